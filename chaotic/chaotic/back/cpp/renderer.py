@@ -176,12 +176,14 @@ class OneToOneFileRenderer:
             clang_format_bin: str,
             parse_extra_formats: bool = False,
             generate_serializer: bool = False,
+            generate_sax_parser: bool = False,
     ) -> None:
         self._relative_to = relative_to
         self._vfilepath_to_relfilepath_map = vfilepath_to_relfilepath
         self._clang_format_bin = clang_format_bin
         self._parse_extra_formats = parse_extra_formats
         self._generate_serializer = generate_serializer
+        self._generate_sax_parser = generate_sax_parser
 
     @staticmethod
     def filepath_wo_ext(filepath: str) -> str:
@@ -274,6 +276,7 @@ class OneToOneFileRenderer:
                 'external_includes': external_includes,
                 'parse_formats': parse_formats,
                 'generate_serializer': self._generate_serializer,
+                'generate_sax_parser': self._generate_sax_parser,
             }
 
             tpl = JINJA_ENV.get_template('templates/type_fwd.hpp.jinja')
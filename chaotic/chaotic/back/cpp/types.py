@@ -662,6 +662,17 @@ class CppStructField:
         else:
             return f'std::optional<{type_}>'
 
+    def is_sax_required(self) -> bool:
+        return self.required and self._default() is None
+
+    def cpp_field_sax_parse_type(self) -> str:
+        # null and a missing field are handled by the SAX parser itself
+        type_ = self.schema.parser_type('TODO', self.name.title())
+        if self.is_sax_required():
+            return type_
+        else:
+            return f'std::optional<{type_}>'
+
 
 @dataclasses.dataclass
 class CppStruct(CppType):
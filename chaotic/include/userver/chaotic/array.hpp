@@ -65,6 +65,16 @@ Value Serialize(const Array<ItemType, UserType, Validators...>& ps,
   return vb.ExtractValue();
 }
 
+template <typename ItemType, typename UserType, typename... Validators,
+          typename StringBuilder>
+void WriteToStream(const Array<ItemType, UserType, Validators...>& ps,
+                   StringBuilder& sw) {
+  typename StringBuilder::ArrayGuard guard(sw);
+  for (const auto& item : ps.value) {
+    WriteToStream(ItemType{item}, sw);
+  }
+}
+
 }  // namespace chaotic
 
 USERVER_NAMESPACE_END
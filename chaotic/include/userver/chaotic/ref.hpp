@@ -25,6 +25,11 @@ Value Serialize(const Ref<T>& ps, formats::serialize::To<Value>) {
   return typename Value::Builder{T{*ps.value}}.ExtractValue();
 }
 
+template <typename T, typename StringBuilder>
+void WriteToStream(const Ref<T>& ps, StringBuilder& sw) {
+  WriteToStream(T{*ps.value}, sw);
+}
+
 }  // namespace chaotic
 
 USERVER_NAMESPACE_END
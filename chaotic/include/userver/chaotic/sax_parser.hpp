@@ -0,0 +1,536 @@
+#pragma once
+
+#include <cstdint>
+#include <iterator>
+#include <memory>
+#include <optional>
+#include <string>
+#include <string_view>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#include <fmt/format.h>
+
+#include <userver/chaotic/array.hpp>
+#include <userver/chaotic/convert.hpp>
+#include <userver/chaotic/primitive.hpp>
+#include <userver/chaotic/ref.hpp>
+#include <userver/chaotic/sax_parser_fwd.hpp>
+#include <userver/chaotic/with_type.hpp>
+#include <userver/formats/common/meta.hpp>
+#include <userver/formats/json/parser/parser.hpp>
+#include <userver/formats/json/value.hpp>
+#include <userver/formats/json/value_builder.hpp>
+#include <userver/formats/parse/to.hpp>
+#include <userver/utils/box.hpp>
+#include <userver/utils/meta.hpp>
+
+USERVER_NAMESPACE_BEGIN
+
+/// SAX parsers for the chaotic generated types, see --generate-sax-parsers
+namespace chaotic::sax {
+
+namespace impl {
+
+template <typename T>
+using MakeSaxParserResult =
+    decltype(MakeSaxParser(formats::parse::To<T>{}));
+
+template <typename T>
+inline constexpr bool kHasSaxParser =
+    meta::kIsDetected<MakeSaxParserResult, T>;
+
+template <typename RawType>
+struct RawParser {
+  using Type = void;
+};
+
+template <>
+struct RawParser<bool> {
+  using Type = formats::json::parser::BoolParser;
+};
+
+template <>
+struct RawParser<std::int32_t> {
+  using Type = formats::json::parser::Int32Parser;
+};
+
+template <>
+struct RawParser<std::int64_t> {
+  using Type = formats::json::parser::Int64Parser;
+};
+
+template <>
+struct RawParser<double> {
+  using Type = formats::json::parser::DoubleParser;
+};
+
+template <>
+struct RawParser<std::string> {
+  using Type = formats::json::parser::StringParser;
+};
+
+}  // namespace impl
+
+/// Parses the value via JsonValueParser and formats::json::Value::As<T>().
+/// Used for the types without a dedicated SAX parser, e.g. oneOf.
+template <typename T>
+class DomParser final
+    : public formats::json::parser::Subscriber<formats::json::Value> {
+ public:
+  using ResultType = formats::common::ParseType<formats::json::Value, T>;
+
+  void Reset() {
+    // JsonValueParser gives away its document with the result, so a fresh
+    // one is required for every value
+    parser_ = std::make_unique<formats::json::parser::JsonValueParser>();
+    parser_->Subscribe(*this);
+  }
+
+  void Subscribe(formats::json::parser::Subscriber<ResultType>& subscriber) {
+    subscriber_ = &subscriber;
+  }
+
+  formats::json::parser::TypedParser<formats::json::Value>& GetParser() {
+    if (!parser_) Reset();
+    return parser_->GetParser();
+  }
+
+ private:
+  void OnSend(formats::json::Value&& value) override {
+    auto result = value.As<T>();
+    if (subscriber_) subscriber_->OnSend(std::move(result));
+  }
+
+  std::unique_ptr<formats::json::parser::JsonValueParser> parser_;
+  formats::json::parser::Subscriber<ResultType>* subscriber_{nullptr};
+};
+
+/// Parser of a type with the generated MakeSaxParser(). The generated parser
+/// is created on first use, so recursive types are fine.
+template <typename T>
+class GeneratedParser final {
+ public:
+  using ResultType = T;
+
+  void Reset() { Get().Reset(); }
+
+  void Subscribe(formats::json::parser::Subscriber<T>& subscriber) {
+    subscriber_ = &subscriber;
+    if (parser_) parser_->Subscribe(subscriber);
+  }
+
+  formats::json::parser::TypedParser<T>& GetParser() { return Get(); }
+
+ private:
+  formats::json::parser::TypedParser<T>& Get() {
+    if (!parser_) {
+      parser_ = MakeSaxParser(formats::parse::To<T>{});
+      if (subscriber_) parser_->Subscribe(*subscriber_);
+    }
+    return *parser_;
+  }
+
+  std::unique_ptr<formats::json::parser::TypedParser<T>> parser_;
+  formats::json::parser::Subscriber<T>* subscriber_{nullptr};
+};
+
+/// Proxy parser that runs chaotic validators on the result
+template <typename Parser, typename... Validators>
+class ValidatingParser final
+    : public formats::json::parser::Subscriber<typename Parser::ResultType> {
+ public:
+  using ResultType = typename Parser::ResultType;
+
+  ValidatingParser() { parser_.Subscribe(*this); }
+
+  void Reset() { parser_.Reset(); }
+
+  void Subscribe(formats::json::parser::Subscriber<ResultType>& subscriber) {
+    subscriber_ = &subscriber;
+  }
+
+  auto& GetParser() { return parser_.GetParser(); }
+
+ private:
+  void OnSend(ResultType&& value) override {
+    (Validators::Validate(value), ...);
+    if (subscriber_) subscriber_->OnSend(std::move(value));
+  }
+
+  Parser parser_;
+  formats::json::parser::Subscriber<ResultType>* subscriber_{nullptr};
+};
+
+/// Proxy parser for chaotic::WithType
+template <typename Parser, typename UserType>
+class ConvertingParser final
+    : public formats::json::parser::Subscriber<typename Parser::ResultType> {
+ public:
+  using ResultType = UserType;
+
+  ConvertingParser() { parser_.Subscribe(*this); }
+
+  void Reset() { parser_.Reset(); }
+
+  void Subscribe(formats::json::parser::Subscriber<UserType>& subscriber) {
+    subscriber_ = &subscriber;
+  }
+
+  auto& GetParser() { return parser_.GetParser(); }
+
+ private:
+  void OnSend(typename Parser::ResultType&& value) override {
+    auto result = Convert(std::move(value), convert::To<UserType>{});
+    if (subscriber_) subscriber_->OnSend(std::move(result));
+  }
+
+  Parser parser_;
+  formats::json::parser::Subscriber<UserType>* subscriber_{nullptr};
+};
+
+/// Proxy parser for chaotic::Ref
+template <typename Parser>
+class RefParser final
+    : public formats::json::parser::Subscriber<typename Parser::ResultType> {
+ public:
+  using ResultType = utils::Box<typename Parser::ResultType>;
+
+  RefParser() { parser_.Subscribe(*this); }
+
+  void Reset() { parser_.Reset(); }
+
+  void Subscribe(formats::json::parser::Subscriber<ResultType>& subscriber) {
+    subscriber_ = &subscriber;
+  }
+
+  auto& GetParser() { return parser_.GetParser(); }
+
+ private:
+  void OnSend(typename Parser::ResultType&& value) override {
+    if (subscriber_) subscriber_->OnSend(ResultType{std::move(value)});
+  }
+
+  Parser parser_;
+  formats::json::parser::Subscriber<ResultType>* subscriber_{nullptr};
+};
+
+/// Proxy parser for chaotic::Array
+template <typename ItemParser, typename UserType, typename... Validators>
+class ArrayParser final
+    : public formats::json::parser::Subscriber<
+          std::vector<typename ItemParser::ResultType>> {
+ public:
+  using ResultType = UserType;
+
+  ArrayParser() { parser_.Subscribe(*this); }
+
+  void Reset() { parser_.Reset(); }
+
+  void Subscribe(formats::json::parser::Subscriber<UserType>& subscriber) {
+    subscriber_ = &subscriber;
+  }
+
+  auto& GetParser() { return parser_.GetParser(); }
+
+ private:
+  using Item = typename ItemParser::ResultType;
+  using Storage = std::vector<Item>;
+
+  void OnSend(Storage&& storage) override {
+    if constexpr (std::is_same_v<Storage, UserType>) {
+      Send(std::move(storage));
+    } else {
+      UserType result;
+      auto inserter = std::inserter(result, result.end());
+      for (auto& item : storage) {
+        *inserter = std::move(item);
+        ++inserter;
+      }
+      Send(std::move(result));
+    }
+  }
+
+  void Send(UserType&& value) {
+    (Validators::Validate(value), ...);
+    if (subscriber_) subscriber_->OnSend(std::move(value));
+  }
+
+  ItemParser item_parser_;
+  formats::json::parser::ArrayParser<Item, ItemParser, Storage> parser_{
+      item_parser_};
+  formats::json::parser::Subscriber<UserType>* subscriber_{nullptr};
+};
+
+/// Parser of std::optional, null and a missing value are std::nullopt
+template <typename Parser>
+class OptionalParser final
+    : public formats::json::parser::TypedParser<
+          std::optional<typename Parser::ResultType>>,
+      public formats::json::parser::Subscriber<typename Parser::ResultType> {
+  using Item = typename Parser::ResultType;
+
+ public:
+  OptionalParser() { parser_.Subscribe(*this); }
+
+  void Null() override { this->SetResult(std::nullopt); }
+  void Bool(bool value) override { Push().Bool(value); }
+  void Int64(std::int64_t value) override { Push().Int64(value); }
+  void Uint64(std::uint64_t value) override { Push().Uint64(value); }
+  void Double(double value) override { Push().Double(value); }
+  void String(std::string_view value) override { Push().String(value); }
+  void StartObject() override { Push().StartObject(); }
+  void StartArray() override { Push().StartArray(); }
+
+ private:
+  formats::json::parser::BaseParser& Push() {
+    parser_.Reset();
+    auto& parser = parser_.GetParser();
+    this->parser_state_->PushParser(parser);
+    return parser;
+  }
+
+  void OnSend(Item&& value) override {
+    this->SetResult(std::optional<Item>{std::move(value)});
+  }
+
+  std::string Expected() const override { return "value or null"; }
+
+  std::string GetPathItem() const override { return {}; }
+
+  Parser parser_;
+};
+
+/// Maps chaotic parser types (as in `value.As<ParserType>()`) to SAX parsers
+template <typename ParserType, typename = void>
+struct ParserFor {
+  using Type = std::conditional_t<impl::kHasSaxParser<ParserType>,
+                                  GeneratedParser<ParserType>,
+                                  DomParser<ParserType>>;
+};
+
+template <typename ParserType>
+using Parser = typename ParserFor<ParserType>::Type;
+
+template <typename RawType, typename... Validators>
+struct ParserFor<Primitive<RawType, Validators...>,
+                 std::enable_if_t<!std::is_void_v<
+                     typename impl::RawParser<RawType>::Type>>> {
+  using RawParserType = typename impl::RawParser<RawType>::Type;
+  using Type = std::conditional_t<sizeof...(Validators) == 0, RawParserType,
+                                  ValidatingParser<RawParserType,
+                                                   Validators...>>;
+};
+
+template <typename T>
+struct ParserFor<Primitive<T>,
+                 std::enable_if_t<impl::kHasSaxParser<T>>> {
+  using Type = GeneratedParser<T>;
+};
+
+template <typename ItemType, typename UserType, typename... Validators>
+struct ParserFor<Array<ItemType, UserType, Validators...>> {
+  using Type = ArrayParser<Parser<ItemType>, UserType, Validators...>;
+};
+
+template <typename RawType, typename UserType>
+struct ParserFor<WithType<RawType, UserType>> {
+  using Type = ConvertingParser<Parser<RawType>, UserType>;
+};
+
+template <typename T>
+struct ParserFor<Ref<T>> {
+  using Type = RefParser<Parser<T>>;
+};
+
+template <typename T>
+struct ParserFor<std::optional<T>> {
+  using Type = OptionalParser<Parser<T>>;
+};
+
+template <typename T>
+struct SinkFor {
+  using Type = formats::json::parser::SubscriberSink<T>;
+};
+
+template <typename T>
+struct SinkFor<std::optional<T>> {
+  using Type = formats::json::parser::SubscriberSinkOptional<T>;
+};
+
+/// Sink for a field of a generated struct
+template <typename T>
+using Sink = typename SinkFor<T>::Type;
+
+/// Sink for a field with a default value: null keeps the default
+template <typename T>
+class DefaultedSink final
+    : public formats::json::parser::Subscriber<std::optional<T>> {
+ public:
+  explicit DefaultedSink(T& data) : data_(data) {}
+
+  void OnSend(std::optional<T>&& value) override {
+    if (value) data_ = std::move(*value);
+  }
+
+ private:
+  T& data_;
+};
+
+/// Sink for typed additionalProperties
+template <typename Map>
+class MapSink final
+    : public formats::json::parser::Subscriber<typename Map::mapped_type> {
+ public:
+  MapSink(Map& data, const std::string& key) : data_(data), key_(key) {}
+
+  void OnSend(typename Map::mapped_type&& value) override {
+    data_.emplace(key_, std::move(value));
+  }
+
+ private:
+  Map& data_;
+  const std::string& key_;
+};
+
+/// Sink for `additionalProperties: true`
+class ObjectSink final
+    : public formats::json::parser::Subscriber<formats::json::Value> {
+ public:
+  explicit ObjectSink(const std::string& key) : key_(key) {}
+
+  void Reset() { builder_ = formats::common::Type::kObject; }
+
+  formats::json::Value Extract() { return builder_.ExtractValue(); }
+
+  void OnSend(formats::json::Value&& value) override {
+    builder_[key_] = std::move(value);
+  }
+
+ private:
+  const std::string& key_;
+  formats::json::ValueBuilder builder_{formats::common::Type::kObject};
+};
+
+/// Skips a value of any type, used for the unknown properties
+class SkipParser final : public formats::json::parser::BaseParser {
+ public:
+  void Reset() { depth_ = 0; }
+
+  formats::json::parser::BaseParser& GetParser() { return *this; }
+
+ private:
+  void Null() override { Scalar(); }
+  void Bool(bool) override { Scalar(); }
+  void Int64(std::int64_t) override { Scalar(); }
+  void Uint64(std::uint64_t) override { Scalar(); }
+  void Double(double) override { Scalar(); }
+  void String(std::string_view) override { Scalar(); }
+  void Key(std::string_view) override {}
+  void StartObject() override { ++depth_; }
+  void EndObject() override { Close(); }
+  void StartArray() override { ++depth_; }
+  void EndArray() override { Close(); }
+
+  void Scalar() {
+    if (depth_ == 0) parser_state_->PopMe(*this);
+  }
+
+  void Close() {
+    if (--depth_ == 0) parser_state_->PopMe(*this);
+  }
+
+  std::string Expected() const override { return "value"; }
+
+  std::string GetPathItem() const override { return {}; }
+
+  std::size_t depth_{0};
+};
+
+/// Base class for the generated parsers of objects
+template <typename T>
+class ObjectParserBase : public formats::json::parser::TypedParser<T> {
+ public:
+  void Reset() override { started_ = false; }
+
+ protected:
+  /// Called at the end of the object, must call SetResult()
+  virtual void Finish() = 0;
+
+  template <typename FieldParser>
+  void PushField(std::string_view key, FieldParser& parser) {
+    key_.assign(key);
+    parser.Reset();
+    this->parser_state_->PushParser(parser.GetParser());
+  }
+
+  void SkipField(std::string_view key) { PushField(key, skip_parser_); }
+
+  [[noreturn]] void ThrowUnknownField(std::string_view key) {
+    // the error is reported for the object itself, as in the DOM parser
+    key_.clear();
+    throw std::runtime_error(fmt::format("Unknown property '{}'", key));
+  }
+
+  [[noreturn]] void ThrowMissingField(std::string_view key) {
+    key_.assign(key);
+    throw std::runtime_error("Field is missing");
+  }
+
+  const std::string& CurrentKey() const noexcept { return key_; }
+
+ private:
+  void StartObject() final {
+    if (started_) this->Throw("object");
+    started_ = true;
+  }
+
+  // null is an empty object, as in the DOM parser
+  void Null() final { Finish(); }
+
+  void EndObject() final { Finish(); }
+
+  std::string Expected() const override { return "object"; }
+
+  std::string GetPathItem() const override { return key_; }
+
+  bool started_{false};
+  std::string key_;
+  SkipParser skip_parser_;
+};
+
+/// Parser of a string enum with generated FromString()
+template <typename T>
+class StringEnumParser final : public formats::json::parser::TypedParser<T> {
+ private:
+  void String(std::string_view value) override {
+    this->SetResult(FromString(value, formats::parse::To<T>{}));
+  }
+
+  std::string Expected() const override { return "string"; }
+
+  std::string GetPathItem() const override { return {}; }
+};
+
+/// @brief Parses JSON string into T without building formats::json::Value.
+///
+/// T is a type generated by chaotic with --generate-sax-parsers, other types
+/// are parsed via formats::json::Value.
+template <typename T>
+T ParseJsonString(std::string_view input) {
+  Parser<Primitive<T>> parser;
+  T result{};
+  Sink<T> sink{result};
+  parser.Subscribe(sink);
+  parser.Reset();
+
+  formats::json::parser::ParserState state;
+  state.PushParser(parser.GetParser());
+  state.ProcessInput(input);
+  return result;
+}
+
+}  // namespace chaotic::sax
+
+USERVER_NAMESPACE_END
@@ -0,0 +1,12 @@
+#pragma once
+
+#include <memory>
+
+USERVER_NAMESPACE_BEGIN
+
+namespace formats::json::parser {
+template <typename T>
+class TypedParser;
+}  // namespace formats::json::parser
+
+USERVER_NAMESPACE_END
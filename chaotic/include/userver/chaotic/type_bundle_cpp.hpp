@@ -1,7 +1,11 @@
 #pragma once
 
+#include <userver/chaotic/sax_parser.hpp>
+#include <userver/chaotic/written_keys.hpp>
+#include <userver/formats/json/string_builder.hpp>
 #include <userver/formats/json/value.hpp>
 #include <userver/formats/json/value_builder.hpp>
 #include <userver/formats/yaml/value.hpp>
 #include <userver/logging/log_helper.hpp>
+#include <userver/utils/trivial_map.hpp>
 #include <userver/yaml_config/yaml_config.hpp>
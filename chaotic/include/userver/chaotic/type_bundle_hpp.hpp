@@ -1,5 +1,8 @@
 #pragma once
 
+#include <userver/chaotic/sax_parser_fwd.hpp>
+#include <userver/chaotic/written_keys_fwd.hpp>
+#include <userver/formats/json/string_builder_fwd.hpp>
 #include <userver/formats/json_fwd.hpp>
 #include <userver/formats/parse/to.hpp>
 #include <userver/formats/yaml_fwd.hpp>
@@ -0,0 +1,28 @@
+#pragma once
+
+#include <string>
+#include <string_view>
+#include <unordered_set>
+
+#include <userver/chaotic/written_keys_fwd.hpp>
+
+USERVER_NAMESPACE_BEGIN
+
+namespace chaotic {
+
+/// @brief Keys of the object that is being written with WriteToStream.
+///
+/// The parents of allOf write their fields into a single object, a key that
+/// is present in several parents is written once.
+class WrittenKeys final {
+ public:
+  /// Returns false if the key was already written
+  bool Insert(std::string_view key) { return keys_.emplace(key).second; }
+
+ private:
+  std::unordered_set<std::string> keys_;
+};
+
+}  // namespace chaotic
+
+USERVER_NAMESPACE_END
@@ -0,0 +1,9 @@
+#pragma once
+
+USERVER_NAMESPACE_BEGIN
+
+namespace chaotic {
+class WrittenKeys;
+}  // namespace chaotic
+
+USERVER_NAMESPACE_END
@@ -0,0 +1,170 @@
+#include <benchmark/benchmark.h>
+
+#include <cstdlib>
+#include <new>
+
+#include <fmt/format.h>
+
+#include <userver/chaotic/sax_parser.hpp>
+#include <userver/formats/json/serialize.hpp>
+#include <userver/formats/json/string_builder.hpp>
+#include <userver/formats/json/value_builder.hpp>
+
+#include <schemas/all_of.hpp>
+#include <schemas/object_single_field.hpp>
+#include <schemas/recursion.hpp>
+
+namespace {
+
+// Heap allocations made by the current thread, the global operator new is
+// replaced for the whole benchmark binary
+thread_local std::size_t heap_allocations = 0;
+
+}  // namespace
+
+void* operator new(std::size_t size) {
+  ++heap_allocations;
+  if (void* ptr = std::malloc(size ? size : 1)) return ptr;
+  throw std::bad_alloc{};
+}
+
+void operator delete(void* ptr) noexcept { std::free(ptr); }
+
+void operator delete(void* ptr, std::size_t) noexcept { std::free(ptr); }
+
+USERVER_NAMESPACE_BEGIN
+
+namespace {
+
+void SetAllocationsCounter(benchmark::State& state,
+                           std::size_t allocations_before) {
+  state.counters["allocations"] = benchmark::Counter(
+      static_cast<double>(heap_allocations - allocations_before),
+      benchmark::Counter::kAvgIterations);
+}
+
+std::string BuildObjectTypes(std::size_t len) {
+  std::string array;
+  for (std::size_t i = 0; i < len; ++i) {
+    if (i > 0) array += ',';
+    array += std::to_string(i);
+  }
+  return fmt::format(
+      R"({{"boolean": true, "integer": 1, "number": 1.5, "string": "str", )"
+      R"("object": {{}}, "array": [{}], "string-enum": "bar"}})",
+      array);
+}
+
+std::string BuildAllOf(std::size_t len) {
+  std::string extra;
+  for (std::size_t i = 0; i < len; ++i) {
+    extra += fmt::format(R"(, "field{}": "value {}")", i, i);
+  }
+  return fmt::format(R"({{"foo": 1, "bar": 2{}}})", extra);
+}
+
+std::string BuildRecursive(std::size_t len) {
+  std::string next;
+  for (std::size_t i = 0; i < len; ++i) {
+    if (i > 0) next += ',';
+    next += fmt::format(R"({{"data": "item {}", "next": [{{"data": "x"}}]}})",
+                        i);
+  }
+  return fmt::format(R"({{"data": "root", "next": [{}]}})", next);
+}
+
+template <typename T>
+void ParseDom(benchmark::State& state, const std::string& input) {
+  const auto allocations_before = heap_allocations;
+  for ([[maybe_unused]] auto _ : state) {
+    auto result = formats::json::FromString(input).As<T>();
+    benchmark::DoNotOptimize(result);
+  }
+  SetAllocationsCounter(state, allocations_before);
+  state.SetBytesProcessed(state.iterations() * input.size());
+}
+
+template <typename T>
+void ParseSax(benchmark::State& state, const std::string& input) {
+  const auto allocations_before = heap_allocations;
+  for ([[maybe_unused]] auto _ : state) {
+    auto result = chaotic::sax::ParseJsonString<T>(input);
+    benchmark::DoNotOptimize(result);
+  }
+  SetAllocationsCounter(state, allocations_before);
+  state.SetBytesProcessed(state.iterations() * input.size());
+}
+
+template <typename T>
+void SerializeDom(benchmark::State& state, const std::string& input) {
+  const auto value = formats::json::FromString(input).As<T>();
+  const auto allocations_before = heap_allocations;
+  for ([[maybe_unused]] auto _ : state) {
+    auto result = formats::json::ToString(
+        formats::json::ValueBuilder{value}.ExtractValue());
+    benchmark::DoNotOptimize(result);
+  }
+  SetAllocationsCounter(state, allocations_before);
+}
+
+template <typename T>
+void SerializeStringBuilder(benchmark::State& state, const std::string& input) {
+  const auto value = formats::json::FromString(input).As<T>();
+  const auto allocations_before = heap_allocations;
+  for ([[maybe_unused]] auto _ : state) {
+    formats::json::StringBuilder sw;
+    WriteToStream(value, sw);
+    auto result = sw.GetString();
+    benchmark::DoNotOptimize(result);
+  }
+  SetAllocationsCounter(state, allocations_before);
+}
+
+}  // namespace
+
+void ChaoticParseArrayDom(benchmark::State& state) {
+  ParseDom<ns::ObjectTypes>(state, BuildObjectTypes(state.range(0)));
+}
+BENCHMARK(ChaoticParseArrayDom)->RangeMultiplier(8)->Range(1, 32768);
+
+void ChaoticParseArraySax(benchmark::State& state) {
+  ParseSax<ns::ObjectTypes>(state, BuildObjectTypes(state.range(0)));
+}
+BENCHMARK(ChaoticParseArraySax)->RangeMultiplier(8)->Range(1, 32768);
+
+void ChaoticParseObjectsDom(benchmark::State& state) {
+  ParseDom<ns::RecursiveObject>(state, BuildRecursive(state.range(0)));
+}
+BENCHMARK(ChaoticParseObjectsDom)->RangeMultiplier(8)->Range(1, 32768);
+
+void ChaoticParseObjectsSax(benchmark::State& state) {
+  ParseSax<ns::RecursiveObject>(state, BuildRecursive(state.range(0)));
+}
+BENCHMARK(ChaoticParseObjectsSax)->RangeMultiplier(8)->Range(1, 32768);
+
+void ChaoticSerializeObjectsDom(benchmark::State& state) {
+  SerializeDom<ns::RecursiveObject>(state, BuildRecursive(state.range(0)));
+}
+BENCHMARK(ChaoticSerializeObjectsDom)->RangeMultiplier(8)->Range(1, 32768);
+
+void ChaoticSerializeObjectsStringBuilder(benchmark::State& state) {
+  SerializeStringBuilder<ns::RecursiveObject>(state,
+                                              BuildRecursive(state.range(0)));
+}
+BENCHMARK(ChaoticSerializeObjectsStringBuilder)
+    ->RangeMultiplier(8)
+    ->Range(1, 32768);
+
+void ChaoticSerializeAllOfDom(benchmark::State& state) {
+  SerializeDom<ns::AllOf>(state, BuildAllOf(state.range(0)));
+}
+BENCHMARK(ChaoticSerializeAllOfDom)->RangeMultiplier(8)->Range(1, 512);
+
+void ChaoticSerializeAllOfStringBuilder(benchmark::State& state) {
+  SerializeStringBuilder<ns::AllOf>(state, BuildAllOf(state.range(0)));
+}
+BENCHMARK(ChaoticSerializeAllOfStringBuilder)
+    ->RangeMultiplier(8)
+    ->Range(1, 512);
+
+USERVER_NAMESPACE_END
@@ -0,0 +1,201 @@
+#include <userver/utest/assert_macros.hpp>
+
+#include <userver/chaotic/sax_parser.hpp>
+#include <userver/formats/json/parser/exception.hpp>
+#include <userver/formats/json/serialize.hpp>
+#include <userver/formats/json/string_builder.hpp>
+#include <userver/formats/json/value_builder.hpp>
+
+#include <schemas/all_of.hpp>
+#include <schemas/array.hpp>
+#include <schemas/extra_container.hpp>
+#include <schemas/indirect.hpp>
+#include <schemas/int_minmax.hpp>
+#include <schemas/object_empty.hpp>
+#include <schemas/object_single_field.hpp>
+#include <schemas/one_of.hpp>
+#include <schemas/pattern.hpp>
+#include <schemas/recursion.hpp>
+
+USERVER_NAMESPACE_BEGIN
+
+namespace {
+
+template <typename T>
+T ParseSax(std::string_view input) {
+  return chaotic::sax::ParseJsonString<T>(input);
+}
+
+template <typename T>
+T ParseDom(std::string_view input) {
+  return formats::json::FromString(input).As<T>();
+}
+
+template <typename T>
+void ExpectSameAsDom(std::string_view input) {
+  EXPECT_EQ(ParseSax<T>(input), ParseDom<T>(input)) << input;
+}
+
+template <typename T>
+void ExpectSameAsSerialize(const T& value) {
+  formats::json::StringBuilder sw;
+  WriteToStream(value, sw);
+  EXPECT_EQ(formats::json::FromString(sw.GetString()),
+            formats::json::ValueBuilder{value}.ExtractValue())
+      << sw.GetString();
+}
+
+}  // namespace
+
+TEST(Sax, Empty) {
+  EXPECT_EQ(ParseSax<ns::ObjectEmpty>("{}"), ns::ObjectEmpty{});
+  EXPECT_EQ(ParseSax<ns::ObjectEmpty>("null"), ns::ObjectEmpty{});
+}
+
+TEST(Sax, SimpleObject) {
+  const auto obj = ParseSax<ns::SimpleObject>(R"({"integer": 5, "int3": 42})");
+  EXPECT_EQ(obj.integer, 5);
+  EXPECT_EQ(obj.int_, 1);
+  EXPECT_EQ(obj.int3, 42);
+
+  ExpectSameAsDom<ns::SimpleObject>(R"({"int3": 1, "int": 10})");
+  ExpectSameAsDom<ns::SimpleObject>(R"({"int3": 1, "int": null})");
+  ExpectSameAsDom<ns::SimpleObject>(R"({"int3": 1, "integer": null})");
+  ExpectSameAsDom<ns::ObjectWithOptionalNoDefault>("{}");
+  ExpectSameAsDom<ns::ObjectWithOptionalNoDefault>(R"({"int": 3})");
+}
+
+TEST(Sax, ObjectTypes) {
+  constexpr std::string_view kJson = R"({
+    "boolean": true,
+    "integer": 1,
+    "number": 1.5,
+    "string": "some \"quoted\" string",
+    "object": {},
+    "array": [1, 2, 3],
+    "int-enum": 2,
+    "string-enum": "bar"
+  })";
+  ExpectSameAsDom<ns::ObjectTypes>(kJson);
+  ExpectSameAsSerialize(ParseSax<ns::ObjectTypes>(kJson));
+}
+
+TEST(Sax, MissingField) {
+  UEXPECT_THROW_MSG(ParseSax<ns::SimpleObject>(R"({"integer": 1})"),
+                    formats::json::parser::ParseError,
+                    "path 'int3': Field is missing");
+  UEXPECT_THROW_MSG(ParseSax<ns::SimpleObject>("null"),
+                    formats::json::parser::ParseError,
+                    "path 'int3': Field is missing");
+}
+
+TEST(Sax, WrongType) {
+  UEXPECT_THROW_MSG(ParseSax<ns::SimpleObject>(R"({"int3": "1"})"),
+                    formats::json::parser::ParseError,
+                    "path 'int3': integer was expected, but string found");
+  UEXPECT_THROW_MSG(ParseSax<ns::SimpleObject>("[]"),
+                    formats::json::parser::ParseError,
+                    "object was expected, but array found");
+}
+
+TEST(Sax, Validators) {
+  UEXPECT_THROW_MSG(
+      ParseSax<ns::SimpleObject>(R"({"int3": 1, "int": 11})"),
+      formats::json::parser::ParseError,
+      "path 'int': Invalid value, maximum=10, given=11");
+  UEXPECT_THROW_MSG(
+      ParseSax<ns::IntegerObject>(R"({"zoo": [1]})"),
+      formats::json::parser::ParseError,
+      "path 'zoo': Too short array, minimum length=2, given=1");
+  UEXPECT_THROW_MSG(ParseSax<ns::ObjectPattern>(R"({"foo": "bar"})"),
+                    formats::json::parser::ParseError,
+                    "path 'foo': doesn't match regex");
+
+  ExpectSameAsDom<ns::IntegerObject>(
+      R"({"foo": 2, "bar": "abc", "zoo": [1, 2]})");
+  ExpectSameAsDom<ns::ObjectPattern>(R"({"foo": "foo1", "bar": "bar2"})");
+}
+
+TEST(Sax, UnknownProperties) {
+  ExpectSameAsDom<ns::ObjectWithAdditionalPropertiesTrueExtraMemberFalse>(
+      R"({"unknown": {"a": [1, {"b": null}], "c": []}, "one": 2})");
+
+  UEXPECT_THROW_MSG(ParseSax<ns::SimpleObject>(R"({"int3": 1, "bar": 2})"),
+                    formats::json::parser::ParseError,
+                    "Unknown property 'bar'");
+}
+
+TEST(Sax, AdditionalProperties) {
+  ExpectSameAsDom<ns::ObjectWithAdditionalPropertiesInt>(
+      R"({"one": 5, "two": 2, "three": 3})");
+  UEXPECT_THROW_MSG(ParseSax<ns::ObjectWithAdditionalPropertiesInt>(
+                        R"({"one": 5, "two": 1})"),
+                    formats::json::parser::ParseError,
+                    "path 'two': Invalid value, minimum=2, given=1");
+
+  ExpectSameAsDom<ns::ObjectWithAdditionalProperties>(
+      R"({"foo": "a", "x": {"bar": "b"}, "y": {}})");
+  ExpectSameAsDom<ns::ObjectWithAdditionalPropertiesTrue>(
+      R"({"one": 5, "two": [2], "three": {"four": 4}})");
+  ExpectSameAsDom<ns::ObjectWithAdditionalPropertiesTrueExtraMemberFalse>(
+      R"({"one": 5, "two": [2]})");
+  ExpectSameAsDom<ns::ObjectWithExtraType>(R"({"a": "b", "c": "d"})");
+
+  ExpectSameAsSerialize(ParseSax<ns::ObjectWithAdditionalPropertiesTrue>(
+      R"({"one": 5, "two": [2]})"));
+  ExpectSameAsSerialize(ParseSax<ns::ObjectWithAdditionalProperties>(
+      R"({"foo": "a", "x": {"bar": "b"}})"));
+}
+
+TEST(Sax, Arrays) {
+  ExpectSameAsDom<ns::ArrayStruct>(R"({"array": ["a", "b"]})");
+  ExpectSameAsDom<ns::ArrayStruct>(R"({"array": []})");
+  ExpectSameAsDom<ns::ObjectWithSet>(R"({"set": [1, 2, 2, 3]})");
+
+  ExpectSameAsSerialize(ParseSax<ns::ArrayStruct>(R"({"array": ["a"]})"));
+}
+
+TEST(Sax, Recursion) {
+  constexpr std::string_view kRecursive =
+      R"({"data": "a", "next": [{"data": "b", "next": [{"data": "c"}]}]})";
+  ExpectSameAsDom<ns::RecursiveObject>(kRecursive);
+  ExpectSameAsSerialize(ParseSax<ns::RecursiveObject>(kRecursive));
+
+  constexpr std::string_view kTree =
+      R"({"data": "a", "left": {"data": "b"}, "right": {"right": {}}})";
+  const auto tree = ParseSax<ns::TreeNode>(kTree);
+  ASSERT_TRUE(tree.left);
+  EXPECT_EQ((*tree.left)->data, "b");
+  ExpectSameAsSerialize(tree);
+}
+
+TEST(Sax, DomFallback) {
+  // oneOf is parsed via formats::json::Value
+  ExpectSameAsDom<ns::ObjectOneOfWithDiscriminator>(
+      R"({"oneof": {"type": "ObjectFoo", "foo": 1}})");
+  ExpectSameAsDom<ns::ObjectOneOfWithDiscriminator>(
+      R"({"oneof": {"type": "ObjectBar", "bar": "x"}})");
+  UEXPECT_THROW_MSG(ParseSax<ns::ObjectOneOfWithDiscriminator>(
+                        R"({"oneof": {"type": "ObjectZoo"}})"),
+                    formats::json::parser::ParseError, "path 'oneof'");
+}
+
+TEST(Sax, SerializeAllOf) {
+  ExpectSameAsSerialize(ParseDom<ns::AllOf>(R"({"foo": 1, "bar": 2})"));
+  ExpectSameAsSerialize(
+      ParseDom<ns::AllOf>(R"({"foo": 1, "bar": 2, "baz": {"x": [1]}})"));
+  ExpectSameAsSerialize(ParseDom<ns::AllOf>("{}"));
+
+  // The parents disagree, the last one wins as in Serialize()
+  ns::AllOf value;
+  static_cast<ns::Object1&>(value).foo = 1;
+  static_cast<ns::AllOf__P1&>(value).extra =
+      formats::json::FromString(R"({"foo": 2})");
+  ExpectSameAsSerialize(value);
+
+  formats::json::StringBuilder sw;
+  WriteToStream(value, sw);
+  EXPECT_EQ(formats::json::FromString(sw.GetString())["foo"].As<int>(), 2);
+}
+
+USERVER_NAMESPACE_END
@@ -4,6 +4,8 @@
 /// This file is mainly for documentation purposes and inclusion of all headers
 /// that are required for working with ClickHouse µserver component.
 
+#include <userver/storages/clickhouse/block_cursor.hpp>
+#include <userver/storages/clickhouse/buffered_inserter.hpp>
 #include <userver/storages/clickhouse/cluster.hpp>
 #include <userver/storages/clickhouse/component.hpp>
 #include <userver/storages/clickhouse/execution_result.hpp>
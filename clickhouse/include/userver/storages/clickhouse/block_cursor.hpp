@@ -0,0 +1,56 @@
+#pragma once
+
+/// @file userver/storages/clickhouse/block_cursor.hpp
+/// @brief @copybrief storages::clickhouse::BlockCursor
+
+#include <memory>
+#include <optional>
+
+#include <userver/storages/clickhouse/execution_result.hpp>
+
+USERVER_NAMESPACE_BEGIN
+
+namespace storages::clickhouse {
+
+namespace impl {
+class BlockCursorImpl;
+}
+
+// clang-format off
+
+/// Streaming accessor to the result of a query, returned by
+/// storages::clickhouse::Cluster ExecuteStreaming methods.
+///
+/// Blocks are handed out in the order ClickHouse sends them, each of them is
+/// converted the same way as a whole storages::clickhouse::ExecutionResult is.
+/// Only a couple of blocks are buffered at a time: the connection is not read
+/// further until the consumer catches up, so the memory usage does not depend
+/// on the result size.
+///
+/// The connection is held until the cursor is read till the end or destroyed,
+/// destroying the cursor earlier cancels the query. The `execute` timeout
+/// limits the whole streaming, including the time spent by the consumer.
+///
+/// ## Usage example:
+///
+/// @snippet storages/tests/streaming_chtest.cpp  Sample BlockCursor usage
+
+// clang-format on
+class BlockCursor final {
+ public:
+  explicit BlockCursor(std::unique_ptr<impl::BlockCursorImpl>);
+  BlockCursor(BlockCursor&&) noexcept;
+  ~BlockCursor();
+
+  /// Waits for the next non-empty block of the result.
+  /// Returns std::nullopt once the whole result is read,
+  /// rethrows the errors of the query.
+  std::optional<ExecutionResult> Next();
+
+ private:
+  std::unique_ptr<impl::BlockCursorImpl> impl_;
+};
+
+}  // namespace storages::clickhouse
+
+USERVER_NAMESPACE_END
@@ -0,0 +1,146 @@
+#pragma once
+
+/// @file userver/storages/clickhouse/buffered_inserter.hpp
+/// @brief @copybrief storages::clickhouse::BufferedInserter
+
+#include <iterator>
+#include <memory>
+#include <string>
+#include <type_traits>
+#include <vector>
+
+#include <userver/storages/clickhouse/cluster.hpp>
+#include <userver/storages/clickhouse/fwd.hpp>
+#include <userver/storages/clickhouse/impl/buffered_inserter_base.hpp>
+#include <userver/storages/clickhouse/options.hpp>
+
+USERVER_NAMESPACE_BEGIN
+
+namespace storages::clickhouse {
+
+namespace impl {
+
+template <typename Row>
+class RowsBatch final : public InsertionBatch {
+ public:
+  void Append(Row&& row) { rows_.push_back(std::move(row)); }
+
+  template <typename Container>
+  void AppendRows(Container&& rows) {
+    if constexpr (std::is_rvalue_reference_v<Container&&>) {
+      rows_.insert(rows_.end(), std::make_move_iterator(rows.begin()),
+                   std::make_move_iterator(rows.end()));
+    } else {
+      rows_.insert(rows_.end(), rows.begin(), rows.end());
+    }
+  }
+
+  std::size_t GetRowsCount() const override { return rows_.size(); }
+
+  void Insert(const Cluster& cluster, OptionalCommandControl optional_cc,
+              const std::string& table_name,
+              const std::vector<std::string_view>& column_names) override {
+    cluster.InsertRows(optional_cc, table_name, column_names, rows_);
+  }
+
+ private:
+  std::vector<Row> rows_;
+};
+
+}  // namespace impl
+
+// clang-format off
+
+/// @brief Accumulates the rows inserted by many tasks and sends them to
+/// ClickHouse in large blocks.
+///
+/// Every insert of storages::clickhouse::Cluster sends a separate block
+/// and makes the server create a separate part for it. BufferedInserter
+/// instead collects the rows of any number of concurrent Insert calls and
+/// sends them with a single storages::clickhouse::Cluster::InsertRows once
+/// storages::clickhouse::BufferedInserterSettings::max_rows rows are collected
+/// or storages::clickhouse::BufferedInserterSettings::max_delay passes.
+///
+/// Flushes happen in a background task, one at a time. Once
+/// storages::clickhouse::BufferedInserterSettings::max_pending_rows rows are
+/// waiting to be sent, Insert waits for the flushes to catch up.
+/// Rows of a failed flush are dropped and accounted in the statistics,
+/// the remaining rows are flushed on destruction.
+///
+/// `Row` is expected to be a clickhouse-mapped type,
+/// see @ref clickhouse_io for its requirements.
+
+// clang-format on
+template <typename Row>
+class BufferedInserter final {
+ public:
+  /// @param cluster cluster to insert into, kept alive by the inserter
+  /// @param table_name table to insert into
+  /// @param column_names names of columns of the table
+  /// @param settings flush and backpressure settings
+  BufferedInserter(ClusterPtr cluster, std::string table_name,
+                   std::vector<std::string> column_names,
+                   BufferedInserterSettings settings = {});
+
+  BufferedInserter(const BufferedInserter&) = delete;
+
+  /// Buffers a row, waits if too many rows are pending
+  void Insert(Row row);
+
+  /// Buffers the rows of a container, waits if too many rows are pending
+  template <typename Container>
+  void InsertRows(Container&& rows);
+
+  /// Sends all the rows buffered so far and waits for the send to complete,
+  /// rethrows the insertion errors.
+  void Flush();
+
+  /// Write inserter statistics
+  void WriteStatistics(
+      USERVER_NAMESPACE::utils::statistics::Writer& writer) const;
+
+ private:
+  impl::BufferedInserterBase base_;
+};
+
+template <typename Row>
+BufferedInserter<Row>::BufferedInserter(ClusterPtr cluster,
+                                        std::string table_name,
+                                        std::vector<std::string> column_names,
+                                        BufferedInserterSettings settings)
+    : base_{std::move(cluster), std::move(table_name), std::move(column_names),
+            settings,
+            [] { return std::make_unique<impl::RowsBatch<Row>>(); }} {}
+
+template <typename Row>
+void BufferedInserter<Row>::Insert(Row row) {
+  base_.Append([&row](impl::InsertionBatch& batch) {
+    static_cast<impl::RowsBatch<Row>&>(batch).Append(std::move(row));
+  });
+}
+
+template <typename Row>
+template <typename Container>
+void BufferedInserter<Row>::InsertRows(Container&& rows) {
+  if (std::empty(rows)) return;
+
+  base_.Append([&rows](impl::InsertionBatch& batch) {
+    static_cast<impl::RowsBatch<Row>&>(batch).AppendRows(
+        std::forward<Container>(rows));
+  });
+}
+
+template <typename Row>
+void BufferedInserter<Row>::Flush() {
+  base_.Flush();
+}
+
+template <typename Row>
+void BufferedInserter<Row>::WriteStatistics(
+    USERVER_NAMESPACE::utils::statistics::Writer& writer) const {
+  base_.WriteStatistics(writer);
+}
+
+}  // namespace storages::clickhouse
+
+USERVER_NAMESPACE_END
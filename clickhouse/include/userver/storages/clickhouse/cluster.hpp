@@ -11,6 +11,7 @@
 #include <userver/clients/dns/resolver_fwd.hpp>
 #include <userver/components/component_fwd.hpp>
 
+#include <userver/storages/clickhouse/block_cursor.hpp>
 #include <userver/storages/clickhouse/fwd.hpp>
 #include <userver/storages/clickhouse/impl/insertion_request.hpp>
 #include <userver/storages/clickhouse/impl/pool.hpp>
@@ -60,6 +61,20 @@ class Cluster final {
   ExecutionResult Execute(OptionalCommandControl, const Query& query,
                           const Args&... args) const;
 
+  /// @brief Execute a statement at some host of the cluster
+  /// with args as query parameters, the result is read block by block
+  /// through the returned storages::clickhouse::BlockCursor.
+  template <typename... Args>
+  BlockCursor ExecuteStreaming(const Query& query, const Args&... args) const;
+
+  /// @brief Execute a statement with specified command control settings
+  /// at some host of the cluster with args as query parameters, the result is
+  /// read block by block through the returned
+  /// storages::clickhouse::BlockCursor.
+  template <typename... Args>
+  BlockCursor ExecuteStreaming(OptionalCommandControl, const Query& query,
+                               const Args&... args) const;
+
   /// @brief Insert data at some host of the cluster;
   /// `T` is expected to be a struct of vectors of same length.
   /// @param table_name table to insert into
@@ -131,6 +146,9 @@ class Cluster final {
 
   ExecutionResult DoExecute(OptionalCommandControl, const Query& query) const;
 
+  BlockCursor DoExecuteStreaming(OptionalCommandControl,
+                                 const Query& query) const;
+
   const impl::Pool& GetPool() const;
 
   std::vector<impl::Pool> pools_;
@@ -189,6 +207,20 @@ ExecutionResult Cluster::Execute(OptionalCommandControl optional_cc,
   return DoExecute(optional_cc, formatted_query);
 }
 
+template <typename... Args>
+BlockCursor Cluster::ExecuteStreaming(const Query& query,
+                                      const Args&... args) const {
+  return ExecuteStreaming(OptionalCommandControl{}, query, args...);
+}
+
+template <typename... Args>
+BlockCursor Cluster::ExecuteStreaming(OptionalCommandControl optional_cc,
+                                      const Query& query,
+                                      const Args&... args) const {
+  const auto formatted_query = query.WithArgs(args...);
+  return DoExecuteStreaming(optional_cc, formatted_query);
+}
+
 }  // namespace storages::clickhouse
 
 USERVER_NAMESPACE_END
@@ -0,0 +1,62 @@
+#pragma once
+
+#include <cstddef>
+#include <functional>
+#include <memory>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include <userver/storages/clickhouse/fwd.hpp>
+#include <userver/storages/clickhouse/options.hpp>
+#include <userver/utils/function_ref.hpp>
+#include <userver/utils/statistics/writer.hpp>
+
+USERVER_NAMESPACE_BEGIN
+
+namespace storages::clickhouse::impl {
+
+/// Rows accumulated by a BufferedInserter between the flushes
+class InsertionBatch {
+ public:
+  virtual ~InsertionBatch() = default;
+
+  virtual std::size_t GetRowsCount() const = 0;
+
+  virtual void Insert(const Cluster& cluster, OptionalCommandControl,
+                      const std::string& table_name,
+                      const std::vector<std::string_view>& column_names) = 0;
+};
+
+using InsertionBatchFactory = std::function<std::unique_ptr<InsertionBatch>()>;
+
+/// Buffering, flushing and backpressure of BufferedInserter, independent
+/// of the rows type
+class BufferedInserterBase final {
+ public:
+  BufferedInserterBase(ClusterPtr cluster, std::string table_name,
+                       std::vector<std::string> column_names,
+                       BufferedInserterSettings settings,
+                       InsertionBatchFactory batch_factory);
+  ~BufferedInserterBase();
+
+  BufferedInserterBase(const BufferedInserterBase&) = delete;
+
+  /// Waits while too many rows are pending, then calls `append` for the
+  /// current batch
+  void Append(USERVER_NAMESPACE::utils::function_ref<void(InsertionBatch&)>
+                  append);
+
+  void Flush();
+
+  void WriteStatistics(
+      USERVER_NAMESPACE::utils::statistics::Writer& writer) const;
+
+ private:
+  class Impl;
+  std::unique_ptr<Impl> impl_;
+};
+
+}  // namespace storages::clickhouse::impl
+
+USERVER_NAMESPACE_END
@@ -4,6 +4,7 @@
 /// @brief Options
 
 #include <chrono>
+#include <cstddef>
 #include <optional>
 
 USERVER_NAMESPACE_BEGIN
@@ -35,6 +36,23 @@ struct CommandControl final {
 /// @brief storages::clickhouse::CommandControl that may not be set.
 using OptionalCommandControl = std::optional<CommandControl>;
 
+/// Settings of storages::clickhouse::BufferedInserter
+struct BufferedInserterSettings final {
+  /// Rows count that triggers a flush without waiting for `max_delay`
+  std::size_t max_rows{100'000};
+
+  /// Max time the rows are buffered for
+  std::chrono::milliseconds max_delay{1000};
+
+  /// Rows count (both buffered and being flushed) after which Insert waits
+  /// for the flushes to complete, must not be less than `max_rows`: otherwise
+  /// the rows stop being added before a flush is triggered by their count
+  std::size_t max_pending_rows{1'000'000};
+
+  /// Command control of the flushes
+  OptionalCommandControl command_control{};
+};
+
 }  // namespace storages::clickhouse
 
 USERVER_NAMESPACE_END
@@ -0,0 +1,25 @@
+#include <userver/storages/clickhouse/block_cursor.hpp>
+
+#include <userver/utils/assert.hpp>
+
+#include <storages/clickhouse/impl/block_cursor_impl.hpp>
+
+USERVER_NAMESPACE_BEGIN
+
+namespace storages::clickhouse {
+
+BlockCursor::BlockCursor(std::unique_ptr<impl::BlockCursorImpl> impl)
+    : impl_{std::move(impl)} {}
+
+BlockCursor::BlockCursor(BlockCursor&&) noexcept = default;
+
+BlockCursor::~BlockCursor() = default;
+
+std::optional<ExecutionResult> BlockCursor::Next() {
+  UASSERT(impl_);
+  return impl_->Next();
+}
+
+}  // namespace storages::clickhouse
+
+USERVER_NAMESPACE_END
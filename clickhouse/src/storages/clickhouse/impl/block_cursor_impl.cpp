@@ -0,0 +1,26 @@
+#include "block_cursor_impl.hpp"
+
+#include <storages/clickhouse/impl/block_wrapper.hpp>
+
+USERVER_NAMESPACE_BEGIN
+
+namespace storages::clickhouse::impl {
+
+BlockCursorImpl::BlockCursorImpl(engine::TaskWithResult<void> producer_task,
+                                 Queue::Consumer consumer)
+    : producer_task_{std::move(producer_task)},
+      consumer_{std::move(consumer)} {}
+
+std::optional<ExecutionResult> BlockCursorImpl::Next() {
+  BlockWrapperPtr block;
+  if (consumer_.Pop(block)) return ExecutionResult{std::move(block)};
+
+  // The producer is gone: either the result is read till the end,
+  // or the query has failed
+  if (producer_task_.IsValid()) producer_task_.Get();
+  return std::nullopt;
+}
+
+}  // namespace storages::clickhouse::impl
+
+USERVER_NAMESPACE_END
@@ -0,0 +1,35 @@
+#pragma once
+
+#include <optional>
+
+#include <userver/concurrent/queue.hpp>
+#include <userver/engine/task/task_with_result.hpp>
+#include <userver/storages/clickhouse/execution_result.hpp>
+#include <userver/storages/clickhouse/impl/block_wrapper_fwd.hpp>
+
+USERVER_NAMESPACE_BEGIN
+
+namespace storages::clickhouse::impl {
+
+class BlockCursorImpl final {
+ public:
+  using Queue = concurrent::SpscQueue<BlockWrapperPtr>;
+
+  /// The number of blocks received ahead of the cursor consumer
+  static constexpr std::size_t kMaxBlocksInFlight = 2;
+
+  BlockCursorImpl(engine::TaskWithResult<void> producer_task,
+                  Queue::Consumer consumer);
+
+  std::optional<ExecutionResult> Next();
+
+ private:
+  engine::TaskWithResult<void> producer_task_;
+  // Destroyed first, so that the producer stops waiting for free space and
+  // cancels the query
+  Queue::Consumer consumer_;
+};
+
+}  // namespace storages::clickhouse::impl
+
+USERVER_NAMESPACE_END
@@ -0,0 +1,220 @@
+#include <userver/storages/clickhouse/impl/buffered_inserter_base.hpp>
+
+#include <mutex>
+#include <utility>
+
+#include <userver/engine/condition_variable.hpp>
+#include <userver/engine/exception.hpp>
+#include <userver/engine/mutex.hpp>
+#include <userver/engine/task/cancel.hpp>
+#include <userver/logging/log.hpp>
+#include <userver/storages/clickhouse/cluster.hpp>
+#include <userver/utils/assert.hpp>
+#include <userver/utils/periodic_task.hpp>
+#include <userver/utils/scope_guard.hpp>
+
+#include <storages/clickhouse/stats/buffered_inserter_statistics.hpp>
+#include <storages/clickhouse/stats/statement_timer.hpp>
+
+USERVER_NAMESPACE_BEGIN
+
+namespace storages::clickhouse::impl {
+
+namespace {
+
+std::vector<std::string_view> MakeViews(
+    const std::vector<std::string>& strings) {
+  return {strings.begin(), strings.end()};
+}
+
+}  // namespace
+
+class BufferedInserterBase::Impl final {
+ public:
+  Impl(ClusterPtr cluster, std::string table_name,
+       std::vector<std::string> column_names,
+       BufferedInserterSettings settings, InsertionBatchFactory batch_factory);
+  ~Impl();
+
+  void Append(
+      USERVER_NAMESPACE::utils::function_ref<void(InsertionBatch&)> append);
+
+  void Flush();
+
+  void WriteStatistics(
+      USERVER_NAMESPACE::utils::statistics::Writer& writer) const;
+
+ private:
+  enum class FlushReason { kExplicit, kBackground };
+
+  void DoFlush(FlushReason reason);
+  void FlushInBackground();
+
+  // Both the buffered rows and the rows being flushed
+  std::size_t GetPendingRows() const;
+  void UpdatePendingRows();
+
+  const ClusterPtr cluster_;
+  const std::string table_name_;
+  const std::vector<std::string> column_names_;
+  const std::vector<std::string_view> column_names_view_;
+  const BufferedInserterSettings settings_;
+  const InsertionBatchFactory batch_factory_;
+
+  engine::Mutex mutex_;
+  engine::ConditionVariable rows_flushed_cv_;
+  std::unique_ptr<InsertionBatch> batch_;
+  std::size_t flushing_rows_{0};
+  bool size_flush_requested_{false};
+
+  // Flushes go one at a time, so that the rows are sent in the order
+  // they were inserted
+  engine::Mutex flush_mutex_;
+
+  stats::BufferedInserterStatistics stats_;
+
+  USERVER_NAMESPACE::utils::PeriodicTask flush_task_;
+};
+
+BufferedInserterBase::Impl::Impl(ClusterPtr cluster, std::string table_name,
+                                 std::vector<std::string> column_names,
+                                 BufferedInserterSettings settings,
+                                 InsertionBatchFactory batch_factory)
+    : cluster_{std::move(cluster)},
+      table_name_{std::move(table_name)},
+      column_names_{std::move(column_names)},
+      column_names_view_{MakeViews(column_names_)},
+      settings_{settings},
+      batch_factory_{std::move(batch_factory)} {
+  UINVARIANT(cluster_, "BufferedInserter requires a cluster");
+  UINVARIANT(settings_.max_rows > 0, "max_rows must be positive");
+  UINVARIANT(settings_.max_pending_rows >= settings_.max_rows,
+             "max_pending_rows must not be less than max_rows");
+
+  flush_task_.Start("clickhouse_buffered_insert_" + table_name_,
+                    {settings_.max_delay}, [this] { FlushInBackground(); });
+}
+
+BufferedInserterBase::Impl::~Impl() {
+  flush_task_.Stop();
+
+  try {
+    DoFlush(FlushReason::kExplicit);
+  } catch (const std::exception& ex) {
+    LOG_ERROR() << "Failed to flush the rows buffered for '" << table_name_
+                << "' on shutdown: " << ex;
+  }
+}
+
+void BufferedInserterBase::Impl::Append(
+    USERVER_NAMESPACE::utils::function_ref<void(InsertionBatch&)> append) {
+  std::unique_lock lock{mutex_};
+
+  if (GetPendingRows() >= settings_.max_pending_rows) {
+    ++stats_.backpressure_waits;
+    const bool flushed = rows_flushed_cv_.Wait(lock, [this] {
+      return GetPendingRows() < settings_.max_pending_rows;
+    });
+    if (!flushed) {
+      throw engine::WaitInterruptedException(
+          engine::current_task::CancellationReason());
+    }
+  }
+
+  if (!batch_) batch_ = batch_factory_();
+  const USERVER_NAMESPACE::utils::ScopeGuard update_guard{
+      [this] { UpdatePendingRows(); }};
+  append(*batch_);
+
+  if (batch_->GetRowsCount() >= settings_.max_rows && !size_flush_requested_) {
+    size_flush_requested_ = true;
+    flush_task_.ForceStepAsync();
+  }
+}
+
+void BufferedInserterBase::Impl::Flush() { DoFlush(FlushReason::kExplicit); }
+
+void BufferedInserterBase::Impl::WriteStatistics(
+    USERVER_NAMESPACE::utils::statistics::Writer& writer) const {
+  writer.ValueWithLabels(stats_, {{"clickhouse_table", table_name_}});
+}
+
+void BufferedInserterBase::Impl::DoFlush(FlushReason reason) {
+  const std::lock_guard flush_lock{flush_mutex_};
+
+  std::unique_ptr<InsertionBatch> batch;
+  {
+    const std::lock_guard lock{mutex_};
+    batch = std::move(batch_);
+    const bool by_size = std::exchange(size_flush_requested_, false);
+    if (!batch) return;
+
+    if (reason == FlushReason::kBackground) {
+      ++(by_size ? stats_.size_flushes : stats_.time_flushes);
+    }
+    flushing_rows_ = batch->GetRowsCount();
+  }
+
+  const auto rows_count = batch->GetRowsCount();
+  const USERVER_NAMESPACE::utils::ScopeGuard flushed_guard{[this] {
+    {
+      const std::lock_guard lock{mutex_};
+      flushing_rows_ = 0;
+      UpdatePendingRows();
+    }
+    rows_flushed_cv_.NotifyAll();
+  }};
+
+  try {
+    const stats::StatementTimer timer{stats_.flushes};
+    batch->Insert(*cluster_, settings_.command_control, table_name_,
+                  column_names_view_);
+  } catch (const std::exception&) {
+    stats_.rows_dropped += rows_count;
+    throw;
+  }
+  stats_.rows_inserted += rows_count;
+}
+
+void BufferedInserterBase::Impl::FlushInBackground() {
+  try {
+    DoFlush(FlushReason::kBackground);
+  } catch (const std::exception& ex) {
+    LOG_ERROR() << "Failed to insert the rows buffered for '" << table_name_
+                << "', the rows are dropped: " << ex;
+  }
+}
+
+std::size_t BufferedInserterBase::Impl::GetPendingRows() const {
+  return flushing_rows_ + (batch_ ? batch_->GetRowsCount() : 0);
+}
+
+void BufferedInserterBase::Impl::UpdatePendingRows() {
+  stats_.pending_rows = GetPendingRows();
+}
+
+BufferedInserterBase::BufferedInserterBase(
+    ClusterPtr cluster, std::string table_name,
+    std::vector<std::string> column_names, BufferedInserterSettings settings,
+    InsertionBatchFactory batch_factory)
+    : impl_{std::make_unique<Impl>(std::move(cluster), std::move(table_name),
+                                   std::move(column_names), settings,
+                                   std::move(batch_factory))} {}
+
+BufferedInserterBase::~BufferedInserterBase() = default;
+
+void BufferedInserterBase::Append(
+    USERVER_NAMESPACE::utils::function_ref<void(InsertionBatch&)> append) {
+  impl_->Append(append);
+}
+
+void BufferedInserterBase::Flush() { impl_->Flush(); }
+
+void BufferedInserterBase::WriteStatistics(
+    USERVER_NAMESPACE::utils::statistics::Writer& writer) const {
+  impl_->WriteStatistics(writer);
+}
+
+}  // namespace storages::clickhouse::impl
+
+USERVER_NAMESPACE_END
@@ -104,6 +104,25 @@ ExecutionResult Connection::Execute(OptionalCommandControl optional_cc,
   return ExecutionResult{BlockWrapperPtr{result_ptr.release()}};
 }
 
+void Connection::ExecuteStreaming(OptionalCommandControl optional_cc,
+                                  const Query& query,
+                                  BlockConsumer on_block) {
+  const auto deadline = GetDeadline(optional_cc);
+
+  clickhouse_cpp::Query native_query{query.QueryText()};
+  native_query.OnDataCancelable(
+      [on_block, deadline](const NativeBlock& block) {
+        // we must return 'true' if we don't want to cancel query
+        if (engine::current_task::ShouldCancel()) return false;
+        if (block.GetRowCount() == 0) return true;
+
+        auto block_ptr = std::make_unique<BlockWrapper>(NativeBlock{block});
+        return on_block(BlockWrapperPtr{block_ptr.release()}, deadline);
+      });
+
+  DoExecute(optional_cc, native_query);
+}
+
 void Connection::Insert(OptionalCommandControl optional_cc,
                         const InsertionRequest& request) {
   const auto& block = request.GetBlock();
@@ -3,8 +3,11 @@
 #include <storages/clickhouse/impl/wrap_clickhouse_cpp.hpp>
 
 #include <userver/clients/dns/resolver_fwd.hpp>
+#include <userver/engine/deadline.hpp>
 #include <userver/storages/clickhouse/execution_result.hpp>
+#include <userver/storages/clickhouse/impl/block_wrapper_fwd.hpp>
 #include <userver/storages/clickhouse/options.hpp>
+#include <userver/utils/function_ref.hpp>
 
 #include <storages/clickhouse/impl/native_client_factory.hpp>
 
@@ -28,6 +31,16 @@ class Connection final {
 
   ExecutionResult Execute(OptionalCommandControl, const Query&);
 
+  using BlockConsumer =
+      USERVER_NAMESPACE::utils::function_ref<bool(BlockWrapperPtr&&,
+                                                  engine::Deadline)>;
+
+  /// Passes the non-empty blocks of the result to `on_block` along with the
+  /// query deadline as soon as they are received, the query is cancelled once
+  /// `on_block` returns false.
+  void ExecuteStreaming(OptionalCommandControl, const Query&,
+                        BlockConsumer on_block);
+
   void Insert(OptionalCommandControl, const InsertionRequest&);
 
   void Ping();
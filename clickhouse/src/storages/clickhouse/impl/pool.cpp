@@ -2,9 +2,12 @@
 
 #include <userver/storages/clickhouse/query.hpp>
 
+#include <userver/engine/io/exception.hpp>
 #include <userver/tracing/span.hpp>
 #include <userver/tracing/tags.hpp>
+#include <userver/utils/async.hpp>
 
+#include <storages/clickhouse/impl/block_cursor_impl.hpp>
 #include <storages/clickhouse/impl/connection.hpp>
 #include <storages/clickhouse/impl/connection_ptr.hpp>
 #include <storages/clickhouse/impl/pool_impl.hpp>
@@ -45,6 +48,43 @@ ExecutionResult Pool::Execute(OptionalCommandControl optional_cc,
   return conn_ptr->Execute(optional_cc, query);
 }
 
+BlockCursor Pool::ExecuteStreaming(OptionalCommandControl optional_cc,
+                                   const Query& query) const {
+  auto conn_ptr = impl_->Acquire();
+  auto queue =
+      BlockCursorImpl::Queue::Create(BlockCursorImpl::kMaxBlocksInFlight);
+
+  auto producer_task = USERVER_NAMESPACE::utils::Async(
+      "clickhouse_streaming",
+      [pool = impl_, conn_ptr = std::move(conn_ptr),
+       producer = queue->GetProducer(), optional_cc, query]() mutable {
+        // the connection and the producer are released as soon as the query
+        // completes, not when the cursor is destroyed
+        auto connection = std::move(conn_ptr);
+        auto block_producer = std::move(producer);
+
+        auto span =
+            PrepareExecutionSpan(impl::scopes::kQuery, pool->GetHostName());
+        query.FillSpanTags(span);
+
+        const auto timer = pool->GetExecuteTimer();
+        connection->ExecuteStreaming(
+            optional_cc, query,
+            [&block_producer](BlockWrapperPtr&& block,
+                              engine::Deadline deadline) {
+              if (block_producer.Push(std::move(block), deadline)) return true;
+              // the cursor is gone, no one waits for the rest of the result
+              if (!deadline.IsReached()) return false;
+              // the consumer is too slow, the connection is left in the middle
+              // of the result and is dropped
+              throw engine::io::IoTimeout{};
+            });
+      });
+
+  return BlockCursor{std::make_unique<BlockCursorImpl>(std::move(producer_task),
+                                                       queue->GetConsumer())};
+}
+
 void Pool::Insert(OptionalCommandControl optional_cc,
                   const InsertionRequest& request) const {
   auto conn_ptr = impl_->Acquire();
@@ -0,0 +1,24 @@
+#include "buffered_inserter_statistics.hpp"
+
+#include <userver/utils/statistics/percentile_format_json.hpp>
+
+USERVER_NAMESPACE_BEGIN
+
+namespace storages::clickhouse::stats {
+
+void DumpMetric(USERVER_NAMESPACE::utils::statistics::Writer& writer,
+                const BufferedInserterStatistics& stats) {
+  writer["flushes"] = stats.flushes;
+  writer["size_flushes"] = stats.size_flushes;
+  writer["time_flushes"] = stats.time_flushes;
+
+  writer["rows"]["inserted"] = stats.rows_inserted;
+  writer["rows"]["dropped"] = stats.rows_dropped;
+  writer["rows"]["pending"] = stats.pending_rows;
+
+  writer["backpressure_waits"] = stats.backpressure_waits;
+}
+
+}  // namespace storages::clickhouse::stats
+
+USERVER_NAMESPACE_END
@@ -0,0 +1,25 @@
+#pragma once
+
+#include <storages/clickhouse/stats/pool_statistics.hpp>
+
+USERVER_NAMESPACE_BEGIN
+
+namespace storages::clickhouse::stats {
+
+struct BufferedInserterStatistics final {
+  PoolQueryStatistics flushes{};
+  Counter size_flushes{};
+  Counter time_flushes{};
+
+  Counter rows_inserted{};
+  Counter rows_dropped{};
+  Counter pending_rows{};
+  Counter backpressure_waits{};
+};
+
+void DumpMetric(USERVER_NAMESPACE::utils::statistics::Writer& writer,
+                const BufferedInserterStatistics& stats);
+
+}  // namespace storages::clickhouse::stats
+
+USERVER_NAMESPACE_END
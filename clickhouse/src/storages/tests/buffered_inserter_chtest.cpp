@@ -0,0 +1,209 @@
+#include <userver/utest/utest.hpp>
+
+#include <userver/engine/async.hpp>
+#include <userver/engine/sleep.hpp>
+#include <userver/storages/clickhouse/buffered_inserter.hpp>
+#include <userver/utils/statistics/storage.hpp>
+#include <userver/utils/statistics/testing.hpp>
+
+#include "utils_test.hpp"
+
+USERVER_NAMESPACE_BEGIN
+
+namespace {
+
+struct Row final {
+  uint64_t value;
+};
+
+struct Count final {
+  std::vector<uint64_t> count;
+};
+
+using Inserter = storages::clickhouse::BufferedInserter<Row>;
+
+// Background flushes may use any connection of the pool,
+// so the tests use regular tables instead of temporary ones
+void CreateTable(storages::clickhouse::Cluster& cluster,
+                 const std::string& table) {
+  cluster.Execute("DROP TABLE IF EXISTS " + table);
+  cluster.Execute("CREATE TABLE " + table +
+                  " (value UInt64) ENGINE = Memory");
+}
+
+uint64_t CountRows(storages::clickhouse::Cluster& cluster,
+                   const std::string& table) {
+  return cluster.Execute("SELECT count() FROM " + table)
+      .As<Count>()
+      .count.at(0);
+}
+
+storages::clickhouse::ClusterPtr MakeNonOwning(ClusterWrapper& cluster) {
+  return {std::shared_ptr<void>{}, &*cluster};
+}
+
+class InserterStatistics final {
+ public:
+  explicit InserterStatistics(Inserter& inserter)
+      : holder_{storage_.RegisterWriter(
+            kPrefix,
+            [&inserter](utils::statistics::Writer& writer) {
+              inserter.WriteStatistics(writer);
+            })} {}
+
+  ~InserterStatistics() { holder_.Unregister(); }
+
+  utils::statistics::Snapshot Get(const std::string& prefix = {}) {
+    return utils::statistics::Snapshot{
+        storage_, prefix.empty() ? kPrefix : kPrefix + '.' + prefix};
+  }
+
+ private:
+  inline static const std::string kPrefix = "buffered_inserter";
+
+  utils::statistics::Storage storage_;
+  utils::statistics::Entry holder_;
+};
+
+}  // namespace
+
+namespace storages::clickhouse::io {
+
+template <>
+struct CppToClickhouse<Row> final {
+  using mapped_type = std::tuple<columns::UInt64Column>;
+};
+
+template <>
+struct CppToClickhouse<Count> final {
+  using mapped_type = std::tuple<columns::UInt64Column>;
+};
+
+}  // namespace storages::clickhouse::io
+
+UTEST(BufferedInserter, FlushesBySize) {
+  ClusterWrapper cluster{};
+  CreateTable(*cluster, "buffered_by_size");
+
+  storages::clickhouse::BufferedInserterSettings settings;
+  settings.max_rows = 100;
+  settings.max_delay = std::chrono::hours{1};
+
+  Inserter inserter{MakeNonOwning(cluster), "buffered_by_size", {"value"},
+                    settings};
+  InserterStatistics statistics{inserter};
+
+  std::vector<engine::TaskWithResult<void>> tasks;
+  for (uint64_t task = 0; task < 5; ++task) {
+    tasks.push_back(engine::AsyncNoSpan([&inserter, task] {
+      for (uint64_t i = 0; i < 50; ++i) inserter.Insert({task * 50 + i});
+    }));
+  }
+  for (auto& task : tasks) task.Get();
+
+  // size flushes send whole batches, the tail is sent by the explicit flush
+  inserter.Flush();
+  EXPECT_EQ(CountRows(*cluster, "buffered_by_size"), 250);
+
+  const auto flushes = statistics.Get();
+  EXPECT_GE(flushes.SingleMetric("size_flushes").AsInt(), 1);
+  EXPECT_EQ(flushes.SingleMetric("time_flushes").AsInt(), 0);
+  EXPECT_EQ(flushes.SingleMetric("flushes.error").AsInt(), 0);
+
+  const auto rows = statistics.Get("rows");
+  EXPECT_EQ(rows.SingleMetric("inserted").AsInt(), 250);
+  EXPECT_EQ(rows.SingleMetric("dropped").AsInt(), 0);
+  EXPECT_EQ(rows.SingleMetric("pending").AsInt(), 0);
+}
+
+UTEST(BufferedInserter, FlushesByTime) {
+  ClusterWrapper cluster{};
+  CreateTable(*cluster, "buffered_by_time");
+
+  storages::clickhouse::BufferedInserterSettings settings;
+  settings.max_delay = std::chrono::milliseconds{50};
+
+  Inserter inserter{MakeNonOwning(cluster), "buffered_by_time", {"value"},
+                    settings};
+  inserter.InsertRows(std::vector<Row>{{1}, {2}, {3}});
+
+  for (int i = 0; i < 100; ++i) {
+    if (CountRows(*cluster, "buffered_by_time") == 3) break;
+    engine::SleepFor(std::chrono::milliseconds{20});
+  }
+  EXPECT_EQ(CountRows(*cluster, "buffered_by_time"), 3);
+}
+
+UTEST(BufferedInserter, FlushesOnDestruction) {
+  ClusterWrapper cluster{};
+  CreateTable(*cluster, "buffered_on_destruction");
+
+  {
+    storages::clickhouse::BufferedInserterSettings settings;
+    settings.max_delay = std::chrono::hours{1};
+
+    Inserter inserter{MakeNonOwning(cluster), "buffered_on_destruction",
+                      {"value"}, settings};
+    inserter.Insert({1});
+    inserter.Insert({2});
+  }
+
+  EXPECT_EQ(CountRows(*cluster, "buffered_on_destruction"), 2);
+}
+
+UTEST(BufferedInserter, Backpressure) {
+  ClusterWrapper cluster{};
+  CreateTable(*cluster, "buffered_backpressure");
+
+  storages::clickhouse::BufferedInserterSettings settings;
+  settings.max_rows = 20;
+  settings.max_delay = std::chrono::hours{1};
+  settings.max_pending_rows = 50;
+
+  Inserter inserter{MakeNonOwning(cluster), "buffered_backpressure",
+                    {"value"}, settings};
+  InserterStatistics statistics{inserter};
+
+  for (uint64_t i = 0; i < 200; ++i) inserter.Insert({i});
+  inserter.Flush();
+
+  EXPECT_EQ(CountRows(*cluster, "buffered_backpressure"), 200);
+  EXPECT_GT(statistics.Get().SingleMetric("backpressure_waits").AsInt(), 0);
+}
+
+UTEST_DEATH(BufferedInserterDeathTest, InvalidSettings) {
+  ClusterWrapper cluster{};
+
+  storages::clickhouse::BufferedInserterSettings settings;
+  settings.max_rows = 20;
+  settings.max_pending_rows = 10;
+  EXPECT_UINVARIANT_FAILURE(Inserter(MakeNonOwning(cluster),
+                                     "buffered_invalid", {"value"}, settings));
+
+  settings.max_rows = 0;
+  settings.max_pending_rows = 0;
+  EXPECT_UINVARIANT_FAILURE(Inserter(MakeNonOwning(cluster),
+                                     "buffered_invalid", {"value"}, settings));
+}
+
+UTEST(BufferedInserter, FailedFlushDropsRows) {
+  ClusterWrapper cluster{};
+  cluster->Execute("DROP TABLE IF EXISTS buffered_nonexistent");
+
+  storages::clickhouse::BufferedInserterSettings settings;
+  settings.max_delay = std::chrono::hours{1};
+
+  Inserter inserter{MakeNonOwning(cluster), "buffered_nonexistent", {"value"},
+                    settings};
+  InserterStatistics statistics{inserter};
+
+  inserter.Insert({1});
+  EXPECT_ANY_THROW(inserter.Flush());
+  // the failed rows are not retried
+  EXPECT_NO_THROW(inserter.Flush());
+
+  EXPECT_EQ(statistics.Get("flushes").SingleMetric("error").AsInt(), 1);
+  EXPECT_EQ(statistics.Get("rows").SingleMetric("dropped").AsInt(), 1);
+}
+
+USERVER_NAMESPACE_END
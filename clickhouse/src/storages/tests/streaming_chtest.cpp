@@ -0,0 +1,92 @@
+#include <userver/utest/utest.hpp>
+
+#include <userver/engine/sleep.hpp>
+#include <userver/storages/clickhouse/block_cursor.hpp>
+#include <userver/storages/clickhouse/query.hpp>
+
+#include "utils_test.hpp"
+
+USERVER_NAMESPACE_BEGIN
+
+namespace {
+
+struct Numbers final {
+  std::vector<uint64_t> numbers;
+};
+
+const storages::clickhouse::Query kNumbersQuery{
+    "SELECT number FROM system.numbers LIMIT {} "
+    "SETTINGS max_block_size = 1000"};
+
+}  // namespace
+
+namespace storages::clickhouse::io {
+
+template <>
+struct CppToClickhouse<Numbers> final {
+  using mapped_type = std::tuple<columns::UInt64Column>;
+};
+
+}  // namespace storages::clickhouse::io
+
+UTEST(Streaming, ReadsAllBlocks) {
+  ClusterWrapper cluster{};
+
+  /// [Sample BlockCursor usage]
+  auto cursor = cluster->ExecuteStreaming(kNumbersQuery, 100000);
+
+  std::size_t blocks = 0;
+  uint64_t expected = 0;
+  while (auto block = cursor.Next()) {
+    const auto data = std::move(*block).As<Numbers>();
+    for (const auto number : data.numbers) {
+      EXPECT_EQ(number, expected++);
+    }
+    ++blocks;
+  }
+  /// [Sample BlockCursor usage]
+
+  EXPECT_EQ(expected, 100000);
+  EXPECT_GT(blocks, 1);
+  EXPECT_FALSE(cursor.Next().has_value());
+}
+
+UTEST(Streaming, EmptyResult) {
+  ClusterWrapper cluster{};
+
+  auto cursor = cluster->ExecuteStreaming(kNumbersQuery, 0);
+  EXPECT_FALSE(cursor.Next().has_value());
+}
+
+UTEST(Streaming, Errors) {
+  ClusterWrapper cluster{};
+
+  auto cursor = cluster->ExecuteStreaming(
+      storages::clickhouse::Query{"SELECT * FROM nonexistent_table"});
+  EXPECT_ANY_THROW(cursor.Next());
+}
+
+UTEST(Streaming, EarlyDestructionReleasesConnection) {
+  ClusterWrapper cluster{};
+
+  for (std::size_t i = 0; i < 10; ++i) {
+    auto cursor = cluster->ExecuteStreaming(kNumbersQuery, 10000000);
+    EXPECT_TRUE(cursor.Next().has_value());
+  }
+
+  const auto result = cluster->Execute(kNumbersQuery, 10).As<Numbers>();
+  EXPECT_EQ(result.numbers.size(), 10);
+}
+
+UTEST(Streaming, SlowConsumerTimesOut) {
+  ClusterWrapper cluster{};
+
+  storages::clickhouse::CommandControl cc{std::chrono::milliseconds{200}};
+  auto cursor = cluster->ExecuteStreaming(cc, kNumbersQuery, 10000000);
+  EXPECT_TRUE(cursor.Next().has_value());
+
+  engine::SleepFor(std::chrono::milliseconds{300});
+  EXPECT_ANY_THROW(while (cursor.Next()) {});
+}
+
+USERVER_NAMESPACE_END
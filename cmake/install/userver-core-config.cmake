@@ -19,6 +19,9 @@ find_package(ZLIB REQUIRED)
 list(APPEND CMAKE_MODULE_PATH "${CMAKE_CURRENT_LIST_DIR}/..")
 find_package(Nghttp2 REQUIRED)
 find_package(LibEv REQUIRED)
+if (USERVER_IMPL_FEATURE_IO_URING)
+  find_package(liburing REQUIRED)
+endif()
 
 include("${USERVER_CMAKE_DIR}/UserverTestsuite.cmake")
 include("${USERVER_CMAKE_DIR}/Findc-ares.cmake")
@@ -3,6 +3,7 @@
 #include <userver/components/component_context.hpp>
 #include <userver/dynamic_config/storage/component.hpp>
 #include <userver/engine/sleep.hpp>
+#include <userver/http/common_headers.hpp>
 #include <userver/server/handlers/http_handler_base.hpp>
 #include <userver/server/handlers/json_error_builder.hpp>
 #include <userver/server/http/http_response_body_stream.hpp>
@@ -63,4 +64,36 @@ class HttpServerHandler final : public server::handlers::HttpHandlerBase {
   }
 };
 
+class CompressionHandler final : public server::handlers::HttpHandlerBase {
+ public:
+  static constexpr std::string_view kName = "handler-compression";
+
+  CompressionHandler(const components::ComponentConfig& config,
+                     const components::ComponentContext& context)
+      : HttpHandlerBase(config, context) {}
+
+  std::string HandleRequestThrow(
+      const server::http::HttpRequest& request,
+      server::request::RequestContext&) const override {
+    request.GetHttpResponse().SetHeader(http::headers::kContentType,
+                                        request.GetArg("content_type"));
+    return std::string(std::stoul(request.GetArg("size")), 'a');
+  }
+
+  void HandleStreamRequest(
+      const server::http::HttpRequest& request,
+      server::request::RequestContext&,
+      server::http::ResponseBodyStream& response_body_stream) const override {
+    response_body_stream.SetHeader(std::string{http::headers::kContentType},
+                                   request.GetArg("content_type"));
+    response_body_stream.SetEndOfHeaders();
+
+    const auto size = std::stoul(request.GetArg("size"));
+    for (std::size_t i = 0; i < std::stoul(request.GetArg("parts")); ++i) {
+      response_body_stream.PushBodyChunk(std::string(size, 'a' + i % 26),
+                                         engine::Deadline());
+    }
+  }
+};
+
 }  // namespace chaos
@@ -23,6 +23,8 @@ int main(int argc, char* argv[]) {
           .Append<chaos::HttpClientHandler>()
           .Append<chaos::StreamHandler>()
           .Append<chaos::HttpServerHandler>()
+          .Append<chaos::CompressionHandler>()
+          .Append<chaos::CompressionHandler>("handler-compression-stream")
           .Append<chaos::ResolverHandler>()
           .Append<components::LoggingConfigurator>()
           .Append<components::HttpClient>()
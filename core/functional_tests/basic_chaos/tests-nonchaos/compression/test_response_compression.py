@@ -0,0 +1,115 @@
+import gzip
+
+import aiohttp
+import pytest
+
+try:
+    import zstandard as zstd
+except ImportError:
+    import zstd
+
+
+def _decompress(encoding, data):
+    if encoding == 'gzip':
+        return gzip.decompress(data)
+    if encoding == 'zstd':
+        if hasattr(zstd, 'ZstdDecompressor'):
+            # Streamed responses have no content size in the frame header
+            return zstd.ZstdDecompressor().decompressobj().decompress(data)
+        return zstd.decompress(data)
+    assert encoding is None
+    return data
+
+
+@pytest.fixture(name='fetch')
+def _fetch(service_client, service_baseurl):
+    async def _fetch(path, accept_encoding, **params):
+        # The body is checked as it is sent by the service
+        async with aiohttp.ClientSession(auto_decompress=False) as session:
+            async with session.get(
+                    service_baseurl + path,
+                    params=params,
+                    headers={'Accept-Encoding': accept_encoding},
+            ) as response:
+                assert response.status == 200
+                return response.headers, await response.read()
+
+    return _fetch
+
+
+@pytest.mark.parametrize(
+    'accept_encoding, expected_encoding',
+    [
+        ('gzip', 'gzip'),
+        ('zstd', 'zstd'),
+        ('gzip, deflate, br, zstd', 'zstd'),
+        ('zstd;q=0.5, gzip', 'gzip'),
+        ('*', 'zstd'),
+        ('br', None),
+        ('identity', None),
+        ('', None),
+    ],
+)
+async def test_negotiation(fetch, accept_encoding, expected_encoding):
+    headers, body = await fetch(
+        'compression',
+        accept_encoding,
+        size='1000',
+        content_type='application/json',
+    )
+    assert headers.get('Content-Encoding') == expected_encoding
+    assert _decompress(expected_encoding, body) == b'a' * 1000
+    if expected_encoding:
+        assert len(body) < 1000
+        assert headers['Vary'] == 'Accept-Encoding'
+        assert int(headers['Content-Length']) == len(body)
+
+
+async def test_small_body(fetch):
+    headers, body = await fetch(
+        'compression', 'gzip', size='99', content_type='application/json',
+    )
+    assert 'Content-Encoding' not in headers
+    # The response still depends on Accept-Encoding
+    assert headers['Vary'] == 'Accept-Encoding'
+    assert body == b'a' * 99
+
+
+async def test_not_compressible_content_type(fetch):
+    headers, body = await fetch(
+        'compression', 'gzip', size='1000', content_type='image/png',
+    )
+    assert 'Content-Encoding' not in headers
+    assert 'Vary' not in headers
+    assert body == b'a' * 1000
+
+
+@pytest.mark.parametrize('encoding', ['gzip', 'zstd'])
+async def test_stream_round_trip(fetch, encoding):
+    headers, body = await fetch(
+        'compression/stream',
+        encoding,
+        size='500',
+        parts='10',
+        content_type='text/plain',
+    )
+    assert headers['Content-Encoding'] == encoding
+    assert headers['Vary'] == 'Accept-Encoding'
+    assert headers['Transfer-Encoding'] == 'chunked'
+    assert 'Content-Length' not in headers
+
+    expected = b''.join(bytes([ord('a') + i]) * 500 for i in range(10))
+    assert _decompress(encoding, body) == expected
+    assert len(body) < len(expected)
+
+
+async def test_stream_not_compressible(fetch):
+    headers, body = await fetch(
+        'compression/stream',
+        'gzip',
+        size='10',
+        parts='2',
+        content_type='image/png',
+    )
+    assert 'Content-Encoding' not in headers
+    assert body == b'a' * 10 + b'b' * 10
@@ -90,10 +90,33 @@ class WebsocketsFullDuplexHandler final
   }
 };
 
+class WebsocketsDeflateHandler final
+    : public server::websocket::WebsocketHandlerBase {
+ public:
+  static constexpr std::string_view kName = "websocket-deflate-handler";
+
+  using WebsocketHandlerBase::WebsocketHandlerBase;
+
+  void Handle(server::websocket::WebSocketConnection& chat,
+              server::request::RequestContext&) const override {
+    server::websocket::Message message;
+    while (!engine::current_task::ShouldCancel()) {
+      chat.Recv(message);
+      if (message.close_status) break;
+
+      // Echo each message twice, the second time as a prepared one
+      chat.Send(message);
+      chat.SendPrepared(PrepareMessage(message.data, message.is_text));
+    }
+    if (message.close_status) chat.Close(*message.close_status);
+  }
+};
+
 int main(int argc, char* argv[]) {
   const auto component_list = components::MinimalServerComponentList()
                                   .Append<WebsocketsHandler>()
                                   .Append<WebsocketsFullDuplexHandler>()
+                                  .Append<WebsocketsDeflateHandler>()
                                   .Append<clients::dns::Component>()
                                   .Append<components::HttpClient>()
                                   .Append<components::TestsuiteSupport>()
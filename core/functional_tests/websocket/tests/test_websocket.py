@@ -97,3 +97,22 @@ async def test_two(websocket_client):
             for _ in range(10):
                 msg = await chat1.recv()
                 assert msg == b'A'
+
+
+async def test_deflate(websocket_client):
+    async with websocket_client.get('deflate') as chat:
+        assert chat.response_headers['Sec-WebSocket-Extensions'] == (
+            'permessage-deflate; server_no_context_takeover'
+        )
+        for msg in ('short', 'hello' * 10000, 'x' * 90000):
+            await chat.send(msg)
+            assert await chat.recv() == msg
+            assert await chat.recv() == msg
+
+
+async def test_deflate_binary(websocket_client):
+    async with websocket_client.get('deflate') as chat:
+        msg = bytes(range(256)) * 100
+        await chat.send(msg)
+        assert await chat.recv() == msg
+        assert await chat.recv() == msg
@@ -26,6 +26,9 @@ struct UpdateStatistics final {
   utils::statistics::RateCounter documents_read_count{0};
   utils::statistics::RateCounter documents_parse_failures{0};
 
+  utils::statistics::RateCounter chunks_count{0};
+  std::atomic<std::chrono::milliseconds> last_update_max_chunk_duration{{}};
+
   std::atomic<std::chrono::steady_clock::time_point> last_update_start_time{{}};
   std::atomic<std::chrono::steady_clock::time_point>
       last_successful_update_start_time{{}};
@@ -88,6 +91,13 @@ class UpdateStatisticsScope final {
   /// @param add the number of non-valid items newly received
   void IncreaseDocumentsParseFailures(std::size_t add);
 
+  /// @brief Caches that load the data in several chunks should account each
+  /// of them with this function
+  /// @note This method is thread-safe and can be called multiple times per
+  /// `Update`
+  /// @param duration the time it took to load the chunk
+  void AccountChunk(std::chrono::milliseconds duration);
+
  private:
   void DoFinish(impl::UpdateState new_state);
 
@@ -95,6 +105,7 @@ class UpdateStatisticsScope final {
   impl::UpdateStatistics& update_stats_;
   impl::UpdateState state_{impl::UpdateState::kNotFinished};
   const std::chrono::steady_clock::time_point update_start_time_;
+  std::atomic<std::chrono::milliseconds> max_chunk_duration_{{}};
 };
 
 }  // namespace cache
@@ -68,10 +68,11 @@ class ExpirableLruCache final {
     kUseCache,   ///< Cache value got from update function
   };
 
-  /// For the description of `ways` and `way_size`,
+  /// For the description of `ways`, `way_size` and `policy`,
   /// see the cache::NWayLRU::NWayLRU constructor.
   ExpirableLruCache(size_t ways, size_t way_size, const Hash& hash = Hash(),
-                    const Equal& equal = Equal());
+                    const Equal& equal = Equal(),
+                    CachePolicy policy = CachePolicy::kLru);
 
   ~ExpirableLruCache();
 
@@ -171,8 +172,9 @@ class ExpirableLruCache final {
 
 template <typename Key, typename Value, typename Hash, typename Equal>
 ExpirableLruCache<Key, Value, Hash, Equal>::ExpirableLruCache(
-    size_t ways, size_t way_size, const Hash& hash, const Equal& equal)
-    : lru_(ways, way_size, hash, equal),
+    size_t ways, size_t way_size, const Hash& hash, const Equal& equal,
+    CachePolicy policy)
+    : lru_(ways, way_size, hash, equal, policy),
       mutex_set_{ways, way_size, hash, equal} {}
 
 template <typename Key, typename Value, typename Hash, typename Equal>
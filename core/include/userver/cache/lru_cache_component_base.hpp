@@ -58,6 +58,7 @@ yaml_config::Schema GetLruCacheComponentBaseSchema();
 /// size | max amount of items to store in cache | --
 /// ways | number of ways for associative cache | --
 /// lifetime | TTL for cache entries (0 is unlimited) | 0
+/// policy | eviction policy, `lru` or `tinylfu` (see cache::CachePolicy) | lru
 /// config-settings | enables dynamic reconfiguration with CacheConfigSet | true
 ///
 /// ## Example usage:
@@ -129,7 +130,8 @@ LruCacheComponent<Key, Value, Hash, Equal>::LruCacheComponent(
       name_(components::GetCurrentComponentName(config)),
       static_config_(config),
       cache_(std::make_shared<Cache>(static_config_.ways,
-                                     static_config_.GetWaySize())) {
+                                     static_config_.GetWaySize(), Hash{},
+                                     Equal{}, static_config_.policy)) {
   if (impl::IsDumpSupportEnabled(config)) {
     dumper_ = std::make_shared<dump::Dumper>(
         config, context, static_cast<dump::DumpableEntity&>(*this));
@@ -2,14 +2,20 @@
 
 #include <functional>
 #include <optional>
+#include <shared_mutex>
+#include <type_traits>
+#include <variant>
 #include <vector>
 
 #include <boost/container_hash/hash.hpp>
 
+#include <userver/cache/impl/tinylfu.hpp>
 #include <userver/cache/lru_map.hpp>
+#include <userver/cache/policy.hpp>
 #include <userver/dump/dumper.hpp>
 #include <userver/dump/operations.hpp>
 #include <userver/engine/mutex.hpp>
+#include <userver/engine/shared_mutex.hpp>
 
 USERVER_NAMESPACE_BEGIN
 
@@ -33,8 +39,11 @@ class NWayLRU final {
   /// according to the LRU policy.
   ///
   /// The maximum total number of elements is `ways * way_size`.
+  ///
+  /// @param policy is the eviction policy of each way, see cache::CachePolicy
   NWayLRU(size_t ways, size_t way_size, const Hash& hash = Hash(),
-          const Equal& equal = Equal());
+          const Equal& equal = Equal(),
+          CachePolicy policy = CachePolicy::kLru);
 
   void Put(const T& key, U value);
 
@@ -69,43 +78,86 @@ class NWayLRU final {
   void SetDumper(std::shared_ptr<dump::Dumper> dumper);
 
  private:
+  template <typename Cache, typename Mutex>
   struct Way {
     Way(Way&& other) noexcept : cache(std::move(other.cache)) {}
 
     // max_size is not used, will be reset by Resize() in NWayLRU::NWayLRU
     Way(const Hash& hash, const Equal& equal) : cache(1, hash, equal) {}
 
-    mutable engine::Mutex mutex;
-    LruMap<T, U, Hash, Equal> cache;
+    mutable Mutex mutex;
+    Cache cache;
   };
 
-  Way& GetWay(const T& key);
+  using LruWay = Way<LruMap<T, U, Hash, Equal>, engine::Mutex>;
+  // Readers take the mutex in shared mode, see impl::TinyLfuBase::Peek
+  using TinyLfuWay =
+      Way<impl::TinyLfuBase<T, U, Hash, Equal>, engine::SharedMutex>;
+
+  template <typename Validator>
+  static std::optional<U> GetShared(TinyLfuWay& way, const T& key,
+                                    Validator& validator);
+
+  template <typename Ways>
+  static std::vector<Ways> MakeWays(size_t ways, size_t way_size,
+                                    const Hash& hash, const Equal& equal);
+
+  template <typename Function>
+  decltype(auto) VisitWays(Function&& func) {
+    return std::visit(std::forward<Function>(func), caches_);
+  }
+
+  template <typename Function>
+  decltype(auto) VisitWays(Function&& func) const {
+    return std::visit(std::forward<Function>(func), caches_);
+  }
+
+  template <typename Ways>
+  auto& GetWay(Ways& ways, const T& key) const;
 
   void NotifyDumper();
 
-  std::vector<Way> caches_;
+  std::variant<std::vector<LruWay>, std::vector<TinyLfuWay>> caches_;
   Hash hash_fn_;
   std::shared_ptr<dump::Dumper> dumper_{nullptr};
 };
 
 template <typename T, typename U, typename Hash, typename Eq>
-NWayLRU<T, U, Hash, Eq>::NWayLRU(size_t ways, size_t way_size, const Hash& hash,
-                                 const Eq& equal)
-    : caches_(), hash_fn_(hash) {
-  caches_.reserve(ways);
-  for (size_t i = 0; i < ways; ++i) caches_.emplace_back(hash, equal);
+template <typename Ways>
+std::vector<Ways> NWayLRU<T, U, Hash, Eq>::MakeWays(size_t ways,
+                                                   size_t way_size,
+                                                   const Hash& hash,
+                                                   const Eq& equal) {
+  std::vector<Ways> caches;
+  caches.reserve(ways);
+  for (size_t i = 0; i < ways; ++i) caches.emplace_back(hash, equal);
   if (ways == 0) throw std::logic_error("Ways must be positive");
 
-  for (auto& way : caches_) way.cache.SetMaxSize(way_size);
+  for (auto& way : caches) way.cache.SetMaxSize(way_size);
+  return caches;
+}
+
+template <typename T, typename U, typename Hash, typename Eq>
+NWayLRU<T, U, Hash, Eq>::NWayLRU(size_t ways, size_t way_size, const Hash& hash,
+                                 const Eq& equal, CachePolicy policy)
+    : caches_(), hash_fn_(hash) {
+  switch (policy) {
+    case CachePolicy::kLru:
+      caches_ = MakeWays<LruWay>(ways, way_size, hash, equal);
+      break;
+    case CachePolicy::kTinyLfu:
+      caches_ = MakeWays<TinyLfuWay>(ways, way_size, hash, equal);
+      break;
+  }
 }
 
 template <typename T, typename U, typename Hash, typename Eq>
 void NWayLRU<T, U, Hash, Eq>::Put(const T& key, U value) {
-  auto& way = GetWay(key);
-  {
-    std::unique_lock<engine::Mutex> lock(way.mutex);
+  VisitWays([&](auto& ways) {
+    auto& way = GetWay(ways, key);
+    std::unique_lock lock(way.mutex);
     way.cache.Put(key, std::move(value));
-  }
+  });
   NotifyDumper();
 }
 
@@ -113,98 +165,145 @@ template <typename T, typename U, typename Hash, typename Eq>
 template <typename Validator>
 std::optional<U> NWayLRU<T, U, Hash, Eq>::Get(const T& key,
                                               Validator validator) {
-  auto& way = GetWay(key);
-  std::unique_lock<engine::Mutex> lock(way.mutex);
-  auto* value = way.cache.Get(key);
+  return VisitWays([&](auto& ways) -> std::optional<U> {
+    auto& way = GetWay(ways, key);
+    if constexpr (std::is_same_v<std::decay_t<decltype(way)>, TinyLfuWay>) {
+      return GetShared(way, key, validator);
+    } else {
+      std::unique_lock<engine::Mutex> lock(way.mutex);
+      auto* value = way.cache.Get(key);
+
+      if (value) {
+        if (validator(*value)) return *value;
+        way.cache.Erase(key);
+      }
+
+      return std::nullopt;
+    }
+  });
+}
 
-  if (value) {
-    if (validator(*value)) return *value;
-    way.cache.Erase(key);
+template <typename T, typename U, typename Hash, typename Eq>
+template <typename Validator>
+std::optional<U> NWayLRU<T, U, Hash, Eq>::GetShared(TinyLfuWay& way,
+                                                    const T& key,
+                                                    Validator& validator) {
+  std::optional<U> result;
+  bool is_valid = true;
+  {
+    std::shared_lock<engine::SharedMutex> lock(way.mutex);
+    const auto* value = way.cache.Peek(key);
+    if (value) {
+      is_valid = validator(*value);
+      if (is_valid) result.emplace(*value);
+    }
+  }
+
+  if (!is_valid) {
+    std::unique_lock<engine::SharedMutex> lock(way.mutex);
+    const auto* value = way.cache.Peek(key);
+    // The value could have been updated while the mutex was unlocked
+    if (value && !validator(*value)) way.cache.Erase(key);
+    way.cache.ProcessPendingReads();
+  } else if (way.cache.HasManyPendingReads()) {
+    // Skip if contended, the next writer applies the reads anyway
+    std::unique_lock<engine::SharedMutex> lock(way.mutex, std::try_to_lock);
+    if (lock) way.cache.ProcessPendingReads();
   }
 
-  return std::nullopt;
+  return result;
 }
 
 template <typename T, typename U, typename Hash, typename Eq>
 void NWayLRU<T, U, Hash, Eq>::InvalidateByKey(const T& key) {
-  auto& way = GetWay(key);
-  {
-    std::unique_lock<engine::Mutex> lock(way.mutex);
+  VisitWays([&](auto& ways) {
+    auto& way = GetWay(ways, key);
+    std::unique_lock lock(way.mutex);
     way.cache.Erase(key);
-  }
+  });
   NotifyDumper();
 }
 
 template <typename T, typename U, typename Hash, typename Eq>
 U NWayLRU<T, U, Hash, Eq>::GetOr(const T& key, const U& default_value) {
-  auto& way = GetWay(key);
-  std::unique_lock<engine::Mutex> lock(way.mutex);
-  return way.cache.GetOr(key, default_value);
+  auto value = Get(key);
+  if (value) return std::move(*value);
+  return default_value;
 }
 
 template <typename T, typename U, typename Hash, typename Eq>
 void NWayLRU<T, U, Hash, Eq>::Invalidate() {
-  for (auto& way : caches_) {
-    std::unique_lock<engine::Mutex> lock(way.mutex);
-    way.cache.Clear();
-  }
+  VisitWays([](auto& ways) {
+    for (auto& way : ways) {
+      std::unique_lock lock(way.mutex);
+      way.cache.Clear();
+    }
+  });
   NotifyDumper();
 }
 
 template <typename T, typename U, typename Hash, typename Eq>
 template <typename Function>
 void NWayLRU<T, U, Hash, Eq>::VisitAll(Function func) const {
-  for (const auto& way : caches_) {
-    std::unique_lock<engine::Mutex> lock(way.mutex);
-    way.cache.VisitAll(func);
-  }
+  VisitWays([&func](const auto& ways) {
+    for (const auto& way : ways) {
+      std::unique_lock lock(way.mutex);
+      way.cache.VisitAll(func);
+    }
+  });
 }
 
 template <typename T, typename U, typename Hash, typename Eq>
 size_t NWayLRU<T, U, Hash, Eq>::GetSize() const {
-  size_t size{0};
-  for (const auto& way : caches_) {
-    std::unique_lock<engine::Mutex> lock(way.mutex);
-    size += way.cache.GetSize();
-  }
-  return size;
+  return VisitWays([](const auto& ways) {
+    size_t size{0};
+    for (const auto& way : ways) {
+      std::unique_lock lock(way.mutex);
+      size += way.cache.GetSize();
+    }
+    return size;
+  });
 }
 
 template <typename T, typename U, typename Hash, typename Eq>
 void NWayLRU<T, U, Hash, Eq>::UpdateWaySize(size_t way_size) {
-  for (auto& way : caches_) {
-    std::unique_lock<engine::Mutex> lock(way.mutex);
-    way.cache.SetMaxSize(way_size);
-  }
+  VisitWays([way_size](auto& ways) {
+    for (auto& way : ways) {
+      std::unique_lock lock(way.mutex);
+      way.cache.SetMaxSize(way_size);
+    }
+  });
 }
 
 template <typename T, typename U, typename Hash, typename Eq>
-typename NWayLRU<T, U, Hash, Eq>::Way& NWayLRU<T, U, Hash, Eq>::GetWay(
-    const T& key) {
+template <typename Ways>
+auto& NWayLRU<T, U, Hash, Eq>::GetWay(Ways& ways, const T& key) const {
   /// It is needed to twist hash because there is hash map in LruMap. Otherwise
   /// nodes will fall into one bucket. According to
   /// https://www.boost.org/doc/libs/1_83_0/libs/container_hash/doc/html/hash.html#notes_hash_combine
   /// hash_combine can be treated as hash itself
   auto seed = hash_fn_(key);
   boost::hash_combine(seed, 0);
-  auto n = seed % caches_.size();
-  return caches_[n];
+  auto n = seed % ways.size();
+  return ways[n];
 }
 
 template <typename T, typename U, typename Hash, typename Equal>
 void NWayLRU<T, U, Hash, Equal>::Write(dump::Writer& writer) const {
-  writer.Write(caches_.size());
+  VisitWays([&writer](const auto& ways) {
+    writer.Write(ways.size());
 
-  for (const Way& way : caches_) {
-    std::unique_lock<engine::Mutex> lock(way.mutex);
+    for (const auto& way : ways) {
+      std::unique_lock lock(way.mutex);
 
-    writer.Write(way.cache.GetSize());
+      writer.Write(way.cache.GetSize());
 
-    way.cache.VisitAll([&writer](const T& key, const U& value) {
-      writer.Write(key);
-      writer.Write(value);
-    });
-  }
+      way.cache.VisitAll([&writer](const T& key, const U& value) {
+        writer.Write(key);
+        writer.Write(value);
+      });
+    }
+  });
 }
 
 template <typename T, typename U, typename Hash, typename Equal>
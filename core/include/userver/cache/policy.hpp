@@ -0,0 +1,23 @@
+#pragma once
+
+/// @file userver/cache/policy.hpp
+/// @brief @copybrief cache::CachePolicy
+
+USERVER_NAMESPACE_BEGIN
+
+namespace cache {
+
+/// @brief Eviction policy of cache::NWayLRU and cache::LruCacheComponent
+enum class CachePolicy {
+  /// Evicts the least recently used key
+  kLru,
+  /// W-TinyLFU: new keys get into the main part of the cache only if they
+  /// are accessed more frequently than the eviction candidate, so bulk scans
+  /// of cold keys do not flush the hot set. Reads do not take the exclusive
+  /// lock of a way.
+  kTinyLfu,
+};
+
+}  // namespace cache
+
+USERVER_NAMESPACE_END
@@ -36,6 +36,7 @@ class HeadersPropagator;
 namespace curl {
 class easy;
 class multi;
+class share;
 class ConnectRateLimiter;
 }  // namespace curl
 
@@ -145,10 +146,13 @@ class Client final {
 
   std::shared_ptr<curl::easy> TryDequeueIdle() noexcept;
 
+  Statistics* BindToDestination(curl::easy& easy);
+
   std::atomic<std::size_t> pending_tasks_{0};
 
   const DeadlinePropagationConfig deadline_propagation_config_;
   CancellationPolicy cancellation_policy_;
+  const ConnectionAffinity connection_affinity_;
 
   std::shared_ptr<DestinationStatistics> destination_statistics_;
   std::unique_ptr<engine::ev::ThreadPool> thread_pool_;
@@ -175,6 +179,7 @@ class Client final {
   rcu::Variable<std::vector<std::string>> allowed_urls_extra_;
 
   std::shared_ptr<curl::ConnectRateLimiter> connect_rate_limiter_;
+  std::shared_ptr<curl::share> ssl_session_share_;
 
   clients::dns::Resolver* resolver_{nullptr};
   utils::NotNull<const tracing::TracingManagerBase*> tracing_manager_;
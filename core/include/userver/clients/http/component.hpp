@@ -49,6 +49,8 @@ namespace components {
 /// set-deadline-propagation-header | whether to set http::common::kXYaTaxiClientTimeoutMs request header, see @ref scripts/docs/en/userver/deadline_propagation.md | true
 /// plugins | Plugin names to apply. A plugin component is called "http-client-plugin-" plus the plugin name. | []
 /// cancellation-policy | Cancellation policy for new requests. | cancel
+/// connection-affinity | how a request chooses the IO thread: 'none' picks a random one, 'destination' keeps requests to the same host on the same thread to reuse its connections | none
+/// share-ssl-sessions | share TLS sessions between IO threads to resume them instead of doing full handshakes | false
 ///
 /// ## Static configuration example:
 ///
@@ -31,6 +31,17 @@ enum class CancellationPolicy {
 CancellationPolicy Parse(yaml_config::YamlConfig value,
                          formats::parse::To<CancellationPolicy>);
 
+/// How a new request chooses the IO thread (curl multi) to run on. Each multi
+/// has its own connection cache, so keeping requests to the same host on the
+/// same multi lets them reuse the already established connections.
+enum class ConnectionAffinity {
+  kNone,
+  kDestination,
+};
+
+ConnectionAffinity Parse(yaml_config::YamlConfig value,
+                         formats::parse::To<ConnectionAffinity>);
+
 // Static config
 struct ClientSettings final {
   std::string thread_name_prefix{};
@@ -40,6 +51,8 @@ struct ClientSettings final {
   const tracing::TracingManagerBase* tracing_manager{nullptr};
   const server::http::HeadersPropagator* headers_propagator{nullptr};
   CancellationPolicy cancellation_policy{CancellationPolicy::kCancel};
+  ConnectionAffinity connection_affinity{ConnectionAffinity::kNone};
+  bool share_ssl_sessions{false};
 };
 
 ClientSettings Parse(const yaml_config::YamlConfig& value,
@@ -51,6 +51,9 @@ class Manager;
 /// worker_threads | threads count for the task processor | -
 /// os-scheduling | OS scheduling mode for the task processor threads. 'idle' sets the lowest priority. 'low-priority' sets the priority below 'normal' but higher than 'idle'. | normal
 /// spinning-iterations | tunes the number of spin-wait iterations in case of an empty task queue before threads go to sleep | 1000
+/// spinning-policy | 'fixed' spins for spinning-iterations, 'adaptive' tunes the spin limit between spinning-iterations / 16 and spinning-iterations * 16 from the recent wake-ups: it shrinks when tasks come rarely and grows when sleeping threads are woken up shortly after they went to sleep | fixed
+/// hot-workers | number of idle worker threads that keep spinning instead of going to sleep and get new tasks first; trades CPU for wake-up latency | 0
+/// task-processor-queue | task queue implementation: 'global-task-queue' shares a single queue between all the worker threads, 'work-stealing-task-queue' keeps a local queue per worker and steals tasks from other workers when idle, which scales better on hosts with many cores | global-task-queue
 /// task-trace | optional dictionary of tracing options | empty (disabled)
 /// task-trace.every | set N to trace each Nth task | 1000
 /// task-trace.max-context-switch-count | set upper limit of context switches to trace for a single task | 1000
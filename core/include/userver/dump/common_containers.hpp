@@ -11,7 +11,10 @@
 ///
 /// @ingroup userver_dump_read_write
 
+#include <algorithm>
 #include <cstddef>
+#include <cstring>
+#include <limits>
 #include <map>
 #include <memory>
 #include <optional>
@@ -33,6 +36,7 @@
 #include <userver/dump/meta.hpp>
 #include <userver/dump/meta_containers.hpp>
 #include <userver/dump/operations.hpp>
+#include <userver/dump/unsafe.hpp>
 
 /// @cond
 namespace boost {
@@ -95,6 +99,41 @@ VariantType ReadVariant(Reader& reader, std::size_t index) {
   return std::move(*result);
 }
 
+// The values of these types are dumped as their bytes, so the vectors of them
+// are written and read in bulk. The format is the same as for other vectors.
+template <typename T>
+inline constexpr bool kIsDumpedAsBytes =
+    std::is_floating_point_v<T> || (meta::kIsInteger<T> && sizeof(T) == 1);
+
+template <typename T>
+inline constexpr bool kIsBulkDumpedVector = false;
+
+template <typename T, typename Allocator>
+inline constexpr bool kIsBulkDumpedVector<std::vector<T, Allocator>> =
+    kIsDumpedAsBytes<T>;
+
+// Limits the memory a Reader needs to read a huge vector
+inline constexpr std::size_t kBulkReadPieceSize = 1 << 16;
+
+template <typename T>
+T ReadBulkVector(Reader& reader, std::size_t size) {
+  using Value = typename T::value_type;
+  if (size > std::numeric_limits<std::size_t>::max() / sizeof(Value)) {
+    throw Error("Too many elements in a vector");
+  }
+
+  T result(size);
+  auto* const data = reinterpret_cast<char*>(result.data());
+  const auto bytes = size * sizeof(Value);
+  for (std::size_t offset = 0; offset < bytes;) {
+    const auto piece = ReadStringViewUnsafe(
+        reader, std::min(kBulkReadPieceSize, bytes - offset));
+    std::memcpy(data + offset, piece.data(), piece.size());
+    offset += piece.size();
+  }
+  return result;
+}
+
 }  // namespace impl
 
 /// @brief Container serialization support
@@ -102,9 +141,15 @@ template <typename T>
 std::enable_if_t<kIsContainer<T> && kIsWritable<meta::RangeValueType<T>>> Write(
     Writer& writer, const T& value) {
   writer.Write(std::size(value));
-  for (const auto& item : value) {
-    // explicit cast for vector<bool> shenanigans
-    writer.Write(static_cast<const meta::RangeValueType<T>&>(item));
+  if constexpr (impl::kIsBulkDumpedVector<T>) {
+    WriteStringViewUnsafe(
+        writer, std::string_view{reinterpret_cast<const char*>(value.data()),
+                                 value.size() * sizeof(value[0])});
+  } else {
+    for (const auto& item : value) {
+      // explicit cast for vector<bool> shenanigans
+      writer.Write(static_cast<const meta::RangeValueType<T>&>(item));
+    }
   }
 }
 
@@ -113,14 +158,18 @@ template <typename T>
 std::enable_if_t<kIsContainer<T> && kIsReadable<meta::RangeValueType<T>>, T>
 Read(Reader& reader, To<T>) {
   const auto size = reader.Read<std::size_t>();
-  T result{};
-  if constexpr (meta::kIsReservable<T>) {
-    result.reserve(size);
-  }
-  for (std::size_t i = 0; i < size; ++i) {
-    dump::Insert(result, reader.Read<meta::RangeValueType<T>>());
+  if constexpr (impl::kIsBulkDumpedVector<T>) {
+    return impl::ReadBulkVector<T>(reader, size);
+  } else {
+    T result{};
+    if constexpr (meta::kIsReservable<T>) {
+      result.reserve(size);
+    }
+    for (std::size_t i = 0; i < size; ++i) {
+      dump::Insert(result, reader.Read<meta::RangeValueType<T>>());
+    }
+    return result;
   }
-  return result;
 }
 
 /// @brief Pair serialization support (for maps)
@@ -0,0 +1,72 @@
+#pragma once
+
+#include <memory>
+
+#include <boost/filesystem/operations.hpp>
+
+#include <userver/dump/factory.hpp>
+#include <userver/dump/operations.hpp>
+#include <userver/dump/operations_file.hpp>
+
+USERVER_NAMESPACE_BEGIN
+
+namespace dump {
+
+/// @brief Writes a dump as a sequence of independently compressed zstd
+/// frames. File operations block the thread.
+class CompressedWriter final : public Writer {
+ public:
+  /// @brief Creates a new dump file and opens it
+  /// @throws `Error` on a filesystem error
+  CompressedWriter(std::string path, boost::filesystem::perms perms,
+                   tracing::ScopeTime& scope);
+
+  void Finish() override;
+
+ private:
+  void WriteRaw(std::string_view data) override;
+
+  void WriteChunk();
+
+  FileWriter file_writer_;
+  std::string chunk_;
+};
+
+/// @brief Reads a dump written by CompressedWriter.
+///
+/// The file is memory-mapped. The chunks are decompressed ahead of the
+/// reader in parallel tasks, data that fits into a chunk is returned
+/// without copying.
+class CompressedReader final : public Reader {
+ public:
+  /// @brief Opens an existing dump file
+  /// @throws `Error` on a filesystem error or a malformed file
+  explicit CompressedReader(std::string path);
+
+  ~CompressedReader() override;
+
+  void Finish() override;
+
+ private:
+  std::string_view ReadRaw(std::size_t max_size) override;
+
+  struct Impl;
+  std::unique_ptr<Impl> impl_;
+};
+
+class CompressedOperationsFactory final : public OperationsFactory {
+ public:
+  explicit CompressedOperationsFactory(boost::filesystem::perms perms);
+
+  std::unique_ptr<Reader> CreateReader(std::string full_path) override;
+
+  std::unique_ptr<Writer> CreateWriter(std::string full_path,
+                                       tracing::ScopeTime& scope) override;
+
+ private:
+  const boost::filesystem::perms perms_;
+};
+
+}  // namespace dump
+
+USERVER_NAMESPACE_END
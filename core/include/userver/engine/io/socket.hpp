@@ -94,6 +94,11 @@ class [[nodiscard]] Socket final : public RwBase {
     return SendAll(list, deadline);
   }
 
+  [[nodiscard]] size_t WriteAll(const IoData* list, std::size_t list_size,
+                                Deadline deadline) override {
+    return SendAll(list, list_size, deadline);
+  }
+
   /// @brief Sends exactly list_size IoData to the socket.
   /// @note Can return less than len if socket is closed by peer.
   [[nodiscard]] size_t SendAll(const IoData* list, std::size_t list_size,
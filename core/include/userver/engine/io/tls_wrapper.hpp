@@ -4,6 +4,7 @@
 /// @brief TLS socket wrappers
 
 #include <string>
+#include <string_view>
 #include <vector>
 
 #include <userver/crypto/certificate.hpp>
@@ -38,11 +39,14 @@ class [[nodiscard]] TlsWrapper final : public RwBase {
       Deadline deadline,
       const std::vector<crypto::Certificate>& extra_cert_authorities = {});
 
-  /// Starts a TLS server on an opened socket
+  /// @brief Starts a TLS server on an opened socket
+  /// @param alpn_protocols application protocols to negotiate via ALPN in
+  /// the order of preference, e.g. {"h2", "http/1.1"}
   static TlsWrapper StartTlsServer(
       Socket&& socket, const crypto::Certificate& cert,
       const crypto::PrivateKey& key, Deadline deadline,
-      const std::vector<crypto::Certificate>& extra_cert_authorities = {});
+      const std::vector<crypto::Certificate>& extra_cert_authorities = {},
+      const std::vector<std::string>& alpn_protocols = {});
 
   ~TlsWrapper() override;
 
@@ -104,8 +108,14 @@ class [[nodiscard]] TlsWrapper final : public RwBase {
   [[nodiscard]] size_t WriteAll(std::initializer_list<IoData> list,
                                 Deadline deadline) override;
 
+  [[nodiscard]] size_t WriteAll(const IoData* list, std::size_t list_size,
+                                Deadline deadline) override;
+
   int GetRawFd();
 
+  /// Application protocol negotiated via ALPN, empty if none
+  std::string_view GetAlpnProtocol() const;
+
  private:
   explicit TlsWrapper(Socket&&);
 
@@ -6,6 +6,7 @@
 #include <cstddef>
 #include <string>
 
+#include <userver/engine/task/task_processor_fwd.hpp>
 #include <userver/utils/function_ref.hpp>
 
 USERVER_NAMESPACE_BEGIN
@@ -21,6 +22,10 @@ struct TaskProcessorPoolsConfig final {
   std::string ev_thread_name = "ev";
   bool ev_default_loop_disabled = false;
   bool defer_events = true;
+  bool use_io_uring = false;
+  TaskQueueType task_queue_type = TaskQueueType::kGlobalTaskQueue;
+  SpinningPolicy spinning_policy = SpinningPolicy::kFixed;
+  std::size_t hot_workers = 0;
 };
 
 /// @brief Runs a payload in a temporary coroutine engine instance.
@@ -16,6 +16,24 @@ namespace engine {
 /// section of the components::ManagerControllerComponent static configuration.
 class TaskProcessor;
 
+/// @brief Task queue implementation used by a TaskProcessor
+enum class TaskQueueType {
+  /// A single queue shared by all the worker threads
+  kGlobalTaskQueue,
+  /// Per-worker queues with a LIFO slot for the just woken up task and
+  /// stealing from random workers when idle
+  kWorkStealingTaskQueue,
+};
+
+/// @brief How idle TaskProcessor worker threads spin before going to sleep
+enum class SpinningPolicy {
+  /// Spin for a fixed number of iterations
+  kFixed,
+  /// Tune the number of iterations from the recent wake-ups: spin less when
+  /// tasks come rarely and more when sleeping workers are woken up shortly
+  kAdaptive,
+};
+
 /// @brief Register a function that runs on all threads on task processor
 /// creation. Used for pre-initializing thread_local variables with heavy
 /// constructors (constructor that does blocking system calls, file access,
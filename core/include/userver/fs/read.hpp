@@ -50,6 +50,10 @@ FileInfoWithDataMap ReadRecursiveFilesInfoWithData(
     utils::Flags<SettingsReadFile> flags = {SettingsReadFile::kSkipHidden});
 
 /// @brief Reads file contents asynchronously
+///
+/// If the ev threads use io_uring (`event_thread_pool.use_io_uring` static
+/// config option), the file is read via io_uring right from the current task
+/// and `async_tp` is not used.
 /// @param async_tp TaskProcessor for synchronous waiting
 /// @param path file to open
 /// @returns file contents
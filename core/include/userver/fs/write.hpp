@@ -29,6 +29,10 @@ void CreateDirectories(engine::TaskProcessor& async_tp, std::string_view path);
 /// @brief Rewrite file contents asynchronously
 /// It doesn't provide strict atomic guarantees. If you need them, use
 /// `fs::RewriteFileContentsAtomically`.
+///
+/// If the ev threads use io_uring (`event_thread_pool.use_io_uring` static
+/// config option), the file is written via io_uring right from the current
+/// task and `async_tp` is not used.
 /// @param async_tp TaskProcessor for synchronous waiting
 /// @param path file to rewrite
 /// @param contents new file contents
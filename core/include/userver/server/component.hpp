@@ -77,6 +77,12 @@ namespace components {
 /// connection.requests_queue_size_threshold | drop requests from handlers that allow throttling if there's more pending requests than allowed by this value | 100
 /// connection.keepalive_timeout | timeout in seconds to drop connection if there's not data received from it | 600
 /// connection.stream_close_check_delay | delay in microseconds of the start of stream close check routine; do not set if not sure what it is doing | 20ms
+/// connection.pipelining_batch_delay | how long a ready response to a pipelined request waits for the responses to the next requests to send them with a single write; 0 disables the batching | 0
+/// connection.http2.enabled | accept HTTP/2 connections, negotiated via TLS ALPN or cleartext ones with prior knowledge | false
+/// connection.http2.max_concurrent_streams | max number of concurrently processed streams of a connection | 100
+/// connection.http2.initial_window_size | initial flow control window size of a stream in bytes | 65535
+/// connection.http2.connection_window_size | flow control window size of the whole connection in bytes | 1048576
+/// connection.http2.max_frame_size | max payload size of a received frame in bytes | 16384
 /// shards | how many concurrent tasks harvest data from a single socket; do not set if not sure what it is doing | -
 /// middleware-pipeline-builder | name of a component to build a server-wide middleware pipeline | default-server-middleware-pipeline-builder
 ///
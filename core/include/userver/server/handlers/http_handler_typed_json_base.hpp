@@ -0,0 +1,177 @@
+#pragma once
+
+/// @file userver/server/handlers/http_handler_typed_json_base.hpp
+/// @brief @copybrief server::handlers::HttpHandlerTypedJsonBase
+
+#include <memory>
+#include <string>
+#include <string_view>
+
+#include <userver/formats/json/exception.hpp>
+#include <userver/formats/json/parser/parser_state.hpp>
+#include <userver/formats/json/parser/typed_parser.hpp>
+#include <userver/formats/json/string_builder.hpp>
+#include <userver/formats/parse/to.hpp>
+#include <userver/http/content_type.hpp>
+#include <userver/server/handlers/exceptions.hpp>
+#include <userver/server/handlers/http_handler_base.hpp>
+#include <userver/server/handlers/json_error_builder.hpp>
+#include <userver/server/handlers/legacy_json_error_builder.hpp>
+#include <userver/tracing/scope_time.hpp>
+#include <userver/yaml_config/schema.hpp>
+
+USERVER_NAMESPACE_BEGIN
+
+namespace server::handlers {
+
+namespace impl {
+
+inline constexpr std::string_view kTypedJsonRequestDataName =
+    "__request_typed_json";
+inline constexpr std::string_view kTypedJsonResponseDataName =
+    "__response_typed_json";
+
+}  // namespace impl
+
+// clang-format off
+
+/// @ingroup userver_components userver_http_handlers userver_base_classes
+///
+/// @brief Convenient base for handlers that accept requests with body in
+/// JSON format and respond with body in JSON format, without building
+/// formats::json::Value for both of them.
+///
+/// The request body is parsed by a SAX parser returned from
+/// `MakeSaxParser(formats::parse::To<InputType>)`, the response is written
+/// with `WriteToStream(const ReturnType&, formats::json::StringBuilder&)`.
+/// chaotic generates both functions for the types of a schema with
+/// `--generate-sax-parsers --generate-serializers`.
+
+// clang-format on
+
+template <typename InputType, typename ReturnType>
+class HttpHandlerTypedJsonBase : public HttpHandlerBase {
+ public:
+  HttpHandlerTypedJsonBase(
+      const components::ComponentConfig& config,
+      const components::ComponentContext& component_context,
+      bool is_monitor = false);
+
+  std::string HandleRequestThrow(const http::HttpRequest& request,
+                                 request::RequestContext& context) const final;
+
+  virtual ReturnType HandleRequestTypedJsonThrow(
+      const http::HttpRequest& request, const InputType& input,
+      request::RequestContext& context) const = 0;
+
+  static yaml_config::Schema GetStaticConfigSchema();
+
+ protected:
+  /// @returns A pointer to input data if it was parsed successfully or
+  /// nullptr otherwise.
+  const InputType* GetInputData(const request::RequestContext& context) const;
+
+  /// @returns a pointer to output data if it was returned successfully by
+  /// `HandleRequestTypedJsonThrow()` or nullptr otherwise.
+  const ReturnType* GetOutputData(const request::RequestContext& context) const;
+
+  void ParseRequestData(const http::HttpRequest& request,
+                        request::RequestContext& context) const override;
+
+ private:
+  FormattedErrorData GetFormattedExternalErrorBody(
+      const CustomHandlerException& exc) const final;
+};
+
+template <typename InputType, typename ReturnType>
+HttpHandlerTypedJsonBase<InputType, ReturnType>::HttpHandlerTypedJsonBase(
+    const components::ComponentConfig& config,
+    const components::ComponentContext& component_context, bool is_monitor)
+    : HttpHandlerBase(config, component_context, is_monitor) {}
+
+template <typename InputType, typename ReturnType>
+std::string HttpHandlerTypedJsonBase<InputType, ReturnType>::HandleRequestThrow(
+    const http::HttpRequest& request, request::RequestContext& context) const {
+  const auto& input =
+      context.GetData<const InputType&>(impl::kTypedJsonRequestDataName);
+
+  auto& response = request.GetHttpResponse();
+  response.SetContentType(
+      USERVER_NAMESPACE::http::content_type::kApplicationJson);
+
+  const auto& ret =
+      context.SetData(std::string{impl::kTypedJsonResponseDataName},
+                      HandleRequestTypedJsonThrow(request, input, context));
+
+  const auto scope_time =
+      tracing::ScopeTime::CreateOptionalScopeTime("serialize_json");
+  formats::json::StringBuilder sw;
+  WriteToStream(ret, sw);
+  return sw.GetString();
+}
+
+template <typename InputType, typename ReturnType>
+const InputType* HttpHandlerTypedJsonBase<InputType, ReturnType>::GetInputData(
+    const request::RequestContext& context) const {
+  return context.GetDataOptional<const InputType>(
+      impl::kTypedJsonRequestDataName);
+}
+
+template <typename InputType, typename ReturnType>
+const ReturnType*
+HttpHandlerTypedJsonBase<InputType, ReturnType>::GetOutputData(
+    const request::RequestContext& context) const {
+  return context.GetDataOptional<const ReturnType>(
+      impl::kTypedJsonResponseDataName);
+}
+
+template <typename InputType, typename ReturnType>
+void HttpHandlerTypedJsonBase<InputType, ReturnType>::ParseRequestData(
+    const http::HttpRequest& request, request::RequestContext& context) const {
+  std::string_view body = request.RequestBody();
+  // Same as formats::json::Value{} in HttpHandlerJsonBase
+  if (body.empty()) body = "null";
+
+  InputType input{};
+  try {
+    auto parser = MakeSaxParser(formats::parse::To<InputType>{});
+    formats::json::parser::SubscriberSink<InputType> sink{input};
+    parser->Subscribe(sink);
+    parser->Reset();
+
+    formats::json::parser::ParserState state;
+    state.PushParser(*parser);
+    state.ProcessInput(body);
+  } catch (const formats::json::Exception& e) {
+    throw RequestParseError(
+        InternalMessage{"Invalid JSON body"},
+        ExternalBody{std::string("Invalid JSON body: ") + e.what()});
+  }
+
+  context.SetData(std::string{impl::kTypedJsonRequestDataName},
+                  std::move(input));
+}
+
+template <typename InputType, typename ReturnType>
+FormattedErrorData
+HttpHandlerTypedJsonBase<InputType, ReturnType>::GetFormattedExternalErrorBody(
+    const CustomHandlerException& exc) const {
+  if (exc.GetServiceCode().empty()) {
+    return {LegacyJsonErrorBuilder(exc).GetExternalBody(),
+            LegacyJsonErrorBuilder::GetContentType()};
+  }
+  return {JsonErrorBuilder(exc).GetExternalBody(),
+          JsonErrorBuilder::GetContentType()};
+}
+
+template <typename InputType, typename ReturnType>
+yaml_config::Schema
+HttpHandlerTypedJsonBase<InputType, ReturnType>::GetStaticConfigSchema() {
+  auto schema = HttpHandlerBase::GetStaticConfigSchema();
+  schema.UpdateDescription("HTTP handler typed JSON base config");
+  return schema;
+}
+
+}  // namespace server::handlers
+
+USERVER_NAMESPACE_END
@@ -3,6 +3,8 @@
 /// @file userver/server/handlers/server_monitor.hpp
 /// @brief @copybrief server::handlers::ServerMonitor
 
+#include <memory>
+
 #include <userver/server/handlers/http_handler_base.hpp>
 #include <userver/utils/statistics/fwd.hpp>
 
@@ -12,7 +14,8 @@ namespace server::handlers {
 
 namespace impl {
 enum class StatsFormat;
-}
+struct ScrapeCaches;
+}  // namespace impl
 
 // clang-format off
 
@@ -25,6 +28,12 @@ enum class StatsFormat;
 /// 'common-labels' option that should be a map of label name to label value.
 /// Items of the map are added to each metric.
 ///
+/// Setting 'scrape-cache' option to `true` makes the handler reuse the
+/// serialized metrics that did not change since the previous scrape, see
+/// utils::statistics::ScrapeCache. Only the "prometheus",
+/// "prometheus-untyped" and "solomon" formats without 'labels', 'path' and
+/// 'prefix' arguments are cached.
+///
 /// Default format can be set via 'format' option. Supported formats are: "prometheus", "prometheus-untyped", "graphite",
 ///   "json", "solomon", "pretty" and "internal". For more info see the documentation for utils::statistics::ToPrometheusFormat,
 ///   utils::statistics::ToPrometheusFormatUntyped, utils::statistics::ToGraphiteFormat, utils::statistics::ToJsonFormat,
@@ -50,6 +59,8 @@ class ServerMonitor final : public HttpHandlerBase {
   ServerMonitor(const components::ComponentConfig& config,
                 const components::ComponentContext& component_context);
 
+  ~ServerMonitor() override;
+
   /// @ingroup userver_component_names
   /// @brief The default name of server::handlers::ServerMonitor
   static constexpr std::string_view kName = "handler-server-monitor";
@@ -69,6 +80,7 @@ class ServerMonitor final : public HttpHandlerBase {
   using CommonLabels = std::unordered_map<std::string, std::string>;
   const CommonLabels common_labels_;
   const std::optional<impl::StatsFormat> default_format_;
+  const std::unique_ptr<impl::ScrapeCaches> scrape_caches_;
 };
 
 }  // namespace server::handlers
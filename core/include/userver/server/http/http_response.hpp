@@ -4,6 +4,7 @@
 /// @brief @copybrief server::http::HttpResponse
 
 #include <chrono>
+#include <memory>
 #include <string>
 #include <unordered_map>
 
@@ -13,6 +14,7 @@
 #include <userver/http/header_map.hpp>
 #include <userver/server/http/http_response_cookie.hpp>
 #include <userver/server/request/response_base.hpp>
+#include <userver/utils/impl/monotonic_arena.hpp>
 #include <userver/utils/impl/projecting_view.hpp>
 #include <userver/utils/str_icase.hpp>
 
@@ -27,6 +29,10 @@ namespace impl {
 void OutputHeader(USERVER_NAMESPACE::http::headers::HeadersString& header,
                   std::string_view key, std::string_view val);
 
+class StreamBodyCompressor;
+class Http2StreamWriter;
+class ResponseBatch;
+
 }  // namespace impl
 
 class HttpRequestImpl;
@@ -48,7 +54,7 @@ class HttpResponse final : public request::ResponseBase {
   HttpResponse(const HttpRequestImpl& request,
                request::ResponseDataAccounter& data_accounter,
                std::chrono::steady_clock::time_point now,
-               utils::StrCaseHash hasher);
+               utils::StrCaseHash hasher, utils::impl::MonotonicArena& arena);
   ~HttpResponse() override;
 
   void SetSendFailed(
@@ -123,6 +129,17 @@ class HttpResponse final : public request::ResponseBase {
   /// @cond
   // TODO: server internals. remove from public interface
   void SendResponse(engine::io::RwBase& socket) override;
+
+  // For internal use only. Hands the response over to an HTTP/2 stream, the
+  // connection is responsible for writing the frames.
+  void SendResponseHttp2(impl::Http2StreamWriter& stream);
+
+  // For internal use only. Serializes the status line and the headers of a
+  // response that is not streamed into `header` without writing them and
+  // returns the body that goes after them. Used to send several pipelined
+  // responses with a single write, see impl::ResponseBatch.
+  std::string_view SerializeNotStreamed(
+      USERVER_NAMESPACE::http::headers::HeadersString& header);
   /// @endcond
 
   void SetStatusServiceUnavailable() override {
@@ -141,7 +158,26 @@ class HttpResponse final : public request::ResponseBase {
   // Can be called only once
   Queue::Producer GetBodyProducer();
 
+  /// @cond
+  // For internal use only. Compresses the streamed body if the compressor
+  // agrees to do so for the final status and headers.
+  void SetStreamBodyCompressor(
+      std::unique_ptr<impl::StreamBodyCompressor> compressor);
+  /// @endcond
+
  private:
+  friend class impl::ResponseBatch;
+
+  // Outputs the status line and all the headers except for the ones that
+  // depend on the way the body is sent
+  void OutputHeaders(USERVER_NAMESPACE::http::headers::HeadersString& header,
+                     bool send_body_streamed);
+
+  // Outputs Content-Length and the headers end marker, returns the body
+  // that should be sent
+  std::string_view FinishNotStreamedHeaders(
+      USERVER_NAMESPACE::http::headers::HeadersString& header);
+
   // Returns total size of the response
   std::size_t SetBodyStreamed(
       engine::io::RwBase& socket,
@@ -161,6 +197,7 @@ class HttpResponse final : public request::ResponseBase {
       engine::SingleConsumerEvent::NoAutoReset()};
   std::optional<Queue::Consumer> body_stream_;
   std::optional<Queue::Producer> body_stream_producer_;
+  std::unique_ptr<impl::StreamBodyCompressor> stream_body_compressor_;
 };
 
 void SetThrottleReason(http::HttpResponse& http_response,
@@ -45,13 +45,51 @@ struct Message {
 
 class WebSocketConnectionImpl;
 
+/// @brief permessage-deflate extension settings, see RFC 7692
+struct DeflateConfig final {
+  bool enabled = false;
+  bool server_no_context_takeover = false;
+  bool client_no_context_takeover = false;
+  int server_max_window_bits = 15;  // 9..15
+  int client_max_window_bits = 15;  // 8..15
+  int compression_level = 6;        // 0..9
+  std::size_t min_message_size = 0;  // smaller messages are not compressed
+};
+
+DeflateConfig Parse(const yaml_config::YamlConfig&,
+                    formats::parse::To<DeflateConfig>);
+
 struct Config final {
   unsigned max_remote_payload = 65536;
   unsigned fragment_size = 65536;  // 0 - do not fragment
+  DeflateConfig deflate{};
 };
 
 Config Parse(const yaml_config::YamlConfig&, formats::parse::To<Config>);
 
+/// @brief Message that is compressed and split into frames once and may be
+/// sent to many connections via WebSocketConnection::SendPrepared().
+///
+/// Copies are cheap and share the data, so a single message may be sent
+/// from different coroutines at once.
+class PreparedMessage final {
+ public:
+  /// @param data payload
+  /// @param is_text is it text or binary?
+  /// @param config settings of the handler that owns the connections, see
+  /// WebsocketHandlerBase::PrepareMessage()
+  PreparedMessage(std::string data, bool is_text, const Config& config);
+
+  const std::string& GetData() const noexcept;
+  bool IsText() const noexcept;
+
+ private:
+  friend class WebSocketConnectionImpl;
+
+  struct Impl;
+  std::shared_ptr<const Impl> impl_;
+};
+
 struct Statistics final {
   std::atomic<int64_t> msg_sent{0};
   std::atomic<int64_t> msg_recv{0};
@@ -100,6 +138,12 @@ class WebSocketConnection {
         reinterpret_cast<const std::byte*>(message.data() + message.size())));
   }
 
+  /// @brief Send a message that was compressed and framed beforehand. The
+  /// payload is written straight from the shared buffer of the message.
+  /// @throws engine::io::IoException in case of socket errors
+  /// @note Has the same thread-safety guarantees as Send().
+  virtual void SendPrepared(const PreparedMessage& message);
+
   virtual void Close(CloseStatus status_code) = 0;
 
   virtual const engine::io::Sockaddr& RemoteAddr() const = 0;
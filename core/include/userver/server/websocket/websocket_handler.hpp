@@ -28,6 +28,13 @@ namespace server::websocket {
 /// status-codes-log-level | map of "status": log_level items to override span log level for specific status codes | {}
 /// max-remote-payload | max remote payload size | 65536
 /// fragment-size | max output fragment size | 65536
+/// permessage-deflate.enabled | accept permessage-deflate extension (RFC 7692) if the client offers it | false
+/// permessage-deflate.server-no-context-takeover | do not reuse the compression window between sent messages, saves memory and makes the prepared messages cheaper | false
+/// permessage-deflate.client-no-context-takeover | ask the client not to reuse the window between messages | false
+/// permessage-deflate.server-max-window-bits | log2 of the compression window of sent messages, 9..15 | 15
+/// permessage-deflate.client-max-window-bits | max log2 of the window of received messages, 8..15 | 15
+/// permessage-deflate.compression-level | zlib compression level, 0..9 | 6
+/// permessage-deflate.min-message-size | smaller messages are sent uncompressed | 0
 ///
 /// ## Example usage:
 ///
@@ -51,6 +58,11 @@ class WebsocketHandlerBase : public server::handlers::HttpHandlerBase {
     return true;
   }
 
+  /// @brief Compresses and frames the message once with the settings of the
+  /// handler, to send it to many connections via
+  /// WebSocketConnection::SendPrepared().
+  PreparedMessage PrepareMessage(std::string data, bool is_text) const;
+
   /// @cond
   void WriteMetrics(utils::statistics::Writer& writer) const;
 
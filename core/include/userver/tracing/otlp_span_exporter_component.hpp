@@ -0,0 +1,80 @@
+#pragma once
+
+/// @file userver/tracing/otlp_span_exporter_component.hpp
+/// @brief @copybrief components::OtlpSpanExporter
+
+#include <memory>
+
+#include <userver/components/component_base.hpp>
+#include <userver/utils/statistics/entry.hpp>
+
+USERVER_NAMESPACE_BEGIN
+
+namespace tracing::impl {
+class OtlpSpanExporter;
+}  // namespace tracing::impl
+
+namespace components {
+
+// clang-format off
+
+/// @ingroup userver_components
+///
+/// @brief Component that sends the finished spans to an OpenTelemetry
+/// collector via OTLP/HTTP in protobuf format.
+///
+/// Spans are passed to a background task in binary form through a bounded
+/// queue instead of being formatted into the log on the request path. Spans
+/// that do not fit into the queue are dropped and accounted in the
+/// `otlp-span-exporter.dropped` metric.
+///
+/// Only the spans that would be logged are exported, so the log levels and
+/// `no-log-spans` apply as usual.
+///
+/// ## Static options:
+/// Name | Description | Default value
+/// ---- | ----------- | -------------
+/// endpoint | OTLP/HTTP traces URL of the collector, e.g. http://localhost:4318/v1/traces | -
+/// service-name | service name to write into the `service.name` resource attribute | service-name of components::Tracer
+/// http-client | name of the components::HttpClient to send the spans with | http-client
+/// task-processor | task processor for the background export task | main-task-processor
+/// max-queue-size | max number of spans waiting for the export | 65536
+/// max-batch-size | max number of spans in a single request | 512
+/// flush-period | max time to wait for a batch to be filled | 1s
+/// timeout | HTTP request timeout | 1s
+/// log-spans | write spans into the default logger as well | false
+///
+/// ## Static configuration example:
+///
+/// @code
+/// otlp-span-exporter:
+///     endpoint: http://localhost:4318/v1/traces
+///     max-queue-size: 100000
+///     flush-period: 500ms
+/// @endcode
+
+// clang-format on
+class OtlpSpanExporter final : public ComponentBase {
+ public:
+  /// @ingroup userver_component_names
+  /// @brief The default name of components::OtlpSpanExporter
+  static constexpr std::string_view kName = "otlp-span-exporter";
+
+  OtlpSpanExporter(const ComponentConfig& config,
+                   const ComponentContext& context);
+
+  ~OtlpSpanExporter() override;
+
+  static yaml_config::Schema GetStaticConfigSchema();
+
+ private:
+  std::shared_ptr<tracing::impl::OtlpSpanExporter> exporter_;
+  utils::statistics::Entry statistics_holder_;
+};
+
+template <>
+inline constexpr bool kHasValidate<OtlpSpanExporter> = true;
+
+}  // namespace components
+
+USERVER_NAMESPACE_END
@@ -185,6 +185,9 @@ class Span final {
   ///
   /// Propagates both to sub-spans within a single service, and from client
   /// to server
+  ///
+  /// The ids are kept in binary and are formatted to hex on the first call
+  /// of any of the id getters.
   const std::string& GetTraceId() const;
 
   /// Identifies a specific span. It does not propagate
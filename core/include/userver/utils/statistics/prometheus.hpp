@@ -5,6 +5,7 @@
 
 #include <string>
 
+#include <userver/utils/statistics/scrape_cache.hpp>
 #include <userver/utils/statistics/storage.hpp>
 
 USERVER_NAMESPACE_BEGIN
@@ -30,11 +31,25 @@ std::string ToPrometheusLabel(std::string_view name);
 std::string ToPrometheusFormat(const utils::statistics::Storage& statistics,
                                const utils::statistics::Request& request = {});
 
+/// Output `statistics` in Prometheus format, each metric has `gauge` type.
+/// Metrics that did not change since the previous call with the `cache` are
+/// not formatted again.
+std::string ToPrometheusFormat(const utils::statistics::Storage& statistics,
+                               ScrapeCache& cache,
+                               const utils::statistics::Request& request = {});
+
 /// Output `statistics` in Prometheus format, without metric types.
 std::string ToPrometheusFormatUntyped(
     const utils::statistics::Storage& statistics,
     const utils::statistics::Request& request = {});
 
+/// Output `statistics` in Prometheus format, without metric types.
+/// Metrics that did not change since the previous call with the `cache` are
+/// not formatted again.
+std::string ToPrometheusFormatUntyped(
+    const utils::statistics::Storage& statistics, ScrapeCache& cache,
+    const utils::statistics::Request& request = {});
+
 }  // namespace utils::statistics
 
 USERVER_NAMESPACE_END
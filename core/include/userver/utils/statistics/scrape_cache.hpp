@@ -0,0 +1,48 @@
+#pragma once
+
+/// @file userver/utils/statistics/scrape_cache.hpp
+/// @brief @copybrief utils::statistics::ScrapeCache
+
+#include <memory>
+
+USERVER_NAMESPACE_BEGIN
+
+namespace utils::statistics {
+
+/// @brief Serialized metrics of the previous scrapes of a Storage, that speed
+/// up the next scrapes.
+///
+/// Metrics written by each registered writer are compared with the ones from
+/// the previous scrape. If they did not change, the previously serialized data
+/// is copied into the output instead of formatting the metrics again. The
+/// output buffer is also reused between the scrapes where the format allows.
+///
+/// The output is exactly the same as without the cache.
+///
+/// A cache should be used with a single output format, switching the format
+/// drops the cached data. The cache is not thread-safe, concurrent scrapes
+/// should use different caches or be serialized.
+///
+/// @see utils::statistics::ToPrometheusFormat,
+/// utils::statistics::ToPrometheusFormatUntyped,
+/// utils::statistics::ToSolomonFormat
+class ScrapeCache final {
+ public:
+  ScrapeCache();
+  ScrapeCache(ScrapeCache&&) noexcept;
+  ScrapeCache& operator=(ScrapeCache&&) noexcept;
+  ~ScrapeCache();
+
+  /// @cond
+  struct Impl;
+
+  Impl& GetImpl() noexcept { return *impl_; }
+  /// @endcond
+
+ private:
+  std::unique_ptr<Impl> impl_;
+};
+
+}  // namespace utils::statistics
+
+USERVER_NAMESPACE_END
@@ -5,6 +5,7 @@
 
 #include <string>
 
+#include <userver/utils/statistics/scrape_cache.hpp>
 #include <userver/utils/statistics/storage.hpp>
 
 USERVER_NAMESPACE_BEGIN
@@ -61,6 +62,15 @@ std::string ToSolomonFormat(
     const std::unordered_map<std::string, std::string>& common_labels,
     const utils::statistics::Request& statistics_request = {});
 
+/// Output `statistics` in Solomon format, see the overload above. Metrics that
+/// did not change since the previous call with the `cache` are not formatted
+/// again.
+std::string ToSolomonFormat(
+    const utils::statistics::Storage& statistics,
+    const std::unordered_map<std::string, std::string>& common_labels,
+    ScrapeCache& cache,
+    const utils::statistics::Request& statistics_request = {});
+
 }  // namespace utils::statistics
 
 USERVER_NAMESPACE_END
@@ -86,8 +86,12 @@ using ExtenderFunc =
 
 using WriterFunc = std::function<void(Writer&)>;
 
+class ScrapeCache;
+
 namespace impl {
 
+class BaseCachingFormatBuilder;
+
 struct MetricsSource final {
   std::string prefix_path;
   std::vector<std::string> path_segments;
@@ -133,6 +137,12 @@ class Storage final {
   void VisitMetrics(BaseFormatBuilder& out, const Request& request = {}) const;
 
   /// @cond
+  /// Same as VisitMetrics, but reuses the serialized metrics of the writers
+  /// whose metrics did not change since the previous visit with the `cache`.
+  void VisitMetricsCached(impl::BaseCachingFormatBuilder& out,
+                          ScrapeCache& cache,
+                          const Request& request = {}) const;
+
   /// Must be called from StatisticsStorage only. Don't call it from user
   /// components.
   void StopRegisteringExtenders();
@@ -39,6 +39,10 @@ void CombineStatistics(const impl::UpdateStatistics& a,
       a.documents_read_count.Load() + b.documents_read_count.Load();
   result.documents_parse_failures =
       a.documents_parse_failures.Load() + b.documents_parse_failures.Load();
+  result.chunks_count = a.chunks_count.Load() + b.chunks_count.Load();
+  result.last_update_max_chunk_duration =
+      std::max(a.last_update_max_chunk_duration.load(),
+               b.last_update_max_chunk_duration.load());
 
   result.last_update_start_time = std::max(a.last_update_start_time.load(),
                                            b.last_update_start_time.load());
@@ -77,6 +81,12 @@ void DumpMetric(utils::statistics::Writer& writer,
     documents["parse_failures.v2"] = stats.documents_parse_failures;
   }
 
+  if (auto chunks = writer["chunks"]) {
+    chunks["count"] = stats.chunks_count;
+    chunks["last-update-max-duration-ms"] =
+        stats.last_update_max_chunk_duration.load().count();
+  }
+
   if (auto age = writer["time"]) {
     age["time-from-last-update-start-ms"] =
         TimeStampToMillisecondsFromNow(stats.last_update_start_time.load());
@@ -150,6 +160,15 @@ void UpdateStatisticsScope::IncreaseDocumentsParseFailures(std::size_t add) {
   update_stats_.documents_parse_failures += utils::statistics::Rate{add};
 }
 
+void UpdateStatisticsScope::AccountChunk(std::chrono::milliseconds duration) {
+  ++update_stats_.chunks_count;
+
+  auto max_duration = max_chunk_duration_.load();
+  while (max_duration < duration &&
+         !max_chunk_duration_.compare_exchange_weak(max_duration, duration)) {
+  }
+}
+
 void UpdateStatisticsScope::DoFinish(impl::UpdateState new_state) {
   UASSERT(new_state != impl::UpdateState::kNotFinished);
   // TODO Some production caches call Finish multiple times. We should fix those
@@ -163,6 +182,7 @@ void UpdateStatisticsScope::DoFinish(impl::UpdateState new_state) {
   update_stats_.last_update_duration =
       std::chrono::duration_cast<std::chrono::milliseconds>(update_stop_time -
                                                             update_start_time_);
+  update_stats_.last_update_max_chunk_duration = max_chunk_duration_.load();
 
   state_ = new_state;
 }
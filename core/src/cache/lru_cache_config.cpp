@@ -2,6 +2,8 @@
 
 #include <stdexcept>
 
+#include <fmt/format.h>
+
 #include <userver/components/component_config.hpp>
 #include <userver/dump/config.hpp>
 #include <userver/dynamic_config/value.hpp>
@@ -18,6 +20,17 @@ constexpr std::string_view kSize = "size";
 constexpr std::string_view kLifetime = "lifetime";
 constexpr std::string_view kBackgroundUpdate = "background-update";
 constexpr std::string_view kLifetimeMs = "lifetime-ms";
+constexpr std::string_view kPolicy = "policy";
+
+CachePolicy ParsePolicy(const yaml_config::YamlConfig& value) {
+  const auto policy = value.As<std::string>("lru");
+  if (policy == "lru") return CachePolicy::kLru;
+  if (policy == "tinylfu") return CachePolicy::kTinyLfu;
+  throw std::runtime_error(
+      fmt::format("Unknown cache policy '{}' at '{}', expected 'lru' or "
+                  "'tinylfu'",
+                  policy, value.GetPath()));
+}
 
 }  // namespace
 
@@ -58,6 +71,7 @@ LruCacheConfigStatic::LruCacheConfigStatic(
     const yaml_config::YamlConfig& config)
     : config(config),
       ways(config[kWays].As<std::size_t>()),
+      policy(ParsePolicy(config[kPolicy])),
       use_dynamic_config(config["config-settings"].As<bool>(true)) {
   if (ways <= 0) throw std::runtime_error("cache-ways is non-positive");
 }
@@ -0,0 +1,71 @@
+#include <userver/cache/nway_lru_cache.hpp>
+
+#include <atomic>
+#include <vector>
+
+#include <benchmark/benchmark.h>
+
+#include <userver/engine/async.hpp>
+#include <userver/engine/run_standalone.hpp>
+#include <userver/engine/task/task_with_result.hpp>
+
+USERVER_NAMESPACE_BEGIN
+
+namespace {
+
+constexpr std::size_t kWays = 16;
+constexpr std::size_t kWaySize = 1000;
+constexpr int kKeysCount = kWays * kWaySize / 2;
+
+// Read-mostly workload: every 100th request is a write of a cold key
+void ReadMostly(cache::NWayLRU<int, int>& cache, std::size_t thread_id,
+                std::size_t iteration) {
+  const auto key =
+      static_cast<int>((iteration * 7919 + thread_id) % kKeysCount);
+  if (iteration % 100 == 0) {
+    cache.Put(kKeysCount + static_cast<int>(iteration), key);
+  } else {
+    benchmark::DoNotOptimize(cache.Get(key));
+  }
+}
+
+}  // namespace
+
+void nway_lru_read_mostly(benchmark::State& state, cache::CachePolicy policy) {
+  engine::RunStandalone(state.range(0), [&] {
+    cache::NWayLRU<int, int> cache(kWays, kWaySize, {}, {}, policy);
+    for (int i = 0; i < kKeysCount; ++i) cache.Put(i, i);
+
+    const std::size_t concurrent_jobs = state.range(0);
+    std::atomic<bool> keep_running{true};
+    std::vector<engine::TaskWithResult<void>> tasks;
+    tasks.reserve(concurrent_jobs);
+
+    for (std::size_t thread_id = 1; thread_id < concurrent_jobs; ++thread_id) {
+      tasks.push_back(engine::AsyncNoSpan([&, thread_id] {
+        for (std::size_t i = 0; keep_running; ++i) {
+          ReadMostly(cache, thread_id, i);
+        }
+      }));
+    }
+
+    std::size_t i = 0;
+    for ([[maybe_unused]] auto _ : state) {
+      ReadMostly(cache, 0, i++);
+    }
+
+    keep_running = false;
+
+    for (auto& task : tasks) {
+      task.Get();
+    }
+  });
+}
+BENCHMARK_CAPTURE(nway_lru_read_mostly, lru, cache::CachePolicy::kLru)
+    ->RangeMultiplier(2)
+    ->Range(1, 8);
+BENCHMARK_CAPTURE(nway_lru_read_mostly, tinylfu, cache::CachePolicy::kTinyLfu)
+    ->RangeMultiplier(2)
+    ->Range(1, 8);
+
+USERVER_NAMESPACE_END
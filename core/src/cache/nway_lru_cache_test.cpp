@@ -1,6 +1,9 @@
 #include <userver/utest/utest.hpp>
 
+#include <vector>
+
 #include <userver/cache/nway_lru_cache.hpp>
+#include <userver/engine/async.hpp>
 
 USERVER_NAMESPACE_BEGIN
 
@@ -54,6 +57,54 @@ UTEST(NWayLRU, SetMultipleWays) {
   EXPECT_EQ(1, cache.Get(1));
 }
 
+UTEST(NWayLRU, TinyLfu) {
+  Cache cache(2, 100, {}, {}, cache::CachePolicy::kTinyLfu);
+  for (int i = 0; i < 50; ++i) {
+    cache.Put(i, i);
+  }
+  EXPECT_EQ(50, cache.GetSize());
+
+  for (int i = 0; i < 50; ++i) {
+    EXPECT_EQ(i, cache.Get(i));
+    EXPECT_EQ(i, cache.GetOr(i, -1));
+  }
+  EXPECT_EQ(-1, cache.GetOr(100, -1));
+
+  EXPECT_FALSE(cache.Get(1, [](int) { return false; }).has_value());
+  EXPECT_EQ(49, cache.GetSize());
+
+  cache.InvalidateByKey(2);
+  EXPECT_FALSE(cache.Get(2).has_value());
+
+  cache.Invalidate();
+  EXPECT_EQ(0, cache.GetSize());
+}
+
+UTEST_MT(NWayLRU, TinyLfuConcurrentReads, 4) {
+  Cache cache(1, 100, {}, {}, cache::CachePolicy::kTinyLfu);
+  constexpr int kHotKeys = 50;
+  for (int i = 0; i < kHotKeys; ++i) {
+    cache.Put(i, i);
+  }
+
+  std::vector<engine::TaskWithResult<void>> tasks;
+  for (int task = 0; task < 4; ++task) {
+    tasks.push_back(engine::AsyncNoSpan([&cache, task] {
+      for (int i = 0; i < 10000; ++i) {
+        const auto key = i % kHotKeys;
+        EXPECT_EQ(key, cache.Get(key));
+        if (i % 10 == task) cache.Put(1000 + i, i);
+      }
+    }));
+  }
+  for (auto& task : tasks) task.Get();
+
+  // Bulk writes of cold keys do not evict the keys that were read
+  for (int i = 0; i < kHotKeys; ++i) {
+    EXPECT_EQ(i, cache.Get(i));
+  }
+}
+
 UTEST(NWayLRU, HashCombine) {
   for (const auto seed : std::vector<std::size_t>{0, 1, 7, 42, 100, 1000}) {
     /// @note: checking for seed used in way selection to not be equal after
@@ -2,12 +2,14 @@
 
 #include <chrono>
 #include <cstdlib>
+#include <functional>
 #include <limits>
 
 #include <moodycamel/concurrentqueue.h>
 
 #include <userver/components/headers_propagator_component.hpp>
 #include <userver/crypto/openssl.hpp>
+#include <userver/http/url.hpp>
 #include <userver/logging/log.hpp>
 #include <userver/tracing/manager.hpp>
 #include <userver/utils/async.hpp>
@@ -20,6 +22,7 @@
 #include <clients/http/testsuite.hpp>
 #include <curl-ev/multi.hpp>
 #include <curl-ev/ratelimit.hpp>
+#include <curl-ev/share.hpp>
 #include <engine/ev/thread_pool.hpp>
 #include <server/http/headers_propagator.hpp>
 
@@ -50,6 +53,7 @@ Client::Client(ClientSettings settings,
                impl::PluginPipeline&& plugin_pipeline)
     : deadline_propagation_config_(settings.deadline_propagation),
       cancellation_policy_(settings.cancellation_policy),
+      connection_affinity_(settings.connection_affinity),
       destination_statistics_(std::make_shared<DestinationStatistics>()),
       statistics_(settings.io_threads),
       fs_task_processor_(fs_task_processor),
@@ -71,6 +75,14 @@ Client::Client(ClientSettings settings,
 
   ReinitEasy();
 
+  if (settings.share_ssl_sessions) {
+    // Only the TLS sessions are shared: connection caches of different multis
+    // live in different IO threads and libcurl does not allow using a
+    // connection from another thread.
+    ssl_session_share_ = std::make_shared<curl::share>();
+    ssl_session_share_->set_share_ssl_session(true);
+  }
+
   multis_.reserve(io_threads);
 
   // libcurl synchronously reads some of /etc/* files.
@@ -120,6 +132,7 @@ Request Client::CreateRequest() {
     if (easy) {
       auto idx = FindMultiIndex(easy->GetMulti());
       auto wrapper = impl::EasyWrapper{std::move(easy), *this};
+      if (ssl_session_share_) wrapper.Easy().set_share(ssl_session_share_);
       return Request{
           std::move(wrapper),      statistics_[idx].CreateRequestStats(),
           destination_statistics_, resolver_,
@@ -133,6 +146,7 @@ Request Client::CreateRequest() {
                          return impl::EasyWrapper{
                              easy_.Get()->GetBoundBlocking(*multi), *this};
                        }).Get();
+        if (ssl_session_share_) wrapper.Easy().set_share(ssl_session_share_);
         return Request{
             std::move(wrapper),      statistics_[i].CreateRequestStats(),
             destination_statistics_, resolver_,
@@ -255,6 +269,18 @@ std::shared_ptr<curl::easy> Client::TryDequeueIdle() noexcept {
   return result;
 }
 
+Statistics* Client::BindToDestination(curl::easy& easy) {
+  if (connection_affinity_ != ConnectionAffinity::kDestination) return nullptr;
+
+  const auto host =
+      USERVER_NAMESPACE::http::ExtractHostname(easy.get_original_url());
+  const auto idx = std::hash<std::string>{}(host) % multis_.size();
+  if (multis_[idx].get() == easy.GetMulti()) return nullptr;
+
+  easy.Rebind(*multis_[idx]);
+  return &statistics_[idx];
+}
+
 void Client::SetTestsuiteConfig(const TestsuiteConfig& config) {
   LOG_INFO() << "http client: configured for testsuite";
   testsuite_config_ = std::make_shared<const TestsuiteConfig>(config);
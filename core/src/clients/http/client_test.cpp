@@ -23,6 +23,7 @@
 #include <userver/fs/blocking/write.hpp>
 #include <userver/http/common_headers.hpp>
 #include <userver/logging/log.hpp>
+#include <userver/tracing/manager.hpp>
 #include <userver/tracing/tracing.hpp>
 #include <userver/utils/async.hpp>
 #include <userver/utils/userver_info.hpp>
@@ -647,6 +648,41 @@ UTEST(HttpClient, StatsOnTimeout) {
   }
 }
 
+UTEST(HttpClient, ConnectionAffinity) {
+  const utest::SimpleServer http_server{[](const HttpRequest&) {
+    return HttpResponse{
+        "HTTP/1.1 200 OK\r\nContent-Length: 0\r\n\r\n",
+        HttpResponse::kWriteAndContinue};
+  }};
+
+  const tracing::GenericTracingManager tracing_manager{
+      tracing::Format::kYandexTaxi, tracing::Format::kYandexTaxi};
+  clients::http::ClientSettings settings;
+  settings.io_threads = 4;
+  settings.tracing_manager = &tracing_manager;
+  settings.connection_affinity =
+      clients::http::ConnectionAffinity::kDestination;
+  clients::http::Client http_client{
+      std::move(settings), engine::current_task::GetTaskProcessor(),
+      std::vector<utils::NotNull<clients::http::Plugin*>>{}};
+
+  // Each request may start on any IO thread, but must be moved to the one
+  // that keeps the connection to the server
+  std::size_t open_sockets = 0;
+  for (unsigned i = 0; i < kFewRepetitions; ++i) {
+    const auto res = http_client.CreateRequest()
+                         .get(http_server.GetBaseUrl())
+                         .retry(1)
+                         .http_version(clients::http::HttpVersion::k11)
+                         .timeout(kTimeout)
+                         .perform();
+    EXPECT_EQ(res->status_code(), 200);
+    open_sockets += res->GetStats().open_socket_count;
+  }
+
+  EXPECT_EQ(open_sockets, 1);
+}
+
 UTEST(HttpClient, CancelPre) {
   auto task = utils::Async("test", [] {
     const utest::SimpleServer http_server{EchoCallback{}};
@@ -262,6 +262,21 @@ properties:
         enum:
           - cancel
           - ignore
+    connection-affinity:
+        type: string
+        description: |
+            How a request chooses the IO thread to run on. 'destination' keeps
+            requests to the same host on the same thread, so that they reuse
+            the connections from its connection cache. Note that all the
+            requests to a single host are then served by a single thread.
+        defaultDescription: none
+        enum:
+          - none
+          - destination
+    share-ssl-sessions:
+        type: boolean
+        description: share TLS sessions between IO threads to resume them instead of doing full handshakes
+        defaultDescription: false
 )");
 }
 
@@ -47,6 +47,14 @@ CancellationPolicy Parse(yaml_config::YamlConfig value,
   throw std::runtime_error("Invalid CancellationPolicy value: " + str);
 }
 
+ConnectionAffinity Parse(yaml_config::YamlConfig value,
+                         formats::parse::To<ConnectionAffinity>) {
+  auto str = value.As<std::string>();
+  if (str == "none") return ConnectionAffinity::kNone;
+  if (str == "destination") return ConnectionAffinity::kDestination;
+  throw std::runtime_error("Invalid ConnectionAffinity value: " + str);
+}
+
 ClientSettings Parse(const yaml_config::YamlConfig& value,
                      formats::parse::To<ClientSettings>) {
   ClientSettings result;
@@ -55,6 +63,11 @@ ClientSettings Parse(const yaml_config::YamlConfig& value,
   result.io_threads = value["threads"].As<size_t>(result.io_threads);
   result.defer_events = value["defer-events"].As<bool>(result.defer_events);
   result.deadline_propagation = ParseDeadlinePropagationConfig(value);
+  result.connection_affinity =
+      value["connection-affinity"].As<ConnectionAffinity>(
+          result.connection_affinity);
+  result.share_ssl_sessions =
+      value["share-ssl-sessions"].As<bool>(result.share_ssl_sessions);
   return result;
 }
 
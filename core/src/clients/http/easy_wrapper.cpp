@@ -25,6 +25,10 @@ curl::easy& EasyWrapper::Easy() { return *easy_; }
 
 const curl::easy& EasyWrapper::Easy() const { return *easy_; }
 
+Statistics* EasyWrapper::BindToDestination() {
+  return client_.BindToDestination(*easy_);
+}
+
 }  // namespace clients::http::impl
 
 USERVER_NAMESPACE_END
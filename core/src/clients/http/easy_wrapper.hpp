@@ -8,6 +8,7 @@ USERVER_NAMESPACE_BEGIN
 
 namespace clients::http {
 class Client;
+class Statistics;
 }  // namespace clients::http
 
 namespace clients::http::impl {
@@ -26,6 +27,11 @@ class EasyWrapper final {
   curl::easy& Easy();
   const curl::easy& Easy() const;
 
+  /// Rebinds the easy to the multi chosen by the connection affinity of the
+  /// client for the current URL. Returns the statistics of the new multi or
+  /// nullptr if the easy was not moved.
+  Statistics* BindToDestination();
+
  private:
   std::shared_ptr<curl::easy> easy_;
   Client& client_;
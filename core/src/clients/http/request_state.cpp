@@ -486,8 +486,11 @@ void RequestState::on_completed(std::shared_ptr<RequestState> holder,
 
   holder->AccountResponse(err);
   const auto sockets = easy.get_num_connects();
-  holder->WithRequestStats(
-      [sockets](RequestStats& stats) { stats.AccountOpenSockets(sockets); });
+  const bool reused_connection = !err && sockets == 0;
+  holder->WithRequestStats([sockets, reused_connection](RequestStats& stats) {
+    stats.AccountOpenSockets(sockets);
+    if (reused_connection) stats.AccountReusedConnection();
+  });
 
   span.AddTag(tracing::kAttempts, holder->retry_.current);
   if (holder->deadline_propagation_config_.update_header) {
@@ -953,6 +956,12 @@ void RequestState::ResetDataForNewRequest() {
   // the original timeout is exceeded.
   SetEasyTimeout(original_timeout_);
 
+  // The URL is known only now, move the request to the IO thread that keeps
+  // the connections to its destination
+  if (auto* multi_stats = easy_.BindToDestination()) {
+    stats_ = multi_stats->CreateRequestStats();
+  }
+
   StartStats();
 }
 
@@ -37,6 +37,15 @@ RequestStats::~RequestStats() {
 RequestStats::RequestStats(RequestStats&& other) noexcept
     : stats_{std::exchange(other.stats_, nullptr)} {}
 
+RequestStats& RequestStats::operator=(RequestStats&& other) noexcept {
+  if (this != &other) {
+    if (stats_) stats_->easy_handles_--;
+    stats_ = std::exchange(other.stats_, nullptr);
+    start_time_ = other.start_time_;
+  }
+  return *this;
+}
+
 void RequestStats::Start() { start_time_ = std::chrono::steady_clock::now(); }
 
 void RequestStats::FinishOk(int code, unsigned int attempts) noexcept {
@@ -77,6 +86,11 @@ void RequestStats::AccountOpenSockets(size_t sockets) noexcept {
   stats_->socket_open_ += utils::statistics::Rate{sockets};
 }
 
+void RequestStats::AccountReusedConnection() noexcept {
+  UASSERT(stats_);
+  ++stats_->socket_reused_;
+}
+
 void RequestStats::AccountTimeoutUpdatedByDeadline() noexcept {
   UASSERT(stats_);
   ++stats_->timeout_updated_by_deadline_;
@@ -178,6 +192,9 @@ void DumpMetric(utils::statistics::Writer& writer,
   writer["cancelled-by-deadline"] = stats.cancelled_by_deadline;
 
   writer["sockets"]["open"] = stats.multi.socket_open;
+  // Requests that were served by an already established connection, compare
+  // with the sum of `errors` to get the connection reuse ratio
+  writer["sockets"]["reused"] = stats.multi.socket_reused;
 }
 
 void DumpMetric(utils::statistics::Writer& writer,
@@ -220,6 +237,7 @@ InstanceStatistics::InstanceStatistics(const Statistics& other)
   for (size_t i = 0; i < error_count.size(); i++)
     error_count[i] = other.error_count_[i].Load();
   multi.socket_open = other.socket_open_.Load();
+  multi.socket_reused = other.socket_reused_.Load();
 }
 
 uint64_t InstanceStatistics::GetNotOkErrorCount() const {
@@ -28,7 +28,7 @@ class RequestStats final {
   RequestStats& operator=(const RequestStats&) = delete;
 
   RequestStats(RequestStats&&) noexcept;
-  RequestStats& operator=(RequestStats&&) = delete;
+  RequestStats& operator=(RequestStats&&) noexcept;
 
   void Start();
   void FinishOk(int code, unsigned int attempts) noexcept;
@@ -37,6 +37,7 @@ class RequestStats final {
   void StoreTimeToStart(std::chrono::microseconds micro_seconds) noexcept;
 
   void AccountOpenSockets(size_t sockets) noexcept;
+  void AccountReusedConnection() noexcept;
 
   void AccountTimeoutUpdatedByDeadline() noexcept;
   void AccountCancelledByDeadline() noexcept;
@@ -50,12 +51,14 @@ class RequestStats final {
 
 struct MultiStats {
   utils::statistics::Rate socket_open;
+  utils::statistics::Rate socket_reused;
   utils::statistics::Rate socket_close;
   utils::statistics::Rate socket_ratelimit;
   double current_load{0};
 
   MultiStats& operator+=(const MultiStats& other) {
     socket_open += other.socket_open;
+    socket_reused += other.socket_reused;
     socket_close += other.socket_close;
     socket_ratelimit += other.socket_ratelimit;
     current_load += other.current_load;
@@ -105,6 +108,7 @@ class Statistics {
   std::array<utils::statistics::RateCounter, kErrorGroupCount> error_count_;
   utils::statistics::RateCounter retries_;
   utils::statistics::RateCounter socket_open_{0};
+  utils::statistics::RateCounter socket_reused_{0};
   utils::statistics::RateCounter timeout_updated_by_deadline_;
   utils::statistics::RateCounter cancelled_by_deadline_;
   utils::statistics::HttpCodes reply_status_;
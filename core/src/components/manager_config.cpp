@@ -137,6 +137,16 @@ properties:
                 description: >
                     Whether to defer timer events to a per-thread periodic timer
                     or notify ev-loop right away
+            use_io_uring:
+                type: boolean
+                description: >
+                    Whether to complete socket and file operations that would
+                    block with a per-thread io_uring instead of waiting for
+                    readiness notifications; falls back to readiness
+                    notifications if io_uring is not available. With io_uring
+                    fs::ReadFileContents and fs::RewriteFileContents do not use
+                    the passed task processor
+                defaultDescription: false
     components:
         type: object
         description: 'dictionary of "component name": "options"'
@@ -178,6 +188,34 @@ properties:
                         tunes the number of spin-wait iterations in case of
                         an empty task queue before threads go to sleep
                     defaultDescription: 10000
+                spinning-policy:
+                    type: string
+                    description: |
+                        `fixed` spins for spinning-iterations, `adaptive`
+                        tunes the spin limit between spinning-iterations / 16
+                        and spinning-iterations * 16 from the recent wake-ups
+                    defaultDescription: fixed
+                    enum:
+                      - fixed
+                      - adaptive
+                hot-workers:
+                    type: integer
+                    description: |
+                        number of idle worker threads that keep spinning
+                        instead of going to sleep and get new tasks first
+                    defaultDescription: 0
+                    minimum: 0
+                task-processor-queue:
+                    type: string
+                    description: |
+                        task queue implementation. `work-stealing-task-queue`
+                        keeps a local queue per worker thread and steals
+                        tasks from other workers when idle, which reduces
+                        contention on processors with many threads
+                    defaultDescription: global-task-queue
+                    enum:
+                      - global-task-queue
+                      - work-stealing-task-queue
                 task-trace:
                     type: object
                     description: .
@@ -48,6 +48,15 @@ void DumpMetric(utils::statistics::Writer& writer,
     context_switch["no_overloaded"] = counter.GetTasksNoOverloadSensor().value;
   }
 
+  const auto spinning = task_processor.GetSpinningStats();
+  if (auto idle_workers = writer["idle_workers"]) {
+    idle_workers["spin_wakeups"] = spinning.spin_wakeups.value;
+    idle_workers["spin_iterations"] = spinning.spin_iterations.value;
+    idle_workers["parks"] = spinning.parks.value;
+    idle_workers["spin_limit"] = spinning.spin_limit;
+    idle_workers["hot"] = spinning.hot_workers;
+  }
+
   writer["worker-threads"] = task_processor.GetWorkerCount();
 }
 
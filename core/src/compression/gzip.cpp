@@ -3,12 +3,103 @@
 #include <boost/iostreams/filter/gzip.hpp>
 #include <boost/iostreams/filtering_stream.hpp>
 
+#include <zlib.h>
+
+#include <userver/utils/assert.hpp>
+
 USERVER_NAMESPACE_BEGIN
 
 namespace compression::gzip {
 
 namespace {
 constexpr auto kDecompressBufferSize = 1024;
+// Room for the sync flush marker and gzip header/trailer on top of
+// deflateBound(), which only accounts for the deflate stream itself
+constexpr std::size_t kCompressOutputReserve = 32;
+
+// 15 is the maximum window size, +16 makes zlib write a gzip header and
+// trailer instead of the zlib ones
+constexpr int kGzipWindowBits = 15 + 16;
+constexpr int kMemLevel = 8;
+
+class Deflater final {
+ public:
+  explicit Deflater(int level) {
+    if (deflateInit2(&stream_, level, Z_DEFLATED, kGzipWindowBits, kMemLevel,
+                     Z_DEFAULT_STRATEGY) != Z_OK) {
+      throw CompressionError("failed to initialize gzip compression stream");
+    }
+  }
+
+  ~Deflater() { deflateEnd(&stream_); }
+
+  Deflater(Deflater&&) = delete;
+  Deflater& operator=(Deflater&&) = delete;
+
+  std::string Deflate(std::string_view data, int flush) {
+    std::string output;
+
+    // NOLINTNEXTLINE(cppcoreguidelines-pro-type-const-cast)
+    stream_.next_in = reinterpret_cast<Bytef*>(const_cast<char*>(data.data()));
+    stream_.avail_in = data.size();
+
+    int ret = Z_OK;
+    do {
+      const auto old_size = output.size();
+      const std::size_t chunk_size =
+          deflateBound(&stream_, stream_.avail_in) + kCompressOutputReserve;
+      output.resize(old_size + chunk_size);
+
+      stream_.next_out = reinterpret_cast<Bytef*>(output.data() + old_size);
+      stream_.avail_out = chunk_size;
+
+      ret = deflate(&stream_, flush);
+      if (ret == Z_STREAM_ERROR) {
+        throw CompressionError("failed to compress data with gzip");
+      }
+      output.resize(old_size + chunk_size - stream_.avail_out);
+    } while (stream_.avail_out == 0 ||
+             (flush == Z_FINISH && ret != Z_STREAM_END));
+
+    UASSERT(stream_.avail_in == 0);
+    return output;
+  }
+
+ private:
+  z_stream stream_{};
+};
+
+}  // namespace
+
+struct StreamCompressor::Impl final {
+  explicit Impl(int level) : deflater(level) {}
+
+  Deflater deflater;
+};
+
+StreamCompressor::StreamCompressor(int level)
+    : impl_(std::make_unique<Impl>(level)) {}
+
+StreamCompressor::StreamCompressor(StreamCompressor&&) noexcept = default;
+
+StreamCompressor& StreamCompressor::operator=(StreamCompressor&&) noexcept =
+    default;
+
+StreamCompressor::~StreamCompressor() = default;
+
+std::string StreamCompressor::Compress(std::string_view chunk) {
+  UASSERT(impl_);
+  return impl_->deflater.Deflate(chunk, Z_SYNC_FLUSH);
+}
+
+std::string StreamCompressor::Finish() {
+  UASSERT(impl_);
+  return impl_->deflater.Deflate({}, Z_FINISH);
+}
+
+std::string Compress(std::string_view data, int level) {
+  Deflater deflater{level};
+  return deflater.Deflate(data, Z_FINISH);
 }
 
 std::string Decompress(std::string_view compressed, size_t max_size) {
@@ -1,5 +1,7 @@
 #pragma once
 
+#include <memory>
+#include <string>
 #include <string_view>
 
 #include <userver/compression/error.hpp>
@@ -12,6 +14,36 @@ namespace compression::gzip {
 /// @throws DecompressionError
 std::string Decompress(std::string_view compressed, size_t max_size);
 
+/// Compresses the string, `level` is in [1, 9] range.
+/// @throws CompressionError
+std::string Compress(std::string_view data, int level);
+
+/// @brief Compresses the data chunk by chunk into a single gzip stream.
+///
+/// Output of each Compress() call is flushed, so it may be sent to the
+/// client right away and decompressed on arrival.
+class StreamCompressor final {
+ public:
+  /// @throws CompressionError
+  explicit StreamCompressor(int level);
+
+  StreamCompressor(StreamCompressor&&) noexcept;
+  StreamCompressor& operator=(StreamCompressor&&) noexcept;
+  ~StreamCompressor();
+
+  /// Compresses the chunk and flushes the output.
+  /// @throws CompressionError
+  std::string Compress(std::string_view chunk);
+
+  /// Finishes the stream, no calls are allowed after it.
+  /// @throws CompressionError
+  std::string Finish();
+
+ private:
+  struct Impl;
+  std::unique_ptr<Impl> impl_;
+};
+
 }  // namespace compression::gzip
 
 USERVER_NAMESPACE_END
@@ -29,4 +29,33 @@ TEST(Gzip, TestOverflow) {
                compression::TooBigError);
 }
 
+TEST(Gzip, CompressRoundtrip) {
+  std::string data;
+  for (int i = 0; i < 1000; ++i) {
+    data += R"({"id":)" + std::to_string(i) + R"(,"name":"item"},)";
+  }
+
+  const auto compressed = compression::gzip::Compress(data, 6);
+  EXPECT_LT(compressed.size(), data.size());
+  EXPECT_EQ(compression::gzip::Decompress(compressed, data.size()), data);
+}
+
+TEST(Gzip, StreamCompressRoundtrip) {
+  compression::gzip::StreamCompressor compressor{1};
+
+  std::string data;
+  std::string compressed;
+  for (int i = 0; i < 100; ++i) {
+    const auto chunk = "chunk #" + std::to_string(i) + '\n';
+    data += chunk;
+    const auto compressed_chunk = compressor.Compress(chunk);
+    // Every chunk is flushed, so that the client may decode it right away
+    EXPECT_FALSE(compressed_chunk.empty());
+    compressed += compressed_chunk;
+  }
+  compressed += compressor.Finish();
+
+  EXPECT_EQ(compression::gzip::Decompress(compressed, data.size()), data);
+}
+
 USERVER_NAMESPACE_END
@@ -140,6 +140,11 @@ std::shared_ptr<easy> easy::GetBoundBlocking(multi& multi_handle) const {
   return std::make_shared<easy>(cloned, &multi_handle);
 }
 
+void easy::Rebind(multi& multi_handle) {
+  UASSERT(!multi_registered_);
+  multi_ = &multi_handle;
+}
+
 easy* easy::from_native(native::CURL* native_easy) {
   easy* easy_handle = nullptr;
   native::curl_easy_getinfo(native_easy, native::CURLINFO_PRIVATE,
@@ -604,7 +609,7 @@ void easy::set_share(std::shared_ptr<share> share) {
 void easy::set_share(std::shared_ptr<share> share, std::error_code& ec) {
   share_ = std::move(share);
 
-  if (share) {
+  if (share_) {
     ec = std::error_code{
         static_cast<errc::EasyErrorCode>(native::curl_easy_setopt(
             handle_, native::CURLOPT_SHARE, share_->native_handle()))};
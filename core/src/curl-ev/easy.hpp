@@ -222,6 +222,10 @@ class easy final : public std::enable_shared_from_this<easy> {
 
   const multi* GetMulti() const { return multi_; }
 
+  // Moves an idle easy to another multi. Connections are owned by the multi,
+  // so nothing is lost except the affinity to the previous one.
+  void Rebind(multi&);
+
   inline native::CURL* native_handle() { return handle_; }
   engine::ev::ThreadControl& GetThreadControl();
 
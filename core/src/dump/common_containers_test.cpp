@@ -79,6 +79,21 @@ TEST(DumpCommonContainers, Vector) {
   TestWriteReadCycle(std::vector<std::string>{});
 }
 
+TEST(DumpCommonContainers, VectorBulk) {
+  TestWriteReadCycle(std::vector<double>{1.5, -2, 1e300});
+  TestWriteReadCycle(std::vector<std::int8_t>{1, -2, 127});
+  TestWriteReadCycle(std::vector<std::uint8_t>{});
+
+  // Larger than a single bulk read
+  std::vector<double> large(100'000);
+  for (std::size_t i = 0; i < large.size(); ++i) large[i] = i * 0.25;
+  TestWriteReadCycle(large);
+
+  // Same format as the element-wise one
+  EXPECT_EQ(ToBinary(std::vector<std::uint8_t>{1, 2, 3}),
+            ToBinary(std::vector<int>{1, 2, 3}));
+}
+
 TEST(DumpCommonContainers, Pair) {
   TestWriteReadCycle(std::pair<int, int>{1, 2});
   TestWriteReadCycle(std::pair<const int, int>{1, 2});
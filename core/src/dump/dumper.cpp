@@ -574,6 +574,10 @@ properties:
                 type: boolean
                 description: Whether to encrypt the dump
                 defaultDescription: false
+            compressed:
+                type: boolean
+                description: Whether to compress the dump with zstd
+                defaultDescription: false
 )");
 }
 
@@ -1,6 +1,7 @@
 #include <userver/dump/factory.hpp>
 
 #include <dump/secdist.hpp>
+#include <userver/dump/operations_compressed.hpp>
 #include <userver/dump/operations_encrypted.hpp>
 #include <userver/dump/operations_file.hpp>
 #include <userver/storages/secdist/component.hpp>
@@ -31,13 +32,16 @@ std::unique_ptr<dump::OperationsFactory> CreateOperationsFactory(
     return std::make_unique<dump::EncryptedOperationsFactory>(
         std::move(secret_key), dump_perms);
   } else {
-    return std::make_unique<dump::FileOperationsFactory>(dump_perms);
+    return CreateDefaultOperationsFactory(config);
   }
 }
 
 std::unique_ptr<dump::OperationsFactory> CreateDefaultOperationsFactory(
     const Config& config) {
   auto dump_perms = GetPerms(config);
+  if (config.dump_is_compressed) {
+    return std::make_unique<dump::CompressedOperationsFactory>(dump_perms);
+  }
   return std::make_unique<dump::FileOperationsFactory>(dump_perms);
 }
 
@@ -0,0 +1,325 @@
+#include <userver/dump/operations_compressed.hpp>
+
+#include <sys/mman.h>
+
+#include <cstdint>
+#include <cstring>
+#include <deque>
+#include <optional>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#include <boost/endian/conversion.hpp>
+#include <fmt/format.h>
+
+#include <userver/compression/zstd.hpp>
+#include <userver/dump/unsafe.hpp>
+#include <userver/engine/async.hpp>
+#include <userver/engine/task/task_with_result.hpp>
+#include <userver/fs/blocking/file_descriptor.hpp>
+#include <userver/utils/assert.hpp>
+
+#include <utils/check_syscall.hpp>
+
+USERVER_NAMESPACE_BEGIN
+
+namespace dump {
+
+namespace {
+
+// The file starts with the magic, followed by the chunks. Each chunk is
+// a ChunkHeader and `stored_size` bytes of a zstd frame holding `raw_size`
+// bytes, or of the raw data if it does not compress. The header fields are
+// little endian.
+constexpr std::string_view kMagic = "UDMPZST1";
+
+// Chunks are decompressed independently, so they are the unit of parallelism
+constexpr std::size_t kChunkSize = 1 << 20;
+
+constexpr int kCompressionLevel = 1;
+
+// Chunks decompressed ahead of the reader. Limits the memory used by the
+// reader to kChunksInFlight * kChunkSize.
+constexpr std::size_t kChunksInFlight = 8;
+
+struct ChunkHeader final {
+  std::uint64_t raw_size;
+  std::uint64_t stored_size;
+};
+
+static_assert(std::is_trivially_copyable_v<ChunkHeader>);
+
+struct Chunk final {
+  // Either a zstd frame or the raw data, if its size is `raw_size`
+  std::string_view stored;
+  std::size_t raw_size;
+};
+
+class MappedFile final {
+ public:
+  explicit MappedFile(const std::string& path) {
+    auto file = fs::blocking::FileDescriptor::Open(
+        path, fs::blocking::OpenFlag::kRead);
+    size_ = file.GetSize();
+    if (size_ == 0) return;
+
+    // The mapping stays valid after the file is closed
+    void* data = utils::CheckSyscallNotEquals(
+        ::mmap(nullptr, size_, PROT_READ, MAP_PRIVATE, file.GetNative(), 0),
+        MAP_FAILED, "mapping the dump file '{}'", path);
+    data_ = static_cast<const char*>(data);
+
+    // A failed hint is not worth failing the read
+    ::madvise(data, size_, MADV_SEQUENTIAL);
+  }
+
+  ~MappedFile() {
+    if (data_) ::munmap(const_cast<char*>(data_), size_);
+  }
+
+  MappedFile(const MappedFile&) = delete;
+  MappedFile& operator=(const MappedFile&) = delete;
+
+  std::string_view GetContents() const { return {data_, size_}; }
+
+ private:
+  const char* data_{nullptr};
+  std::size_t size_{0};
+};
+
+std::vector<Chunk> ParseChunks(std::string_view contents,
+                               const std::string& path) {
+  if (contents.substr(0, kMagic.size()) != kMagic) {
+    throw Error(fmt::format(
+        "The dump file \"{}\" is not a compressed dump", path));
+  }
+  contents.remove_prefix(kMagic.size());
+
+  std::vector<Chunk> chunks;
+  while (!contents.empty()) {
+    ChunkHeader header{};
+    if (contents.size() < sizeof(header)) {
+      throw Error(fmt::format(
+          "Unexpected end-of-file in a chunk header of the dump file \"{}\"",
+          path));
+    }
+    std::memcpy(&header, contents.data(), sizeof(header));
+    contents.remove_prefix(sizeof(header));
+    boost::endian::little_to_native_inplace(header.raw_size);
+    boost::endian::little_to_native_inplace(header.stored_size);
+
+    if (header.stored_size > contents.size() ||
+        header.stored_size > header.raw_size) {
+      throw Error(fmt::format(
+          "Broken chunk in the dump file \"{}\": raw-size={}, stored-size={}, "
+          "remaining-size={}",
+          path, header.raw_size, header.stored_size, contents.size()));
+    }
+    chunks.push_back({contents.substr(0, header.stored_size),
+                      static_cast<std::size_t>(header.raw_size)});
+    contents.remove_prefix(header.stored_size);
+  }
+  return chunks;
+}
+
+std::string DecompressChunk(Chunk chunk, const std::string& path) {
+  std::string data;
+  try {
+    data = compression::zstd::Decompress(chunk.stored, chunk.raw_size);
+  } catch (const std::exception& ex) {
+    throw Error(fmt::format("Failed to decompress the dump file \"{}\": {}",
+                            path, ex.what()));
+  }
+
+  if (data.size() != chunk.raw_size) {
+    throw Error(fmt::format(
+        "Broken chunk in the dump file \"{}\": raw-size={}, "
+        "decompressed-size={}",
+        path, chunk.raw_size, data.size()));
+  }
+  return data;
+}
+
+}  // namespace
+
+CompressedWriter::CompressedWriter(std::string path,
+                                   boost::filesystem::perms perms,
+                                   tracing::ScopeTime& scope)
+    : file_writer_(std::move(path), perms, scope) {
+  chunk_.reserve(kChunkSize);
+  WriteStringViewUnsafe(file_writer_, kMagic);
+}
+
+void CompressedWriter::WriteRaw(std::string_view data) {
+  while (!data.empty()) {
+    const auto part = data.substr(0, kChunkSize - chunk_.size());
+    chunk_.append(part);
+    data.remove_prefix(part.size());
+
+    if (chunk_.size() == kChunkSize) WriteChunk();
+  }
+}
+
+void CompressedWriter::Finish() {
+  if (!chunk_.empty()) WriteChunk();
+  file_writer_.Finish();
+}
+
+void CompressedWriter::WriteChunk() {
+  std::string compressed;
+  try {
+    compressed = compression::zstd::Compress(chunk_, kCompressionLevel);
+  } catch (const std::exception& ex) {
+    throw Error(fmt::format("Failed to compress a dump chunk: {}", ex.what()));
+  }
+
+  // Data that does not compress is stored as is and is read without copying
+  const std::string_view stored =
+      compressed.size() < chunk_.size() ? compressed : chunk_;
+
+  const ChunkHeader header{
+      boost::endian::native_to_little(std::uint64_t{chunk_.size()}),
+      boost::endian::native_to_little(std::uint64_t{stored.size()})};
+  WriteStringViewUnsafe(
+      file_writer_,
+      std::string_view{reinterpret_cast<const char*>(&header), sizeof(header)});
+  WriteStringViewUnsafe(file_writer_, stored);
+
+  chunk_.clear();
+}
+
+struct CompressedReader::Impl final {
+  explicit Impl(std::string path);
+
+  // Makes the next chunk current, returns false if there are no chunks left
+  bool NextChunk();
+
+  void StartDecompression();
+
+  std::string path;
+  MappedFile file;
+  std::vector<Chunk> chunks;
+
+  // Decompression tasks of the chunks following the current one, in order.
+  // No task is started for the chunks stored uncompressed. The tasks are
+  // destroyed before the file is unmapped.
+  std::deque<std::optional<engine::TaskWithResult<std::string>>> pending;
+  std::size_t next_chunk{0};
+
+  std::string current_storage;
+  // The unread part of the current chunk
+  std::string_view current;
+  // Holds the data that spans several chunks
+  std::string buffer;
+};
+
+CompressedReader::Impl::Impl(std::string file_path)
+    : path(std::move(file_path)),
+      file([this] {
+        try {
+          return MappedFile{path};
+        } catch (const std::exception& ex) {
+          throw Error(fmt::format(
+              "Failed to open the dump file for reading \"{}\". Reason: {}",
+              path, ex.what()));
+        }
+      }()),
+      chunks(ParseChunks(file.GetContents(), path)) {}
+
+void CompressedReader::Impl::StartDecompression() {
+  while (pending.size() < kChunksInFlight && next_chunk < chunks.size()) {
+    const auto chunk = chunks[next_chunk++];
+    if (chunk.stored.size() == chunk.raw_size) {
+      pending.emplace_back();
+    } else {
+      pending.emplace_back(engine::AsyncNoSpan(
+          [chunk, &path = path] { return DecompressChunk(chunk, path); }));
+    }
+  }
+}
+
+bool CompressedReader::Impl::NextChunk() {
+  StartDecompression();
+  if (pending.empty()) return false;
+
+  const auto chunk = chunks[next_chunk - pending.size()];
+  auto task = std::move(pending.front());
+  pending.pop_front();
+
+  if (task) {
+    current_storage = task->Get();
+    current = current_storage;
+  } else {
+    current = chunk.stored;
+  }
+
+  StartDecompression();
+  return true;
+}
+
+CompressedReader::CompressedReader(std::string path)
+    : impl_(std::make_unique<Impl>(std::move(path))) {}
+
+CompressedReader::~CompressedReader() = default;
+
+std::string_view CompressedReader::ReadRaw(std::size_t max_size) {
+  auto& impl = *impl_;
+
+  while (impl.current.empty()) {
+    if (!impl.NextChunk()) return {};
+  }
+
+  // Fast path: the data is returned right from the current chunk
+  if (impl.current.size() >= max_size) {
+    const auto result = impl.current.substr(0, max_size);
+    impl.current.remove_prefix(max_size);
+    return result;
+  }
+
+  impl.buffer.clear();
+  while (impl.buffer.size() < max_size) {
+    const auto part = impl.current.substr(0, max_size - impl.buffer.size());
+    impl.buffer.append(part);
+    impl.current.remove_prefix(part.size());
+
+    if (impl.current.empty() && !impl.NextChunk()) break;
+  }
+  return impl.buffer;
+}
+
+void CompressedReader::Finish() {
+  auto& impl = *impl_;
+
+  std::size_t unread_size = impl.current.size();
+  for (std::size_t i = impl.next_chunk - impl.pending.size();
+       i < impl.chunks.size(); ++i) {
+    unread_size += impl.chunks[i].raw_size;
+  }
+
+  if (unread_size != 0) {
+    throw Error(
+        fmt::format("Unexpected extra data at the end of the dump file \"{}\": "
+                    "unread-size={}",
+                    impl.path, unread_size));
+  }
+}
+
+CompressedOperationsFactory::CompressedOperationsFactory(
+    boost::filesystem::perms perms)
+    : perms_(perms) {}
+
+std::unique_ptr<Reader> CompressedOperationsFactory::CreateReader(
+    std::string full_path) {
+  return std::make_unique<CompressedReader>(std::move(full_path));
+}
+
+std::unique_ptr<Writer> CompressedOperationsFactory::CreateWriter(
+    std::string full_path, tracing::ScopeTime& scope) {
+  return std::make_unique<CompressedWriter>(std::move(full_path), perms_,
+                                            scope);
+}
+
+}  // namespace dump
+
+USERVER_NAMESPACE_END
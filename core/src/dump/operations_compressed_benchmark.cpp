@@ -0,0 +1,99 @@
+#include <userver/dump/operations_compressed.hpp>
+
+#include <memory>
+#include <string>
+#include <vector>
+
+#include <benchmark/benchmark.h>
+#include <boost/filesystem/operations.hpp>
+
+#include <userver/dump/common_containers.hpp>
+#include <userver/dump/operations_file.hpp>
+#include <userver/engine/run_standalone.hpp>
+#include <userver/fs/blocking/temp_directory.hpp>
+#include <userver/tracing/span.hpp>
+
+USERVER_NAMESPACE_BEGIN
+
+namespace {
+
+constexpr std::size_t kStringsCount = 200'000;
+constexpr std::size_t kDoublesCount = 1'000'000;
+
+struct Data final {
+  std::vector<std::string> strings;
+  std::vector<double> doubles;
+};
+
+Data GenerateData() {
+  Data data;
+  data.strings.reserve(kStringsCount);
+  for (std::size_t i = 0; i < kStringsCount; ++i) {
+    data.strings.push_back("value-" + std::to_string(i * 7919));
+  }
+  data.doubles.reserve(kDoublesCount);
+  for (std::size_t i = 0; i < kDoublesCount; ++i) {
+    data.doubles.push_back(i * 0.5);
+  }
+  return data;
+}
+
+void WriteData(dump::Writer& writer, const Data& data) {
+  writer.Write(data.strings);
+  writer.Write(data.doubles);
+  writer.Finish();
+}
+
+void ReadData(dump::Reader& reader) {
+  benchmark::DoNotOptimize(reader.Read<std::vector<std::string>>());
+  benchmark::DoNotOptimize(reader.Read<std::vector<double>>());
+  reader.Finish();
+}
+
+}  // namespace
+
+void dump_read_file(benchmark::State& state) {
+  engine::RunStandalone(state.range(0), [&] {
+    const auto dir = fs::blocking::TempDirectory::Create();
+    const auto path = dir.GetPath() + "/file";
+    {
+      tracing::Span span{"dump_benchmark"};
+      auto scope = span.CreateScopeTime("dump");
+      dump::FileWriter writer(path, boost::filesystem::perms::owner_read,
+                              scope);
+      WriteData(writer, GenerateData());
+    }
+
+    for ([[maybe_unused]] auto _ : state) {
+      dump::FileReader reader(path);
+      ReadData(reader);
+    }
+    state.counters["file_size"] =
+        static_cast<double>(boost::filesystem::file_size(path));
+  });
+}
+BENCHMARK(dump_read_file)->Arg(1)->Arg(4);
+
+void dump_read_compressed(benchmark::State& state) {
+  engine::RunStandalone(state.range(0), [&] {
+    const auto dir = fs::blocking::TempDirectory::Create();
+    const auto path = dir.GetPath() + "/file";
+    {
+      tracing::Span span{"dump_benchmark"};
+      auto scope = span.CreateScopeTime("dump");
+      dump::CompressedWriter writer(path, boost::filesystem::perms::owner_read,
+                                    scope);
+      WriteData(writer, GenerateData());
+    }
+
+    for ([[maybe_unused]] auto _ : state) {
+      dump::CompressedReader reader(path);
+      ReadData(reader);
+    }
+    state.counters["file_size"] =
+        static_cast<double>(boost::filesystem::file_size(path));
+  });
+}
+BENCHMARK(dump_read_compressed)->Arg(1)->Arg(4);
+
+USERVER_NAMESPACE_END
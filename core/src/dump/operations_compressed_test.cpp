@@ -0,0 +1,160 @@
+#include <userver/utest/utest.hpp>
+
+#include <random>
+#include <string>
+#include <vector>
+
+#include <boost/filesystem/operations.hpp>
+
+#include <userver/dump/common.hpp>
+#include <userver/dump/common_containers.hpp>
+#include <userver/dump/operations_compressed.hpp>
+#include <userver/dump/operations_file.hpp>
+#include <userver/fs/blocking/temp_directory.hpp>
+#include <userver/tracing/span.hpp>
+
+USERVER_NAMESPACE_BEGIN
+
+namespace {
+
+// Larger than a compressed chunk, so that the data spans several of them
+constexpr std::size_t kLongSize = 3'500'000;
+
+std::string GenerateRandomData(std::size_t size) {
+  std::mt19937 engine(42);
+  std::uniform_int_distribution<int> dist(0, 255);
+
+  std::string data(size, '\0');
+  for (auto& c : data) c = static_cast<char>(dist(engine));
+  return data;
+}
+
+void TestLongRoundTrip(const std::string& data) {
+  const auto dir = fs::blocking::TempDirectory::Create();
+  const auto path = dir.GetPath() + "/file";
+
+  auto scope_time = tracing::Span::CurrentSpan().CreateScopeTime("dump");
+  dump::CompressedWriter w(path, boost::filesystem::perms::owner_read,
+                           scope_time);
+  w.Write(1);
+  w.Write(data);
+  w.Write(std::vector<double>(100'000, 0.5));
+  w.Write(2);
+  UEXPECT_NO_THROW(w.Finish());
+
+  dump::CompressedReader r(path);
+  EXPECT_EQ(r.Read<int>(), 1);
+  EXPECT_EQ(r.Read<std::string>(), data);
+  EXPECT_EQ(r.Read<std::vector<double>>(), std::vector<double>(100'000, 0.5));
+  EXPECT_EQ(r.Read<int>(), 2);
+
+  UEXPECT_THROW(r.Read<int>(), dump::Error);
+
+  UEXPECT_NO_THROW(r.Finish());
+}
+
+}  // namespace
+
+UTEST(DumpCompressedFile, Smoke) {
+  const auto dir = fs::blocking::TempDirectory::Create();
+  const auto path = dir.GetPath() + "/file";
+
+  auto scope_time = tracing::Span::CurrentSpan().CreateScopeTime("dump");
+  dump::CompressedWriter w(path, boost::filesystem::perms::owner_read,
+                           scope_time);
+
+  w.Write(1);
+  w.Write(std::string{"abc"});
+  UEXPECT_NO_THROW(w.Finish());
+
+  dump::CompressedReader r(path);
+  EXPECT_EQ(r.Read<int32_t>(), 1);
+  EXPECT_EQ(r.Read<std::string>(), "abc");
+
+  UEXPECT_THROW(r.Read<int32_t>(), dump::Error);
+
+  UEXPECT_NO_THROW(r.Finish());
+}
+
+UTEST(DumpCompressedFile, Empty) {
+  const auto dir = fs::blocking::TempDirectory::Create();
+  const auto path = dir.GetPath() + "/file";
+
+  auto scope_time = tracing::Span::CurrentSpan().CreateScopeTime("dump");
+  dump::CompressedWriter w(path, boost::filesystem::perms::owner_read,
+                           scope_time);
+  UEXPECT_NO_THROW(w.Finish());
+
+  dump::CompressedReader r(path);
+  UEXPECT_THROW(r.Read<int32_t>(), dump::Error);
+  UEXPECT_NO_THROW(r.Finish());
+}
+
+UTEST(DumpCompressedFile, UnreadData) {
+  const auto dir = fs::blocking::TempDirectory::Create();
+  const auto path = dir.GetPath() + "/file";
+
+  auto scope_time = tracing::Span::CurrentSpan().CreateScopeTime("dump");
+  dump::CompressedWriter w(path, boost::filesystem::perms::owner_read,
+                           scope_time);
+
+  w.Write(1);
+  UEXPECT_NO_THROW(w.Finish());
+
+  dump::CompressedReader r(path);
+
+  UEXPECT_THROW(r.Finish(), dump::Error);
+}
+
+UTEST(DumpCompressedFile, LongCompressible) {
+  TestLongRoundTrip(std::string(kLongSize, 'a'));
+}
+
+UTEST(DumpCompressedFile, LongIncompressible) {
+  TestLongRoundTrip(GenerateRandomData(kLongSize));
+}
+
+UTEST(DumpCompressedFile, CompressesData) {
+  const auto dir = fs::blocking::TempDirectory::Create();
+  const auto path = dir.GetPath() + "/file";
+
+  auto scope_time = tracing::Span::CurrentSpan().CreateScopeTime("dump");
+  dump::CompressedWriter w(path, boost::filesystem::perms::owner_read,
+                           scope_time);
+  w.Write(std::string(kLongSize, 'a'));
+  UEXPECT_NO_THROW(w.Finish());
+
+  EXPECT_LT(boost::filesystem::file_size(path), kLongSize / 100);
+}
+
+UTEST(DumpCompressedFile, NotCompressed) {
+  const auto dir = fs::blocking::TempDirectory::Create();
+  const auto path = dir.GetPath() + "/file";
+
+  auto scope_time = tracing::Span::CurrentSpan().CreateScopeTime("dump");
+  dump::FileWriter w(path, boost::filesystem::perms::owner_read, scope_time);
+  w.Write(std::string(100, 'a'));
+  UEXPECT_NO_THROW(w.Finish());
+
+  UEXPECT_THROW(dump::CompressedReader{path}, dump::Error);
+}
+
+UTEST(DumpCompressedFile, Truncated) {
+  const auto dir = fs::blocking::TempDirectory::Create();
+  const auto path = dir.GetPath() + "/file";
+  const auto truncated_path = dir.GetPath() + "/truncated";
+
+  auto scope_time = tracing::Span::CurrentSpan().CreateScopeTime("dump");
+  dump::CompressedWriter w(path, boost::filesystem::perms::owner_all,
+                           scope_time);
+  w.Write(std::string(kLongSize, 'a'));
+  UEXPECT_NO_THROW(w.Finish());
+
+  boost::filesystem::copy_file(path, truncated_path);
+  boost::filesystem::resize_file(truncated_path,
+                                 boost::filesystem::file_size(path) - 1);
+
+  UEXPECT_THROW(dump::CompressedReader{truncated_path}, dump::Error);
+}
+
+USERVER_NAMESPACE_END
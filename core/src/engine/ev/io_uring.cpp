@@ -0,0 +1,372 @@
+#include "io_uring.hpp"
+
+#ifdef USERVER_FEATURE_IO_URING_ENABLED
+#include <fcntl.h>
+#include <sys/eventfd.h>
+#include <unistd.h>
+
+#include <cerrno>
+#include <chrono>
+#include <system_error>
+#include <unordered_map>
+
+#include <ev.h>
+#include <liburing.h>
+
+#include <userver/engine/future_status.hpp>
+#include <userver/engine/single_use_event.hpp>
+#include <userver/utils/fast_scope_guard.hpp>
+
+#include <engine/ev/async_payload_base.hpp>
+#include <engine/ev/thread.hpp>
+#endif
+
+#include <userver/logging/log.hpp>
+#include <userver/utils/assert.hpp>
+
+USERVER_NAMESPACE_BEGIN
+
+namespace engine::ev {
+
+#ifdef USERVER_FEATURE_IO_URING_ENABLED
+
+namespace {
+
+constexpr unsigned kQueueEntries = 256;
+
+// Period of the warnings while the in-flight requests are drained on stop
+constexpr std::chrono::seconds kDrainWarningPeriod{1};
+
+// Submission queue entries with this user data are not tracked, e.g. cancels
+constexpr IoUring::RequestId kUntrackedRequestId = 0;
+
+}  // namespace
+
+class IoUringRequest;
+
+struct IoUring::Impl final {
+  explicit Impl(Thread& thread) : thread(thread) {}
+  ~Impl();
+
+  io_uring_sqe& GetSqe() noexcept;
+  void Prepare(IoUringRequest& request) noexcept;
+  void PrepareCancel(RequestId id) noexcept;
+  void Cancel(RequestId id);
+  void Submit() noexcept;
+  void ReapCompletions() noexcept;
+  void DrainInFlight() noexcept;
+
+  static void OnCompletion(struct ev_loop*, ev_io* watcher, int) noexcept;
+
+  Thread& thread;
+  io_uring ring{};
+  bool is_ring_initialized{false};
+  int event_fd{-1};
+  ev_io completion_watcher{};
+  std::atomic<RequestId> next_request_id{kUntrackedRequestId + 1};
+  // All the in-flight requests are cancelled on stop
+  std::atomic<bool> is_stopping{false};
+
+  // Accessed on the ev thread only
+  std::unordered_map<RequestId, IoUringRequest*> in_flight;
+  unsigned prepared_entries{0};
+};
+
+class IoUringRequest final : public SingleShotAsyncPayload<IoUringRequest> {
+ public:
+  IoUringRequest(IoUring::Impl& impl, const IoUringOperation& operation,
+          IoUring::RequestId id) noexcept
+      : impl_(impl), operation_(operation), id_(id) {}
+
+  const IoUringOperation& GetOperation() const noexcept { return operation_; }
+  IoUring::RequestId GetId() const noexcept { return id_; }
+
+  void DoPerformAndRelease() noexcept { impl_.Prepare(*this); }
+
+  void Complete(int result) noexcept {
+    result_ = result;
+    // *this may be destroyed right after the Send
+    completed_.Send();
+  }
+
+  std::optional<int> Wait(Deadline deadline) {
+    if (completed_.WaitUntil(deadline) == FutureStatus::kReady) {
+      return result_;
+    }
+
+    // The kernel may still access the operation buffers
+    impl_.Cancel(id_);
+    completed_.WaitNonCancellable();
+    if (result_ == -ECANCELED || result_ == -EINTR) return std::nullopt;
+    return result_;
+  }
+
+ private:
+  IoUring::Impl& impl_;
+  const IoUringOperation operation_;
+  const IoUring::RequestId id_;
+  int result_{0};
+  SingleUseEvent completed_;
+};
+
+namespace {
+
+class CancelPayload final : public SingleShotAsyncPayload<CancelPayload> {
+ public:
+  CancelPayload(IoUring::Impl& impl, IoUring::RequestId id) noexcept
+      : impl_(impl), id_(id) {}
+
+  void DoPerformAndRelease() noexcept {
+    utils::FastScopeGuard guard([this]() noexcept { delete this; });
+    impl_.PrepareCancel(id_);
+  }
+
+ private:
+  IoUring::Impl& impl_;
+  const IoUring::RequestId id_;
+};
+
+}  // namespace
+
+IoUring::Impl::~Impl() {
+  if (is_ring_initialized) io_uring_queue_exit(&ring);
+  if (event_fd != -1) ::close(event_fd);
+}
+
+io_uring_sqe& IoUring::Impl::GetSqe() noexcept {
+  auto* sqe = io_uring_get_sqe(&ring);
+  if (!sqe) {
+    // Submission queue is full, flush it right away
+    Submit();
+    sqe = io_uring_get_sqe(&ring);
+  }
+  UINVARIANT(sqe, "Failed to get an io_uring submission queue entry");
+  ++prepared_entries;
+  return *sqe;
+}
+
+void IoUring::Impl::Prepare(IoUringRequest& request) noexcept {
+  const auto& op = request.GetOperation();
+  auto& sqe = GetSqe();
+  // NOLINTBEGIN(cppcoreguidelines-pro-type-const-cast)
+  auto* buf = const_cast<void*>(op.buf);
+  switch (op.opcode) {
+    case IoUringOpcode::kRecv:
+      io_uring_prep_recv(&sqe, op.fd, buf, op.len, 0);
+      break;
+    case IoUringOpcode::kSend:
+      io_uring_prep_send(&sqe, op.fd, buf, op.len, MSG_NOSIGNAL);
+      break;
+    case IoUringOpcode::kWritev:
+      io_uring_prep_writev(&sqe, op.fd, static_cast<const iovec*>(op.buf),
+                           op.len, 0);
+      break;
+    case IoUringOpcode::kAccept:
+      io_uring_prep_accept(&sqe, op.fd, op.addr, op.addrlen,
+                           SOCK_NONBLOCK | SOCK_CLOEXEC);
+      break;
+    case IoUringOpcode::kRead:
+      io_uring_prep_read(&sqe, op.fd, buf, op.len, op.offset);
+      break;
+    case IoUringOpcode::kWrite:
+      io_uring_prep_write(&sqe, op.fd, op.buf, op.len, op.offset);
+      break;
+    case IoUringOpcode::kOpenAt:
+      io_uring_prep_openat(&sqe, AT_FDCWD, static_cast<const char*>(op.buf),
+                           op.flags, op.mode);
+      break;
+  }
+  // NOLINTEND(cppcoreguidelines-pro-type-const-cast)
+  sqe.user_data = request.GetId();
+  in_flight.emplace(request.GetId(), &request);
+}
+
+void IoUring::Impl::PrepareCancel(RequestId id) noexcept {
+  // Ids are never reused, so the request has already completed if it is not
+  // found
+  if (in_flight.find(id) == in_flight.end()) return;
+
+  auto& sqe = GetSqe();
+  // NOLINTNEXTLINE(performance-no-int-to-ptr)
+  io_uring_prep_cancel(&sqe, reinterpret_cast<void*>(id), 0);
+  sqe.user_data = kUntrackedRequestId;
+}
+
+void IoUring::Impl::Cancel(RequestId id) {
+  if (id == kUntrackedRequestId || is_stopping) return;
+  thread.RunInEvLoopAsync(*new CancelPayload(*this, id));
+}
+
+void IoUring::Impl::Submit() noexcept {
+  if (!prepared_entries) return;
+
+  const auto submitted = io_uring_submit(&ring);
+  if (submitted < 0) {
+    // The entries stay in the submission queue and are retried on the next
+    // ev-loop iteration
+    LOG_LIMITED_ERROR() << "io_uring_submit failed: "
+                        << std::system_category().message(-submitted);
+    return;
+  }
+  prepared_entries = 0;
+}
+
+void IoUring::Impl::ReapCompletions() noexcept {
+  eventfd_t value{};
+  [[maybe_unused]] const auto res = ::eventfd_read(event_fd, &value);
+
+  unsigned head{};
+  unsigned count = 0;
+  io_uring_cqe* cqe = nullptr;
+  io_uring_for_each_cqe(&ring, head, cqe) {
+    ++count;
+    // Timeouts are submitted by io_uring_wait_cqe_timeout on old kernels
+    if (cqe->user_data == kUntrackedRequestId ||
+        cqe->user_data == LIBURING_UDATA_TIMEOUT) {
+      continue;
+    }
+
+    const auto it = in_flight.find(cqe->user_data);
+    UASSERT(it != in_flight.end());
+    if (it == in_flight.end()) continue;
+
+    auto* request = it->second;
+    in_flight.erase(it);
+    request->Complete(cqe->res);
+  }
+  io_uring_cq_advance(&ring, count);
+}
+
+void IoUring::Impl::DrainInFlight() noexcept {
+  // The tasks wait for the completion of their requests non-cancellably, so
+  // all the in-flight requests are cancelled and their completions are reaped
+  // before the ev thread exits. The kernel may still access the buffers of a
+  // request until its completion, so it is never completed here on its own.
+  is_stopping = true;
+  for (const auto& [id, request] : in_flight) PrepareCancel(id);
+  Submit();
+
+  while (!in_flight.empty()) {
+    io_uring_cqe* cqe = nullptr;
+    __kernel_timespec timeout{};
+    timeout.tv_sec = kDrainWarningPeriod.count();
+    const auto wait_result = io_uring_wait_cqe_timeout(&ring, &cqe, &timeout);
+    if (wait_result == -ETIME) {
+      LOG_WARNING() << "Waiting for " << in_flight.size()
+                    << " cancelled io_uring requests to complete";
+      // Entries that failed to submit are retried
+      Submit();
+      continue;
+    }
+    if (wait_result < 0 && wait_result != -EINTR) {
+      LOG_ERROR() << "io_uring_wait_cqe_timeout failed: "
+                  << std::system_category().message(-wait_result);
+      Submit();
+      continue;
+    }
+    ReapCompletions();
+  }
+}
+
+void IoUring::Impl::OnCompletion(struct ev_loop*, ev_io* watcher,
+                                 int) noexcept {
+  auto* self = static_cast<Impl*>(watcher->data);
+  UASSERT(self);
+  self->ReapCompletions();
+}
+
+std::unique_ptr<IoUring> IoUring::TryCreate(Thread& thread) {
+  auto impl = std::make_unique<Impl>(thread);
+
+  const auto init_result =
+      io_uring_queue_init(kQueueEntries, &impl->ring, /*flags=*/0);
+  if (init_result < 0) {
+    LOG_WARNING() << "io_uring is not available ("
+                  << std::system_category().message(-init_result)
+                  << "), falling back to readiness notifications";
+    return {};
+  }
+  impl->is_ring_initialized = true;
+
+  impl->event_fd = ::eventfd(0, EFD_NONBLOCK | EFD_CLOEXEC);
+  if (impl->event_fd == -1) {
+    LOG_WARNING() << "Failed to create eventfd for io_uring ("
+                  << std::system_category().message(errno)
+                  << "), falling back to readiness notifications";
+    return {};
+  }
+
+  const auto register_result =
+      io_uring_register_eventfd(&impl->ring, impl->event_fd);
+  if (register_result < 0) {
+    LOG_WARNING() << "Failed to register eventfd in io_uring ("
+                  << std::system_category().message(-register_result)
+                  << "), falling back to readiness notifications";
+    return {};
+  }
+
+  // NOLINTNEXTLINE(cppcoreguidelines-pro-type-cstyle-cast)
+  ev_io_init(&impl->completion_watcher, &Impl::OnCompletion, impl->event_fd,
+             EV_READ);
+  impl->completion_watcher.data = impl.get();
+  ev_io_start(thread.GetEvLoop(), &impl->completion_watcher);
+
+  return std::unique_ptr<IoUring>(new IoUring(std::move(impl)));
+}
+
+IoUring::IoUring(std::unique_ptr<Impl>&& impl) : impl_(std::move(impl)) {}
+
+IoUring::~IoUring() = default;
+
+std::optional<int> IoUring::Perform(IoUringOperation operation,
+                                    Deadline deadline,
+                                    std::atomic<RequestId>* in_flight_id) {
+  IoUringRequest request{*impl_, operation, impl_->next_request_id++};
+  if (in_flight_id) in_flight_id->store(request.GetId());
+  const utils::FastScopeGuard reset_in_flight_id([in_flight_id]() noexcept {
+    if (in_flight_id) in_flight_id->store(kUntrackedRequestId);
+  });
+
+  impl_->thread.RunInEvLoopAsync(request);
+  return request.Wait(deadline);
+}
+
+void IoUring::Cancel(RequestId id) { impl_->Cancel(id); }
+
+void IoUring::Submit() noexcept { impl_->Submit(); }
+
+void IoUring::Stop() noexcept {
+  ev_io_stop(impl_->thread.GetEvLoop(), &impl_->completion_watcher);
+  impl_->DrainInFlight();
+}
+
+#else
+
+struct IoUring::Impl final {};
+
+std::unique_ptr<IoUring> IoUring::TryCreate(Thread&) {
+  LOG_WARNING() << "userver is built without io_uring support, falling back "
+                   "to readiness notifications";
+  return {};
+}
+
+IoUring::IoUring(std::unique_ptr<Impl>&& impl) : impl_(std::move(impl)) {}
+
+IoUring::~IoUring() = default;
+
+std::optional<int> IoUring::Perform(IoUringOperation, Deadline,
+                                    std::atomic<RequestId>*) {
+  UINVARIANT(false, "io_uring is not supported");
+}
+
+void IoUring::Cancel(RequestId) {}
+
+void IoUring::Submit() noexcept {}
+
+void IoUring::Stop() noexcept {}
+
+#endif
+
+}  // namespace engine::ev
+
+USERVER_NAMESPACE_END
@@ -0,0 +1,103 @@
+#pragma once
+
+#include <sys/socket.h>
+#include <sys/types.h>
+
+#include <atomic>
+#include <cstdint>
+#include <memory>
+#include <optional>
+
+#include <userver/engine/deadline.hpp>
+
+USERVER_NAMESPACE_BEGIN
+
+namespace engine::ev {
+
+class Thread;
+
+enum class IoUringOpcode {
+  kRecv,
+  kSend,
+  kWritev,
+  kAccept,
+  kRead,
+  kWrite,
+  kOpenAt,
+};
+
+struct IoUringOperation final {
+  IoUringOpcode opcode{IoUringOpcode::kRecv};
+  int fd{-1};
+
+  // Data buffer, `struct iovec` array for kWritev, path for kOpenAt
+  const void* buf{nullptr};
+  // Buffer size, `struct iovec` count for kWritev
+  std::size_t len{0};
+  // File offset for kRead and kWrite, -1 for the current file position
+  std::int64_t offset{-1};
+
+  // Peer address storage for kAccept
+  struct sockaddr* addr{nullptr};
+  socklen_t* addrlen{nullptr};
+
+  // File flags and mode for kOpenAt
+  int flags{0};
+  mode_t mode{0};
+};
+
+/// An io_uring instance of an ev thread.
+///
+/// Submission queue entries are prepared on the ev thread only and all the
+/// entries prepared during a single ev-loop iteration are flushed with a
+/// single io_uring_submit call. Completions are reaped on the ev thread via
+/// an eventfd registered in the ring.
+class IoUring final {
+ public:
+  using RequestId = std::uint64_t;
+
+  /// Returns nullptr if io_uring is not available: either userver was built
+  /// without USERVER_FEATURE_IO_URING or the kernel does not support it.
+  /// Must be called before the ev thread is started.
+  static std::unique_ptr<IoUring> TryCreate(Thread& thread);
+
+  ~IoUring();
+
+  /// @brief Performs the operation on the ev thread and waits for its
+  /// completion.
+  ///
+  /// On deadline or task cancellation the operation is cancelled in the kernel
+  /// and then waited for non-cancellably, as the kernel may still access its
+  /// buffers.
+  ///
+  /// @param in_flight_id if set, holds the id of the in-flight request to be
+  /// passed to Cancel
+  /// @returns result of the operation (transferred bytes or new fd, -errno
+  /// on failure), std::nullopt if the operation was interrupted
+  std::optional<int> Perform(IoUringOperation operation, Deadline deadline,
+                             std::atomic<RequestId>* in_flight_id = nullptr);
+
+  /// Cancels the request if it is still in flight, may be called from any
+  /// thread
+  void Cancel(RequestId id);
+
+  /// Flushes the prepared submission queue entries, must be called on the ev
+  /// thread
+  void Submit() noexcept;
+
+  /// Cancels the in-flight requests and waits for their completion, then
+  /// stops reaping completions. Must be called on the ev thread after the
+  /// ev-loop is stopped.
+  void Stop() noexcept;
+
+  struct Impl;
+
+ private:
+  explicit IoUring(std::unique_ptr<Impl>&& impl);
+
+  std::unique_ptr<Impl> impl_;
+};
+
+}  // namespace engine::ev
+
+USERVER_NAMESPACE_END
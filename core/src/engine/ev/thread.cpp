@@ -36,19 +36,20 @@ constexpr std::size_t kCpuStatsThrottle{16};
 }  // namespace
 
 Thread::Thread(const std::string& thread_name,
-               RegisterEventMode register_event_mode)
-    : Thread(thread_name, EventLoop::EvLoopType::kNewLoop,
-             register_event_mode) {}
+               RegisterEventMode register_event_mode, IoBackend io_backend)
+    : Thread(thread_name, EventLoop::EvLoopType::kNewLoop, register_event_mode,
+             io_backend) {}
 
 Thread::Thread(const std::string& thread_name, UseDefaultEvLoop,
-               RegisterEventMode register_event_mode)
+               RegisterEventMode register_event_mode, IoBackend io_backend)
     : Thread(thread_name, EventLoop::EvLoopType::kDefaultLoop,
-             register_event_mode) {}
+             register_event_mode, io_backend) {}
 
 Thread::Thread(const std::string& thread_name,
                EventLoop::EvLoopType ev_loop_type,
-               RegisterEventMode register_event_mode)
+               RegisterEventMode register_event_mode, IoBackend io_backend)
     : register_event_mode_(register_event_mode),
+      io_backend_(io_backend),
       event_loop_(ev_loop_type),
       lock_(loop_mutex_, std::defer_lock),
       name_{thread_name},
@@ -143,6 +144,11 @@ void Thread::Start() {
     ev_timer_start(loop, &stats_timer_);
   }
 
+  if (io_backend_ == IoBackend::kIoUring) {
+    // Starts the completion watcher, so must be created before the thread
+    io_uring_ = IoUring::TryCreate(*this);
+  }
+
   is_running_ = true;
   thread_ = std::thread([this] {
     utils::SetCurrentThreadName(name_);
@@ -164,12 +170,16 @@ void Thread::RunEvLoop() {
     AcquireImpl();
     event_loop_.RunOnce();
     UpdateLoopWatcherImpl();
+    // All the io_uring operations prepared during the iteration are submitted
+    // with a single syscall
+    if (io_uring_) io_uring_->Submit();
     cpu_stats_storage_.Collect();
     ReleaseImpl();
   }
 
   ev_async_stop(GetEvLoop(), &watch_update_);
   ev_async_stop(GetEvLoop(), &watch_break_);
+  if (io_uring_) io_uring_->Stop();
   if (register_event_mode_ == RegisterEventMode::kDeferred) {
     ev_timer_stop(GetEvLoop(), &timers_driver_);
   } else {
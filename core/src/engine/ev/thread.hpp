@@ -13,6 +13,7 @@
 #include <concurrent/impl/intrusive_mpsc_queue.hpp>
 #include <engine/ev/async_payload_base.hpp>
 #include <engine/ev/event_loop.hpp>
+#include <engine/ev/io_uring.hpp>
 #include <utils/statistics/thread_statistics.hpp>
 
 USERVER_NAMESPACE_BEGIN
@@ -35,8 +36,19 @@ class Thread final {
     kDeferred
   };
 
-  Thread(const std::string& thread_name, RegisterEventMode);
-  Thread(const std::string& thread_name, UseDefaultEvLoop, RegisterEventMode);
+  enum class IoBackend {
+    // Sockets wait for readiness notifications of the ev-loop and then perform
+    // the syscalls themselves.
+    kEvLoop,
+    // Operations that would block are completed by an io_uring instance of
+    // the ev thread. Falls back to kEvLoop if io_uring is not available.
+    kIoUring,
+  };
+
+  Thread(const std::string& thread_name, RegisterEventMode,
+         IoBackend io_backend = IoBackend::kEvLoop);
+  Thread(const std::string& thread_name, UseDefaultEvLoop, RegisterEventMode,
+         IoBackend io_backend = IoBackend::kEvLoop);
 
   ~Thread();
 
@@ -57,9 +69,12 @@ class Thread final {
   std::uint8_t GetCurrentLoadPercent() const;
   const std::string& GetName() const;
 
+  // nullptr if the thread does not use io_uring
+  IoUring* GetIoUring() const noexcept { return io_uring_.get(); }
+
  private:
   Thread(const std::string& thread_name, EventLoop::EvLoopType ev_loop_type,
-         RegisterEventMode register_event_mode);
+         RegisterEventMode register_event_mode, IoBackend io_backend);
 
   void RegisterInEvLoop(AsyncPayloadBase& payload);
 
@@ -82,8 +97,10 @@ class Thread final {
   concurrent::impl::IntrusiveMpscQueue<AsyncPayloadBase> func_queue_{};
 
   RegisterEventMode register_event_mode_;
+  IoBackend io_backend_;
 
   EventLoop event_loop_;
+  std::unique_ptr<IoUring> io_uring_;
 
   std::thread thread_{};
   std::mutex loop_mutex_{};
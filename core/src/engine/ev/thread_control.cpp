@@ -28,6 +28,10 @@ bool ThreadControlBase::IsInEvThread() const noexcept {
   return thread_.IsInEvThread();
 }
 
+IoUring* ThreadControlBase::GetIoUring() const noexcept {
+  return thread_.GetIoUring();
+}
+
 // NOLINTNEXTLINE(readability-make-member-function-const)
 void ThreadControlBase::DoStart(ev_timer& w) noexcept {
   UASSERT(IsInEvThread());
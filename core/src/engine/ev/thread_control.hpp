@@ -9,6 +9,7 @@
 #include <ev.h>
 
 #include <engine/ev/async_payload_base.hpp>
+#include <engine/ev/io_uring.hpp>
 #include <userver/engine/deadline.hpp>
 #include <userver/engine/single_use_event.hpp>
 #include <userver/engine/task/cancel.hpp>
@@ -133,6 +134,9 @@ class ThreadControlBase {
 
   bool IsInEvThread() const noexcept;
 
+  /// nullptr if the thread does not use io_uring
+  IoUring* GetIoUring() const noexcept;
+
  protected:
   explicit ThreadControlBase(Thread& thread) noexcept;
 
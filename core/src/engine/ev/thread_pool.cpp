@@ -18,6 +18,11 @@ Thread::RegisterEventMode GetRegisterEventMode(bool defer_timers) {
                       : Thread::RegisterEventMode::kImmediate;
 }
 
+Thread::IoBackend GetIoBackend(bool use_io_uring) {
+  return use_io_uring ? Thread::IoBackend::kIoUring
+                      : Thread::IoBackend::kEvLoop;
+}
+
 }  // namespace
 
 ThreadPool::ThreadPool(ThreadPoolConfig config)
@@ -30,6 +35,7 @@ ThreadPool::ThreadPool(ThreadPoolConfig config, bool use_ev_default_loop)
     : use_ev_default_loop_(use_ev_default_loop) {
   const auto register_timer_event_mode =
       GetRegisterEventMode(config.defer_events);
+  const auto io_backend = GetIoBackend(config.use_io_uring);
 
   {
     default_threads_.threads =
@@ -38,8 +44,9 @@ ThreadPool::ThreadPool(ThreadPoolConfig config, bool use_ev_default_loop)
               fmt::format("{}_{}", config.thread_name, index);
           return (use_ev_default_loop && index == 0)
                      ? Thread(thread_name, Thread::kUseDefaultEvLoop,
-                              register_timer_event_mode)
-                     : Thread(thread_name, register_timer_event_mode);
+                              register_timer_event_mode, io_backend)
+                     : Thread(thread_name, register_timer_event_mode,
+                              io_backend);
         });
 
     default_threads_.thread_controls = utils::GenerateFixedArray(
@@ -13,6 +13,7 @@ ThreadPoolConfig Parse(const yaml_config::YamlConfig& value,
           config.dedicated_timer_threads);
   config.thread_name = value["thread_name"].As<std::string>(config.thread_name);
   config.defer_events = value["defer_events"].As<bool>(config.defer_events);
+  config.use_io_uring = value["use_io_uring"].As<bool>(config.use_io_uring);
   return config;
 }
 
@@ -25,6 +25,7 @@ std::shared_ptr<TaskProcessorPools> MakeTaskProcessorPools(
   ev_config.thread_name = pools_config.ev_thread_name;
   ev_config.ev_default_loop_disabled = pools_config.ev_default_loop_disabled;
   ev_config.defer_events = pools_config.defer_events;
+  ev_config.use_io_uring = pools_config.use_io_uring;
 
   return std::make_shared<TaskProcessorPools>(std::move(coro_config),
                                               std::move(ev_config));
@@ -32,10 +33,14 @@ std::shared_ptr<TaskProcessorPools> MakeTaskProcessorPools(
 
 TaskProcessorHolder TaskProcessorHolder::Make(
     std::size_t threads_num, std::string thread_name,
-    std::shared_ptr<TaskProcessorPools> pools) {
+    std::shared_ptr<TaskProcessorPools> pools,
+    const TaskProcessorPoolsConfig& pools_config) {
   TaskProcessorConfig config;
   config.worker_threads = threads_num;
   config.thread_name = std::move(thread_name);
+  config.task_processor_queue = pools_config.task_queue_type;
+  config.spinning_policy = pools_config.spinning_policy;
+  config.hot_workers = pools_config.hot_workers;
 
   return TaskProcessorHolder(
       std::make_unique<TaskProcessor>(std::move(config), std::move(pools)));
@@ -29,9 +29,10 @@ std::shared_ptr<TaskProcessorPools> MakeTaskProcessorPools(
 
 class TaskProcessorHolder final {
  public:
-  static TaskProcessorHolder Make(std::size_t threads_num,
-                                  std::string thread_name,
-                                  std::shared_ptr<TaskProcessorPools> pools);
+  static TaskProcessorHolder Make(
+      std::size_t threads_num, std::string thread_name,
+      std::shared_ptr<TaskProcessorPools> pools,
+      const TaskProcessorPoolsConfig& pools_config = {});
 
   explicit TaskProcessorHolder(std::unique_ptr<TaskProcessor>&&);
 
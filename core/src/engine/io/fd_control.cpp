@@ -11,6 +11,7 @@
 #include <userver/logging/log.hpp>
 #include <userver/utils/assert.hpp>
 
+#include <engine/ev/thread_control.hpp>
 #include <engine/task/task_context.hpp>
 #include <utils/check_syscall.hpp>
 
@@ -65,7 +66,9 @@ Direction::SingleUserGuard::~SingleUserGuard() {
 }
 #endif  // #ifndef NDEBUG
 
-Direction::Direction(Kind kind) : kind_(kind) {}
+Direction::Direction(Kind kind)
+    : kind_(kind),
+      io_uring_(current_task::GetEventThread().GetIoUring()) {}
 
 Direction::~Direction() = default;
 
@@ -81,7 +84,22 @@ engine::impl::ContextAccessor* Direction::TryGetContextAccessor() noexcept {
 
 void Direction::Reset(int fd) { poller_.Reset(fd, kind_); }
 
-void Direction::Invalidate() { poller_.Invalidate(); }
+void Direction::Invalidate() {
+  poller_.Invalidate();
+  if (io_uring_) {
+    // The in-flight request holds a reference to the file and would not be
+    // interrupted by close()
+    io_uring_->Cancel(io_uring_request_id_.load());
+  }
+}
+
+bool Direction::IsWouldBlock(int error_code) noexcept {
+  return error_code == EWOULDBLOCK
+#if EWOULDBLOCK != EAGAIN
+         || error_code == EAGAIN
+#endif
+      ;
+}
 
 FdControl::FdControl()
     : read_(Direction::Kind::kRead), write_(Direction::Kind::kWrite) {}
@@ -3,6 +3,7 @@
 #include <sys/uio.h>
 #include <atomic>
 #include <cerrno>
+#include <type_traits>
 
 #include <userver/engine/io/exception.hpp>
 #include <userver/engine/io/fd_control_holder.hpp>
@@ -12,6 +13,7 @@
 #include <userver/logging/log.hpp>
 #include <userver/utils/assert.hpp>
 
+#include <engine/ev/io_uring.hpp>
 #include <engine/task/task_context.hpp>
 #include <userver/engine/impl/wait_list_fwd.hpp>
 
@@ -41,6 +43,15 @@ enum class ErrorMode {
   kFatal,      ///< break execute operation
 };
 
+/// IoFunc wrappers that may be completed via io_uring declare the matching
+/// operation as `static constexpr ev::IoUringOpcode kIoUringOpcode`
+template <typename IoFunc, typename = void>
+inline constexpr bool kHasIoUringOpcode = false;
+
+template <typename IoFunc>
+inline constexpr bool kHasIoUringOpcode<
+    IoFunc, std::void_t<decltype(IoFunc::kIoUringOpcode)>> = true;
+
 class FdControl;
 
 class Direction final {
@@ -90,6 +101,16 @@ class Direction final {
 
   engine::impl::ContextAccessor* TryGetContextAccessor() noexcept;
 
+  bool HasIoUring() const noexcept { return io_uring_ != nullptr; }
+
+  // Completes the operation that would block via io_uring instead of waiting
+  // for readiness and repeating the syscall. Returns the syscall-like result,
+  // with errno set on failure.
+  template <typename... Context>
+  ssize_t PerformIoUring(ev::IoUringOperation operation,
+                         size_t processed_bytes, Deadline deadline,
+                         const Context&... context);
+
  private:
   friend class FdControl;
   explicit Direction(Kind kind);
@@ -105,8 +126,12 @@ class Direction final {
                            TransferMode mode, Deadline deadline,
                            Context&... context);
 
+  static bool IsWouldBlock(int error_code) noexcept;
+
   FdPoller poller_;
   Kind kind_;
+  ev::IoUring* io_uring_;
+  std::atomic<ev::IoUring::RequestId> io_uring_request_id_{0};
 };
 
 class FdControl final {
@@ -189,6 +214,38 @@ ErrorMode Direction::TryHandleError(int error_code, size_t processed_bytes,
   return ErrorMode::kProcessed;
 }
 
+template <typename... Context>
+ssize_t Direction::PerformIoUring(ev::IoUringOperation operation,
+                                  size_t processed_bytes, Deadline deadline,
+                                  const Context&... context) {
+  UASSERT(io_uring_);
+  if (current_task::ShouldCancel()) {
+    throw(IoCancelled(/*bytes_transferred =*/processed_bytes)
+          << ... << context);
+  }
+
+  operation.fd = Fd();
+  const auto result =
+      io_uring_->Perform(operation, deadline, &io_uring_request_id_);
+  if (!IsValid()) {
+    throw((IoException() << "Fd closed during ") << ... << context);
+  }
+  if (!result) {
+    if (current_task::ShouldCancel()) {
+      throw(IoCancelled(/*bytes_transferred =*/processed_bytes)
+            << ... << context);
+    } else {
+      throw(IoTimeout(/*bytes_transferred =*/processed_bytes)
+            << ... << context);
+    }
+  }
+  if (*result < 0) {
+    errno = -*result;
+    return -1;
+  }
+  return *result;
+}
+
 template <typename IoFunc, typename... Context>
 size_t Direction::PerformIoV(SingleUserGuard&, IoFunc&& io_func,
                              struct iovec* list, std::size_t list_size,
@@ -200,6 +257,19 @@ size_t Direction::PerformIoV(SingleUserGuard&, IoFunc&& io_func,
   do {
     auto chunk_size = io_func(Fd(), list, list_size);
 
+    if constexpr (kHasIoUringOpcode<std::decay_t<IoFunc>>) {
+      if (chunk_size < 0 && io_uring_ && IsWouldBlock(errno)) {
+        if (processed_bytes != 0 && mode != TransferMode::kWhole) break;
+
+        ev::IoUringOperation operation;
+        operation.opcode = std::decay_t<IoFunc>::kIoUringOpcode;
+        operation.buf = list;
+        operation.len = list_size;
+        chunk_size =
+            PerformIoUring(operation, processed_bytes, deadline, context...);
+      }
+    }
+
     if (chunk_size > 0) {
       processed_bytes += chunk_size;
       if (mode == TransferMode::kOnce) {
@@ -240,6 +310,19 @@ size_t Direction::PerformIo(SingleUserGuard&, IoFunc&& io_func, void* buf,
   while (pos < end) {
     auto chunk_size = io_func(Fd(), pos, end - pos);
 
+    if constexpr (kHasIoUringOpcode<std::decay_t<IoFunc>>) {
+      if (chunk_size < 0 && io_uring_ && IsWouldBlock(errno)) {
+        if (pos != begin && mode != TransferMode::kWhole) break;
+
+        ev::IoUringOperation operation;
+        operation.opcode = std::decay_t<IoFunc>::kIoUringOpcode;
+        operation.buf = pos;
+        operation.len = end - pos;
+        chunk_size =
+            PerformIoUring(operation, pos - begin, deadline, context...);
+      }
+    }
+
     if (chunk_size > 0) {
       pos += chunk_size;
       if (mode == TransferMode::kOnce) {
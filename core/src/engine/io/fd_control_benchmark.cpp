@@ -1,7 +1,11 @@
 #include <benchmark/benchmark.h>
 
+#include <sys/socket.h>
 #include <unistd.h>
 
+#include <array>
+
+#include <userver/engine/async.hpp>
 #include <userver/engine/run_standalone.hpp>
 #include <utils/check_syscall.hpp>
 
@@ -29,6 +33,32 @@ class Pipe final {
 namespace io = engine::io;
 using Deadline = engine::Deadline;
 using FdControl = io::impl::FdControl;
+using Direction = io::impl::Direction;
+
+constexpr std::size_t kPingPongMessageSize = 64;
+
+struct RecvFunc final {
+  static constexpr auto kIoUringOpcode = engine::ev::IoUringOpcode::kRecv;
+
+  ssize_t operator()(int fd, void* buf, size_t len) const {
+    return ::recv(fd, buf, len, 0);
+  }
+};
+
+struct SendFunc final {
+  static constexpr auto kIoUringOpcode = engine::ev::IoUringOpcode::kSend;
+
+  ssize_t operator()(int fd, const void* buf, size_t len) const {
+    return ::send(fd, buf, len, MSG_NOSIGNAL);
+  }
+};
+
+template <typename IoFunc>
+std::size_t Transfer(Direction& dir, IoFunc io_func, void* buf, size_t len) {
+  Direction::SingleUserGuard guard(dir);
+  return dir.PerformIo(guard, io_func, buf, len, io::impl::TransferMode::kWhole,
+                       Deadline{}, "ping-pong");
+}
 
 }  // namespace
 
@@ -94,4 +124,36 @@ void fd_control_construct_wait_destroy(benchmark::State& state) {
 }
 BENCHMARK(fd_control_construct_wait_destroy);
 
+// Arg: whether the ev threads use io_uring
+void fd_control_ping_pong(benchmark::State& state) {
+  engine::TaskProcessorPoolsConfig config;
+  config.use_io_uring = state.range(0) != 0;
+  engine::RunStandalone(2, config, [&] {
+    int fds[2]{};
+    utils::CheckSyscall(::socketpair(AF_UNIX, SOCK_STREAM, 0, fds),
+                        "creating socket pair");
+    auto client = FdControl::Adopt(fds[0]);
+    auto server = FdControl::Adopt(fds[1]);
+
+    auto task_echo = engine::AsyncNoSpan([&server] {
+      std::array<char, kPingPongMessageSize> buf{};
+      while (Transfer(server->Read(), RecvFunc{}, buf.data(), buf.size()) ==
+             buf.size()) {
+        Transfer(server->Write(), SendFunc{}, buf.data(), buf.size());
+      }
+    });
+
+    std::array<char, kPingPongMessageSize> buf{};
+    for ([[maybe_unused]] auto _ : state) {
+      Transfer(client->Write(), SendFunc{}, buf.data(), buf.size());
+      const auto recv_bytes =
+          Transfer(client->Read(), RecvFunc{}, buf.data(), buf.size());
+      benchmark::DoNotOptimize(recv_bytes);
+    }
+    client->Close();
+    task_echo.Get();
+  });
+}
+BENCHMARK(fd_control_ping_pong)->Arg(0)->Arg(1);
+
 USERVER_NAMESPACE_END
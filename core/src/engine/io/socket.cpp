@@ -56,18 +56,35 @@ Sockaddr& MemoizeAddr(Sockaddr& addr, decltype(&::getpeername) getter,
 
 // IoFunc wrappers for Direction::PerformIo
 
-[[nodiscard]] ssize_t RecvWrapper(int fd, void* buf, size_t len) {
-  return ::recv(fd, buf, len, 0);
-}
+struct RecvWrapper final {
+  static constexpr auto kIoUringOpcode = ev::IoUringOpcode::kRecv;
+
+  [[nodiscard]] ssize_t operator()(int fd, void* buf, size_t len) const {
+    return ::recv(fd, buf, len, 0);
+  }
+};
 
-[[nodiscard]] ssize_t SendWrapper(int fd, const void* buf, size_t len) {
-  return ::send(fd, buf, len,
+struct SendWrapper final {
+  static constexpr auto kIoUringOpcode = ev::IoUringOpcode::kSend;
+
+  [[nodiscard]] ssize_t operator()(int fd, const void* buf, size_t len) const {
+    return ::send(fd, buf, len,
 // MAC_COMPAT: does not support MSG_NOSIGNAL
 #ifdef MSG_NOSIGNAL
-                MSG_NOSIGNAL |
+                  MSG_NOSIGNAL |
 #endif
-                    0);
-}
+                      0);
+  }
+};
+
+struct WritevWrapper final {
+  static constexpr auto kIoUringOpcode = ev::IoUringOpcode::kWritev;
+
+  [[nodiscard]] ssize_t operator()(int fd, const struct iovec* list,
+                                   std::size_t list_size) const {
+    return ::writev(fd, list, list_size);
+  }
+};
 
 class RecvFromWrapper {
  public:
@@ -226,8 +243,9 @@ size_t Socket::RecvSome(void* buf, size_t len, Deadline deadline) {
   auto& dir = fd_control_->Read();
   dir.ResetReady();
   impl::Direction::SingleUserGuard guard(dir);
-  return dir.PerformIo(guard, &RecvWrapper, buf, len, impl::TransferMode::kOnce,
-                       deadline, "RecvSome from ", peername_);
+  return dir.PerformIo(guard, RecvWrapper{}, buf, len,
+                       impl::TransferMode::kOnce, deadline, "RecvSome from ",
+                       peername_);
 }
 
 size_t Socket::RecvAll(void* buf, size_t len, Deadline deadline) {
@@ -237,7 +255,7 @@ size_t Socket::RecvAll(void* buf, size_t len, Deadline deadline) {
   auto& dir = fd_control_->Read();
   dir.ResetReady();
   impl::Direction::SingleUserGuard guard(dir);
-  return dir.PerformIo(guard, &RecvWrapper, buf, len,
+  return dir.PerformIo(guard, RecvWrapper{}, buf, len,
                        impl::TransferMode::kWhole, deadline, "RecvAll from ",
                        peername_);
 }
@@ -273,9 +291,10 @@ size_t Socket::SendAll(const struct iovec* list, std::size_t list_size,
   dir.ResetReady();
   impl::Direction::SingleUserGuard guard(dir);
   // NOLINTNEXTLINE(cppcoreguidelines-pro-type-const-cast)
-  return dir.PerformIoV(guard, &writev, const_cast<struct iovec*>(list),
-                        list_size, impl::TransferMode::kWhole, deadline,
-                        "SendAll to ", peername_);
+  return dir.PerformIoV(guard, WritevWrapper{},
+                        const_cast<struct iovec*>(list), list_size,
+                        impl::TransferMode::kWhole, deadline, "SendAll to ",
+                        peername_);
 }
 
 size_t Socket::SendAll(const void* buf, size_t len, Deadline deadline) {
@@ -286,7 +305,7 @@ size_t Socket::SendAll(const void* buf, size_t len, Deadline deadline) {
   dir.ResetReady();
   impl::Direction::SingleUserGuard guard(dir);
   // NOLINTNEXTLINE(cppcoreguidelines-pro-type-const-cast)
-  return dir.PerformIo(guard, &SendWrapper, const_cast<void*>(buf), len,
+  return dir.PerformIo(guard, SendWrapper{}, const_cast<void*>(buf), len,
                        impl::TransferMode::kWhole, deadline, "SendAll to ",
                        peername_);
 }
@@ -349,6 +368,18 @@ Socket Socket::Accept(Deadline deadline) {
     int fd = ::accept(dir.Fd(), buf.Data(), &len);
 #endif
 
+    if (fd == -1 && (errno == EAGAIN || errno == EWOULDBLOCK) &&
+        dir.HasIoUring()) {
+      len = buf.Capacity();
+      ev::IoUringOperation operation;
+      operation.opcode = ev::IoUringOpcode::kAccept;
+      operation.addr = buf.Data();
+      operation.addrlen = &len;
+      fd = static_cast<int>(
+          dir.PerformIoUring(operation, /*processed_bytes=*/0, deadline,
+                             "Accept"));
+    }
+
     UASSERT(len <= buf.Capacity());
     if (fd != -1) {
       auto peersock = Socket(fd);
@@ -22,6 +22,7 @@ using Deadline = engine::Deadline;
 namespace {
 
 constexpr auto kDeadlineMaxTime = std::chrono::seconds{60};
+constexpr std::size_t kPingPongMessageSize = 64;
 
 }  // namespace
 
@@ -138,4 +139,60 @@ BENCHMARK(socket_send_all_v);
 // TODO(TAXICOMMON-5510) flaky, sometimes throws engine::io::IoTimeout
 // BENCHMARK(socket_send_all_range)->RangeMultiplier(10)->Range(10, 10000);
 
+// Arg: whether the ev threads use io_uring
+void socket_ping_pong(benchmark::State& state) {
+  engine::TaskProcessorPoolsConfig config;
+  config.use_io_uring = state.range(0) != 0;
+  engine::RunStandalone(2, config, [&]() {
+    const auto test_deadline = Deadline::FromDuration(kDeadlineMaxTime);
+    internal::net::TcpListener listener;
+    auto [server, client] = listener.MakeSocketPair(test_deadline);
+    auto task_echo = engine::AsyncNoSpan(
+        [test_deadline](auto&& server) {
+          std::array<char, kPingPongMessageSize> buf = {};
+          while (server.RecvAll(buf.data(), buf.size(), test_deadline) ==
+                 buf.size()) {
+            [[maybe_unused]] const auto send_bytes =
+                server.SendAll(buf.data(), buf.size(), test_deadline);
+          }
+        },
+        std::move(server));
+
+    std::array<char, kPingPongMessageSize> buf = {};
+    for ([[maybe_unused]] auto _ : state) {
+      [[maybe_unused]] const auto send_bytes =
+          client.SendAll(buf.data(), buf.size(), test_deadline);
+      const auto recv_bytes =
+          client.RecvAll(buf.data(), buf.size(), test_deadline);
+      benchmark::DoNotOptimize(recv_bytes);
+    }
+    client.Close();
+    task_echo.Get();
+  });
+}
+BENCHMARK(socket_ping_pong)->Arg(0)->Arg(1);
+
+// Arg: whether the ev threads use io_uring
+void socket_accept(benchmark::State& state) {
+  engine::TaskProcessorPoolsConfig config;
+  config.use_io_uring = state.range(0) != 0;
+  engine::RunStandalone(2, config, [&]() {
+    const auto test_deadline = Deadline::FromDuration(kDeadlineMaxTime);
+    internal::net::TcpListener listener;
+    const auto& addr = listener.addr;
+    for ([[maybe_unused]] auto _ : state) {
+      auto task_connect = engine::AsyncNoSpan([&addr, test_deadline] {
+        engine::io::Socket socket{addr.Domain(),
+                                  engine::io::SocketType::kStream};
+        socket.Connect(addr, test_deadline);
+        return socket;
+      });
+      auto accepted = listener.socket.Accept(test_deadline);
+      benchmark::DoNotOptimize(accepted.Fd());
+      [[maybe_unused]] auto connected = task_connect.Get();
+    }
+  });
+}
+BENCHMARK(socket_accept)->Arg(0)->Arg(1);
+
 USERVER_NAMESPACE_END
@@ -15,6 +15,7 @@
 #include <userver/engine/io/sockaddr.hpp>
 #include <userver/engine/io/socket.hpp>
 #include <userver/engine/mutex.hpp>
+#include <userver/engine/run_standalone.hpp>
 #include <userver/engine/single_consumer_event.hpp>
 #include <userver/engine/sleep.hpp>
 #include <userver/engine/wait_any.hpp>
@@ -29,6 +30,13 @@ using Deadline = engine::Deadline;
 using TcpListener = internal::net::TcpListener;
 using UdpListener = internal::net::UdpListener;
 
+// Falls back to readiness notifications if io_uring is not available
+engine::TaskProcessorPoolsConfig MakeIoUringConfig() {
+  engine::TaskProcessorPoolsConfig config;
+  config.use_io_uring = true;
+  return config;
+}
+
 }  // namespace
 
 UTEST(Socket, ConnectFail) {
@@ -492,4 +500,74 @@ UTEST(Socket, WriteALot) {
   }
 }
 
+TEST(SocketIoUring, PingPong) {
+  engine::RunStandalone(2, MakeIoUringConfig(), [] {
+    const auto test_deadline =
+        Deadline::FromDuration(utest::kMaxTestWaitTime);
+    TcpListener listener;
+
+    auto echo_task = engine::AsyncNoSpan([&] {
+      auto server = listener.socket.Accept(test_deadline);
+      std::array<char, 6> buf{};
+      while (server.RecvAll(buf.data(), buf.size(), test_deadline) ==
+             buf.size()) {
+        EXPECT_EQ(buf.size(),
+                  server.SendAll(buf.data(), buf.size(), test_deadline));
+      }
+    });
+
+    io::Socket client{listener.addr.Domain(), io::SocketType::kStream};
+    client.Connect(listener.addr, test_deadline);
+    for (int i = 0; i < 100; ++i) {
+      EXPECT_EQ(6, client.SendAll({{"ping", 4}, {"!!", 2}}, test_deadline));
+      std::array<char, 6> buf{};
+      EXPECT_EQ(buf.size(),
+                client.RecvAll(buf.data(), buf.size(), test_deadline));
+      EXPECT_EQ("ping!!", std::string_view(buf.data(), buf.size()));
+    }
+    client.Close();
+    echo_task.Get();
+  });
+}
+
+TEST(SocketIoUring, Timeout) {
+  engine::RunStandalone(1, MakeIoUringConfig(), [] {
+    const auto test_deadline =
+        Deadline::FromDuration(utest::kMaxTestWaitTime);
+    TcpListener listener;
+    auto [server, client] = listener.MakeSocketPair(test_deadline);
+
+    char c = 0;
+    const auto short_deadline =
+        Deadline::FromDuration(std::chrono::milliseconds(10));
+    UEXPECT_THROW([[maybe_unused]] auto received =
+                      client.RecvSome(&c, 1, short_deadline),
+                  io::IoTimeout);
+
+    // the socket is still usable after the interrupted operation
+    EXPECT_EQ(1, server.SendAll(&c, 1, test_deadline));
+    EXPECT_EQ(1, client.RecvSome(&c, 1, test_deadline));
+  });
+}
+
+TEST(SocketIoUring, Cancel) {
+  engine::RunStandalone(2, MakeIoUringConfig(), [] {
+    const auto test_deadline =
+        Deadline::FromDuration(utest::kMaxTestWaitTime);
+    TcpListener listener;
+    auto [server, client] = listener.MakeSocketPair(test_deadline);
+
+    engine::SingleConsumerEvent has_started_event;
+    auto recv_task = engine::AsyncNoSpan([&] {
+      has_started_event.Send();
+      char c = 0;
+      [[maybe_unused]] auto received = client.RecvSome(&c, 1, test_deadline);
+    });
+    ASSERT_TRUE(has_started_event.WaitForEvent());
+    engine::Yield();
+    recv_task.RequestCancel();
+    UEXPECT_THROW(recv_task.Get(), io::IoCancelled);
+  });
+}
+
 USERVER_NAMESPACE_END
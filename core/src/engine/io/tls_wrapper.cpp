@@ -263,6 +263,41 @@ void AddCertAuthorities(
   }
 }
 
+// Length-prefixed protocol names, see RFC 7301 section 3.1
+std::string MakeAlpnWireProtocols(const std::vector<std::string>& protocols) {
+  std::string result;
+  for (const auto& protocol : protocols) {
+    if (protocol.empty() || protocol.size() > 255) {
+      throw TlsException(
+          fmt::format("Invalid ALPN protocol name '{}'", protocol));
+    }
+    result.push_back(static_cast<char>(protocol.size()));
+    result.append(protocol);
+  }
+  return result;
+}
+
+int SelectAlpnProtocol(SSL*, const unsigned char** out, unsigned char* outlen,
+                       const unsigned char* in, unsigned int inlen,
+                       void* arg) noexcept {
+  const auto* server_protocols = static_cast<const std::string*>(arg);
+  UASSERT(server_protocols);
+
+  // Server preference order, as SSL_select_next_proto iterates over its
+  // first list
+  unsigned char* selected = nullptr;
+  if (OPENSSL_NPN_NEGOTIATED !=
+      SSL_select_next_proto(
+          &selected, outlen,
+          reinterpret_cast<const unsigned char*>(server_protocols->data()),
+          server_protocols->size(), in, inlen)) {
+    // Proceed without ALPN, e.g. for the clients not supporting HTTP/2
+    return SSL_TLSEXT_ERR_NOACK;
+  }
+  *out = selected;
+  return SSL_TLSEXT_ERR_OK;
+}
+
 }  // namespace
 
 class TlsWrapper::ReadContextAccessor final
@@ -527,9 +562,19 @@ TlsWrapper TlsWrapper::StartTlsClient(
 TlsWrapper TlsWrapper::StartTlsServer(
     Socket&& socket, const crypto::Certificate& cert,
     const crypto::PrivateKey& key, Deadline deadline,
-    const std::vector<crypto::Certificate>& extra_cert_authorities) {
+    const std::vector<crypto::Certificate>& extra_cert_authorities,
+    const std::vector<std::string>& alpn_protocols) {
   auto ssl_ctx = MakeSslCtx();
 
+  // Must outlive SSL_accept
+  const auto alpn_wire_protocols = MakeAlpnWireProtocols(alpn_protocols);
+  if (!alpn_wire_protocols.empty()) {
+    SSL_CTX_set_alpn_select_cb(
+        ssl_ctx.get(), &SelectAlpnProtocol,
+        // NOLINTNEXTLINE(cppcoreguidelines-pro-type-const-cast)
+        const_cast<std::string*>(&alpn_wire_protocols));
+  }
+
   if (!extra_cert_authorities.empty()) {
     AddCertAuthorities(ssl_ctx, extra_cert_authorities);
     SSL_CTX_set_verify(ssl_ctx.get(),
@@ -565,6 +610,11 @@ TlsWrapper TlsWrapper::StartTlsServer(
                     SSL_get_error(wrapper.impl_->ssl.get(), ret))));
   }
 
+  if (!alpn_wire_protocols.empty()) {
+    SSL_CTX_set_alpn_select_cb(SSL_get_SSL_CTX(wrapper.impl_->ssl.get()),
+                               nullptr, nullptr);
+  }
+
   UASSERT(wrapper.impl_->ssl);
   return wrapper;
 }
@@ -629,13 +679,20 @@ size_t TlsWrapper::SendAll(const void* buf, size_t len, Deadline deadline) {
 
 [[nodiscard]] size_t TlsWrapper::WriteAll(std::initializer_list<IoData> list,
                                           Deadline deadline) {
+  return WriteAll(list.begin(), list.size(), deadline);
+}
+
+[[nodiscard]] size_t TlsWrapper::WriteAll(const IoData* list,
+                                          std::size_t list_size,
+                                          Deadline deadline) {
+  const auto* const list_end = list + list_size;
   static constexpr std::size_t kBufSize = 4'096;
   std::byte buf[kBufSize];
 
   std::size_t sent_bytes = 0;
   std::size_t remaining_cap = kBufSize;
-  auto fits_in_buf_begin = list.begin();
-  for (auto it = fits_in_buf_begin; it != list.end(); ++it) {
+  auto fits_in_buf_begin = list;
+  for (auto it = fits_in_buf_begin; it != list_end; ++it) {
     if (it->len > remaining_cap) {
       if (it - fits_in_buf_begin >= 2) {
         for (auto* ins_pos = buf; fits_in_buf_begin != it;
@@ -665,7 +722,7 @@ size_t TlsWrapper::SendAll(const void* buf, size_t len, Deadline deadline) {
   }
 
   auto ins_pos = buf;
-  for (auto ins_it = fits_in_buf_begin; ins_it != list.end(); ++ins_it) {
+  for (auto ins_it = fits_in_buf_begin; ins_it != list_end; ++ins_it) {
     ins_pos = std::copy_n(static_cast<const std::byte*>(ins_it->data),
                           ins_it->len, ins_pos);
   }
@@ -713,6 +770,16 @@ Socket TlsWrapper::StopTls(Deadline deadline) {
 
 int TlsWrapper::GetRawFd() { return impl_->bio_data.socket.Fd(); }
 
+std::string_view TlsWrapper::GetAlpnProtocol() const {
+  if (!impl_->ssl) return {};
+
+  const unsigned char* protocol = nullptr;
+  unsigned int length = 0;
+  SSL_get0_alpn_selected(impl_->ssl.get(), &protocol, &length);
+  if (!protocol) return {};
+  return {reinterpret_cast<const char*>(protocol), length};
+}
+
 }  // namespace engine::io
 
 USERVER_NAMESPACE_END
@@ -0,0 +1,195 @@
+#include <engine/task/spinning_semaphore.hpp>
+
+#include <algorithm>
+
+#include <userver/utils/assert.hpp>
+#include <userver/utils/fast_scope_guard.hpp>
+
+USERVER_NAMESPACE_BEGIN
+
+namespace engine {
+
+namespace {
+
+// The adaptive spin limit stays within [spinning-iterations / kAdaptiveRange,
+// spinning-iterations * kAdaptiveRange]
+constexpr std::int64_t kAdaptiveRange = 16;
+
+// A worker that was woken up earlier than this after parking would have been
+// better off spinning, futex wake-up latency is of the same order
+constexpr auto kShortPark = std::chrono::microseconds{50};
+
+// Hot workers account the spin iterations in batches of this size
+constexpr std::uint64_t kHotSpinStatsBatch = 1024;
+
+// Sequentially consistent, see SpinningSemaphore::SpinHot()
+bool TryDecrement(std::atomic<std::int64_t>& count) noexcept {
+  auto old_count = count.load();
+  while (old_count > 0) {
+    if (count.compare_exchange_weak(old_count, old_count - 1)) return true;
+  }
+  return false;
+}
+
+void CpuPause() noexcept {
+#if defined(__x86_64__) || defined(__i386__)
+  __builtin_ia32_pause();
+#elif defined(__aarch64__)
+  asm volatile("yield");
+#else
+  std::atomic_signal_fence(std::memory_order_acquire);
+#endif
+}
+
+}  // namespace
+
+SpinningSemaphore::SpinningSemaphore(const TaskProcessorConfig& config)
+    : policy_(config.spinning_policy),
+      min_spins_(policy_ == SpinningPolicy::kAdaptive
+                     ? config.spinning_iterations / kAdaptiveRange
+                     : config.spinning_iterations),
+      max_spins_(policy_ == SpinningPolicy::kAdaptive
+                     ? std::int64_t{config.spinning_iterations} *
+                           kAdaptiveRange
+                     : config.spinning_iterations),
+      max_hot_workers_(std::min(config.hot_workers, config.worker_threads)),
+      spin_limit_(config.spinning_iterations) {
+  UINVARIANT(config.spinning_iterations >= 0,
+             "spinning-iterations must not be negative");
+}
+
+void SpinningSemaphore::Signal() noexcept {
+  // Parked workers have already decremented the count, so the signal would
+  // go to them. Hot workers get a separate counter to be woken up first.
+  if (max_hot_workers_ != 0 && hot_workers_->load() != 0) {
+    hot_handoff_->fetch_add(1);
+    // The last hot worker might have left after the check above, see
+    // SpinHot()
+    if (hot_workers_->load() != 0 || !TryDecrement(*hot_handoff_)) return;
+  }
+
+  SignalParked(1);
+}
+
+void SpinningSemaphore::Wait() noexcept {
+  if (TryWait()) return;
+
+  if (TryBecomeHot()) {
+    SpinHot();
+    return;
+  }
+
+  // Same as moodycamel::LightweightSemaphore::waitWithPartialSpinning, but
+  // with a variable spin limit
+  const auto spin_limit = spin_limit_->load(std::memory_order_relaxed);
+  for (std::int64_t i = 0; i < spin_limit; ++i) {
+    if (TryWait()) {
+      spin_iterations_.Add({static_cast<std::uint64_t>(i + 1)});
+      ++spin_wakeups_;
+      AdaptAfterSpin(i + 1);
+      return;
+    }
+    // Prevents the compiler from collapsing the loop
+    std::atomic_signal_fence(std::memory_order_acquire);
+  }
+  spin_iterations_.Add({static_cast<std::uint64_t>(spin_limit)});
+
+  if (count_.fetch_sub(1, std::memory_order_acquire) > 0) return;
+
+  ++parks_;
+  const auto park_start = policy_ == SpinningPolicy::kAdaptive
+                              ? std::chrono::steady_clock::now()
+                              : std::chrono::steady_clock::time_point{};
+  while (!sema_.wait()) {
+    // interrupted by a signal
+  }
+  if (policy_ == SpinningPolicy::kAdaptive) {
+    AdaptAfterPark(std::chrono::steady_clock::now() - park_start);
+  }
+}
+
+SpinningSemaphore::Stats SpinningSemaphore::GetStats() const noexcept {
+  Stats stats;
+  stats.spin_wakeups = spin_wakeups_.Load();
+  stats.spin_iterations = spin_iterations_.Load();
+  stats.parks = parks_.Load();
+  stats.spin_limit = spin_limit_->load(std::memory_order_relaxed);
+  stats.hot_workers = hot_workers_->load(std::memory_order_relaxed);
+  return stats;
+}
+
+bool SpinningSemaphore::TryWait() noexcept {
+  if (max_hot_workers_ != 0 && TryDecrement(*hot_handoff_)) return true;
+  return TryDecrement(count_);
+}
+
+void SpinningSemaphore::SignalParked(std::int64_t count) noexcept {
+  const auto old_count = count_.fetch_add(count, std::memory_order_release);
+  const auto to_release = std::min(-old_count, count);
+  if (to_release > 0) sema_.signal(static_cast<int>(to_release));
+}
+
+bool SpinningSemaphore::TryBecomeHot() noexcept {
+  if (max_hot_workers_ == 0) return false;
+
+  auto hot_workers = hot_workers_->load(std::memory_order_relaxed);
+  while (hot_workers < max_hot_workers_) {
+    if (hot_workers_->compare_exchange_weak(hot_workers, hot_workers + 1,
+                                            std::memory_order_relaxed)) {
+      return true;
+    }
+  }
+  return false;
+}
+
+void SpinningSemaphore::SpinHot() noexcept {
+  const utils::FastScopeGuard hot_guard{[this]() noexcept {
+    if (hot_workers_->fetch_sub(1) != 1) return;
+
+    // Nobody spins any more, the signals that went to the hot workers are
+    // given to the parked ones. Sequentially consistent operations on
+    // hot_workers_ and hot_handoff_ make sure that either this loop or
+    // Signal() sees each of them.
+    std::int64_t handoffs = 0;
+    while (TryDecrement(*hot_handoff_)) ++handoffs;
+    if (handoffs != 0) SignalParked(handoffs);
+  }};
+
+  std::uint64_t iterations = 0;
+  while (!TryWait()) {
+    CpuPause();
+    if (++iterations == kHotSpinStatsBatch) {
+      spin_iterations_.Add({iterations});
+      iterations = 0;
+    }
+  }
+  spin_iterations_.Add({iterations + 1});
+  ++spin_wakeups_;
+}
+
+void SpinningSemaphore::AdaptAfterSpin(std::int64_t spins) noexcept {
+  if (policy_ != SpinningPolicy::kAdaptive) return;
+
+  // Moves towards twice the iterations the task took to come. Races between
+  // the workers only add noise to the heuristic.
+  auto limit = spin_limit_->load(std::memory_order_relaxed);
+  limit += (2 * spins - limit) / 8;
+  spin_limit_->store(std::clamp(limit, min_spins_, max_spins_),
+                     std::memory_order_relaxed);
+}
+
+void SpinningSemaphore::AdaptAfterPark(
+    std::chrono::steady_clock::duration parked) noexcept {
+  auto limit = spin_limit_->load(std::memory_order_relaxed);
+  if (parked < kShortPark) {
+    limit += (max_spins_ - limit) / 4 + 1;
+  } else {
+    limit -= limit / 8 + 1;
+  }
+  spin_limit_->store(std::clamp(limit, min_spins_, max_spins_),
+                     std::memory_order_relaxed);
+}
+
+}  // namespace engine
+
+USERVER_NAMESPACE_END
@@ -0,0 +1,88 @@
+#pragma once
+
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+
+// lightweightsemaphore.h relies on the macros and includes of concurrentqueue.h
+#include <moodycamel/concurrentqueue.h>
+#include <moodycamel/lightweightsemaphore.h>
+
+#include <concurrent/impl/interference_shield.hpp>
+#include <engine/task/task_processor_config.hpp>
+#include <userver/utils/statistics/rate.hpp>
+#include <userver/utils/statistics/striped_rate_counter.hpp>
+
+USERVER_NAMESPACE_BEGIN
+
+namespace engine {
+
+/// Counts the queued tasks, idle TaskProcessor workers wait on it.
+///
+/// A waiting worker spins for a while before parking on the OS semaphore.
+/// Spinning saves the wake-up latency when tasks come in bursts, but burns
+/// CPU under light load. With SpinningPolicy::kAdaptive the spin limit moves
+/// towards the number of iterations that the recent successful spins needed,
+/// shrinks after long parks and grows when parked workers are woken up right
+/// away. Up to `hot_workers` idle workers do not park at all and get the new
+/// tasks before the parked ones.
+class SpinningSemaphore final {
+ public:
+  struct Stats final {
+    // Waits that ended while spinning
+    utils::statistics::Rate spin_wakeups;
+    utils::statistics::Rate spin_iterations;
+    utils::statistics::Rate parks;
+    std::int64_t spin_limit{0};
+    std::size_t hot_workers{0};
+  };
+
+  explicit SpinningSemaphore(const TaskProcessorConfig& config);
+
+  SpinningSemaphore(SpinningSemaphore&&) = delete;
+  SpinningSemaphore& operator=(SpinningSemaphore&&) = delete;
+
+  void Signal() noexcept;
+
+  void Wait() noexcept;
+
+  /// Acquires a unit if one is available right away, never spins or parks
+  bool TryWait() noexcept;
+
+  Stats GetStats() const noexcept;
+
+ private:
+
+  void SignalParked(std::int64_t count) noexcept;
+
+  bool TryBecomeHot() noexcept;
+
+  void SpinHot() noexcept;
+
+  void AdaptAfterSpin(std::int64_t spins) noexcept;
+
+  void AdaptAfterPark(std::chrono::steady_clock::duration parked) noexcept;
+
+  std::atomic<std::int64_t> count_{0};
+  moodycamel::details::Semaphore sema_;
+
+  const SpinningPolicy policy_;
+  const std::int64_t min_spins_;
+  const std::int64_t max_spins_;
+  const std::size_t max_hot_workers_;
+
+  concurrent::impl::InterferenceShield<std::atomic<std::int64_t>> spin_limit_;
+  concurrent::impl::InterferenceShield<std::atomic<std::size_t>> hot_workers_{
+      0};
+  concurrent::impl::InterferenceShield<std::atomic<std::int64_t>> hot_handoff_{
+      0};
+
+  utils::statistics::StripedRateCounter spin_wakeups_;
+  utils::statistics::StripedRateCounter spin_iterations_;
+  utils::statistics::StripedRateCounter parks_;
+};
+
+}  // namespace engine
+
+USERVER_NAMESPACE_END
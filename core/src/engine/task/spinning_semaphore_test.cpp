@@ -0,0 +1,134 @@
+#include <engine/task/spinning_semaphore.hpp>
+
+#include <atomic>
+#include <chrono>
+#include <thread>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+USERVER_NAMESPACE_BEGIN
+
+namespace {
+
+engine::TaskProcessorConfig MakeConfig(engine::SpinningPolicy policy,
+                                       std::size_t hot_workers = 0) {
+  engine::TaskProcessorConfig config;
+  config.worker_threads = 4;
+  config.spinning_policy = policy;
+  config.hot_workers = hot_workers;
+  return config;
+}
+
+void ProduceConsume(engine::SpinningSemaphore& semaphore) {
+  constexpr std::size_t kConsumers = 4;
+  constexpr std::size_t kSignals = 20000;
+
+  std::atomic<std::size_t> acquired{0};
+  std::vector<std::thread> consumers;
+  for (std::size_t i = 0; i < kConsumers; ++i) {
+    consumers.emplace_back([&] {
+      for (std::size_t j = 0; j < kSignals / kConsumers; ++j) {
+        semaphore.Wait();
+        ++acquired;
+      }
+    });
+  }
+
+  for (std::size_t i = 0; i < kSignals; ++i) {
+    semaphore.Signal();
+    // Bursts with pauses exercise both the spinning and the parking
+    if (i % 1000 == 0) {
+      std::this_thread::sleep_for(std::chrono::microseconds{200});
+    }
+  }
+
+  for (auto& consumer : consumers) consumer.join();
+  EXPECT_EQ(acquired.load(), kSignals);
+}
+
+}  // namespace
+
+TEST(SpinningSemaphore, Fixed) {
+  engine::SpinningSemaphore semaphore{
+      MakeConfig(engine::SpinningPolicy::kFixed)};
+  ProduceConsume(semaphore);
+
+  const auto stats = semaphore.GetStats();
+  EXPECT_EQ(stats.spin_limit, 1000);
+  EXPECT_EQ(stats.hot_workers, 0);
+}
+
+TEST(SpinningSemaphore, Adaptive) {
+  engine::SpinningSemaphore semaphore{
+      MakeConfig(engine::SpinningPolicy::kAdaptive)};
+  ProduceConsume(semaphore);
+
+  const auto stats = semaphore.GetStats();
+  EXPECT_GE(stats.spin_limit, 1000 / 16);
+  EXPECT_LE(stats.spin_limit, 1000 * 16);
+}
+
+TEST(SpinningSemaphore, HotWorkers) {
+  engine::SpinningSemaphore semaphore{
+      MakeConfig(engine::SpinningPolicy::kFixed, 2)};
+  ProduceConsume(semaphore);
+  EXPECT_EQ(semaphore.GetStats().hot_workers, 0);
+}
+
+TEST(SpinningSemaphore, AdaptiveShrinksOnRareWakeups) {
+  engine::SpinningSemaphore semaphore{
+      MakeConfig(engine::SpinningPolicy::kAdaptive)};
+
+  std::thread consumer{[&] {
+    for (int i = 0; i < 20; ++i) semaphore.Wait();
+  }};
+  for (int i = 0; i < 20; ++i) {
+    std::this_thread::sleep_for(std::chrono::milliseconds{2});
+    semaphore.Signal();
+  }
+  consumer.join();
+
+  const auto stats = semaphore.GetStats();
+  EXPECT_LT(stats.spin_limit, 1000);
+  EXPECT_GT(stats.parks.value, 0);
+}
+
+TEST(SpinningSemaphore, HotWorkerGetsSignalFirst) {
+  engine::SpinningSemaphore semaphore{
+      MakeConfig(engine::SpinningPolicy::kFixed, 1)};
+
+  std::atomic<bool> stop{false};
+  std::atomic<std::size_t> acquired{0};
+  std::vector<std::thread> consumers;
+  for (int i = 0; i < 3; ++i) {
+    consumers.emplace_back([&] {
+      while (true) {
+        semaphore.Wait();
+        if (stop) return;
+        ++acquired;
+      }
+    });
+  }
+
+  // Let the workers park or become hot
+  while (semaphore.GetStats().hot_workers == 0) std::this_thread::yield();
+  std::this_thread::sleep_for(std::chrono::milliseconds{10});
+  const auto parks_before = semaphore.GetStats().parks;
+
+  for (int i = 0; i < 100; ++i) {
+    while (semaphore.GetStats().hot_workers == 0) std::this_thread::yield();
+    semaphore.Signal();
+    while (acquired != static_cast<std::size_t>(i + 1)) {
+      std::this_thread::yield();
+    }
+  }
+  // The hot worker took all the signals, nobody was woken up
+  EXPECT_EQ(semaphore.GetStats().parks.value, parks_before.value);
+
+  stop = true;
+  for (std::size_t i = 0; i < consumers.size(); ++i) semaphore.Signal();
+  for (auto& consumer : consumers) consumer.join();
+}
+
+USERVER_NAMESPACE_END
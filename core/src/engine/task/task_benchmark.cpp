@@ -34,8 +34,11 @@ void engine_task_yield_single_thread(benchmark::State& state) {
 }
 BENCHMARK(engine_task_yield_single_thread)->RangeMultiplier(2)->Range(1, 128);
 
-void engine_task_yield_multiple_threads(benchmark::State& state) {
-  engine::RunStandalone(state.range(0), [&] {
+void DoTaskYieldMultipleThreads(benchmark::State& state,
+                                engine::TaskQueueType task_queue_type) {
+  engine::TaskProcessorPoolsConfig config;
+  config.task_queue_type = task_queue_type;
+  engine::RunStandalone(state.range(0), config, [&] {
     std::atomic<std::uint64_t> total_yields{0};
 
     RunParallelBenchmark(state, [&](auto& range) {
@@ -54,12 +57,27 @@ void engine_task_yield_multiple_threads(benchmark::State& state) {
                            benchmark::Counter::kIsRate);
   });
 }
+
+void engine_task_yield_multiple_threads(benchmark::State& state) {
+  DoTaskYieldMultipleThreads(state, engine::TaskQueueType::kGlobalTaskQueue);
+}
 BENCHMARK(engine_task_yield_multiple_threads)
     ->RangeMultiplier(2)
     ->Range(1, 32)
     ->Arg(6)
     ->Arg(12);
 
+void engine_task_yield_multiple_threads_work_stealing(
+    benchmark::State& state) {
+  DoTaskYieldMultipleThreads(state,
+                             engine::TaskQueueType::kWorkStealingTaskQueue);
+}
+BENCHMARK(engine_task_yield_multiple_threads_work_stealing)
+    ->RangeMultiplier(2)
+    ->Range(1, 32)
+    ->Arg(6)
+    ->Arg(12);
+
 void engine_task_yield_multiple_task_processors(benchmark::State& state) {
   engine::RunStandalone([&] {
     auto tp_pool = engine::SingleThreadedTaskProcessorsPool::MakeForTests(
@@ -107,8 +125,11 @@ void thread_yield(benchmark::State& state) {
 }
 BENCHMARK(thread_yield)->RangeMultiplier(2)->ThreadRange(1, 32);
 
-void engine_multiple_tasks_multiple_threads(benchmark::State& state) {
-  engine::RunStandalone(state.range(0), [&] {
+void DoMultipleTasksMultipleThreads(benchmark::State& state,
+                                    engine::TaskQueueType task_queue_type) {
+  engine::TaskProcessorPoolsConfig config;
+  config.task_queue_type = task_queue_type;
+  engine::RunStandalone(state.range(0), config, [&] {
     std::atomic<std::uint64_t> tasks_count_total = 0;
     RunParallelBenchmark(state, [&](auto& range) {
       std::uint64_t tasks_count = 0;
@@ -122,10 +143,26 @@ void engine_multiple_tasks_multiple_threads(benchmark::State& state) {
     benchmark::DoNotOptimize(tasks_count_total);
   });
 }
+
+void engine_multiple_tasks_multiple_threads(benchmark::State& state) {
+  DoMultipleTasksMultipleThreads(state,
+                                 engine::TaskQueueType::kGlobalTaskQueue);
+}
 BENCHMARK(engine_multiple_tasks_multiple_threads)
     ->RangeMultiplier(2)
     ->Range(1, 32)
     ->Arg(6)
     ->Arg(12);
 
+void engine_multiple_tasks_multiple_threads_work_stealing(
+    benchmark::State& state) {
+  DoMultipleTasksMultipleThreads(state,
+                                 engine::TaskQueueType::kWorkStealingTaskQueue);
+}
+BENCHMARK(engine_multiple_tasks_multiple_threads_work_stealing)
+    ->RangeMultiplier(2)
+    ->Range(1, 32)
+    ->Arg(6)
+    ->Arg(12);
+
 USERVER_NAMESPACE_END
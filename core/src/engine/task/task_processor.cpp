@@ -63,6 +63,18 @@ std::vector<std::function<void()>>& ThreadStartedHooks() {
   return thread_started_hooks;
 }
 
+std::variant<TaskQueue, WorkStealingTaskQueue> MakeTaskQueue(
+    const TaskProcessorConfig& config) {
+  using Variant = std::variant<TaskQueue, WorkStealingTaskQueue>;
+  switch (config.task_processor_queue) {
+    case TaskQueueType::kGlobalTaskQueue:
+      return Variant{std::in_place_type<TaskQueue>, config};
+    case TaskQueueType::kWorkStealingTaskQueue:
+      return Variant{std::in_place_type<WorkStealingTaskQueue>, config};
+  }
+  UINVARIANT(false, "Unexpected value of TaskQueueType");
+}
+
 void EmitMagicNanosleep() {
   // If we're ptrace'd (e.g. by strace), the magic syscall tells a tracer
   // that all startup stuff of the current thread is done.
@@ -85,7 +97,7 @@ void TaskProcessorThreadStartedHook() {
 
 TaskProcessor::TaskProcessor(TaskProcessorConfig config,
                              std::shared_ptr<impl::TaskProcessorPools> pools)
-    : task_queue_(config),
+    : task_queue_(MakeTaskQueue(config)),
       task_counter_(config.worker_threads),
       config_(std::move(config)),
       pools_(std::move(pools)) {
@@ -93,7 +105,11 @@ TaskProcessor::TaskProcessor(TaskProcessorConfig config,
   try {
     LOG_INFO() << "creating task_processor " << Name() << " "
                << "worker_threads=" << config_.worker_threads
-               << " thread_name=" << config_.thread_name;
+               << " thread_name=" << config_.thread_name
+               << " task_processor_queue="
+               << (std::holds_alternative<WorkStealingTaskQueue>(task_queue_)
+                       ? "work-stealing-task-queue"
+                       : "global-task-queue");
     concurrent::impl::Latch workers_left{
         static_cast<std::ptrdiff_t>(config_.worker_threads)};
     workers_.reserve(config_.worker_threads);
@@ -101,7 +117,8 @@ TaskProcessor::TaskProcessor(TaskProcessorConfig config,
       workers_.emplace_back([this, i, &workers_left] {
         PrepareWorkerThread(i);
         workers_left.count_down();
-        ProcessTasks();
+        std::visit([this](auto& queue) { ProcessTasks(queue); },
+                   task_queue_);
         FinalizeWorkerThread();
       });
     }
@@ -124,7 +141,7 @@ void TaskProcessor::Cleanup() noexcept {
   // Some tasks may be bound but not scheduled yet
   task_counter_.WaitForExhaustionBlocking();
 
-  task_queue_.StopProcessing();
+  std::visit([](auto& queue) { queue.StopProcessing(); }, task_queue_);
 
   for (auto& w : workers_) {
     w.join();
@@ -158,7 +175,7 @@ void TaskProcessor::Schedule(impl::TaskContext* context) {
 
   SetTaskQueueWaitTimepoint(context);
 
-  task_queue_.Push(context);
+  std::visit([context](auto& queue) { queue.Push(context); }, task_queue_);
 }
 
 void TaskProcessor::Adopt(impl::TaskContext& context) {
@@ -289,6 +306,10 @@ void TaskProcessor::PrepareWorkerThread(std::size_t index) noexcept {
 
   impl::SetLocalTaskCounterData(task_counter_, index);
 
+  if (auto* queue = std::get_if<WorkStealingTaskQueue>(&task_queue_)) {
+    queue->PrepareWorker(index);
+  }
+
   pools_->GetCoroPool().RegisterThread();
 
   TaskProcessorThreadStartedHook();
@@ -298,9 +319,10 @@ void TaskProcessor::FinalizeWorkerThread() noexcept {
   pools_->GetCoroPool().ClearLocalCache();
 }
 
-void TaskProcessor::ProcessTasks() noexcept {
+template <typename Queue>
+void TaskProcessor::ProcessTasks(Queue& task_queue) noexcept {
   while (true) {
-    auto context = task_queue_.PopBlocking();
+    auto context = task_queue.PopBlocking();
     if (!context) break;
 
     GetTaskCounter().AccountTaskSwitchSlow();
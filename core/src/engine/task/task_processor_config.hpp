@@ -5,6 +5,7 @@
 #include <cstdint>
 #include <string>
 
+#include <userver/engine/task/task_processor_fwd.hpp>
 #include <userver/formats/json_fwd.hpp>
 #include <userver/yaml_config/fwd.hpp>
 
@@ -21,6 +22,12 @@ enum class OsScheduling {
 OsScheduling Parse(const yaml_config::YamlConfig& value,
                    formats::parse::To<OsScheduling>);
 
+TaskQueueType Parse(const yaml_config::YamlConfig& value,
+                    formats::parse::To<TaskQueueType>);
+
+SpinningPolicy Parse(const yaml_config::YamlConfig& value,
+                     formats::parse::To<SpinningPolicy>);
+
 struct TaskProcessorConfig {
   std::string name;
 
@@ -29,6 +36,9 @@ struct TaskProcessorConfig {
   std::string thread_name;
   OsScheduling os_scheduling{OsScheduling::kNormal};
   int spinning_iterations{1000};
+  SpinningPolicy spinning_policy{SpinningPolicy::kFixed};
+  std::size_t hot_workers{0};
+  TaskQueueType task_processor_queue{TaskQueueType::kGlobalTaskQueue};
 
   std::size_t task_trace_every{1000};
   std::size_t task_trace_max_csw{0};
@@ -1,7 +1,13 @@
 #include <engine/task/task_processor.hpp>
 
+#include <atomic>
+#include <thread>
+
 #include <engine/task/task_processor_config.hpp>
 #include <userver/engine/async.hpp>
+#include <userver/engine/run_standalone.hpp>
+#include <userver/engine/single_consumer_event.hpp>
+#include <userver/engine/sleep.hpp>
 #include <userver/engine/task/task_base.hpp>
 #include <userver/engine/task/task_with_result.hpp>
 #include <userver/utest/utest.hpp>
@@ -47,4 +53,138 @@ UTEST(TaskProcessor, Overload) {
   }
 }
 
+TEST(TaskProcessor, WorkStealingTaskQueue) {
+  constexpr std::size_t kPingPongPairs = 16;
+  constexpr std::size_t kIterations = 1000;
+
+  engine::TaskProcessorPoolsConfig config{};
+  config.task_queue_type = engine::TaskQueueType::kWorkStealingTaskQueue;
+
+  engine::RunStandalone(4, config, [&] {
+    std::atomic<std::size_t> total_iterations{0};
+    std::vector<engine::SingleConsumerEvent> events(kPingPongPairs * 2);
+    std::vector<engine::TaskWithResult<void>> tasks;
+    tasks.reserve(kPingPongPairs * 2);
+
+    // Tasks that wake each other up go through the LIFO slots
+    for (std::size_t i = 0; i < kPingPongPairs; ++i) {
+      auto& ping = events[i * 2];
+      auto& pong = events[i * 2 + 1];
+      tasks.push_back(engine::AsyncNoSpan([&] {
+        for (std::size_t j = 0; j < kIterations; ++j) {
+          pong.Send();
+          ASSERT_TRUE(ping.WaitForEvent());
+          ++total_iterations;
+        }
+      }));
+      tasks.push_back(engine::AsyncNoSpan([&] {
+        for (std::size_t j = 0; j < kIterations; ++j) {
+          ASSERT_TRUE(pong.WaitForEvent());
+          ping.Send();
+          engine::Yield();
+        }
+      }));
+    }
+
+    for (auto& task : tasks) task.Get();
+    EXPECT_EQ(total_iterations.load(), kPingPongPairs * kIterations);
+  });
+}
+
+TEST(TaskProcessor, WorkStealingTaskQueuePingPongLocality) {
+  constexpr std::size_t kIterations = 1000;
+
+  engine::TaskProcessorPoolsConfig config{};
+  config.task_queue_type = engine::TaskQueueType::kWorkStealingTaskQueue;
+
+  engine::RunStandalone(4, config, [&] {
+    engine::SingleConsumerEvent ping;
+    engine::SingleConsumerEvent pong;
+    std::size_t migrations = 0;
+
+    auto pinger = engine::AsyncNoSpan([&] {
+      auto thread = std::this_thread::get_id();
+      for (std::size_t i = 0; i < kIterations; ++i) {
+        pong.Send();
+        ASSERT_TRUE(ping.WaitForEvent());
+        const auto current_thread = std::this_thread::get_id();
+        if (current_thread != thread) ++migrations;
+        thread = current_thread;
+      }
+    });
+    auto ponger = engine::AsyncNoSpan([&] {
+      for (std::size_t i = 0; i < kIterations; ++i) {
+        ASSERT_TRUE(pong.WaitForEvent());
+        ping.Send();
+      }
+    });
+
+    pinger.Get();
+    ponger.Get();
+    // The idle workers are not woken up for the task that goes into the LIFO
+    // slot of its waker, so the pair settles on a single worker
+    EXPECT_LT(migrations, kIterations / 10);
+  });
+}
+
+TEST(TaskProcessor, WorkStealingTaskQueueBusyWorker) {
+  engine::TaskProcessorPoolsConfig config{};
+  config.task_queue_type = engine::TaskQueueType::kWorkStealingTaskQueue;
+
+  engine::RunStandalone(2, config, [&] {
+    std::atomic<bool> keep_running{true};
+    std::atomic<std::size_t> subtasks_done{0};
+    constexpr std::size_t kSubtasks = 10;
+
+    // Occupies a worker thread without ever yielding, so the tasks scheduled
+    // into its local queue and LIFO slot have to be stolen by the other one.
+    // The LIFO slot is taken over once the task in it gets stale.
+    auto busy_task = engine::AsyncNoSpan([&] {
+      for (std::size_t i = 0; i < kSubtasks; ++i) {
+        engine::AsyncNoSpan([&] { ++subtasks_done; }).Detach();
+      }
+      while (keep_running) {
+      }
+    });
+
+    while (subtasks_done != kSubtasks) {
+      engine::SleepFor(std::chrono::milliseconds{1});
+    }
+    keep_running = false;
+    busy_task.Get();
+  });
+}
+
+class TaskProcessorSpinning
+    : public ::testing::TestWithParam<engine::TaskQueueType> {};
+
+INSTANTIATE_TEST_SUITE_P(
+    /*no prefix*/, TaskProcessorSpinning,
+    ::testing::Values(engine::TaskQueueType::kGlobalTaskQueue,
+                      engine::TaskQueueType::kWorkStealingTaskQueue));
+
+TEST_P(TaskProcessorSpinning, AdaptiveWithHotWorker) {
+  constexpr std::size_t kTasks = 200;
+
+  engine::TaskProcessorPoolsConfig config{};
+  config.task_queue_type = GetParam();
+  config.spinning_policy = engine::SpinningPolicy::kAdaptive;
+  config.hot_workers = 1;
+
+  engine::RunStandalone(4, config, [&] {
+    std::atomic<std::size_t> tasks_done{0};
+    for (std::size_t i = 0; i < kTasks; ++i) {
+      engine::AsyncNoSpan([&] { ++tasks_done; }).Get();
+      // Lets the workers go idle between the tasks
+      if (i % 10 == 0) engine::SleepFor(std::chrono::milliseconds{1});
+    }
+    EXPECT_EQ(tasks_done.load(), kTasks);
+
+    const auto stats =
+        engine::current_task::GetTaskProcessor().GetSpinningStats();
+    EXPECT_GT(stats.spin_wakeups.value, 0u);
+    EXPECT_LE(stats.hot_workers, 1u);
+  });
+}
+
 USERVER_NAMESPACE_END
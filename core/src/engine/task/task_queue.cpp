@@ -6,12 +6,8 @@ USERVER_NAMESPACE_BEGIN
 
 namespace engine {
 
-namespace {
-constexpr std::size_t kSemaphoreInitialCount = 0;
-}
-
 TaskQueue::TaskQueue(const TaskProcessorConfig& config)
-    : queue_semaphore_(kSemaphoreInitialCount, config.spinning_iterations) {}
+    : queue_semaphore_(config) {}
 
 void TaskQueue::Push(boost::intrusive_ptr<impl::TaskContext>&& context) {
   UASSERT(context);
@@ -41,11 +37,15 @@ std::size_t TaskQueue::GetSizeApproximate() const noexcept {
   return queue_.size_approx();
 }
 
+SpinningSemaphore::Stats TaskQueue::GetSpinningStats() const noexcept {
+  return queue_semaphore_.GetStats();
+}
+
 void TaskQueue::DoPush(impl::TaskContext* context) {
   // This piece of code is copy-pasted from
   // moodycamel::BlockingConcurrentQueue::enqueue
   queue_.enqueue(context);
-  queue_semaphore_.signal();
+  queue_semaphore_.Signal();
 }
 
 impl::TaskContext* TaskQueue::DoPopBlocking(moodycamel::ConsumerToken& token) {
@@ -53,7 +53,7 @@ impl::TaskContext* TaskQueue::DoPopBlocking(moodycamel::ConsumerToken& token) {
 
   // This piece of code is copy-pasted from
   // moodycamel::BlockingConcurrentQueue::wait_dequeue
-  queue_semaphore_.wait();
+  queue_semaphore_.Wait();
   while (!queue_.try_dequeue(token, context)) {
     // Can happen when another consumer steals our item in exchange for another
     // item in a Moodycamel sub-queue that we have already passed.
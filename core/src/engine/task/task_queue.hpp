@@ -1,9 +1,9 @@
 #pragma once
 
 #include <moodycamel/blockingconcurrentqueue.h>
-#include <moodycamel/lightweightsemaphore.h>
 #include <boost/smart_ptr/intrusive_ptr.hpp>
 
+#include <engine/task/spinning_semaphore.hpp>
 #include <engine/task/task_processor_config.hpp>
 
 USERVER_NAMESPACE_BEGIN
@@ -27,13 +27,15 @@ class TaskQueue final {
 
   std::size_t GetSizeApproximate() const noexcept;
 
+  SpinningSemaphore::Stats GetSpinningStats() const noexcept;
+
  private:
   void DoPush(impl::TaskContext* context);
 
   impl::TaskContext* DoPopBlocking(moodycamel::ConsumerToken& token);
 
   moodycamel::ConcurrentQueue<impl::TaskContext*> queue_;
-  moodycamel::LightweightSemaphore queue_semaphore_;
+  SpinningSemaphore queue_semaphore_;
 };
 
 }  // namespace engine
@@ -0,0 +1,321 @@
+#include <engine/task/work_stealing_task_queue.hpp>
+
+#include <array>
+#include <chrono>
+#include <optional>
+#include <thread>
+
+#include <engine/task/task_context.hpp>
+#include <userver/compiler/thread_local.hpp>
+#include <userver/utils/assert.hpp>
+#include <userver/utils/datetime/steady_coarse_clock.hpp>
+
+USERVER_NAMESPACE_BEGIN
+
+namespace engine {
+
+namespace {
+
+// Power of 2 for cheap index wrapping.
+constexpr std::size_t kLocalQueueCapacity = 256;
+
+// Limits the number of tasks taken from the LIFO slot in a row, otherwise
+// a pair of tasks that wake each other up may starve the queued tasks.
+constexpr std::uint32_t kMaxLifoStreak = 3;
+
+// A task that has been in the LIFO slot for longer than that is taken by
+// another worker, as the owner is likely stuck in a long task. The coarse
+// clock makes the actual delay up to a few milliseconds longer.
+constexpr std::chrono::milliseconds kStaleLifoAge{2};
+
+// The global queue is checked before the local one every N pops, otherwise
+// tasks from non-worker threads may starve under constant local load.
+constexpr std::uint32_t kGlobalQueueCheckInterval = 61;
+
+struct LocalConsumerData final {
+  const WorkStealingTaskQueue* queue{nullptr};
+  std::size_t index{0};
+};
+
+compiler::ThreadLocal local_consumer_data = [] {
+  return LocalConsumerData{};
+};
+
+}  // namespace
+
+/// Bounded single-producer multi-consumer ring buffer. Only the owning worker
+/// pushes, any worker may pop from the head.
+class WorkStealingTaskQueue::LocalQueue final {
+ public:
+  bool TryPush(impl::TaskContext* context) noexcept {
+    const auto tail = tail_.load(std::memory_order_relaxed);
+    const auto head = head_.load(std::memory_order_acquire);
+    if (tail - head >= kLocalQueueCapacity) return false;
+
+    buffer_[tail % kLocalQueueCapacity].store(context,
+                                              std::memory_order_relaxed);
+    tail_.store(tail + 1, std::memory_order_release);
+    return true;
+  }
+
+  bool TryPop(impl::TaskContext*& context) noexcept {
+    auto head = head_.load(std::memory_order_acquire);
+    while (true) {
+      const auto tail = tail_.load(std::memory_order_acquire);
+      if (head == tail) return false;
+
+      // The slot may be overwritten by the producer right after we read it,
+      // but only after another consumer has advanced head_, in which case
+      // the CAS below fails and the stale value is discarded.
+      auto* candidate =
+          buffer_[head % kLocalQueueCapacity].load(std::memory_order_relaxed);
+      if (head_.compare_exchange_weak(head, head + 1,
+                                      std::memory_order_acq_rel,
+                                      std::memory_order_acquire)) {
+        context = candidate;
+        return true;
+      }
+    }
+  }
+
+  std::size_t GetSizeApproximate() const noexcept {
+    const auto head = head_.load(std::memory_order_relaxed);
+    const auto tail = tail_.load(std::memory_order_relaxed);
+    return tail >= head ? tail - head : 0;
+  }
+
+ private:
+  std::atomic<std::uint64_t> head_{0};
+  std::atomic<std::uint64_t> tail_{0};
+  std::array<std::atomic<impl::TaskContext*>, kLocalQueueCapacity> buffer_{};
+};
+
+struct WorkStealingTaskQueue::Consumer final {
+  LocalQueue local_queue;
+  std::atomic<impl::TaskContext*> lifo_slot{nullptr};
+  std::atomic<utils::datetime::SteadyCoarseClock::time_point> lifo_push_time{};
+
+  // Accessed only by the owning worker
+  std::optional<moodycamel::ConsumerToken> consumer_token;
+  std::optional<moodycamel::ProducerToken> producer_token;
+  std::uint32_t lifo_streak{0};
+  std::uint32_t pops_since_global_check{0};
+  std::uint64_t random_state{0};
+};
+
+WorkStealingTaskQueue::WorkStealingTaskQueue(const TaskProcessorConfig& config)
+    : consumers_count_(config.worker_threads),
+      consumers_(
+          std::make_unique<concurrent::impl::InterferenceShield<Consumer>[]>(
+              consumers_count_)),
+      queue_semaphore_(config) {
+  UINVARIANT(consumers_count_ > 0,
+             "Work stealing task queue requires at least one worker");
+}
+
+WorkStealingTaskQueue::~WorkStealingTaskQueue() = default;
+
+void WorkStealingTaskQueue::PrepareWorker(std::size_t index) noexcept {
+  UASSERT(index < consumers_count_);
+  auto& consumer = *consumers_[index];
+  consumer.consumer_token.emplace(global_queue_);
+  consumer.producer_token.emplace(global_queue_);
+  // Any non-zero seed works for xorshift
+  consumer.random_state = index + 1;
+
+  auto local_data = local_consumer_data.Use();
+  *local_data = {this, index};
+}
+
+void WorkStealingTaskQueue::Push(
+    boost::intrusive_ptr<impl::TaskContext>&& context) {
+  UASSERT(context);
+  DoPush(context.get());
+  context.detach();
+}
+
+boost::intrusive_ptr<impl::TaskContext> WorkStealingTaskQueue::PopBlocking() {
+  boost::intrusive_ptr<impl::TaskContext> context{DoPopBlocking(),
+                                                  /* add_ref= */ false};
+
+  if (!context) {
+    // return "stop" token back
+    PushToGlobal(nullptr);
+    queue_semaphore_.Signal();
+  }
+
+  return context;
+}
+
+void WorkStealingTaskQueue::StopProcessing() {
+  PushToGlobal(nullptr);
+  queue_semaphore_.Signal();
+}
+
+std::size_t WorkStealingTaskQueue::GetSizeApproximate() const noexcept {
+  std::size_t size = global_queue_.size_approx();
+  for (std::size_t i = 0; i < consumers_count_; ++i) {
+    const auto& consumer = *consumers_[i];
+    size += consumer.local_queue.GetSizeApproximate();
+    if (consumer.lifo_slot.load(std::memory_order_relaxed)) ++size;
+  }
+  return size;
+}
+
+SpinningSemaphore::Stats WorkStealingTaskQueue::GetSpinningStats()
+    const noexcept {
+  return queue_semaphore_.GetStats();
+}
+
+WorkStealingTaskQueue::Consumer* WorkStealingTaskQueue::GetLocalConsumer()
+    const noexcept {
+  auto local_data = local_consumer_data.Use();
+  if (local_data->queue != this) return nullptr;
+  return &*consumers_[local_data->index];
+}
+
+void WorkStealingTaskQueue::DoPush(impl::TaskContext* context) {
+  UASSERT(context);
+  if (auto* consumer = GetLocalConsumer()) {
+    // The slot is not counted by the semaphore: waking up another worker
+    // here would make it steal the task from under its owner
+    consumer->lifo_push_time.store(utils::datetime::SteadyCoarseClock::now(),
+                                   std::memory_order_relaxed);
+    auto* displaced =
+        consumer->lifo_slot.exchange(context, std::memory_order_acq_rel);
+    if (!displaced) return;
+    PushToLocal(*consumer, displaced);
+  } else {
+    PushToGlobal(context);
+  }
+  queue_semaphore_.Signal();
+}
+
+void WorkStealingTaskQueue::PushToLocal(Consumer& consumer,
+                                        impl::TaskContext* context) {
+  if (!consumer.local_queue.TryPush(context)) PushToGlobal(context);
+}
+
+void WorkStealingTaskQueue::PushToGlobal(impl::TaskContext* context) {
+  auto* consumer = GetLocalConsumer();
+  if (consumer && consumer->producer_token) {
+    global_queue_.enqueue(*consumer->producer_token, context);
+  } else {
+    global_queue_.enqueue(context);
+  }
+}
+
+impl::TaskContext* WorkStealingTaskQueue::DoPopBlocking() {
+  auto* consumer = GetLocalConsumer();
+  impl::TaskContext* context{};
+
+  bool acquired = false;
+  if (consumer) {
+    auto* lifo_context = TryPopLifo(*consumer);
+    if (!lifo_context) {
+      consumer->lifo_streak = 0;
+    } else if (consumer->lifo_streak < kMaxLifoStreak) {
+      ++consumer->lifo_streak;
+      return lifo_context;
+    } else if (!queue_semaphore_.TryWait()) {
+      // Nothing else is queued, no need to break the streak. It stays at
+      // the maximum, so that the queues are checked on the next pop as well.
+      return lifo_context;
+    } else {
+      // Lets the queued tasks run first, the semaphore unit acquired above
+      // is now for one of them
+      consumer->lifo_streak = 0;
+      PushToLocal(*consumer, lifo_context);
+      queue_semaphore_.Signal();
+      acquired = true;
+    }
+  }
+
+  if (!acquired && !queue_semaphore_.TryWait()) {
+    // About to spin or park, a task stuck in the LIFO slot of a busy worker
+    // is better off running here
+    if (TryStealStaleLifo(consumer, context)) return context;
+    queue_semaphore_.Wait();
+  }
+
+  // Each acquired unit of the semaphore corresponds to a task that was pushed
+  // into one of the queues, so we are bound to find it.
+  while (true) {
+    if (consumer && TryPopLocal(*consumer, context)) break;
+    if (TryPopGlobal(consumer, context)) break;
+    if (TrySteal(consumer, context)) break;
+
+    // The task is in a moodycamel sub-queue we have already passed, or its
+    // producer has not finished pushing it yet. Let the producer proceed.
+    std::this_thread::yield();
+  }
+
+  return context;
+}
+
+impl::TaskContext* WorkStealingTaskQueue::TryPopLifo(Consumer& consumer) {
+  if (!consumer.lifo_slot.load(std::memory_order_relaxed)) return nullptr;
+  // Other workers may take a stale task from the slot concurrently
+  return consumer.lifo_slot.exchange(nullptr, std::memory_order_acq_rel);
+}
+
+bool WorkStealingTaskQueue::TryPopLocal(Consumer& consumer,
+                                        impl::TaskContext*& context) {
+  if (++consumer.pops_since_global_check >= kGlobalQueueCheckInterval) {
+    consumer.pops_since_global_check = 0;
+    if (TryPopGlobal(&consumer, context)) return true;
+  }
+
+  return consumer.local_queue.TryPop(context);
+}
+
+bool WorkStealingTaskQueue::TryPopGlobal(Consumer* consumer,
+                                         impl::TaskContext*& context) {
+  if (consumer && consumer->consumer_token) {
+    return global_queue_.try_dequeue(*consumer->consumer_token, context);
+  }
+  return global_queue_.try_dequeue(context);
+}
+
+bool WorkStealingTaskQueue::TrySteal(Consumer* thief,
+                                     impl::TaskContext*& context) {
+  std::size_t start = 0;
+  if (thief) {
+    // xorshift64
+    auto& x = thief->random_state;
+    x ^= x << 13;
+    x ^= x >> 7;
+    x ^= x << 17;
+    start = x % consumers_count_;
+  }
+
+  for (std::size_t i = 0; i < consumers_count_; ++i) {
+    auto& victim = *consumers_[(start + i) % consumers_count_];
+    if (&victim == thief) continue;
+
+    if (victim.local_queue.TryPop(context)) return true;
+  }
+  return false;
+}
+
+bool WorkStealingTaskQueue::TryStealStaleLifo(Consumer* thief,
+                                              impl::TaskContext*& context) {
+  const auto now = utils::datetime::SteadyCoarseClock::now();
+  for (std::size_t i = 0; i < consumers_count_; ++i) {
+    auto& victim = *consumers_[i];
+    if (&victim == thief) continue;
+    if (!victim.lifo_slot.load(std::memory_order_relaxed)) continue;
+    if (now - victim.lifo_push_time.load(std::memory_order_relaxed) <
+        kStaleLifoAge) {
+      continue;
+    }
+
+    context = victim.lifo_slot.exchange(nullptr, std::memory_order_acq_rel);
+    if (context) return true;
+  }
+  return false;
+}
+
+}  // namespace engine
+
+USERVER_NAMESPACE_END
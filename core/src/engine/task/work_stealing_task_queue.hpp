@@ -0,0 +1,91 @@
+#pragma once
+
+#include <atomic>
+#include <cstdint>
+#include <memory>
+
+#include <moodycamel/concurrentqueue.h>
+#include <boost/smart_ptr/intrusive_ptr.hpp>
+
+#include <concurrent/impl/interference_shield.hpp>
+#include <engine/task/spinning_semaphore.hpp>
+#include <engine/task/task_processor_config.hpp>
+
+USERVER_NAMESPACE_BEGIN
+
+namespace engine {
+
+namespace impl {
+class TaskContext;
+}  // namespace impl
+
+/// A task queue with a local bounded queue and a LIFO slot per worker.
+///
+/// Tasks scheduled from a worker thread of the owning TaskProcessor go into
+/// the LIFO slot of that worker (the previous occupant of the slot is moved to
+/// the local queue), so that a task that was just woken up runs on the same
+/// core and while its data is still hot in cache. Tasks scheduled from other
+/// threads, as well as local queue overflow, go to the global queue.
+///
+/// Idle workers steal from the local queues of random victims. The number of
+/// tasks in the local and global queues is tracked by a single semaphore, so
+/// that a worker that acquired it is guaranteed to eventually find a task in
+/// one of them. LIFO slots are not counted and do not wake up other workers:
+/// the owner takes the task from its slot when its current task is done. Only
+/// a task that has been in the slot for a while, as the owner is busy with
+/// a long task, is taken by a worker that is about to go idle.
+class WorkStealingTaskQueue final {
+ public:
+  explicit WorkStealingTaskQueue(const TaskProcessorConfig& config);
+  ~WorkStealingTaskQueue();
+
+  WorkStealingTaskQueue(WorkStealingTaskQueue&&) = delete;
+  WorkStealingTaskQueue& operator=(WorkStealingTaskQueue&&) = delete;
+
+  /// Must be called once on each worker thread before any PopBlocking
+  void PrepareWorker(std::size_t index) noexcept;
+
+  void Push(boost::intrusive_ptr<impl::TaskContext>&& context);
+
+  // Returns nullptr as a stop signal
+  boost::intrusive_ptr<impl::TaskContext> PopBlocking();
+
+  void StopProcessing();
+
+  std::size_t GetSizeApproximate() const noexcept;
+
+  SpinningSemaphore::Stats GetSpinningStats() const noexcept;
+
+ private:
+  class LocalQueue;
+  struct Consumer;
+
+  Consumer* GetLocalConsumer() const noexcept;
+
+  void DoPush(impl::TaskContext* context);
+
+  void PushToLocal(Consumer& consumer, impl::TaskContext* context);
+
+  void PushToGlobal(impl::TaskContext* context);
+
+  impl::TaskContext* DoPopBlocking();
+
+  impl::TaskContext* TryPopLifo(Consumer& consumer);
+
+  bool TryPopLocal(Consumer& consumer, impl::TaskContext*& context);
+
+  bool TryPopGlobal(Consumer* consumer, impl::TaskContext*& context);
+
+  bool TrySteal(Consumer* thief, impl::TaskContext*& context);
+
+  bool TryStealStaleLifo(Consumer* thief, impl::TaskContext*& context);
+
+  const std::size_t consumers_count_;
+  std::unique_ptr<concurrent::impl::InterferenceShield<Consumer>[]> consumers_;
+  moodycamel::ConcurrentQueue<impl::TaskContext*> global_queue_;
+  SpinningSemaphore queue_semaphore_;
+};
+
+}  // namespace engine
+
+USERVER_NAMESPACE_END
@@ -0,0 +1,120 @@
+#include <fs/io_uring_file.hpp>
+
+#include <fcntl.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include <algorithm>
+#include <stdexcept>
+#include <system_error>
+
+#include <fmt/format.h>
+
+#include <userver/engine/exception.hpp>
+#include <userver/engine/task/cancel.hpp>
+#include <userver/engine/task/task_base.hpp>
+#include <userver/utils/fast_scope_guard.hpp>
+
+#include <engine/ev/thread_control.hpp>
+
+USERVER_NAMESPACE_BEGIN
+
+namespace fs::impl {
+
+namespace {
+
+constexpr std::size_t kReadChunkSize = 64 * 1024;
+
+int Perform(engine::ev::IoUring& io_uring,
+            const engine::ev::IoUringOperation& operation) {
+  const auto result = io_uring.Perform(operation, engine::Deadline{});
+  if (!result) {
+    throw engine::WaitInterruptedException(
+        engine::current_task::CancellationReason());
+  }
+  return *result;
+}
+
+int OpenFile(engine::ev::IoUring& io_uring, const std::string& path,
+             int flags) {
+  engine::ev::IoUringOperation operation;
+  operation.opcode = engine::ev::IoUringOpcode::kOpenAt;
+  operation.buf = path.c_str();
+  operation.flags = flags | O_CLOEXEC;
+  // same as the fs::blocking::FileDescriptor::Open default
+  operation.mode = S_IRUSR | S_IWUSR;
+  return Perform(io_uring, operation);
+}
+
+[[noreturn]] void ThrowSystemError(int result, std::string_view what) {
+  throw std::system_error(std::error_code(-result, std::system_category()),
+                          std::string{what});
+}
+
+}  // namespace
+
+engine::ev::IoUring* TryGetIoUring() noexcept {
+  return engine::current_task::GetEventThread().GetIoUring();
+}
+
+std::string ReadFileContents(engine::ev::IoUring& io_uring,
+                             const std::string& path) {
+  const int fd = OpenFile(io_uring, path, O_RDONLY);
+  if (fd < 0) {
+    throw std::runtime_error("Error opening '" + path + '\'');
+  }
+  const utils::FastScopeGuard close_guard([fd]() noexcept { ::close(fd); });
+
+  std::string contents;
+  std::size_t size = 0;
+  for (;;) {
+    if (contents.size() - size < kReadChunkSize) {
+      contents.resize(std::max(contents.size() * 2, size + kReadChunkSize));
+    }
+
+    engine::ev::IoUringOperation operation;
+    operation.opcode = engine::ev::IoUringOpcode::kRead;
+    operation.fd = fd;
+    operation.buf = contents.data() + size;
+    operation.len = contents.size() - size;
+    operation.offset = size;
+    const auto result = Perform(io_uring, operation);
+    if (result < 0) {
+      if (result == -EINTR || result == -EAGAIN) continue;
+      ThrowSystemError(result, fmt::format("reading file '{}'", path));
+    }
+    if (result == 0) break;
+    size += result;
+  }
+  contents.resize(size);
+  return contents;
+}
+
+void RewriteFileContents(engine::ev::IoUring& io_uring,
+                         const std::string& path, std::string_view contents) {
+  const int fd = OpenFile(io_uring, path, O_WRONLY | O_CREAT | O_TRUNC);
+  if (fd < 0) {
+    ThrowSystemError(fd, fmt::format("opening file '{}'", path));
+  }
+  const utils::FastScopeGuard close_guard([fd]() noexcept { ::close(fd); });
+
+  std::size_t offset = 0;
+  while (offset < contents.size()) {
+    engine::ev::IoUringOperation operation;
+    operation.opcode = engine::ev::IoUringOpcode::kWrite;
+    operation.fd = fd;
+    operation.buf = contents.data() + offset;
+    operation.len = contents.size() - offset;
+    operation.offset = offset;
+    const auto result = Perform(io_uring, operation);
+    if (result < 0) {
+      if (result == -EINTR || result == -EAGAIN) continue;
+      ThrowSystemError(result, fmt::format("writing file '{}'", path));
+    }
+    offset += result;
+  }
+}
+
+}  // namespace fs::impl
+
+USERVER_NAMESPACE_END
@@ -0,0 +1,25 @@
+#pragma once
+
+#include <string>
+#include <string_view>
+
+#include <engine/ev/io_uring.hpp>
+
+USERVER_NAMESPACE_BEGIN
+
+namespace fs::impl {
+
+/// Returns nullptr if the ev thread of the current task does not use io_uring
+engine::ev::IoUring* TryGetIoUring() noexcept;
+
+/// Reads the file via io_uring without blocking the current task processor
+std::string ReadFileContents(engine::ev::IoUring& io_uring,
+                             const std::string& path);
+
+/// Rewrites the file via io_uring without blocking the current task processor
+void RewriteFileContents(engine::ev::IoUring& io_uring,
+                         const std::string& path, std::string_view contents);
+
+}  // namespace fs::impl
+
+USERVER_NAMESPACE_END
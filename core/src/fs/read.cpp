@@ -6,6 +6,8 @@
 #include <userver/fs/blocking/read.hpp>
 #include <userver/utils/async.hpp>
 
+#include <fs/io_uring_file.hpp>
+
 USERVER_NAMESPACE_BEGIN
 
 namespace fs {
@@ -29,6 +31,9 @@ std::string GetLexicallyRelative(std::string_view path, std::string_view dir) {
 
 std::string ReadFileContents(engine::TaskProcessor& async_tp,
                              const std::string& path) {
+  if (auto* io_uring = impl::TryGetIoUring()) {
+    return impl::ReadFileContents(*io_uring, path);
+  }
   return engine::AsyncNoSpan(async_tp, &fs::blocking::ReadFileContents, path)
       .Get();
 }
@@ -188,6 +188,41 @@ properties:
                         type: integer
                         description: delay in microseconds of the start of abort check routine
                         defaultDescription: 20ms
+                    pipelining_batch_delay:
+                        type: string
+                        description: how long a ready response to a pipelined request waits for the responses to the next requests to send them with a single write; 0 disables the batching
+                        defaultDescription: 0
+                    http2:
+                        type: object
+                        description: HTTP/2 options
+                        additionalProperties: false
+                        properties:
+                            enabled:
+                                type: boolean
+                                description: accept HTTP/2 connections, negotiated via TLS ALPN or cleartext ones with prior knowledge
+                                defaultDescription: false
+                            max_concurrent_streams:
+                                type: integer
+                                description: max number of concurrently processed streams of a connection
+                                defaultDescription: 100
+                                minimum: 1
+                            initial_window_size:
+                                type: integer
+                                description: initial flow control window size of a stream in bytes
+                                defaultDescription: 65535
+                                maximum: 2147483647
+                            connection_window_size:
+                                type: integer
+                                description: flow control window size of the whole connection in bytes
+                                defaultDescription: 1048576
+                                minimum: 65535
+                                maximum: 2147483647
+                            max_frame_size:
+                                type: integer
+                                description: max payload size of a received frame in bytes
+                                defaultDescription: 16384
+                                minimum: 16384
+                                maximum: 16777215
             shards:
                 type: integer
                 description: how many concurrent tasks harvest data from a single socket; do not set if not sure what it is doing
@@ -1,13 +1,18 @@
 #include <userver/server/handlers/server_monitor.hpp>
 
+#include <functional>
+#include <mutex>
+
 #include <userver/components/component.hpp>
 #include <userver/components/statistics_storage.hpp>
+#include <userver/engine/mutex.hpp>
 #include <userver/formats/json/serialize.hpp>
 #include <userver/server/handlers/exceptions.hpp>
 #include <userver/utils/statistics/graphite.hpp>
 #include <userver/utils/statistics/json.hpp>
 #include <userver/utils/statistics/pretty_format.hpp>
 #include <userver/utils/statistics/prometheus.hpp>
+#include <userver/utils/statistics/scrape_cache.hpp>
 #include <userver/utils/statistics/solomon.hpp>
 #include <userver/utils/statistics/storage.hpp>
 #include <userver/utils/trivial_map.hpp>
@@ -30,9 +35,35 @@ enum class impl::StatsFormat {
   kSolomon,
 };
 
+struct impl::ScrapeCaches final {
+  struct Cache final {
+    engine::Mutex mutex;
+    utils::statistics::ScrapeCache cache;
+  };
+
+  Cache prometheus;
+  Cache prometheus_untyped;
+  Cache solomon;
+};
+
 namespace {
 
 using impl::StatsFormat;
+using CachedFormatter =
+    std::function<std::string(utils::statistics::ScrapeCache*)>;
+
+// Concurrent scrapes do not wait for each other, the ones that could not take
+// the cache format metrics from scratch
+std::string FormatMaybeCached(impl::ScrapeCaches::Cache* cache,
+                              const CachedFormatter& formatter) {
+  if (cache) {
+    std::unique_lock lock(cache->mutex, std::try_to_lock);
+    if (lock.owns_lock()) {
+      return formatter(&cache->cache);
+    }
+  }
+  return formatter(nullptr);
+}
 
 std::optional<StatsFormat> ParseFormat(std::string_view format) {
   if (format.empty()) return {};
@@ -68,7 +99,12 @@ ServerMonitor::ServerMonitor(
           component_context.FindComponent<components::StatisticsStorage>()
               .GetStorage()),
       common_labels_{config["common-labels"].As<CommonLabels>({})},
-      default_format_{ParseFormat(config["format"].As<std::string>({}))} {}
+      default_format_{ParseFormat(config["format"].As<std::string>({}))},
+      scrape_caches_{config["scrape-cache"].As<bool>(false)
+                         ? std::make_unique<impl::ScrapeCaches>()
+                         : nullptr} {}
+
+ServerMonitor::~ServerMonitor() = default;
 
 std::string ServerMonitor::HandleRequestThrow(const http::HttpRequest& request,
                                               request::RequestContext&) const {
@@ -107,6 +143,11 @@ std::string ServerMonitor::HandleRequestThrow(const http::HttpRequest& request,
                     : Request::MakeWithPath(path, std::move(common_labels),
                                             std::move(labels)));
 
+  // Filtered requests would evict the cached metrics of a full scrape
+  auto* const caches = (path.empty() && prefix.empty() && labels_json.empty()
+                            ? scrape_caches_.get()
+                            : nullptr);
+
   request.GetHttpResponse().SetContentType("text/plain; charset=utf-8");
   switch (format) {
     case StatsFormat::kGraphite:
@@ -114,12 +155,24 @@ std::string ServerMonitor::HandleRequestThrow(const http::HttpRequest& request,
                                                  statistics_request);
 
     case StatsFormat::kPrometheus:
-      return utils::statistics::ToPrometheusFormat(statistics_storage_,
-                                                   statistics_request);
+      return FormatMaybeCached(
+          caches ? &caches->prometheus : nullptr,
+          [&](utils::statistics::ScrapeCache* cache) {
+            return cache ? utils::statistics::ToPrometheusFormat(
+                               statistics_storage_, *cache, statistics_request)
+                         : utils::statistics::ToPrometheusFormat(
+                               statistics_storage_, statistics_request);
+          });
 
     case StatsFormat::kPrometheusUntyped:
-      return utils::statistics::ToPrometheusFormatUntyped(statistics_storage_,
-                                                          statistics_request);
+      return FormatMaybeCached(
+          caches ? &caches->prometheus_untyped : nullptr,
+          [&](utils::statistics::ScrapeCache* cache) {
+            return cache ? utils::statistics::ToPrometheusFormatUntyped(
+                               statistics_storage_, *cache, statistics_request)
+                         : utils::statistics::ToPrometheusFormatUntyped(
+                               statistics_storage_, statistics_request);
+          });
 
     case StatsFormat::kJson:
       request.GetHttpResponse().SetContentType("application/json");
@@ -132,8 +185,16 @@ std::string ServerMonitor::HandleRequestThrow(const http::HttpRequest& request,
 
     case StatsFormat::kSolomon:
       request.GetHttpResponse().SetContentType("application/json");
-      return utils::statistics::ToSolomonFormat(
-          statistics_storage_, common_labels_, statistics_request);
+      return FormatMaybeCached(
+          caches ? &caches->solomon : nullptr,
+          [&](utils::statistics::ScrapeCache* cache) {
+            return cache ? utils::statistics::ToSolomonFormat(
+                               statistics_storage_, common_labels_, *cache,
+                               statistics_request)
+                         : utils::statistics::ToSolomonFormat(
+                               statistics_storage_, common_labels_,
+                               statistics_request);
+          });
 
     case StatsFormat::kInternal:
       request.GetHttpResponse().SetContentType("application/json");
@@ -176,6 +237,12 @@ properties:
           - pretty
           - solomon
           - internal
+    scrape-cache:
+        type: boolean
+        description: |
+            Reuse the serialized metrics that did not change since the previous
+            scrape for prometheus, prometheus-untyped and solomon formats
+        defaultDescription: false
   )");
 }
 
@@ -0,0 +1,655 @@
+#include "http2_session.hpp"
+
+#include <algorithm>
+#include <cstring>
+#include <mutex>
+#include <optional>
+#include <string>
+#include <unordered_map>
+
+#include <fmt/format.h>
+#include <nghttp2/nghttp2.h>
+
+#include <userver/concurrent/variable.hpp>
+#include <userver/engine/single_consumer_event.hpp>
+#include <userver/http/common_headers.hpp>
+#include <userver/logging/log.hpp>
+#include <userver/server/http/http_method.hpp>
+#include <userver/utils/assert.hpp>
+
+#include "http_request_constructor.hpp"
+
+USERVER_NAMESPACE_BEGIN
+
+namespace server::http {
+
+namespace {
+
+constexpr std::string_view kClientPreface{NGHTTP2_CLIENT_MAGIC,
+                                          NGHTTP2_CLIENT_MAGIC_LEN};
+
+// Frames are coalesced up to this size to save on syscalls (and TLS records)
+constexpr std::size_t kMaxOutputChunkSize = 64 * 1024;
+
+// Response body bytes of a stream that may wait for DATA frames. The frames
+// are encoded only while the peer's stream and connection windows are open,
+// so the body writer stops at this limit until the peer reads the data.
+constexpr std::size_t kMaxBufferedBodySize = 64 * 1024;
+
+constexpr std::string_view kCookieSeparator = "; ";
+
+std::string_view AsStringView(const std::uint8_t* data, std::size_t size) {
+  return {reinterpret_cast<const char*>(data), size};
+}
+
+nghttp2_nv MakeNv(std::string_view name, std::string_view value) {
+  // nghttp2 copies the header fields on submission
+  // NOLINTBEGIN(cppcoreguidelines-pro-type-const-cast)
+  return {const_cast<std::uint8_t*>(
+              reinterpret_cast<const std::uint8_t*>(name.data())),
+          const_cast<std::uint8_t*>(
+              reinterpret_cast<const std::uint8_t*>(value.data())),
+          name.size(), value.size(), NGHTTP2_NV_FLAG_NONE};
+  // NOLINTEND(cppcoreguidelines-pro-type-const-cast)
+}
+
+using StreamId = Http2Session::StreamId;
+
+// Wakes up the connection task when the request tasks write responses
+class OutputNotifier final {
+ public:
+  void Notify(StreamId stream_id) {
+    auto data = data_.Lock();
+    data->updated_streams.push_back(stream_id);
+    if (data->promise) {
+      data->promise->set_value();
+      data->promise.reset();
+    }
+  }
+
+  engine::Future<void> GetFuture() {
+    engine::Promise<void> promise;
+    auto future = promise.get_future();
+
+    auto data = data_.Lock();
+    if (!data->updated_streams.empty()) {
+      promise.set_value();
+    } else {
+      data->promise.emplace(std::move(promise));
+    }
+    return future;
+  }
+
+  std::vector<StreamId> ExtractUpdatedStreams() {
+    std::vector<StreamId> result;
+    auto data = data_.Lock();
+    std::swap(result, data->updated_streams);
+    return result;
+  }
+
+ private:
+  struct Data {
+    std::vector<StreamId> updated_streams;
+    std::optional<engine::Promise<void>> promise;
+  };
+
+  concurrent::Variable<Data, std::mutex> data_;
+};
+
+struct InputStream final {
+  std::optional<HttpRequestConstructor> constructor;
+  HttpMethod method{HttpMethod::kUnknown};
+  std::string path;
+  std::string authority;
+  std::string cookie;
+  bool has_host{false};
+  bool is_url_complete{false};
+  bool are_headers_complete{false};
+  bool is_failed{false};
+};
+
+}  // namespace
+
+class Http2OutputStream final : public impl::Http2StreamWriter {
+ public:
+  Http2OutputStream(StreamId stream_id,
+                    std::shared_ptr<OutputNotifier> notifier)
+      : stream_id_(stream_id), notifier_(std::move(notifier)) {}
+
+  void WriteHeaders(HttpStatus status, Headers&& headers,
+                    bool end_stream) override {
+    {
+      auto data = data_.Lock();
+      if (data->is_closed) return;
+      UASSERT(!data->status);
+      data->status = status;
+      data->headers = std::move(headers);
+      data->is_complete = end_stream;
+    }
+    notifier_->Notify(stream_id_);
+  }
+
+  void WriteData(std::string_view body, bool end_stream) override {
+    {
+      auto data = data_.Lock();
+      if (data->is_closed) return;
+      UASSERT(data->status);
+      UASSERT(!data->is_complete);
+      data->body.append(body);
+      data->is_complete = end_stream;
+    }
+    notifier_->Notify(stream_id_);
+
+    // Nothing more is going to be pulled from the body producer after the
+    // last chunk, the response is kept alive until it is sent anyway
+    if (!end_stream) WaitForBufferedBody();
+  }
+
+  // Returns false if the headers are not written yet or already submitted
+  bool TrySubmitHeaders(nghttp2_session* session) {
+    auto data = data_.Lock();
+    if (!data->status || data->are_headers_submitted) return false;
+    data->are_headers_submitted = true;
+
+    const auto status = fmt::format("{}", static_cast<int>(*data->status));
+    std::vector<nghttp2_nv> nva;
+    nva.reserve(data->headers.size() + 1);
+    nva.push_back(MakeNv(":status", status));
+    for (const auto& [name, value] : data->headers) {
+      nva.push_back(MakeNv(name, value));
+    }
+
+    nghttp2_data_provider data_provider{};
+    data_provider.source.ptr = this;
+    data_provider.read_callback = &Http2OutputStream::Read;
+    const bool has_body = !data->is_complete || !data->body.empty();
+
+    const auto result =
+        nghttp2_submit_response(session, stream_id_, nva.data(), nva.size(),
+                                has_body ? &data_provider : nullptr);
+    if (result != 0) {
+      LOG_WARNING() << "Failed to submit HTTP/2 response for stream "
+                    << stream_id_ << ": " << nghttp2_strerror(result);
+    }
+    data->headers.clear();
+    return true;
+  }
+
+  void Close() {
+    {
+      auto data = data_.Lock();
+      data->is_closed = true;
+    }
+    body_sent_event_.Send();
+  }
+
+ private:
+  // Waits for the peer to accept the buffered body, so that a slow reader
+  // does not make the whole streamed body pile up in memory
+  void WaitForBufferedBody() {
+    while (true) {
+      {
+        auto data = data_.Lock();
+        if (data->is_closed ||
+            data->body.size() - data->body_offset < kMaxBufferedBodySize) {
+          return;
+        }
+      }
+      if (!body_sent_event_.WaitForEvent()) return;
+    }
+  }
+
+  static ssize_t Read(nghttp2_session*, StreamId, std::uint8_t* buf,
+                      std::size_t length, std::uint32_t* data_flags,
+                      nghttp2_data_source* source, void*) noexcept {
+    auto* self = static_cast<Http2OutputStream*>(source->ptr);
+    UASSERT(self);
+    auto data = self->data_.Lock();
+
+    const auto size = std::min(length, data->body.size() - data->body_offset);
+    std::memcpy(buf, data->body.data() + data->body_offset, size);
+    data->body_offset += size;
+    if (size != 0 &&
+        data->body.size() - data->body_offset < kMaxBufferedBodySize) {
+      self->body_sent_event_.Send();
+    }
+
+    if (data->body_offset == data->body.size()) {
+      data->body.clear();
+      data->body_offset = 0;
+      if (data->is_complete) {
+        *data_flags |= NGHTTP2_DATA_FLAG_EOF;
+      } else if (size == 0) {
+        // Resumed by Http2Session::GetPendingOutput on the next WriteData
+        return NGHTTP2_ERR_DEFERRED;
+      }
+    }
+    return static_cast<ssize_t>(size);
+  }
+
+  struct Data {
+    std::optional<HttpStatus> status;
+    Headers headers;
+    std::string body;
+    std::size_t body_offset{0};
+    bool is_complete{false};
+    bool are_headers_submitted{false};
+    bool is_closed{false};
+  };
+
+  const StreamId stream_id_;
+  const std::shared_ptr<OutputNotifier> notifier_;
+  concurrent::Variable<Data, std::mutex> data_;
+  engine::SingleConsumerEvent body_sent_event_;
+};
+
+struct Http2Session::Impl final {
+  Impl(const net::Http2Config& config,
+       const HandlerInfoIndex& handler_info_index,
+       const request::HttpRequestConfig& request_config,
+       OnNewRequestCb&& on_new_request_cb, net::ParserStats& stats,
+       request::ResponseDataAccounter& data_accounter);
+  ~Impl();
+
+  static int OnBeginHeaders(nghttp2_session* session,
+                            const nghttp2_frame* frame, void* user_data);
+  static int OnHeader(nghttp2_session* session, const nghttp2_frame* frame,
+                      const std::uint8_t* name, std::size_t name_size,
+                      const std::uint8_t* value, std::size_t value_size,
+                      std::uint8_t flags, void* user_data);
+  static int OnFrameRecv(nghttp2_session* session, const nghttp2_frame* frame,
+                         void* user_data);
+  static int OnDataChunkRecv(nghttp2_session* session, std::uint8_t flags,
+                             StreamId stream_id, const std::uint8_t* data,
+                             std::size_t size, void* user_data);
+  static int OnStreamClose(nghttp2_session* session, StreamId stream_id,
+                           std::uint32_t error_code, void* user_data);
+
+  void OnBeginHeadersImpl(StreamId stream_id);
+  void OnHeaderImpl(StreamId stream_id, std::string_view name,
+                    std::string_view value);
+  void OnHeadersCompleteImpl(StreamId stream_id);
+  void OnDataChunkRecvImpl(StreamId stream_id, std::string_view data);
+  void OnStreamCloseImpl(StreamId stream_id);
+
+  InputStream* FindInputStream(StreamId stream_id);
+  void CompleteUrl(InputStream& stream);
+  void FinalizeRequest(StreamId stream_id);
+
+  const net::Http2Config config;
+  const HandlerInfoIndex& handler_info_index;
+  const HttpRequestConstructor::Config request_constructor_config;
+  OnNewRequestCb on_new_request_cb;
+  net::ParserStats& stats;
+  request::ResponseDataAccounter& data_accounter;
+
+  nghttp2_session* session{nullptr};
+  const std::shared_ptr<OutputNotifier> notifier;
+
+  std::unordered_map<StreamId, InputStream> input_streams;
+  std::unordered_map<StreamId, std::shared_ptr<Http2OutputStream>>
+      output_streams;
+  std::vector<StreamId> closed_streams;
+  std::string output;
+};
+
+Http2Session::Impl::Impl(const net::Http2Config& config,
+                         const HandlerInfoIndex& handler_info_index,
+                         const request::HttpRequestConfig& request_config,
+                         OnNewRequestCb&& on_new_request_cb,
+                         net::ParserStats& stats,
+                         request::ResponseDataAccounter& data_accounter)
+    : config(config),
+      handler_info_index(handler_info_index),
+      request_constructor_config{request_config},
+      on_new_request_cb(std::move(on_new_request_cb)),
+      stats(stats),
+      data_accounter(data_accounter),
+      notifier(std::make_shared<OutputNotifier>()) {
+  nghttp2_session_callbacks* callbacks = nullptr;
+  if (nghttp2_session_callbacks_new(&callbacks) != 0) {
+    throw std::bad_alloc();
+  }
+  nghttp2_session_callbacks_set_on_begin_headers_callback(
+      callbacks, &Impl::OnBeginHeaders);
+  nghttp2_session_callbacks_set_on_header_callback(callbacks, &Impl::OnHeader);
+  nghttp2_session_callbacks_set_on_frame_recv_callback(callbacks,
+                                                       &Impl::OnFrameRecv);
+  nghttp2_session_callbacks_set_on_data_chunk_recv_callback(
+      callbacks, &Impl::OnDataChunkRecv);
+  nghttp2_session_callbacks_set_on_stream_close_callback(callbacks,
+                                                         &Impl::OnStreamClose);
+
+  const auto result = nghttp2_session_server_new(&session, callbacks, this);
+  nghttp2_session_callbacks_del(callbacks);
+  if (result != 0) {
+    throw std::runtime_error(fmt::format(
+        "Failed to create HTTP/2 session: {}", nghttp2_strerror(result)));
+  }
+
+  const nghttp2_settings_entry settings[] = {
+      {NGHTTP2_SETTINGS_MAX_CONCURRENT_STREAMS, config.max_concurrent_streams},
+      {NGHTTP2_SETTINGS_INITIAL_WINDOW_SIZE, config.initial_window_size},
+      {NGHTTP2_SETTINGS_MAX_FRAME_SIZE, config.max_frame_size},
+  };
+  nghttp2_submit_settings(session, NGHTTP2_FLAG_NONE, settings,
+                          std::size(settings));
+  // Connection-level window is not a setting, it is announced by a
+  // WINDOW_UPDATE of stream 0
+  nghttp2_session_set_local_window_size(
+      session, NGHTTP2_FLAG_NONE, 0,
+      static_cast<std::int32_t>(config.connection_window_size));
+}
+
+Http2Session::Impl::~Impl() {
+  for (auto& [stream_id, stream] : output_streams) stream->Close();
+  stats.parsing_request_count.Subtract(input_streams.size());
+  nghttp2_session_del(session);
+}
+
+int Http2Session::Impl::OnBeginHeaders(nghttp2_session*,
+                                       const nghttp2_frame* frame,
+                                       void* user_data) {
+  if (frame->hd.type != NGHTTP2_HEADERS ||
+      frame->headers.cat != NGHTTP2_HCAT_REQUEST) {
+    return 0;
+  }
+  auto* impl = static_cast<Impl*>(user_data);
+  UASSERT(impl != nullptr);
+  impl->OnBeginHeadersImpl(frame->hd.stream_id);
+  return 0;
+}
+
+int Http2Session::Impl::OnHeader(nghttp2_session*, const nghttp2_frame* frame,
+                                 const std::uint8_t* name,
+                                 std::size_t name_size,
+                                 const std::uint8_t* value,
+                                 std::size_t value_size, std::uint8_t,
+                                 void* user_data) {
+  auto* impl = static_cast<Impl*>(user_data);
+  UASSERT(impl != nullptr);
+  impl->OnHeaderImpl(frame->hd.stream_id, AsStringView(name, name_size),
+                     AsStringView(value, value_size));
+  return 0;
+}
+
+int Http2Session::Impl::OnFrameRecv(nghttp2_session*,
+                                    const nghttp2_frame* frame,
+                                    void* user_data) {
+  auto* impl = static_cast<Impl*>(user_data);
+  UASSERT(impl != nullptr);
+  const auto stream_id = frame->hd.stream_id;
+
+  if (frame->hd.type == NGHTTP2_HEADERS &&
+      (frame->hd.flags & NGHTTP2_FLAG_END_HEADERS)) {
+    impl->OnHeadersCompleteImpl(stream_id);
+  }
+  if ((frame->hd.type == NGHTTP2_HEADERS || frame->hd.type == NGHTTP2_DATA) &&
+      (frame->hd.flags & NGHTTP2_FLAG_END_STREAM)) {
+    impl->FinalizeRequest(stream_id);
+  }
+  return 0;
+}
+
+int Http2Session::Impl::OnDataChunkRecv(nghttp2_session*, std::uint8_t,
+                                        StreamId stream_id,
+                                        const std::uint8_t* data,
+                                        std::size_t size, void* user_data) {
+  auto* impl = static_cast<Impl*>(user_data);
+  UASSERT(impl != nullptr);
+  impl->OnDataChunkRecvImpl(stream_id, AsStringView(data, size));
+  return 0;
+}
+
+int Http2Session::Impl::OnStreamClose(nghttp2_session*, StreamId stream_id,
+                                      std::uint32_t, void* user_data) {
+  auto* impl = static_cast<Impl*>(user_data);
+  UASSERT(impl != nullptr);
+  impl->OnStreamCloseImpl(stream_id);
+  return 0;
+}
+
+void Http2Session::Impl::OnBeginHeadersImpl(StreamId stream_id) {
+  // The peer may exceed the limit before it acknowledges our SETTINGS
+  if (input_streams.size() + output_streams.size() >=
+      config.max_concurrent_streams) {
+    LOG_LIMITED_WARNING() << "Refusing HTTP/2 stream " << stream_id
+                          << ": too many concurrent streams";
+    nghttp2_submit_rst_stream(session, NGHTTP2_FLAG_NONE, stream_id,
+                              NGHTTP2_REFUSED_STREAM);
+    return;
+  }
+
+  LOG_TRACE() << "HTTP/2 stream " << stream_id << " begin";
+  stats.parsing_request_count.Add(1);
+  auto& stream = input_streams[stream_id];
+  stream.constructor.emplace(request_constructor_config, handler_info_index,
+                             data_accounter);
+}
+
+void Http2Session::Impl::OnHeaderImpl(StreamId stream_id, std::string_view name,
+                                      std::string_view value) {
+  auto* stream = FindInputStream(stream_id);
+  // Trailers are ignored, as in HTTP/1.1
+  if (!stream || stream->are_headers_complete) return;
+
+  LOG_TRACE() << "HTTP/2 stream " << stream_id << " header '" << name
+              << "': '" << value << '\'';
+  try {
+    // nghttp2 guarantees that pseudo-headers go first
+    if (!name.empty() && name.front() == ':') {
+      if (name == ":method") {
+        stream->method = HttpMethodFromString(value);
+      } else if (name == ":path") {
+        stream->path = value;
+      } else if (name == ":authority") {
+        stream->authority = value;
+      }
+      return;
+    }
+
+    CompleteUrl(*stream);
+
+    // RFC 9113 section 8.2.3 allows splitting the cookie into several fields
+    if (name == "cookie") {
+      if (!stream->cookie.empty()) stream->cookie.append(kCookieSeparator);
+      stream->cookie.append(value);
+      return;
+    }
+    if (name == "host") stream->has_host = true;
+
+    stream->constructor->AppendHeaderField(name.data(), name.size());
+    stream->constructor->AppendHeaderValue(value.data(), value.size());
+  } catch (const std::exception& ex) {
+    LOG_WARNING() << "can't append header: " << ex;
+    stream->is_failed = true;
+  }
+}
+
+void Http2Session::Impl::OnHeadersCompleteImpl(StreamId stream_id) {
+  auto* stream = FindInputStream(stream_id);
+  if (!stream || stream->are_headers_complete) return;
+  stream->are_headers_complete = true;
+
+  try {
+    CompleteUrl(*stream);
+
+    auto& constructor = *stream->constructor;
+    if (!stream->cookie.empty()) {
+      const std::string_view name = USERVER_NAMESPACE::http::headers::kCookie;
+      constructor.AppendHeaderField(name.data(), name.size());
+      constructor.AppendHeaderValue(stream->cookie.data(),
+                                    stream->cookie.size());
+    }
+    if (!stream->has_host && !stream->authority.empty()) {
+      const std::string_view name = USERVER_NAMESPACE::http::headers::kHost;
+      constructor.AppendHeaderField(name.data(), name.size());
+      constructor.AppendHeaderValue(stream->authority.data(),
+                                    stream->authority.size());
+    }
+    constructor.AppendHeaderField("", 0);
+  } catch (const std::exception& ex) {
+    LOG_WARNING() << "can't append header: " << ex;
+    stream->is_failed = true;
+  }
+  LOG_TRACE() << "HTTP/2 stream " << stream_id << " headers complete";
+}
+
+void Http2Session::Impl::OnDataChunkRecvImpl(StreamId stream_id,
+                                             std::string_view data) {
+  auto* stream = FindInputStream(stream_id);
+  if (!stream) return;
+
+  try {
+    stream->constructor->AppendBody(data.data(), data.size());
+  } catch (const std::exception& ex) {
+    LOG_WARNING() << "can't append body: " << ex;
+    stream->is_failed = true;
+  }
+}
+
+void Http2Session::Impl::OnStreamCloseImpl(StreamId stream_id) {
+  LOG_TRACE() << "HTTP/2 stream " << stream_id << " closed";
+
+  if (input_streams.erase(stream_id)) {
+    stats.parsing_request_count.Subtract(1);
+  }
+
+  const auto it = output_streams.find(stream_id);
+  if (it != output_streams.end()) {
+    it->second->Close();
+    output_streams.erase(it);
+    closed_streams.push_back(stream_id);
+  }
+}
+
+InputStream* Http2Session::Impl::FindInputStream(StreamId stream_id) {
+  const auto it = input_streams.find(stream_id);
+  if (it == input_streams.end()) return nullptr;
+  if (it->second.is_failed) return nullptr;
+  return &it->second;
+}
+
+void Http2Session::Impl::CompleteUrl(InputStream& stream) {
+  if (stream.is_url_complete) return;
+  stream.is_url_complete = true;
+
+  auto& constructor = *stream.constructor;
+  constructor.SetMethod(stream.method);
+  constructor.SetHttpMajor(2);
+  constructor.SetHttpMinor(0);
+  constructor.AppendUrl(stream.path.data(), stream.path.size());
+  constructor.ParseUrl();
+}
+
+void Http2Session::Impl::FinalizeRequest(StreamId stream_id) {
+  const auto it = input_streams.find(stream_id);
+  if (it == input_streams.end()) return;
+
+  auto& constructor = *it->second.constructor;
+  constructor.SetIsFinal(false);
+  auto request = constructor.Finalize();
+  input_streams.erase(it);
+  stats.parsing_request_count.Subtract(1);
+
+  if (!request) {
+    LOG_ERROR() << "request is null after Finalize()";
+    nghttp2_submit_rst_stream(session, NGHTTP2_FLAG_NONE, stream_id,
+                              NGHTTP2_INTERNAL_ERROR);
+    return;
+  }
+
+  output_streams.emplace(
+      stream_id, std::make_shared<Http2OutputStream>(stream_id, notifier));
+  on_new_request_cb(stream_id, std::move(request));
+}
+
+Http2Session::Http2Session(const net::Http2Config& config,
+                           const HandlerInfoIndex& handler_info_index,
+                           const request::HttpRequestConfig& request_config,
+                           OnNewRequestCb&& on_new_request_cb,
+                           net::ParserStats& stats,
+                           request::ResponseDataAccounter& data_accounter)
+    : impl_(std::make_unique<Impl>(config, handler_info_index, request_config,
+                                   std::move(on_new_request_cb), stats,
+                                   data_accounter)) {}
+
+Http2Session::~Http2Session() = default;
+
+bool Http2Session::IsClientPreface(const char* data, std::size_t size) {
+  // "PRI " is not a valid HTTP/1.1 request anyway
+  static constexpr std::size_t kMinPrefixSize = 4;
+  if (size < kMinPrefixSize) return false;
+
+  const auto prefix_size = std::min(size, kClientPreface.size());
+  return std::string_view{data, prefix_size} ==
+         kClientPreface.substr(0, prefix_size);
+}
+
+bool Http2Session::Parse(const char* data, std::size_t size) {
+  const auto result = nghttp2_session_mem_recv(
+      impl_->session, reinterpret_cast<const std::uint8_t*>(data), size);
+  if (result < 0) {
+    LOG_WARNING() << "HTTP/2 session error: "
+                  << nghttp2_strerror(static_cast<int>(result));
+    nghttp2_session_terminate_session(impl_->session, NGHTTP2_PROTOCOL_ERROR);
+    return false;
+  }
+  return true;
+}
+
+std::shared_ptr<impl::Http2StreamWriter> Http2Session::GetStreamWriter(
+    StreamId stream_id) {
+  const auto it = impl_->output_streams.find(stream_id);
+  UASSERT(it != impl_->output_streams.end());
+  return it->second;
+}
+
+std::string_view Http2Session::GetPendingOutput() {
+  for (const auto stream_id : impl_->notifier->ExtractUpdatedStreams()) {
+    const auto it = impl_->output_streams.find(stream_id);
+    if (it == impl_->output_streams.end()) continue;
+
+    if (!it->second->TrySubmitHeaders(impl_->session)) {
+      // Fails harmlessly if the stream is not deferred
+      nghttp2_session_resume_data(impl_->session, stream_id);
+    }
+  }
+
+  impl_->output.clear();
+  while (impl_->output.size() < kMaxOutputChunkSize) {
+    const std::uint8_t* data = nullptr;
+    const auto size = nghttp2_session_mem_send(impl_->session, &data);
+    if (size < 0) {
+      throw std::runtime_error(
+          fmt::format("Failed to encode HTTP/2 frames: {}",
+                      nghttp2_strerror(static_cast<int>(size))));
+    }
+    if (size == 0) break;
+    impl_->output.append(AsStringView(data, size));
+  }
+  return impl_->output;
+}
+
+engine::Future<void> Http2Session::GetStreamOutputFuture() {
+  return impl_->notifier->GetFuture();
+}
+
+std::vector<Http2Session::StreamId> Http2Session::ExtractClosedStreams() {
+  std::vector<StreamId> result;
+  std::swap(result, impl_->closed_streams);
+  return result;
+}
+
+void Http2Session::Terminate() {
+  nghttp2_session_terminate_session(impl_->session, NGHTTP2_NO_ERROR);
+}
+
+bool Http2Session::IsAlive() const {
+  return nghttp2_session_want_read(impl_->session) ||
+         nghttp2_session_want_write(impl_->session);
+}
+
+}  // namespace server::http
+
+USERVER_NAMESPACE_END
@@ -0,0 +1,87 @@
+#pragma once
+
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <string_view>
+#include <vector>
+
+#include <userver/engine/future.hpp>
+#include <userver/server/request/request_base.hpp>
+#include <userver/server/request/request_config.hpp>
+
+#include <server/net/connection_config.hpp>
+#include <server/net/stats.hpp>
+
+#include "handler_info_index.hpp"
+#include "http2_stream_writer.hpp"
+
+USERVER_NAMESPACE_BEGIN
+
+namespace server::http {
+
+/// @brief Server side of an HTTP/2 connection.
+///
+/// Frames are decoded and encoded by nghttp2. HPACK-decoded header fields of
+/// each stream are fed into a separate HttpRequestConstructor, so requests
+/// are indistinguishable from the HTTP/1.1 ones for the handlers.
+///
+/// The session does no I/O by itself: the connection feeds the received bytes
+/// into Parse() and writes out whatever GetPendingOutput() returns. All the
+/// methods must be called from the connection task, the stream writers may be
+/// used from any task.
+class Http2Session final {
+ public:
+  using StreamId = std::int32_t;
+  using OnNewRequestCb =
+      std::function<void(StreamId, std::shared_ptr<request::RequestBase>&&)>;
+
+  Http2Session(const net::Http2Config& config,
+               const HandlerInfoIndex& handler_info_index,
+               const request::HttpRequestConfig& request_config,
+               OnNewRequestCb&& on_new_request_cb, net::ParserStats& stats,
+               request::ResponseDataAccounter& data_accounter);
+  ~Http2Session();
+
+  Http2Session(Http2Session&&) = delete;
+  Http2Session& operator=(Http2Session&&) = delete;
+
+  /// Checks whether the data starts with the HTTP/2 client connection preface
+  static bool IsClientPreface(const char* data, std::size_t size);
+
+  /// @brief Feeds the received bytes into the session.
+  /// @returns false on a connection error, the session is terminated then and
+  /// only the pending output has to be written
+  bool Parse(const char* data, std::size_t size);
+
+  /// Returns the response writer of a stream reported via OnNewRequestCb
+  std::shared_ptr<impl::Http2StreamWriter> GetStreamWriter(StreamId stream_id);
+
+  /// @brief Encodes the frames to be sent, including the ones of the responses
+  /// written since the last call.
+  /// @returns empty string_view if there is nothing to send; the data is
+  /// valid until the next call
+  std::string_view GetPendingOutput();
+
+  /// Returns a future that becomes ready once any of the stream writers gets
+  /// new data to be encoded by GetPendingOutput
+  engine::Future<void> GetStreamOutputFuture();
+
+  /// Returns the streams closed since the last call, e.g. reset by the peer
+  std::vector<StreamId> ExtractClosedStreams();
+
+  /// Starts a graceful shutdown by sending GOAWAY
+  void Terminate();
+
+  /// Whether there is anything to be received or sent
+  bool IsAlive() const;
+
+  struct Impl;
+
+ private:
+  std::unique_ptr<Impl> impl_;
+};
+
+}  // namespace server::http
+
+USERVER_NAMESPACE_END
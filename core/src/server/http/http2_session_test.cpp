@@ -0,0 +1,439 @@
+#include <server/http/http2_session.hpp>
+
+#include <algorithm>
+#include <cstring>
+#include <map>
+#include <string>
+#include <vector>
+
+#include <nghttp2/nghttp2.h>
+
+#include <server/http/http_request_impl.hpp>
+#include <userver/engine/async.hpp>
+#include <userver/engine/sleep.hpp>
+#include <userver/utest/utest.hpp>
+
+USERVER_NAMESPACE_BEGIN
+
+namespace {
+
+using StreamId = server::http::Http2Session::StreamId;
+using RequestPtr = std::shared_ptr<server::request::RequestBase>;
+
+constexpr server::request::HttpRequestConfig kTestRequestConfig{
+    /*.max_url_size = */ 8192,
+    /*.max_request_size = */ 1024 * 1024,
+    /*.max_headers_size = */ 65536,
+    /*.parse_args_from_body = */ false,
+    /*.testing_mode = */ true,  // non default value
+    /*.decompress_request = */ false,
+};
+
+nghttp2_nv MakeNv(const std::string& name, const std::string& value) {
+  // NOLINTBEGIN(cppcoreguidelines-pro-type-const-cast)
+  return {const_cast<std::uint8_t*>(
+              reinterpret_cast<const std::uint8_t*>(name.data())),
+          const_cast<std::uint8_t*>(
+              reinterpret_cast<const std::uint8_t*>(value.data())),
+          name.size(), value.size(), NGHTTP2_NV_FLAG_NONE};
+  // NOLINTEND(cppcoreguidelines-pro-type-const-cast)
+}
+
+std::string_view AsStringView(const std::uint8_t* data, std::size_t size) {
+  return {reinterpret_cast<const char*>(data), size};
+}
+
+server::http::HttpRequestImpl& AsHttpRequest(const RequestPtr& request) {
+  // NOLINTNEXTLINE(cppcoreguidelines-pro-type-static-cast-downcast)
+  return static_cast<server::http::HttpRequestImpl&>(*request);
+}
+
+// Minimal nghttp2 client to produce and consume the frames
+class TestClient final {
+ public:
+  struct Response {
+    std::map<std::string, std::string> headers;
+    std::string body;
+    bool is_complete{false};
+    std::uint32_t error_code{NGHTTP2_NO_ERROR};
+    std::size_t consumed_size{0};
+  };
+
+  // Without auto window update the received data is not acknowledged until
+  // ConsumeBody() is called, as if the client was slow to read it
+  explicit TestClient(bool auto_window_update = true) {
+    nghttp2_session_callbacks* callbacks = nullptr;
+    nghttp2_session_callbacks_new(&callbacks);
+    nghttp2_session_callbacks_set_on_header_callback(callbacks, &OnHeader);
+    nghttp2_session_callbacks_set_on_data_chunk_recv_callback(callbacks,
+                                                              &OnDataChunk);
+    nghttp2_session_callbacks_set_on_stream_close_callback(callbacks,
+                                                           &OnStreamClose);
+    nghttp2_option* option = nullptr;
+    nghttp2_option_new(&option);
+    nghttp2_option_set_no_auto_window_update(option, !auto_window_update);
+    nghttp2_session_client_new2(&session_, callbacks, this, option);
+    nghttp2_option_del(option);
+    nghttp2_session_callbacks_del(callbacks);
+    nghttp2_submit_settings(session_, NGHTTP2_FLAG_NONE, nullptr, 0);
+  }
+
+  ~TestClient() { nghttp2_session_del(session_); }
+
+  StreamId SubmitRequest(
+      const std::vector<std::pair<std::string, std::string>>& headers,
+      std::string body = {}) {
+    std::vector<nghttp2_nv> nva;
+    for (const auto& [name, value] : headers) {
+      nva.push_back(MakeNv(name, value));
+    }
+
+    request_body_ = std::move(body);
+    nghttp2_data_provider data_provider{};
+    data_provider.source.ptr = &request_body_;
+    data_provider.read_callback = &ReadBody;
+
+    return nghttp2_submit_request(
+        session_, nullptr, nva.data(), nva.size(),
+        request_body_.empty() ? nullptr : &data_provider, nullptr);
+  }
+
+  std::string GetOutput() {
+    std::string result;
+    const std::uint8_t* data = nullptr;
+    while (const auto size = nghttp2_session_mem_send(session_, &data)) {
+      result.append(AsStringView(data, size));
+    }
+    return result;
+  }
+
+  void Receive(std::string_view data) {
+    const auto result = nghttp2_session_mem_recv(
+        session_, reinterpret_cast<const std::uint8_t*>(data.data()),
+        data.size());
+    ASSERT_EQ(result, static_cast<ssize_t>(data.size()));
+  }
+
+  void ResetStream(StreamId stream_id) {
+    nghttp2_submit_rst_stream(session_, NGHTTP2_FLAG_NONE, stream_id,
+                              NGHTTP2_CANCEL);
+  }
+
+  // Opens the flow control windows for the data received so far
+  void ConsumeBody(StreamId stream_id) {
+    auto& response = responses_[stream_id];
+    nghttp2_session_consume(session_, stream_id,
+                            response.body.size() - response.consumed_size);
+    response.consumed_size = response.body.size();
+  }
+
+  Response& GetResponse(StreamId stream_id) { return responses_[stream_id]; }
+
+ private:
+  static int OnHeader(nghttp2_session*, const nghttp2_frame* frame,
+                      const std::uint8_t* name, std::size_t name_size,
+                      const std::uint8_t* value, std::size_t value_size,
+                      std::uint8_t, void* user_data) {
+    auto* self = static_cast<TestClient*>(user_data);
+    self->responses_[frame->hd.stream_id].headers.emplace(
+        AsStringView(name, name_size), AsStringView(value, value_size));
+    return 0;
+  }
+
+  static int OnDataChunk(nghttp2_session*, std::uint8_t, StreamId stream_id,
+                         const std::uint8_t* data, std::size_t size,
+                         void* user_data) {
+    auto* self = static_cast<TestClient*>(user_data);
+    self->responses_[stream_id].body.append(AsStringView(data, size));
+    return 0;
+  }
+
+  static int OnStreamClose(nghttp2_session*, StreamId stream_id,
+                           std::uint32_t error_code, void* user_data) {
+    auto* self = static_cast<TestClient*>(user_data);
+    auto& response = self->responses_[stream_id];
+    response.is_complete = true;
+    response.error_code = error_code;
+    return 0;
+  }
+
+  static ssize_t ReadBody(nghttp2_session*, StreamId, std::uint8_t* buf,
+                          std::size_t length, std::uint32_t* data_flags,
+                          nghttp2_data_source* source, void*) {
+    auto* body = static_cast<std::string*>(source->ptr);
+    const auto size = std::min(length, body->size());
+    std::memcpy(buf, body->data(), size);
+    body->erase(0, size);
+    if (body->empty()) *data_flags |= NGHTTP2_DATA_FLAG_EOF;
+    return static_cast<ssize_t>(size);
+  }
+
+  nghttp2_session* session_{nullptr};
+  std::string request_body_;
+  std::map<StreamId, Response> responses_;
+};
+
+class Http2SessionTest {
+ public:
+  explicit Http2SessionTest(server::net::Http2Config config = {},
+                            bool client_auto_window_update = true)
+      : session_(
+            config, handler_info_index_, kTestRequestConfig,
+            [this](StreamId stream_id, RequestPtr&& request) {
+              requests_.emplace_back(stream_id, std::move(request));
+            },
+            stats_, data_accounter_),
+        client_(client_auto_window_update) {}
+
+  // Passes the frames between the client and the server until both have
+  // nothing to send, e.g. while waiting for flow control window updates
+  void Exchange() {
+    bool has_output = true;
+    while (has_output) {
+      const auto client_output = client_.GetOutput();
+      ASSERT_TRUE(session_.Parse(client_output.data(), client_output.size()));
+      has_output = !client_output.empty();
+
+      for (auto output = session_.GetPendingOutput(); !output.empty();
+           output = session_.GetPendingOutput()) {
+        client_.Receive(output);
+        has_output = true;
+      }
+    }
+  }
+
+  TestClient& Client() { return client_; }
+  server::http::Http2Session& Session() { return session_; }
+  std::vector<std::pair<StreamId, RequestPtr>>& Requests() {
+    return requests_;
+  }
+  std::size_t ParsingRequestCount() const {
+    return stats_.parsing_request_count.NonNegativeRead();
+  }
+
+ private:
+  const server::http::HandlerInfoIndex handler_info_index_;
+  server::net::ParserStats stats_;
+  server::request::ResponseDataAccounter data_accounter_;
+  std::vector<std::pair<StreamId, RequestPtr>> requests_;
+  server::http::Http2Session session_;
+  TestClient client_;
+};
+
+const std::vector<std::pair<std::string, std::string>> kGetHeaders{
+    {":method", "GET"},
+    {":scheme", "http"},
+    {":authority", "localhost:11235"},
+    {":path", "/foo/bar?query1=value1"},
+    {"user-agent", "test"},
+};
+
+}  // namespace
+
+TEST(Http2Session, IsClientPreface) {
+  constexpr std::string_view kPreface{NGHTTP2_CLIENT_MAGIC,
+                                      NGHTTP2_CLIENT_MAGIC_LEN};
+  EXPECT_TRUE(server::http::Http2Session::IsClientPreface(kPreface.data(),
+                                                          kPreface.size()));
+  EXPECT_TRUE(server::http::Http2Session::IsClientPreface(kPreface.data(), 8));
+
+  constexpr std::string_view kHttp11 = "GET / HTTP/1.1\r\n\r\n";
+  EXPECT_FALSE(server::http::Http2Session::IsClientPreface(kHttp11.data(),
+                                                           kHttp11.size()));
+  EXPECT_FALSE(server::http::Http2Session::IsClientPreface(kPreface.data(), 2));
+}
+
+UTEST(Http2Session, Request) {
+  Http2SessionTest test;
+  const auto stream_id = test.Client().SubmitRequest(kGetHeaders);
+  test.Exchange();
+
+  ASSERT_EQ(test.Requests().size(), 1);
+  EXPECT_EQ(test.Requests()[0].first, stream_id);
+  const auto& request = AsHttpRequest(test.Requests()[0].second);
+  EXPECT_EQ(request.GetMethod(), server::http::HttpMethod::kGet);
+  EXPECT_EQ(request.GetHttpMajor(), 2);
+  EXPECT_EQ(request.GetHttpMinor(), 0);
+  EXPECT_EQ(request.GetUrl(), "/foo/bar?query1=value1");
+  EXPECT_EQ(request.GetRequestPath(), "/foo/bar");
+  EXPECT_EQ(request.GetArg("query1"), "value1");
+  EXPECT_EQ(request.GetHeader("User-Agent"), "test");
+  EXPECT_EQ(request.GetHost(), "localhost:11235");
+  EXPECT_FALSE(request.IsFinal());
+  EXPECT_EQ(test.ParsingRequestCount(), 0);
+}
+
+UTEST(Http2Session, RequestBody) {
+  Http2SessionTest test;
+  auto headers = kGetHeaders;
+  headers[0].second = "POST";
+  test.Client().SubmitRequest(headers, std::string(100'000, 'x'));
+  test.Exchange();
+
+  ASSERT_EQ(test.Requests().size(), 1);
+  const auto& request = AsHttpRequest(test.Requests()[0].second);
+  EXPECT_EQ(request.GetMethod(), server::http::HttpMethod::kPost);
+  EXPECT_EQ(request.RequestBody(), std::string(100'000, 'x'));
+}
+
+UTEST(Http2Session, SplitCookies) {
+  Http2SessionTest test;
+  auto headers = kGetHeaders;
+  headers.emplace_back("cookie", "a=1");
+  headers.emplace_back("cookie", "b=2");
+  test.Client().SubmitRequest(headers);
+  test.Exchange();
+
+  ASSERT_EQ(test.Requests().size(), 1);
+  const auto& request = AsHttpRequest(test.Requests()[0].second);
+  EXPECT_EQ(request.GetHeader("Cookie"), "a=1; b=2");
+  EXPECT_EQ(request.GetCookie("a"), "1");
+  EXPECT_EQ(request.GetCookie("b"), "2");
+}
+
+UTEST(Http2Session, ConcurrentStreams) {
+  Http2SessionTest test;
+  const auto first = test.Client().SubmitRequest(kGetHeaders);
+  const auto second = test.Client().SubmitRequest(kGetHeaders);
+  test.Exchange();
+  ASSERT_EQ(test.Requests().size(), 2);
+
+  // Responses are written in the reverse order
+  auto second_writer = test.Session().GetStreamWriter(second);
+  second_writer->WriteHeaders(server::http::HttpStatus::kOk,
+                              {{"content-type", "text/plain"}}, false);
+  second_writer->WriteData("second", true);
+  test.Exchange();
+
+  EXPECT_TRUE(test.Client().GetResponse(second).is_complete);
+  EXPECT_EQ(test.Client().GetResponse(second).headers[":status"], "200");
+  EXPECT_EQ(test.Client().GetResponse(second).headers["content-type"],
+            "text/plain");
+  EXPECT_EQ(test.Client().GetResponse(second).body, "second");
+  EXPECT_FALSE(test.Client().GetResponse(first).is_complete);
+
+  auto first_writer = test.Session().GetStreamWriter(first);
+  first_writer->WriteHeaders(server::http::HttpStatus::kNotFound, {}, true);
+  test.Exchange();
+
+  EXPECT_TRUE(test.Client().GetResponse(first).is_complete);
+  EXPECT_EQ(test.Client().GetResponse(first).headers[":status"], "404");
+  EXPECT_EQ(test.Client().GetResponse(first).body, "");
+}
+
+UTEST(Http2Session, StreamedResponse) {
+  Http2SessionTest test;
+  const auto stream_id = test.Client().SubmitRequest(kGetHeaders);
+  test.Exchange();
+
+  auto writer = test.Session().GetStreamWriter(stream_id);
+  writer->WriteHeaders(server::http::HttpStatus::kOk, {}, false);
+  test.Exchange();
+  EXPECT_EQ(test.Client().GetResponse(stream_id).headers[":status"], "200");
+
+  auto output_ready = test.Session().GetStreamOutputFuture();
+  EXPECT_EQ(output_ready.wait_for(std::chrono::milliseconds{0}),
+            engine::FutureStatus::kTimeout);
+
+  for (const auto* chunk : {"a", "b", "c"}) {
+    writer->WriteData(chunk, false);
+    EXPECT_EQ(output_ready.wait_for(std::chrono::milliseconds{0}),
+              engine::FutureStatus::kReady);
+    test.Exchange();
+    output_ready = test.Session().GetStreamOutputFuture();
+  }
+  EXPECT_FALSE(test.Client().GetResponse(stream_id).is_complete);
+
+  writer->WriteData({}, true);
+  test.Exchange();
+  EXPECT_TRUE(test.Client().GetResponse(stream_id).is_complete);
+  EXPECT_EQ(test.Client().GetResponse(stream_id).body, "abc");
+}
+
+UTEST(Http2Session, StreamedResponseBackpressure) {
+  Http2SessionTest test{{}, /*client_auto_window_update=*/false};
+  const auto stream_id = test.Client().SubmitRequest(kGetHeaders);
+  test.Exchange();
+  auto writer = test.Session().GetStreamWriter(stream_id);
+
+  constexpr std::size_t kChunksCount = 16;
+  constexpr std::size_t kChunkSize = 64 * 1024;
+  std::size_t chunks_written = 0;
+  auto write_task = engine::AsyncNoSpan([&] {
+    writer->WriteHeaders(server::http::HttpStatus::kOk, {}, false);
+    for (std::size_t i = 0; i < kChunksCount; ++i) {
+      writer->WriteData(std::string(kChunkSize, static_cast<char>('a' + i)),
+                        false);
+      ++chunks_written;
+    }
+    writer->WriteData({}, true);
+  });
+
+  for (int i = 0; i < 10; ++i) {
+    engine::Yield();
+    test.Exchange();
+  }
+
+  // The peer's windows are exhausted, so the writer waits instead of
+  // buffering the rest of the body
+  auto& response = test.Client().GetResponse(stream_id);
+  EXPECT_FALSE(write_task.IsFinished());
+  EXPECT_LE(chunks_written, std::size_t{2});
+  EXPECT_LE(response.body.size(), std::size_t{NGHTTP2_INITIAL_WINDOW_SIZE});
+
+  const auto deadline =
+      engine::Deadline::FromDuration(utest::kMaxTestWaitTime);
+  while (!response.is_complete) {
+    ASSERT_FALSE(deadline.IsReached());
+    test.Client().ConsumeBody(stream_id);
+    test.Exchange();
+    engine::Yield();
+  }
+  write_task.Get();
+
+  std::string expected_body;
+  for (std::size_t i = 0; i < kChunksCount; ++i) {
+    expected_body.append(kChunkSize, static_cast<char>('a' + i));
+  }
+  EXPECT_EQ(chunks_written, kChunksCount);
+  EXPECT_EQ(response.body, expected_body);
+}
+
+UTEST(Http2Session, MaxConcurrentStreams) {
+  server::net::Http2Config config;
+  config.max_concurrent_streams = 1;
+  Http2SessionTest test{config};
+
+  const auto first = test.Client().SubmitRequest(kGetHeaders);
+  const auto second = test.Client().SubmitRequest(kGetHeaders);
+  test.Exchange();
+
+  ASSERT_EQ(test.Requests().size(), 1);
+  EXPECT_EQ(test.Requests()[0].first, first);
+  EXPECT_TRUE(test.Client().GetResponse(second).is_complete);
+  EXPECT_EQ(test.Client().GetResponse(second).error_code,
+            NGHTTP2_REFUSED_STREAM);
+}
+
+UTEST(Http2Session, ResetStream) {
+  Http2SessionTest test;
+  const auto stream_id = test.Client().SubmitRequest(kGetHeaders);
+  test.Exchange();
+  auto writer = test.Session().GetStreamWriter(stream_id);
+
+  test.Client().ResetStream(stream_id);
+  test.Exchange();
+  EXPECT_EQ(test.Session().ExtractClosedStreams(),
+            std::vector<StreamId>{stream_id});
+
+  // Late writes of a cancelled request are ignored
+  writer->WriteHeaders(server::http::HttpStatus::kOk, {}, true);
+  EXPECT_TRUE(test.Session().GetPendingOutput().empty());
+  EXPECT_TRUE(test.Session().IsAlive());
+
+  test.Session().Terminate();
+  test.Exchange();
+  EXPECT_FALSE(test.Session().IsAlive());
+}
+
+USERVER_NAMESPACE_END
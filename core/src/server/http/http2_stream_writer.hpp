@@ -0,0 +1,41 @@
+#pragma once
+
+#include <string>
+#include <string_view>
+#include <utility>
+#include <vector>
+
+#include <userver/server/http/http_status.hpp>
+
+USERVER_NAMESPACE_BEGIN
+
+namespace server::http::impl {
+
+/// Output side of a single HTTP/2 stream. Frames are not written right away:
+/// the data is handed over to the connection, which encodes it into HEADERS
+/// and DATA frames with respect to the peer's flow control windows.
+class Http2StreamWriter {
+ public:
+  /// Header names must be lower-case and must not contain connection-specific
+  /// headers, as required by RFC 9113 section 8.2.
+  using Headers = std::vector<std::pair<std::string, std::string>>;
+
+  /// Called once, before any WriteData.
+  virtual void WriteHeaders(HttpStatus status, Headers&& headers,
+                            bool end_stream) = 0;
+
+  /// Appends a chunk of the response body. The last call must have
+  /// end_stream set, `data` may be empty in that case.
+  ///
+  /// Unless end_stream is set, waits while too much of the body is buffered
+  /// because the peer's flow control window is exhausted. So the caller stops
+  /// pulling the body from its producer until the peer reads the data.
+  virtual void WriteData(std::string_view data, bool end_stream) = 0;
+
+ protected:
+  ~Http2StreamWriter() = default;
+};
+
+}  // namespace server::http::impl
+
+USERVER_NAMESPACE_END
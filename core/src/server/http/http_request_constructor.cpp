@@ -271,46 +271,37 @@ void HttpRequestConstructor::AddHeader() {
 }
 
 void HttpRequestConstructor::ParseCookies() {
-  const std::string& cookie =
+  std::string_view cookies =
       request_->GetHeader(USERVER_NAMESPACE::http::headers::kCookie);
-  const char* data = cookie.data();
-  size_t size = cookie.size();
-  const char* end = data + size;
-  const char* key_begin = data;
-  const char* key_end = data;
-  bool parse_key = true;
-  for (const char* ptr = data; ptr <= end; ++ptr) {
-    if (ptr == end || *ptr == ';') {
-      const char* value_begin = nullptr;
-      const char* value_end = nullptr;
-      if (parse_key) {
-        key_end = ptr;
-        value_begin = value_end = ptr;
-      } else {
-        value_begin = key_end + 1;
-        value_end = ptr;
-        Strip(value_begin, value_end);
-        if (value_begin + 2 <= value_end && *value_begin == '"' &&
-            value_end[-1] == '"') {
-          ++value_begin;
-          --value_end;
-        }
+  while (true) {
+    // memchr-based search, vectorized by libc
+    const auto cookie_size = std::min(cookies.find(';'), cookies.size());
+    const auto cookie = cookies.substr(0, cookie_size);
+
+    const char* key_begin = cookie.data();
+    const char* key_end = cookie.data() + cookie.size();
+    const char* value_begin = key_end;
+    const char* value_end = key_end;
+    const auto eq_pos = cookie.find('=');
+    if (eq_pos != std::string_view::npos) {
+      key_end = key_begin + eq_pos;
+      value_begin = key_end + 1;
+      Strip(value_begin, value_end);
+      if (value_begin + 2 <= value_end && *value_begin == '"' &&
+          value_end[-1] == '"') {
+        ++value_begin;
+        --value_end;
       }
-      Strip(key_begin, key_end);
-      if (key_begin < key_end) {
-        request_->cookies_.emplace(std::piecewise_construct,
-                                   std::tie(key_begin, key_end),
-                                   std::tie(value_begin, value_end));
-      }
-      parse_key = true;
-      key_begin = ptr + 1;
-      continue;
     }
-    if (*ptr == '=' && parse_key) {
-      parse_key = false;
-      key_end = ptr;
-      continue;
+    Strip(key_begin, key_end);
+    if (key_begin < key_end) {
+      request_->cookies_.emplace(std::piecewise_construct,
+                                 std::tie(key_begin, key_end),
+                                 std::tie(value_begin, value_end));
     }
+
+    if (cookie_size == cookies.size()) break;
+    cookies.remove_prefix(cookie_size + 1);
   }
 }
 
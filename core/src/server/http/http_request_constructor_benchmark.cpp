@@ -1,8 +1,34 @@
 #include <benchmark/benchmark.h>
 
+#include <cstdlib>
+#include <new>
+
+#include <fmt/format.h>
+
 #include <server/http/http_request_constructor.hpp>
+#include <server/http/http_request_impl.hpp>
+#include <server/http/http_request_parser.hpp>
 #include <utils/gbench_auxilary.hpp>
 
+namespace {
+
+// Heap allocations made by the current thread. The global operator new is
+// replaced for the whole benchmark binary, the counting is a single
+// thread-local increment.
+thread_local std::size_t heap_allocations = 0;
+
+}  // namespace
+
+void* operator new(std::size_t size) {
+  ++heap_allocations;
+  if (void* ptr = std::malloc(size ? size : 1)) return ptr;
+  throw std::bad_alloc{};
+}
+
+void operator delete(void* ptr) noexcept { std::free(ptr); }
+
+void operator delete(void* ptr, std::size_t) noexcept { std::free(ptr); }
+
 USERVER_NAMESPACE_BEGIN
 
 namespace {
@@ -16,9 +42,70 @@ void http_request_constructor_url_decode(benchmark::State& state) {
   for ([[maybe_unused]] auto _ : state)
     benchmark::DoNotOptimize(USERVER_NAMESPACE::http::parser::UrlDecode(input));
 }
+
+void http_request_constructor_arena(benchmark::State& state) {
+  static const server::http::HandlerInfoIndex kHandlerInfoIndex;
+  static constexpr server::request::HttpRequestConfig kRequestConfig{
+      /*.max_url_size = */ 8192,
+      /*.max_request_size = */ 1024 * 1024,
+      /*.max_headers_size = */ 65536,
+      /*.parse_args_from_body = */ false,
+      /*.testing_mode = */ true,
+      /*.decompress_request = */ false,
+  };
+  server::net::ParserStats stats;
+  server::request::ResponseDataAccounter accounter;
+
+  std::size_t requests = 0;
+  std::size_t arena_bytes = 0;
+  std::size_t arena_heap_blocks = 0;
+  server::http::HttpRequestParser parser(
+      kHandlerInfoIndex, kRequestConfig,
+      [&](std::shared_ptr<server::request::RequestBase>&& request) {
+        const auto& arena_stats =
+            static_cast<const server::http::HttpRequestImpl&>(*request)
+                .GetArenaStats();
+        ++requests;
+        arena_bytes += arena_stats.allocated_bytes;
+        arena_heap_blocks += arena_stats.heap_blocks;
+      },
+      stats, accounter);
+
+  std::string args;
+  for (int64_t i = 0; i < state.range(0); ++i) {
+    args += fmt::format("&argument{}=value{}", i, i);
+  }
+  const std::string request_data = fmt::format(
+      "GET /v1/handler?{} HTTP/1.1\r\n"
+      "Host: localhost\r\n"
+      "User-Agent: benchmark/1.0\r\n"
+      "Accept: application/json\r\n"
+      "X-Request-Id: 0123456789abcdef0123456789abcdef\r\n"
+      "Cookie: session=0123456789abcdef; theme=dark\r\n\r\n",
+      args.substr(1));
+
+  const auto heap_allocations_before = heap_allocations;
+  for ([[maybe_unused]] auto _ : state) {
+    parser.Parse(request_data.data(), request_data.size());
+  }
+  const auto request_heap_allocations =
+      heap_allocations - heap_allocations_before;
+
+  state.SetItemsProcessed(requests);
+  if (requests != 0) {
+    state.counters["heap_allocations"] =
+        static_cast<double>(request_heap_allocations) / requests;
+    state.counters["arena_bytes"] =
+        static_cast<double>(arena_bytes) / requests;
+    state.counters["arena_heap_blocks"] =
+        static_cast<double>(arena_heap_blocks) / requests;
+  }
+}
+
 }  // namespace
 BENCHMARK(http_request_constructor_url_decode)
     ->RangeMultiplier(2)
     ->Range(1, 1024);
+BENCHMARK(http_request_constructor_arena)->RangeMultiplier(4)->Range(1, 256);
 
 USERVER_NAMESPACE_END
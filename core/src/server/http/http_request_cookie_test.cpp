@@ -61,6 +61,13 @@ UTEST_P(HttpRequestCookies, Test) {
           EXPECT_TRUE(param.expected.find(name) != param.expected.end());
         }
         EXPECT_EQ(names_count, param.expected.size());
+
+        const server::http::HttpRequest::CookiesMap& cookies =
+            http_request.RequestCookies();
+        EXPECT_EQ(cookies.size(), param.expected.size());
+        for (const auto& [name, value] : param.expected) {
+          EXPECT_EQ(cookies.at(name), value);
+        }
       });
 
   const auto request = "GET / HTTP/1.1\r\nCookie: " + param.data + "\r\n\r\n";
@@ -1,5 +1,7 @@
 #include "http_request_impl.hpp"
 
+#include <mutex>
+
 #include <server/handlers/http_handler_base_statistics.hpp>
 #include <userver/engine/io/socket.hpp>
 #include <userver/engine/task/task.hpp>
@@ -75,13 +77,23 @@ namespace server::http {
 // unordered_maps because we don't need different seeds and want to avoid its
 // overhead.
 HttpRequestImpl::HttpRequestImpl(request::ResponseDataAccounter& data_accounter)
-    : form_data_args_(kZeroAllocationBucketCount,
-                      request_args_.hash_function()),
+    : request_args_(kZeroAllocationBucketCount, utils::StrCaseHash{},
+                    std::equal_to<>{},
+                    utils::impl::ArenaAllocator<char>{arena_}),
+      form_data_args_(kZeroAllocationBucketCount,
+                      request_args_.hash_function(), std::equal_to<>{},
+                      utils::impl::ArenaAllocator<char>{arena_}),
+      path_args_(utils::impl::ArenaAllocator<std::string>{arena_}),
       path_args_by_name_index_(kZeroAllocationBucketCount,
-                               request_args_.hash_function()),
-      headers_(kBucketCount),
-      cookies_(kZeroAllocationBucketCount, request_args_.hash_function()),
-      response_(*this, data_accounter, StartTime(), cookies_.hash_function()) {}
+                               request_args_.hash_function(),
+                               std::equal_to<>{},
+                               utils::impl::ArenaAllocator<char>{arena_}),
+      headers_(kBucketCount, arena_),
+      cookies_(kZeroAllocationBucketCount, request_args_.hash_function(),
+               std::equal_to<std::string>{},
+               utils::impl::ArenaAllocator<char>{arena_}),
+      response_(*this, data_accounter, StartTime(), cookies_.hash_function(),
+                arena_) {}
 
 HttpRequestImpl::~HttpRequestImpl() = default;
 
@@ -246,11 +258,16 @@ bool HttpRequestImpl::HasCookie(const std::string& cookie_name) const {
 size_t HttpRequestImpl::CookieCount() const { return cookies_.size(); }
 
 HttpRequest::CookiesMapKeys HttpRequestImpl::GetCookieNames() const {
-  return HttpRequest::CookiesMapKeys{cookies_};
+  return HttpRequest::CookiesMapKeys{GetCookies()};
 }
 
 const HttpRequest::CookiesMap& HttpRequestImpl::GetCookies() const {
-  return cookies_;
+  std::lock_guard lock{public_cookies_mutex_};
+  if (!public_cookies_) {
+    public_cookies_.emplace(cookies_.begin(), cookies_.end(),
+                            cookies_.bucket_count(), cookies_.hash_function());
+  }
+  return *public_cookies_;
 }
 
 void HttpRequestImpl::SetRequestBody(std::string body) {
@@ -2,10 +2,12 @@
 
 #include <chrono>
 #include <memory>
+#include <optional>
 #include <string>
 #include <unordered_map>
 #include <vector>
 
+#include <userver/engine/mutex.hpp>
 #include <userver/engine/task/task_processor_fwd.hpp>
 
 #include <userver/server/http/http_method.hpp>
@@ -13,9 +15,12 @@
 #include <userver/server/http/http_response.hpp>
 #include <userver/server/request/request_base.hpp>
 #include <userver/utils/datetime/wall_coarse_clock.hpp>
+#include <userver/utils/impl/monotonic_arena.hpp>
 #include <userver/utils/impl/transparent_hash.hpp>
 #include <userver/utils/str_icase.hpp>
 
+#include "multipart_form_data_parser.hpp"
+
 USERVER_NAMESPACE_BEGIN
 
 namespace server {
@@ -136,9 +141,26 @@ class HttpRequestImpl final : public request::RequestBase {
 
   void SetHttpHandlerStatistics(handlers::HttpRequestStatistics&);
 
+  const utils::impl::MonotonicArena::Stats& GetArenaStats() const {
+    return arena_.GetStats();
+  }
+
   friend class HttpRequestConstructor;
 
  private:
+  using Cookies = std::unordered_map<
+      std::string, std::string, utils::StrCaseHash, std::equal_to<std::string>,
+      utils::impl::ArenaAllocator<std::pair<const std::string, std::string>>>;
+
+  using RequestArgs = utils::impl::TransparentMap<
+      std::string, std::vector<std::string>, utils::StrCaseHash,
+      std::equal_to<>,
+      utils::impl::ArenaAllocator<
+          std::pair<const std::string, std::vector<std::string>>>>;
+
+  // Must outlive all the containers that allocate from it
+  utils::impl::MonotonicArena arena_;
+
   HttpMethod method_{HttpMethod::kUnknown};
   unsigned short http_major_{1};
   unsigned short http_minor_{1};
@@ -146,17 +168,20 @@ class HttpRequestImpl final : public request::RequestBase {
   std::string request_path_;
   std::string request_body_;
   std::string path_suffix_;
-  utils::impl::TransparentMap<std::string, std::vector<std::string>,
-                              utils::StrCaseHash>
-      request_args_;
-  utils::impl::TransparentMap<std::string, std::vector<FormDataArg>,
-                              utils::StrCaseHash>
-      form_data_args_;
-  std::vector<std::string> path_args_;
-  utils::impl::TransparentMap<std::string, size_t, utils::StrCaseHash>
+  RequestArgs request_args_;
+  FormDataArgs form_data_args_;
+  std::vector<std::string, utils::impl::ArenaAllocator<std::string>>
+      path_args_;
+  utils::impl::TransparentMap<
+      std::string, size_t, utils::StrCaseHash, std::equal_to<>,
+      utils::impl::ArenaAllocator<std::pair<const std::string, size_t>>>
       path_args_by_name_index_;
   HttpRequest::HeadersMap headers_;
-  HttpRequest::CookiesMap cookies_;
+  Cookies cookies_;
+  // HttpRequest hands out the cookies map with the default allocator, it is
+  // copied from cookies_ on the first request for it
+  mutable engine::Mutex public_cookies_mutex_;
+  mutable std::optional<HttpRequest::CookiesMap> public_cookies_;
   bool is_final_{false};
   UpgradeCallback upgrade_websocket_cb_;
 
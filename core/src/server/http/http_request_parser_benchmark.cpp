@@ -107,10 +107,37 @@ void http_request_parser_parse_benchmark_many_headers(benchmark::State& state) {
   }
 }
 
+void http_request_parser_parse_benchmark_args_and_cookies(
+    benchmark::State& state) {
+  std::size_t requests = 0;
+  auto parser = CreateBenchmarkParser(
+      [&requests](std::shared_ptr<server::request::RequestBase>&&) {
+        ++requests;
+      });
+
+  std::string args;
+  std::string cookies;
+  for (size_t i = 0; i < 32; ++i) {
+    args += fmt::format("&argument{}=some%20value+{}", i, i);
+    cookies += fmt::format("cookie{}=\"some value {}\"; ", i, i);
+  }
+  const std::string http_request_data = fmt::format(
+      "GET /v1/handler?{} HTTP/1.1\r\n"
+      "Host: localhost:11235\r\nCookie: {}\r\n\r\n",
+      args.substr(1), cookies);
+
+  for ([[maybe_unused]] auto _ : state) {
+    parser.Parse(http_request_data.data(), http_request_data.size());
+  }
+  // Requests per second per core
+  state.SetItemsProcessed(requests);
+}
+
 BENCHMARK(http_request_parser_parse_benchmark_small);
 BENCHMARK(http_request_parser_parse_benchmark_middle);
 BENCHMARK(http_request_parser_parse_benchmark_large_url);
 BENCHMARK(http_request_parser_parse_benchmark_large_body);
 BENCHMARK(http_request_parser_parse_benchmark_many_headers);
+BENCHMARK(http_request_parser_parse_benchmark_args_and_cookies);
 
 USERVER_NAMESPACE_END
@@ -1,6 +1,7 @@
 #include <userver/server/http/http_response.hpp>
 
 #include <array>
+#include <vector>
 
 #include <cctz/time_zone.h>
 #include <fmt/compile.h>
@@ -17,7 +18,9 @@
 #include <userver/utils/datetime/wall_coarse_clock.hpp>
 #include <userver/utils/small_string.hpp>
 
+#include <server/http/http2_stream_writer.hpp>
 #include <server/http/http_cached_date.hpp>
+#include <server/http/stream_body_compressor.hpp>
 
 #include "http_request_impl.hpp"
 
@@ -36,6 +39,10 @@ constexpr std::string_view kKeyValueHeaderSeparator = ": ";
 // charset https://www.iana.org/assignments/media-types/application/octet-stream
 constexpr std::string_view kDefaultContentType = "application/octet-stream";
 
+// Limits of the streamed body chunks that are gathered into a single write
+constexpr std::size_t kMaxPendingChunkParts = 64;
+constexpr std::size_t kMaxPendingChunksSize = 64 * 1024;
+
 constexpr std::string_view kClose = "close";
 constexpr std::string_view kKeepAlive = "keep-alive";
 
@@ -96,6 +103,29 @@ void AppendToCharArray(char*& data, const std::string_view what) {
 
 const std::string kEmptyString{};
 
+// RFC 9113 section 8.2.2
+bool IsConnectionSpecificHeader(std::string_view name) {
+  namespace headers = USERVER_NAMESPACE::http::headers;
+  static constexpr std::string_view kConnectionSpecific[] = {
+      headers::kConnection, headers::kTransferEncoding, headers::kUpgrade,
+      "Keep-Alive", "Proxy-Connection"};
+
+  const utils::StrIcaseEqual equal;
+  for (const auto header : kConnectionSpecific) {
+    if (equal(name, header)) return true;
+  }
+  return false;
+}
+
+void AppendHttp2Header(server::http::impl::Http2StreamWriter::Headers& headers,
+                       std::string_view name, std::string value) {
+  std::string lower_name{name};
+  for (auto& c : lower_name) {
+    if (c >= 'A' && c <= 'Z') c = c - 'A' + 'a';
+  }
+  headers.emplace_back(std::move(lower_name), std::move(value));
+}
+
 }  // namespace
 
 namespace server::http {
@@ -123,15 +153,17 @@ void OutputHeader(USERVER_NAMESPACE::http::headers::HeadersString& header,
 
 HttpResponse::HttpResponse(const HttpRequestImpl& request,
                            request::ResponseDataAccounter& data_accounter)
-    : HttpResponse{request, data_accounter, std::chrono::steady_clock::now(),
-                   utils::StrCaseHash{}} {}
+    : ResponseBase{data_accounter, std::chrono::steady_clock::now()},
+      request_{request} {}
 
 HttpResponse::HttpResponse(const HttpRequestImpl& request,
                            request::ResponseDataAccounter& data_accounter,
                            std::chrono::steady_clock::time_point now,
-                           utils::StrCaseHash hasher)
+                           utils::StrCaseHash hasher,
+                           utils::impl::MonotonicArena& arena)
     : ResponseBase{data_accounter, now},
       request_{request},
+      headers_{0, arena},
       cookies_{0, hasher} {}
 
 HttpResponse::~HttpResponse() = default;
@@ -260,10 +292,9 @@ void HttpResponse::SetHeadersEnd() { headers_end_.Send(); }
 
 bool HttpResponse::WaitForHeadersEnd() { return headers_end_.WaitForEvent(); }
 
-void HttpResponse::SendResponse(engine::io::RwBase& socket) {
-  utils::SmallString<USERVER_NAMESPACE::http::headers::kTypicalHeadersSize>
-      header;
-
+void HttpResponse::OutputHeaders(
+    USERVER_NAMESPACE::http::headers::HeadersString& header,
+    bool send_body_streamed) {
   header.resize_and_overwrite(
       USERVER_NAMESPACE::http::headers::kTypicalHeadersSize,
       [&](char* data, std::size_t) {
@@ -277,6 +308,12 @@ void HttpResponse::SendResponse(engine::io::RwBase& socket) {
         return data - old_data_pointer;
       });
 
+  if (stream_body_compressor_ &&
+      (!send_body_streamed ||
+       !stream_body_compressor_->Start(status_, headers_))) {
+    stream_body_compressor_.reset();
+  }
+
   headers_.erase(USERVER_NAMESPACE::http::headers::kContentLength);
   const auto end = headers_.end();
   if (headers_.find(USERVER_NAMESPACE::http::headers::kDate) == end) {
@@ -313,10 +350,17 @@ void HttpResponse::SendResponse(engine::io::RwBase& socket) {
 
     header.append(kCrlf);
   }
+}
+
+void HttpResponse::SendResponse(engine::io::RwBase& socket) {
+  USERVER_NAMESPACE::http::headers::HeadersString header;
+
+  const bool send_body_streamed = IsBodyStreamed() && GetData().empty();
+  OutputHeaders(header, send_body_streamed);
 
   std::size_t sent_bytes{};
 
-  if (IsBodyStreamed() && GetData().empty()) {
+  if (send_body_streamed) {
     sent_bytes = SetBodyStreamed(socket, header);
   } else {
     // e.g. a CustomHandlerException
@@ -326,8 +370,14 @@ void HttpResponse::SendResponse(engine::io::RwBase& socket) {
   SetSent(sent_bytes, std::chrono::steady_clock::now());
 }
 
-std::size_t HttpResponse::SetBodyNotStreamed(
-    engine::io::RwBase& socket,
+std::string_view HttpResponse::SerializeNotStreamed(
+    USERVER_NAMESPACE::http::headers::HeadersString& header) {
+  UASSERT(!IsBodyStreamed() || !GetData().empty());
+  OutputHeaders(header, false);
+  return FinishNotStreamedHeaders(header);
+}
+
+std::string_view HttpResponse::FinishNotStreamedHeaders(
     USERVER_NAMESPACE::http::headers::HeadersString& header) {
   const bool is_body_forbidden = IsBodyForbiddenForStatus(status_);
   const bool is_head_request = request_.GetMethod() == HttpMethod::kHead;
@@ -346,17 +396,115 @@ std::size_t HttpResponse::SetBodyNotStreamed(
         << " which does not allow one, it will be dropped";
   }
 
-  ssize_t sent_bytes = 0;
-  if (!is_head_request && !is_body_forbidden) {
-    sent_bytes = socket.WriteAll(
-        {{header.data(), header.size()}, {data.data(), data.size()}},
-        engine::Deadline{});
-  } else {
-    sent_bytes =
-        socket.WriteAll(header.data(), header.size(), engine::Deadline{});
+  if (is_head_request || is_body_forbidden) return {};
+  return data;
+}
+
+void HttpResponse::SendResponseHttp2(impl::Http2StreamWriter& stream) {
+  const bool send_body_streamed = IsBodyStreamed() && GetData().empty();
+  if (stream_body_compressor_ &&
+      (!send_body_streamed ||
+       !stream_body_compressor_->Start(status_, headers_))) {
+    stream_body_compressor_.reset();
   }
 
-  return sent_bytes;
+  impl::Http2StreamWriter::Headers headers;
+  headers.reserve(headers_.size() + cookies_.size() + 3);
+
+  headers_.erase(USERVER_NAMESPACE::http::headers::kContentLength);
+  const auto end = headers_.end();
+  if (headers_.find(USERVER_NAMESPACE::http::headers::kDate) == end) {
+    AppendHttp2Header(headers, USERVER_NAMESPACE::http::headers::kDate,
+                      // impl::GetCachedDate() must not cross thread boundaries
+                      std::string{impl::GetCachedDate()});
+  }
+  if (headers_.find(USERVER_NAMESPACE::http::headers::kContentType) == end) {
+    AppendHttp2Header(headers, USERVER_NAMESPACE::http::headers::kContentType,
+                      std::string{kDefaultContentType});
+  }
+  for (const auto& [name, value] : headers_) {
+    if (IsConnectionSpecificHeader(name)) continue;
+    AppendHttp2Header(headers, name, value);
+  }
+  for (const auto& cookie : cookies_) {
+    USERVER_NAMESPACE::http::headers::HeadersString value;
+    cookie.second.AppendToString(value);
+    AppendHttp2Header(headers, USERVER_NAMESPACE::http::headers::kSetCookie,
+                      std::string{value.data(), value.size()});
+  }
+
+  const bool is_body_forbidden = IsBodyForbiddenForStatus(status_);
+  const bool is_head_request = request_.GetMethod() == HttpMethod::kHead;
+  const auto& data = GetData();
+
+  if (!send_body_streamed && !is_body_forbidden) {
+    AppendHttp2Header(headers, USERVER_NAMESPACE::http::headers::kContentLength,
+                      fmt::format(FMT_COMPILE("{}"), data.size()));
+  }
+  if (is_body_forbidden && !data.empty()) {
+    LOG_LIMITED_WARNING()
+        << "Non-empty body provided for response with HTTP code "
+        << static_cast<int>(status_)
+        << " which does not allow one, it will be dropped";
+  }
+
+  // HPACK-encoded size is not known here, account the raw size
+  std::size_t sent_bytes = 0;
+  for (const auto& [name, value] : headers) {
+    sent_bytes += name.size() + value.size();
+  }
+
+  const bool has_body = !is_head_request && !is_body_forbidden &&
+                        (send_body_streamed || !data.empty());
+  stream.WriteHeaders(status_, std::move(headers), !has_body);
+
+  if (has_body && !send_body_streamed) {
+    sent_bytes += data.size();
+    stream.WriteData(data, true);
+  } else if (has_body) {
+    std::string body_part;
+    while (body_stream_->Pop(body_part)) {
+      if (body_part.empty()) continue;
+
+      if (stream_body_compressor_) {
+        body_part = stream_body_compressor_->Compress(body_part);
+        if (body_part.empty()) continue;
+      }
+
+      sent_bytes += body_part.size();
+      // Waits while the peer's flow control window is exhausted, so the body
+      // is not pulled from the producer any faster than the peer reads it
+      stream.WriteData(body_part, false);
+    }
+
+    std::string compressed_end;
+    if (stream_body_compressor_) {
+      compressed_end = stream_body_compressor_->Finish();
+      stream_body_compressor_.reset();
+    }
+    sent_bytes += compressed_end.size();
+    stream.WriteData(compressed_end, true);
+  }
+
+  if (send_body_streamed) {
+    body_stream_producer_.reset();
+    body_stream_.reset();
+  }
+
+  SetSent(sent_bytes, std::chrono::steady_clock::now());
+}
+
+std::size_t HttpResponse::SetBodyNotStreamed(
+    engine::io::RwBase& socket,
+    USERVER_NAMESPACE::http::headers::HeadersString& header) {
+  const auto body = FinishNotStreamedHeaders(header);
+  if (body.empty()) {
+    return socket.WriteAll(header.data(), header.size(), engine::Deadline{});
+  }
+
+  return socket.WriteAll(
+      {{header.data(), header.size()}, {body.data(), body.size()}},
+      engine::Deadline{});
 }
 
 std::size_t HttpResponse::SetBodyStreamed(
@@ -370,40 +518,91 @@ std::size_t HttpResponse::SetBodyStreamed(
   // headers end marker
   header.append(kCrlf);
 
-  // send HTTP headers
-  size_t sent_bytes = socket.WriteAll(header.data(), header.size(), {});
-  header.clear();
-  header.shrink_to_fit();  // free memory before time-consuming operation
-
   if (is_body_forbidden) {
-    return sent_bytes;
+    return socket.WriteAll(header.data(), header.size(), {});
   }
 
-  // Transmit HTTP response body
-  std::string body_part;
+  // Headers and the chunks that are already in the queue are gathered into
+  // a single write, pending data is flushed before waiting for the next
+  // chunk.
+  std::size_t sent_bytes = 0;
+  bool has_pending_header = true;
+  std::vector<std::string> pending;
+  std::size_t pending_bytes = 0;
+  std::vector<engine::io::IoData> io_data;
+
+  const auto flush = [&] {
+    io_data.clear();
+    if (has_pending_header) {
+      io_data.push_back({header.data(), header.size()});
+    }
+    for (const auto& part : pending) {
+      io_data.push_back({part.data(), part.size()});
+    }
+    if (io_data.empty()) return;
+
+    sent_bytes += socket.WriteAll(io_data.data(), io_data.size(), {});
+    pending.clear();
+    pending_bytes = 0;
+    if (has_pending_header) {
+      has_pending_header = false;
+      header.clear();
+      header.shrink_to_fit();  // free memory before time-consuming operation
+    }
+  };
+
   // First chunk must be sent without kCrlf
   // because kCrlf was sent with headers
   bool first_chunk_processed = false;
-  while (body_stream_->Pop(body_part)) {
+  const auto append_chunk = [&](std::string&& chunk) {
+    pending.push_back(first_chunk_processed
+                          ? fmt::format("\r\n{:x}\r\n", chunk.size())
+                          : fmt::format("{:x}\r\n", chunk.size()));
+    pending_bytes += pending.back().size() + chunk.size();
+    pending.push_back(std::move(chunk));
+    first_chunk_processed = true;
+
+    if (pending.size() >= kMaxPendingChunkParts ||
+        pending_bytes >= kMaxPendingChunksSize) {
+      flush();
+    }
+  };
+
+  // Transmit HTTP response body
+  const auto queue = body_stream_->Queue();
+  std::string body_part;
+  while (true) {
+    if (!body_stream_->PopNoblock(body_part)) {
+      // Nothing to wait for if the producer is gone, the pending data goes
+      // with the terminating chunk
+      if (!queue->NoMoreProducers()) flush();
+      if (!body_stream_->Pop(body_part)) break;
+    }
+
     if (body_part.empty()) {
       LOG_DEBUG() << "Zero size body_part in http_response.cpp";
       continue;
     }
 
-    auto size = first_chunk_processed
-                    ? fmt::format("\r\n{:x}\r\n", body_part.size())
-                    : fmt::format("{:x}\r\n", body_part.size());
-    sent_bytes += socket.WriteAll(
-        {{size.data(), size.size()}, {body_part.data(), body_part.size()}},
-        engine::Deadline{});
+    if (stream_body_compressor_) {
+      body_part = stream_body_compressor_->Compress(body_part);
+      if (body_part.empty()) continue;
+    }
 
-    first_chunk_processed = true;
+    append_chunk(std::move(body_part));
+    body_part.clear();
   }
 
-  const std::string_view terminating_chunk{
-      first_chunk_processed ? "\r\n0\r\n\r\n" : "0\r\n\r\n"};
-  sent_bytes +=
-      socket.WriteAll(terminating_chunk.data(), terminating_chunk.size(), {});
+  if (stream_body_compressor_) {
+    auto compressed_end = stream_body_compressor_->Finish();
+    if (!compressed_end.empty()) append_chunk(std::move(compressed_end));
+    stream_body_compressor_.reset();
+  }
+
+  // terminating chunk goes with the last data
+  pending.emplace_back(first_chunk_processed ? "\r\n0\r\n\r\n"
+                                             : "0\r\n\r\n");
+  flush();
 
   // TODO: exceptions?
   body_stream_producer_.reset();
@@ -435,6 +634,12 @@ void HttpResponse::SetStreamBody() {
 
 bool HttpResponse::IsBodyStreamed() const { return body_stream_.has_value(); }
 
+void HttpResponse::SetStreamBodyCompressor(
+    std::unique_ptr<impl::StreamBodyCompressor> compressor) {
+  UASSERT(IsBodyStreamed());
+  stream_body_compressor_ = std::move(compressor);
+}
+
 HttpResponse::Queue::Producer HttpResponse::GetBodyProducer() {
   UASSERT(IsBodyStreamed());
   UASSERT_MSG(body_stream_producer_, "GetBodyProducer() is called twice");
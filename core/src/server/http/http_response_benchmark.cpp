@@ -9,6 +9,9 @@
 #include <userver/utils/small_string.hpp>
 
 #include <server/http/http_request_impl.hpp>
+#include <server/http/response_batch.hpp>
+#include <userver/engine/io/common.hpp>
+#include <userver/engine/run_standalone.hpp>
 #include <userver/server/request/response_base.hpp>
 
 USERVER_NAMESPACE_BEGIN
@@ -148,11 +151,124 @@ void HttpResponseSetHeaderBenchmark(benchmark::State& state) {
   }
 }
 
+// Counts write syscalls a socket would make
+class CountingSocket final : public engine::io::RwBase {
+ public:
+  bool IsValid() const override { return true; }
+
+  bool WaitReadable(engine::Deadline) override { return false; }
+
+  size_t ReadSome(void*, size_t, engine::Deadline) override { return 0; }
+
+  size_t ReadAll(void*, size_t, engine::Deadline) override { return 0; }
+
+  bool WaitWriteable(engine::Deadline) override { return true; }
+
+  size_t WriteAll(const void* buf, size_t len, engine::Deadline) override {
+    benchmark::DoNotOptimize(buf);
+    ++writes;
+    return len;
+  }
+
+  size_t WriteAll(const engine::io::IoData* list, std::size_t list_size,
+                  engine::Deadline) override {
+    ++writes;
+    std::size_t result = 0;
+    for (std::size_t i = 0; i < list_size; ++i) result += list[i].len;
+    return result;
+  }
+
+  std::size_t writes{0};
+};
+
+std::vector<std::unique_ptr<server::http::HttpResponse>> MakeResponses(
+    const server::http::HttpRequestImpl& request,
+    server::request::ResponseDataAccounter& accounter, std::size_t count) {
+  std::vector<std::unique_ptr<server::http::HttpResponse>> result;
+  for (std::size_t i = 0; i < count; ++i) {
+    auto& response = *result.emplace_back(
+        std::make_unique<server::http::HttpResponse>(request, accounter));
+    response.SetData(R"({"status":"ok"})");
+    for (const auto& [name, value] : kHeaders) response.SetHeader(name, value);
+  }
+  return result;
+}
+
+void http_pipelined_responses_one_by_one(benchmark::State& state) {
+  server::request::ResponseDataAccounter accounter{};
+  const server::http::HttpRequestImpl request{accounter};
+  CountingSocket socket;
+
+  for ([[maybe_unused]] auto _ : state) {
+    state.PauseTiming();
+    auto responses = MakeResponses(request, accounter, state.range(0));
+    state.ResumeTiming();
+
+    for (auto& response : responses) response->SendResponse(socket);
+  }
+  state.counters["writes_per_response"] = benchmark::Counter(
+      static_cast<double>(socket.writes) / state.range(0),
+      benchmark::Counter::kAvgIterations);
+}
+
+void http_pipelined_responses_batched(benchmark::State& state) {
+  server::request::ResponseDataAccounter accounter{};
+  const server::http::HttpRequestImpl request{accounter};
+  CountingSocket socket;
+
+  for ([[maybe_unused]] auto _ : state) {
+    state.PauseTiming();
+    auto responses = MakeResponses(request, accounter, state.range(0));
+    state.ResumeTiming();
+
+    server::http::impl::ResponseBatch batch;
+    for (auto& response : responses) {
+      batch.Add(*response);
+      if (batch.IsFull()) batch.Send(socket);
+    }
+    if (!batch.IsEmpty()) batch.Send(socket);
+  }
+  state.counters["writes_per_response"] = benchmark::Counter(
+      static_cast<double>(socket.writes) / state.range(0),
+      benchmark::Counter::kAvgIterations);
+}
+
+void http_streamed_response(benchmark::State& state) {
+  engine::RunStandalone([&] {
+    server::request::ResponseDataAccounter accounter{};
+    const server::http::HttpRequestImpl request{accounter};
+    CountingSocket socket;
+    const std::string chunk(256, 'x');
+
+    for ([[maybe_unused]] auto _ : state) {
+      state.PauseTiming();
+      server::http::HttpResponse response{request, accounter};
+      response.SetStreamBody();
+      {
+        auto producer = response.GetBodyProducer();
+        for (std::int64_t i = 0; i < state.range(0); ++i) {
+          if (!producer.Push(std::string{chunk})) std::abort();
+        }
+      }
+      state.ResumeTiming();
+
+      response.SendResponse(socket);
+    }
+    state.counters["writes_per_response"] = benchmark::Counter(
+        static_cast<double>(socket.writes), benchmark::Counter::kAvgIterations);
+  });
+}
+
 }  // namespace
 
 BENCHMARK(http_headers_serialization_inplace);
 BENCHMARK(http_headers_serialization_no_ostreams);
 BENCHMARK(http_headers_serialization_ostreams);
 BENCHMARK(HttpResponseSetHeaderBenchmark);
+BENCHMARK(http_pipelined_responses_one_by_one)
+    ->RangeMultiplier(4)
+    ->Range(1, 64);
+BENCHMARK(http_pipelined_responses_batched)->RangeMultiplier(4)->Range(1, 64);
+BENCHMARK(http_streamed_response)->Arg(1)->Arg(16);
 
 USERVER_NAMESPACE_END
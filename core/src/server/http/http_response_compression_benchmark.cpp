@@ -0,0 +1,93 @@
+#include <benchmark/benchmark.h>
+
+#include <cstdint>
+#include <string>
+#include <string_view>
+
+#include <server/http/stream_body_compressor.hpp>
+#include <server/middlewares/compression.hpp>
+#include <userver/http/common_headers.hpp>
+#include <userver/server/http/http_response.hpp>
+
+USERVER_NAMESPACE_BEGIN
+
+namespace {
+
+using server::middlewares::ContentEncoding;
+
+constexpr std::size_t kStreamChunkSize = 4096;
+
+std::string GenerateJsonData(std::size_t size) {
+  std::string output;
+  for (std::size_t i = 0; output.size() < size; ++i) {
+    output += R"({"id":)" + std::to_string(i) +
+              R"(,"name":"item","tags":["a","b"]},)";
+  }
+  output.resize(size);
+  return output;
+}
+
+server::middlewares::CompressionSettings MakeSettings(int level) {
+  server::middlewares::CompressionSettings settings;
+  settings.enabled = true;
+  settings.gzip_level = level;
+  settings.zstd_level = level;
+  return settings;
+}
+
+void http_response_compress_body(benchmark::State& state) {
+  const auto data = GenerateJsonData(state.range(0));
+  const auto encoding = static_cast<ContentEncoding>(state.range(1));
+  const auto settings = MakeSettings(static_cast<int>(state.range(2)));
+
+  std::size_t compressed_size = 0;
+  for ([[maybe_unused]] auto _ : state) {
+    const auto compressed =
+        server::middlewares::CompressBody(settings, encoding, data);
+    compressed_size = compressed.size();
+    benchmark::DoNotOptimize(compressed);
+  }
+  state.SetBytesProcessed(state.iterations() * data.size());
+  state.counters["ratio"] =
+      static_cast<double>(data.size()) / static_cast<double>(compressed_size);
+}
+
+void http_response_compress_stream(benchmark::State& state) {
+  const auto data = GenerateJsonData(state.range(0));
+  const auto encoding = static_cast<ContentEncoding>(state.range(1));
+  const auto settings = MakeSettings(1);
+
+  for ([[maybe_unused]] auto _ : state) {
+    server::http::HttpResponse::HeadersMap headers;
+    headers[USERVER_NAMESPACE::http::headers::kContentType] =
+        "application/json";
+
+    auto compressor =
+        server::middlewares::MakeStreamBodyCompressor(settings, encoding);
+    if (!compressor->Start(server::http::HttpStatus::kOk, headers)) {
+      state.SkipWithError("Response is not compressible");
+      break;
+    }
+    for (std::size_t pos = 0; pos < data.size(); pos += kStreamChunkSize) {
+      benchmark::DoNotOptimize(compressor->Compress(
+          std::string_view{data}.substr(pos, kStreamChunkSize)));
+    }
+    benchmark::DoNotOptimize(compressor->Finish());
+  }
+  state.SetBytesProcessed(state.iterations() * data.size());
+}
+
+constexpr auto kGzip = static_cast<std::int64_t>(ContentEncoding::kGzip);
+constexpr auto kZstd = static_cast<std::int64_t>(ContentEncoding::kZstd);
+
+}  // namespace
+
+BENCHMARK(http_response_compress_body)
+    ->ArgsProduct({benchmark::CreateRange(1 << 10, 1 << 20, 16),
+                   {kGzip, kZstd},
+                   {1, 6, 9}});
+BENCHMARK(http_response_compress_stream)
+    ->ArgsProduct(
+        {benchmark::CreateRange(1 << 14, 1 << 20, 8), {kGzip, kZstd}});
+
+USERVER_NAMESPACE_END
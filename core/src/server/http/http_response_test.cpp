@@ -5,7 +5,9 @@
 #include <gmock/gmock.h>
 
 #include <server/http/http_request_impl.hpp>
+#include <server/http/response_batch.hpp>
 #include <userver/engine/async.hpp>
+#include <userver/engine/sleep.hpp>
 #include <userver/http/common_headers.hpp>
 #include <userver/internal/net/net_listener.hpp>
 #include <userver/server/http/http_response.hpp>
@@ -13,6 +15,40 @@
 
 USERVER_NAMESPACE_BEGIN
 
+namespace {
+
+// Records each write call as a separate string
+class WritesRecorder final : public engine::io::RwBase {
+ public:
+  bool IsValid() const override { return true; }
+
+  bool WaitReadable(engine::Deadline) override { return false; }
+
+  size_t ReadSome(void*, size_t, engine::Deadline) override { return 0; }
+
+  size_t ReadAll(void*, size_t, engine::Deadline) override { return 0; }
+
+  bool WaitWriteable(engine::Deadline) override { return true; }
+
+  size_t WriteAll(const void* buf, size_t len, engine::Deadline) override {
+    writes.emplace_back(static_cast<const char*>(buf), len);
+    return len;
+  }
+
+  size_t WriteAll(const engine::io::IoData* list, std::size_t list_size,
+                  engine::Deadline) override {
+    auto& write = writes.emplace_back();
+    for (std::size_t i = 0; i < list_size; ++i) {
+      write.append(static_cast<const char*>(list[i].data), list[i].len);
+    }
+    return write.size();
+  }
+
+  std::vector<std::string> writes;
+};
+
+}  // namespace
+
 UTEST(HttpResponse, Smoke) {
   const auto test_deadline =
       engine::Deadline::FromDuration(utest::kMaxTestWaitTime);
@@ -117,6 +153,91 @@ UTEST_P(HttpResponseBody, ForbiddenBody) {
 INSTANTIATE_UTEST_SUITE_P(HttpResponseForbiddenBody, HttpResponseBody,
                           testing::Values(100, 101, 150, 199, 304, 204));
 
+UTEST(HttpResponse, StreamedReadyChunksInSingleWrite) {
+  server::request::ResponseDataAccounter accounter;
+  server::http::HttpRequestImpl request{accounter};
+  server::http::HttpResponse response{request, accounter};
+
+  response.SetStreamBody();
+  {
+    auto producer = response.GetBodyProducer();
+    ASSERT_TRUE(producer.Push("hello"));
+    ASSERT_TRUE(producer.Push(std::string(20, 'x')));
+  }
+
+  WritesRecorder socket;
+  response.SendResponse(socket);
+
+  ASSERT_EQ(socket.writes.size(), 1);
+  const auto& reply = socket.writes.front();
+  EXPECT_THAT(reply,
+              testing::HasSubstr("\r\nTransfer-Encoding: chunked\r\n"));
+  EXPECT_THAT(reply, testing::EndsWith("\r\n\r\n5\r\nhello\r\n14\r\n" +
+                                       std::string(20, 'x') +
+                                       "\r\n0\r\n\r\n"));
+  EXPECT_EQ(response.BytesSent(), reply.size());
+}
+
+UTEST(HttpResponse, StreamedHeadersSentBeforeWaiting) {
+  server::request::ResponseDataAccounter accounter;
+  server::http::HttpRequestImpl request{accounter};
+  server::http::HttpResponse response{request, accounter};
+
+  response.SetStreamBody();
+  auto producer = response.GetBodyProducer();
+
+  WritesRecorder socket;
+  auto send_task = engine::AsyncNoSpan(
+      [&response, &socket] { response.SendResponse(socket); });
+
+  while (socket.writes.empty()) engine::Yield();
+  EXPECT_THAT(socket.writes.front(), testing::EndsWith("\r\n\r\n"));
+
+  ASSERT_TRUE(producer.Push("data"));
+  std::move(producer).Reset();
+  send_task.Get();
+
+  ASSERT_EQ(socket.writes.size(), 2);
+  EXPECT_EQ(socket.writes.back(), "4\r\ndata\r\n0\r\n\r\n");
+}
+
+UTEST(HttpResponse, BatchSingleWrite) {
+  server::request::ResponseDataAccounter accounter;
+  server::http::HttpRequestImpl request{accounter};
+
+  std::vector<std::unique_ptr<server::http::HttpResponse>> responses;
+  std::string expected;
+  for (const auto* body : {"first", "", "third"}) {
+    auto& response = *responses.emplace_back(
+        std::make_unique<server::http::HttpResponse>(request, accounter));
+    response.SetData(body);
+    response.SetHeader(std::string{http::headers::kDate}, "today");
+
+    server::http::HttpResponse single{request, accounter};
+    single.SetData(body);
+    single.SetHeader(std::string{http::headers::kDate}, "today");
+    WritesRecorder socket;
+    single.SendResponse(socket);
+    ASSERT_EQ(socket.writes.size(), 1);
+    expected += socket.writes.front();
+  }
+
+  server::http::impl::ResponseBatch batch;
+  for (auto& response : responses) batch.Add(*response);
+  EXPECT_EQ(batch.GetSize(), responses.size());
+
+  WritesRecorder socket;
+  EXPECT_EQ(batch.Send(socket), expected.size());
+  EXPECT_TRUE(batch.IsEmpty());
+
+  ASSERT_EQ(socket.writes.size(), 1);
+  EXPECT_EQ(socket.writes.front(), expected);
+  for (const auto& response : responses) {
+    EXPECT_TRUE(response->IsSent());
+    EXPECT_GT(response->BytesSent(), 0);
+  }
+}
+
 TEST(HttpResponse, GetHeaderDoesntThrow) {
   server::request::ResponseDataAccounter accounter{};
   const server::http::HttpRequestImpl request_impl{accounter};
@@ -6,6 +6,7 @@
 #include <vector>
 
 #include <userver/server/http/form_data_arg.hpp>
+#include <userver/utils/impl/monotonic_arena.hpp>
 #include <userver/utils/impl/transparent_hash.hpp>
 #include <userver/utils/str_icase.hpp>
 
@@ -13,9 +14,10 @@ USERVER_NAMESPACE_BEGIN
 
 namespace server::http {
 
-using FormDataArgs =
-    utils::impl::TransparentMap<std::string, std::vector<FormDataArg>,
-                                utils::StrCaseHash>;
+using FormDataArgs = utils::impl::TransparentMap<
+    std::string, std::vector<FormDataArg>, utils::StrCaseHash, std::equal_to<>,
+    utils::impl::ArenaAllocator<
+        std::pair<const std::string, std::vector<FormDataArg>>>>;
 
 bool IsMultipartFormDataContentType(std::string_view content_type);
 bool ParseMultipartFormData(const std::string& content_type,
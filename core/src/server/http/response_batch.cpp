@@ -0,0 +1,60 @@
+#include <server/http/response_batch.hpp>
+
+#include <algorithm>
+#include <chrono>
+
+#include <userver/server/http/http_response.hpp>
+#include <userver/utils/assert.hpp>
+#include <userver/utils/fast_scope_guard.hpp>
+
+USERVER_NAMESPACE_BEGIN
+
+namespace server::http::impl {
+
+ResponseBatch::ResponseBatch() = default;
+
+ResponseBatch::~ResponseBatch() = default;
+
+void ResponseBatch::Add(HttpResponse& response) {
+  UASSERT(!IsFull());
+
+  auto& entry = responses_.emplace_back();
+  entry.response = &response;
+  entry.body = response.SerializeNotStreamed(entry.header);
+  bodies_size_ += entry.body.size();
+}
+
+std::size_t ResponseBatch::Send(engine::io::RwBase& socket) {
+  const utils::FastScopeGuard clear_guard{[this]() noexcept { Clear(); }};
+
+  io_data_.clear();
+  io_data_.reserve(responses_.size() * 2);
+  for (const auto& entry : responses_) {
+    io_data_.push_back({entry.header.data(), entry.header.size()});
+    if (!entry.body.empty()) {
+      io_data_.push_back({entry.body.data(), entry.body.size()});
+    }
+  }
+
+  const auto sent_bytes =
+      socket.WriteAll(io_data_.data(), io_data_.size(), engine::Deadline{});
+
+  const auto now = std::chrono::steady_clock::now();
+  auto bytes_left = sent_bytes;
+  for (const auto& entry : responses_) {
+    const auto size = std::min(entry.header.size() + entry.body.size(),
+                               bytes_left);
+    bytes_left -= size;
+    entry.response->SetSent(size, now);
+  }
+  return sent_bytes;
+}
+
+void ResponseBatch::Clear() noexcept {
+  responses_.clear();
+  bodies_size_ = 0;
+}
+
+}  // namespace server::http::impl
+
+USERVER_NAMESPACE_END
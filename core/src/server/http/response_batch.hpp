@@ -0,0 +1,77 @@
+#pragma once
+
+#include <cstddef>
+#include <deque>
+#include <string_view>
+#include <vector>
+
+#include <userver/engine/io/common.hpp>
+#include <userver/http/predefined_header.hpp>
+#include <userver/utils/small_string.hpp>
+
+USERVER_NAMESPACE_BEGIN
+
+namespace server::http {
+
+class HttpResponse;
+
+namespace impl {
+
+/// @brief Ready responses to pipelined HTTP/1.1 requests that are written to
+/// the socket with a single gathered write.
+///
+/// Only the responses that are not streamed may be added.
+class ResponseBatch final {
+ public:
+  /// Keeps the gather list far below IOV_MAX
+  static constexpr std::size_t kMaxResponses = 64;
+
+  /// Total size of the bodies after which the batch should be flushed
+  static constexpr std::size_t kMaxBodiesSize = 256 * 1024;
+
+  ResponseBatch();
+  ~ResponseBatch();
+
+  ResponseBatch(ResponseBatch&&) = delete;
+  ResponseBatch& operator=(ResponseBatch&&) = delete;
+
+  /// Serializes the response headers, the response must outlive the batch
+  void Add(HttpResponse& response);
+
+  bool IsEmpty() const noexcept { return responses_.empty(); }
+
+  bool IsFull() const noexcept {
+    return responses_.size() >= kMaxResponses ||
+           bodies_size_ >= kMaxBodiesSize;
+  }
+
+  std::size_t GetSize() const noexcept { return responses_.size(); }
+
+  /// Writes all the responses and marks them as sent. The responses that
+  /// were not written completely because the peer closed the connection
+  /// are accounted with the bytes that made it to the socket. The batch is
+  /// empty afterwards, on exceptions the responses are left not sent.
+  /// @returns total number of bytes written
+  std::size_t Send(engine::io::RwBase& socket);
+
+  /// Drops the responses without marking them as sent
+  void Clear() noexcept;
+
+ private:
+  struct Entry final {
+    HttpResponse* response{nullptr};
+    USERVER_NAMESPACE::http::headers::HeadersString header;
+    std::string_view body;
+  };
+
+  // std::deque keeps the headers in place while the batch grows
+  std::deque<Entry> responses_;
+  std::vector<engine::io::IoData> io_data_;
+  std::size_t bodies_size_{0};
+};
+
+}  // namespace impl
+
+}  // namespace server::http
+
+USERVER_NAMESPACE_END
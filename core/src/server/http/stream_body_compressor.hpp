@@ -0,0 +1,31 @@
+#pragma once
+
+#include <string>
+#include <string_view>
+
+#include <userver/server/http/http_response.hpp>
+
+USERVER_NAMESPACE_BEGIN
+
+namespace server::http::impl {
+
+/// Compresses the streamed response body right before it is sent, when the
+/// final status and headers are known.
+class StreamBodyCompressor {
+ public:
+  virtual ~StreamBodyCompressor() = default;
+
+  /// Called once before the headers are sent. Returns false if the body should
+  /// be sent as is, otherwise adjusts the headers (Content-Encoding, Vary).
+  virtual bool Start(HttpStatus status, HttpResponse::HeadersMap& headers) = 0;
+
+  /// Compresses and flushes a body chunk.
+  virtual std::string Compress(std::string_view chunk) = 0;
+
+  /// Returns the end of the compressed stream.
+  virtual std::string Finish() = 0;
+};
+
+}  // namespace server::http::impl
+
+USERVER_NAMESPACE_END
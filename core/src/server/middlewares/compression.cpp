@@ -0,0 +1,429 @@
+#include <server/middlewares/compression.hpp>
+
+#include <algorithm>
+#include <type_traits>
+#include <variant>
+
+#include <compression/gzip.hpp>
+#include <server/http/stream_body_compressor.hpp>
+#include <userver/compression/zstd.hpp>
+
+#include <userver/components/component_config.hpp>
+#include <userver/formats/yaml/serialize.hpp>
+#include <userver/http/common_headers.hpp>
+#include <userver/logging/log.hpp>
+#include <userver/server/http/http_request.hpp>
+#include <userver/server/http/http_response.hpp>
+#include <userver/tracing/scope_time.hpp>
+#include <userver/utils/assert.hpp>
+#include <userver/utils/str_icase.hpp>
+#include <userver/yaml_config/merge_schemas.hpp>
+#include <userver/yaml_config/yaml_config.hpp>
+
+USERVER_NAMESPACE_BEGIN
+
+namespace server::middlewares {
+
+namespace {
+
+constexpr std::string_view kWhitespace = " \t";
+
+std::string_view TrimView(std::string_view value) {
+  const auto begin = value.find_first_not_of(kWhitespace);
+  if (begin == std::string_view::npos) return {};
+  const auto end = value.find_last_not_of(kWhitespace);
+  return value.substr(begin, end - begin + 1);
+}
+
+// Returns q-value in thousandths, as RFC 9110 allows at most 3 digits after
+// the point. Malformed values are treated as q=0.
+int ParseQValue(std::string_view params) {
+  while (!params.empty()) {
+    const auto semicolon = params.find(';');
+    auto param = TrimView(params.substr(0, semicolon));
+    params = semicolon == std::string_view::npos ? std::string_view{}
+                                                 : params.substr(semicolon + 1);
+
+    if (param.size() < 2 || (param[0] != 'q' && param[0] != 'Q') ||
+        param[1] != '=') {
+      continue;
+    }
+    param.remove_prefix(2);
+    if (param.empty() || (param[0] != '0' && param[0] != '1')) return 0;
+
+    int integer = param[0] - '0';
+    int fraction = 0;
+    int digits = 0;
+    if (param.size() > 1) {
+      if (param[1] != '.') return 0;
+      for (const char c : param.substr(2)) {
+        if (c < '0' || c > '9' || digits == 3) return 0;
+        fraction = fraction * 10 + (c - '0');
+        ++digits;
+      }
+    }
+    for (; digits < 3; ++digits) fraction *= 10;
+    const int q = integer * 1000 + fraction;
+    return q > 1000 ? 0 : q;
+  }
+  return 1000;
+}
+
+// Media type without parameters, e.g. "application/json"
+std::string_view GetMediaType(std::string_view content_type) {
+  return TrimView(content_type.substr(0, content_type.find(';')));
+}
+
+bool IsContentTypeAllowed(const std::vector<std::string>& allowed,
+                          std::string_view content_type) {
+  const auto media_type = GetMediaType(content_type);
+  if (media_type.empty()) return false;
+
+  const utils::StrIcaseEqual equal;
+  for (std::string_view pattern : allowed) {
+    if (pattern.size() > 2 && pattern.substr(pattern.size() - 2) == "/*") {
+      pattern.remove_suffix(1);
+      if (media_type.size() > pattern.size() &&
+          equal(media_type.substr(0, pattern.size()), pattern)) {
+        return true;
+      }
+    } else if (equal(media_type, pattern)) {
+      return true;
+    }
+  }
+  return false;
+}
+
+bool StatusAllowsBody(http::HttpStatus status) {
+  const auto code = static_cast<int>(status);
+  return code >= 200 && code != 204 && code != 304;
+}
+
+void AddVaryAcceptEncoding(std::string& vary) {
+  if (vary.empty()) {
+    vary = USERVER_NAMESPACE::http::headers::kAcceptEncoding;
+  } else if (!utils::StrIcaseEqual{}(TrimView(vary), "*")) {
+    vary.append(", ").append(
+        std::string_view{USERVER_NAMESPACE::http::headers::kAcceptEncoding});
+  }
+}
+
+class StreamBodyCompressorImpl final : public http::impl::StreamBodyCompressor {
+ public:
+  StreamBodyCompressorImpl(const CompressionSettings& settings,
+                           ContentEncoding encoding)
+      : settings_(settings), encoding_(encoding) {}
+
+  bool Start(http::HttpStatus status,
+             http::HttpResponse::HeadersMap& headers) override {
+    using USERVER_NAMESPACE::http::headers::kContentEncoding;
+    using USERVER_NAMESPACE::http::headers::kContentType;
+    using USERVER_NAMESPACE::http::headers::kVary;
+
+    const auto content_type_it = headers.find(kContentType);
+    const auto content_encoding_it = headers.find(kContentEncoding);
+    if (!IsCompressibleResponse(
+            settings_, status,
+            content_type_it == headers.end() ? std::string_view{}
+                                             : content_type_it->second,
+            content_encoding_it == headers.end()
+                ? std::string_view{}
+                : content_encoding_it->second)) {
+      return false;
+    }
+
+    if (encoding_ == ContentEncoding::kGzip) {
+      compressor_.emplace<compression::gzip::StreamCompressor>(
+          settings_.gzip_level);
+    } else {
+      compressor_.emplace<compression::zstd::StreamCompressor>(
+          settings_.zstd_level);
+    }
+
+    headers[kContentEncoding] = std::string{ToString(encoding_)};
+    AddVaryAcceptEncoding(headers[kVary]);
+    return true;
+  }
+
+  std::string Compress(std::string_view chunk) override {
+    return std::visit(
+        [chunk](auto& compressor) -> std::string {
+          if constexpr (std::is_same_v<std::decay_t<decltype(compressor)>,
+                                       std::monostate>) {
+            UINVARIANT(false, "Compress() called before Start()");
+          } else {
+            return compressor.Compress(chunk);
+          }
+        },
+        compressor_);
+  }
+
+  std::string Finish() override {
+    return std::visit(
+        [](auto& compressor) -> std::string {
+          if constexpr (std::is_same_v<std::decay_t<decltype(compressor)>,
+                                       std::monostate>) {
+            UINVARIANT(false, "Finish() called before Start()");
+          } else {
+            return compressor.Finish();
+          }
+        },
+        compressor_);
+  }
+
+ private:
+  const CompressionSettings& settings_;
+  const ContentEncoding encoding_;
+  std::variant<std::monostate, compression::gzip::StreamCompressor,
+               compression::zstd::StreamCompressor>
+      compressor_;
+};
+
+}  // namespace
+
+ContentEncoding NegotiateContentEncoding(std::string_view accept_encoding) {
+  int gzip_q = -1;
+  int zstd_q = -1;
+  int wildcard_q = -1;
+
+  while (!accept_encoding.empty()) {
+    const auto comma = accept_encoding.find(',');
+    const auto item = accept_encoding.substr(0, comma);
+    accept_encoding = comma == std::string_view::npos
+                          ? std::string_view{}
+                          : accept_encoding.substr(comma + 1);
+
+    const auto semicolon = item.find(';');
+    const auto coding = TrimView(item.substr(0, semicolon));
+    const auto q = semicolon == std::string_view::npos
+                       ? 1000
+                       : ParseQValue(item.substr(semicolon + 1));
+
+    const utils::StrIcaseEqual equal;
+    if (equal(coding, "gzip") || equal(coding, "x-gzip")) {
+      gzip_q = std::max(gzip_q, q);
+    } else if (equal(coding, "zstd")) {
+      zstd_q = std::max(zstd_q, q);
+    } else if (coding == "*") {
+      wildcard_q = std::max(wildcard_q, q);
+    }
+  }
+
+  // Codings not listed explicitly are covered by "*"
+  if (gzip_q < 0) gzip_q = wildcard_q;
+  if (zstd_q < 0) zstd_q = wildcard_q;
+
+  if (zstd_q > 0 && zstd_q >= gzip_q) return ContentEncoding::kZstd;
+  if (gzip_q > 0) return ContentEncoding::kGzip;
+  return ContentEncoding::kIdentity;
+}
+
+std::string_view ToString(ContentEncoding encoding) {
+  switch (encoding) {
+    case ContentEncoding::kIdentity:
+      return "identity";
+    case ContentEncoding::kGzip:
+      return "gzip";
+    case ContentEncoding::kZstd:
+      return "zstd";
+  }
+  UINVARIANT(false, "Unexpected content encoding");
+}
+
+CompressionSettings ParseCompressionSettings(
+    const yaml_config::YamlConfig& value, const CompressionSettings& defaults) {
+  CompressionSettings settings;
+  settings.enabled = value["enabled"].As<bool>(defaults.enabled);
+  settings.min_size = value["min-size"].As<std::size_t>(defaults.min_size);
+  settings.gzip_level = value["gzip-level"].As<int>(defaults.gzip_level);
+  settings.zstd_level = value["zstd-level"].As<int>(defaults.zstd_level);
+  settings.content_types =
+      value["content-types"].As<std::vector<std::string>>(
+          defaults.content_types);
+  return settings;
+}
+
+bool IsCompressibleResponse(const CompressionSettings& settings,
+                            http::HttpStatus status,
+                            std::string_view content_type,
+                            std::string_view content_encoding) {
+  if (!StatusAllowsBody(status)) return false;
+
+  // Already encoded by the handler
+  const auto encoding = TrimView(content_encoding);
+  if (!encoding.empty() && !utils::StrIcaseEqual{}(encoding, "identity")) {
+    return false;
+  }
+
+  return IsContentTypeAllowed(settings.content_types, content_type);
+}
+
+std::string CompressBody(const CompressionSettings& settings,
+                         ContentEncoding encoding, std::string_view body) {
+  switch (encoding) {
+    case ContentEncoding::kGzip:
+      return compression::gzip::Compress(body, settings.gzip_level);
+    case ContentEncoding::kZstd:
+      return compression::zstd::Compress(body, settings.zstd_level);
+    case ContentEncoding::kIdentity:
+      break;
+  }
+  UINVARIANT(false, "Unexpected content encoding");
+}
+
+std::unique_ptr<http::impl::StreamBodyCompressor> MakeStreamBodyCompressor(
+    const CompressionSettings& settings, ContentEncoding encoding) {
+  UINVARIANT(encoding != ContentEncoding::kIdentity,
+             "Nothing to compress with identity encoding");
+  return std::make_unique<StreamBodyCompressorImpl>(settings, encoding);
+}
+
+Compression::Compression(CompressionSettings settings)
+    : settings_{std::move(settings)} {}
+
+void Compression::HandleRequest(http::HttpRequest& request,
+                                request::RequestContext& context) const {
+  const auto encoding = settings_.enabled
+                            ? NegotiateContentEncoding(request.GetHeader(
+                                  USERVER_NAMESPACE::http::headers::
+                                      kAcceptEncoding))
+                            : ContentEncoding::kIdentity;
+  if (encoding == ContentEncoding::kIdentity) {
+    Next(request, context);
+    return;
+  }
+
+  auto& response = request.GetHttpResponse();
+  if (response.IsBodyStreamed()) {
+    // Status and headers of a streamed response are not known yet, the
+    // decision is made right before they are sent.
+    response.SetStreamBodyCompressor(
+        MakeStreamBodyCompressor(settings_, encoding));
+    Next(request, context);
+    return;
+  }
+
+  Next(request, context);
+  CompressResponseBody(response, encoding);
+}
+
+void Compression::CompressResponseBody(http::HttpResponse& response,
+                                       ContentEncoding encoding) const {
+  using USERVER_NAMESPACE::http::headers::kContentEncoding;
+  using USERVER_NAMESPACE::http::headers::kContentType;
+  using USERVER_NAMESPACE::http::headers::kVary;
+
+  if (!IsCompressibleResponse(settings_, response.GetStatus(),
+                              response.GetHeader(kContentType),
+                              response.GetHeader(kContentEncoding))) {
+    return;
+  }
+
+  // The response depends on Accept-Encoding even if it turns out to be too
+  // small to compress, caches should know that.
+  auto vary = response.GetHeader(kVary);
+  AddVaryAcceptEncoding(vary);
+  response.SetHeader(kVary, std::move(vary));
+
+  if (response.GetData().size() < settings_.min_size) return;
+
+  const auto scope_time = tracing::ScopeTime::CreateOptionalScopeTime(
+      "http_compress_response_body");
+  try {
+    response.SetData(CompressBody(settings_, encoding, response.GetData()));
+    response.SetContentEncoding(std::string{ToString(encoding)});
+  } catch (const std::exception& e) {
+    LOG_LIMITED_WARNING() << "Failed to compress response body, sending it "
+                             "uncompressed: "
+                          << e;
+  }
+}
+
+CompressionFactory::CompressionFactory(
+    const components::ComponentConfig& config,
+    const components::ComponentContext& context)
+    : HttpMiddlewareFactoryBase{config, context},
+      settings_{ParseCompressionSettings(config, CompressionSettings{})} {}
+
+std::unique_ptr<HttpMiddlewareBase> CompressionFactory::Create(
+    const handlers::HttpHandlerBase&,
+    yaml_config::YamlConfig middleware_config) const {
+  return std::make_unique<Compression>(
+      ParseCompressionSettings(middleware_config, settings_));
+}
+
+yaml_config::Schema CompressionFactory::GetMiddlewareConfigSchema() const {
+  return formats::yaml::FromString(R"(
+type: object
+description: per-handler overrides of the response compression settings
+additionalProperties: false
+properties:
+    enabled:
+        type: boolean
+        description: compress responses of the handler
+    min-size:
+        type: integer
+        minimum: 0
+        description: responses with smaller bodies are sent uncompressed
+    gzip-level:
+        type: integer
+        minimum: 1
+        maximum: 9
+        description: gzip compression level
+    zstd-level:
+        type: integer
+        minimum: 1
+        maximum: 19
+        description: zstd compression level
+    content-types:
+        type: array
+        items:
+            type: string
+            description: media type, 'type/*' matches any subtype
+        description: media types of the responses to compress
+)")
+      .As<yaml_config::Schema>();
+}
+
+yaml_config::Schema CompressionFactory::GetStaticConfigSchema() {
+  return yaml_config::MergeSchemas<HttpMiddlewareFactoryBase>(R"(
+type: object
+description: |
+    Compresses response bodies according to the Accept-Encoding request
+    header, the settings may be overridden in the handler config
+additionalProperties: false
+properties:
+    enabled:
+        type: boolean
+        description: compress responses by default
+        defaultDescription: false
+    min-size:
+        type: integer
+        minimum: 0
+        description: responses with smaller bodies are sent uncompressed
+        defaultDescription: 1024
+    gzip-level:
+        type: integer
+        minimum: 1
+        maximum: 9
+        description: gzip compression level
+        defaultDescription: 6
+    zstd-level:
+        type: integer
+        minimum: 1
+        maximum: 19
+        description: zstd compression level
+        defaultDescription: 3
+    content-types:
+        type: array
+        items:
+            type: string
+            description: media type, 'type/*' matches any subtype
+        description: media types of the responses to compress
+        defaultDescription: application/json, application/javascript, application/xml, text/*
+)");
+}
+
+}  // namespace server::middlewares
+
+USERVER_NAMESPACE_END
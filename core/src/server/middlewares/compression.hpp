@@ -0,0 +1,112 @@
+#pragma once
+
+#include <cstddef>
+#include <memory>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include <userver/server/http/http_status.hpp>
+#include <userver/server/middlewares/builtin.hpp>
+#include <userver/server/middlewares/http_middleware_base.hpp>
+
+USERVER_NAMESPACE_BEGIN
+
+namespace server::http {
+class HttpResponse;
+
+namespace impl {
+class StreamBodyCompressor;
+}  // namespace impl
+}  // namespace server::http
+
+namespace server::middlewares {
+
+enum class ContentEncoding {
+  kIdentity,
+  kGzip,
+  kZstd,
+};
+
+/// Picks the best supported encoding from the Accept-Encoding header value,
+/// zstd is preferred over gzip for equal q-values.
+ContentEncoding NegotiateContentEncoding(std::string_view accept_encoding);
+
+std::string_view ToString(ContentEncoding encoding);
+
+struct CompressionSettings final {
+  bool enabled{false};
+  std::size_t min_size{1024};
+  int gzip_level{6};
+  int zstd_level{3};
+  std::vector<std::string> content_types{
+      "application/json", "application/javascript", "application/xml",
+      "text/*",
+  };
+};
+
+/// Parses the settings, missing options are taken from `defaults`
+CompressionSettings ParseCompressionSettings(
+    const yaml_config::YamlConfig& value, const CompressionSettings& defaults);
+
+/// Whether a response with this status and headers may be compressed
+bool IsCompressibleResponse(const CompressionSettings& settings,
+                            http::HttpStatus status,
+                            std::string_view content_type,
+                            std::string_view content_encoding);
+
+/// Compresses the whole body with the configured level
+std::string CompressBody(const CompressionSettings& settings,
+                         ContentEncoding encoding, std::string_view body);
+
+/// Compressor of a streamed response body, `settings` must outlive it
+std::unique_ptr<http::impl::StreamBodyCompressor> MakeStreamBodyCompressor(
+    const CompressionSettings& settings, ContentEncoding encoding);
+
+class Compression final : public HttpMiddlewareBase {
+ public:
+  static constexpr std::string_view kName = builtin::kCompression;
+
+  explicit Compression(CompressionSettings settings);
+
+ private:
+  void HandleRequest(http::HttpRequest& request,
+                     request::RequestContext& context) const override;
+
+  void CompressResponseBody(http::HttpResponse& response,
+                            ContentEncoding encoding) const;
+
+  const CompressionSettings settings_;
+};
+
+class CompressionFactory final : public HttpMiddlewareFactoryBase {
+ public:
+  static constexpr std::string_view kName = Compression::kName;
+
+  CompressionFactory(const components::ComponentConfig&,
+                     const components::ComponentContext&);
+
+  static yaml_config::Schema GetStaticConfigSchema();
+
+ private:
+  std::unique_ptr<HttpMiddlewareBase> Create(
+      const handlers::HttpHandlerBase&,
+      yaml_config::YamlConfig middleware_config) const override;
+
+  yaml_config::Schema GetMiddlewareConfigSchema() const override;
+
+  const CompressionSettings settings_;
+};
+
+}  // namespace server::middlewares
+
+template <>
+inline constexpr bool
+    components::kHasValidate<server::middlewares::CompressionFactory> = true;
+
+template <>
+inline constexpr auto
+    components::kConfigFileMode<server::middlewares::CompressionFactory> =
+        ConfigFileMode::kNotRequired;
+
+USERVER_NAMESPACE_END
@@ -0,0 +1,229 @@
+#include <server/middlewares/compression.hpp>
+
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include <fmt/format.h>
+#include <gmock/gmock.h>
+
+#include <compression/gzip.hpp>
+#include <server/http/http_request_impl.hpp>
+#include <server/http/stream_body_compressor.hpp>
+#include <userver/compression/zstd.hpp>
+#include <userver/engine/io/common.hpp>
+#include <userver/http/common_headers.hpp>
+#include <userver/server/http/http_response.hpp>
+#include <userver/utest/utest.hpp>
+
+USERVER_NAMESPACE_BEGIN
+
+namespace {
+
+using server::http::HttpStatus;
+using server::middlewares::ContentEncoding;
+using server::middlewares::NegotiateContentEncoding;
+
+// Stores everything written into it
+class WritesRecorder final : public engine::io::RwBase {
+ public:
+  bool IsValid() const override { return true; }
+
+  bool WaitReadable(engine::Deadline) override { return false; }
+
+  size_t ReadSome(void*, size_t, engine::Deadline) override { return 0; }
+
+  size_t ReadAll(void*, size_t, engine::Deadline) override { return 0; }
+
+  bool WaitWriteable(engine::Deadline) override { return true; }
+
+  size_t WriteAll(const void* buf, size_t len, engine::Deadline) override {
+    data.append(static_cast<const char*>(buf), len);
+    return len;
+  }
+
+  size_t WriteAll(const engine::io::IoData* list, std::size_t list_size,
+                  engine::Deadline) override {
+    std::size_t result = 0;
+    for (std::size_t i = 0; i < list_size; ++i) {
+      data.append(static_cast<const char*>(list[i].data), list[i].len);
+      result += list[i].len;
+    }
+    return result;
+  }
+
+  std::string data;
+};
+
+struct ParsedResponse final {
+  std::string headers;
+  std::vector<std::string> chunks;
+};
+
+ParsedResponse ParseChunkedResponse(std::string_view reply) {
+  ParsedResponse result;
+  const auto headers_end = reply.find("\r\n\r\n");
+  if (headers_end == std::string_view::npos) {
+    ADD_FAILURE() << "No end of headers in " << reply;
+    return result;
+  }
+  result.headers = reply.substr(0, headers_end + 2);
+  reply.remove_prefix(headers_end + 4);
+
+  while (true) {
+    const auto size_end = reply.find("\r\n");
+    if (size_end == std::string_view::npos) {
+      ADD_FAILURE() << "Truncated chunked body";
+      return result;
+    }
+    const auto size = std::stoul(std::string{reply.substr(0, size_end)},
+                                 nullptr, 16);
+    reply.remove_prefix(size_end + 2);
+    if (size == 0) break;
+
+    result.chunks.emplace_back(reply.substr(0, size));
+    reply.remove_prefix(size + 2);
+  }
+  EXPECT_EQ(reply, "\r\n");
+  return result;
+}
+
+std::string Decompress(ContentEncoding encoding, std::string_view data,
+                       std::size_t max_size) {
+  if (encoding == ContentEncoding::kGzip) {
+    return compression::gzip::Decompress(data, max_size);
+  }
+  return compression::zstd::Decompress(data, max_size);
+}
+
+std::string SendStreamed(server::http::HttpResponse& response,
+                         const std::vector<std::string>& body_parts) {
+  {
+    auto producer = response.GetBodyProducer();
+    for (const auto& part : body_parts) {
+      EXPECT_TRUE(producer.Push(std::string{part}));
+    }
+  }
+
+  WritesRecorder socket;
+  response.SendResponse(socket);
+  return std::move(socket.data);
+}
+
+class CompressionMiddlewareStream
+    : public testing::TestWithParam<ContentEncoding> {};
+
+}  // namespace
+
+TEST(CompressionMiddleware, NegotiateContentEncoding) {
+  EXPECT_EQ(NegotiateContentEncoding(""), ContentEncoding::kIdentity);
+  EXPECT_EQ(NegotiateContentEncoding("identity"), ContentEncoding::kIdentity);
+  EXPECT_EQ(NegotiateContentEncoding("br"), ContentEncoding::kIdentity);
+  EXPECT_EQ(NegotiateContentEncoding("gzip"), ContentEncoding::kGzip);
+  EXPECT_EQ(NegotiateContentEncoding("GZIP"), ContentEncoding::kGzip);
+  EXPECT_EQ(NegotiateContentEncoding("gzip, deflate, br, zstd"),
+            ContentEncoding::kZstd);
+  EXPECT_EQ(NegotiateContentEncoding("zstd;q=0.5, gzip"),
+            ContentEncoding::kGzip);
+  EXPECT_EQ(NegotiateContentEncoding("zstd;q=0, gzip;q=0.1"),
+            ContentEncoding::kGzip);
+  EXPECT_EQ(NegotiateContentEncoding("gzip ; q=0.000"),
+            ContentEncoding::kIdentity);
+  EXPECT_EQ(NegotiateContentEncoding("*"), ContentEncoding::kZstd);
+  EXPECT_EQ(NegotiateContentEncoding("zstd;q=0, *"), ContentEncoding::kGzip);
+  EXPECT_EQ(NegotiateContentEncoding("*;q=0"), ContentEncoding::kIdentity);
+  EXPECT_EQ(NegotiateContentEncoding("gzip;q=1.5"), ContentEncoding::kIdentity);
+}
+
+TEST(CompressionMiddleware, IsCompressibleResponse) {
+  const server::middlewares::CompressionSettings settings;
+  using server::middlewares::IsCompressibleResponse;
+
+  EXPECT_TRUE(IsCompressibleResponse(settings, HttpStatus::kOk,
+                                     "application/json; charset=utf-8", ""));
+  EXPECT_TRUE(IsCompressibleResponse(settings, HttpStatus::kNotFound,
+                                     "text/html", "identity"));
+  EXPECT_FALSE(
+      IsCompressibleResponse(settings, HttpStatus::kOk, "image/png", ""));
+  EXPECT_FALSE(IsCompressibleResponse(settings, HttpStatus::kOk, "", ""));
+  EXPECT_FALSE(IsCompressibleResponse(settings, HttpStatus::kOk,
+                                      "application/json", "gzip"));
+  EXPECT_FALSE(IsCompressibleResponse(settings, HttpStatus::kNoContent,
+                                      "application/json", ""));
+  EXPECT_FALSE(IsCompressibleResponse(settings, HttpStatus::kNotModified,
+                                      "application/json", ""));
+}
+
+TEST(CompressionMiddleware, CompressBody) {
+  const server::middlewares::CompressionSettings settings;
+  const std::string body(4096, 'a');
+
+  const auto gzipped =
+      server::middlewares::CompressBody(settings, ContentEncoding::kGzip, body);
+  EXPECT_EQ(compression::gzip::Decompress(gzipped, body.size()), body);
+
+  const auto zstded =
+      server::middlewares::CompressBody(settings, ContentEncoding::kZstd, body);
+  EXPECT_EQ(compression::zstd::Decompress(zstded, body.size()), body);
+}
+
+UTEST_P(CompressionMiddlewareStream, RoundTrip) {
+  const auto encoding = GetParam();
+  const server::middlewares::CompressionSettings settings;
+  const std::vector<std::string> body_parts{
+      R"({"items":[)", std::string(5000, 'a'), R"("b","c"]})"};
+  std::string body;
+  for (const auto& part : body_parts) body += part;
+
+  server::request::ResponseDataAccounter accounter;
+  server::http::HttpRequestImpl request{accounter};
+  server::http::HttpResponse response{request, accounter};
+  response.SetStreamBody();
+  response.SetHeader(http::headers::kContentType, "application/json");
+  response.SetStreamBodyCompressor(
+      server::middlewares::MakeStreamBodyCompressor(settings, encoding));
+
+  const auto parsed = ParseChunkedResponse(SendStreamed(response, body_parts));
+  EXPECT_THAT(parsed.headers,
+              testing::HasSubstr(fmt::format("\r\n{}: {}\r\n",
+                                             http::headers::kContentEncoding,
+                                             ToString(encoding))));
+  EXPECT_THAT(parsed.headers,
+              testing::HasSubstr(fmt::format("\r\n{}: {}\r\n",
+                                             http::headers::kVary,
+                                             http::headers::kAcceptEncoding)));
+  EXPECT_THAT(parsed.headers, testing::Not(testing::HasSubstr(
+                                  http::headers::kContentLength)));
+
+  // Every chunk is flushed, so the client may decode the data received so far
+  ASSERT_GE(parsed.chunks.size(), body_parts.size());
+  std::string compressed;
+  for (const auto& chunk : parsed.chunks) compressed += chunk;
+  EXPECT_EQ(Decompress(encoding, compressed, body.size()), body);
+  EXPECT_LT(compressed.size(), body.size());
+}
+
+UTEST_P(CompressionMiddlewareStream, NotCompressible) {
+  const server::middlewares::CompressionSettings settings;
+  const std::vector<std::string> body_parts{"first", "second"};
+
+  server::request::ResponseDataAccounter accounter;
+  server::http::HttpRequestImpl request{accounter};
+  server::http::HttpResponse response{request, accounter};
+  response.SetStreamBody();
+  response.SetHeader(http::headers::kContentType, "image/png");
+  response.SetStreamBodyCompressor(
+      server::middlewares::MakeStreamBodyCompressor(settings, GetParam()));
+
+  const auto parsed = ParseChunkedResponse(SendStreamed(response, body_parts));
+  EXPECT_THAT(parsed.headers, testing::Not(testing::HasSubstr(
+                                  http::headers::kContentEncoding)));
+  EXPECT_EQ(parsed.chunks, body_parts);
+}
+
+INSTANTIATE_UTEST_SUITE_P(CompressionMiddlewareEncodings,
+                          CompressionMiddlewareStream,
+                          testing::Values(ContentEncoding::kGzip,
+                                          ContentEncoding::kZstd));
+
+USERVER_NAMESPACE_END
@@ -8,6 +8,7 @@
 
 #include <server/middlewares/auth.hpp>
 #include <server/middlewares/baggage.hpp>
+#include <server/middlewares/compression.hpp>
 #include <server/middlewares/deadline_propagation.hpp>
 #include <server/middlewares/decompression.hpp>
 #include <server/middlewares/exceptions_handling.hpp>
@@ -42,6 +43,9 @@ MiddlewaresList DefaultPipeline() {
       std::string{builtin::kBaggage},
       std::string{builtin::kAuth},
       std::string{builtin::kDecompression},
+      // Compresses whatever the handler or the middlewares below produced,
+      // including error responses.
+      std::string{builtin::kCompression},
 
       // Transforms CustomHandlerException into response as specified by the
       // exception, transforms std::exception into Http500 without context.
@@ -62,6 +66,7 @@ components::ComponentList DefaultMiddlewareComponents() {
       .Append<AuthFactory>()
       .Append<DeadlinePropagationFactory>()
       .Append<DecompressionFactory>()
+      .Append<CompressionFactory>()
       .Append<SetAcceptEncodingFactory>()
       .Append<ExceptionsHandlingFactory>()
       .Append<UnknownExceptionsHandlingFactory>()
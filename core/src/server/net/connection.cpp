@@ -2,9 +2,13 @@
 
 #include <array>
 #include <system_error>
+#include <unordered_map>
+#include <utility>
 #include <vector>
 
+#include <server/http/http_request_impl.hpp>
 #include <server/http/request_handler_base.hpp>
+#include <server/http/response_batch.hpp>
 
 #include <userver/engine/async.hpp>
 #include <userver/engine/exception.hpp>
@@ -14,6 +18,7 @@
 #include <userver/engine/wait_any.hpp>
 #include <userver/logging/log.hpp>
 #include <userver/server/request/request_config.hpp>
+#include <userver/utils/algo.hpp>
 #include <userver/utils/assert.hpp>
 #include <userver/utils/fast_scope_guard.hpp>
 
@@ -87,6 +92,13 @@ void Connection::ListenForRequests() noexcept {
         stats_->parser_stats, data_accounter_);
 
     pending_data_.resize(config_.in_buffer_size);
+    if (IsHttp2Negotiated()) {
+      LOG_TRACE() << "HTTP/2 is negotiated via ALPN on fd " << Fd();
+      ListenForHttp2Requests();
+      return;
+    }
+
+    bool is_first_read = true;
     while (is_accepting_requests_) {
       auto deadline = engine::Deadline::FromDuration(config_.keepalive_timeout);
 
@@ -127,6 +139,14 @@ void Connection::ListenForRequests() noexcept {
                     << Getpeername() << " on fd " << Fd();
       }
 
+      if (std::exchange(is_first_read, false) && config_.http2.enabled &&
+          http::Http2Session::IsClientPreface(pending_data_.data(),
+                                              pending_data_size_)) {
+        LOG_TRACE() << "HTTP/2 with prior knowledge on fd " << Fd();
+        ListenForHttp2Requests();
+        return;
+      }
+
       bool should_stop_accepting_requests = false;
       if (!request_parser.Parse(pending_data_.data(), pending_data_size_)) {
         LOG_DEBUG() << "Malformed request from " << Getpeername() << " on fd "
@@ -137,9 +157,11 @@ void Connection::ListenForRequests() noexcept {
       }
       pending_data_size_ = 0;
 
-      for (auto&& request : pending_requests) {
-        ProcessRequest(std::move(request));
+      for (std::size_t i = 0; i < pending_requests.size(); ++i) {
+        ProcessRequest(std::move(pending_requests[i]),
+                       i + 1 < pending_requests.size());
       }
+      SendResponseBatch();
       pending_requests.resize(0);
       if (should_stop_accepting_requests) is_accepting_requests_ = false;
     }
@@ -165,7 +187,8 @@ void Connection::ListenForRequests() noexcept {
 }
 
 void Connection::ProcessRequest(
-    std::shared_ptr<request::RequestBase>&& request_ptr) {
+    std::shared_ptr<request::RequestBase>&& request_ptr,
+    bool has_next_request) {
   if (request_ptr->IsFinal()) {
     is_accepting_requests_ = false;
   }
@@ -173,12 +196,185 @@ void Connection::ProcessRequest(
   stats_->active_request_count.Add(1);
 
   auto task = HandleQueueItem(request_ptr);
+
+  // Responses to pipelined requests are held while the handlers of the next
+  // requests are quick, so that they are written to the socket together
+  if ((has_next_request || !batched_requests_.empty()) &&
+      CanBatchResponse(*request_ptr)) {
+    request_ptr->SetStartSendResponseTime();
+    response_batch_.Add(
+        static_cast<http::HttpResponse&>(request_ptr->GetResponse()));
+    batched_requests_.push_back(std::move(request_ptr));
+    if (!has_next_request || response_batch_.IsFull()) SendResponseBatch();
+    return;
+  }
+
+  SendResponseBatch();
   SendResponse(*request_ptr);
 
   if (request_ptr->IsUpgradeWebsocket())
     request_ptr->DoUpgrade(std::move(peer_socket_), std::move(remote_address_));
 }
 
+bool Connection::IsHttp2Negotiated() const {
+  if (!config_.http2.enabled) return false;
+
+  auto* tls_socket = dynamic_cast<engine::io::TlsWrapper*>(peer_socket_.get());
+  return tls_socket && tls_socket->GetAlpnProtocol() == "h2";
+}
+
+void Connection::ListenForHttp2Requests() {
+  using RequestBasePtr = std::shared_ptr<request::RequestBase>;
+  using StreamId = http::Http2Session::StreamId;
+
+  std::vector<std::pair<StreamId, RequestBasePtr>> pending_requests;
+
+  http::Http2Session session(
+      config_.http2, request_handler_.GetHandlerInfoIndex(),
+      handler_defaults_config_,
+      [&pending_requests](StreamId stream_id, RequestBasePtr&& request_ptr) {
+        pending_requests.emplace_back(stream_id, std::move(request_ptr));
+      },
+      stats_->parser_stats, data_accounter_);
+
+  // Unlike HTTP/1.1 pipelining, the streams are processed concurrently. The
+  // tasks are cancelled on exit.
+  std::unordered_map<StreamId, engine::TaskWithResult<void>> stream_tasks;
+
+  while (true) {
+    if (pending_data_size_ != 0) {
+      if (!session.Parse(pending_data_.data(), pending_data_size_)) {
+        LOG_DEBUG() << "Malformed HTTP/2 frames from " << Getpeername()
+                    << " on fd " << Fd();
+      }
+      pending_data_size_ = 0;
+
+      for (auto& [stream_id, request_ptr] : pending_requests) {
+        stream_tasks.emplace(
+            stream_id, StartHttp2Stream(std::move(request_ptr),
+                                        session.GetStreamWriter(stream_id)));
+      }
+      pending_requests.clear();
+    }
+
+    for (const auto stream_id : session.ExtractClosedStreams()) {
+      const auto it = stream_tasks.find(stream_id);
+      if (it != stream_tasks.end() && !it->second.IsFinished()) {
+        // The stream was reset by the peer, nobody waits for the response
+        LOG_DEBUG() << "Cancelling request due to closed HTTP/2 stream";
+        it->second.RequestCancel();
+      }
+    }
+    utils::EraseIf(stream_tasks,
+                   [](const auto& item) { return item.second.IsFinished(); });
+
+    SendHttp2Output(session);
+    if (!session.IsAlive()) {
+      LOG_TRACE() << "HTTP/2 session is finished on fd " << Fd();
+      return;
+    }
+
+    auto stream_output = session.GetStreamOutputFuture();
+    const auto deadline =
+        stream_tasks.empty()
+            ? engine::Deadline::FromDuration(config_.keepalive_timeout)
+            : engine::Deadline{};
+    engine::io::ReadableBase& peer_read = *peer_socket_;
+    const auto ready = engine::WaitAnyUntil(deadline, peer_read, stream_output);
+
+    if (!ready) {
+      if (engine::current_task::IsCancelRequested()) return;
+
+      LOG_INFO() << "Closing idle connection on timeout";
+      session.Terminate();
+      SendHttp2Output(session);
+      return;
+    }
+    if (*ready == 0 && !ReadSome()) {
+      LOG_TRACE() << "Peer " << Getpeername() << " on fd " << Fd()
+                  << " closed connection";
+      return;
+    }
+  }
+}
+
+engine::TaskWithResult<void> Connection::StartHttp2Stream(
+    std::shared_ptr<request::RequestBase>&& request_ptr,
+    std::shared_ptr<http::impl::Http2StreamWriter>&& stream) {
+  stats_->active_request_count.Add(1);
+
+  return engine::CriticalAsyncNoSpan(
+      [this, request_ptr = std::move(request_ptr),
+       stream = std::move(stream)] {
+        HandleHttp2Stream(request_ptr, *stream);
+      });
+}
+
+void Connection::HandleHttp2Stream(
+    const std::shared_ptr<request::RequestBase>& request,
+    http::impl::Http2StreamWriter& stream) noexcept {
+  auto request_task = request_handler_.StartRequestTask(request);
+
+  // Http2Session constructs HTTP requests only
+  auto& response =
+      // NOLINTNEXTLINE(cppcoreguidelines-pro-type-static-cast-downcast)
+      static_cast<http::HttpRequestImpl&>(*request).GetHttpResponse();
+  try {
+    if (response.IsBodyStreamed()) {
+      response.WaitForHeadersEnd();
+    } else {
+      request_task.Get();
+    }
+  } catch (const engine::TaskCancelledException& e) {
+    auto reason = e.Reason();
+    auto lvl = reason == engine::TaskCancellationReason::kUserRequest
+                   ? logging::Level::kWarning
+                   : logging::Level::kError;
+    LOG_LIMITED(lvl) << "Handler task was cancelled with reason: "
+                     << ToString(reason);
+    if (!response.IsReady()) {
+      response.SetReady();
+      response.SetStatusServiceUnavailable();
+    }
+  } catch (const engine::WaitInterruptedException&) {
+    LOG_DEBUG() << "Request processing interrupted";
+  } catch (const std::exception& e) {
+    LOG_WARNING() << "Request failed with unhandled exception: " << e;
+    request->MarkAsInternalServerError();
+  }
+
+  request->SetStartSendResponseTime();
+  if (!engine::current_task::IsCancelRequested()) {
+    try {
+      response.SendResponseHttp2(stream);
+    } catch (const std::exception& ex) {
+      LOG_ERROR() << "Error while sending data: " << ex;
+      response.SetSendFailed(std::chrono::steady_clock::now());
+    }
+  } else {
+    response.SetSendFailed(std::chrono::steady_clock::now());
+  }
+  request->SetFinishSendResponseTime();
+  stats_->active_request_count.Subtract(1);
+  stats_->requests_processed_count.Add(1);
+
+  request->WriteAccessLogs(request_handler_.LoggerAccess(),
+                           request_handler_.LoggerAccessTskv(), peer_name_);
+}
+
+void Connection::SendHttp2Output(http::Http2Session& session) {
+  for (auto output = session.GetPendingOutput(); !output.empty();
+       output = session.GetPendingOutput()) {
+    const auto sent_bytes =
+        peer_socket_->WriteAll(output.data(), output.size(), {});
+    if (sent_bytes != output.size()) {
+      LOG_DEBUG() << "Peer " << Getpeername() << " on fd " << Fd()
+                  << " closed connection while sending data";
+      return;
+    }
+  }
+}
+
 bool Connection::ReadSome() {
   if (pending_data_size_ == pending_data_.size()) return true;
 
@@ -205,6 +401,8 @@ engine::TaskWithResult<void> Connection::HandleQueueItem(
   auto request_task = request_handler_.StartRequestTask(request);
 
   if (engine::current_task::IsCancelRequested()) {
+    SendResponseBatch();
+
     // We could've packed all remaining requests into a vector and cancel them
     // in parallel. But pipelining is almost never used so why bother.
     request_task.SyncCancel();
@@ -216,9 +414,16 @@ engine::TaskWithResult<void> Connection::HandleQueueItem(
   try {
     auto& response = request->GetResponse();
     if (response.IsBodyStreamed()) {
+      SendResponseBatch();
+
       // TODO: wait for TCP connection closure too
       response.WaitForHeadersEnd();
     } else {
+      if (!response_batch_.IsEmpty()) {
+        request_task.WaitFor(config_.pipelining_batch_delay);
+        if (!request_task.IsFinished()) SendResponseBatch();
+      }
+
       // We must wait for one of the following events:
       // a) socket is ready - maybe it is closed and the handler task must be
       //    cancelled;
@@ -261,6 +466,10 @@ engine::TaskWithResult<void> Connection::HandleQueueItem(
       response.SetStatusServiceUnavailable();
     }
   } catch (const engine::WaitInterruptedException&) {
+    // The batched responses are ready, they are written before the chain
+    // is broken
+    SendResponseBatch();
+
     LOG_DEBUG() << "Request processing interrupted";
     is_response_chain_valid_ = false;
   } catch (const std::exception& e) {
@@ -294,6 +503,45 @@ void Connection::SendResponse(request::RequestBase& request) {
   } else {
     response.SetSendFailed(std::chrono::steady_clock::now());
   }
+  FinishRequest(request);
+}
+
+bool Connection::CanBatchResponse(const request::RequestBase& request) const {
+  return config_.pipelining_batch_delay.count() > 0 &&
+         is_response_chain_valid_ && peer_socket_ &&
+         !request.IsUpgradeWebsocket() &&
+         !request.GetResponse().IsBodyStreamed();
+}
+
+void Connection::SendResponseBatch() {
+  if (batched_requests_.empty()) return;
+
+  if (is_response_chain_valid_ && peer_socket_) {
+    try {
+      response_batch_.Send(*peer_socket_);
+    } catch (const engine::io::IoSystemError& ex) {
+      auto log_level =
+          ex.Code().value() == static_cast<int>(std::errc::broken_pipe)
+              ? logging::Level::kWarning
+              : logging::Level::kError;
+      LOG(log_level) << "I/O error while sending data: " << ex;
+    } catch (const std::exception& ex) {
+      LOG_ERROR() << "Error while sending data: " << ex;
+    }
+  }
+  response_batch_.Clear();
+
+  for (const auto& request : batched_requests_) {
+    auto& response = request->GetResponse();
+    if (!response.IsSent()) {
+      response.SetSendFailed(std::chrono::steady_clock::now());
+    }
+    FinishRequest(*request);
+  }
+  batched_requests_.clear();
+}
+
+void Connection::FinishRequest(request::RequestBase& request) {
   request.SetFinishSendResponseTime();
   stats_->active_request_count.Subtract(1);
   stats_->requests_processed_count.Add(1);
@@ -2,9 +2,12 @@
 
 #include <memory>
 #include <string>
+#include <vector>
 
+#include <server/http/http2_session.hpp>
 #include <server/http/http_request_parser.hpp>
 #include <server/http/request_handler_base.hpp>
+#include <server/http/response_batch.hpp>
 #include <server/net/connection_config.hpp>
 #include <server/net/stats.hpp>
 #include <server/request/request_parser.hpp>
@@ -39,11 +42,24 @@ class Connection final {
   bool IsRequestTasksEmpty() const noexcept;
 
   void ListenForRequests() noexcept;
-  void ProcessRequest(std::shared_ptr<request::RequestBase>&& request_ptr);
+  void ProcessRequest(std::shared_ptr<request::RequestBase>&& request_ptr,
+                      bool has_next_request);
+
+  bool IsHttp2Negotiated() const;
+  void ListenForHttp2Requests();
+  engine::TaskWithResult<void> StartHttp2Stream(
+      std::shared_ptr<request::RequestBase>&& request_ptr,
+      std::shared_ptr<http::impl::Http2StreamWriter>&& stream);
+  void HandleHttp2Stream(const std::shared_ptr<request::RequestBase>& request,
+                         http::impl::Http2StreamWriter& stream) noexcept;
+  void SendHttp2Output(http::Http2Session& session);
 
   engine::TaskWithResult<void> HandleQueueItem(
       const std::shared_ptr<request::RequestBase>& request) noexcept;
   void SendResponse(request::RequestBase& request);
+  bool CanBatchResponse(const request::RequestBase& request) const;
+  void SendResponseBatch();
+  void FinishRequest(request::RequestBase& request);
 
   std::string Getpeername() const;
 
@@ -64,6 +80,10 @@ class Connection final {
 
   bool is_accepting_requests_{true};
   bool is_response_chain_valid_{true};
+
+  // Ready responses to pipelined requests that are sent with a single write
+  http::impl::ResponseBatch response_batch_;
+  std::vector<std::shared_ptr<request::RequestBase>> batched_requests_;
 };
 
 }  // namespace server::net
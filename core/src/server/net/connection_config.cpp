@@ -6,6 +6,25 @@ USERVER_NAMESPACE_BEGIN
 
 namespace server::net {
 
+Http2Config Parse(const yaml_config::YamlConfig& value,
+                  formats::parse::To<Http2Config>) {
+  Http2Config config;
+
+  config.enabled = value["enabled"].As<bool>(config.enabled);
+  config.max_concurrent_streams =
+      value["max_concurrent_streams"].As<std::uint32_t>(
+          config.max_concurrent_streams);
+  config.initial_window_size = value["initial_window_size"].As<std::uint32_t>(
+      config.initial_window_size);
+  config.connection_window_size =
+      value["connection_window_size"].As<std::uint32_t>(
+          config.connection_window_size);
+  config.max_frame_size =
+      value["max_frame_size"].As<std::uint32_t>(config.max_frame_size);
+
+  return config;
+}
+
 ConnectionConfig Parse(const yaml_config::YamlConfig& value,
                        formats::parse::To<ConnectionConfig>) {
   ConnectionConfig config;
@@ -20,6 +39,9 @@ ConnectionConfig Parse(const yaml_config::YamlConfig& value,
           config.keepalive_timeout);
   config.abort_check_delay = utils::StringToDuration(
       value["stream_close_check_delay"].As<std::string>("20ms"));
+  config.pipelining_batch_delay = utils::StringToDuration(
+      value["pipelining_batch_delay"].As<std::string>("0ms"));
+  config.http2 = value["http2"].As<Http2Config>(config.http2);
 
   return config;
 }
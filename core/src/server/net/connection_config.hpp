@@ -1,5 +1,7 @@
 #pragma once
 
+#include <chrono>
+#include <cstdint>
 #include <memory>
 #include <string>
 
@@ -9,11 +11,24 @@ USERVER_NAMESPACE_BEGIN
 
 namespace server::net {
 
+struct Http2Config {
+  bool enabled = false;
+  std::uint32_t max_concurrent_streams = 100;
+  std::uint32_t initial_window_size = 64 * 1024 - 1;
+  std::uint32_t connection_window_size = 1024 * 1024;
+  std::uint32_t max_frame_size = 16 * 1024;
+};
+
+Http2Config Parse(const yaml_config::YamlConfig& value,
+                  formats::parse::To<Http2Config>);
+
 struct ConnectionConfig {
   size_t in_buffer_size = 32 * 1024;
   size_t requests_queue_size_threshold = 100;
   std::chrono::seconds keepalive_timeout{10 * 60};
   std::chrono::milliseconds abort_check_delay{20};
+  std::chrono::milliseconds pipelining_batch_delay{0};
+  Http2Config http2;
 };
 
 ConnectionConfig Parse(const yaml_config::YamlConfig& value,
@@ -1,5 +1,7 @@
 #include <server/net/connection.hpp>
 
+#include <array>
+
 #include <fmt/format.h>
 
 #include <server/handlers/http_handler_base_statistics.hpp>
@@ -9,6 +11,7 @@
 #include <userver/clients/http/client.hpp>
 #include <userver/engine/io/sockaddr.hpp>
 #include <userver/engine/sleep.hpp>
+#include <userver/internal/net/net_listener.hpp>
 
 #include <userver/utest/http_client.hpp>
 #include <userver/utest/utest.hpp>
@@ -274,6 +277,66 @@ UTEST(ServerNetConnection, KeepAlive) {
   EXPECT_EQ(handler.asyncs_finished, 2);
 }
 
+namespace {
+
+void TestPipelining(std::chrono::milliseconds batch_delay) {
+  constexpr std::size_t kRequests = 5;
+  const auto deadline = Deadline::FromDuration(utest::kMaxTestWaitTime);
+  net::ListenerConfig config = CreateConfig();
+  config.connection_config.pipelining_batch_delay = batch_delay;
+
+  auto [server, client] = internal::net::TcpListener{}.MakeSocketPair(deadline);
+  auto stats = std::make_shared<net::Stats>();
+  server::request::ResponseDataAccounter data_accounter;
+  TestHttprequestHandler handler;
+
+  auto task = engine::AsyncNoSpan([&, server = std::move(server)]() mutable {
+    net::Connection connection(
+        config.connection_config, config.handler_defaults,
+        std::make_unique<engine::io::Socket>(std::move(server)), {}, handler,
+        stats, data_accounter);
+
+    connection.Process();
+  });
+
+  std::string requests;
+  for (std::size_t i = 0; i < kRequests; ++i) {
+    requests += fmt::format("GET /{} HTTP/1.1\r\nHost: localhost\r\n\r\n", i);
+  }
+  ASSERT_EQ(client.SendAll(requests.data(), requests.size(), deadline),
+            requests.size());
+
+  std::string replies;
+  std::size_t replies_count = 0;
+  while (replies_count < kRequests) {
+    std::array<char, 4096> buffer{};
+    const auto size = client.RecvSome(buffer.data(), buffer.size(), deadline);
+    ASSERT_GT(size, 0);
+    replies.append(buffer.data(), size);
+
+    replies_count = 0;
+    for (auto pos = replies.find("HTTP/1.1 404"); pos != std::string::npos;
+         pos = replies.find("HTTP/1.1 404", pos + 1)) {
+      ++replies_count;
+    }
+  }
+
+  EXPECT_EQ(replies_count, kRequests);
+  EXPECT_EQ(handler.asyncs_finished, kRequests);
+
+  task.SyncCancel();
+}
+
+}  // namespace
+
+UTEST(ServerNetConnection, Pipelining) {
+  TestPipelining(std::chrono::milliseconds{0});
+}
+
+UTEST(ServerNetConnection, PipeliningBatched) {
+  TestPipelining(std::chrono::milliseconds{1});
+}
+
 UTEST(ServerNetConnection, CancelMultipleInFlight) {
   constexpr std::size_t kInFlightRequests = 10;
   constexpr std::size_t kMaxAttempts = 10;
@@ -7,6 +7,7 @@
 #include <stdexcept>
 #include <string>
 #include <system_error>
+#include <vector>
 
 #include <server/net/create_socket.hpp>
 #include <userver/engine/async.hpp>
@@ -24,6 +25,13 @@ USERVER_NAMESPACE_BEGIN
 
 namespace server::net {
 
+namespace {
+
+const std::vector<std::string> kAlpnProtocols{};
+const std::vector<std::string> kAlpnProtocolsWithHttp2{"h2", "http/1.1"};
+
+}  // namespace
+
 ListenerImpl::ListenerImpl(engine::TaskProcessor& task_processor,
                            std::shared_ptr<EndpointInfo> endpoint_info,
                            request::ResponseDataAccounter& data_accounter)
@@ -105,7 +113,9 @@ void ListenerImpl::ProcessConnection(engine::io::Socket peer_socket) {
     socket = std::make_unique<engine::io::TlsWrapper>(
         engine::io::TlsWrapper::StartTlsServer(
             std::move(peer_socket), config.tls_cert, config.tls_private_key, {},
-            config.tls_certificate_authorities));
+            config.tls_certificate_authorities,
+            config.connection_config.http2.enabled ? kAlpnProtocolsWithHttp2
+                                                   : kAlpnProtocols));
   } else {
     socket = std::make_unique<engine::io::Socket>(std::move(peer_socket));
   }
@@ -0,0 +1,258 @@
+#include <server/websocket/deflate.hpp>
+
+#include <algorithm>
+#include <charconv>
+#include <stdexcept>
+
+#include <fmt/format.h>
+
+#include <userver/utils/assert.hpp>
+#include <userver/utils/text_light.hpp>
+
+USERVER_NAMESPACE_BEGIN
+
+namespace server::websocket::impl {
+
+namespace {
+
+// Sync flush marker that is removed from the end of each compressed message
+// and appended back before decompression,
+// https://datatracker.ietf.org/doc/html/rfc7692#section-7.2.1
+constexpr std::string_view kDeflateTail{"\x00\x00\xff\xff", 4};
+
+// Room for the sync flush marker on top of deflateBound()
+constexpr std::size_t kCompressOutputReserve = 16;
+constexpr std::size_t kMinDecompressChunk = 1024;
+constexpr int kMemLevel = 8;
+
+// zlib does not support 256-byte window for raw deflate streams
+constexpr int kMinServerWindowBits = 9;
+constexpr int kMinClientWindowBits = 8;
+constexpr int kMaxWindowBits = 15;
+
+std::string_view TrimView(std::string_view str) {
+  while (!str.empty() && utils::text::IsAsciiSpace(str.front())) {
+    str.remove_prefix(1);
+  }
+  while (!str.empty() && utils::text::IsAsciiSpace(str.back())) {
+    str.remove_suffix(1);
+  }
+  return str;
+}
+
+std::optional<int> ParseWindowBits(std::string_view value) {
+  if (value.size() >= 2 && value.front() == '"' && value.back() == '"') {
+    value = value.substr(1, value.size() - 2);
+  }
+  // No leading zeroes are allowed by RFC 7692
+  if (value.empty() || value.front() == '0') return std::nullopt;
+
+  int result = 0;
+  const auto [ptr, ec] =
+      std::from_chars(value.data(), value.data() + value.size(), result);
+  if (ec != std::errc{} || ptr != value.data() + value.size()) {
+    return std::nullopt;
+  }
+  if (result < kMinClientWindowBits || result > kMaxWindowBits) {
+    return std::nullopt;
+  }
+  return result;
+}
+
+// Returns std::nullopt if the offer should be declined
+std::optional<DeflateParams> AcceptOffer(
+    const std::vector<std::string_view>& offer, const DeflateConfig& config) {
+  DeflateParams params;
+  params.server_no_context_takeover = config.server_no_context_takeover;
+  params.client_no_context_takeover = config.client_no_context_takeover;
+  params.compression_level = config.compression_level;
+  params.min_message_size = config.min_message_size;
+
+  bool has_server_no_context_takeover = false;
+  bool has_client_no_context_takeover = false;
+  std::optional<int> server_max_window_bits;
+  std::optional<int> client_max_window_bits;
+  bool has_client_max_window_bits = false;
+
+  for (std::size_t i = 1; i < offer.size(); ++i) {
+    const auto param = offer[i];
+    const auto eq_pos = param.find('=');
+    const auto name = TrimView(param.substr(0, eq_pos));
+    const auto value = eq_pos == std::string_view::npos
+                           ? std::optional<std::string_view>{}
+                           : TrimView(param.substr(eq_pos + 1));
+
+    // Each parameter is allowed only once
+    if (name == "server_no_context_takeover") {
+      if (value || has_server_no_context_takeover) return std::nullopt;
+      has_server_no_context_takeover = true;
+    } else if (name == "client_no_context_takeover") {
+      if (value || has_client_no_context_takeover) return std::nullopt;
+      has_client_no_context_takeover = true;
+    } else if (name == "server_max_window_bits") {
+      if (!value || server_max_window_bits) return std::nullopt;
+      server_max_window_bits = ParseWindowBits(*value);
+      if (!server_max_window_bits) return std::nullopt;
+    } else if (name == "client_max_window_bits") {
+      if (has_client_max_window_bits) return std::nullopt;
+      has_client_max_window_bits = true;
+      if (value) {
+        client_max_window_bits = ParseWindowBits(*value);
+        if (!client_max_window_bits) return std::nullopt;
+      }
+    } else {
+      return std::nullopt;
+    }
+  }
+
+  params.server_no_context_takeover |= has_server_no_context_takeover;
+  params.client_no_context_takeover |= has_client_no_context_takeover;
+
+  params.server_max_window_bits =
+      std::min(config.server_max_window_bits,
+               server_max_window_bits.value_or(kMaxWindowBits));
+  if (params.server_max_window_bits < kMinServerWindowBits) return std::nullopt;
+
+  // Without client_max_window_bits in the offer the client may use any
+  // window and the response must not limit it
+  params.client_max_window_bits =
+      has_client_max_window_bits
+          ? std::min(config.client_max_window_bits,
+                     client_max_window_bits.value_or(kMaxWindowBits))
+          : kMaxWindowBits;
+
+  return params;
+}
+
+}  // namespace
+
+std::optional<DeflateParams> NegotiateDeflate(
+    std::string_view extensions_header, const DeflateConfig& config) {
+  if (!config.enabled) return std::nullopt;
+
+  for (const auto extension :
+       utils::text::SplitIntoStringViewVector(extensions_header, ",")) {
+    const auto offer = utils::text::SplitIntoStringViewVector(extension, ";");
+    if (offer.empty() || TrimView(offer.front()) != kPerMessageDeflate) {
+      continue;
+    }
+
+    auto params = AcceptOffer(offer, config);
+    if (params) return params;
+  }
+  return std::nullopt;
+}
+
+std::string MakeDeflateResponse(const DeflateParams& params) {
+  std::string result{kPerMessageDeflate};
+  if (params.server_no_context_takeover) {
+    result += "; server_no_context_takeover";
+  }
+  if (params.client_no_context_takeover) {
+    result += "; client_no_context_takeover";
+  }
+  if (params.server_max_window_bits != kMaxWindowBits) {
+    result += fmt::format("; server_max_window_bits={}",
+                          params.server_max_window_bits);
+  }
+  if (params.client_max_window_bits != kMaxWindowBits) {
+    result += fmt::format("; client_max_window_bits={}",
+                          params.client_max_window_bits);
+  }
+  return result;
+}
+
+Deflater::Deflater(int window_bits, int compression_level) {
+  // Negative window bits make zlib produce a raw deflate stream
+  if (deflateInit2(&stream_, compression_level, Z_DEFLATED, -window_bits,
+                   kMemLevel, Z_DEFAULT_STRATEGY) != Z_OK) {
+    throw std::runtime_error(
+        "failed to initialize permessage-deflate compression stream");
+  }
+}
+
+Deflater::~Deflater() { deflateEnd(&stream_); }
+
+void Deflater::Compress(std::string_view message, std::string& output) {
+  output.clear();
+
+  // NOLINTNEXTLINE(cppcoreguidelines-pro-type-const-cast)
+  stream_.next_in = reinterpret_cast<Bytef*>(const_cast<char*>(message.data()));
+  stream_.avail_in = message.size();
+
+  do {
+    const auto old_size = output.size();
+    const std::size_t chunk_size =
+        deflateBound(&stream_, stream_.avail_in) + kCompressOutputReserve;
+    output.resize(old_size + chunk_size);
+
+    stream_.next_out = reinterpret_cast<Bytef*>(output.data() + old_size);
+    stream_.avail_out = chunk_size;
+
+    if (deflate(&stream_, Z_SYNC_FLUSH) == Z_STREAM_ERROR) {
+      throw std::runtime_error("failed to compress websocket message");
+    }
+    output.resize(old_size + chunk_size - stream_.avail_out);
+  } while (stream_.avail_out == 0);
+
+  UASSERT(stream_.avail_in == 0);
+  UASSERT(utils::text::EndsWith(output, kDeflateTail));
+  output.resize(output.size() - kDeflateTail.size());
+}
+
+void Deflater::Reset() { deflateReset(&stream_); }
+
+Inflater::Inflater(int window_bits) {
+  if (inflateInit2(&stream_, -window_bits) != Z_OK) {
+    throw std::runtime_error(
+        "failed to initialize permessage-deflate decompression stream");
+  }
+}
+
+Inflater::~Inflater() { inflateEnd(&stream_); }
+
+CloseStatus Inflater::Decompress(std::string_view message, std::string& output,
+                                 std::size_t max_size) {
+  output.clear();
+
+  for (const auto input : {message, kDeflateTail}) {
+    // NOLINTNEXTLINE(cppcoreguidelines-pro-type-const-cast)
+    stream_.next_in = reinterpret_cast<Bytef*>(const_cast<char*>(input.data()));
+    stream_.avail_in = input.size();
+
+    do {
+      // One byte over the limit is enough to detect the overflow
+      const auto old_size = output.size();
+      const std::size_t chunk_size =
+          std::min<std::size_t>(std::max<std::size_t>(stream_.avail_in * 4,
+                                                      kMinDecompressChunk),
+                                max_size + 1 - old_size);
+      output.resize(old_size + chunk_size);
+
+      stream_.next_out = reinterpret_cast<Bytef*>(output.data() + old_size);
+      stream_.avail_out = chunk_size;
+
+      const int ret = inflate(&stream_, Z_SYNC_FLUSH);
+      output.resize(old_size + chunk_size - stream_.avail_out);
+
+      if (output.size() > max_size) return CloseStatus::kTooBigData;
+      if (ret == Z_STREAM_END) {
+        // The sender finished the stream with BFINAL, the next message
+        // starts a new one
+        inflateReset(&stream_);
+        return CloseStatus::kNone;
+      }
+      if (ret != Z_OK && ret != Z_BUF_ERROR) {
+        return CloseStatus::kBadMessageData;
+      }
+    } while (stream_.avail_in > 0 || stream_.avail_out == 0);
+  }
+
+  return CloseStatus::kNone;
+}
+
+void Inflater::Reset() { inflateReset(&stream_); }
+
+}  // namespace server::websocket::impl
+
+USERVER_NAMESPACE_END
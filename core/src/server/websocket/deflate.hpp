@@ -0,0 +1,80 @@
+#pragma once
+
+#include <optional>
+#include <string>
+#include <string_view>
+
+#include <zlib.h>
+
+#include <userver/server/websocket/server.hpp>
+
+USERVER_NAMESPACE_BEGIN
+
+namespace server::websocket::impl {
+
+inline constexpr std::string_view kPerMessageDeflate = "permessage-deflate";
+
+/// Parameters of permessage-deflate extension agreed with the client,
+/// https://datatracker.ietf.org/doc/html/rfc7692#section-7.1
+struct DeflateParams final {
+  bool server_no_context_takeover{false};
+  bool client_no_context_takeover{false};
+  int server_max_window_bits{15};
+  int client_max_window_bits{15};
+  int compression_level{Z_DEFAULT_COMPRESSION};
+  std::size_t min_message_size{0};
+};
+
+/// Selects the first acceptable permessage-deflate offer from the
+/// Sec-WebSocket-Extensions request header
+std::optional<DeflateParams> NegotiateDeflate(
+    std::string_view extensions_header, const DeflateConfig& config);
+
+/// Value of the Sec-WebSocket-Extensions response header
+std::string MakeDeflateResponse(const DeflateParams& params);
+
+/// Compresses messages into the raw deflate stream without the trailing
+/// 0x00 0x00 0xff 0xff of the sync flush
+class Deflater final {
+ public:
+  /// @throws std::runtime_error if zlib fails to initialize
+  Deflater(int window_bits, int compression_level);
+  ~Deflater();
+
+  Deflater(Deflater&&) = delete;
+  Deflater& operator=(Deflater&&) = delete;
+
+  /// Replaces the contents of `output` with the compressed message
+  void Compress(std::string_view message, std::string& output);
+
+  /// Drops the sliding window, next messages do not reference the previous
+  void Reset();
+
+ private:
+  z_stream stream_{};
+};
+
+class Inflater final {
+ public:
+  /// @throws std::runtime_error if zlib fails to initialize
+  explicit Inflater(int window_bits);
+  ~Inflater();
+
+  Inflater(Inflater&&) = delete;
+  Inflater& operator=(Inflater&&) = delete;
+
+  /// Replaces the contents of `output` with the decompressed message.
+  /// @returns CloseStatus::kTooBigData if the result exceeds `max_size`,
+  /// CloseStatus::kBadMessageData on malformed input
+  CloseStatus Decompress(std::string_view message, std::string& output,
+                         std::size_t max_size);
+
+  void Reset();
+
+ private:
+  z_stream stream_{};
+};
+
+}  // namespace server::websocket::impl
+
+USERVER_NAMESPACE_END
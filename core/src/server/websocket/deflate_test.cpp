@@ -0,0 +1,368 @@
+#include <server/websocket/deflate.hpp>
+
+#include <cstring>
+
+#include <gtest/gtest.h>
+
+#include <userver/engine/io/exception.hpp>
+#include <userver/utest/utest.hpp>
+
+#include <server/websocket/protocol.hpp>
+
+USERVER_NAMESPACE_BEGIN
+
+namespace {
+
+namespace ws = server::websocket;
+
+ws::DeflateConfig MakeDeflateConfig() {
+  ws::DeflateConfig config;
+  config.enabled = true;
+  return config;
+}
+
+std::string MakeJson(std::size_t items) {
+  std::string result = "[";
+  for (std::size_t i = 0; i < items; ++i) {
+    if (i > 0) result += ',';
+    result += R"({"id":)" + std::to_string(i) + R"(,"status":"delivered"})";
+  }
+  return result + "]";
+}
+
+class MemoryIo final : public engine::io::RwBase {
+ public:
+  MemoryIo(std::string input, std::string& output)
+      : input_(std::move(input)), output_(output) {}
+
+  bool IsValid() const override { return true; }
+
+  bool WaitReadable(engine::Deadline) override { return true; }
+
+  size_t ReadSome(void* buf, size_t len, engine::Deadline deadline) override {
+    return ReadAll(buf, len, deadline);
+  }
+
+  size_t ReadAll(void* buf, size_t len, engine::Deadline) override {
+    if (input_.size() - read_pos_ < len) {
+      throw engine::io::IoException() << "No more input";
+    }
+    std::memcpy(buf, input_.data() + read_pos_, len);
+    read_pos_ += len;
+    return len;
+  }
+
+  bool WaitWriteable(engine::Deadline) override { return true; }
+
+  size_t WriteAll(const void* buf, size_t len, engine::Deadline) override {
+    output_.append(static_cast<const char*>(buf), len);
+    return len;
+  }
+
+ private:
+  std::string input_;
+  std::size_t read_pos_{0};
+  std::string& output_;
+};
+
+struct ParsedFrame {
+  bool fin{false};
+  bool rsv1{false};
+  int opcode{0};
+  std::string payload;
+};
+
+std::vector<ParsedFrame> ParseFrames(std::string_view data) {
+  std::vector<ParsedFrame> result;
+  while (!data.empty()) {
+    ParsedFrame frame;
+    const auto first = static_cast<unsigned char>(data[0]);
+    frame.fin = first & 0x80;
+    frame.rsv1 = first & 0x40;
+    frame.opcode = first & 0x0f;
+
+    std::size_t len = static_cast<unsigned char>(data[1]) & 0x7f;
+    std::size_t offset = 2;
+    if (len == 126) {
+      len = (static_cast<unsigned char>(data[2]) << 8) |
+            static_cast<unsigned char>(data[3]);
+      offset = 4;
+    } else if (len == 127) {
+      len = 0;
+      for (int i = 0; i < 8; ++i) {
+        len = (len << 8) | static_cast<unsigned char>(data[2 + i]);
+      }
+      offset = 10;
+    }
+    frame.payload = std::string{data.substr(offset, len)};
+    data.remove_prefix(offset + len);
+    result.push_back(std::move(frame));
+  }
+  return result;
+}
+
+std::string Inflate(const std::string& compressed, int window_bits = 15) {
+  ws::impl::Inflater inflater{window_bits};
+  std::string result;
+  EXPECT_EQ(inflater.Decompress(compressed, result, 1 << 20),
+            ws::CloseStatus::kNone);
+  return result;
+}
+
+}  // namespace
+
+TEST(WebsocketDeflate, Negotiate) {
+  const auto config = MakeDeflateConfig();
+
+  auto params = ws::impl::NegotiateDeflate(
+      "permessage-deflate; client_max_window_bits", config);
+  ASSERT_TRUE(params);
+  EXPECT_FALSE(params->server_no_context_takeover);
+  EXPECT_EQ(params->server_max_window_bits, 15);
+  EXPECT_EQ(params->client_max_window_bits, 15);
+  EXPECT_EQ(ws::impl::MakeDeflateResponse(*params), "permessage-deflate");
+
+  params = ws::impl::NegotiateDeflate(
+      "x-webkit-deflate-frame, permessage-deflate; "
+      "server_no_context_takeover; server_max_window_bits=10",
+      config);
+  ASSERT_TRUE(params);
+  EXPECT_TRUE(params->server_no_context_takeover);
+  EXPECT_EQ(params->server_max_window_bits, 10);
+  EXPECT_EQ(ws::impl::MakeDeflateResponse(*params),
+            "permessage-deflate; server_no_context_takeover; "
+            "server_max_window_bits=10");
+
+  EXPECT_FALSE(ws::impl::NegotiateDeflate("x-webkit-deflate-frame", config));
+  EXPECT_FALSE(ws::impl::NegotiateDeflate("permessage-deflate",
+                                          ws::DeflateConfig{}));
+}
+
+TEST(WebsocketDeflate, NegotiateLimits) {
+  auto config = MakeDeflateConfig();
+  config.client_max_window_bits = 10;
+  config.server_max_window_bits = 12;
+  config.client_no_context_takeover = true;
+
+  // Client window may be limited only if the client supports it
+  auto params = ws::impl::NegotiateDeflate("permessage-deflate", config);
+  ASSERT_TRUE(params);
+  EXPECT_EQ(params->client_max_window_bits, 15);
+  EXPECT_EQ(ws::impl::MakeDeflateResponse(*params),
+            "permessage-deflate; client_no_context_takeover; "
+            "server_max_window_bits=12");
+
+  params = ws::impl::NegotiateDeflate(
+      R"(permessage-deflate; client_max_window_bits="9")", config);
+  ASSERT_TRUE(params);
+  EXPECT_EQ(params->client_max_window_bits, 9);
+  EXPECT_EQ(params->server_max_window_bits, 12);
+}
+
+TEST(WebsocketDeflate, DeclineInvalidOffers) {
+  const auto config = MakeDeflateConfig();
+
+  for (const auto* offer : {
+           "permessage-deflate; server_max_window_bits",
+           "permessage-deflate; server_max_window_bits=16",
+           "permessage-deflate; server_max_window_bits=010",
+           // zlib can not produce the raw stream for 256-byte window
+           "permessage-deflate; server_max_window_bits=8",
+           "permessage-deflate; client_max_window_bits=7",
+           "permessage-deflate; server_no_context_takeover=1",
+           "permessage-deflate; client_no_context_takeover; "
+           "client_no_context_takeover",
+           "permessage-deflate; unknown_param",
+       }) {
+    EXPECT_FALSE(ws::impl::NegotiateDeflate(offer, config)) << offer;
+  }
+
+  // The next acceptable offer is selected
+  const auto params = ws::impl::NegotiateDeflate(
+      "permessage-deflate; server_max_window_bits=8, "
+      "permessage-deflate; server_no_context_takeover",
+      config);
+  ASSERT_TRUE(params);
+  EXPECT_TRUE(params->server_no_context_takeover);
+}
+
+TEST(WebsocketDeflate, RoundTrip) {
+  ws::impl::Deflater deflater{15, 6};
+  ws::impl::Inflater inflater{15};
+
+  const auto message = MakeJson(100);
+  std::string compressed;
+  std::string decompressed;
+  for (int i = 0; i < 3; ++i) {
+    deflater.Compress(message, compressed);
+    EXPECT_LT(compressed.size(), message.size() / 4);
+
+    ASSERT_EQ(inflater.Decompress(compressed, decompressed, message.size()),
+              ws::CloseStatus::kNone);
+    EXPECT_EQ(decompressed, message);
+  }
+
+  // With context takeover the repeated message is a few back references
+  deflater.Compress(message, compressed);
+  EXPECT_LT(compressed.size(), 64);
+}
+
+TEST(WebsocketDeflate, DecompressErrors) {
+  ws::impl::Deflater deflater{15, 6};
+  const auto message = MakeJson(100);
+  std::string compressed;
+  deflater.Compress(message, compressed);
+
+  std::string decompressed;
+  EXPECT_EQ(ws::impl::Inflater{15}.Decompress(compressed, decompressed,
+                                              message.size() - 1),
+            ws::CloseStatus::kTooBigData);
+  EXPECT_EQ(ws::impl::Inflater{15}.Decompress("\xff\xff\xff\xff", decompressed,
+                                              message.size()),
+            ws::CloseStatus::kBadMessageData);
+}
+
+UTEST(WebsocketDeflate, SendCompressed) {
+  ws::Config config;
+  config.deflate = MakeDeflateConfig();
+  config.fragment_size = 100;
+  const auto params = ws::impl::NegotiateDeflate(
+      "permessage-deflate; server_no_context_takeover", config.deflate);
+  ASSERT_TRUE(params);
+
+  std::string output;
+  auto ws = ws::impl::MakeWebSocket(std::make_unique<MemoryIo>("", output),
+                                    {}, config, params);
+
+  const auto message = MakeJson(100);
+  ws->SendText(message);
+  ws->SendText(message);
+
+  const auto frames = ParseFrames(output);
+  ASSERT_GE(frames.size(), 2);
+  EXPECT_TRUE(frames[0].rsv1);
+  EXPECT_EQ(frames[0].opcode, ws::impl::kText);
+
+  // Both messages are compressed from scratch and RSV1 is set only on the
+  // first frame of each message
+  std::string compressed;
+  std::size_t messages = 0;
+  for (const auto& frame : frames) {
+    EXPECT_EQ(frame.rsv1, frame.opcode != ws::impl::kContinuation);
+    compressed += frame.payload;
+    if (frame.fin) {
+      EXPECT_EQ(Inflate(compressed), message);
+      compressed.clear();
+      ++messages;
+    }
+  }
+  EXPECT_EQ(messages, 2);
+}
+
+UTEST(WebsocketDeflate, RecvCompressed) {
+  ws::Config config;
+  config.deflate = MakeDeflateConfig();
+  const auto params =
+      ws::impl::NegotiateDeflate("permessage-deflate", config.deflate);
+
+  const auto message = MakeJson(100);
+  std::string compressed;
+  ws::impl::Deflater{15, 6}.Compress(message, compressed);
+
+  std::string input;
+  ws::impl::frames::DataFrames frames;
+  ws::impl::frames::AppendDataFrames(
+      frames, utils::as_bytes(utils::span(compressed)), true,
+      ws::impl::frames::Compressed::kYes, 100);
+  for (const auto& frame : frames) {
+    input.append(frame.header.data(), frame.header.size());
+    input.append(reinterpret_cast<const char*>(frame.payload.data()),
+                 frame.payload.size());
+  }
+
+  std::string output;
+  auto ws = ws::impl::MakeWebSocket(
+      std::make_unique<MemoryIo>(std::move(input), output), {}, config,
+      params);
+
+  ws::Message received;
+  ws->Recv(received);
+  EXPECT_FALSE(received.close_status);
+  EXPECT_TRUE(received.is_text);
+  EXPECT_EQ(received.data, message);
+}
+
+UTEST(WebsocketDeflate, RecvCompressedWithoutNegotiation) {
+  std::string compressed;
+  ws::impl::Deflater{15, 6}.Compress("hello", compressed);
+
+  const auto header = ws::impl::frames::DataFrameHeader(
+      utils::as_bytes(utils::span(compressed)), true,
+      ws::impl::frames::Continuation::kNo, ws::impl::frames::Final::kYes,
+      ws::impl::frames::Compressed::kYes);
+  std::string output;
+  auto ws = ws::impl::MakeWebSocket(
+      std::make_unique<MemoryIo>(
+          std::string(header.data(), header.size()) + compressed, output),
+      {}, ws::Config{}, std::nullopt);
+
+  ws::Message received;
+  ws->Recv(received);
+  EXPECT_EQ(received.close_status, ws::CloseStatus::kProtocolError);
+}
+
+UTEST(WebsocketDeflate, SendPrepared) {
+  ws::Config config;
+  config.deflate = MakeDeflateConfig();
+  const auto message = MakeJson(100);
+  const ws::PreparedMessage prepared{message, true, config};
+
+  const auto takeover_params =
+      ws::impl::NegotiateDeflate("permessage-deflate", config.deflate);
+  const auto small_window_params = ws::impl::NegotiateDeflate(
+      "permessage-deflate; server_max_window_bits=9", config.deflate);
+
+  std::string plain_output;
+  std::string takeover_output;
+  std::string small_window_output;
+  ws::impl::MakeWebSocket(std::make_unique<MemoryIo>("", plain_output), {},
+                          config, std::nullopt)
+      ->SendPrepared(prepared);
+  {
+    auto ws = ws::impl::MakeWebSocket(
+        std::make_unique<MemoryIo>("", takeover_output), {}, config,
+        takeover_params);
+    ws->SendText(message);
+    ws->SendPrepared(prepared);
+    ws->SendText(message);
+  }
+  ws::impl::MakeWebSocket(std::make_unique<MemoryIo>("", small_window_output),
+                          {}, config, small_window_params)
+      ->SendPrepared(prepared);
+
+  auto frames = ParseFrames(plain_output);
+  ASSERT_EQ(frames.size(), 1);
+  EXPECT_FALSE(frames[0].rsv1);
+  EXPECT_EQ(frames[0].payload, message);
+
+  // The client keeps a single window for the whole connection
+  frames = ParseFrames(takeover_output);
+  ASSERT_EQ(frames.size(), 3);
+  ws::impl::Inflater inflater{15};
+  for (const auto& frame : frames) {
+    EXPECT_TRUE(frame.rsv1);
+    std::string decompressed;
+    ASSERT_EQ(inflater.Decompress(frame.payload, decompressed, 1 << 20),
+              ws::CloseStatus::kNone);
+    EXPECT_EQ(decompressed, message);
+  }
+
+  // Prepared data does not fit into the agreed window and is compressed by
+  // the connection
+  frames = ParseFrames(small_window_output);
+  ASSERT_EQ(frames.size(), 1);
+  EXPECT_TRUE(frames[0].rsv1);
+  EXPECT_EQ(Inflate(frames[0].payload, 9), message);
+}
+
+USERVER_NAMESPACE_END
@@ -61,7 +61,7 @@ namespace frames {
 
 boost::container::small_vector<char, impl::kMaxFrameHeaderSize> DataFrameHeader(
     utils::span<const std::byte> data, bool is_text,
-    Continuation is_continuation, Final is_final) {
+    Continuation is_continuation, Final is_final, Compressed is_compressed) {
   boost::container::small_vector<char, impl::kMaxFrameHeaderSize> frame;
 
   frame.resize(sizeof(WSHeader));
@@ -73,7 +73,12 @@ boost::container::small_vector<char, impl::kMaxFrameHeaderSize> DataFrameHeader(
   hdr->bytes = 0;
   hdr->bits.fin = is_final == Final::kYes ? 1 : 0;
   hdr->bits.opcode = is_text ? kText : kBinary;
-  if (is_continuation == Continuation::kYes) hdr->bits.opcode = kContinuation;
+  if (is_continuation == Continuation::kYes) {
+    hdr->bits.opcode = kContinuation;
+  } else if (is_compressed == Compressed::kYes) {
+    // Only the first frame of the message is marked
+    hdr->bits.reserved = kReservedCompressed;
+  }
 
   if (data.size() <= 125) {
     hdr->bits.payloadLen = data.size();
@@ -89,6 +94,23 @@ boost::container::small_vector<char, impl::kMaxFrameHeaderSize> DataFrameHeader(
   return frame;
 }
 
+void AppendDataFrames(DataFrames& frames, utils::span<const std::byte> data,
+                      bool is_text, Compressed is_compressed,
+                      unsigned fragment_size) {
+  auto continuation = Continuation::kNo;
+  while (data.size() > fragment_size && fragment_size > 0) {
+    const auto fragment = data.first(fragment_size);
+    frames.push_back({DataFrameHeader(fragment, is_text, continuation,
+                                      Final::kNo, is_compressed),
+                      fragment});
+    continuation = Continuation::kYes;
+    data = data.last(data.size() - fragment_size);
+  }
+  frames.push_back(
+      {DataFrameHeader(data, is_text, continuation, Final::kYes, is_compressed),
+       data});
+}
+
 std::string CloseFrame(CloseStatusInt status_code) {
   std::string frame;
   frame.resize(sizeof(WSHeader) + sizeof(status_code));
@@ -159,6 +181,15 @@ CloseStatus ReadWSFrame(FrameParserState& frame, engine::io::ReadableBase& io,
 
   const bool isDataFrame =
       (hdr.bits.opcode & (kText | kBinary)) || hdr.bits.opcode == kContinuation;
+
+  if (hdr.bits.reserved & kReservedCompressed) {
+    // RSV1 is allowed only on the first frame of a compressed message
+    if (!frame.deflate_negotiated ||
+        (hdr.bits.opcode != kText && hdr.bits.opcode != kBinary)) {
+      return CloseStatus::kProtocolError;
+    }
+    frame.is_compressed = true;
+  }
   if (hdr.bits.payloadLen <= 125) {
     payload_len = hdr.bits.payloadLen;
   } else if (hdr.bits.payloadLen == 126) {
@@ -2,6 +2,8 @@
 
 #include <userver/server/websocket/server.hpp>
 
+#include <memory>
+#include <optional>
 #include <string>
 
 #include <boost/container/small_vector.hpp>
@@ -10,6 +12,8 @@
 #include <userver/tracing/span.hpp>
 #include <userver/utils/span.hpp>
 
+#include <server/websocket/deflate.hpp>
+
 USERVER_NAMESPACE_BEGIN
 
 namespace server::websocket::impl {
@@ -60,6 +64,9 @@ union WSHeader {
 
 static_assert(sizeof(WSHeader) == 2);
 
+// RSV1 bit of WSHeader::bits::reserved, marks compressed messages
+constexpr inline unsigned char kReservedCompressed = 0b100;
+
 constexpr inline unsigned int kMaxFrameHeaderSize =
     sizeof(WSHeader) + sizeof(uint64_t);
 
@@ -75,9 +82,28 @@ enum class Final {
   kNo,
 };
 
+enum class Compressed {
+  kYes,
+  kNo,
+};
+
 boost::container::small_vector<char, impl::kMaxFrameHeaderSize> DataFrameHeader(
     utils::span<const std::byte> data, bool is_text,
-    Continuation is_continuation, Final is_final);
+    Continuation is_continuation, Final is_final,
+    Compressed is_compressed = Compressed::kNo);
+
+struct DataFrame final {
+  boost::container::small_vector<char, impl::kMaxFrameHeaderSize> header;
+  utils::span<const std::byte> payload;
+};
+
+using DataFrames = boost::container::small_vector<DataFrame, 4>;
+
+/// Splits the message into frames of at most `fragment_size` bytes,
+/// 0 means no fragmentation. Frames reference the `data`.
+void AppendDataFrames(DataFrames& frames, utils::span<const std::byte> data,
+                      bool is_text, Compressed is_compressed,
+                      unsigned fragment_size);
 std::array<char, sizeof(WSHeader)> MakeControlFrame(
     WSOpcodes opcode, utils::span<const std::byte> data = {});
 std::string CloseFrame(CloseStatusInt status_code);
@@ -94,6 +120,9 @@ struct FrameParserState {
   bool pong_received = false;
   bool waiting_continuation = false;
   bool is_text = false;
+  // Set by the first frame of the message if it has RSV1 bit
+  bool is_compressed = false;
+  bool deflate_negotiated = false;
   CloseStatusInt remote_close_status = 0;
 
   std::string* payload = nullptr;
@@ -102,6 +131,11 @@ struct FrameParserState {
 CloseStatus ReadWSFrame(FrameParserState& frame, engine::io::ReadableBase& io,
                         unsigned max_payload_size, std::size_t& payload_len);
 
+std::shared_ptr<WebSocketConnection> MakeWebSocket(
+    std::unique_ptr<engine::io::RwBase>&& socket,
+    engine::io::Sockaddr&& peer_name, const Config& config,
+    const std::optional<DeflateParams>& deflate_params);
+
 }  // namespace server::websocket::impl
 
 USERVER_NAMESPACE_END
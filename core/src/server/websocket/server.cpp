@@ -14,6 +14,10 @@ USERVER_NAMESPACE_BEGIN
 namespace server::websocket {
 
 namespace {
+
+// Keeps the number of iovecs per write well below IOV_MAX
+constexpr std::size_t kMaxFramesPerWrite = 64;
+
 inline void SendExactly(engine::io::WritableBase& writable,
                         utils::span<const char> data1,
                         utils::span<const std::byte> data2) {
@@ -23,6 +27,31 @@ inline void SendExactly(engine::io::WritableBase& writable,
     throw(engine::io::IoException() << "Socket closed during transfer");
 }
 
+// Writes headers and payloads of the frames with vectored writes
+void SendFrames(engine::io::WritableBase& writable,
+                utils::span<const impl::frames::DataFrame> frames) {
+  boost::container::small_vector<engine::io::IoData, kMaxFramesPerWrite * 2>
+      io_data;
+  while (!frames.empty()) {
+    const auto batch =
+        frames.first(std::min(frames.size(), kMaxFramesPerWrite));
+    frames = frames.last(frames.size() - batch.size());
+
+    io_data.clear();
+    std::size_t expected_size = 0;
+    for (const auto& frame : batch) {
+      io_data.push_back({frame.header.data(), frame.header.size()});
+      io_data.push_back({frame.payload.data(), frame.payload.size()});
+      expected_size += frame.header.size() + frame.payload.size();
+    }
+
+    if (writable.WriteAll(io_data.data(), io_data.size(), {}) !=
+        expected_size) {
+      throw(engine::io::IoException() << "Socket closed during transfer");
+    }
+  }
+}
+
 Message CloseMessage(CloseStatus status) { return {{}, status, false}; }
 
 utils::span<const std::byte> MakeBinarySpan(utils::span<const char> span) {
@@ -31,14 +60,88 @@ utils::span<const std::byte> MakeBinarySpan(utils::span<const char> span) {
 
 }  // namespace
 
+DeflateConfig Parse(const yaml_config::YamlConfig& config,
+                    formats::parse::To<DeflateConfig>) {
+  DeflateConfig result;
+  result.enabled = config["enabled"].As<bool>(result.enabled);
+  result.server_no_context_takeover =
+      config["server-no-context-takeover"].As<bool>(
+          result.server_no_context_takeover);
+  result.client_no_context_takeover =
+      config["client-no-context-takeover"].As<bool>(
+          result.client_no_context_takeover);
+  result.server_max_window_bits =
+      config["server-max-window-bits"].As<int>(result.server_max_window_bits);
+  result.client_max_window_bits =
+      config["client-max-window-bits"].As<int>(result.client_max_window_bits);
+  result.compression_level =
+      config["compression-level"].As<int>(result.compression_level);
+  result.min_message_size =
+      config["min-message-size"].As<std::size_t>(result.min_message_size);
+  return result;
+}
+
 Config Parse(const yaml_config::YamlConfig& config,
              formats::parse::To<Config>) {
-  return {
-      config["max-remote-payload"].As<unsigned>(65536),
-      config["fragment-size"].As<unsigned>(65536),
+  Config result;
+  result.max_remote_payload =
+      config["max-remote-payload"].As<unsigned>(result.max_remote_payload);
+  result.fragment_size =
+      config["fragment-size"].As<unsigned>(result.fragment_size);
+  result.deflate = config["permessage-deflate"].As<DeflateConfig>(
+      DeflateConfig{});
+  return result;
+}
+
+struct PreparedMessage::Impl final {
+  struct Compressed final {
+    std::string data;
+    int window_bits{0};
+    impl::frames::DataFrames frames;
   };
+
+  std::string data;
+  bool is_text{false};
+  unsigned fragment_size{0};
+  impl::frames::DataFrames frames;
+  std::optional<Compressed> compressed;
+};
+
+PreparedMessage::PreparedMessage(std::string data, bool is_text,
+                                 const Config& config) {
+  // Frames reference the data, so it is placed before building them and
+  // never moves afterwards
+  auto impl = std::make_shared<Impl>();
+  impl->data = std::move(data);
+  impl->is_text = is_text;
+  impl->fragment_size = config.fragment_size;
+  impl::frames::AppendDataFrames(
+      impl->frames, MakeBinarySpan(impl->data), is_text,
+      impl::frames::Compressed::kNo, config.fragment_size);
+
+  const auto& deflate = config.deflate;
+  if (deflate.enabled && !impl->data.empty() &&
+      impl->data.size() >= deflate.min_message_size) {
+    // A fresh compressor makes the message independent of the sliding
+    // window of any connection
+    auto& compressed = impl->compressed.emplace();
+    compressed.window_bits = deflate.server_max_window_bits;
+    impl::Deflater{compressed.window_bits, deflate.compression_level}.Compress(
+        impl->data, compressed.data);
+    impl::frames::AppendDataFrames(
+        compressed.frames, MakeBinarySpan(compressed.data), is_text,
+        impl::frames::Compressed::kYes, config.fragment_size);
+  }
+
+  impl_ = std::move(impl);
 }
 
+const std::string& PreparedMessage::GetData() const noexcept {
+  return impl_->data;
+}
+
+bool PreparedMessage::IsText() const noexcept { return impl_->is_text; }
+
 class WebSocketConnectionImpl final : public WebSocketConnection {
  public:
  private:
@@ -64,11 +167,51 @@ class WebSocketConnectionImpl final : public WebSocketConnection {
 
   Config config;
 
+  // permessage-deflate state, deflater_ is guarded by write_mutex_ and
+  // inflater_ is used only by Recv()
+  std::optional<impl::DeflateParams> deflate_params_;
+  std::unique_ptr<impl::Deflater> deflater_;
+  std::unique_ptr<impl::Inflater> inflater_;
+  std::string compressed_buffer_;
+  std::string decompressed_buffer_;
+
+  bool ShouldCompress(std::size_t size) const {
+    return deflate_params_ && size > 0 &&
+           size >= deflate_params_->min_message_size;
+  }
+
+  impl::Deflater& GetDeflater() {
+    if (!deflater_) {
+      deflater_ = std::make_unique<impl::Deflater>(
+          deflate_params_->server_max_window_bits,
+          deflate_params_->compression_level);
+    }
+    return *deflater_;
+  }
+
+  void SendDataFrames(utils::span<const std::byte> data, bool is_text,
+                      impl::frames::Compressed is_compressed) {
+    impl::frames::DataFrames frames;
+    impl::frames::AppendDataFrames(frames, data, is_text, is_compressed,
+                                   config.fragment_size);
+    SendFrames(*io, frames);
+  }
+
  public:
-  WebSocketConnectionImpl(std::unique_ptr<engine::io::RwBase> io_,
-                          const engine::io::Sockaddr& remote_addr,
-                          const Config& server_config)
-      : io(std::move(io_)), remote_addr_(remote_addr), config(server_config) {}
+  WebSocketConnectionImpl(
+      std::unique_ptr<engine::io::RwBase> io_,
+      const engine::io::Sockaddr& remote_addr, const Config& server_config,
+      const std::optional<impl::DeflateParams>& deflate_params)
+      : io(std::move(io_)),
+        remote_addr_(remote_addr),
+        config(server_config),
+        deflate_params_(deflate_params) {
+    if (deflate_params_) {
+      frame_.deflate_negotiated = true;
+      inflater_ = std::make_unique<impl::Inflater>(
+          deflate_params_->client_max_window_bits);
+    }
+  }
 
   ~WebSocketConnectionImpl() override {
     LOG_TRACE() << "Websocket connection closed";
@@ -92,27 +235,63 @@ class WebSocketConnectionImpl final : public WebSocketConnection {
           static_cast<int>(message.close_status.value()));
       SendExactly(*io, close_frame, {});
     } else if (!message.data.empty()) {
-      utils::span<const std::byte> data_to_send{message.data};
-      auto continuation = impl::frames::Continuation::kNo;
-      while (data_to_send.size() > config.fragment_size &&
-             config.fragment_size > 0) {
-        const auto data_frame_header = impl::frames::DataFrameHeader(
-            data_to_send.first(config.fragment_size),
-            message.opcode == impl::WSOpcodes::kText, continuation,
-            impl::frames::Final::kNo);
-        SendExactly(*io, data_frame_header,
-                    data_to_send.first(config.fragment_size));
-        continuation = impl::frames::Continuation::kYes;
-        data_to_send =
-            data_to_send.last(data_to_send.size() - config.fragment_size);
+      const bool is_text = message.opcode == impl::WSOpcodes::kText;
+      if (ShouldCompress(message.data.size())) {
+        auto& deflater = GetDeflater();
+        deflater.Compress(
+            std::string_view{reinterpret_cast<const char*>(message.data.data()),
+                             message.data.size()},
+            compressed_buffer_);
+        if (deflate_params_->server_no_context_takeover) deflater.Reset();
+        SendDataFrames(MakeBinarySpan(compressed_buffer_), is_text,
+                       impl::frames::Compressed::kYes);
+      } else {
+        SendDataFrames(message.data, is_text, impl::frames::Compressed::kNo);
       }
-      const auto data_frame_header = impl::frames::DataFrameHeader(
-          data_to_send, message.opcode == impl::WSOpcodes::kText, continuation,
-          impl::frames::Final::kYes);
-      SendExactly(*io, data_frame_header, data_to_send);
     }
   }
 
+  void SendPrepared(const PreparedMessage& message) override {
+    const auto& prepared = *message.impl_;
+    if (prepared.data.empty()) return;
+
+    // Compressed data of the prepared message is usable if it fits into
+    // the window agreed with the client
+    const auto* compressed =
+        deflate_params_ && prepared.compressed &&
+                prepared.compressed->window_bits <=
+                    deflate_params_->server_max_window_bits
+            ? &*prepared.compressed
+            : nullptr;
+    if (!compressed && ShouldCompress(prepared.data.size())) {
+      // Compress it with the connection settings
+      DoSendBinaryOrText(MakeBinarySpan(prepared.data), prepared.is_text);
+      return;
+    }
+
+    stats_.msg_sent++;
+    stats_.bytes_sent += prepared.data.size();
+
+    const std::unique_lock lock(write_mutex_);
+
+    LOG_TRACE() << "Write prepared message " << prepared.data.size()
+                << " bytes";
+    const auto& frames = compressed ? compressed->frames : prepared.frames;
+    if (prepared.fragment_size == config.fragment_size) {
+      SendFrames(*io, frames);
+    } else {
+      SendDataFrames(
+          MakeBinarySpan(compressed ? compressed->data : prepared.data),
+          prepared.is_text,
+          compressed ? impl::frames::Compressed::kYes
+                     : impl::frames::Compressed::kNo);
+    }
+
+    // The client appended the message to its sliding window while our
+    // deflater did not, so further messages must not reference the history
+    if (compressed && deflater_) deflater_->Reset();
+  }
+
   void Send(const Message& message) override {
     MessageExtended mext{
         MakeBinarySpan(message.data),
@@ -131,6 +310,13 @@ class WebSocketConnectionImpl final : public WebSocketConnection {
     SendExtended(mext);
   }
 
+  void DoSendBinaryOrText(utils::span<const std::byte> message, bool is_text) {
+    MessageExtended mext{
+        message, is_text ? impl::WSOpcodes::kText : impl::WSOpcodes::kBinary,
+        {}};
+    SendExtended(mext);
+  }
+
   void Recv(Message& msg) override {
     msg.data.resize(0);  // do not call .clear() to keep the allocated memory
     frame_.payload = &msg.data;
@@ -175,6 +361,22 @@ class WebSocketConnectionImpl final : public WebSocketConnection {
         }
         if (frame_.waiting_continuation) continue;
 
+        if (frame_.is_compressed) {
+          frame_.is_compressed = false;
+          const auto inflate_status = inflater_->Decompress(
+              msg.data, decompressed_buffer_, config.max_remote_payload);
+          if (inflate_status != CloseStatus::kNone) {
+            MessageExtended close_msg{
+                {}, impl::WSOpcodes::kClose, inflate_status};
+            SendExtended(close_msg);
+            msg = CloseMessage(inflate_status);
+            return;
+          }
+          if (deflate_params_->client_no_context_takeover) inflater_->Reset();
+          // Swap to keep both allocations for the next messages
+          msg.data.swap(decompressed_buffer_);
+        }
+
         msg.is_text = frame_.is_text;
         stats_.msg_recv++;
         stats_.bytes_recv += msg.data.size();
@@ -214,13 +416,34 @@ WebSocketConnection::WebSocketConnection() = default;
 
 WebSocketConnection::~WebSocketConnection() = default;
 
+void WebSocketConnection::SendPrepared(const PreparedMessage& message) {
+  const auto& data = message.GetData();
+  if (message.IsText()) {
+    SendText(data);
+  } else {
+    DoSendBinary(MakeBinarySpan(data));
+  }
+}
+
 std::shared_ptr<WebSocketConnection> MakeWebSocket(
     std::unique_ptr<engine::io::RwBase>&& socket,
     engine::io::Sockaddr&& peer_name, const Config& config) {
+  return impl::MakeWebSocket(std::move(socket), std::move(peer_name), config,
+                             std::nullopt);
+}
+
+namespace impl {
+
+std::shared_ptr<WebSocketConnection> MakeWebSocket(
+    std::unique_ptr<engine::io::RwBase>&& socket,
+    engine::io::Sockaddr&& peer_name, const Config& config,
+    const std::optional<DeflateParams>& deflate_params) {
   return std::make_shared<WebSocketConnectionImpl>(
-      std::move(socket), std::move(peer_name), config);
+      std::move(socket), std::move(peer_name), config, deflate_params);
 }
 
+}  // namespace impl
+
 }  // namespace server::websocket
 
 USERVER_NAMESPACE_END
@@ -0,0 +1,100 @@
+#include <benchmark/benchmark.h>
+
+#include <userver/engine/run_standalone.hpp>
+#include <userver/server/websocket/server.hpp>
+
+#include <server/websocket/protocol.hpp>
+
+USERVER_NAMESPACE_BEGIN
+
+namespace {
+
+namespace ws = server::websocket;
+
+constexpr std::size_t kConnections = 100;
+
+class NullIo final : public engine::io::RwBase {
+ public:
+  bool IsValid() const override { return true; }
+
+  bool WaitReadable(engine::Deadline) override { return false; }
+
+  size_t ReadSome(void*, size_t, engine::Deadline) override { return 0; }
+
+  size_t ReadAll(void*, size_t, engine::Deadline) override { return 0; }
+
+  bool WaitWriteable(engine::Deadline) override { return true; }
+
+  size_t WriteAll(const void* buf, size_t len, engine::Deadline) override {
+    benchmark::DoNotOptimize(buf);
+    return len;
+  }
+};
+
+std::string MakeJson(std::size_t items) {
+  std::string result = "[";
+  for (std::size_t i = 0; i < items; ++i) {
+    if (i > 0) result += ',';
+    result += R"({"id":)" + std::to_string(i) + R"(,"status":"delivered"})";
+  }
+  return result + "]";
+}
+
+ws::Config MakeConfig(bool deflate) {
+  ws::Config config;
+  config.fragment_size = 4096;
+  config.deflate.enabled = deflate;
+  config.deflate.server_no_context_takeover = true;
+  return config;
+}
+
+std::vector<std::shared_ptr<ws::WebSocketConnection>> MakeConnections(
+    const ws::Config& config) {
+  const auto params = ws::impl::NegotiateDeflate(
+      "permessage-deflate; server_no_context_takeover", config.deflate);
+
+  std::vector<std::shared_ptr<ws::WebSocketConnection>> result;
+  for (std::size_t i = 0; i < kConnections; ++i) {
+    result.push_back(ws::impl::MakeWebSocket(std::make_unique<NullIo>(), {},
+                                             config, params));
+  }
+  return result;
+}
+
+}  // namespace
+
+void websocket_fanout_send(benchmark::State& state) {
+  engine::RunStandalone([&] {
+    const auto connections = MakeConnections(MakeConfig(state.range(1)));
+    const auto message = MakeJson(state.range(0));
+
+    for ([[maybe_unused]] auto _ : state) {
+      for (const auto& connection : connections) connection->SendText(message);
+    }
+    state.SetBytesProcessed(state.iterations() * kConnections *
+                            message.size());
+  });
+}
+BENCHMARK(websocket_fanout_send)
+    ->ArgsProduct({{10, 1000, 10000}, {false, true}});
+
+void websocket_fanout_send_prepared(benchmark::State& state) {
+  engine::RunStandalone([&] {
+    const auto config = MakeConfig(state.range(1));
+    const auto connections = MakeConnections(config);
+    const auto message = MakeJson(state.range(0));
+
+    for ([[maybe_unused]] auto _ : state) {
+      const ws::PreparedMessage prepared{message, true, config};
+      for (const auto& connection : connections) {
+        connection->SendPrepared(prepared);
+      }
+    }
+    state.SetBytesProcessed(state.iterations() * kConnections *
+                            message.size());
+  });
+}
+BENCHMARK(websocket_fanout_send_prepared)
+    ->ArgsProduct({{10, 1000, 10000}, {false, true}});
+
+USERVER_NAMESPACE_END
@@ -61,6 +61,14 @@ std::string WebsocketHandlerBase::HandleRequestThrow(
 
   if (!HandleHandshake(request, response, context)) return "";
 
+  auto deflate_params = impl::NegotiateDeflate(
+      request.GetHeader(USERVER_NAMESPACE::http::headers::kWebsocketExtensions),
+      config_.deflate);
+  if (deflate_params) {
+    response.SetHeader(USERVER_NAMESPACE::http::headers::kWebsocketExtensions,
+                       impl::MakeDeflateResponse(*deflate_params));
+  }
+
   response.SetStatus(server::http::HttpStatus::kSwitchingProtocols);
   response.SetHeader(USERVER_NAMESPACE::http::headers::kConnection, "Upgrade");
   response.SetHeader(USERVER_NAMESPACE::http::headers::kUpgrade, "websocket");
@@ -70,11 +78,12 @@ std::string WebsocketHandlerBase::HandleRequestThrow(
   request.SetUpgradeWebsocket(
       [context = std::make_shared<server::request::RequestContext>(
            std::move(context)),
+       deflate_params,
        this](std::unique_ptr<engine::io::RwBase> socket,
              engine::io::Sockaddr&& peer_name) {
         tracing::Span span("ws/" + HandlerName());
-        auto ws = websocket::MakeWebSocket(std::move(socket),
-                                           std::move(peer_name), config_);
+        auto ws = websocket::impl::MakeWebSocket(
+            std::move(socket), std::move(peer_name), config_, deflate_params);
         try {
           Handle(*ws, *context);
         } catch (const std::exception& e) {
@@ -87,6 +96,11 @@ std::string WebsocketHandlerBase::HandleRequestThrow(
   return "";
 }
 
+PreparedMessage WebsocketHandlerBase::PrepareMessage(std::string data,
+                                                     bool is_text) const {
+  return PreparedMessage{std::move(data), is_text, config_};
+}
+
 void WebsocketHandlerBase::WriteMetrics(
     utils::statistics::Writer& writer) const {
   writer["msg"]["sent"] = stats_.msg_sent.load();
@@ -110,6 +124,46 @@ properties:
         type: integer
         description: max output fragment size
         defaultDescription: 65536
+    permessage-deflate:
+        type: object
+        description: permessage-deflate compression extension (RFC 7692)
+        additionalProperties: false
+        properties:
+            enabled:
+                type: boolean
+                description: accept the extension if the client offers it
+                defaultDescription: false
+            server-no-context-takeover:
+                type: boolean
+                description: do not reuse the compression window between sent messages
+                defaultDescription: false
+            client-no-context-takeover:
+                type: boolean
+                description: ask the client not to reuse the window between messages
+                defaultDescription: false
+            server-max-window-bits:
+                type: integer
+                description: log2 of the compression window of sent messages
+                defaultDescription: 15
+                minimum: 9
+                maximum: 15
+            client-max-window-bits:
+                type: integer
+                description: max log2 of the window of received messages, if the client supports the limit
+                defaultDescription: 15
+                minimum: 8
+                maximum: 15
+            compression-level:
+                type: integer
+                description: zlib compression level
+                defaultDescription: 6
+                minimum: 0
+                maximum: 9
+            min-message-size:
+                type: integer
+                description: smaller messages are sent uncompressed
+                defaultDescription: 0
+                minimum: 0
 )");
 }
 
@@ -0,0 +1,164 @@
+#pragma once
+
+#include <algorithm>
+#include <array>
+#include <cstddef>
+#include <cstring>
+#include <functional>
+#include <memory>
+#include <string>
+#include <string_view>
+#include <utility>
+
+USERVER_NAMESPACE_BEGIN
+
+namespace tracing::impl {
+
+namespace detail {
+
+constexpr std::string_view kLowerXdigits = "0123456789abcdef";
+
+constexpr int LowerHexValue(char c) noexcept {
+  if (c >= '0' && c <= '9') return c - '0';
+  if (c >= 'a' && c <= 'f') return c - 'a' + 10;
+  return -1;
+}
+
+}  // namespace detail
+
+/// Trace or span id of a tracing::Span.
+///
+/// Lowercase hex ids of the native size (the generated ones and the ones from
+/// the W3C and B3 headers) are kept in binary and formatted on demand, so
+/// creating a span does not allocate for the ids. Other ids that come from
+/// the external headers are kept as is.
+template <std::size_t Bytes>
+class HexId final {
+ public:
+  static constexpr std::size_t kHexSize = Bytes * 2;
+
+  /// Hex representation that lives on the stack
+  class Formatted final {
+   public:
+    std::string_view ToStringView() const& noexcept {
+      return external_.data() ? external_ : std::string_view{data_, size_};
+    }
+    std::string_view ToStringView() && noexcept = delete;
+
+   private:
+    friend class HexId;
+
+    char data_[kHexSize]{};
+    std::size_t size_{0};
+    std::string_view external_;
+  };
+
+  HexId() = default;
+
+  HexId(const HexId& other)
+      : binary_(other.binary_),
+        kind_(other.kind_),
+        string_(other.string_ ? std::make_unique<std::string>(*other.string_)
+                              : nullptr) {}
+  HexId(HexId&& other) noexcept
+      : binary_(other.binary_),
+        kind_(std::exchange(other.kind_, Kind::kEmpty)),
+        string_(std::move(other.string_)) {}
+
+  HexId& operator=(const HexId& other) {
+    if (this != &other) *this = HexId{other};
+    return *this;
+  }
+  HexId& operator=(HexId&& other) noexcept {
+    binary_ = other.binary_;
+    kind_ = std::exchange(other.kind_, Kind::kEmpty);
+    string_ = std::move(other.string_);
+    return *this;
+  }
+
+  explicit HexId(std::string_view value) {
+    if (value.empty()) return;
+
+    if (value.size() == kHexSize) {
+      bool is_binary = true;
+      for (std::size_t i = 0; i < Bytes && is_binary; ++i) {
+        const auto high = detail::LowerHexValue(value[i * 2]);
+        const auto low = detail::LowerHexValue(value[i * 2 + 1]);
+        is_binary = (high >= 0 && low >= 0);
+        binary_[i] = static_cast<unsigned char>((high << 4) | low);
+      }
+      if (is_binary) {
+        kind_ = Kind::kBinary;
+        return;
+      }
+    }
+
+    kind_ = Kind::kString;
+    string_ = std::make_unique<std::string>(value);
+  }
+
+  /// @param data pointer to `Bytes` bytes of the id
+  static HexId FromBinary(const void* data) noexcept {
+    HexId result;
+    std::memcpy(result.binary_.data(), data, Bytes);
+    result.kind_ = Kind::kBinary;
+    return result;
+  }
+
+  bool IsEmpty() const noexcept { return kind_ == Kind::kEmpty; }
+
+  Formatted ToHex() const noexcept {
+    Formatted result;
+    if (kind_ == Kind::kString) {
+      result.external_ = *string_;
+    } else if (kind_ == Kind::kBinary) {
+      for (std::size_t i = 0; i < Bytes; ++i) {
+        result.data_[i * 2] = detail::kLowerXdigits[binary_[i] >> 4];
+        result.data_[i * 2 + 1] = detail::kLowerXdigits[binary_[i] & 0xf];
+      }
+      result.size_ = kHexSize;
+    }
+    return result;
+  }
+
+  /// Binary form of the id for the binary protocols. Ids that are kept as
+  /// strings are hashed, empty id is all zeros.
+  std::array<unsigned char, Bytes> ToBinary() const noexcept {
+    if (kind_ == Kind::kBinary) return binary_;
+
+    std::array<unsigned char, Bytes> result{};
+    if (kind_ == Kind::kString) {
+      const auto hash = std::hash<std::string>{}(*string_);
+      for (std::size_t i = 0; i < Bytes; i += sizeof(hash)) {
+        const auto part = hash ^ (i * 0x9e3779b97f4a7c15ULL);
+        std::memcpy(result.data() + i, &part,
+                    std::min(sizeof(part), Bytes - i));
+      }
+    }
+    return result;
+  }
+
+  std::string ToString() const {
+    const auto formatted = ToHex();
+    return std::string{formatted.ToStringView()};
+  }
+
+ private:
+  enum class Kind : unsigned char {
+    kEmpty,
+    kBinary,
+    kString,
+  };
+
+  std::array<unsigned char, Bytes> binary_{};
+  Kind kind_{Kind::kEmpty};
+  // Rare, so it is allocated to keep the span small
+  std::unique_ptr<std::string> string_;
+};
+
+using TraceId = HexId<16>;
+using SpanId = HexId<8>;
+
+}  // namespace tracing::impl
+
+USERVER_NAMESPACE_END
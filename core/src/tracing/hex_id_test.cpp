@@ -0,0 +1,70 @@
+#include <tracing/hex_id.hpp>
+
+#include <gtest/gtest.h>
+
+#include <userver/utils/encoding/hex.hpp>
+
+USERVER_NAMESPACE_BEGIN
+
+namespace {
+
+template <typename Id>
+std::string Format(const Id& id) {
+  const auto formatted = id.ToHex();
+  return std::string{formatted.ToStringView()};
+}
+
+}  // namespace
+
+TEST(TracingHexId, Empty) {
+  const tracing::impl::SpanId id;
+  EXPECT_TRUE(id.IsEmpty());
+  EXPECT_EQ(Format(id), "");
+  EXPECT_TRUE(tracing::impl::SpanId{""}.IsEmpty());
+}
+
+TEST(TracingHexId, Native) {
+  constexpr std::string_view kTraceId = "0123456789abcdef0123456789abcdef";
+  constexpr std::string_view kSpanId = "00ff10a0b0c0d0e9";
+
+  EXPECT_EQ(Format(tracing::impl::TraceId{kTraceId}), kTraceId);
+  EXPECT_EQ(tracing::impl::TraceId{kTraceId}.ToString(), kTraceId);
+  EXPECT_EQ(Format(tracing::impl::SpanId{kSpanId}), kSpanId);
+  EXPECT_FALSE(tracing::impl::SpanId{kSpanId}.IsEmpty());
+}
+
+TEST(TracingHexId, Binary) {
+  const std::uint64_t value = 0x0123456789abcdef;
+  const auto id = tracing::impl::SpanId::FromBinary(&value);
+  EXPECT_EQ(Format(id), utils::encoding::ToHex(&value, sizeof(value)));
+}
+
+TEST(TracingHexId, External) {
+  for (const std::string_view external : {
+           "1234567890-trace-id",
+           "0123456789ABCDEF",
+           "0123456789abcdeg",
+           "0123456789abcdef0",
+           "0",
+       }) {
+    const tracing::impl::SpanId id{external};
+    EXPECT_FALSE(id.IsEmpty());
+    EXPECT_EQ(Format(id), external);
+    EXPECT_EQ(id.ToString(), external);
+  }
+}
+
+TEST(TracingHexId, Copy) {
+  const tracing::impl::SpanId native{"0123456789abcdef"};
+  const tracing::impl::SpanId external{"some-id"};
+
+  auto native_copy = native;
+  auto external_copy = external;
+  EXPECT_EQ(Format(native_copy), "0123456789abcdef");
+  EXPECT_EQ(Format(external_copy), "some-id");
+
+  native_copy = external;
+  EXPECT_EQ(Format(native_copy), "some-id");
+}
+
+USERVER_NAMESPACE_END
@@ -42,8 +42,8 @@ InPlaceSpan::InPlaceSpan(std::string&& name, std::string&& trace_id,
     : impl_(std::move(name), ReferenceType::kChild, logging::Level::kInfo,
             std::move(source_location)) {
   impl_->span.AttachToCoroStack();
-  impl_->span_impl.SetTraceId(std::move(trace_id));
-  impl_->span_impl.SetParentId(std::move(parent_span_id));
+  impl_->span_impl.SetTraceId(trace_id);
+  impl_->span_impl.SetParentId(parent_span_id);
   SetLinkIfRoot(impl_->span);
 }
 
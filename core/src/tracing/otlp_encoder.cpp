@@ -0,0 +1,252 @@
+#include <tracing/otlp_encoder.hpp>
+
+#include <array>
+#include <chrono>
+#include <cstdint>
+#include <cstring>
+#include <type_traits>
+#include <variant>
+
+#include <userver/tracing/tags.hpp>
+
+USERVER_NAMESPACE_BEGIN
+
+namespace tracing::impl::otlp {
+
+namespace {
+
+// Field numbers from opentelemetry/proto/trace/v1/trace.proto and
+// opentelemetry/proto/common/v1/common.proto
+namespace fields {
+
+constexpr std::uint32_t kRequestResourceSpans = 1;
+
+constexpr std::uint32_t kResourceSpansResource = 1;
+constexpr std::uint32_t kResourceSpansScopeSpans = 2;
+
+constexpr std::uint32_t kResourceAttributes = 1;
+
+constexpr std::uint32_t kScopeSpansScope = 1;
+constexpr std::uint32_t kScopeSpansSpans = 2;
+
+constexpr std::uint32_t kScopeName = 1;
+
+constexpr std::uint32_t kSpanTraceId = 1;
+constexpr std::uint32_t kSpanSpanId = 2;
+constexpr std::uint32_t kSpanParentSpanId = 4;
+constexpr std::uint32_t kSpanName = 5;
+constexpr std::uint32_t kSpanKind = 6;
+constexpr std::uint32_t kSpanStartTime = 7;
+constexpr std::uint32_t kSpanEndTime = 8;
+constexpr std::uint32_t kSpanAttributes = 9;
+constexpr std::uint32_t kSpanStatus = 15;
+
+constexpr std::uint32_t kStatusCode = 3;
+
+constexpr std::uint32_t kKeyValueKey = 1;
+constexpr std::uint32_t kKeyValueValue = 2;
+
+constexpr std::uint32_t kAnyValueString = 1;
+constexpr std::uint32_t kAnyValueInt = 3;
+constexpr std::uint32_t kAnyValueDouble = 4;
+
+}  // namespace fields
+
+constexpr std::uint64_t kSpanKindInternal = 1;
+constexpr std::uint64_t kStatusCodeError = 2;
+
+constexpr std::string_view kScopeName = "userver";
+constexpr std::string_view kServiceNameAttribute = "service.name";
+constexpr std::string_view kReferenceTypeAttribute = "span_ref_type";
+constexpr std::string_view kReferenceTypeFollows = "follows";
+
+enum class WireType : std::uint32_t {
+  kVarint = 0,
+  kFixed64 = 1,
+  kLengthDelimited = 2,
+};
+
+// Minimal protobuf writer, nested messages are written in place and their
+// length is inserted in front of them when the message is finished.
+class ProtoWriter final {
+ public:
+  explicit ProtoWriter(std::string& output) : output_(output) {}
+
+  void WriteVarint(std::uint32_t field, std::uint64_t value) {
+    WriteTag(field, WireType::kVarint);
+    WriteRawVarint(value);
+  }
+
+  void WriteFixed64(std::uint32_t field, std::uint64_t value) {
+    WriteTag(field, WireType::kFixed64);
+    char buffer[sizeof(value)];
+    for (std::size_t i = 0; i < sizeof(value); ++i) {
+      buffer[i] = static_cast<char>((value >> (i * 8)) & 0xff);
+    }
+    output_.append(buffer, sizeof(buffer));
+  }
+
+  void WriteDouble(std::uint32_t field, double value) {
+    static_assert(sizeof(double) == sizeof(std::uint64_t));
+    std::uint64_t bits{};
+    std::memcpy(&bits, &value, sizeof(bits));
+    WriteFixed64(field, bits);
+  }
+
+  void WriteBytes(std::uint32_t field, std::string_view value) {
+    WriteTag(field, WireType::kLengthDelimited);
+    WriteRawVarint(value.size());
+    output_.append(value);
+  }
+
+  template <std::size_t Size>
+  void WriteBytes(std::uint32_t field,
+                  const std::array<unsigned char, Size>& value) {
+    WriteBytes(field, std::string_view{
+                          reinterpret_cast<const char*>(value.data()), Size});
+  }
+
+  template <typename Func>
+  void WriteMessage(std::uint32_t field, Func&& func) {
+    WriteTag(field, WireType::kLengthDelimited);
+    const auto start = output_.size();
+    func();
+    const auto size = output_.size() - start;
+
+    char buffer[10];
+    const auto length = EncodeVarint(size, buffer);
+    output_.insert(start, buffer, length);
+  }
+
+ private:
+  void WriteTag(std::uint32_t field, WireType wire_type) {
+    WriteRawVarint((field << 3) | static_cast<std::uint32_t>(wire_type));
+  }
+
+  void WriteRawVarint(std::uint64_t value) {
+    char buffer[10];
+    output_.append(buffer, EncodeVarint(value, buffer));
+  }
+
+  static std::size_t EncodeVarint(std::uint64_t value, char* buffer) {
+    std::size_t size = 0;
+    while (value >= 0x80) {
+      buffer[size++] = static_cast<char>((value & 0x7f) | 0x80);
+      value >>= 7;
+    }
+    buffer[size++] = static_cast<char>(value);
+    return size;
+  }
+
+  std::string& output_;
+};
+
+std::uint64_t ToUnixNano(std::chrono::system_clock::time_point time) {
+  return std::chrono::duration_cast<std::chrono::nanoseconds>(
+             time.time_since_epoch())
+      .count();
+}
+
+void WriteStringAttribute(ProtoWriter& writer, std::uint32_t field,
+                          std::string_view key, std::string_view value) {
+  writer.WriteMessage(field, [&] {
+    writer.WriteBytes(fields::kKeyValueKey, key);
+    writer.WriteMessage(fields::kKeyValueValue, [&] {
+      writer.WriteBytes(fields::kAnyValueString, value);
+    });
+  });
+}
+
+void WriteAttribute(ProtoWriter& writer, std::string_view key,
+                    const logging::LogExtra::Value& value) {
+  writer.WriteMessage(fields::kSpanAttributes, [&] {
+    writer.WriteBytes(fields::kKeyValueKey, key);
+    writer.WriteMessage(fields::kKeyValueValue, [&] {
+      std::visit(
+          [&writer](const auto& item) {
+            using Type = std::decay_t<decltype(item)>;
+            if constexpr (std::is_same_v<Type, std::string>) {
+              writer.WriteBytes(fields::kAnyValueString, item);
+            } else if constexpr (std::is_floating_point_v<Type>) {
+              writer.WriteDouble(fields::kAnyValueDouble, item);
+            } else {
+              // int64 is encoded as two's complement varint
+              writer.WriteVarint(
+                  fields::kAnyValueInt,
+                  static_cast<std::uint64_t>(static_cast<std::int64_t>(item)));
+            }
+          },
+          value);
+    });
+  });
+}
+
+bool IsError(const logging::LogExtra::Value& value) {
+  return std::visit(
+      [](const auto& item) {
+        using Type = std::decay_t<decltype(item)>;
+        if constexpr (std::is_same_v<Type, std::string>) {
+          return item == "true" || item == "1";
+        } else {
+          return item != 0;
+        }
+      },
+      value);
+}
+
+void WriteSpan(ProtoWriter& writer, const SpanRecord& span) {
+  writer.WriteBytes(fields::kSpanTraceId, span.trace_id.ToBinary());
+  writer.WriteBytes(fields::kSpanSpanId, span.span_id.ToBinary());
+  if (!span.parent_id.IsEmpty()) {
+    writer.WriteBytes(fields::kSpanParentSpanId, span.parent_id.ToBinary());
+  }
+  writer.WriteBytes(fields::kSpanName, span.name);
+  writer.WriteVarint(fields::kSpanKind, kSpanKindInternal);
+
+  const auto start = ToUnixNano(span.start_time);
+  writer.WriteFixed64(fields::kSpanStartTime, start);
+  writer.WriteFixed64(fields::kSpanEndTime, start + span.duration.count());
+
+  bool is_error = false;
+  for (const auto& [key, value] : span.attributes) {
+    WriteAttribute(writer, key, value);
+    if (key == kErrorFlag) is_error = IsError(value);
+  }
+  if (span.reference_type == ReferenceType::kReference) {
+    WriteStringAttribute(writer, fields::kSpanAttributes,
+                         kReferenceTypeAttribute, kReferenceTypeFollows);
+  }
+
+  if (is_error) {
+    writer.WriteMessage(fields::kSpanStatus, [&] {
+      writer.WriteVarint(fields::kStatusCode, kStatusCodeError);
+    });
+  }
+}
+
+}  // namespace
+
+void SerializeExportRequest(std::string_view service_name,
+                            const std::vector<SpanRecord>& spans,
+                            std::string& output) {
+  ProtoWriter writer{output};
+  writer.WriteMessage(fields::kRequestResourceSpans, [&] {
+    writer.WriteMessage(fields::kResourceSpansResource, [&] {
+      WriteStringAttribute(writer, fields::kResourceAttributes,
+                           kServiceNameAttribute, service_name);
+    });
+    writer.WriteMessage(fields::kResourceSpansScopeSpans, [&] {
+      writer.WriteMessage(fields::kScopeSpansScope, [&] {
+        writer.WriteBytes(fields::kScopeName, kScopeName);
+      });
+      for (const auto& span : spans) {
+        writer.WriteMessage(fields::kScopeSpansSpans,
+                            [&] { WriteSpan(writer, span); });
+      }
+    });
+  });
+}
+
+}  // namespace tracing::impl::otlp
+
+USERVER_NAMESPACE_END
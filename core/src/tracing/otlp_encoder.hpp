@@ -0,0 +1,21 @@
+#pragma once
+
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include <tracing/span_exporter.hpp>
+
+USERVER_NAMESPACE_BEGIN
+
+namespace tracing::impl::otlp {
+
+/// Appends the spans to `output` as a protobuf encoded
+/// opentelemetry.proto.collector.trace.v1.ExportTraceServiceRequest
+void SerializeExportRequest(std::string_view service_name,
+                            const std::vector<SpanRecord>& spans,
+                            std::string& output);
+
+}  // namespace tracing::impl::otlp
+
+USERVER_NAMESPACE_END
@@ -0,0 +1,112 @@
+#include <tracing/otlp_span_exporter.hpp>
+
+#include <userver/engine/async.hpp>
+#include <userver/engine/task/cancel.hpp>
+#include <userver/logging/log.hpp>
+#include <userver/utils/assert.hpp>
+
+#include <tracing/otlp_encoder.hpp>
+
+USERVER_NAMESPACE_BEGIN
+
+namespace tracing::impl {
+
+OtlpSpanExporter::OtlpSpanExporter(Config config, Sender sender)
+    : config_(std::move(config)),
+      sender_(std::move(sender)),
+      queue_(Queue::Create(config_.max_queue_size)),
+      producer_(queue_->GetMultiProducer()),
+      consumer_(queue_->GetConsumer()) {
+  UINVARIANT(config_.max_batch_size > 0, "max-batch-size must be positive");
+}
+
+OtlpSpanExporter::~OtlpSpanExporter() {
+  UASSERT_MSG(!export_task_.IsValid(),
+              "StopExportTask() must be called before destruction");
+}
+
+void OtlpSpanExporter::StartExportTask(engine::TaskProcessor& task_processor) {
+  UASSERT(!export_task_.IsValid());
+  export_task_ = engine::CriticalAsyncNoSpan(task_processor,
+                                             [this] { ProcessingLoop(); });
+}
+
+void OtlpSpanExporter::StopExportTask() {
+  if (!export_task_.IsValid()) return;
+  export_task_.SyncCancel();
+  export_task_ = {};
+}
+
+void OtlpSpanExporter::Export(SpanRecord&& record) noexcept {
+  bool pushed = false;
+  try {
+    pushed = producer_.PushNoblock(std::move(record));
+  } catch (const std::exception&) {
+    // Dropped as well
+  }
+  if (!pushed) dropped_.fetch_add(1, std::memory_order_relaxed);
+}
+
+bool OtlpSpanExporter::ShouldLogSpans() const noexcept {
+  return config_.log_spans;
+}
+
+void OtlpSpanExporter::ProcessingLoop() {
+  // Spans of the sender (e.g. HTTP client spans) must not be exported,
+  // otherwise each batch would produce a new one. Warnings are still logged.
+  tracing::Span span{"otlp_export"};
+  span.SetLocalLogLevel(logging::Level::kWarning);
+
+  std::vector<SpanRecord> batch;
+  batch.reserve(config_.max_batch_size);
+
+  SpanRecord record;
+  while (!engine::current_task::ShouldCancel()) {
+    const auto deadline = engine::Deadline::FromDuration(config_.flush_period);
+    while (batch.size() < config_.max_batch_size &&
+           consumer_.Pop(record, deadline)) {
+      batch.push_back(std::move(record));
+    }
+    SendBatch(batch);
+  }
+
+  // Send the spans that are already in the queue
+  const engine::TaskCancellationBlocker block_cancel;
+  while (consumer_.PopNoblock(record)) {
+    batch.push_back(std::move(record));
+    if (batch.size() >= config_.max_batch_size) SendBatch(batch);
+  }
+  SendBatch(batch);
+}
+
+void OtlpSpanExporter::SendBatch(std::vector<SpanRecord>& batch) noexcept {
+  if (batch.empty()) return;
+
+  try {
+    buffer_.clear();
+    otlp::SerializeExportRequest(config_.service_name, batch, buffer_);
+    sender_(buffer_);
+    exported_.fetch_add(batch.size(), std::memory_order_relaxed);
+  } catch (const std::exception& e) {
+    send_errors_.fetch_add(1, std::memory_order_relaxed);
+    dropped_.fetch_add(batch.size(), std::memory_order_relaxed);
+    LOG_LIMITED_WARNING() << "Failed to export " << batch.size()
+                          << " spans: " << e;
+  }
+  batches_.fetch_add(1, std::memory_order_relaxed);
+  batch.clear();
+}
+
+void DumpMetric(utils::statistics::Writer& writer,
+                const OtlpSpanExporter& exporter) {
+  writer["exported"] = exporter.exported_.load(std::memory_order_relaxed);
+  writer["dropped"] = exporter.dropped_.load(std::memory_order_relaxed);
+  writer["batches"] = exporter.batches_.load(std::memory_order_relaxed);
+  writer["send-errors"] =
+      exporter.send_errors_.load(std::memory_order_relaxed);
+  writer["queue-size"] = exporter.queue_->GetSizeApproximate();
+}
+
+}  // namespace tracing::impl
+
+USERVER_NAMESPACE_END
@@ -0,0 +1,78 @@
+#pragma once
+
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <functional>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include <userver/concurrent/queue.hpp>
+#include <userver/engine/task/task.hpp>
+#include <userver/engine/task/task_processor_fwd.hpp>
+#include <userver/utils/statistics/writer.hpp>
+
+#include <tracing/span_exporter.hpp>
+
+USERVER_NAMESPACE_BEGIN
+
+namespace tracing::impl {
+
+/// @brief Exports the finished spans in OTLP protobuf format.
+///
+/// Spans are pushed into a bounded lock-free queue without formatting, the
+/// background task batches them and calls the sender with a serialized
+/// ExportTraceServiceRequest. If the queue is full, spans are dropped.
+class OtlpSpanExporter final : public SpanExporter {
+ public:
+  struct Config {
+    std::string service_name;
+    std::size_t max_queue_size{65536};
+    std::size_t max_batch_size{512};
+    std::chrono::milliseconds flush_period{1000};
+    bool log_spans{false};
+  };
+
+  /// Sends a serialized batch, throws on errors
+  using Sender = std::function<void(std::string_view body)>;
+
+  OtlpSpanExporter(Config config, Sender sender);
+  ~OtlpSpanExporter() override;
+
+  void StartExportTask(engine::TaskProcessor& task_processor);
+
+  /// Sends the spans that are already in the queue and stops the export task
+  void StopExportTask();
+
+  void Export(SpanRecord&& record) noexcept override;
+
+  bool ShouldLogSpans() const noexcept override;
+
+  friend void DumpMetric(utils::statistics::Writer& writer,
+                         const OtlpSpanExporter& exporter);
+
+ private:
+  using Queue = concurrent::NonFifoMpscQueue<SpanRecord>;
+
+  void ProcessingLoop();
+  void SendBatch(std::vector<SpanRecord>& batch) noexcept;
+
+  const Config config_;
+  const Sender sender_;
+
+  std::shared_ptr<Queue> queue_;
+  Queue::MultiProducer producer_;
+  Queue::Consumer consumer_;
+  engine::Task export_task_;
+  std::string buffer_;
+
+  std::atomic<std::uint64_t> exported_{0};
+  std::atomic<std::uint64_t> dropped_{0};
+  std::atomic<std::uint64_t> batches_{0};
+  std::atomic<std::uint64_t> send_errors_{0};
+};
+
+}  // namespace tracing::impl
+
+USERVER_NAMESPACE_END
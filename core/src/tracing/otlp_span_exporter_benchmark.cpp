@@ -0,0 +1,68 @@
+#include <benchmark/benchmark.h>
+
+#include <userver/engine/run_standalone.hpp>
+#include <userver/engine/task/task.hpp>
+#include <userver/tracing/span.hpp>
+
+#include <tracing/otlp_encoder.hpp>
+#include <tracing/otlp_span_exporter.hpp>
+
+USERVER_NAMESPACE_BEGIN
+
+namespace {
+
+tracing::impl::SpanRecord MakeRecord() {
+  tracing::impl::SpanRecord record;
+  record.name = "external";
+  record.trace_id =
+      tracing::impl::TraceId{"0123456789abcdef0123456789abcdef"};
+  record.span_id = tracing::impl::SpanId{"0123456789abcdef"};
+  record.parent_id = tracing::impl::SpanId{"fedcba9876543210"};
+  record.start_time = std::chrono::system_clock::now();
+  record.duration = std::chrono::microseconds{1234};
+  record.attributes.emplace_back("http_url", "http://example.com/v1/handle");
+  record.attributes.emplace_back("meta_code", 200);
+  record.attributes.emplace_back("attempts", 1);
+  return record;
+}
+
+}  // namespace
+
+void otlp_serialize_batch(benchmark::State& state) {
+  const std::vector<tracing::impl::SpanRecord> batch(state.range(0),
+                                                     MakeRecord());
+  std::string output;
+
+  for ([[maybe_unused]] auto _ : state) {
+    tracing::impl::otlp::SerializeExportRequest("service", batch, output);
+    benchmark::DoNotOptimize(output);
+  }
+  state.SetItemsProcessed(state.iterations() * batch.size());
+}
+BENCHMARK(otlp_serialize_batch)->RangeMultiplier(8)->Range(1, 512);
+
+void otlp_export_span(benchmark::State& state) {
+  engine::RunStandalone([&] {
+    auto exporter = std::make_shared<tracing::impl::OtlpSpanExporter>(
+        tracing::impl::OtlpSpanExporter::Config{"service",
+                                                /*max_queue_size=*/1 << 20},
+        [](std::string_view) {});
+    exporter->StartExportTask(engine::current_task::GetTaskProcessor());
+    tracing::impl::SetSpanExporter(exporter);
+
+    {
+      tracing::Span root_span{"root"};
+      for ([[maybe_unused]] auto _ : state) {
+        tracing::Span span{"external"};
+        span.AddTag("http_url", "http://example.com/v1/handle");
+      }
+    }
+
+    tracing::impl::SetSpanExporter(nullptr);
+    exporter->StopExportTask();
+  });
+  state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK(otlp_export_span);
+
+USERVER_NAMESPACE_END
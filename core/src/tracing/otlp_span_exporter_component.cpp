@@ -0,0 +1,131 @@
+#include <userver/tracing/otlp_span_exporter_component.hpp>
+
+#include <userver/clients/http/component.hpp>
+#include <userver/components/component.hpp>
+#include <userver/components/statistics_storage.hpp>
+#include <userver/http/common_headers.hpp>
+#include <userver/tracing/tracer.hpp>
+#include <userver/yaml_config/merge_schemas.hpp>
+
+#include <tracing/otlp_span_exporter.hpp>
+
+USERVER_NAMESPACE_BEGIN
+
+namespace components {
+
+namespace {
+
+constexpr std::string_view kProtobufContentType = "application/x-protobuf";
+
+tracing::impl::OtlpSpanExporter::Config ParseConfig(
+    const ComponentConfig& config) {
+  tracing::impl::OtlpSpanExporter::Config result;
+  result.service_name = config["service-name"].As<std::string>(
+      tracing::Tracer::GetTracer()->GetServiceName());
+  result.max_queue_size =
+      config["max-queue-size"].As<std::size_t>(result.max_queue_size);
+  result.max_batch_size =
+      config["max-batch-size"].As<std::size_t>(result.max_batch_size);
+  result.flush_period = config["flush-period"].As<std::chrono::milliseconds>(
+      result.flush_period);
+  result.log_spans = config["log-spans"].As<bool>(result.log_spans);
+  return result;
+}
+
+}  // namespace
+
+OtlpSpanExporter::OtlpSpanExporter(const ComponentConfig& config,
+                                   const ComponentContext& context)
+    : ComponentBase(config, context) {
+  auto& http_client =
+      context
+          .FindComponent<HttpClient>(
+              config["http-client"].As<std::string>(HttpClient::kName))
+          .GetHttpClient();
+  const auto endpoint = config["endpoint"].As<std::string>();
+  const auto timeout =
+      config["timeout"].As<std::chrono::milliseconds>(std::chrono::seconds{1});
+
+  exporter_ = std::make_shared<tracing::impl::OtlpSpanExporter>(
+      ParseConfig(config),
+      [&http_client, endpoint, timeout](std::string_view body) {
+        http_client.CreateRequest()
+            .post(endpoint, std::string{body})
+            .headers({{USERVER_NAMESPACE::http::headers::kContentType,
+                       kProtobufContentType}})
+            .timeout(timeout)
+            .perform()
+            ->raise_for_status();
+      });
+
+  auto& task_processor =
+      config.HasMember("task-processor")
+          ? context.GetTaskProcessor(
+                config["task-processor"].As<std::string>())
+          : engine::current_task::GetTaskProcessor();
+  exporter_->StartExportTask(task_processor);
+  tracing::impl::SetSpanExporter(exporter_);
+
+  auto& storage =
+      context.FindComponent<components::StatisticsStorage>().GetStorage();
+  statistics_holder_ = storage.RegisterWriter(
+      std::string{kName}, [this](utils::statistics::Writer& writer) {
+        writer = *exporter_;
+      });
+}
+
+OtlpSpanExporter::~OtlpSpanExporter() {
+  statistics_holder_.Unregister();
+  tracing::impl::SetSpanExporter(nullptr);
+  exporter_->StopExportTask();
+}
+
+yaml_config::Schema OtlpSpanExporter::GetStaticConfigSchema() {
+  return yaml_config::MergeSchemas<ComponentBase>(R"(
+type: object
+description: Component that sends the finished spans to an OpenTelemetry collector
+additionalProperties: false
+properties:
+    endpoint:
+        type: string
+        description: OTLP/HTTP traces URL of the collector
+    service-name:
+        type: string
+        description: service name to write into the `service.name` resource attribute
+        defaultDescription: service-name of components::Tracer
+    http-client:
+        type: string
+        description: name of the components::HttpClient to send the spans with
+        defaultDescription: http-client
+    task-processor:
+        type: string
+        description: task processor for the background export task
+        defaultDescription: main-task-processor
+    max-queue-size:
+        type: integer
+        description: max number of spans waiting for the export
+        defaultDescription: 65536
+        minimum: 1
+    max-batch-size:
+        type: integer
+        description: max number of spans in a single request
+        defaultDescription: 512
+        minimum: 1
+    flush-period:
+        type: string
+        description: max time to wait for a batch to be filled
+        defaultDescription: 1s
+    timeout:
+        type: string
+        description: HTTP request timeout
+        defaultDescription: 1s
+    log-spans:
+        type: boolean
+        description: write spans into the default logger as well
+        defaultDescription: false
+)");
+}
+
+}  // namespace components
+
+USERVER_NAMESPACE_END
@@ -0,0 +1,298 @@
+#include <tracing/otlp_span_exporter.hpp>
+
+#include <cstdint>
+#include <map>
+#include <mutex>
+
+#include <gmock/gmock.h>
+
+#include <logging/logging_test.hpp>
+#include <tracing/otlp_encoder.hpp>
+#include <userver/tracing/span.hpp>
+#include <userver/utest/utest.hpp>
+#include <userver/utils/statistics/storage.hpp>
+#include <userver/utils/statistics/testing.hpp>
+
+USERVER_NAMESPACE_BEGIN
+
+namespace {
+
+// Decodes a single level of a protobuf message, values of the
+// length-delimited fields are kept as is
+struct ProtoField {
+  std::uint64_t number{};
+  std::string bytes;
+};
+
+std::uint64_t ReadVarint(std::string_view& data) {
+  std::uint64_t result = 0;
+  for (int shift = 0; !data.empty(); shift += 7) {
+    const auto byte = static_cast<unsigned char>(data.front());
+    data.remove_prefix(1);
+    result |= static_cast<std::uint64_t>(byte & 0x7f) << shift;
+    if (!(byte & 0x80)) return result;
+  }
+  throw std::runtime_error("Truncated varint");
+}
+
+std::multimap<std::uint32_t, ProtoField> Decode(std::string_view data) {
+  std::multimap<std::uint32_t, ProtoField> result;
+  while (!data.empty()) {
+    const auto tag = ReadVarint(data);
+    ProtoField field;
+    switch (tag & 7) {
+      case 0:
+        field.number = ReadVarint(data);
+        break;
+      case 1:
+        if (data.size() < 8) throw std::runtime_error("Truncated fixed64");
+        std::memcpy(&field.number, data.data(), 8);
+        data.remove_prefix(8);
+        break;
+      case 2: {
+        const auto size = ReadVarint(data);
+        if (data.size() < size) throw std::runtime_error("Truncated bytes");
+        field.bytes = std::string{data.substr(0, size)};
+        data.remove_prefix(size);
+        break;
+      }
+      default:
+        throw std::runtime_error("Unexpected wire type");
+    }
+    result.emplace(static_cast<std::uint32_t>(tag >> 3), std::move(field));
+  }
+  return result;
+}
+
+const ProtoField& Get(const std::multimap<std::uint32_t, ProtoField>& fields,
+                      std::uint32_t number) {
+  const auto it = fields.find(number);
+  if (it == fields.end()) throw std::runtime_error("Missing field");
+  return it->second;
+}
+
+std::vector<std::multimap<std::uint32_t, ProtoField>> DecodeSpans(
+    std::string_view request) {
+  const auto resource_spans = Decode(Get(Decode(request), 1).bytes);
+  const auto scope_spans = Decode(Get(resource_spans, 2).bytes);
+
+  std::vector<std::multimap<std::uint32_t, ProtoField>> result;
+  const auto [begin, end] = scope_spans.equal_range(2);
+  for (auto it = begin; it != end; ++it) {
+    result.push_back(Decode(it->second.bytes));
+  }
+  return result;
+}
+
+tracing::impl::SpanRecord MakeRecord(std::string name) {
+  tracing::impl::SpanRecord record;
+  record.name = std::move(name);
+  record.trace_id =
+      tracing::impl::TraceId{"0102030405060708090a0b0c0d0e0f10"};
+  record.span_id = tracing::impl::SpanId{"1112131415161718"};
+  record.start_time = std::chrono::system_clock::time_point{
+      std::chrono::seconds{1700000000}};
+  record.duration = std::chrono::milliseconds{5};
+  return record;
+}
+
+class RecordingSender final {
+ public:
+  void operator()(std::string_view body) {
+    const std::lock_guard lock{mutex_};
+    bodies_.emplace_back(body);
+  }
+
+  std::vector<std::string> GetBodies() const {
+    const std::lock_guard lock{mutex_};
+    return bodies_;
+  }
+
+ private:
+  mutable std::mutex mutex_;
+  std::vector<std::string> bodies_;
+};
+
+class RecordingExporter final : public tracing::impl::SpanExporter {
+ public:
+  explicit RecordingExporter(bool log_spans) : log_spans_(log_spans) {}
+
+  void Export(tracing::impl::SpanRecord&& record) noexcept override {
+    const std::lock_guard lock{mutex_};
+    records_.push_back(std::move(record));
+  }
+
+  bool ShouldLogSpans() const noexcept override { return log_spans_; }
+
+  std::vector<tracing::impl::SpanRecord> GetRecords() const {
+    const std::lock_guard lock{mutex_};
+    return records_;
+  }
+
+ private:
+  const bool log_spans_;
+  mutable std::mutex mutex_;
+  std::vector<tracing::impl::SpanRecord> records_;
+};
+
+class SpanExporterScope final {
+ public:
+  explicit SpanExporterScope(
+      std::shared_ptr<tracing::impl::SpanExporter> exporter) {
+    tracing::impl::SetSpanExporter(std::move(exporter));
+  }
+
+  ~SpanExporterScope() { tracing::impl::SetSpanExporter(nullptr); }
+};
+
+std::int64_t GetMetric(const tracing::impl::OtlpSpanExporter& exporter,
+                       std::string metric) {
+  utils::statistics::Storage storage;
+  const auto holder = storage.RegisterWriter(
+      "otlp", [&exporter](utils::statistics::Writer& writer) {
+        writer = exporter;
+      });
+  return utils::statistics::Snapshot{storage, "otlp"}
+      .SingleMetric(metric)
+      .AsInt();
+}
+
+class OtlpSpanExporter : public LoggingTest {};
+
+}  // namespace
+
+TEST(OtlpEncoder, Span) {
+  auto record = MakeRecord("span-name");
+  record.parent_id = tracing::impl::SpanId{"2122232425262728"};
+  record.attributes.emplace_back("str", "value");
+  record.attributes.emplace_back("int", -5);
+  record.attributes.emplace_back("double", 1.5);
+  record.attributes.emplace_back("error", 1);
+
+  std::string request;
+  tracing::impl::otlp::SerializeExportRequest("my-service", {record}, request);
+
+  const auto resource_spans = Decode(Get(Decode(request), 1).bytes);
+  const auto resource = Decode(Get(resource_spans, 1).bytes);
+  const auto service_name = Decode(Get(resource, 1).bytes);
+  EXPECT_EQ(Get(service_name, 1).bytes, "service.name");
+  EXPECT_EQ(Get(Decode(Get(service_name, 2).bytes), 1).bytes, "my-service");
+
+  const auto spans = DecodeSpans(request);
+  ASSERT_EQ(spans.size(), 1);
+  const auto& span = spans[0];
+  EXPECT_EQ(Get(span, 1).bytes,
+            "\x01\x02\x03\x04\x05\x06\x07\x08\x09\x0a\x0b\x0c\x0d\x0e\x0f\x10");
+  EXPECT_EQ(Get(span, 2).bytes, "\x11\x12\x13\x14\x15\x16\x17\x18");
+  EXPECT_EQ(Get(span, 4).bytes, "\x21\x22\x23\x24\x25\x26\x27\x28");
+  EXPECT_EQ(Get(span, 5).bytes, "span-name");
+  EXPECT_EQ(Get(span, 7).number, 1700000000ULL * 1000000000ULL);
+  EXPECT_EQ(Get(span, 8).number, 1700000000ULL * 1000000000ULL + 5000000);
+  EXPECT_EQ(span.count(9), 4);
+  EXPECT_EQ(Get(Decode(Get(span, 15).bytes), 3).number, 2);
+
+  const auto [begin, end] = span.equal_range(9);
+  std::map<std::string, std::multimap<std::uint32_t, ProtoField>> attributes;
+  for (auto it = begin; it != end; ++it) {
+    const auto key_value = Decode(it->second.bytes);
+    attributes.emplace(Get(key_value, 1).bytes,
+                       Decode(Get(key_value, 2).bytes));
+  }
+  EXPECT_EQ(Get(attributes.at("str"), 1).bytes, "value");
+  EXPECT_EQ(static_cast<std::int64_t>(Get(attributes.at("int"), 3).number),
+            -5);
+  double value{};
+  std::memcpy(&value, &Get(attributes.at("double"), 4).number, sizeof(value));
+  EXPECT_EQ(value, 1.5);
+}
+
+TEST(OtlpEncoder, NoParent) {
+  std::string request;
+  tracing::impl::otlp::SerializeExportRequest("service", {MakeRecord("a")},
+                                              request);
+  const auto spans = DecodeSpans(request);
+  ASSERT_EQ(spans.size(), 1);
+  EXPECT_EQ(spans[0].count(4), 0);
+  EXPECT_EQ(spans[0].count(15), 0);
+}
+
+UTEST(OtlpSpanExporter, Batches) {
+  auto sender = std::make_shared<RecordingSender>();
+  tracing::impl::OtlpSpanExporter exporter{
+      {"service", 100, 3, std::chrono::milliseconds{10}, false},
+      [sender](std::string_view body) { (*sender)(body); }};
+  exporter.StartExportTask(engine::current_task::GetTaskProcessor());
+
+  for (int i = 0; i < 10; ++i) exporter.Export(MakeRecord("span"));
+  exporter.StopExportTask();
+
+  std::size_t spans = 0;
+  for (const auto& body : sender->GetBodies()) {
+    const auto batch_size = DecodeSpans(body).size();
+    EXPECT_LE(batch_size, 3);
+    spans += batch_size;
+  }
+  EXPECT_EQ(spans, 10);
+
+  EXPECT_EQ(GetMetric(exporter, "exported"), 10);
+  EXPECT_EQ(GetMetric(exporter, "dropped"), 0);
+}
+
+UTEST(OtlpSpanExporter, DropOnOverflow) {
+  auto sender = std::make_shared<RecordingSender>();
+  tracing::impl::OtlpSpanExporter exporter{
+      {"service", 2, 100, std::chrono::milliseconds{10}, false},
+      [sender](std::string_view body) { (*sender)(body); }};
+
+  for (int i = 0; i < 5; ++i) exporter.Export(MakeRecord("span"));
+
+  exporter.StartExportTask(engine::current_task::GetTaskProcessor());
+  exporter.StopExportTask();
+
+  std::size_t spans = 0;
+  for (const auto& body : sender->GetBodies()) {
+    spans += DecodeSpans(body).size();
+  }
+  EXPECT_EQ(spans, 2);
+
+  EXPECT_EQ(GetMetric(exporter, "dropped"), 3);
+}
+
+UTEST_F(OtlpSpanExporter, SpansAreExportedInsteadOfLogged) {
+  auto exporter = std::make_shared<RecordingExporter>(false);
+  {
+    const SpanExporterScope scope{exporter};
+    tracing::Span span{"exported_span"};
+    span.AddTag("tag", "value");
+  }
+
+  const auto records = exporter->GetRecords();
+  ASSERT_EQ(records.size(), 1);
+  EXPECT_EQ(records[0].name, "exported_span");
+  EXPECT_FALSE(records[0].parent_id.IsEmpty());
+  EXPECT_THAT(records[0].attributes,
+              testing::Contains(logging::LogExtra::Pair{"tag", "value"}));
+  EXPECT_THAT(GetStreamString(), testing::Not(testing::HasSubstr(
+                                     "stopwatch_name=exported_span")));
+}
+
+UTEST_F(OtlpSpanExporter, SpansAreExportedAndLogged) {
+  auto exporter = std::make_shared<RecordingExporter>(true);
+  {
+    const SpanExporterScope scope{exporter};
+    tracing::Span span{"exported_span"};
+    span.SetLogLevel(logging::Level::kTrace);
+    tracing::Span logged_span{"logged_span"};
+  }
+
+  // Spans that are not logged are not exported either
+  const auto records = exporter->GetRecords();
+  ASSERT_EQ(records.size(), 1);
+  EXPECT_EQ(records[0].name, "logged_span");
+
+  logging::LogFlush();
+  EXPECT_THAT(GetStreamString(),
+              testing::HasSubstr("stopwatch_name=logged_span"));
+}
+
+USERVER_NAMESPACE_END
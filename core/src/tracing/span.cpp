@@ -2,6 +2,7 @@
 
 #include <type_traits>
 
+#include <boost/container/small_vector.hpp>
 #include <fmt/compile.h>
 #include <fmt/format.h>
 
@@ -13,7 +14,7 @@
 #include <userver/tracing/span.hpp>
 #include <userver/tracing/tracer.hpp>
 #include <userver/utils/assert.hpp>
-#include <userver/utils/encoding/hex.hpp>
+#include <userver/utils/boost_uuid4.hpp>
 #include <userver/utils/rand.hpp>
 #include <userver/utils/uuid4.hpp>
 
@@ -61,12 +62,19 @@ TsBuffer StartTsToString(std::chrono::system_clock::time_point start) {
 // Maintain coro-local span stack to identify "current span" in O(1).
 engine::TaskLocalVariable<SpanStack> task_local_spans;
 
-std::string GenerateSpanId() {
+impl::SpanId GenerateSpanId() {
   std::uniform_int_distribution<std::uint64_t> dist;
   const auto random_value = utils::WithDefaultRandom(dist);
 
   static_assert(sizeof(random_value) == 8);
-  return utils::encoding::ToHex(&random_value, 8);
+  return impl::SpanId::FromBinary(&random_value);
+}
+
+impl::TraceId GenerateTraceId() {
+  const auto uuid = utils::generators::GenerateBoostUuid();
+
+  static_assert(boost::uuids::uuid::static_size() == 16);
+  return impl::TraceId::FromBinary(uuid.begin());
 }
 
 }  // namespace
@@ -86,8 +94,7 @@ Span::Impl::Impl(TracerPtr tracer, std::string name, const Span::Impl* parent,
       tracer_(std::move(tracer)),
       start_system_time_(std::chrono::system_clock::now()),
       start_steady_time_(std::chrono::steady_clock::now()),
-      trace_id_(parent ? parent->GetTraceId()
-                       : utils::generators::GenerateUuid()),
+      trace_id_(parent ? parent->GetTraceId() : GenerateTraceId()),
       span_id_(GenerateSpanId()),
       parent_id_(GetParentIdForLogging(parent)),
       reference_type_(reference_type),
@@ -103,6 +110,12 @@ Span::Impl::~Impl() {
     return;
   }
 
+  if (const auto exporter = impl::GetSpanExporter()) {
+    const bool should_log = exporter->ShouldLogSpans();
+    exporter->Export(MakeSpanRecord(/*extract=*/!should_log));
+    if (!should_log) return;
+  }
+
   {
     const DetachLocalSpansScope ignore_local_span;
     logging::LogHelper lh{logging::GetDefaultLogger(), log_level_,
@@ -140,6 +153,36 @@ void Span::Impl::PutIntoLogger(logging::impl::TagWriter writer) && {
   LogOpenTracing();
 }
 
+impl::SpanRecord Span::Impl::MakeSpanRecord(bool extract) {
+  impl::SpanRecord record;
+  record.name = name_;
+  record.trace_id = trace_id_;
+  record.span_id = span_id_;
+  record.parent_id = parent_id_;
+  record.reference_type = reference_type_;
+  record.start_time = start_system_time_;
+  record.duration = std::chrono::steady_clock::now() - start_steady_time_;
+
+  const auto append = [&record, extract](logging::LogExtra& log_extra) {
+    for (auto& [key, value] : *log_extra.extra_) {
+      if (extract) {
+        record.attributes.emplace_back(std::move(key),
+                                       std::move(value.GetValue()));
+      } else {
+        record.attributes.emplace_back(key, value.GetValue());
+      }
+    }
+  };
+  record.attributes.reserve(log_extra_inheritable_.extra_->size() +
+                            (log_extra_local_ ? log_extra_local_->extra_->size()
+                                              : 0));
+  append(log_extra_inheritable_);
+  if (log_extra_local_) append(*log_extra_local_);
+  time_storage_.MergeInto(record.attributes);
+
+  return record;
+}
+
 void Span::Impl::LogTo(logging::impl::TagWriter writer) {
   writer.ExtendLogExtra(log_extra_inheritable_);
   tracer_->LogSpanContextTo(*this, writer);
@@ -152,7 +195,7 @@ void Span::Impl::AttachToCoroStack() {
   task_local_spans->push_back(*this);
 }
 
-std::string Span::Impl::GetParentIdForLogging(const Span::Impl* parent) {
+impl::SpanId Span::Impl::GetParentIdForLogging(const Span::Impl* parent) {
   if (!parent) return {};
 
   if (!parent->is_linked()) {
@@ -169,7 +212,7 @@ std::string Span::Impl::GetParentIdForLogging(const Span::Impl* parent) {
   // orphaned. It's still possible for chaining to break in case parent span
   // becomes non-loggable after child span is created, but that we can't control
   for (auto current = spans_ptr->iterator_to(*parent);; --current) {
-    if (current->GetParentId().empty() /* won't find better candidate */ ||
+    if (current->GetParentId().IsEmpty() /* won't find better candidate */ ||
         current->ShouldLog()) {
       return current->GetSpanId();
     }
@@ -179,6 +222,16 @@ std::string Span::Impl::GetParentIdForLogging(const Span::Impl* parent) {
   return {};
 }
 
+const impl::FormattedIds& Span::Impl::GetFormattedIds() const {
+  return formatted_ids_.GetOrCreate([this] {
+    return impl::FormattedIds{
+        trace_id_.ToString(),
+        span_id_.ToString(),
+        parent_id_.ToString(),
+    };
+  });
+}
+
 bool Span::Impl::ShouldLog() const {
   /* We must honour default log level, but use span's level from ourselves,
    * not the previous span's.
@@ -221,7 +274,7 @@ Span::Span(std::string name, ReferenceType reference_type,
                           source_location),
              Span::OptionalDeleter{OptionalDeleter::ShouldDelete()}) {
   AttachToCoroStack();
-  if (pimpl_->GetParentId().empty()) {
+  if (pimpl_->GetParentId().IsEmpty()) {
     SetLink(utils::generators::GenerateUuid());
   }
   pimpl_->span_ = this;
@@ -270,8 +323,8 @@ Span* Span::CurrentSpanUnchecked() {
 Span Span::MakeSpan(std::string name, std::string_view trace_id,
                     std::string_view parent_span_id) {
   Span span(std::move(name));
-  if (!trace_id.empty()) span.pimpl_->SetTraceId(std::string{trace_id});
-  span.pimpl_->SetParentId(std::string{parent_span_id});
+  if (!trace_id.empty()) span.pimpl_->SetTraceId(trace_id);
+  span.pimpl_->SetParentId(parent_span_id);
   return span;
 }
 
@@ -280,8 +333,8 @@ Span Span::MakeSpan(std::string name, std::string_view trace_id,
   Span span(Tracer::GetTracer(), std::move(name), nullptr,
             ReferenceType::kChild);
   span.SetLink(std::move(link));
-  if (!trace_id.empty()) span.pimpl_->SetTraceId(std::string{trace_id});
-  span.pimpl_->SetParentId(std::string{parent_span_id});
+  if (!trace_id.empty()) span.pimpl_->SetTraceId(trace_id);
+  span.pimpl_->SetParentId(parent_span_id);
   return span;
 }
 
@@ -393,11 +446,17 @@ std::chrono::system_clock::time_point Span::GetStartSystemTime() const {
   return pimpl_->start_system_time_;
 }
 
-const std::string& Span::GetTraceId() const { return pimpl_->GetTraceId(); }
+const std::string& Span::GetTraceId() const {
+  return pimpl_->GetFormattedIds().trace_id;
+}
 
-const std::string& Span::GetSpanId() const { return pimpl_->GetSpanId(); }
+const std::string& Span::GetSpanId() const {
+  return pimpl_->GetFormattedIds().span_id;
+}
 
-const std::string& Span::GetParentId() const { return pimpl_->GetParentId(); }
+const std::string& Span::GetParentId() const {
+  return pimpl_->GetFormattedIds().parent_id;
+}
 
 ScopeTime::Duration Span::GetTotalDuration(
     const std::string& scope_name) const {
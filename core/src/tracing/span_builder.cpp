@@ -16,25 +16,25 @@ SpanBuilder::SpanBuilder(std::string name,
                           logging::Level::kInfo, location),
              Span::OptionalDeleter{Span::OptionalDeleter::ShouldDelete()}) {
   pimpl_->AttachToCoroStack();
-  if (pimpl_->GetParentId().empty()) {
+  if (pimpl_->GetParentId().IsEmpty()) {
     AddTagFrozen(kLinkTag, utils::generators::GenerateUuid());
   }
 }
 
 void SpanBuilder::SetSpanId(std::string parent_span_id) {
-  pimpl_->SetSpanId(std::move(parent_span_id));
+  pimpl_->SetSpanId(parent_span_id);
 }
 
 void SpanBuilder::SetParentSpanId(std::string parent_span_id) {
-  pimpl_->SetParentId(std::move(parent_span_id));
+  pimpl_->SetParentId(parent_span_id);
 }
 
 void SpanBuilder::SetTraceId(std::string trace_id) {
-  pimpl_->SetTraceId(std::move(trace_id));
+  pimpl_->SetTraceId(trace_id);
 }
 
 const std::string& SpanBuilder::GetTraceId() const noexcept {
-  return pimpl_->GetTraceId();
+  return pimpl_->GetFormattedIds().trace_id;
 }
 
 void SpanBuilder::AddTagFrozen(std::string key,
@@ -0,0 +1,38 @@
+#include <tracing/span_exporter.hpp>
+
+#include <atomic>
+
+#include <userver/rcu/rcu.hpp>
+
+USERVER_NAMESPACE_BEGIN
+
+namespace tracing::impl {
+
+namespace {
+
+auto& GlobalSpanExporter() {
+  static rcu::Variable<std::shared_ptr<SpanExporter>> exporter{};
+  return exporter;
+}
+
+// Avoids the RCU read for every span in the common case without exporter
+std::atomic<bool> has_span_exporter{false};
+
+}  // namespace
+
+SpanExporter::~SpanExporter() = default;
+
+void SetSpanExporter(std::shared_ptr<SpanExporter> exporter) {
+  const bool has_exporter = static_cast<bool>(exporter);
+  GlobalSpanExporter().Assign(std::move(exporter));
+  has_span_exporter.store(has_exporter);
+}
+
+std::shared_ptr<SpanExporter> GetSpanExporter() {
+  if (!has_span_exporter.load(std::memory_order_relaxed)) return {};
+  return GlobalSpanExporter().ReadCopy();
+}
+
+}  // namespace tracing::impl
+
+USERVER_NAMESPACE_END
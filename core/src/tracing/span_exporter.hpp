@@ -0,0 +1,48 @@
+#pragma once
+
+#include <chrono>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include <userver/logging/log_extra.hpp>
+#include <userver/tracing/span.hpp>
+
+#include <tracing/hex_id.hpp>
+
+USERVER_NAMESPACE_BEGIN
+
+namespace tracing::impl {
+
+/// Finished span in a binary form, cheap to produce on the request path
+struct SpanRecord final {
+  std::string name;
+  TraceId trace_id;
+  SpanId span_id;
+  SpanId parent_id;
+  ReferenceType reference_type{ReferenceType::kChild};
+  std::chrono::system_clock::time_point start_time;
+  std::chrono::nanoseconds duration{};
+  std::vector<logging::LogExtra::Pair> attributes;
+};
+
+/// Receives the finished spans that pass the log level checks
+class SpanExporter {
+ public:
+  virtual ~SpanExporter();
+
+  /// Called from the span destructor in any thread, must not block
+  virtual void Export(SpanRecord&& record) noexcept = 0;
+
+  /// Whether the spans should also be written into the default logger
+  virtual bool ShouldLogSpans() const noexcept = 0;
+};
+
+/// Sets the global exporter, nullptr disables the export
+void SetSpanExporter(std::shared_ptr<SpanExporter> exporter);
+
+std::shared_ptr<SpanExporter> GetSpanExporter();
+
+}  // namespace tracing::impl
+
+USERVER_NAMESPACE_END
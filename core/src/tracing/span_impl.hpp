@@ -1,7 +1,9 @@
 #pragma once
 
+#include <atomic>
 #include <chrono>
 #include <list>
+#include <memory>
 #include <optional>
 #include <string>
 #include <string_view>
@@ -18,6 +20,8 @@
 #include <userver/tracing/tracer.hpp>
 #include <userver/utils/impl/source_location.hpp>
 
+#include <tracing/hex_id.hpp>
+#include <tracing/span_exporter.hpp>
 #include <tracing/time_storage.hpp>
 
 USERVER_NAMESPACE_BEGIN
@@ -27,6 +31,45 @@ namespace tracing {
 inline const std::string kLinkTag = "link";
 inline const std::string kParentLinkTag = "parent_link";
 
+namespace impl {
+
+struct FormattedIds final {
+  std::string trace_id;
+  std::string span_id;
+  std::string parent_id;
+};
+
+// Hex ids for the public tracing::Span API, formatted on the first request.
+// Most of the spans are only logged, so they never need it.
+class FormattedIdsCache final {
+ public:
+  FormattedIdsCache() = default;
+  FormattedIdsCache(FormattedIdsCache&& other) noexcept
+      : ids_(other.ids_.exchange(nullptr)) {}
+  FormattedIdsCache& operator=(FormattedIdsCache&&) = delete;
+  ~FormattedIdsCache() { Reset(); }
+
+  template <typename Factory>
+  const FormattedIds& GetOrCreate(Factory&& factory) const {
+    auto* ids = ids_.load(std::memory_order_acquire);
+    if (ids) return *ids;
+
+    auto new_ids = std::make_unique<FormattedIds>(factory());
+    if (ids_.compare_exchange_strong(ids, new_ids.get(),
+                                     std::memory_order_acq_rel)) {
+      return *new_ids.release();
+    }
+    return *ids;
+  }
+
+  void Reset() noexcept { delete ids_.exchange(nullptr); }
+
+ private:
+  mutable std::atomic<FormattedIds*> ids_{nullptr};
+};
+
+}  // namespace impl
+
 class Span::Impl
     : public boost::intrusive::list_base_hook<
           boost::intrusive::link_mode<boost::intrusive::auto_unlink>> {
@@ -54,17 +97,26 @@ class Span::Impl
   // Add the context of this Span a non-Span-specific log record
   void LogTo(logging::impl::TagWriter writer);
 
-  const std::string& GetTraceId() const& noexcept { return trace_id_; }
-  const std::string& GetSpanId() const& noexcept { return span_id_; }
-  const std::string& GetParentId() const& noexcept { return parent_id_; }
-
-  std::string GetTraceId() && noexcept { return std::move(trace_id_); }
-  std::string GetSpanId() && noexcept { return std::move(span_id_); }
-  std::string GetParentId() && noexcept { return std::move(parent_id_); }
-
-  void SetTraceId(std::string&& id) noexcept { trace_id_ = std::move(id); }
-  void SetSpanId(std::string&& id) noexcept { span_id_ = std::move(id); }
-  void SetParentId(std::string&& id) noexcept { parent_id_ = std::move(id); }
+  const impl::TraceId& GetTraceId() const noexcept { return trace_id_; }
+  const impl::SpanId& GetSpanId() const noexcept { return span_id_; }
+  const impl::SpanId& GetParentId() const noexcept { return parent_id_; }
+
+  void SetTraceId(std::string_view id) {
+    trace_id_ = impl::TraceId{id};
+    formatted_ids_.Reset();
+  }
+  void SetSpanId(std::string_view id) {
+    span_id_ = impl::SpanId{id};
+    formatted_ids_.Reset();
+  }
+  void SetParentId(std::string_view id) {
+    parent_id_ = impl::SpanId{id};
+    formatted_ids_.Reset();
+  }
+
+  // For the public API only, loggers and tracers should use ToHex() of the
+  // ids to avoid allocations
+  const impl::FormattedIds& GetFormattedIds() const;
 
   ReferenceType GetReferenceType() const noexcept { return reference_type_; }
 
@@ -72,12 +124,15 @@ class Span::Impl
   void AttachToCoroStack();
 
  private:
+  // Moves the tags out of the span if `extract` is set
+  impl::SpanRecord MakeSpanRecord(bool extract);
+
   void LogOpenTracing() const;
   void DoLogOpenTracing(logging::impl::TagWriter writer) const;
   static void AddOpentracingTags(formats::json::StringBuilder& output,
                                  const logging::LogExtra& input);
 
-  static std::string GetParentIdForLogging(const Span::Impl* parent);
+  static impl::SpanId GetParentIdForLogging(const Span::Impl* parent);
   bool ShouldLog() const;
 
   const std::string name_;
@@ -96,9 +151,10 @@ class Span::Impl
   const std::chrono::system_clock::time_point start_system_time_;
   const std::chrono::steady_clock::time_point start_steady_time_;
 
-  std::string trace_id_;
-  std::string span_id_;
-  std::string parent_id_;
+  impl::TraceId trace_id_;
+  impl::SpanId span_id_;
+  impl::SpanId parent_id_;
+  impl::FormattedIdsCache formatted_ids_;
   const ReferenceType reference_type_;
   utils::impl::SourceLocation source_location_;
 
@@ -104,9 +104,12 @@ void Span::Impl::DoLogOpenTracing(logging::impl::TagWriter writer) const {
   if (tracer_) {
     writer.PutTag(jaeger::kServiceName, tracer_->GetServiceName());
   }
-  writer.PutTag(jaeger::kTraceId, trace_id_);
-  writer.PutTag(jaeger::kParentId, parent_id_);
-  writer.PutTag(jaeger::kSpanId, span_id_);
+  const auto trace_id = trace_id_.ToHex();
+  const auto parent_id = parent_id_.ToHex();
+  const auto span_id = span_id_.ToHex();
+  writer.PutTag(jaeger::kTraceId, trace_id.ToStringView());
+  writer.PutTag(jaeger::kParentId, parent_id.ToStringView());
+  writer.PutTag(jaeger::kSpanId, span_id.ToStringView());
   writer.PutTag(jaeger::kStartTime, start_time);
   writer.PutTag(jaeger::kStartTimeMillis, start_time / 1000);
   writer.PutTag(jaeger::kDuration, duration_microseconds);
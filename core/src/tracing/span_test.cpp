@@ -9,6 +9,7 @@
 #include <userver/tracing/span.hpp>
 #include <userver/tracing/tracer.hpp>
 #include <userver/utest/utest.hpp>
+#include <userver/utils/encoding/hex.hpp>
 #include <userver/utils/regex.hpp>
 #include <userver/utils/text_light.hpp>
 
@@ -714,4 +715,45 @@ UTEST_F(Span, MakeSpanWithParentIdTraceIdLinkWithExisting) {
   }
 }
 
+UTEST_F(Span, NativeIds) {
+  const std::string trace_id = "0123456789abcdef0123456789abcdef";
+  const std::string parent_id = "fedcba9876543210";
+
+  {
+    auto span = tracing::Span::MakeSpan("span", trace_id, parent_id);
+    EXPECT_EQ(span.GetTraceId(), trace_id);
+    EXPECT_EQ(span.GetParentId(), parent_id);
+    EXPECT_EQ(span.GetSpanId().size(), 16);
+    EXPECT_TRUE(utils::encoding::IsHexData(span.GetSpanId()));
+
+    auto child = span.CreateChild("child");
+    EXPECT_EQ(child.GetTraceId(), trace_id);
+    EXPECT_EQ(child.GetParentId(), span.GetSpanId());
+    EXPECT_NE(child.GetSpanId(), span.GetSpanId());
+
+    LOG_INFO() << "message";
+  }
+
+  logging::LogFlush();
+  EXPECT_THAT(GetStreamString(),
+              HasSubstr(fmt::format("trace_id={}", trace_id)));
+  EXPECT_THAT(GetStreamString(),
+              HasSubstr(fmt::format("parent_id={}", parent_id)));
+}
+
+UTEST_F(Span, GeneratedIds) {
+  tracing::Span span{"span"};
+  EXPECT_EQ(span.GetTraceId().size(), 32);
+  EXPECT_TRUE(utils::encoding::IsHexData(span.GetTraceId()));
+  EXPECT_EQ(span.GetSpanId().size(), 16);
+  EXPECT_TRUE(utils::encoding::IsHexData(span.GetSpanId()));
+
+  LOG_INFO() << "message";
+  logging::LogFlush();
+  EXPECT_THAT(GetStreamString(),
+              HasSubstr(fmt::format("trace_id={}", span.GetTraceId())));
+  EXPECT_THAT(GetStreamString(),
+              HasSubstr(fmt::format("span_id={}", span.GetSpanId())));
+}
+
 USERVER_NAMESPACE_END
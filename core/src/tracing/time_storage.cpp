@@ -52,6 +52,15 @@ void TimeStorage::MergeInto(logging::impl::TagWriter writer) {
   }
 }
 
+void TimeStorage::MergeInto(
+    std::vector<logging::LogExtra::Pair>& output) const {
+  for (const auto& [key, value] : data_) {
+    output.emplace_back(
+        fmt::format(FMT_COMPILE("{}{}"), key, kTimerSuffix),
+        static_cast<double>(value.count()) / kNsInMs);
+  }
+}
+
 }  // namespace tracing::impl
 
 USERVER_NAMESPACE_END
@@ -3,6 +3,7 @@
 #include <chrono>
 #include <string>
 #include <unordered_map>
+#include <vector>
 
 #include <userver/logging/log_extra.hpp>
 
@@ -32,6 +33,9 @@ class TimeStorage {
 
   void MergeInto(logging::impl::TagWriter writer);
 
+  /// Appends the accumulated times in milliseconds
+  void MergeInto(std::vector<logging::LogExtra::Pair>& output) const;
+
  private:
   std::unordered_map<std::string, Duration> data_;
 };
@@ -30,9 +30,12 @@ class NoopTracer final : public Tracer {
 
 void NoopTracer::LogSpanContextTo(const Span::Impl& span,
                                   logging::impl::TagWriter writer) const {
-  writer.PutTag(kTraceIdName, span.GetTraceId());
-  writer.PutTag(kSpanIdName, span.GetSpanId());
-  writer.PutTag(kParentIdName, span.GetParentId());
+  const auto trace_id = span.GetTraceId().ToHex();
+  const auto span_id = span.GetSpanId().ToHex();
+  const auto parent_id = span.GetParentId().ToHex();
+  writer.PutTag(kTraceIdName, trace_id.ToStringView());
+  writer.PutTag(kSpanIdName, span_id.ToStringView());
+  writer.PutTag(kParentIdName, parent_id.ToStringView());
 }
 
 auto& GlobalNoLogSpans() {
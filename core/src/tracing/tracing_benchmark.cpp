@@ -33,6 +33,44 @@ void tracing_happy_log(benchmark::State& state) {
 }
 BENCHMARK(tracing_happy_log);
 
+void tracing_child_ctr(benchmark::State& state) {
+  engine::RunStandalone([&] {
+    tracing::Span root_span{"root"};
+
+    for ([[maybe_unused]] auto _ : state) {
+      tracing::Span child_span{"child"};
+      benchmark::DoNotOptimize(child_span);
+    }
+  });
+}
+BENCHMARK(tracing_child_ctr);
+
+void tracing_make_span_with_ids(benchmark::State& state) {
+  constexpr std::string_view kTraceId = "0123456789abcdef0123456789abcdef";
+  constexpr std::string_view kParentId = "0123456789abcdef";
+
+  engine::RunStandalone([&] {
+    for ([[maybe_unused]] auto _ : state) {
+      benchmark::DoNotOptimize(
+          tracing::Span::MakeSpan("name", kTraceId, kParentId));
+    }
+  });
+}
+BENCHMARK(tracing_make_span_with_ids);
+
+void tracing_child_ctr_propagate(benchmark::State& state) {
+  engine::RunStandalone([&] {
+    tracing::Span root_span{"root"};
+
+    for ([[maybe_unused]] auto _ : state) {
+      tracing::Span child_span{"child"};
+      benchmark::DoNotOptimize(child_span.GetTraceId());
+      benchmark::DoNotOptimize(child_span.GetSpanId());
+    }
+  });
+}
+BENCHMARK(tracing_child_ctr_propagate);
+
 tracing::Span GetSpanWithOpentracingHttpTags(tracing::TracerPtr tracer) {
   auto span = tracer->CreateSpanWithoutParent("name");
   span.AddTag("meta_code", 200);
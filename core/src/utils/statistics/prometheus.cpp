@@ -2,16 +2,21 @@
 
 #include <algorithm>
 #include <iterator>
-#include <unordered_map>
+#include <optional>
+#include <string>
+#include <vector>
 
 #include <fmt/compile.h>
 #include <fmt/format.h>
 
+#include <userver/utils/assert.hpp>
 #include <userver/utils/impl/transparent_hash.hpp>
 #include <userver/utils/overloaded.hpp>
 #include <userver/utils/statistics/fmt.hpp>
 #include <userver/utils/statistics/storage.hpp>
 
+#include <utils/statistics/scrape_cache_impl.hpp>
+
 USERVER_NAMESPACE_BEGIN
 
 namespace utils::statistics {
@@ -23,9 +28,10 @@ namespace {
 enum class Typed { kYes, kNo };
 
 template <Typed IsTyped>
-class FormatBuilder final : public utils::statistics::BaseFormatBuilder {
+class FormatBuilder final : public BaseCachingFormatBuilder {
  public:
-  explicit FormatBuilder() = default;
+  explicit FormatBuilder(ScrapeCache::Impl& cache)
+      : cache_(cache), buf_(cache.output) {}
 
   void HandleMetric(std::string_view path, utils::statistics::LabelsSpan labels,
                     const MetricValue& value) override {
@@ -39,6 +45,46 @@ class FormatBuilder final : public utils::statistics::BaseFormatBuilder {
     fmt::format_to(std::back_inserter(buf_), FMT_COMPILE(" {}\n"), value);
   }
 
+  void BeginChunk() override {
+    UASSERT(!chunk_begin_);
+    chunk_begin_ = buf_.size();
+    chunk_ = ++cache_.chunk_counter;
+    declared_names_.clear();
+    used_names_.clear();
+  }
+
+  void EndChunk(SerializedChunk& chunk) override {
+    UASSERT(chunk_begin_);
+    chunk.data.assign(buf_.data() + *chunk_begin_, buf_.size() - *chunk_begin_);
+    chunk.declared_names.swap(declared_names_);
+    chunk.used_names.swap(used_names_);
+    chunk_begin_.reset();
+  }
+
+  bool AppendChunk(const SerializedChunk& chunk) override {
+    const auto generation = cache_.generation;
+    for (const auto& name : chunk.declared_names) {
+      const auto* const info =
+          utils::impl::FindTransparentOrNullptr(cache_.metric_names, name);
+      if (info && info->declared_generation == generation) {
+        return false;
+      }
+    }
+    for (const auto& name : chunk.used_names) {
+      const auto* const info =
+          utils::impl::FindTransparentOrNullptr(cache_.metric_names, name);
+      if (!info || info->declared_generation != generation) {
+        return false;
+      }
+    }
+
+    for (const auto& name : chunk.declared_names) {
+      GetMetricName(name).declared_generation = generation;
+    }
+    buf_.append(chunk.data);
+    return true;
+  }
+
   std::string Release() { return fmt::to_string(buf_); }
 
  private:
@@ -87,17 +133,33 @@ class FormatBuilder final : public utils::statistics::BaseFormatBuilder {
                           fmt::to_string(histogram.GetTotalCount()), labels);
   }
 
+  ScrapeCache::Impl::MetricName& GetMetricName(std::string_view name) {
+    if (auto* const info =
+            utils::impl::FindTransparentOrNullptr(cache_.metric_names, name)) {
+      return *info;
+    }
+    return cache_.metric_names
+        .emplace(name, ScrapeCache::Impl::MetricName{
+                           impl::ToPrometheusName(name), 0, 0})
+        .first->second;
+  }
+
   void DumpMetricNameAndType(std::string_view name, const MetricValue& value) {
-    if (const auto* const converted =
-            utils::impl::FindTransparentOrNullptr(metrics_, name)) {
-      buf_.append(*converted);
-      return;
+    auto& info = GetMetricName(name);
+
+    if (info.declared_generation != cache_.generation) {
+      info.declared_generation = cache_.generation;
+      DumpMetricType(info.converted, value);
+      if (chunk_begin_) {
+        info.seen_chunk = chunk_;
+        declared_names_.emplace_back(name);
+      }
+    } else if (chunk_begin_ && info.seen_chunk != chunk_) {
+      info.seen_chunk = chunk_;
+      used_names_.emplace_back(name);
     }
 
-    auto prometheus_name = impl::ToPrometheusName(name);
-    DumpMetricType(prometheus_name, value);
-    buf_.append(prometheus_name);
-    metrics_.emplace(name, std::move(prometheus_name));
+    buf_.append(info.converted);
   }
 
   void DumpMetricType([[maybe_unused]] std::string_view prometheus_name,
@@ -144,10 +206,32 @@ class FormatBuilder final : public utils::statistics::BaseFormatBuilder {
     buf_.push_back('}');
   }
 
-  fmt::memory_buffer buf_;
-  utils::impl::TransparentMap<std::string, std::string> metrics_;
+  ScrapeCache::Impl& cache_;
+  fmt::memory_buffer& buf_;
+
+  std::optional<std::size_t> chunk_begin_;
+  std::uint64_t chunk_{0};
+  std::vector<std::string> declared_names_;
+  std::vector<std::string> used_names_;
 };
 
+template <Typed IsTyped>
+std::string Format(const utils::statistics::Storage& statistics,
+                   ScrapeCache& cache,
+                   const utils::statistics::Request& request, bool cached) {
+  auto& cache_impl = cache.GetImpl();
+  cache_impl.StartScrape(IsTyped == Typed::kYes ? "prometheus"
+                                                : "prometheus-untyped");
+
+  FormatBuilder<IsTyped> builder{cache_impl};
+  if (cached) {
+    statistics.VisitMetricsCached(builder, cache, request);
+  } else {
+    statistics.VisitMetrics(builder, request);
+  }
+  return builder.Release();
+}
+
 }  // namespace
 
 std::string ToPrometheusName(std::string_view data) {
@@ -184,17 +268,31 @@ std::string ToPrometheusLabel(std::string_view name) {
 
 std::string ToPrometheusFormat(const utils::statistics::Storage& statistics,
                                const utils::statistics::Request& request) {
-  impl::FormatBuilder<impl::Typed::kYes> builder{};
-  statistics.VisitMetrics(builder, request);
-  return builder.Release();
+  ScrapeCache cache;
+  return impl::Format<impl::Typed::kYes>(statistics, cache, request,
+                                         /*cached=*/false);
+}
+
+std::string ToPrometheusFormat(const utils::statistics::Storage& statistics,
+                               ScrapeCache& cache,
+                               const utils::statistics::Request& request) {
+  return impl::Format<impl::Typed::kYes>(statistics, cache, request,
+                                         /*cached=*/true);
 }
 
 std::string ToPrometheusFormatUntyped(
     const utils::statistics::Storage& statistics,
     const utils::statistics::Request& request) {
-  impl::FormatBuilder<impl::Typed::kNo> builder{};
-  statistics.VisitMetrics(builder, request);
-  return builder.Release();
+  ScrapeCache cache;
+  return impl::Format<impl::Typed::kNo>(statistics, cache, request,
+                                        /*cached=*/false);
+}
+
+std::string ToPrometheusFormatUntyped(
+    const utils::statistics::Storage& statistics, ScrapeCache& cache,
+    const utils::statistics::Request& request) {
+  return impl::Format<impl::Typed::kNo>(statistics, cache, request,
+                                        /*cached=*/true);
 }
 
 }  // namespace utils::statistics
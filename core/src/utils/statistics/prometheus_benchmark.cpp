@@ -0,0 +1,112 @@
+#include <userver/utils/statistics/prometheus.hpp>
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+#include <benchmark/benchmark.h>
+
+#include <userver/engine/run_standalone.hpp>
+#include <userver/utils/statistics/scrape_cache.hpp>
+#include <userver/utils/statistics/solomon.hpp>
+#include <userver/utils/statistics/storage.hpp>
+
+USERVER_NAMESPACE_BEGIN
+
+namespace {
+
+constexpr std::size_t kWriters = 1000;
+constexpr std::size_t kSeriesPerWriter = 100;  // 100k series in total
+
+// Mimics the handler and destination statistics: a lot of writers that write
+// the same set of labelled metrics
+class MetricsFixture final {
+ public:
+  MetricsFixture() : values_(kWriters) {
+    entries_.reserve(kWriters);
+    for (std::size_t i = 0; i < kWriters; ++i) {
+      entries_.push_back(storage_.RegisterWriter(
+          "handler",
+          [this, i](utils::statistics::Writer& writer) {
+            for (std::size_t j = 0; j < kSeriesPerWriter; ++j) {
+              writer["metric-" + std::to_string(j % 10)].ValueWithLabels(
+                  values_[i] + j,
+                  {{"http_handler", "handler-" + std::to_string(i)},
+                   {"kind", std::to_string(j / 10)}});
+            }
+          },
+          {{"version", "1"}}));
+    }
+  }
+
+  // Changes the metrics of `percent` of the writers
+  void Update(std::int64_t percent) {
+    const auto changed = kWriters * percent / 100;
+    for (std::size_t i = 0; i < changed; ++i) {
+      ++values_[(offset_ + i) % kWriters];
+    }
+    offset_ += changed;
+  }
+
+  const utils::statistics::Storage& GetStorage() const { return storage_; }
+
+ private:
+  std::vector<std::uint64_t> values_;
+  std::size_t offset_{0};
+  utils::statistics::Storage storage_;
+  std::vector<utils::statistics::Entry> entries_;
+};
+
+}  // namespace
+
+void StatisticsPrometheusScrape(benchmark::State& state) {
+  engine::RunStandalone([&] {
+    MetricsFixture fixture;
+    for ([[maybe_unused]] auto _ : state) {
+      fixture.Update(state.range(0));
+      benchmark::DoNotOptimize(
+          utils::statistics::ToPrometheusFormat(fixture.GetStorage()));
+    }
+  });
+}
+BENCHMARK(StatisticsPrometheusScrape)->Arg(0)->Arg(100);
+
+void StatisticsPrometheusScrapeCached(benchmark::State& state) {
+  engine::RunStandalone([&] {
+    MetricsFixture fixture;
+    utils::statistics::ScrapeCache cache;
+    for ([[maybe_unused]] auto _ : state) {
+      fixture.Update(state.range(0));
+      benchmark::DoNotOptimize(
+          utils::statistics::ToPrometheusFormat(fixture.GetStorage(), cache));
+    }
+  });
+}
+BENCHMARK(StatisticsPrometheusScrapeCached)->Arg(0)->Arg(10)->Arg(100);
+
+void StatisticsSolomonScrape(benchmark::State& state) {
+  engine::RunStandalone([&] {
+    MetricsFixture fixture;
+    for ([[maybe_unused]] auto _ : state) {
+      fixture.Update(state.range(0));
+      benchmark::DoNotOptimize(
+          utils::statistics::ToSolomonFormat(fixture.GetStorage(), {}));
+    }
+  });
+}
+BENCHMARK(StatisticsSolomonScrape)->Arg(0)->Arg(100);
+
+void StatisticsSolomonScrapeCached(benchmark::State& state) {
+  engine::RunStandalone([&] {
+    MetricsFixture fixture;
+    utils::statistics::ScrapeCache cache;
+    for ([[maybe_unused]] auto _ : state) {
+      fixture.Update(state.range(0));
+      benchmark::DoNotOptimize(
+          utils::statistics::ToSolomonFormat(fixture.GetStorage(), {}, cache));
+    }
+  });
+}
+BENCHMARK(StatisticsSolomonScrapeCached)->Arg(0)->Arg(10)->Arg(100);
+
+USERVER_NAMESPACE_END
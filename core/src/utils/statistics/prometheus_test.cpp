@@ -1,6 +1,7 @@
 #include <userver/utest/utest.hpp>
 
 #include <userver/formats/json/serialize.hpp>
+#include <userver/utils/statistics/histogram.hpp>
 #include <userver/utils/statistics/metadata.hpp>
 #include <userver/utils/statistics/storage.hpp>
 #include <userver/utils/text.hpp>
@@ -409,6 +410,52 @@ child{application="processing"} 8
   }
 }
 
+UTEST(MetricsPrometheus, ScrapeCache) {
+  utils::statistics::Storage storage;
+  std::uint64_t changing_value = 0;
+  utils::statistics::Histogram histogram{std::vector<double>{1.0, 10.0}};
+
+  auto holder1 = storage.RegisterWriter("a", [&](Writer& writer) {
+    writer["gauge"] = 1;
+    writer["rate"] = Rate{5};
+    writer["histogram"] = histogram;
+  });
+  auto holder2 = storage.RegisterWriter(
+      "b", [&](Writer& writer) { writer["value"] = changing_value; },
+      {{"label", "value"}});
+  // Same metric names as in the first writer
+  auto holder3 = storage.RegisterWriter("a", [&](Writer& writer) {
+    writer["gauge"].ValueWithLabels(2, {"x", "y"});
+    writer["rate"].ValueWithLabels(Rate{changing_value}, {"x", "y"});
+  });
+
+  utils::statistics::ScrapeCache cache;
+  utils::statistics::ScrapeCache untyped_cache;
+  const auto check = [&] {
+    EXPECT_EQ(ToPrometheusFormat(storage, cache), ToPrometheusFormat(storage));
+    EXPECT_EQ(ToPrometheusFormatUntyped(storage, untyped_cache),
+              ToPrometheusFormatUntyped(storage));
+  };
+
+  for (int i = 0; i < 3; ++i) {
+    check();
+    check();
+    ++changing_value;
+    histogram.Account(i * 5);
+  }
+
+  // Now the metrics of the third writer are the first ones with their names
+  holder1.Unregister();
+  check();
+  check();
+
+  // Request filters apply before the metrics are cached
+  const auto request = utils::statistics::Request::MakeWithPrefix("b");
+  EXPECT_EQ(ToPrometheusFormat(storage, cache, request),
+            ToPrometheusFormat(storage, request));
+  check();
+}
+
 }  // namespace utils::statistics::impl
 
 USERVER_NAMESPACE_END
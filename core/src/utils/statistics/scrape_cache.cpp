@@ -0,0 +1,106 @@
+#include <utils/statistics/scrape_cache_impl.hpp>
+
+#include <limits>
+
+#include <boost/container/small_vector.hpp>
+
+#include <userver/utils/algo.hpp>
+#include <userver/utils/assert.hpp>
+
+USERVER_NAMESPACE_BEGIN
+
+namespace utils::statistics {
+
+namespace impl {
+
+void MetricsRecorder::HandleMetric(std::string_view path, LabelsSpan labels,
+                                   const MetricValue& value) {
+  Record record;
+  record.path = AppendText(path);
+
+  record.labels_begin = static_cast<std::uint32_t>(labels_.size());
+  for (const auto& label : labels) {
+    const auto name = AppendText(label.Name());
+    labels_.emplace_back(name, AppendText(label.Value()));
+  }
+  record.labels_end = static_cast<std::uint32_t>(labels_.size());
+
+  if (value.IsHistogram()) {
+    // The view may point to a temporary of the writer
+    const auto& histogram = histograms_.emplace_back(value.AsHistogram());
+    record.value = MetricValue{histogram.GetView()};
+  } else {
+    record.value = value;
+  }
+
+  records_.push_back(record);
+}
+
+void MetricsRecorder::Replay(BaseFormatBuilder& out) const {
+  boost::container::small_vector<LabelView, 16> labels;
+  for (const auto& record : records_) {
+    labels.clear();
+    for (auto i = record.labels_begin; i < record.labels_end; ++i) {
+      labels.emplace_back(GetText(labels_[i].first),
+                          GetText(labels_[i].second));
+    }
+    out.HandleMetric(GetText(record.path), LabelsSpan{labels}, record.value);
+  }
+}
+
+void MetricsRecorder::Clear() noexcept {
+  text_.clear();
+  labels_.clear();
+  records_.clear();
+  histograms_.clear();
+}
+
+bool MetricsRecorder::operator==(const MetricsRecorder& other) const noexcept {
+  return text_ == other.text_ && labels_ == other.labels_ &&
+         records_ == other.records_;
+}
+
+MetricsRecorder::TextRange MetricsRecorder::AppendText(std::string_view text) {
+  UINVARIANT(text_.size() + text.size() <=
+                 std::numeric_limits<std::uint32_t>::max(),
+             "Too much metrics data written by a single writer");
+  const TextRange range{static_cast<std::uint32_t>(text_.size()),
+                        static_cast<std::uint32_t>(text.size())};
+  text_.append(text);
+  return range;
+}
+
+std::string_view MetricsRecorder::GetText(TextRange range) const noexcept {
+  return std::string_view{text_}.substr(range.offset, range.size);
+}
+
+}  // namespace impl
+
+void ScrapeCache::Impl::StartScrape(std::string_view new_format) {
+  if (format != new_format) {
+    sources.clear();
+    metric_names.clear();
+    format = new_format;
+  }
+
+  ++generation;
+  output.clear();
+}
+
+void ScrapeCache::Impl::DropStaleSources() {
+  utils::EraseIf(sources, [this](const auto& source) {
+    return source.second.generation != generation;
+  });
+}
+
+ScrapeCache::ScrapeCache() : impl_(std::make_unique<Impl>()) {}
+
+ScrapeCache::ScrapeCache(ScrapeCache&&) noexcept = default;
+
+ScrapeCache& ScrapeCache::operator=(ScrapeCache&&) noexcept = default;
+
+ScrapeCache::~ScrapeCache() = default;
+
+}  // namespace utils::statistics
+
+USERVER_NAMESPACE_END
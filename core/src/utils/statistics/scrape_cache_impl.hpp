@@ -0,0 +1,133 @@
+#pragma once
+
+#include <cstdint>
+#include <deque>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+#include <fmt/format.h>
+
+#include <userver/utils/impl/transparent_hash.hpp>
+#include <userver/utils/statistics/histogram.hpp>
+#include <userver/utils/statistics/scrape_cache.hpp>
+#include <userver/utils/statistics/storage.hpp>
+
+USERVER_NAMESPACE_BEGIN
+
+namespace utils::statistics {
+
+namespace impl {
+
+/// Serialized metrics of a single writer
+struct SerializedChunk final {
+  std::string data;
+
+  /// Metric names that were first seen in the output within this chunk
+  std::vector<std::string> declared_names;
+
+  /// Metric names of this chunk that were seen in the output before it
+  std::vector<std::string> used_names;
+};
+
+/// Format builder that is able to reuse the serialized metrics of the
+/// previous scrapes
+class BaseCachingFormatBuilder : public BaseFormatBuilder {
+ public:
+  /// Starts serialization of the metrics of a single writer
+  virtual void BeginChunk() = 0;
+
+  /// Stores the data written since BeginChunk() into `chunk`
+  virtual void EndChunk(SerializedChunk& chunk) = 0;
+
+  /// @brief Appends the chunk serialized by one of the previous scrapes.
+  /// @returns false if the chunk does not fit the current output, e.g. if it
+  /// declares a metric that was already declared; nothing is written then
+  virtual bool AppendChunk(const SerializedChunk& chunk) = 0;
+};
+
+/// Copy of the metrics written by a single writer, used to detect whether
+/// the metrics changed between scrapes
+class MetricsRecorder final : public BaseFormatBuilder {
+ public:
+  void HandleMetric(std::string_view path, LabelsSpan labels,
+                    const MetricValue& value) override;
+
+  /// Writes the recorded metrics into `out`
+  void Replay(BaseFormatBuilder& out) const;
+
+  void Clear() noexcept;
+
+  bool operator==(const MetricsRecorder& other) const noexcept;
+
+ private:
+  struct TextRange final {
+    std::uint32_t offset{0};
+    std::uint32_t size{0};
+
+    bool operator==(const TextRange& other) const noexcept {
+      return offset == other.offset && size == other.size;
+    }
+  };
+
+  struct Record final {
+    TextRange path;
+    std::uint32_t labels_begin{0};
+    std::uint32_t labels_end{0};
+    MetricValue value;
+
+    bool operator==(const Record& other) const noexcept {
+      return path == other.path && labels_begin == other.labels_begin &&
+             labels_end == other.labels_end && value == other.value;
+    }
+  };
+
+  TextRange AppendText(std::string_view text);
+  std::string_view GetText(TextRange range) const noexcept;
+
+  std::string text_;
+  std::vector<std::pair<TextRange, TextRange>> labels_;
+  std::vector<Record> records_;
+  // Deque keeps the addresses of the elements on move, so the HistogramView
+  // of the records remain valid
+  std::deque<Histogram> histograms_;
+};
+
+}  // namespace impl
+
+struct ScrapeCache::Impl final {
+  struct SourceData final {
+    impl::MetricsRecorder metrics;
+    impl::SerializedChunk chunk;
+    std::uint64_t generation{0};
+  };
+
+  struct MetricName final {
+    std::string converted;
+    std::uint64_t declared_generation{0};
+    std::uint64_t seen_chunk{0};
+  };
+
+  /// Starts a new scrape, drops everything if the `format` changed
+  void StartScrape(std::string_view new_format);
+
+  /// Drops the data of writers that were not visited by the current scrape
+  void DropStaleSources();
+
+  std::string_view format;
+  std::uint64_t generation{0};
+  std::uint64_t chunk_counter{0};
+
+  std::unordered_map<const void*, SourceData> sources;
+  impl::MetricsRecorder recorder;
+
+  // Format specific data
+  fmt::memory_buffer output;
+  utils::impl::TransparentMap<std::string, MetricName> metric_names;
+};
+
+}  // namespace utils::statistics
+
+USERVER_NAMESPACE_END
@@ -1,11 +1,14 @@
 #include <userver/utils/statistics/solomon.hpp>
 
+#include <optional>
+
 #include <userver/formats/json/string_builder.hpp>
 #include <userver/logging/log.hpp>
 #include <userver/utils/overloaded.hpp>
 #include <userver/utils/statistics/storage.hpp>
 
 #include <utils/statistics/impl/histogram_serialization.hpp>
+#include <utils/statistics/scrape_cache_impl.hpp>
 #include <utils/statistics/solomon_limits.hpp>
 
 USERVER_NAMESPACE_BEGIN
@@ -20,7 +23,7 @@ constexpr bool IsReservedLabelName(std::string_view name) {
   return false;
 }
 
-class SolomonJsonBuilder final : public utils::statistics::BaseFormatBuilder {
+class SolomonJsonBuilder final : public impl::BaseCachingFormatBuilder {
  public:
   explicit SolomonJsonBuilder(formats::json::StringBuilder& builder)
       : builder_{builder} {}
@@ -59,6 +62,30 @@ class SolomonJsonBuilder final : public utils::statistics::BaseFormatBuilder {
     });
   }
 
+  void BeginChunk() override {
+    UASSERT(!chunk_begin_);
+    chunk_begin_ = builder_.GetStringView().size();
+  }
+
+  void EndChunk(impl::SerializedChunk& chunk) override {
+    UASSERT(chunk_begin_);
+    auto data = builder_.GetStringView().substr(*chunk_begin_);
+    // The separator from the previous array element, the builder writes it
+    // on AppendChunk if needed
+    if (!data.empty() && data.front() == ',') {
+      data.remove_prefix(1);
+    }
+    chunk.data.assign(data);
+    chunk_begin_.reset();
+  }
+
+  bool AppendChunk(const impl::SerializedChunk& chunk) override {
+    if (!chunk.data.empty()) {
+      builder_.WriteRawString(chunk.data);
+    }
+    return true;
+  }
+
   void AddCommonLabels(
       const std::unordered_map<std::string, std::string>& common_labels) {
     if (common_labels.empty()) {
@@ -121,14 +148,13 @@ class SolomonJsonBuilder final : public utils::statistics::BaseFormatBuilder {
   }
 
   formats::json::StringBuilder& builder_;
+  std::optional<std::size_t> chunk_begin_;
 };
 
-}  // namespace
-
-std::string ToSolomonFormat(
+std::string Format(
     const utils::statistics::Storage& statistics,
     const std::unordered_map<std::string, std::string>& common_labels,
-    const utils::statistics::Request& request) {
+    const utils::statistics::Request& request, ScrapeCache* cache) {
   formats::json::StringBuilder builder;
   SolomonJsonBuilder solomon_json_builder(builder);
   {
@@ -137,11 +163,32 @@ std::string ToSolomonFormat(
 
     builder.Key("metrics");
     formats::json::StringBuilder::ArrayGuard array_guard(builder);
-    statistics.VisitMetrics(solomon_json_builder, request);
+    if (cache) {
+      cache->GetImpl().StartScrape("solomon");
+      statistics.VisitMetricsCached(solomon_json_builder, *cache, request);
+    } else {
+      statistics.VisitMetrics(solomon_json_builder, request);
+    }
   }
   return builder.GetString();
 }
 
+}  // namespace
+
+std::string ToSolomonFormat(
+    const utils::statistics::Storage& statistics,
+    const std::unordered_map<std::string, std::string>& common_labels,
+    const utils::statistics::Request& request) {
+  return Format(statistics, common_labels, request, nullptr);
+}
+
+std::string ToSolomonFormat(
+    const utils::statistics::Storage& statistics,
+    const std::unordered_map<std::string, std::string>& common_labels,
+    ScrapeCache& cache, const utils::statistics::Request& request) {
+  return Format(statistics, common_labels, request, &cache);
+}
+
 }  // namespace utils::statistics
 
 USERVER_NAMESPACE_END
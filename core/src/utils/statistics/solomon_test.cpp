@@ -397,6 +397,36 @@ UTEST(MetricsSolomon, RateMetric) {
   TestToMetricsSolomon(statistics_storage, expected);
 }
 
+UTEST(MetricsSolomon, ScrapeCache) {
+  utils::statistics::Storage storage;
+  int changing_value = 0;
+
+  auto holder1 = storage.RegisterWriter("a", [&](Writer& writer) {
+    writer["gauge"] = 1;
+    writer["rate"] = Rate{5};
+  });
+  auto holder2 = storage.RegisterWriter(
+      "b", [&](Writer& writer) { writer["value"] = changing_value; },
+      {{"label", "value"}});
+  auto holder3 = storage.RegisterWriter("c", [](Writer&) {});
+
+  utils::statistics::ScrapeCache cache;
+  const auto check = [&] {
+    EXPECT_EQ(ToSolomonFormat(storage, {{"application", "processing"}}, cache),
+              ToSolomonFormat(storage, {{"application", "processing"}}));
+  };
+
+  for (int i = 0; i < 3; ++i) {
+    check();
+    check();
+    ++changing_value;
+  }
+
+  holder1.Unregister();
+  check();
+  check();
+}
+
 }  // namespace utils::statistics::impl
 
 USERVER_NAMESPACE_END
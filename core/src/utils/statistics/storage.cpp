@@ -12,6 +12,7 @@
 #include <utils/statistics/value_builder_helpers.hpp>
 
 #include <utils/statistics/entry_impl.hpp>
+#include <utils/statistics/scrape_cache_impl.hpp>
 #include <utils/statistics/visitation.hpp>
 #include <utils/statistics/writer_state.hpp>
 
@@ -68,6 +69,41 @@ CheckDataUsedByCallbackHasNotBeenDestroyedBeforeUnregistering(
   }
 }
 
+void FillAddLabels(impl::WriterState& state, const Request& request) {
+  for (const auto& [name, value] : request.add_labels) {
+    state.add_labels.emplace_back(name, value);
+  }
+}
+
+// Returns false if the writer has thrown
+bool WriteMetrics(const impl::MetricsSource& entry, impl::WriterState& state) {
+  boost::container::small_vector<LabelView, 16> labels_vector;
+  labels_vector.reserve(entry.writer_labels.size());
+  for (const auto& l : entry.writer_labels) {
+    labels_vector.emplace_back(l);
+  }
+
+  try {
+    auto writer =
+        (entry.prefix_path.empty()
+             ? Writer{state, LabelsSpan{labels_vector}}
+             : Writer{state, LabelsSpan{labels_vector}}[entry.prefix_path]);
+    if (writer) {
+      LOG_DEBUG() << "Getting statistics for prefix=" << entry.prefix_path;
+      entry.writer(writer);
+    }
+  } catch (const std::exception& e) {
+    UASSERT_MSG(false,
+                fmt::format("Failed to write metrics for prefix '{}': {}",
+                            entry.prefix_path, e.what()));
+    LOG_ERROR() << "Failed to write metrics for prefix '" << entry.prefix_path
+                << "': " << e;
+    return false;
+  }
+
+  return true;
+}
+
 }  // namespace
 
 Request Request::MakeWithPrefix(const std::string& prefix, AddLabels add_labels,
@@ -120,11 +156,28 @@ void Storage::VisitMetrics(BaseFormatBuilder& out,
                            const Request& request) const {
   {
     impl::WriterState state{out, request, {}, {}};
-    for (const auto& [name, value] : request.add_labels) {
-      state.add_labels.emplace_back(name, value);
+    FillAddLabels(state, request);
+
+    std::shared_lock lock(mutex_);
+    for (const auto& entry : metrics_sources_) {
+      if (entry.writer) {
+        WriteMetrics(entry, state);
+      }
     }
+  }
+
+  statistics::VisitMetrics(out, GetAsJson(), request);
+}
+
+void Storage::VisitMetricsCached(impl::BaseCachingFormatBuilder& out,
+                                 ScrapeCache& cache,
+                                 const Request& request) const {
+  auto& cache_impl = cache.GetImpl();
+  auto& recorder = cache_impl.recorder;
 
-    boost::container::small_vector<LabelView, 16> labels_vector;
+  {
+    impl::WriterState state{recorder, request, {}, {}};
+    FillAddLabels(state, request);
 
     std::shared_lock lock(mutex_);
     for (const auto& entry : metrics_sources_) {
@@ -132,31 +185,27 @@ void Storage::VisitMetrics(BaseFormatBuilder& out,
         continue;
       }
 
-      labels_vector.clear();
-      labels_vector.reserve(entry.writer_labels.size());
-      for (const auto& l : entry.writer_labels) {
-        labels_vector.emplace_back(l);
+      recorder.Clear();
+      if (!WriteMetrics(entry, state)) {
+        cache_impl.sources.erase(&entry);
+        recorder.Replay(out);
+        continue;
       }
 
-      try {
-        auto writer =
-            (entry.prefix_path.empty()
-                 ? Writer{state, LabelsSpan{labels_vector}}
-                 : Writer{state, LabelsSpan{labels_vector}}[entry.prefix_path]);
-        if (writer) {
-          LOG_DEBUG() << "Getting statistics for prefix=" << entry.prefix_path;
-          entry.writer(writer);
-        }
-      } catch (const std::exception& e) {
-        UASSERT_MSG(false,
-                    fmt::format("Failed to write metrics for prefix '{}': {}",
-                                entry.prefix_path, e.what()));
-        LOG_ERROR() << "Failed to write metrics for prefix '"
-                    << entry.prefix_path << "': " << e;
+      auto& source = cache_impl.sources[&entry];
+      source.generation = cache_impl.generation;
+      if (source.metrics == recorder && out.AppendChunk(source.chunk)) {
+        continue;
       }
+
+      out.BeginChunk();
+      recorder.Replay(out);
+      out.EndChunk(source.chunk);
+      std::swap(source.metrics, recorder);
     }
   }
 
+  cache_impl.DropStaleSources();
   statistics::VisitMetrics(out, GetAsJson(), request);
 }
 
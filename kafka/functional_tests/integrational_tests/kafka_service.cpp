@@ -16,6 +16,7 @@
 #include <userver/formats/json/serialize_container.hpp>
 #include <userver/formats/json/value.hpp>
 #include <userver/formats/json/value_builder.hpp>
+#include <userver/formats/parse/common_containers.hpp>
 
 #include <userver/server/handlers/http_handler_json_base.hpp>
 #include <userver/server/handlers/tests_control.hpp>
@@ -25,6 +26,7 @@
 
 #include <userver/kafka/components/consumer_component.hpp>
 #include <userver/kafka/components/producer_component.hpp>
+#include <userver/kafka/producer_message.hpp>
 
 #include <userver/testsuite/testsuite_support.hpp>
 
@@ -103,6 +105,25 @@ class HandlerKafkaConsumer final
   kafka::ConsumerScope consumer_;
 };
 
+class HandlerKafkaProducerBatch final
+    : public server::handlers::HttpHandlerJsonBase {
+ public:
+  static constexpr std::string_view kName = "handler-kafka-producer-batch";
+
+  HandlerKafkaProducerBatch(const components::ComponentConfig& config,
+                            const components::ComponentContext& context);
+
+  formats::json::Value HandleRequestJsonThrow(
+      const server::http::HttpRequest& request,
+      const formats::json::Value& request_json,
+      server::request::RequestContext& context) const override;
+
+  static yaml_config::Schema GetStaticConfigSchema();
+
+ private:
+  const kafka::Producer& producer_;
+};
+
 class HandlerKafkaProducers final
     : public server::handlers::HttpHandlerJsonBase {
  public:
@@ -388,6 +409,65 @@ formats::json::Value HandlerKafkaProducers::HandleSingleProducerRequest(
   return formats::json::FromString(kMessageSend);
 }
 
+HandlerKafkaProducerBatch::HandlerKafkaProducerBatch(
+    const components::ComponentConfig& config,
+    const components::ComponentContext& context)
+    : server::handlers::HttpHandlerJsonBase(config, context),
+      producer_(context
+                    .FindComponent<kafka::ProducerComponent>(
+                        config["producer"].As<std::string>())
+                    .GetProducer()) {}
+
+/// Sends the owned messages of the request with a single SendBatch call and
+/// responds whether each of them was delivered and whether its payload was
+/// left in the message
+formats::json::Value HandlerKafkaProducerBatch::HandleRequestJsonThrow(
+    [[maybe_unused]] const server::http::HttpRequest& request,
+    const formats::json::Value& request_json,
+    [[maybe_unused]] server::request::RequestContext& context) const {
+  const auto topic = request_json[kReqTopicFieldName].As<std::string>();
+
+  std::vector<kafka::ProducerMessage> messages;
+  for (const auto& message : request_json["messages"]) {
+    messages.push_back(kafka::ProducerMessage::Owned(
+        message[kReqKeyFieldName].As<std::string>(),
+        message[kReqPayloadFieldName].As<std::string>(),
+        message["partition"].As<std::optional<std::uint32_t>>()));
+  }
+
+  auto futures = producer_.SendBatch(topic, messages);
+
+  formats::json::ValueBuilder results{formats::common::Type::kArray};
+  for (std::size_t i = 0; i < futures.size(); ++i) {
+    formats::json::ValueBuilder result{formats::common::Type::kObject};
+    result["payload_kept"] = !messages[i].GetPayload().empty();
+    try {
+      futures[i].Get();
+      result["delivered"] = true;
+    } catch (const std::runtime_error& ex) {
+      result["delivered"] = false;
+      result["error"] = ex.what();
+    }
+    results.PushBack(std::move(result));
+  }
+
+  formats::json::ValueBuilder builder{formats::common::Type::kObject};
+  builder["results"] = std::move(results);
+  return builder.ExtractValue();
+}
+
+yaml_config::Schema HandlerKafkaProducerBatch::GetStaticConfigSchema() {
+  return yaml_config::MergeSchemas<server::handlers::HttpHandlerJsonBase>(R"(
+type: object
+description: Handler of Kafka producer batches
+additionalProperties: false
+properties:
+    producer:
+        type: string
+        description: producer name
+)");
+}
+
 formats::json::Value HandlerKafkaProducers::HandleMultiProducersRequest(
     const formats::json::Value& request_json,
     const server::http::HttpRequest& request) const {
@@ -434,7 +514,8 @@ int main(int argc, char* argv[]) {
           .Append<clients::dns::Component>()
           .Append<server::handlers::TestsControl>()
           .Append<functional_tests::HandlerKafkaConsumer>()
-          .Append<functional_tests::HandlerKafkaProducers>();
+          .Append<functional_tests::HandlerKafkaProducers>()
+          .Append<functional_tests::HandlerKafkaProducerBatch>();
 
   return utils::DaemonMain(argc, argv, components_list);
 }
@@ -0,0 +1,97 @@
+import os
+
+
+import confluent_kafka
+
+
+from utils import clear_topics
+
+
+PRODUCE_BATCH_ROUTE = '/produce-batch'
+TOPIC = 'test-topic-send'
+# Not consumed by the service
+PARTITIONS_TOPIC = 'test-topic-send-batch-partitions'
+
+# Larger than the default `message.max.bytes`, fails to enqueue
+TOO_LARGE_PAYLOAD = 'x' * 2 * 1024 * 1024
+UNKNOWN_PARTITION = 1000
+
+
+async def _produce_batch(service_client, topic, messages):
+    response = await service_client.post(
+        PRODUCE_BATCH_ROUTE, json={'topic': topic, 'messages': messages},
+    )
+    assert response.status_code == 200
+
+    return response.json()['results']
+
+
+def _consume_partitions(topic: str, count: int) -> dict[str, int]:
+    consumer = confluent_kafka.Consumer(
+        {
+            'bootstrap.servers': os.getenv('KAFKA_RECIPE_BROKER_LIST'),
+            'group.id': 'test-send-batch-partitions',
+            'auto.offset.reset': 'earliest',
+        },
+    )
+    consumer.subscribe([topic])
+
+    partitions: dict[str, int] = {}
+    try:
+        while len(partitions) < count:
+            message = consumer.poll(timeout=10.0)
+            assert message is not None, 'Messages were not consumed'
+            assert message.error() is None
+            partitions[message.key().decode()] = message.partition()
+    finally:
+        consumer.close()
+
+    return partitions
+
+
+async def test_send_batch_mixed(service_client, testpoint):
+    @testpoint('tp_kafka-consumer')
+    def received_messages_func(_data):
+        pass
+
+    await service_client.enable_testpoints()
+
+    results = await _produce_batch(
+        service_client,
+        TOPIC,
+        [
+            {'key': 'key-1', 'payload': 'message-1'},
+            {'key': 'key-2', 'payload': TOO_LARGE_PAYLOAD},
+            {'key': 'key-3', 'payload': 'message-3', 'partition': 0},
+            {
+                'key': 'key-4',
+                'payload': 'message-4',
+                'partition': UNKNOWN_PARTITION,
+            },
+        ],
+    )
+
+    assert results[0] == {'delivered': True, 'payload_kept': False}
+    assert not results[1]['delivered']
+    # Payload of the message that failed to enqueue is left to the caller
+    assert results[1]['payload_kept']
+    assert results[2] == {'delivered': True, 'payload_kept': False}
+    assert not results[3]['delivered']
+
+    await clear_topics(
+        service_client, received_messages_func, messages_to_clear_cnt=2,
+    )
+
+
+async def test_send_batch_partitions(service_client):
+    messages = [
+        {'key': f'key-{i}', 'payload': f'message-{i}', 'partition': i % 2}
+        for i in range(6)
+    ]
+    results = await _produce_batch(service_client, PARTITIONS_TOPIC, messages)
+    assert all(result['delivered'] for result in results)
+
+    partitions = _consume_partitions(PARTITIONS_TOPIC, len(messages))
+    assert partitions == {
+        message['key']: message['partition'] for message in messages
+    }
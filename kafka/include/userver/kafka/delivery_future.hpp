@@ -0,0 +1,49 @@
+#pragma once
+
+/// @file userver/kafka/delivery_future.hpp
+/// @brief @copybrief kafka::DeliveryFuture
+
+#include <userver/engine/deadline.hpp>
+#include <userver/engine/future.hpp>
+#include <userver/engine/future_status.hpp>
+
+USERVER_NAMESPACE_BEGIN
+
+namespace kafka {
+
+namespace impl {
+class DeliveryResult;
+class ProducerImpl;
+}  // namespace impl
+
+/// @brief Waits for a delivery report of a message sent with
+/// `Producer::SendBatch`.
+///
+/// Unlike `Producer::SendAsync`, no task is spawned per message: the future is
+/// completed directly by the delivery report callback.
+class DeliveryFuture final {
+ public:
+  DeliveryFuture(DeliveryFuture&&) noexcept;
+  DeliveryFuture& operator=(DeliveryFuture&&) noexcept;
+  ~DeliveryFuture();
+
+  /// @brief Waits until the message is delivered or the delivery error
+  /// occurred. May be called only once.
+  /// @throws std::runtime_error if message is not delivered and acked by
+  /// Kafka Broker
+  void Get();
+
+  /// @brief Waits for the delivery report until the deadline.
+  [[nodiscard]] engine::FutureStatus WaitUntil(engine::Deadline deadline) const;
+
+ private:
+  friend class impl::ProducerImpl;
+
+  explicit DeliveryFuture(engine::Future<impl::DeliveryResult>&& future);
+
+  engine::Future<impl::DeliveryResult> future_;
+};
+
+}  // namespace kafka
+
+USERVER_NAMESPACE_END
@@ -2,10 +2,14 @@
 
 #include <chrono>
 #include <cstdint>
+#include <vector>
 
 #include <userver/engine/task/task.hpp>
 #include <userver/engine/task/task_processor_fwd.hpp>
 #include <userver/engine/task/task_with_result.hpp>
+#include <userver/kafka/delivery_future.hpp>
+#include <userver/kafka/producer_message.hpp>
+#include <userver/utils/span.hpp>
 #include <userver/utils/statistics/writer.hpp>
 
 USERVER_NAMESPACE_BEGIN
@@ -110,6 +114,30 @@ class Producer final {
       std::string topic_name, std::string key, std::string message,
       std::optional<std::uint32_t> partition = std::nullopt) const;
 
+  /// @brief Enqueues the batch of messages to topic `topic_name` and returns
+  /// the futures to wait for their delivery, in the order of `messages`.
+  ///
+  /// Unlike `Producer::SendAsync`, no task is spawned and no data is copied
+  /// per message, and the whole batch is enqueued into `librdkafka` with a
+  /// single call on the current task processor. Prefer it for high message
+  /// rates.
+  ///
+  /// Payloads of `ProducerMessage::Owned` messages are moved into the
+  /// producer, borrowed payloads must stay valid until the corresponding
+  /// future is ready. If a message fails to enqueue (e.g. the local queue is
+  /// full or the message is too large), its future is ready with an error and
+  /// its owned payload is left in the message, so it may be resent.
+  ///
+  /// Messages are retried only by `librdkafka` according to its
+  /// configuration, `send_retries` option is not applied.
+  ///
+  /// @warning Dropping a future does not cancel the delivery, so a borrowed
+  /// payload must stay valid until the delivery report even if its future is
+  /// dropped.
+  [[nodiscard]] std::vector<DeliveryFuture> SendBatch(
+      const std::string& topic_name,
+      utils::span<ProducerMessage> messages) const;
+
   /// @brief Dumps per topic messages produce statistics.
   /// @see impl/stats.hpp
   void DumpMetric(utils::statistics::Writer& writer) const;
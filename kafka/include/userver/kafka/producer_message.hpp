@@ -0,0 +1,62 @@
+#pragma once
+
+/// @file userver/kafka/producer_message.hpp
+/// @brief @copybrief kafka::ProducerMessage
+
+#include <cstdint>
+#include <optional>
+#include <string>
+#include <string_view>
+
+USERVER_NAMESPACE_BEGIN
+
+namespace kafka {
+
+namespace impl {
+class ProducerImpl;
+}  // namespace impl
+
+/// @brief Message to send with `Producer::SendBatch`.
+///
+/// The payload is either borrowed or owned by the message. A borrowed payload
+/// is not copied and must stay valid until the message delivery future is
+/// ready. An owned payload is moved into the producer and freed on delivery.
+///
+/// The key is always copied by `librdkafka`, so a borrowed key only has to
+/// outlive the `Producer::SendBatch` call.
+class ProducerMessage final {
+ public:
+  /// @brief Creates a message that borrows the key and the payload.
+  static ProducerMessage Borrowed(
+      std::string_view key, std::string_view payload,
+      std::optional<std::uint32_t> partition = std::nullopt);
+
+  /// @brief Creates a message that owns the key and the payload.
+  static ProducerMessage Owned(
+      std::string key, std::string payload,
+      std::optional<std::uint32_t> partition = std::nullopt);
+
+  std::string_view GetKey() const;
+
+  /// @note Payload of an owned message is empty after `Producer::SendBatch`,
+  /// unless the message failed to enqueue
+  std::string_view GetPayload() const;
+
+  std::optional<std::uint32_t> GetPartition() const { return partition_; }
+
+ private:
+  friend class impl::ProducerImpl;
+
+  ProducerMessage() = default;
+
+  bool is_owned_{false};
+  std::string_view borrowed_key_;
+  std::string_view borrowed_payload_;
+  std::string owned_key_;
+  std::string owned_payload_;
+  std::optional<std::uint32_t> partition_;
+};
+
+}  // namespace kafka
+
+USERVER_NAMESPACE_END
@@ -0,0 +1,38 @@
+#include <userver/kafka/delivery_future.hpp>
+
+#include <stdexcept>
+
+#include <fmt/format.h>
+
+#include <kafka/impl/delivery_waiter.hpp>
+
+USERVER_NAMESPACE_BEGIN
+
+namespace kafka {
+
+DeliveryFuture::DeliveryFuture(engine::Future<impl::DeliveryResult>&& future)
+    : future_(std::move(future)) {}
+
+DeliveryFuture::DeliveryFuture(DeliveryFuture&&) noexcept = default;
+
+DeliveryFuture& DeliveryFuture::operator=(DeliveryFuture&&) noexcept = default;
+
+DeliveryFuture::~DeliveryFuture() = default;
+
+void DeliveryFuture::Get() {
+  const auto delivery_result = future_.get();
+  if (!delivery_result.IsSuccess()) {
+    throw std::runtime_error{
+        fmt::format("Failed to deliver message: {}",
+                    rd_kafka_err2str(delivery_result.GetMessageError()))};
+  }
+}
+
+engine::FutureStatus DeliveryFuture::WaitUntil(
+    engine::Deadline deadline) const {
+  return future_.wait_until(deadline);
+}
+
+}  // namespace kafka
+
+USERVER_NAMESPACE_END
@@ -1,6 +1,8 @@
 #pragma once
 
 #include <string>
+#include <utility>
+#include <vector>
 
 #include <librdkafka/rdkafka.h>
 
@@ -25,6 +27,12 @@ class Configuration final {
                 const components::ComponentContext& context,
                 EntityType entity_type);
 
+  /// @brief Sets raw `librdkafka` options as is. Used in benchmarks, where
+  /// the component system is not available.
+  Configuration(
+      std::string component_name,
+      const std::vector<std::pair<std::string, std::string>>& options);
+
   ~Configuration();
 
   Configuration(const Configuration&) = delete;
@@ -30,6 +30,10 @@ bool DeliveryResult::IsSuccess() const {
           *message_status_ == RD_KAFKA_MSG_STATUS_PERSISTED);
 }
 
+rd_kafka_resp_err_t DeliveryResult::GetMessageError() const {
+  return message_error_;
+}
+
 DeliveryWaiter::DeliveryWaiter(std::uint32_t current_retry,
                                std::uint32_t max_retries)
     : current_retry_(current_retry), max_retries_(max_retries) {}
@@ -48,6 +52,13 @@ void DeliveryWaiter::SetDeliveryResult(DeliveryResult delivery_result) {
   wait_handle_.set_value(std::move(delivery_result));
 }
 
+std::string_view DeliveryWaiter::HoldPayload(std::string&& payload) {
+  payload_ = std::move(payload);
+  return payload_;
+}
+
+std::string DeliveryWaiter::ReleasePayload() { return std::move(payload_); }
+
 }  // namespace kafka::impl
 
 USERVER_NAMESPACE_END
@@ -1,6 +1,8 @@
 #pragma once
 
 #include <cstdint>
+#include <string>
+#include <string_view>
 
 #include <userver/engine/future.hpp>
 
@@ -26,6 +28,8 @@ class DeliveryResult {
 
   bool IsSuccess() const;
 
+  rd_kafka_resp_err_t GetMessageError() const;
+
  private:
   const rd_kafka_resp_err_t message_error_;
   const std::optional<rd_kafka_msg_status_t> message_status_;
@@ -45,10 +49,20 @@ class DeliveryWaiter {
 
   void SetDeliveryResult(DeliveryResult delivery_result);
 
+  /// @brief Keeps the message payload alive until the delivery report, as
+  /// `librdkafka` does not copy it.
+  /// @returns the held payload, must be taken after the move because of SSO
+  std::string_view HoldPayload(std::string&& payload);
+
+  /// @brief Gives the held payload back if the message was not enqueued.
+  std::string ReleasePayload();
+
  private:
   const std::uint32_t current_retry_;
   const std::uint32_t max_retries_;
 
+  std::string payload_;
+
   engine::Promise<DeliveryResult> wait_handle_;
 };
 
@@ -183,6 +183,106 @@ void ProducerImpl::Send(const std::string& topic_name, std::string_view key,
   }
 }
 
+std::vector<DeliveryFuture> ProducerImpl::SendBatch(
+    const std::string& topic_name,
+    utils::span<ProducerMessage> messages) const {
+  LOG_INFO() << fmt::format(
+      "Batch of {} messages to topic '{}' is requested to send",
+      messages.size(), topic_name);
+
+  std::vector<DeliveryFuture> futures;
+  futures.reserve(messages.size());
+  if (messages.empty()) {
+    return futures;
+  }
+
+  /// Each waiter is owned by `librdkafka` once its message is enqueued and
+  /// is freed by the delivery report callback, which may be invoked by the
+  /// polling task before `rd_kafka_produce_batch` returns. Therefore, waiters
+  /// are released before the call and only those of the failed messages are
+  /// freed here
+  std::vector<rd_kafka_message_t> rk_messages(messages.size());
+  for (std::size_t i = 0; i < messages.size(); ++i) {
+    auto& message = messages[i];
+
+    /// Library retries require a blocking wait of the delivery, so only
+    /// `librdkafka` retries are made for batches
+    auto waiter = std::make_unique<DeliveryWaiter>(/*current_retry=*/0,
+                                                   /*max_retries=*/0);
+    futures.push_back(DeliveryFuture{waiter->GetFuture()});
+
+    std::string_view payload = message.GetPayload();
+    if (message.is_owned_) {
+      payload = waiter->HoldPayload(std::move(message.owned_payload_));
+    }
+    const std::string_view key = message.GetKey();
+
+    // NOLINTBEGIN(cppcoreguidelines-pro-type-const-cast)
+    auto& rk_message = rk_messages[i];
+    rk_message.partition =
+        message.GetPartition().value_or(RD_KAFKA_PARTITION_UA);
+    rk_message.payload = const_cast<char*>(payload.data());
+    rk_message.len = payload.size();
+    rk_message.key = const_cast<char*>(key.data());
+    rk_message.key_len = key.size();
+    rk_message._private = waiter.release();
+    // NOLINTEND(cppcoreguidelines-pro-type-const-cast)
+  }
+
+  /// The waiter of a failed message is not owned by `librdkafka`, an owned
+  /// payload is given back to the caller, who may resend it
+  const auto fail_message = [&messages, &rk_messages](
+                                std::size_t index, rd_kafka_resp_err_t error) {
+    std::unique_ptr<DeliveryWaiter> waiter{
+        static_cast<DeliveryWaiter*>(rk_messages[index]._private)};
+    if (messages[index].is_owned_) {
+      messages[index].owned_payload_ = waiter->ReleasePayload();
+    }
+    waiter->SetDeliveryResult(DeliveryResult{error});
+  };
+
+  /// Topic handles are reference counted and cached by `librdkafka`, the
+  /// enqueued messages hold their own references
+  const std::unique_ptr<rd_kafka_topic_t, decltype(&rd_kafka_topic_destroy)>
+      topic{rd_kafka_topic_new(producer_.Handle(), topic_name.c_str(), nullptr),
+            &rd_kafka_topic_destroy};
+  if (!topic) {
+    const auto error = rd_kafka_last_error();
+    LOG_WARNING() << fmt::format("Failed to create topic '{}' handle: {}",
+                                 topic_name, rd_kafka_err2str(error));
+    for (std::size_t i = 0; i < rk_messages.size(); ++i) {
+      fail_message(i, error);
+    }
+    AccountEnqueueErrors(topic_name, rk_messages.size());
+    return futures;
+  }
+
+  /// `RD_KAFKA_MSG_F_PARTITION` makes `librdkafka` take the partition from
+  /// each message, `RD_KAFKA_PARTITION_UA` ones are assigned by the
+  /// partitioner. 0 copy flags imply the payload is not copied, the key is
+  /// always copied
+  const int enqueued_count = rd_kafka_produce_batch(
+      topic.get(), RD_KAFKA_PARTITION_UA, RD_KAFKA_MSG_F_PARTITION,
+      rk_messages.data(), static_cast<int>(rk_messages.size()));
+
+  if (static_cast<std::size_t>(enqueued_count) != rk_messages.size()) {
+    for (std::size_t i = 0; i < rk_messages.size(); ++i) {
+      const auto error = rk_messages[i].err;
+      if (error != RD_KAFKA_RESP_ERR_NO_ERROR) {
+        LOG_WARNING() << fmt::format(
+            "Failed to enqueue message to Kafka local queue: {}",
+            rd_kafka_err2str(error));
+        fail_message(i, error);
+      }
+    }
+    AccountEnqueueErrors(
+        topic_name,
+        rk_messages.size() - static_cast<std::size_t>(enqueued_count));
+  }
+
+  return futures;
+}
+
 void ProducerImpl::Poll(std::chrono::milliseconds poll_timeout) const {
   rd_kafka_poll(producer_.Handle(), static_cast<int>(poll_timeout.count()));
 }
@@ -240,7 +340,11 @@ DeliveryResult ProducerImpl::SendImpl(const std::string& topic_name,
         "Failed to enqueue message to Kafka local queue: {}",
         rd_kafka_err2str(enqueue_error));
 
-    return DeliveryResult{enqueue_error};
+    DeliveryResult delivery_result{enqueue_error};
+    if (current_retry == max_retries || !delivery_result.IsRetryable()) {
+      AccountEnqueueErrors(topic_name, 1);
+    }
+    return delivery_result;
   }
 
   /// wait until delivery report callback is invoked:
@@ -248,6 +352,13 @@ DeliveryResult ProducerImpl::SendImpl(const std::string& topic_name,
   return wait_handle.get();
 }
 
+void ProducerImpl::AccountEnqueueErrors(const std::string& topic_name,
+                                        std::size_t count) const {
+  auto topic_stats = stats_.topics_stats[topic_name];
+  topic_stats->messages_counts.messages_total += count;
+  topic_stats->messages_counts.messages_error += count;
+}
+
 const Stats& ProducerImpl::GetStats() const { return stats_; }
 
 }  // namespace kafka::impl
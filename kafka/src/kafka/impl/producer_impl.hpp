@@ -4,6 +4,11 @@
 #include <cstdint>
 #include <memory>
 #include <optional>
+#include <vector>
+
+#include <userver/kafka/delivery_future.hpp>
+#include <userver/kafka/producer_message.hpp>
+#include <userver/utils/span.hpp>
 
 #include <kafka/impl/delivery_waiter.hpp>
 #include <kafka/impl/stats.hpp>
@@ -29,6 +34,14 @@ class ProducerImpl final {
             std::string_view message, std::optional<std::uint32_t> partition,
             std::uint32_t max_retries) const;
 
+  /// @brief Enqueues the messages with a single `librdkafka` call, does not
+  /// wait for their delivery and does not retry them.
+  /// @note Owned payloads are moved out of the `messages`, payloads of the
+  /// messages that failed to enqueue are moved back
+  std::vector<DeliveryFuture> SendBatch(
+      const std::string& topic_name,
+      utils::span<ProducerMessage> messages) const;
+
   /// @brief Polls for delivery events for `poll_timeout_` milliseconds
   void Poll(std::chrono::milliseconds poll_timeout) const;
 
@@ -49,8 +62,13 @@ class ProducerImpl final {
                           std::uint32_t current_retry,
                           std::uint32_t max_retries) const;
 
+  /// @brief Accounts messages that failed before reaching `librdkafka` local
+  /// queue, so the delivery report callback is not invoked for them
+  void AccountEnqueueErrors(const std::string& topic_name,
+                            std::size_t count) const;
+
  private:
-  Stats stats_;
+  mutable Stats stats_;
 
   class ProducerHolder final {
    public:
@@ -99,6 +99,23 @@ engine::TaskWithResult<void> Producer::SendAsync(
       });
 }
 
+std::vector<DeliveryFuture> Producer::SendBatch(
+    const std::string& topic_name,
+    utils::span<ProducerMessage> messages) const {
+  InitProducerAndStartPollingIfFirstSend();
+
+  tracing::Span span{"producer_send_batch"};
+  ExtendCurrentSpan();
+  span.AddTag("kafka_batch_size", messages.size());
+
+  // Payloads of the owned messages are moved out by the send
+  for (const auto& message : messages) {
+    SendToTestPoint(topic_name, message.GetKey(), message.GetPayload());
+  }
+
+  return producer_->SendBatch(topic_name, messages);
+}
+
 void Producer::DumpMetric(utils::statistics::Writer& writer) const {
   if (!first_send_.load()) {
     impl::DumpMetric(writer, producer_->GetStats());
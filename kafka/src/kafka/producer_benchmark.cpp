@@ -0,0 +1,116 @@
+#include <userver/kafka/producer.hpp>
+
+#include <cstdlib>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include <benchmark/benchmark.h>
+
+#include <userver/engine/run_standalone.hpp>
+#include <userver/engine/wait_all_checked.hpp>
+
+#include <kafka/impl/configuration.hpp>
+
+USERVER_NAMESPACE_BEGIN
+
+namespace {
+
+constexpr const char* kBootstrapServersEnv = "KAFKA_BOOTSTRAP_SERVERS_BENCH";
+const std::string kTopic = "bench-producer-topic";
+constexpr std::size_t kMessageSize = 256;
+
+// The polling task blocks its thread in `rd_kafka_poll`
+constexpr std::size_t kWorkerThreads = 2;
+
+std::unique_ptr<kafka::Producer> MakeProducer(benchmark::State& state) {
+  const char* bootstrap_servers = std::getenv(kBootstrapServersEnv);
+  if (!bootstrap_servers) {
+    state.SkipWithError("Kafka bootstrap servers are not set");
+    return nullptr;
+  }
+
+  auto configuration = std::make_unique<kafka::impl::Configuration>(
+      "kafka-producer-benchmark",
+      std::vector<std::pair<std::string, std::string>>{
+          {"bootstrap.servers", bootstrap_servers},
+          {"queue.buffering.max.ms", "5"},
+      });
+  return std::make_unique<kafka::Producer>(
+      std::move(configuration), engine::current_task::GetTaskProcessor(),
+      kafka::Producer::kDefaultPollTimeout,
+      kafka::Producer::kDefaultSendRetries);
+}
+
+std::vector<std::string> MakePayloads(std::size_t count) {
+  return std::vector<std::string>(count, std::string(kMessageSize, 'x'));
+}
+
+}  // namespace
+
+void kafka_producer_send_async(benchmark::State& state) {
+  engine::RunStandalone(kWorkerThreads, [&] {
+    const auto producer = MakeProducer(state);
+    if (!producer) return;
+    const auto payloads = MakePayloads(state.range(0));
+
+    std::vector<engine::TaskWithResult<void>> tasks;
+    for ([[maybe_unused]] auto _ : state) {
+      tasks.clear();
+      for (const auto& payload : payloads) {
+        tasks.push_back(producer->SendAsync(kTopic, "key", payload));
+      }
+      engine::WaitAllChecked(tasks);
+    }
+    state.SetItemsProcessed(state.iterations() * payloads.size());
+  });
+}
+BENCHMARK(kafka_producer_send_async)->RangeMultiplier(10)->Range(10, 10000);
+
+void kafka_producer_send_batch_borrowed(benchmark::State& state) {
+  engine::RunStandalone(kWorkerThreads, [&] {
+    const auto producer = MakeProducer(state);
+    if (!producer) return;
+    const auto payloads = MakePayloads(state.range(0));
+
+    std::vector<kafka::ProducerMessage> messages;
+    for ([[maybe_unused]] auto _ : state) {
+      messages.clear();
+      for (const auto& payload : payloads) {
+        messages.push_back(kafka::ProducerMessage::Borrowed("key", payload));
+      }
+      for (auto& future : producer->SendBatch(kTopic, messages)) {
+        future.Get();
+      }
+    }
+    state.SetItemsProcessed(state.iterations() * payloads.size());
+  });
+}
+BENCHMARK(kafka_producer_send_batch_borrowed)
+    ->RangeMultiplier(10)
+    ->Range(10, 10000);
+
+void kafka_producer_send_batch_owned(benchmark::State& state) {
+  engine::RunStandalone(kWorkerThreads, [&] {
+    const auto producer = MakeProducer(state);
+    if (!producer) return;
+    const auto payloads = MakePayloads(state.range(0));
+
+    std::vector<kafka::ProducerMessage> messages;
+    for ([[maybe_unused]] auto _ : state) {
+      messages.clear();
+      for (const auto& payload : payloads) {
+        messages.push_back(kafka::ProducerMessage::Owned("key", payload));
+      }
+      for (auto& future : producer->SendBatch(kTopic, messages)) {
+        future.Get();
+      }
+    }
+    state.SetItemsProcessed(state.iterations() * payloads.size());
+  });
+}
+BENCHMARK(kafka_producer_send_batch_owned)
+    ->RangeMultiplier(10)
+    ->Range(10, 10000);
+
+USERVER_NAMESPACE_END
@@ -0,0 +1,41 @@
+#include <userver/kafka/producer_message.hpp>
+
+#include <utility>
+
+USERVER_NAMESPACE_BEGIN
+
+namespace kafka {
+
+ProducerMessage ProducerMessage::Borrowed(
+    std::string_view key, std::string_view payload,
+    std::optional<std::uint32_t> partition) {
+  ProducerMessage message;
+  message.borrowed_key_ = key;
+  message.borrowed_payload_ = payload;
+  message.partition_ = partition;
+  return message;
+}
+
+ProducerMessage ProducerMessage::Owned(std::string key, std::string payload,
+                                       std::optional<std::uint32_t> partition) {
+  ProducerMessage message;
+  message.is_owned_ = true;
+  message.owned_key_ = std::move(key);
+  message.owned_payload_ = std::move(payload);
+  message.partition_ = partition;
+  return message;
+}
+
+// Views of the owned strings are not stored, as they are invalidated by the
+// move of a short string
+std::string_view ProducerMessage::GetKey() const {
+  return is_owned_ ? owned_key_ : borrowed_key_;
+}
+
+std::string_view ProducerMessage::GetPayload() const {
+  return is_owned_ ? owned_payload_ : borrowed_payload_;
+}
+
+}  // namespace kafka
+
+USERVER_NAMESPACE_END
@@ -0,0 +1,5 @@
+CREATE TABLE IF NOT EXISTS cache_data (
+  id BIGINT PRIMARY KEY,
+  value VARCHAR NOT NULL,
+  updated TIMESTAMPTZ NOT NULL DEFAULT NOW()
+)
@@ -0,0 +1,78 @@
+#include <userver/clients/dns/component.hpp>
+#include <userver/testsuite/testsuite_support.hpp>
+
+#include <userver/utest/using_namespace_userver.hpp>
+
+#include <userver/clients/http/component.hpp>
+#include <userver/components/minimal_server_component_list.hpp>
+#include <userver/formats/json/value_builder.hpp>
+#include <userver/server/handlers/http_handler_json_base.hpp>
+#include <userver/server/handlers/server_monitor.hpp>
+#include <userver/server/handlers/tests_control.hpp>
+#include <userver/utils/daemon_run.hpp>
+
+#include <userver/storages/postgres/component.hpp>
+
+#include <userver/cache/base_postgres_cache.hpp>
+
+namespace pg::cache {
+
+struct CacheData {
+  std::int64_t id;
+  std::string value;
+};
+
+struct ParallelCachePolicy {
+  static constexpr std::string_view kName = "parallel-pg-cache";
+
+  using ValueType = CacheData;
+  static constexpr auto kKeyMember = &CacheData::id;
+  static constexpr const char* kQuery = "SELECT id, value FROM cache_data";
+  static constexpr const char* kUpdatedField = "updated";
+  using UpdatedFieldType = storages::postgres::TimePointTz;
+
+  static constexpr const char* kRangeKeyField = "id";
+};
+
+using ParallelCache = components::PostgreCache<ParallelCachePolicy>;
+
+class CacheDataHandler final : public server::handlers::HttpHandlerJsonBase {
+ public:
+  static constexpr std::string_view kName = "handler-cache-data";
+
+  CacheDataHandler(const components::ComponentConfig& config,
+                   const components::ComponentContext& context)
+      : HttpHandlerJsonBase(config, context),
+        cache_(context.FindComponent<ParallelCache>()) {}
+
+  formats::json::Value HandleRequestJsonThrow(
+      const server::http::HttpRequest&, const formats::json::Value&,
+      server::request::RequestContext&) const override {
+    const auto data = cache_.Get();
+
+    formats::json::ValueBuilder result{formats::common::Type::kObject};
+    for (const auto& [id, value] : *data) {
+      result[std::to_string(id)] = value.value;
+    }
+    return result.ExtractValue();
+  }
+
+ private:
+  ParallelCache& cache_;
+};
+
+}  // namespace pg::cache
+
+int main(int argc, char* argv[]) {
+  const auto component_list =
+      components::MinimalServerComponentList()
+          .Append<server::handlers::ServerMonitor>()
+          .Append<pg::cache::ParallelCache>()
+          .Append<pg::cache::CacheDataHandler>()
+          .Append<components::HttpClient>()
+          .Append<components::Postgres>("cache-database")
+          .Append<components::TestsuiteSupport>()
+          .Append<server::handlers::TestsControl>()
+          .Append<clients::dns::Component>();
+  return utils::DaemonMain(argc, argv, component_list);
+}
@@ -0,0 +1,89 @@
+import pytest
+
+CACHE_NAME = 'parallel-pg-cache'
+
+# full-update-parallelism from static config times the ranges per task
+KEY_RANGES_COUNT = 3 * 4
+
+
+async def _full_update(service_client, monitor_client):
+    # Lets the testsuite do its own cache invalidation outside of the diff
+    await service_client.update_server_state()
+    async with monitor_client.metrics_diff(
+            prefix='cache.full', labels={'cache_name': CACHE_NAME},
+    ) as differ:
+        await service_client.invalidate_caches(
+            clean_update=True, cache_names=[CACHE_NAME],
+        )
+    return differ
+
+
+async def _get_cache_data(service_client):
+    response = await service_client.get('/cache/data')
+    assert response.status == 200
+    return {int(key): value for key, value in response.json().items()}
+
+
+@pytest.mark.pgsql(
+    'cache_data',
+    queries=[
+        # Sparse keys with gaps and negative values, the range bounds are
+        # hit as well
+        'INSERT INTO cache_data (id, value) '
+        'SELECT i * 7 - 500, \'value-\' || i FROM generate_series(1, 1000) i',
+        'INSERT INTO cache_data (id, value) '
+        'VALUES (-9223372036854775808, \'min\'), '
+        '(9223372036854775807, \'max\')',
+    ],
+)
+async def test_full_update(service_client, monitor_client):
+    differ = await _full_update(service_client, monitor_client)
+    assert differ.value_at('chunks.count') == KEY_RANGES_COUNT
+    assert differ.value_at('documents.read_count.v2') == 1002
+
+    expected = {i * 7 - 500: f'value-{i}' for i in range(1, 1001)}
+    expected[-9223372036854775808] = 'min'
+    expected[9223372036854775807] = 'max'
+    assert await _get_cache_data(service_client) == expected
+
+
+@pytest.mark.pgsql(
+    'cache_data', queries=['INSERT INTO cache_data VALUES (42, \'single\')'],
+)
+async def test_single_key(service_client, monitor_client):
+    differ = await _full_update(service_client, monitor_client)
+    assert differ.value_at('chunks.count') == 1
+
+    assert await _get_cache_data(service_client) == {42: 'single'}
+
+
+async def test_empty_table(service_client, monitor_client):
+    differ = await _full_update(service_client, monitor_client)
+    assert differ.value_at('chunks.count') == 0
+
+    assert await _get_cache_data(service_client) == {}
+
+
+@pytest.mark.pgsql(
+    'cache_data',
+    queries=[
+        'INSERT INTO cache_data (id, value) '
+        'SELECT i, \'old-\' || i FROM generate_series(1, 100) i',
+    ],
+)
+async def test_full_update_after_changes(
+        service_client, monitor_client, pgsql,
+):
+    await _full_update(service_client, monitor_client)
+    assert len(await _get_cache_data(service_client)) == 100
+
+    cursor = pgsql['cache_data'].cursor()
+    cursor.execute('DELETE FROM cache_data WHERE id > 50')
+    cursor.execute(
+        'UPDATE cache_data SET value = \'new-\' || id WHERE id % 2 = 0',
+    )
+
+    await _full_update(service_client, monitor_client)
+    assert await _get_cache_data(service_client) == {
+        i: f'new-{i}' if i % 2 == 0 else f'old-{i}' for i in range(1, 51)
+    }
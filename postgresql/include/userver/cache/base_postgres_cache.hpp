@@ -5,11 +5,17 @@
 
 #include <userver/cache/base_postgres_cache_fwd.hpp>
 
+#include <atomic>
 #include <chrono>
+#include <cstdint>
 #include <map>
+#include <optional>
 #include <string_view>
+#include <tuple>
 #include <type_traits>
 #include <unordered_map>
+#include <utility>
+#include <vector>
 
 #include <fmt/format.h>
 
@@ -17,6 +23,7 @@
 #include <userver/cache/caching_component_base.hpp>
 #include <userver/components/component_config.hpp>
 #include <userver/components/component_context.hpp>
+#include <userver/concurrent/queue.hpp>
 
 #include <userver/storages/postgres/cluster.hpp>
 #include <userver/storages/postgres/component.hpp>
@@ -26,6 +33,7 @@
 #include <userver/logging/log.hpp>
 #include <userver/tracing/span.hpp>
 #include <userver/utils/assert.hpp>
+#include <userver/utils/async.hpp>
 #include <userver/utils/cpu_relax.hpp>
 #include <userver/utils/meta.hpp>
 #include <userver/utils/void_t.hpp>
@@ -66,6 +74,30 @@ namespace components {
 /// incremental-update-op-timeout | timeout for an incremental update | 1s
 /// update-correction | incremental update window adjustment | - (0 for caches with defined GetLastKnownUpdated)
 /// chunk-size | number of rows to request from PostgreSQL via portals, 0 to fetch all rows in one request without portals | 1000
+/// full-update-parallelism | number of key ranges of a full update that are fetched and parsed concurrently, requires `kRangeKeyField` in the policy; the ranges are separate non-transactional queries, so the full update is not a consistent snapshot of the table | 1
+///
+/// @section pg_cc_parallel_full_update Parallel full updates
+///
+/// Full updates of big caches may be split into ranges of an integer key
+/// that are fetched over several connections and parsed in parallel tasks,
+/// while the current task inserts the parsed rows into the container. To do
+/// that, specify the name of the key column of the query in `kRangeKeyField`
+/// and set `full-update-parallelism` to more than 1:
+///
+/// @snippet cache/postgres_cache_test.cpp Pg Cache Policy Parallel Full Update Example
+///
+/// The ranges are evenly spread between the minimal and the maximal value of
+/// the key, there are several of them for each of the concurrent tasks to
+/// even out the gaps in the key values. Each range is fetched with one
+/// request, `chunk-size` is not used for them. Incremental updates are not
+/// affected.
+///
+/// @warning The ranges are fetched by separate non-transactional queries,
+/// possibly from different hosts, so a parallel full update is not a
+/// consistent snapshot of the data: rows changed during the update may be
+/// seen in either state, and a row whose key moves between ranges may be
+/// missed or seen twice. Use it for the data that tolerates that until the
+/// next update, e.g. with a key that is never changed.
 ///
 /// @section pg_cc_cache_policy Cache policy
 ///
@@ -161,6 +193,13 @@ using HasWhere = decltype(T::kWhere);
 template <typename T>
 inline constexpr bool kHasWhere = meta::kIsDetected<HasWhere, T>;
 
+// Key field to split full updates into ranges
+template <typename T>
+using HasRangeKeyField = decltype(T::kRangeKeyField);
+template <typename T>
+inline constexpr bool kHasRangeKeyField =
+    meta::kIsDetected<HasRangeKeyField, T>;
+
 // Update field
 template <typename T>
 using HasUpdatedField = decltype(T::kUpdatedField);
@@ -368,6 +407,17 @@ inline constexpr std::string_view kFetchStage = "fetch";
 inline constexpr std::string_view kParseStage = "parse";
 
 inline constexpr std::size_t kDefaultChunkSize = 1000;
+inline constexpr std::size_t kDefaultFullUpdateParallelism = 1;
+
+// Several ranges per task even out the gaps in the key values
+inline constexpr std::size_t kKeyRangesPerTask = 4;
+
+using KeyRange = std::pair<std::int64_t, std::int64_t>;
+
+/// Splits [min_key, max_key] into at most `count` adjacent ranges of the same
+/// size, the bounds are inclusive
+std::vector<KeyRange> SplitKeyRange(std::int64_t min_key, std::int64_t max_key,
+                                    std::size_t count);
 }  // namespace pg_cache::detail
 
 /// @ingroup userver_components
@@ -420,8 +470,21 @@ class PostgreCache final
                     cache::UpdateStatisticsScope& stats_scope,
                     tracing::ScopeTime& scope);
 
+  std::size_t CacheResultsByKeyRanges(storages::postgres::Cluster& cluster,
+                                      std::chrono::milliseconds timeout,
+                                      CachedData& data_cache,
+                                      cache::UpdateStatisticsScope& stats_scope,
+                                      tracing::ScopeTime& scope);
+  static std::vector<ValueType> ParseRows(
+      const storages::postgres::ResultSet& res,
+      cache::UpdateStatisticsScope& stats_scope);
+  static void AccountParseFailure(cache::UpdateStatisticsScope& stats_scope,
+                                  const std::exception& e);
+
   static storages::postgres::Query GetAllQuery();
   static storages::postgres::Query GetDeltaQuery();
+  static storages::postgres::Query GetKeyBoundsQuery();
+  static storages::postgres::Query GetKeyRangeQuery();
 
   std::chrono::milliseconds ParseCorrection(const ComponentConfig& config);
 
@@ -431,6 +494,7 @@ class PostgreCache final
   const std::chrono::milliseconds full_update_timeout_;
   const std::chrono::milliseconds incremental_update_timeout_;
   const std::size_t chunk_size_;
+  const std::size_t full_update_parallelism_;
   std::size_t cpu_relax_iterations_parse_{0};
   std::size_t cpu_relax_iterations_copy_{0};
 };
@@ -450,7 +514,9 @@ PostgreCache<PostgreCachePolicy>::PostgreCache(const ComponentConfig& config,
           config["incremental-update-op-timeout"].As<std::chrono::milliseconds>(
               pg_cache::detail::kDefaultIncrementalUpdateTimeout)},
       chunk_size_{config["chunk-size"].As<size_t>(
-          pg_cache::detail::kDefaultChunkSize)} {
+          pg_cache::detail::kDefaultChunkSize)},
+      full_update_parallelism_{config["full-update-parallelism"].As<size_t>(
+          pg_cache::detail::kDefaultFullUpdateParallelism)} {
   UINVARIANT(
       !chunk_size_ || storages::postgres::Portal::IsSupportedByDriver(),
       "Either set 'chunk-size' to 0, or enable PostgreSQL portals by building "
@@ -464,6 +530,13 @@ PostgreCache<PostgreCachePolicy>::PostgreCache(const ComponentConfig& config,
         "name is specified in traits of '" +
         config.Name() + "' cache");
   }
+  if (full_update_parallelism_ > 1 &&
+      !pg_cache::detail::kHasRangeKeyField<PolicyType>) {
+    throw std::logic_error(
+        "Parallel full updates are requested in config but no range key field "
+        "name is specified in traits of '" +
+        config.Name() + "' cache");
+  }
   if (correction_.count() < 0) {
     throw std::logic_error(
         "Refusing to set forward (negative) update correction requested in "
@@ -527,6 +600,38 @@ storages::postgres::Query PostgreCache<PostgreCachePolicy>::GetDeltaQuery() {
   }
 }
 
+template <typename PostgreCachePolicy>
+storages::postgres::Query
+PostgreCache<PostgreCachePolicy>::GetKeyBoundsQuery() {
+  if constexpr (pg_cache::detail::kHasRangeKeyField<PostgreCachePolicy>) {
+    return {fmt::format("select min({0})::bigint, max({0})::bigint "
+                        "from ({1}) as cache_data",
+                        PolicyType::kRangeKeyField, GetAllQuery().Statement())};
+  } else {
+    UINVARIANT(false, "No range key field in the cache policy");
+  }
+}
+
+template <typename PostgreCachePolicy>
+storages::postgres::Query
+PostgreCache<PostgreCachePolicy>::GetKeyRangeQuery() {
+  if constexpr (pg_cache::detail::kHasRangeKeyField<PostgreCachePolicy>) {
+    const storages::postgres::Query query = GetAllQuery();
+    // Separate name keeps statement metrics of the chunks apart from the ones
+    // of the full query
+    std::optional<storages::postgres::Query::Name> name;
+    if (query.GetName()) {
+      name.emplace(query.GetName()->GetUnderlying() + "_key_range");
+    }
+    return {fmt::format("select * from ({}) as cache_data "
+                        "where {} between $1 and $2",
+                        query.Statement(), PolicyType::kRangeKeyField),
+            std::move(name)};
+  } else {
+    UINVARIANT(false, "No range key field in the cache policy");
+  }
+}
+
 template <typename PostgreCachePolicy>
 std::chrono::milliseconds PostgreCache<PostgreCachePolicy>::ParseCorrection(
     const ComponentConfig& config) {
@@ -578,7 +683,10 @@ void PostgreCache<PostgreCachePolicy>::Update(
   size_t changes = 0;
   // Iterate clusters
   for (auto& cluster : clusters_) {
-    if (chunk_size_ > 0) {
+    if (type == cache::UpdateType::kFull && full_update_parallelism_ > 1) {
+      changes += CacheResultsByKeyRanges(*cluster, timeout, data_cache,
+                                         stats_scope, scope);
+    } else if (chunk_size_ > 0) {
       auto trx = cluster->Begin(
           kClusterHostTypeFlags, pg::Transaction::RO,
           pg::CommandControl{timeout, pg_cache::detail::kStatementTimeoutOff});
@@ -675,13 +783,133 @@ void PostgreCache<PostgreCachePolicy>::CacheResults(
           *data_cache, pg_cache::detail::ExtractValue<PostgreCachePolicy>(*p),
           PostgreCachePolicy::kKeyMember);
     } catch (const std::exception& e) {
-      stats_scope.IncreaseDocumentsParseFailures(1);
-      LOG_ERROR() << "Error parsing data row in cache '" << kName << "' to '"
-                  << compiler::GetTypeName<ValueType>() << "': " << e.what();
+      AccountParseFailure(stats_scope, e);
     }
   }
 }
 
+template <typename PostgreCachePolicy>
+std::size_t PostgreCache<PostgreCachePolicy>::CacheResultsByKeyRanges(
+    storages::postgres::Cluster& cluster, std::chrono::milliseconds timeout,
+    CachedData& data_cache, cache::UpdateStatisticsScope& stats_scope,
+    tracing::ScopeTime& scope) {
+  namespace pg = storages::postgres;
+  const pg::CommandControl cmd_ctl{timeout,
+                                   pg_cache::detail::kStatementTimeoutOff};
+
+  const auto [min_key, max_key] =
+      cluster.Execute(kClusterHostTypeFlags, cmd_ctl, GetKeyBoundsQuery())
+          .template AsSingleRow<std::tuple<std::optional<std::int64_t>,
+                                           std::optional<std::int64_t>>>(
+              pg::kRowTag);
+  if (!min_key || !max_key) return 0;
+
+  const auto ranges = pg_cache::detail::SplitKeyRange(
+      *min_key, *max_key,
+      full_update_parallelism_ * pg_cache::detail::kKeyRangesPerTask);
+
+  // The ranges are fetched and parsed in separate tasks while the current
+  // task inserts the parsed ones into the container. There is no common
+  // transaction, so the result is not a snapshot of the table. The queue
+  // limits the number of parsed ranges waiting for the insertion.
+  using Chunk = std::vector<ValueType>;
+  auto queue = concurrent::NonFifoMpscQueue<Chunk>::Create(
+      full_update_parallelism_);
+  auto consumer = queue->GetConsumer();
+  std::atomic<std::size_t> next_range{0};
+
+  std::vector<engine::TaskWithResult<void>> tasks;
+  const auto tasks_count = std::min(full_update_parallelism_, ranges.size());
+  tasks.reserve(tasks_count);
+  for (std::size_t i = 0; i < tasks_count; ++i) {
+    tasks.push_back(utils::Async(
+        "pg_cache_fetch_range",
+        [&, producer = queue->GetProducer()] {
+          for (auto range = next_range++; range < ranges.size();
+               range = next_range++) {
+            const auto start = std::chrono::steady_clock::now();
+            const auto res = cluster.Execute(
+                kClusterHostTypeFlags, cmd_ctl, GetKeyRangeQuery(),
+                ranges[range].first, ranges[range].second);
+            stats_scope.IncreaseDocumentsReadCount(res.Size());
+            auto chunk = ParseRows(res, stats_scope);
+            stats_scope.AccountChunk(
+                std::chrono::duration_cast<std::chrono::milliseconds>(
+                    std::chrono::steady_clock::now() - start));
+            // The consumer is gone if the update was cancelled
+            if (!producer.Push(std::move(chunk))) return;
+          }
+        }));
+  }
+
+  std::size_t changes = 0;
+  utils::CpuRelax relax{cpu_relax_iterations_parse_, &scope};
+  Chunk chunk;
+  while (consumer.Pop(chunk)) {
+    changes += chunk.size();
+    for (auto& value : chunk) {
+      relax.Relax();
+      try {
+        using pg_cache::detail::CacheInsertOrAssign;
+        CacheInsertOrAssign(*data_cache, std::move(value),
+                            PostgreCachePolicy::kKeyMember);
+      } catch (const std::exception& e) {
+        AccountParseFailure(stats_scope, e);
+      }
+    }
+  }
+
+  for (auto& task : tasks) task.Get();
+  return changes;
+}
+
+template <typename PostgreCachePolicy>
+auto PostgreCache<PostgreCachePolicy>::ParseRows(
+    const storages::postgres::ResultSet& res,
+    cache::UpdateStatisticsScope& stats_scope) -> std::vector<ValueType> {
+  namespace pg = storages::postgres;
+  std::vector<RawValueType> raw_values;
+  try {
+    raw_values = res.AsContainer<std::vector<RawValueType>>(pg::kRowTag);
+  } catch (const std::exception&) {
+    // Decoding row by row to skip and account only the broken rows
+    raw_values.clear();
+    raw_values.reserve(res.Size());
+    const auto typed_res = res.AsSetOf<RawValueType>(pg::kRowTag);
+    for (auto p = typed_res.begin(); p != typed_res.end(); ++p) {
+      try {
+        raw_values.push_back(*p);
+      } catch (const std::exception& e) {
+        AccountParseFailure(stats_scope, e);
+      }
+    }
+  }
+
+  if constexpr (pg_cache::detail::kHasRawValueType<PostgreCachePolicy>) {
+    std::vector<ValueType> values;
+    values.reserve(raw_values.size());
+    for (auto& raw_value : raw_values) {
+      try {
+        values.push_back(pg_cache::detail::ExtractValue<PostgreCachePolicy>(
+            std::move(raw_value)));
+      } catch (const std::exception& e) {
+        AccountParseFailure(stats_scope, e);
+      }
+    }
+    return values;
+  } else {
+    return raw_values;
+  }
+}
+
+template <typename PostgreCachePolicy>
+void PostgreCache<PostgreCachePolicy>::AccountParseFailure(
+    cache::UpdateStatisticsScope& stats_scope, const std::exception& e) {
+  stats_scope.IncreaseDocumentsParseFailures(1);
+  LOG_ERROR() << "Error parsing data row in cache '" << kName << "' to '"
+              << compiler::GetTypeName<ValueType>() << "': " << e.what();
+}
+
 template <typename PostgreCachePolicy>
 typename PostgreCache<PostgreCachePolicy>::CachedData
 PostgreCache<PostgreCachePolicy>::GetDataSnapshot(cache::UpdateType type,
@@ -0,0 +1,193 @@
+#pragma once
+
+/// @file userver/storages/postgres/copy.hpp
+/// @brief Streaming bulk load and export with COPY
+
+#include <cstddef>
+#include <string>
+#include <string_view>
+#include <tuple>
+#include <utility>
+#include <vector>
+
+#include <userver/storages/postgres/exceptions.hpp>
+#include <userver/storages/postgres/io/field_buffer.hpp>
+#include <userver/storages/postgres/io/row_types.hpp>
+#include <userver/storages/postgres/io/user_types.hpp>
+#include <userver/storages/postgres/options.hpp>
+#include <userver/storages/postgres/postgres_fwd.hpp>
+#include <userver/storages/postgres/query.hpp>
+
+USERVER_NAMESPACE_BEGIN
+
+namespace storages::postgres {
+
+/// @brief Writes rows into a table with `COPY ... FROM STDIN` in binary
+/// format.
+///
+/// Values are encoded with the same formatters as query parameters, so any
+/// type that can be passed to Transaction::Execute can be copied. Rows are
+/// accumulated in a buffer that is sent to the server once it grows above
+/// kBufferSize; sending suspends the coroutine until the data is written to the
+/// socket, so a slow server throttles the producer.
+///
+/// The connection can't be used for anything else until Finish() is called.
+/// If the stream is destroyed without Finish(), the copy is aborted and the
+/// transaction fails.
+///
+/// @code
+/// auto trx = cluster->Begin({});
+/// auto copy = trx.CopyIn("foobar", {"foo", "bar"});
+/// for (const auto& [foo, bar] : data) {
+///   copy.WriteRow(foo, bar);
+/// }
+/// const auto rows_copied = copy.Finish();
+/// trx.Commit();
+/// @endcode
+class CopyInStream {
+ public:
+  static constexpr std::size_t kBufferSize = 64 * 1024;
+
+  /// @cond
+  CopyInStream(detail::Connection* conn, std::string_view table,
+               const std::vector<std::string>& columns,
+               OptionalCommandControl cmd_ctl);
+  /// @endcond
+
+  CopyInStream(CopyInStream&&) noexcept;
+  CopyInStream& operator=(CopyInStream&&) = delete;
+  ~CopyInStream();
+
+  /// Writes a row, the number of values must match the number of columns
+  template <typename... Columns>
+  void WriteRow(const Columns&... columns);
+
+  /// Writes rows of a container, the rows must be of a row type (a tuple,
+  /// an aggregate or a class with Introspect method)
+  template <typename Container>
+  void WriteRows(const Container& rows);
+
+  /// Sends the buffered rows and completes the copy.
+  /// @returns the number of rows copied
+  std::size_t Finish();
+
+ private:
+  void WriteRowHeader(std::size_t columns_count);
+  void SendBufferIfFull();
+
+  detail::Connection* conn_;
+  OptionalCommandControl cmd_ctl_;
+  const UserTypes* types_;
+  std::string buffer_;
+};
+
+/// @brief Reads rows of a query with `COPY (...) TO STDOUT` in binary format.
+///
+/// Values are decoded with the same parsers as result set fields. The rows are
+/// read from the socket one by one as they are requested.
+///
+/// The connection can't be used for anything else until all the rows are read.
+/// If the stream is destroyed before that, the query is cancelled.
+///
+/// @code
+/// auto trx = cluster->Begin({});
+/// auto copy = trx.CopyOut("SELECT foo, bar FROM foobar");
+/// int foo{};
+/// std::string bar;
+/// while (copy.ReadRow(foo, bar)) {
+///   Process(foo, bar);
+/// }
+/// trx.Commit();
+/// @endcode
+class CopyOutStream {
+ public:
+  /// @cond
+  CopyOutStream(detail::Connection* conn, const Query& query,
+                OptionalCommandControl cmd_ctl);
+  /// @endcond
+
+  CopyOutStream(CopyOutStream&&) noexcept;
+  CopyOutStream& operator=(CopyOutStream&&) = delete;
+  ~CopyOutStream();
+
+  /// Reads the next row into the values, the number of values must match the
+  /// number of the query columns.
+  /// @returns false if there are no more rows
+  template <typename... Fields>
+  bool ReadRow(Fields&... fields);
+
+  /// Reads the next row into a row type (a tuple, an aggregate or a class
+  /// with Introspect method).
+  /// @returns false if there are no more rows
+  template <typename Row>
+  bool ReadRow(Row& row, RowTag);
+
+  /// @returns the number of rows read so far
+  std::size_t RowsRead() const { return rows_read_; }
+
+ private:
+  // Returns false if there are no more rows, otherwise `row_` points to the
+  // first field of the next row
+  bool FetchRow(std::size_t fields_count);
+
+  template <typename T>
+  void ReadField(T& value);
+
+  void CheckRowConsumed() const;
+
+  detail::Connection* conn_;
+  OptionalCommandControl cmd_ctl_;
+  const io::TypeBufferCategory* categories_;
+  std::string message_;
+  io::FieldBuffer row_;
+  std::size_t rows_read_{0};
+  bool header_read_{false};
+  bool done_{false};
+};
+
+template <typename... Columns>
+void CopyInStream::WriteRow(const Columns&... columns) {
+  static_assert(sizeof...(Columns) > 0, "A row must have at least one column");
+  WriteRowHeader(sizeof...(Columns));
+  (io::WriteRawBinary(*types_, buffer_, columns), ...);
+  SendBufferIfFull();
+}
+
+template <typename Container>
+void CopyInStream::WriteRows(const Container& rows) {
+  using Row = typename Container::value_type;
+  static_assert(io::traits::kIsRowType<Row>,
+                "Container elements must be of a row type");
+  for (const auto& row : rows) {
+    std::apply([this](const auto&... columns) { WriteRow(columns...); },
+               io::RowType<Row>::GetTuple(row));
+  }
+}
+
+template <typename... Fields>
+bool CopyOutStream::ReadRow(Fields&... fields) {
+  static_assert(sizeof...(Fields) > 0, "A row must have at least one field");
+  if (!FetchRow(sizeof...(Fields))) return false;
+  (ReadField(fields), ...);
+  CheckRowConsumed();
+  return true;
+}
+
+template <typename Row>
+bool CopyOutStream::ReadRow(Row& row, RowTag) {
+  static_assert(io::traits::kIsRowType<Row>, "Row must be of a row type");
+  auto tuple = io::RowType<Row>::GetTuple(row);
+  return std::apply([this](auto&... fields) { return ReadRow(fields...); },
+                    tuple);
+}
+
+template <typename T>
+void CopyOutStream::ReadField(T& value) {
+  // Field types are not sent with COPY data, assume the requested one
+  row_.category = io::traits::kTypeBufferCategory<T>;
+  row_.ReadRaw(value, *categories_);
+}
+
+}  // namespace storages::postgres
+
+USERVER_NAMESPACE_END
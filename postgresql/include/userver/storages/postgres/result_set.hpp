@@ -3,6 +3,8 @@
 /// @file userver/storages/postgres/result_set.hpp
 /// @brief Result accessors
 
+#include <algorithm>
+#include <array>
 #include <initializer_list>
 #include <limits>
 #include <memory>
@@ -22,6 +24,7 @@
 
 #include <userver/compiler/demangle.hpp>
 #include <userver/logging/log.hpp>
+#include <userver/utils/function_ref.hpp>
 
 USERVER_NAMESPACE_BEGIN
 
@@ -235,13 +238,21 @@ class FieldView final {
 
   template <typename T>
   size_type To(T&& val) const {
+    return ReadFromBuffer(GetBuffer(), std::forward<T>(val));
+  }
+
+ private:
+  friend class ResultSet;
+
+  /// Reads the field from the buffer that was obtained beforehand, see
+  /// ResultSet::ReadColumn
+  template <typename T>
+  size_type ReadFromBuffer(const io::FieldBuffer& fb, T&& val) const {
     using ValueType = typename std::decay<T>::type;
-    auto fb = GetBuffer();
     return ReadNullable(fb, std::forward<T>(val),
                         io::traits::IsNullable<ValueType>{});
   }
 
- private:
   io::FieldBuffer GetBuffer() const;
   std::string_view Name() const;
   const io::TypeBufferCategory& GetTypeBufferCategories() const;
@@ -686,11 +697,28 @@ class ResultSet {
 
   /// @brief Extract data into a container.
   /// For more information see @ref psql_typed_results
+  ///
+  /// The data is decoded column by column in chunks of rows, the checks of
+  /// the field formats and types are done once per column and not for each
+  /// field.
   template <typename Container>
   Container AsContainer() const;
   template <typename Container>
   Container AsContainer(RowTag) const;
 
+  /// @brief Extract data into a container, decoding ranges of rows in
+  /// parallel tasks of the current task processor.
+  ///
+  /// Worth using for result sets of hundreds of thousands of rows, e.g. for
+  /// full updates of caches. Small result sets are decoded in the current
+  /// task.
+  /// @param max_tasks maximum number of tasks to use, including the current
+  /// one
+  template <typename Container>
+  Container AsContainerParallel(std::size_t max_tasks) const;
+  template <typename Container>
+  Container AsContainerParallel(std::size_t max_tasks, RowTag) const;
+
   /// @brief Extract first row into user type.
   /// A single row result set is expected, will throw an exception when result
   /// set size != 1
@@ -717,6 +745,34 @@ class ResultSet {
   void FillBufferCategories(const UserTypes& types);
   void SetBufferCategoriesFrom(const ResultSet&);
 
+  template <typename Container, typename ExtractionTag>
+  Container DoAsContainer(std::size_t max_tasks) const;
+
+  template <typename T, typename ExtractionTag>
+  void CheckColumnsFor() const;
+
+  template <typename T, typename ExtractionTag>
+  void ReadRows(size_type row_begin, size_type row_end, T* values) const;
+
+  template <typename T, std::size_t... Indexes>
+  void ReadColumns(size_type row_begin, size_type count,
+                   io::FieldBuffer* buffers, T* values,
+                   std::index_sequence<Indexes...>) const;
+
+  template <typename GetValue>
+  void ReadColumn(size_type column, size_type row_begin, size_type count,
+                  io::FieldBuffer* buffers, const GetValue& get_value) const;
+
+  void FillColumnBuffers(size_type column, size_type row_begin,
+                         size_type count, io::FieldBuffer* buffers) const;
+
+  /// Splits [0, Size()) into at most `max_tasks` ranges and calls
+  /// `read_rows` for each of them in a separate task
+  void ForEachRowRange(
+      std::size_t max_tasks,
+      USERVER_NAMESPACE::utils::function_ref<void(size_type, size_type)>
+          read_rows) const;
+
   template <typename T, typename Tag>
   friend class TypedResultSet;
   friend class ConnectionImpl;
@@ -726,6 +782,10 @@ class ResultSet {
 
 namespace detail {
 
+/// Number of rows whose fields are fetched from the result set at once when
+/// decoding it column by column
+inline constexpr std::size_t kColumnarChunkRows = 256;
+
 template <typename T>
 struct IsOptionalFromOptional : std::false_type {};
 
@@ -978,40 +1038,139 @@ auto ResultSet::AsSetOf(FieldTag) const {
 
 template <typename Container>
 Container ResultSet::AsContainer() const {
-  detail::AssertSaneTypeToDeserialize<Container>();
-  using ValueType = typename Container::value_type;
-  Container c;
-  if constexpr (io::traits::kCanReserve<Container>) {
-    c.reserve(Size());
-  }
-  auto res = AsSetOf<ValueType>();
+  return DoAsContainer<Container, FieldTag>(1);
+}
 
-  auto inserter = io::traits::Inserter(c);
-  auto row_it = res.begin();
-  for (std::size_t i = 0; i < res.Size(); ++i, ++row_it, ++inserter) {
-    *inserter = *row_it;
-  }
+template <typename Container>
+Container ResultSet::AsContainer(RowTag) const {
+  return DoAsContainer<Container, RowTag>(1);
+}
 
-  return c;
+template <typename Container>
+Container ResultSet::AsContainerParallel(std::size_t max_tasks) const {
+  return DoAsContainer<Container, FieldTag>(max_tasks);
 }
 
 template <typename Container>
-Container ResultSet::AsContainer(RowTag) const {
+Container ResultSet::AsContainerParallel(std::size_t max_tasks,
+                                         RowTag) const {
+  return DoAsContainer<Container, RowTag>(max_tasks);
+}
+
+template <typename Container, typename ExtractionTag>
+Container ResultSet::DoAsContainer(std::size_t max_tasks) const {
   detail::AssertSaneTypeToDeserialize<Container>();
   using ValueType = typename Container::value_type;
-  Container c;
-  if constexpr (io::traits::kCanReserve<Container>) {
-    c.reserve(Size());
+  CheckColumnsFor<ValueType, ExtractionTag>();
+
+  const auto read_rows_into = [this](ValueType* values) {
+    return [this, values](size_type row_begin, size_type row_end) {
+      ReadRows<ValueType, ExtractionTag>(row_begin, row_end,
+                                         values + row_begin);
+    };
+  };
+
+  if constexpr (std::is_same_v<Container, std::vector<ValueType>> &&
+                !std::is_same_v<ValueType, bool>) {
+    Container c(Size());
+    ForEachRowRange(max_tasks, read_rows_into(c.data()));
+    return c;
+  } else {
+    Container c;
+    if constexpr (io::traits::kCanReserve<Container>) {
+      c.reserve(Size());
+    }
+    auto inserter = io::traits::Inserter(c);
+
+    // Rows are decoded into a temporary buffer that is moved into the
+    // container, the whole result set at once if decoded in parallel
+    const auto batch_size =
+        max_tasks > 1 ? Size() : detail::kColumnarChunkRows;
+    for (size_type batch_begin = 0; batch_begin < Size();
+         batch_begin += batch_size) {
+      const auto count = std::min(batch_size, Size() - batch_begin);
+      auto values = std::make_unique<ValueType[]>(count);
+      if (max_tasks > 1) {
+        ForEachRowRange(max_tasks, read_rows_into(values.get()));
+      } else {
+        ReadRows<ValueType, ExtractionTag>(batch_begin, batch_begin + count,
+                                           values.get());
+      }
+      for (size_type i = 0; i < count; ++i, ++inserter) {
+        *inserter = std::move(values[i]);
+      }
+    }
+    return c;
   }
-  auto res = AsSetOf<ValueType>(kRowTag);
+}
 
-  auto inserter = io::traits::Inserter(c);
-  auto row_it = res.begin();
-  for (std::size_t i = 0; i < res.Size(); ++i, ++row_it, ++inserter) {
-    *inserter = *row_it;
+template <typename T, typename ExtractionTag>
+void ResultSet::CheckColumnsFor() const {
+  detail::AssertSaneTypeToDeserialize<T>();
+  if constexpr (std::is_same_v<ExtractionTag, RowTag>) {
+    io::traits::AssertIsValidRowType<T>();
+    constexpr auto tuple_size = io::RowType<T>::size;
+    // Same checks as in Row::To(T&&, RowTag), but once per result set
+    if (IsEmpty()) return;
+    if (tuple_size > FieldCount()) {
+      throw InvalidTupleSizeRequested(FieldCount(), tuple_size);
+    } else if (tuple_size < FieldCount()) {
+      LOG_LIMITED_WARNING()
+          << "Row size is greater that the number of data members in "
+             "C++ user datatype "
+          << compiler::GetTypeName<T>();
+    }
+  } else {
+    detail::AssertRowTypeIsMappedToPgOrIsCompositeType<T>();
+    if (FieldCount() > 1) {
+      throw NonSingleColumnResultSet{FieldCount(), compiler::GetTypeName<T>(),
+                                     "AsContainer"};
+    }
+    if (!IsEmpty() && FieldCount() < 1) {
+      throw InvalidTupleSizeRequested{FieldCount(), 1};
+    }
   }
+}
 
-  return c;
+template <typename T, typename ExtractionTag>
+void ResultSet::ReadRows(size_type row_begin, size_type row_end,
+                         T* values) const {
+  std::array<io::FieldBuffer, detail::kColumnarChunkRows> buffers;
+  for (auto chunk_begin = row_begin; chunk_begin < row_end;
+       chunk_begin += buffers.size()) {
+    const auto count = std::min(buffers.size(), row_end - chunk_begin);
+    auto* chunk_values = values + (chunk_begin - row_begin);
+    if constexpr (std::is_same_v<ExtractionTag, RowTag>) {
+      ReadColumns(chunk_begin, count, buffers.data(), chunk_values,
+                  typename io::RowType<T>::IndexSequence{});
+    } else {
+      ReadColumn(0, chunk_begin, count, buffers.data(),
+                 [chunk_values](size_type i) -> T& { return chunk_values[i]; });
+    }
+  }
+}
+
+template <typename T, std::size_t... Indexes>
+void ResultSet::ReadColumns(size_type row_begin, size_type count,
+                            io::FieldBuffer* buffers, T* values,
+                            std::index_sequence<Indexes...>) const {
+  using RowType = io::RowType<T>;
+  (ReadColumn(Indexes, row_begin, count, buffers,
+              [values](size_type i) -> decltype(auto) {
+                return std::get<Indexes>(RowType::GetTuple(values[i]));
+              }),
+   ...);
+}
+
+template <typename GetValue>
+void ResultSet::ReadColumn(size_type column, size_type row_begin,
+                           size_type count, io::FieldBuffer* buffers,
+                           const GetValue& get_value) const {
+  FillColumnBuffers(column, row_begin, count, buffers);
+  for (size_type i = 0; i < count; ++i) {
+    FieldView{*pimpl_, row_begin + i, column}.ReadFromBuffer(buffers[i],
+                                                             get_value(i));
+  }
 }
 
 template <typename T>
@@ -1,9 +1,39 @@
 #include <userver/cache/base_postgres_cache.hpp>
 
+#include <userver/utils/assert.hpp>
 #include <userver/yaml_config/merge_schemas.hpp>
 
 USERVER_NAMESPACE_BEGIN
 
+namespace components::pg_cache::detail {
+
+std::vector<KeyRange> SplitKeyRange(std::int64_t min_key, std::int64_t max_key,
+                                    std::size_t count) {
+  UASSERT(min_key <= max_key);
+  UASSERT(count > 0);
+
+  // Unsigned arithmetic does not overflow for the whole int64 range
+  const auto span = static_cast<std::uint64_t>(max_key) -
+                    static_cast<std::uint64_t>(min_key);
+  const auto step = span / count + 1;
+
+  std::vector<KeyRange> ranges;
+  ranges.reserve(count);
+  auto begin = min_key;
+  while (static_cast<std::uint64_t>(max_key) -
+             static_cast<std::uint64_t>(begin) >=
+         step) {
+    const auto end =
+        static_cast<std::int64_t>(static_cast<std::uint64_t>(begin) + step - 1);
+    ranges.emplace_back(begin, end);
+    begin = end + 1;
+  }
+  ranges.emplace_back(begin, max_key);
+  return ranges;
+}
+
+}  // namespace components::pg_cache::detail
+
 namespace components::impl {
 
 std::string GetPostgreCacheSchema() {
@@ -28,6 +58,11 @@ properties:
         type: integer
         description: number of rows to request from PostgreSQL, 0 to fetch all rows in one request
         defaultDescription: 1000
+    full-update-parallelism:
+        type: integer
+        description: number of key ranges of a full update that are fetched and parsed concurrently, requires kRangeKeyField in the cache policy; the ranges are separate non-transactional queries, so the full update is not a consistent snapshot of the table
+        defaultDescription: 1
+        minimum: 1
     pgcomponent:
         type: string
         description: PostgreSQL component name
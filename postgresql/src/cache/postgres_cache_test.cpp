@@ -2,9 +2,14 @@
 
 #include <userver/cache/base_postgres_cache.hpp>
 
+#include <cstdint>
+#include <limits>
+#include <vector>
+
 #include <boost/functional/hash.hpp>
 
 #include <userver/components/minimal_server_component_list.hpp>
+#include <userver/utest/utest.hpp>
 #include <userver/utils/projected_set.hpp>
 
 USERVER_NAMESPACE_BEGIN
@@ -295,6 +300,24 @@ struct PostgresExamplePolicy7 {
   using CacheContainer = utils::ProjectedUnorderedSet<ValueType, kKeyMember>;
 };
 
+/*! [Pg Cache Policy Parallel Full Update Example] */
+struct PostgresExamplePolicy8 {
+  static constexpr std::string_view kName = "my-pg-cache";
+  using ValueType = MyStructure;
+  static constexpr auto kKeyMember = &MyStructure::id;
+  static constexpr const char* kQuery =
+      "select id, bar, updated from test.my_data";
+  static constexpr const char* kUpdatedField = "updated";
+  using UpdatedFieldType = storages::postgres::TimePointTz;
+
+  // Integer column of the query to split full updates into ranges
+  static constexpr const char* kRangeKeyField = "id";
+};
+/*! [Pg Cache Policy Parallel Full Update Example] */
+
+static_assert(pg_cache::detail::kHasRangeKeyField<PostgresExamplePolicy8>);
+static_assert(!pg_cache::detail::kHasRangeKeyField<PostgresExamplePolicy>);
+
 // Instantiation test
 using MyCache1 = PostgreCache<PostgresExamplePolicy>;
 using MyCache2 = PostgreCache<PostgresExamplePolicy2>;
@@ -304,6 +327,7 @@ using MyTrivialCache = PostgreCache<PostgresTrivialPolicy>;
 using MyCache5 = PostgreCache<PostgresExamplePolicy5>;
 using MyCache6 = PostgreCache<PostgresExamplePolicy6>;
 using MyCache7 = PostgreCache<PostgresExamplePolicy7>;
+using MyCache8 = PostgreCache<PostgresExamplePolicy8>;
 
 // NB: field access required for actual instantiation
 static_assert(MyCache1::kIncrementalUpdates);
@@ -313,6 +337,7 @@ static_assert(MyCache4::kIncrementalUpdates);
 static_assert(MyCache5::kIncrementalUpdates);
 static_assert(MyCache6::kIncrementalUpdates);
 static_assert(MyCache7::kIncrementalUpdates);
+static_assert(MyCache8::kIncrementalUpdates);
 
 namespace pg = storages::postgres;
 static_assert(MyCache1::kClusterHostTypeFlags == pg::ClusterHostType::kSlave);
@@ -322,6 +347,7 @@ static_assert(MyCache4::kClusterHostTypeFlags == pg::ClusterHostType::kSlave);
 static_assert(MyCache5::kClusterHostTypeFlags == pg::ClusterHostType::kSlave);
 static_assert(MyCache6::kClusterHostTypeFlags == pg::ClusterHostType::kSlave);
 static_assert(MyCache7::kClusterHostTypeFlags == pg::ClusterHostType::kSlave);
+static_assert(MyCache8::kClusterHostTypeFlags == pg::ClusterHostType::kSlave);
 
 // Update() instantiation test
 [[maybe_unused]] void VerifyUpdateCompiles(
@@ -335,6 +361,7 @@ static_assert(MyCache7::kClusterHostTypeFlags == pg::ClusterHostType::kSlave);
   MyCache5 cache5{config, context};
   MyCache6 cache6{config, context};
   MyCache7 cache7{config, context};
+  MyCache8 cache8{config, context};
 }
 
 inline auto SampleOfComponentRegistration() {
@@ -346,4 +373,30 @@ inline auto SampleOfComponentRegistration() {
 
 }  // namespace components::example
 
+namespace components::pg_cache::detail {
+
+TEST(PostgreCacheSplitKeyRange, Basic) {
+  using Ranges = std::vector<KeyRange>;
+  EXPECT_EQ(SplitKeyRange(1, 1, 4), (Ranges{{1, 1}}));
+  EXPECT_EQ(SplitKeyRange(1, 3, 4), (Ranges{{1, 1}, {2, 2}, {3, 3}}));
+  EXPECT_EQ(SplitKeyRange(0, 99, 4),
+            (Ranges{{0, 24}, {25, 49}, {50, 74}, {75, 99}}));
+  EXPECT_EQ(SplitKeyRange(-10, 10, 1), (Ranges{{-10, 10}}));
+}
+
+TEST(PostgreCacheSplitKeyRange, WholeRange) {
+  constexpr auto kMin = std::numeric_limits<std::int64_t>::min();
+  constexpr auto kMax = std::numeric_limits<std::int64_t>::max();
+
+  const auto ranges = SplitKeyRange(kMin, kMax, 3);
+  ASSERT_EQ(ranges.size(), 3);
+  EXPECT_EQ(ranges.front().first, kMin);
+  EXPECT_EQ(ranges.back().second, kMax);
+  for (std::size_t i = 1; i < ranges.size(); ++i) {
+    EXPECT_EQ(ranges[i - 1].second + 1, ranges[i].first);
+  }
+}
+
+}  // namespace components::pg_cache::detail
+
 USERVER_NAMESPACE_END
@@ -0,0 +1,175 @@
+#include <userver/storages/postgres/copy.hpp>
+
+#include <algorithm>
+#include <cstring>
+
+#include <storages/postgres/detail/connection.hpp>
+#include <userver/logging/log.hpp>
+#include <userver/utils/assert.hpp>
+
+USERVER_NAMESPACE_BEGIN
+
+namespace storages::postgres {
+
+namespace {
+
+// See https://www.postgresql.org/docs/current/sql-copy.html#id-1.9.3.55.9.4
+constexpr std::string_view kBinarySignature{"PGCOPY\n\377\r\n\0", 11};
+constexpr Integer kBinaryFlags = 0;
+constexpr Integer kBinaryHeaderExtensionLength = 0;
+constexpr Smallint kBinaryTrailer = -1;
+
+template <typename T>
+T ReadHeaderValue(io::FieldBuffer& buffer) {
+  T value{};
+  buffer.Read(value, io::BufferCategory::kPlainBuffer);
+  return value;
+}
+
+}  // namespace
+
+CopyInStream::CopyInStream(detail::Connection* conn, std::string_view table,
+                           const std::vector<std::string>& columns,
+                           OptionalCommandControl cmd_ctl)
+    : conn_{conn}, cmd_ctl_{std::move(cmd_ctl)} {
+  UASSERT(conn_);
+  types_ = &conn_->GetUserTypes();
+  conn_->CopyInStart(table, columns, cmd_ctl_);
+
+  buffer_.reserve(kBufferSize + kBufferSize / 4);
+  buffer_.append(kBinarySignature);
+  io::WriteBuffer(*types_, buffer_, kBinaryFlags);
+  io::WriteBuffer(*types_, buffer_, kBinaryHeaderExtensionLength);
+}
+
+CopyInStream::CopyInStream(CopyInStream&& other) noexcept
+    : conn_{std::exchange(other.conn_, nullptr)},
+      cmd_ctl_{std::move(other.cmd_ctl_)},
+      types_{other.types_},
+      buffer_{std::move(other.buffer_)} {}
+
+CopyInStream::~CopyInStream() {
+  if (!conn_) return;
+  try {
+    conn_->CopyInEnd("COPY aborted by the client", cmd_ctl_);
+  } catch (const std::exception& e) {
+    // The server always responds to an aborted copy with an error
+    LOG_DEBUG() << "COPY aborted: " << e;
+  }
+}
+
+std::size_t CopyInStream::Finish() {
+  if (!conn_) {
+    throw LogicError{"COPY is already finished"};
+  }
+  io::WriteBuffer(*types_, buffer_, kBinaryTrailer);
+  conn_->CopyInPutData(buffer_, cmd_ctl_);
+  buffer_.clear();
+  // The copy is over after this call, even if it throws
+  return std::exchange(conn_, nullptr)->CopyInEnd(nullptr, cmd_ctl_);
+}
+
+void CopyInStream::WriteRowHeader(std::size_t columns_count) {
+  if (!conn_) {
+    throw LogicError{"Attempt to write a row to a finished COPY"};
+  }
+  io::WriteBuffer(*types_, buffer_, static_cast<Smallint>(columns_count));
+}
+
+void CopyInStream::SendBufferIfFull() {
+  if (buffer_.size() < kBufferSize) return;
+  conn_->CopyInPutData(buffer_, cmd_ctl_);
+  buffer_.clear();
+}
+
+CopyOutStream::CopyOutStream(detail::Connection* conn, const Query& query,
+                             OptionalCommandControl cmd_ctl)
+    : conn_{conn}, cmd_ctl_{std::move(cmd_ctl)} {
+  UASSERT(conn_);
+  if (!cmd_ctl_) {
+    cmd_ctl_ = conn_->GetQueryCmdCtl(query.GetName());
+  }
+  categories_ = &conn_->GetUserTypes().GetTypeBufferCategories();
+  conn_->CopyOutStart(query, cmd_ctl_);
+}
+
+CopyOutStream::CopyOutStream(CopyOutStream&& other) noexcept
+    : conn_{std::exchange(other.conn_, nullptr)},
+      cmd_ctl_{std::move(other.cmd_ctl_)},
+      categories_{other.categories_},
+      message_{std::move(other.message_)},
+      row_{other.row_},
+      rows_read_{other.rows_read_},
+      header_read_{other.header_read_},
+      done_{other.done_} {
+  // row_ points to the tail of message_, which may be relocated by the move
+  if (row_.buffer) {
+    row_.buffer = reinterpret_cast<const std::uint8_t*>(message_.data()) +
+                  (message_.size() - row_.length);
+  }
+}
+
+CopyOutStream::~CopyOutStream() {
+  if (!conn_ || done_) return;
+  try {
+    conn_->CopyOutCancel(cmd_ctl_);
+  } catch (const std::exception& e) {
+    LOG_LIMITED_WARNING() << "Failed to cancel COPY: " << e;
+    conn_->MarkAsBroken();
+  }
+}
+
+bool CopyOutStream::FetchRow(std::size_t fields_count) {
+  if (done_) return false;
+  if (!conn_) {
+    throw LogicError{"Attempt to read a row from a moved-out COPY"};
+  }
+
+  if (!conn_->CopyOutGetData(message_, cmd_ctl_)) {
+    done_ = true;
+    return false;
+  }
+  row_ = io::FieldBuffer{false, io::BufferCategory::kPlainBuffer,
+                         message_.size(),
+                         reinterpret_cast<const std::uint8_t*>(message_.data())};
+
+  if (!header_read_) {
+    // The header is sent along with the first row
+    if (row_.length < kBinarySignature.size() ||
+        std::memcmp(row_.buffer, kBinarySignature.data(),
+                    kBinarySignature.size()) != 0) {
+      throw InvalidBinaryBuffer{"Invalid COPY binary signature"};
+    }
+    row_ = row_.GetSubBuffer(kBinarySignature.size());
+    ReadHeaderValue<Integer>(row_);
+    const auto extension_length = ReadHeaderValue<Integer>(row_);
+    if (extension_length < 0) {
+      throw InvalidBinaryBuffer{"Invalid COPY header extension length"};
+    }
+    row_ = row_.GetSubBuffer(extension_length);
+    header_read_ = true;
+  }
+
+  const auto row_fields = ReadHeaderValue<Smallint>(row_);
+  if (row_fields == kBinaryTrailer) {
+    // The result is collected by the next call
+    return FetchRow(fields_count);
+  }
+  if (row_fields < 0 || static_cast<std::size_t>(row_fields) != fields_count) {
+    throw InvalidTupleSizeRequested{
+        static_cast<std::size_t>(std::max<Smallint>(row_fields, 0)),
+        fields_count};
+  }
+  ++rows_read_;
+  return true;
+}
+
+void CopyOutStream::CheckRowConsumed() const {
+  if (row_.length != 0) {
+    throw InvalidBinaryBuffer{"COPY row has trailing data"};
+  }
+}
+
+}  // namespace storages::postgres
+
+USERVER_NAMESPACE_END
@@ -0,0 +1,130 @@
+#include <benchmark/benchmark.h>
+
+#include <string>
+#include <vector>
+
+#include <storages/postgres/detail/connection.hpp>
+#include <userver/storages/postgres/copy.hpp>
+#include <userver/storages/postgres/io/array_types.hpp>
+
+#include <storages/postgres/util_benchmark.hpp>
+
+USERVER_NAMESPACE_BEGIN
+
+namespace {
+
+namespace pg = storages::postgres;
+using namespace pg::bench;
+
+struct BenchRow {
+  int id{};
+  std::string name;
+};
+
+std::vector<BenchRow> MakeRows(std::size_t count) {
+  std::vector<BenchRow> rows;
+  rows.reserve(count);
+  for (std::size_t i = 0; i < count; ++i) {
+    rows.push_back({static_cast<int>(i), "name " + std::to_string(i)});
+  }
+  return rows;
+}
+
+void PrepareTable(pg::detail::Connection& conn) {
+  conn.Execute(
+      "create temp table if not exists copy_bench(id integer, name text)");
+  conn.Execute("truncate copy_bench");
+}
+
+}  // namespace
+
+BENCHMARK_DEFINE_F(PgConnection, CopyIn)(benchmark::State& state) {
+  RunStandalone(state, [this, &state] {
+    const auto rows = MakeRows(state.range(0));
+    PrepareTable(GetConnection());
+    for (auto _ : state) {
+      pg::CopyInStream copy{&GetConnection(), "copy_bench", {"id", "name"}, {}};
+      copy.WriteRows(rows);
+      benchmark::DoNotOptimize(copy.Finish());
+
+      state.PauseTiming();
+      GetConnection().Execute("truncate copy_bench");
+      state.ResumeTiming();
+    }
+    state.SetItemsProcessed(state.iterations() * rows.size());
+  });
+}
+BENCHMARK_REGISTER_F(PgConnection, CopyIn)
+    ->RangeMultiplier(10)
+    ->Range(10, 100000);
+
+BENCHMARK_DEFINE_F(PgConnection, InsertUnnest)(benchmark::State& state) {
+  RunStandalone(state, [this, &state] {
+    const auto rows = MakeRows(state.range(0));
+    std::vector<int> ids;
+    std::vector<std::string> names;
+    for (const auto& row : rows) {
+      ids.push_back(row.id);
+      names.push_back(row.name);
+    }
+    PrepareTable(GetConnection());
+    for (auto _ : state) {
+      auto res = GetConnection().Execute(
+          "insert into copy_bench(id, name) "
+          "select * from unnest($1::integer[], $2::text[])",
+          ids, names);
+      benchmark::DoNotOptimize(res.RowsAffected());
+
+      state.PauseTiming();
+      GetConnection().Execute("truncate copy_bench");
+      state.ResumeTiming();
+    }
+    state.SetItemsProcessed(state.iterations() * rows.size());
+  });
+}
+BENCHMARK_REGISTER_F(PgConnection, InsertUnnest)
+    ->RangeMultiplier(10)
+    ->Range(10, 100000);
+
+BENCHMARK_DEFINE_F(PgConnection, CopyOut)(benchmark::State& state) {
+  RunStandalone(state, [this, &state] {
+    const auto count = state.range(0);
+    for (auto _ : state) {
+      pg::CopyOutStream copy{
+          &GetConnection(),
+          "select i, 'name ' || i::text from generate_series(1, " +
+              std::to_string(count) + ") i",
+          {}};
+      BenchRow row;
+      while (copy.ReadRow(row.id, row.name)) {
+        benchmark::DoNotOptimize(row);
+      }
+    }
+    state.SetItemsProcessed(state.iterations() * count);
+  });
+}
+BENCHMARK_REGISTER_F(PgConnection, CopyOut)
+    ->RangeMultiplier(10)
+    ->Range(10, 100000);
+
+BENCHMARK_DEFINE_F(PgConnection, SelectResultSet)(benchmark::State& state) {
+  RunStandalone(state, [this, &state] {
+    const auto count = state.range(0);
+    for (auto _ : state) {
+      auto res = GetConnection().Execute(
+          "select i, 'name ' || i::text from generate_series(1, $1) i",
+          static_cast<int>(count));
+      for (const auto& db_row : res) {
+        BenchRow row;
+        db_row.To(row.id, row.name);
+        benchmark::DoNotOptimize(row);
+      }
+    }
+    state.SetItemsProcessed(state.iterations() * count);
+  });
+}
+BENCHMARK_REGISTER_F(PgConnection, SelectResultSet)
+    ->RangeMultiplier(10)
+    ->Range(10, 100000);
+
+USERVER_NAMESPACE_END
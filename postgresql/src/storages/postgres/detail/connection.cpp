@@ -167,6 +167,36 @@ ResultSet Connection::PortalExecute(StatementId statement_id,
                                std::move(statement_cmd_ctl));
 }
 
+void Connection::CopyInStart(std::string_view table,
+                             const std::vector<std::string>& columns,
+                             OptionalCommandControl statement_cmd_ctl) {
+  pimpl_->CopyInStart(table, columns, std::move(statement_cmd_ctl));
+}
+
+void Connection::CopyInPutData(std::string_view data,
+                               OptionalCommandControl statement_cmd_ctl) {
+  pimpl_->CopyInPutData(data, std::move(statement_cmd_ctl));
+}
+
+std::size_t Connection::CopyInEnd(const char* error_message,
+                                  OptionalCommandControl statement_cmd_ctl) {
+  return pimpl_->CopyInEnd(error_message, std::move(statement_cmd_ctl));
+}
+
+void Connection::CopyOutStart(const Query& query,
+                              OptionalCommandControl statement_cmd_ctl) {
+  pimpl_->CopyOutStart(query, std::move(statement_cmd_ctl));
+}
+
+bool Connection::CopyOutGetData(std::string& data,
+                                OptionalCommandControl statement_cmd_ctl) {
+  return pimpl_->CopyOutGetData(data, std::move(statement_cmd_ctl));
+}
+
+void Connection::CopyOutCancel(OptionalCommandControl statement_cmd_ctl) {
+  pimpl_->CopyOutCancel(std::move(statement_cmd_ctl));
+}
+
 void Connection::CancelAndCleanup(TimeoutDuration timeout) {
   pimpl_->CancelAndCleanup(timeout);
 }
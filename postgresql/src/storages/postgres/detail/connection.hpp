@@ -3,6 +3,8 @@
 #include <atomic>
 #include <chrono>
 #include <string>
+#include <string_view>
+#include <vector>
 
 #include <userver/clients/dns/resolver_fwd.hpp>
 #include <userver/concurrent/background_task_storage_fwd.hpp>
@@ -254,6 +256,26 @@ class Connection {
   ResultSet PortalExecute(StatementId, const std::string& portal_name,
                           std::uint32_t n_rows, OptionalCommandControl);
 
+  /// Start `COPY ... FROM STDIN` in binary format, the connection is in copy
+  /// mode until CopyInEnd is called
+  void CopyInStart(std::string_view table,
+                   const std::vector<std::string>& columns,
+                   OptionalCommandControl);
+  /// Send a chunk of binary COPY data, suspends while the socket is not
+  /// writable
+  void CopyInPutData(std::string_view data, OptionalCommandControl);
+  /// Complete or abort (if `error_message` is not null) the copy,
+  /// returns the number of rows copied
+  std::size_t CopyInEnd(const char* error_message, OptionalCommandControl);
+
+  /// Start `COPY (query) TO STDOUT` in binary format
+  void CopyOutStart(const Query& query, OptionalCommandControl);
+  /// Read the next chunk of binary COPY data, returns false when the copy is
+  /// complete and the connection is out of copy mode
+  bool CopyOutGetData(std::string& data, OptionalCommandControl);
+  /// Cancel the copy and discard the rest of the data
+  void CopyOutCancel(OptionalCommandControl);
+
   /// Send cancel to the database backend
   /// Try to return connection to idle state discarding all results.
   /// If there is a transaction in progress - roll it back.
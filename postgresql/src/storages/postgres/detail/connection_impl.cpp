@@ -34,6 +34,10 @@ constexpr std::string_view kStatementTimeoutParameter = "statement_timeout";
 constexpr std::string_view kStatementVacuum = "vacuum";
 constexpr std::string_view kStatementListen = "listen {}";
 constexpr std::string_view kStatementUnlisten = "unlisten {}";
+constexpr std::string_view kStatementCopyIn =
+    "COPY {} ({}) FROM STDIN (FORMAT binary)";
+constexpr std::string_view kStatementCopyOut =
+    "COPY ({}) TO STDOUT (FORMAT binary)";
 
 const Query kSetConfigQuery{fmt::format("SELECT set_config($1, $2, $3) as {}",
                                         kSetConfigQueryResultName)};
@@ -509,6 +513,152 @@ ResultSet ConnectionImpl::PortalExecute(
                     count_execute, span, scope, &prepared_info->description);
 }
 
+void ConnectionImpl::CopyInStart(std::string_view table,
+                                 const std::vector<std::string>& columns,
+                                 OptionalCommandControl statement_cmd_ctl) {
+  UINVARIANT(!columns.empty(), "COPY requires a non-empty list of columns");
+
+  std::string escaped_table;
+  for (auto part_end = table.find('.');; part_end = table.find('.')) {
+    if (!escaped_table.empty()) escaped_table += '.';
+    escaped_table += conn_wrapper_.EscapeIdentifier(table.substr(0, part_end));
+    if (part_end == std::string_view::npos) break;
+    table.remove_prefix(part_end + 1);
+  }
+
+  std::string escaped_columns;
+  for (const auto& column : columns) {
+    if (!escaped_columns.empty()) escaped_columns += ", ";
+    escaped_columns += conn_wrapper_.EscapeIdentifier(column);
+  }
+
+  CopyStart(fmt::format(kStatementCopyIn, escaped_table, escaped_columns),
+            PGRES_COPY_IN, std::move(statement_cmd_ctl));
+}
+
+void ConnectionImpl::CopyInPutData(std::string_view data,
+                                   OptionalCommandControl statement_cmd_ctl) {
+  UASSERT(!copy_statement_.empty());
+  const auto deadline =
+      testsuite_pg_ctl_.MakeExecuteDeadline(ExecuteTimeout(statement_cmd_ctl));
+  try {
+    conn_wrapper_.PutCopyData(data, deadline);
+  } catch (const ConnectionTimeoutError& e) {
+    ++stats_.execute_timeout;
+    LOG_LIMITED_WARNING() << "Statement `" << copy_statement_
+                          << "` network timeout error: " << e;
+    throw;
+  }
+}
+
+std::size_t ConnectionImpl::CopyInEnd(
+    const char* error_message, OptionalCommandControl statement_cmd_ctl) {
+  UASSERT(!copy_statement_.empty());
+  const auto network_timeout = ExecuteTimeout(statement_cmd_ctl);
+  const auto deadline = testsuite_pg_ctl_.MakeExecuteDeadline(network_timeout);
+  conn_wrapper_.PutCopyEnd(error_message, deadline);
+  return CopyEnd(deadline, network_timeout);
+}
+
+void ConnectionImpl::CopyOutStart(const Query& query,
+                                  OptionalCommandControl statement_cmd_ctl) {
+  CopyStart(fmt::format(kStatementCopyOut, query.Statement()), PGRES_COPY_OUT,
+            std::move(statement_cmd_ctl));
+}
+
+bool ConnectionImpl::CopyOutGetData(std::string& data,
+                                    OptionalCommandControl statement_cmd_ctl) {
+  UASSERT(!copy_statement_.empty());
+  const auto network_timeout = ExecuteTimeout(statement_cmd_ctl);
+  const auto deadline = testsuite_pg_ctl_.MakeExecuteDeadline(network_timeout);
+  try {
+    if (conn_wrapper_.GetCopyData(data, deadline)) return true;
+  } catch (const ConnectionTimeoutError& e) {
+    ++stats_.execute_timeout;
+    LOG_LIMITED_WARNING() << "Statement `" << copy_statement_
+                          << "` network timeout error: " << e;
+    throw;
+  }
+  CopyEnd(deadline, network_timeout);
+  return false;
+}
+
+void ConnectionImpl::CopyOutCancel(OptionalCommandControl statement_cmd_ctl) {
+  UASSERT(!copy_statement_.empty());
+  auto cancel = conn_wrapper_.Cancel();
+  try {
+    std::string data;
+    while (CopyOutGetData(data, statement_cmd_ctl)) {
+      // Discard the rows sent before the cancellation took effect
+    }
+  } catch (const QueryCancelled&) {
+    // Expected
+  }
+  cancel.Wait();
+}
+
+void ConnectionImpl::CopyStart(const std::string& statement,
+                               ExecStatusType copy_status,
+                               OptionalCommandControl statement_cmd_ctl) {
+  CheckBusy();
+  const auto network_timeout = ExecuteTimeout(statement_cmd_ctl);
+  const auto deadline = testsuite_pg_ctl_.MakeExecuteDeadline(network_timeout);
+  SetStatementTimeout(std::move(statement_cmd_ctl));
+
+  tracing::Span span{scopes::kQuery};
+  conn_wrapper_.FillSpanTags(span, {network_timeout, GetStatementTimeout()});
+  span.AddTag(tracing::kDatabaseStatement, statement);
+  CheckDeadlineReached(deadline);
+  auto scope = span.CreateScopeTime();
+
+  try {
+    if (IsPipelineActive()) {
+      // COPY is not allowed in pipeline mode. Collect the results of the
+      // commands sent so far and leave the mode until the copy is done.
+      conn_wrapper_.WaitResult(deadline, scope, nullptr);
+      conn_wrapper_.ExitPipelineMode();
+      is_pipeline_suspended_for_copy_ = true;
+    }
+
+    scope.Reset(scopes::kExec);
+    conn_wrapper_.SendQuery(statement, scope);
+    conn_wrapper_.WaitCopyStart(deadline, scope, copy_status);
+  } catch (const std::exception&) {
+    ++stats_.execute_total;
+    ++stats_.error_execute_total;
+    span.AddTag(tracing::kErrorFlag, true);
+    RestorePipelineAfterCopy();
+    throw;
+  }
+  copy_statement_ = statement;
+}
+
+std::size_t ConnectionImpl::CopyEnd(engine::Deadline deadline,
+                                    TimeoutDuration network_timeout) {
+  const auto statement = std::exchange(copy_statement_, {});
+  const ScopeGuard pipeline_guard{[this] { RestorePipelineAfterCopy(); }};
+
+  tracing::Span span{scopes::kQuery};
+  conn_wrapper_.FillSpanTags(span, {network_timeout, GetStatementTimeout()});
+  span.AddTag(tracing::kDatabaseStatement, statement);
+  auto scope = span.CreateScopeTime();
+  CountExecute count_execute(stats_);
+  return WaitResult(statement, deadline, network_timeout, count_execute, span,
+                    scope, nullptr)
+      .RowsAffected();
+}
+
+void ConnectionImpl::RestorePipelineAfterCopy() noexcept {
+  if (!std::exchange(is_pipeline_suspended_for_copy_, false)) return;
+  try {
+    conn_wrapper_.EnterPipelineMode();
+  } catch (const std::exception& e) {
+    LOG_LIMITED_WARNING() << "Failed to restore pipeline mode after COPY: "
+                          << e;
+    MarkAsBroken();
+  }
+}
+
 void ConnectionImpl::Listen(std::string_view channel,
                             OptionalCommandControl cmd_ctl) {
   ExecuteCommandNoPrepare(
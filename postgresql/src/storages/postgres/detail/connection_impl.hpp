@@ -6,6 +6,7 @@
 #include <string_view>
 #include <unordered_map>
 #include <unordered_set>
+#include <vector>
 
 #include <userver/cache/lru_map.hpp>
 #include <userver/concurrent/background_task_storage_fwd.hpp>
@@ -107,6 +108,20 @@ class ConnectionImpl {
                           const std::string& portal_name, std::uint32_t n_rows,
                           OptionalCommandControl statement_cmd_ctl);
 
+  void CopyInStart(std::string_view table,
+                   const std::vector<std::string>& columns,
+                   OptionalCommandControl statement_cmd_ctl);
+  void CopyInPutData(std::string_view data,
+                     OptionalCommandControl statement_cmd_ctl);
+  std::size_t CopyInEnd(const char* error_message,
+                        OptionalCommandControl statement_cmd_ctl);
+
+  void CopyOutStart(const Query& query,
+                    OptionalCommandControl statement_cmd_ctl);
+  bool CopyOutGetData(std::string& data,
+                      OptionalCommandControl statement_cmd_ctl);
+  void CopyOutCancel(OptionalCommandControl statement_cmd_ctl);
+
   void Listen(std::string_view channel, OptionalCommandControl);
   void Unlisten(std::string_view channel, OptionalCommandControl);
   Notification WaitNotify(engine::Deadline deadline);
@@ -189,6 +204,12 @@ class ConnectionImpl {
                        tracing::Span& span, tracing::ScopeTime& scope,
                        const ResultSet* description_ptr);
 
+  void CopyStart(const std::string& statement, ExecStatusType copy_status,
+                 OptionalCommandControl statement_cmd_ctl);
+  std::size_t CopyEnd(engine::Deadline deadline,
+                      TimeoutDuration network_timeout);
+  void RestorePipelineAfterCopy() noexcept;
+
   void Cancel();
 
   void ReportStatement(const std::string& name);
@@ -203,6 +224,8 @@ class ConnectionImpl {
   bool is_in_recovery_ = true;
   bool is_read_only_ = true;
   bool is_discard_prepared_pending_ = false;
+  bool is_pipeline_suspended_for_copy_ = false;
+  std::string copy_statement_;
   ConnectionSettings settings_;
   std::optional<std::chrono::steady_clock::time_point> expires_at_;
 
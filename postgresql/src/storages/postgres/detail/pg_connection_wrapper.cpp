@@ -561,6 +561,95 @@ ResultSet PGConnectionWrapper::WaitResult(Deadline deadline,
   return MakeResult(std::move(handle));
 }
 
+void PGConnectionWrapper::WaitCopyStart(Deadline deadline,
+                                        tracing::ScopeTime& scope,
+                                        ExecStatusType copy_status) {
+  UASSERT(copy_status == PGRES_COPY_IN || copy_status == PGRES_COPY_OUT);
+  scope.Reset(scopes::kLibpqWaitResult);
+  Flush(deadline);
+  auto handle = MakeResultHandle(ReadResult(deadline, nullptr));
+  const auto status =
+      handle ? PQresultStatus(handle.get()) : PGRES_EMPTY_QUERY;
+  if (status == copy_status) return;
+
+  if (status != PGRES_COPY_IN && status != PGRES_COPY_OUT &&
+      status != PGRES_COPY_BOTH) {
+    // Read the rest of the results, so that the connection is usable after
+    // the exception below
+    while (auto* pg_res = ReadResult(deadline, nullptr)) {
+      MakeResultHandle(pg_res);
+    }
+  }
+  // Throws the server error, if any. The connection is closed if it is stuck
+  // in the copy mode of the other direction.
+  MakeResult(std::move(handle));
+  throw LogicError{"Statement is not a COPY of the expected direction"};
+}
+
+void PGConnectionWrapper::PutCopyData(std::string_view data,
+                                      Deadline deadline) {
+  int put_res = 0;
+  while ((put_res = PQputCopyData(conn_, data.data(), data.size())) == 0) {
+    // libpq output buffer is full
+    Flush(deadline);
+  }
+  if (put_res < 0) {
+    HandleSocketPostClose();
+    throw CommandError(std::string{"PQputCopyData execution error: "} +
+                       PQerrorMessage(conn_));
+  }
+  UpdateLastUse();
+  // Waiting for the data to be sent limits the memory used by libpq buffers
+  // and throttles the producer to the speed of the server
+  Flush(deadline);
+}
+
+void PGConnectionWrapper::PutCopyEnd(const char* error_message,
+                                     Deadline deadline) {
+  int put_res = 0;
+  while ((put_res = PQputCopyEnd(conn_, error_message)) == 0) {
+    Flush(deadline);
+  }
+  if (put_res < 0) {
+    HandleSocketPostClose();
+    throw CommandError(std::string{"PQputCopyEnd execution error: "} +
+                       PQerrorMessage(conn_));
+  }
+  UpdateLastUse();
+}
+
+bool PGConnectionWrapper::GetCopyData(std::string& data, Deadline deadline) {
+  while (true) {
+    char* buffer = nullptr;
+    const auto size = PQgetCopyData(conn_, &buffer, /* async = */ 1);
+    if (size > 0) {
+      const std::unique_ptr<char, decltype(&PQfreemem)> buffer_guard{
+          buffer, &PQfreemem};
+      data.assign(buffer, size);
+      return true;
+    }
+    if (size == -1) return false;
+    if (size < -1) {
+      HandleSocketPostClose();
+      throw CommandError(std::string{"PQgetCopyData execution error: "} +
+                         PQerrorMessage(conn_));
+    }
+
+    // No complete row is available yet
+    if (!WaitSocketReadable(deadline)) {
+      if (engine::current_task::ShouldCancel()) {
+        throw ConnectionInterrupted("Task cancelled while reading copy data");
+      }
+      PGCW_LOG_LIMITED_WARNING()
+          << "Timeout while reading copy data from PostgreSQL connection "
+             "socket";
+      throw ConnectionTimeoutError("Timed out while reading copy data");
+    }
+    CheckError<CommandError>("PQconsumeInput", PQconsumeInput(conn_));
+    UpdateLastUse();
+  }
+}
+
 Notification PGConnectionWrapper::WaitNotify(Deadline deadline) {
   auto notify = std::unique_ptr<PGnotify, decltype(&PQfreemem)>(
       PQnotifies(conn_), &PQfreemem);
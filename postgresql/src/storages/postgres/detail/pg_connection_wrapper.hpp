@@ -106,6 +106,25 @@ class PGConnectionWrapper {
   void SendPortalExecute(const std::string& portal_name, std::uint32_t n_rows,
                          tracing::ScopeTime&);
 
+  /// @brief Wait for the server to switch to COPY IN or COPY OUT mode, which
+  /// is specified by `copy_status`.
+  /// Will throw an exception if the command failed or was not a COPY
+  void WaitCopyStart(Deadline deadline, tracing::ScopeTime&,
+                     ExecStatusType copy_status);
+
+  /// @brief Wrapper for PQputCopyData
+  /// Suspends the coroutine while the data doesn't fit into the socket buffer
+  void PutCopyData(std::string_view data, Deadline deadline);
+
+  /// @brief Wrapper for PQputCopyEnd, the copy is aborted if `error_message`
+  /// is not null. The result of the command must be read with WaitResult
+  void PutCopyEnd(const char* error_message, Deadline deadline);
+
+  /// @brief Wrapper for PQgetCopyData
+  /// Returns false if there is no more data, the result of the command must be
+  /// read with WaitResult then
+  bool GetCopyData(std::string& data, Deadline deadline);
+
   /// @brief Wait for query result
   /// Will return result or throw an exception
   ResultSet WaitResult(Deadline deadline, tracing::ScopeTime&,
@@ -281,15 +281,34 @@ std::size_t ResultWrapper::GetFieldLength(std::size_t row,
 
 io::FieldBuffer ResultWrapper::GetFieldBuffer(std::size_t row,
                                               std::size_t col) const {
+  CheckBinaryFormat(col);
+  return io::FieldBuffer{IsFieldNull(row, col), GetFieldBufferCategory(col),
+                         GetFieldLength(row, col),
+                         reinterpret_cast<const std::uint8_t*>(
+                             PQgetvalue(handle_.get(), row, col))};
+}
+
+void ResultWrapper::GetColumnBuffers(std::size_t col, std::size_t row_begin,
+                                     std::size_t count,
+                                     io::FieldBuffer* buffers) const {
+  CheckBinaryFormat(col);
+  auto* res = handle_.get();
+  const auto category = GetFieldBufferCategory(col);
+  for (std::size_t i = 0; i < count; ++i) {
+    const auto row = row_begin + i;
+    buffers[i] = io::FieldBuffer{
+        PQgetisnull(res, row, col) != 0, category,
+        static_cast<std::size_t>(PQgetlength(res, row, col)),
+        reinterpret_cast<const std::uint8_t*>(PQgetvalue(res, row, col))};
+  }
+}
+
+void ResultWrapper::CheckBinaryFormat(std::size_t col) const {
   if (PQfformat(handle_.get(), col) != io::kPgBinaryDataFormat) {
     throw ResultSetError{
         fmt::format("Column with index {} has text format\n", col) +
         logging::stacktrace_cache::to_string(boost::stacktrace::stacktrace{})};
   }
-  return io::FieldBuffer{IsFieldNull(row, col), GetFieldBufferCategory(col),
-                         GetFieldLength(row, col),
-                         reinterpret_cast<const std::uint8_t*>(
-                             PQgetvalue(handle_.get(), row, col))};
 }
 
 std::string ResultWrapper::GetErrorMessage() const {
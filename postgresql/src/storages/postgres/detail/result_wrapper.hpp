@@ -46,6 +46,10 @@ class ResultWrapper {
   bool IsFieldNull(std::size_t row, std::size_t col) const;
   std::size_t GetFieldLength(std::size_t row, std::size_t col) const;
   io::FieldBuffer GetFieldBuffer(std::size_t row, std::size_t col) const;
+  /// Fills `buffers` with the fields of the column for `count` rows starting
+  /// from `row_begin`, the column format is checked once
+  void GetColumnBuffers(std::size_t col, std::size_t row_begin,
+                        std::size_t count, io::FieldBuffer* buffers) const;
   //@}
 
   //@{
@@ -70,6 +74,9 @@ class ResultWrapper {
   logging::LogExtra GetMessageLogExtra() const;
   //@}
 
+  /// @throws ResultSetError if the column is in text format
+  void CheckBinaryFormat(std::size_t col) const;
+
   ResultHandle handle_;
   io::TypeBufferCategory buffer_categories_;
 
@@ -1,6 +1,8 @@
 #include <userver/storages/postgres/result_set.hpp>
 
+#include <algorithm>
 #include <string_view>
+#include <vector>
 
 #include <fmt/format.h>
 
@@ -9,6 +11,7 @@
 #include <userver/storages/postgres/exceptions.hpp>
 #include <userver/storages/postgres/io/user_types.hpp>
 #include <userver/utils/assert.hpp>
+#include <userver/utils/async.hpp>
 
 USERVER_NAMESPACE_BEGIN
 
@@ -33,6 +36,9 @@ constexpr std::string_view kUnknownTypeErrorMessageTemplate =
     "the type and probably altering a table was run while service up, the only "
     "way to fix this is to restart the service.";
 
+// Decoding smaller ranges of rows in separate tasks costs more than it saves
+constexpr std::size_t kMinRowsPerTask = 4096;
+
 }  // namespace
 
 //----------------------------------------------------------------------------
@@ -244,6 +250,38 @@ ResultSet::reference ResultSet::operator[](size_type index) const& {
   return {pimpl_, index};
 }
 
+void ResultSet::FillColumnBuffers(size_type column, size_type row_begin,
+                                  size_type count,
+                                  io::FieldBuffer* buffers) const {
+  pimpl_->GetColumnBuffers(column, row_begin, count, buffers);
+}
+
+void ResultSet::ForEachRowRange(
+    std::size_t max_tasks,
+    USERVER_NAMESPACE::utils::function_ref<void(size_type, size_type)>
+        read_rows) const {
+  const auto size = Size();
+  const auto tasks_count = std::min(size / kMinRowsPerTask, max_tasks);
+  if (tasks_count <= 1) {
+    read_rows(0, size);
+    return;
+  }
+
+  // The PGresult is never modified after it was received, so the fields
+  // can be read from several threads at once
+  const auto range_size = (size + tasks_count - 1) / tasks_count;
+  std::vector<engine::TaskWithResult<void>> tasks;
+  tasks.reserve(tasks_count - 1);
+  for (auto begin = range_size; begin < size; begin += range_size) {
+    const auto end = std::min(begin + range_size, size);
+    tasks.push_back(USERVER_NAMESPACE::utils::Async(
+        "pg_decode_rows", [read_rows, begin, end] { read_rows(begin, end); }));
+  }
+
+  read_rows(0, range_size);
+  for (auto& task : tasks) task.Get();
+}
+
 void ResultSet::FillBufferCategories(const UserTypes& types) {
   pimpl_->FillBufferCategories(types);
 }
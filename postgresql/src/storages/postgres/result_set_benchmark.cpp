@@ -0,0 +1,87 @@
+#include <benchmark/benchmark.h>
+
+#include <string>
+#include <vector>
+
+#include <storages/postgres/detail/connection.hpp>
+#include <userver/storages/postgres/typed_result_set.hpp>
+
+#include <storages/postgres/util_benchmark.hpp>
+
+USERVER_NAMESPACE_BEGIN
+
+namespace {
+
+namespace pg = storages::postgres;
+using namespace pg::bench;
+
+constexpr std::size_t kParallelTasks = 4;
+
+struct BenchRow {
+  std::int64_t id{};
+  std::string name;
+  std::optional<double> value;
+};
+
+pg::ResultSet SelectRows(pg::detail::Connection& conn, std::size_t count) {
+  return conn.Execute(
+      "select i::bigint, 'name ' || i::text, "
+      "case when i % 10 = 0 then null else i * 0.5 end "
+      "from generate_series(1, $1) as i",
+      static_cast<std::int64_t>(count));
+}
+
+}  // namespace
+
+BENCHMARK_DEFINE_F(PgConnection, ResultSetRowByRow)(benchmark::State& state) {
+  RunStandalone(state, [this, &state] {
+    const auto res = SelectRows(GetConnection(), state.range(0));
+    for (auto _ : state) {
+      // What AsContainer did before decoding the result set by columns
+      std::vector<BenchRow> rows;
+      rows.reserve(res.Size());
+      for (auto row : res.AsSetOf<BenchRow>(pg::kRowTag)) {
+        rows.push_back(std::move(row));
+      }
+      benchmark::DoNotOptimize(rows);
+    }
+    state.SetItemsProcessed(state.iterations() * res.Size());
+  });
+}
+BENCHMARK_REGISTER_F(PgConnection, ResultSetRowByRow)
+    ->RangeMultiplier(10)
+    ->Range(10, 100000);
+
+BENCHMARK_DEFINE_F(PgConnection, ResultSetAsContainer)
+(benchmark::State& state) {
+  RunStandalone(state, [this, &state] {
+    const auto res = SelectRows(GetConnection(), state.range(0));
+    for (auto _ : state) {
+      benchmark::DoNotOptimize(
+          res.AsContainer<std::vector<BenchRow>>(pg::kRowTag));
+    }
+    state.SetItemsProcessed(state.iterations() * res.Size());
+  });
+}
+BENCHMARK_REGISTER_F(PgConnection, ResultSetAsContainer)
+    ->RangeMultiplier(10)
+    ->Range(10, 100000);
+
+BENCHMARK_DEFINE_F(PgConnection, ResultSetAsContainerParallel)
+(benchmark::State& state) {
+  RunStandalone(state, kParallelTasks, [this, &state] {
+    const auto res = SelectRows(GetConnection(), state.range(0));
+    for (auto _ : state) {
+      benchmark::DoNotOptimize(
+          res.AsContainerParallel<std::vector<BenchRow>>(kParallelTasks,
+                                                         pg::kRowTag));
+    }
+    state.SetItemsProcessed(state.iterations() * res.Size());
+  });
+}
+BENCHMARK_REGISTER_F(PgConnection, ResultSetAsContainerParallel)
+    ->RangeMultiplier(10)
+    ->Range(10, 100000)
+    ->UseRealTime();
+
+USERVER_NAMESPACE_END
@@ -0,0 +1,202 @@
+#include <storages/postgres/tests/util_pgtest.hpp>
+
+#include <optional>
+#include <string>
+#include <tuple>
+#include <vector>
+
+#include <storages/postgres/detail/connection.hpp>
+#include <userver/storages/postgres/copy.hpp>
+
+USERVER_NAMESPACE_BEGIN
+
+namespace pg = storages::postgres;
+
+namespace {
+
+constexpr std::size_t kRowsCount = 10000;
+
+struct CopyRow {
+  int id{};
+  std::string name;
+  std::optional<double> value;
+
+  bool operator==(const CopyRow& rhs) const {
+    return std::tie(id, name, value) == std::tie(rhs.id, rhs.name, rhs.value);
+  }
+};
+
+void CreateCopyTable(pg::detail::ConnectionPtr& conn) {
+  UEXPECT_NO_THROW(conn->Execute(
+      "create temp table copy_test(id integer primary key, name text, "
+      "value double precision)"));
+}
+
+std::vector<CopyRow> MakeRows(std::size_t count) {
+  std::vector<CopyRow> rows;
+  rows.reserve(count);
+  for (std::size_t i = 0; i < count; ++i) {
+    rows.push_back({static_cast<int>(i), "name " + std::to_string(i),
+                    i % 3 ? std::optional<double>{i * 0.5} : std::nullopt});
+  }
+  return rows;
+}
+
+}  // namespace
+
+UTEST_P(PostgreConnection, CopyInRoundtrip) {
+  CheckConnection(GetConn());
+  CreateCopyTable(GetConn());
+
+  const auto rows = MakeRows(kRowsCount);
+  {
+    pg::CopyInStream copy{GetConn().get(), "copy_test",
+                          {"id", "name", "value"}, {}};
+    UEXPECT_NO_THROW(copy.WriteRow(rows[0].id, rows[0].name, rows[0].value));
+    UEXPECT_NO_THROW(copy.WriteRows(
+        std::vector<CopyRow>(std::next(rows.begin()), rows.end())));
+    std::size_t copied = 0;
+    UEXPECT_NO_THROW(copied = copy.Finish());
+    EXPECT_EQ(kRowsCount, copied);
+    UEXPECT_THROW(copy.Finish(), pg::LogicError);
+  }
+
+  pg::ResultSet res{nullptr};
+  UEXPECT_NO_THROW(res = GetConn()->Execute(
+                       "select id, name, value from copy_test order by id"));
+  EXPECT_EQ(rows, res.AsContainer<std::vector<CopyRow>>(pg::kRowTag));
+}
+
+UTEST_P(PostgreConnection, CopyInQualifiedTable) {
+  CheckConnection(GetConn());
+  UEXPECT_NO_THROW(GetConn()->Execute(
+      "create temp table \"Copy Test\"(\"Id\" integer, \"Name\" text)"));
+
+  pg::ResultSet res{nullptr};
+  UEXPECT_NO_THROW(res = GetConn()->Execute(
+                       "select nspname from pg_namespace "
+                       "where oid = pg_my_temp_schema()"));
+  const auto schema = res.Front().As<std::string>();
+  {
+    pg::CopyInStream copy{GetConn().get(), schema + ".Copy Test",
+                          {"Id", "Name"}, {}};
+    UEXPECT_NO_THROW(copy.WriteRow(1, std::string{"foo"}));
+    EXPECT_EQ(1u, copy.Finish());
+  }
+  UEXPECT_NO_THROW(
+      res = GetConn()->Execute("select count(*) from \"Copy Test\""));
+  EXPECT_EQ(1, res.Front().As<pg::Bigint>());
+}
+
+UTEST_P(PostgreConnection, CopyInAbort) {
+  CheckConnection(GetConn());
+  CreateCopyTable(GetConn());
+
+  pg::ResultSet res{nullptr};
+  UEXPECT_NO_THROW(GetConn()->Begin({}, pg::detail::SteadyClock::now()));
+  {
+    pg::CopyInStream copy{GetConn().get(), "copy_test", {"id"}, {}};
+    UEXPECT_NO_THROW(copy.WriteRow(1));
+  }
+  EXPECT_EQ(pg::ConnectionState::kTranError, GetConn()->GetState());
+  UEXPECT_NO_THROW(GetConn()->Rollback());
+
+  UEXPECT_NO_THROW(res = GetConn()->Execute("select count(*) from copy_test"));
+  EXPECT_EQ(0, res.Front().As<pg::Bigint>());
+}
+
+UTEST_P(PostgreConnection, CopyInErrors) {
+  CheckConnection(GetConn());
+  CreateCopyTable(GetConn());
+
+  UEXPECT_THROW((pg::CopyInStream{GetConn().get(), "copy_missing", {"id"}, {}}),
+                pg::AccessRuleViolation);
+  EXPECT_EQ(pg::ConnectionState::kIdle, GetConn()->GetState());
+
+  {
+    // Duplicate primary key is reported on finish
+    pg::CopyInStream copy{GetConn().get(), "copy_test", {"id"}, {}};
+    UEXPECT_NO_THROW(copy.WriteRow(1));
+    UEXPECT_NO_THROW(copy.WriteRow(1));
+    UEXPECT_THROW(copy.Finish(), pg::UniqueViolation);
+  }
+  EXPECT_EQ(pg::ConnectionState::kIdle, GetConn()->GetState());
+  UEXPECT_NO_THROW(GetConn()->Execute("select 1"));
+}
+
+UTEST_P(PostgreConnection, CopyOutRoundtrip) {
+  CheckConnection(GetConn());
+  CreateCopyTable(GetConn());
+
+  const auto rows = MakeRows(kRowsCount);
+  {
+    pg::CopyInStream copy{GetConn().get(), "copy_test",
+                          {"id", "name", "value"}, {}};
+    copy.WriteRows(rows);
+    copy.Finish();
+  }
+
+  {
+    pg::CopyOutStream copy{GetConn().get(),
+                           "select id, name, value from copy_test order by id",
+                           {}};
+    std::vector<CopyRow> result;
+    CopyRow row;
+    while (copy.ReadRow(row, pg::kRowTag)) {
+      result.push_back(row);
+    }
+    EXPECT_EQ(kRowsCount, copy.RowsRead());
+    EXPECT_EQ(rows, result);
+    EXPECT_FALSE(copy.ReadRow(row, pg::kRowTag));
+  }
+  {
+    pg::CopyOutStream copy{GetConn().get(),
+                           "select id, name from copy_test order by id", {}};
+    int id{};
+    std::string name;
+    ASSERT_TRUE(copy.ReadRow(id, name));
+    EXPECT_EQ(rows[0].id, id);
+    EXPECT_EQ(rows[0].name, name);
+    // Wrong number of fields
+    UEXPECT_THROW(copy.ReadRow(id), pg::InvalidTupleSizeRequested);
+  }
+  EXPECT_EQ(pg::ConnectionState::kIdle, GetConn()->GetState());
+  UEXPECT_NO_THROW(GetConn()->Execute("select 1"));
+}
+
+UTEST_P(PostgreConnection, CopyOutCancel) {
+  CheckConnection(GetConn());
+
+  {
+    pg::CopyOutStream copy{GetConn().get(),
+                           "select generate_series(1, 10000000)", {}};
+    int value{};
+    ASSERT_TRUE(copy.ReadRow(value));
+    EXPECT_EQ(1, value);
+  }
+  EXPECT_EQ(pg::ConnectionState::kIdle, GetConn()->GetState());
+  pg::ResultSet res{nullptr};
+  UEXPECT_NO_THROW(res = GetConn()->Execute("select 1"));
+  EXPECT_EQ(1, res.Front().As<int>());
+}
+
+UTEST_P(PostgreConnection, CopyOutInPipeline) {
+  CheckConnection(GetConn());
+  if (!GetConn()->IsPipelineActive()) {
+    GTEST_SKIP() << "Pipeline mode is disabled";
+  }
+
+  UEXPECT_NO_THROW(GetConn()->Begin({}, pg::detail::SteadyClock::now()));
+  {
+    pg::CopyOutStream copy{GetConn().get(), "select 42", {}};
+    int value{};
+    ASSERT_TRUE(copy.ReadRow(value));
+    EXPECT_EQ(42, value);
+    EXPECT_FALSE(copy.ReadRow(value));
+  }
+  EXPECT_TRUE(GetConn()->IsPipelineActive());
+  UEXPECT_NO_THROW(GetConn()->Execute("select 1"));
+  UEXPECT_NO_THROW(GetConn()->Commit());
+}
+
+USERVER_NAMESPACE_END
@@ -233,6 +233,48 @@ UTEST_P(PostgreConnection, TypedResultTupleSample) {
   /// [RowTagSippet]
 }
 
+UTEST_P(PostgreConnection, TypedResultLargeContainer) {
+  using MyStruct = static_test::MyStructWithOptional;
+  constexpr std::size_t kRows = 10000;
+
+  CheckConnection(GetConn());
+  const auto res = GetConn()->Execute(
+      "select i, i::text, "
+      "case when i % 3 = 0 then null else (i * 0.5)::float8 end "
+      "from generate_series(1, $1) as i",
+      static_cast<int>(kRows));
+  ASSERT_EQ(kRows, res.Size());
+
+  const auto check = [&](const auto& structs) {
+    ASSERT_EQ(kRows, structs.size());
+    int i = 1;
+    for (const auto& s : structs) {
+      EXPECT_EQ(i, s.int_member);
+      EXPECT_EQ(std::to_string(i), s.string_member);
+      if (i % 3 == 0) {
+        EXPECT_FALSE(s.double_member);
+      } else {
+        EXPECT_EQ(i * 0.5, s.double_member);
+      }
+      ++i;
+    }
+  };
+
+  check(res.AsContainer<std::vector<MyStruct>>(pg::kRowTag));
+  check(res.AsContainer<std::deque<MyStruct>>(pg::kRowTag));
+  check(res.AsContainerParallel<std::vector<MyStruct>>(4, pg::kRowTag));
+  check(res.AsContainerParallel<std::list<MyStruct>>(4, pg::kRowTag));
+
+  const auto ids = GetConn()->Execute("select generate_series(1, $1)",
+                                      static_cast<int>(kRows));
+  EXPECT_EQ(ids.AsContainer<std::vector<int>>(),
+            ids.AsContainerParallel<std::vector<int>>(4));
+  EXPECT_EQ(kRows, ids.AsContainerParallel<std::set<int>>(4).size());
+
+  UEXPECT_THROW(res.AsContainer<std::vector<int>>(),
+                pg::NonSingleColumnResultSet);
+}
+
 }  // namespace
 
 USERVER_NAMESPACE_END
@@ -105,6 +105,37 @@ Portal Transaction::MakePortal(const PortalName& portal_name,
                 std::move(statement_cmd_ctl)};
 }
 
+CopyInStream Transaction::CopyIn(std::string_view table,
+                                 const std::vector<std::string>& columns) {
+  return CopyIn(OptionalCommandControl{}, table, columns);
+}
+
+CopyInStream Transaction::CopyIn(OptionalCommandControl statement_cmd_ctl,
+                                 std::string_view table,
+                                 const std::vector<std::string>& columns) {
+  if (!conn_) {
+    LOG_LIMITED_ERROR() << "Copy in called after transaction finished"
+                        << logging::LogExtra::Stacktrace();
+    throw NotInTransaction("Transaction handle is not valid");
+  }
+  return CopyInStream{conn_.get(), table, columns,
+                      std::move(statement_cmd_ctl)};
+}
+
+CopyOutStream Transaction::CopyOut(const Query& query) {
+  return CopyOut(OptionalCommandControl{}, query);
+}
+
+CopyOutStream Transaction::CopyOut(OptionalCommandControl statement_cmd_ctl,
+                                   const Query& query) {
+  if (!conn_) {
+    LOG_LIMITED_ERROR() << "Copy out called after transaction finished"
+                        << logging::LogExtra::Stacktrace();
+    throw NotInTransaction("Transaction handle is not valid");
+  }
+  return CopyOutStream{conn_.get(), query, std::move(statement_cmd_ctl)};
+}
+
 void Transaction::SetParameter(const std::string& param_name,
                                const std::string& value) {
   if (!conn_) {
@@ -0,0 +1,94 @@
+#include <chrono>
+#include <condition_variable>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+
+#include <benchmark/benchmark.h>
+
+#include <userver/storages/redis/impl/base.hpp>
+#include <userver/storages/redis/impl/thread_pools.hpp>
+
+#include <storages/redis/impl/command.hpp>
+#include <storages/redis/impl/mock_server_test.hpp>
+#include <storages/redis/impl/redis.hpp>
+
+USERVER_NAMESPACE_BEGIN
+
+namespace {
+
+constexpr std::chrono::microseconds kBufferingInterval{100};
+
+const std::string kLocalhost = "127.0.0.1";
+
+// Replies to any read without looking up handlers, so that the server side
+// does not dominate the measurements
+class ReadsServer final : public MockRedisServerBase {
+ public:
+  ~ReadsServer() override { Stop(); }
+
+ protected:
+  void OnCommand(std::shared_ptr<redis::Reply> cmd) override {
+    const auto& args = cmd->data.GetArray();
+    const auto& command = args.front().GetString();
+    if (command == "PING") {
+      SendReplyOk("PONG");
+    } else if (command == "MGET") {
+      SendReplyData(redis::ReplyData::Array(args.size() - 1,
+                                            redis::ReplyData{"value"}));
+    } else {
+      SendReplyData(redis::ReplyData{"value"});
+    }
+  }
+};
+
+}  // namespace
+
+// Concurrent GETs to the same server with and without merging into MGET
+void RedisMergeSingleKeyReads(benchmark::State& state) {
+  const auto reads_count = static_cast<std::size_t>(state.range(0));
+
+  ReadsServer server;
+  auto pool = std::make_shared<redis::ThreadPools>(1, 1);
+  auto redis = std::make_shared<redis::Redis>(pool->GetRedisThreadPool(),
+                                              redis::RedisCreationSettings{});
+  redis::CommandsBufferingSettings buffering_settings;
+  buffering_settings.buffering_enabled = true;
+  buffering_settings.watch_command_timer_interval = kBufferingInterval;
+  buffering_settings.merge_single_key_reads = state.range(1) != 0;
+  redis->SetCommandsBufferingSettings(buffering_settings);
+  redis->Connect({kLocalhost}, server.GetPort(), redis::Password(""));
+  while (redis->GetState() != redis::RedisState::kConnected) {
+    std::this_thread::sleep_for(std::chrono::milliseconds{1});
+  }
+
+  std::mutex mutex;
+  std::condition_variable cv;
+  std::size_t pending = 0;
+  const auto on_reply = [&](const redis::CommandPtr&, redis::ReplyPtr) {
+    const std::lock_guard lock{mutex};
+    if (--pending == 0) cv.notify_one();
+  };
+
+  for ([[maybe_unused]] auto _ : state) {
+    {
+      const std::lock_guard lock{mutex};
+      pending = reads_count;
+    }
+    for (std::size_t i = 0; i < reads_count; ++i) {
+      redis->AsyncCommand(
+          redis::PrepareCommand({"GET", "key" + std::to_string(i)}, on_reply));
+    }
+
+    std::unique_lock lock{mutex};
+    cv.wait(lock, [&] { return pending == 0; });
+  }
+
+  state.SetItemsProcessed(state.iterations() * reads_count);
+}
+BENCHMARK(RedisMergeSingleKeyReads)
+    ->ArgsProduct({{1, 16, 256}, {false, true}})
+    ->UseRealTime();
+
+USERVER_NAMESPACE_END
@@ -0,0 +1,61 @@
+#include <memory>
+#include <string>
+
+#include <benchmark/benchmark.h>
+#include <hiredis/hiredis.h>
+
+#include <userver/storages/redis/impl/reply.hpp>
+
+#include <storages/redis/impl/reply_builder.hpp>
+
+USERVER_NAMESPACE_BEGIN
+
+namespace {
+
+using ReaderPtr = std::unique_ptr<redisReader, decltype(&redisReaderFree)>;
+
+// MGET-like reply: an array of equally sized bulk strings
+std::string MakeArrayReply(std::size_t size, std::size_t value_size) {
+  const std::string value(value_size, 'x');
+  std::string reply = '*' + std::to_string(size) + "\r\n";
+  for (std::size_t i = 0; i < size; ++i) {
+    reply += '$' + std::to_string(value_size) + "\r\n" + value + "\r\n";
+  }
+  return reply;
+}
+
+}  // namespace
+
+// Parsing of a large array reply through a redisReply tree, the way subscriber
+// connections do, and right into ReplyData, the way command connections do
+void RedisParseArrayReply(benchmark::State& state) {
+  const auto size = static_cast<std::size_t>(state.range(0));
+  const auto value_size = static_cast<std::size_t>(state.range(1));
+  const bool reply_data_objects = state.range(2) != 0;
+  const auto input = MakeArrayReply(size, value_size);
+
+  ReaderPtr reader{redisReaderCreate(), &redisReaderFree};
+  if (reply_data_objects) redis::UseReplyDataObjects(*reader);
+
+  for ([[maybe_unused]] auto _ : state) {
+    redisReaderFeed(reader.get(), input.data(), input.size());
+    void* reply = nullptr;
+    redisReaderGetReply(reader.get(), &reply);
+
+    if (reply_data_objects) {
+      benchmark::DoNotOptimize(redis::TakeReplyData(reply));
+      reader->fn->freeObject(reply);
+    } else {
+      benchmark::DoNotOptimize(
+          redis::ReplyData{static_cast<const redisReply*>(reply)});
+      freeReplyObject(reply);
+    }
+  }
+
+  state.SetItemsProcessed(state.iterations() * size);
+  state.SetBytesProcessed(state.iterations() * input.size());
+}
+BENCHMARK(RedisParseArrayReply)
+    ->ArgsProduct({{1000, 100000}, {16, 1024}, {false, true}});
+
+USERVER_NAMESPACE_END
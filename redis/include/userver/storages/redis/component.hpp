@@ -29,6 +29,7 @@ namespace storages {}
 /// Redis client
 namespace storages::redis {
 class Client;
+class NearCache;
 class SubscribeClient;
 class SubscribeClientImpl;
 }  // namespace storages::redis
@@ -64,6 +65,10 @@ namespace components {
 /// groups.[].db | name to refer to the cluster in components::Redis::GetClient() | -
 /// groups.[].sharding_strategy | one of RedisCluster, KeyShardCrc32, KeyShardTaximeterCrc32 or KeyShardGpsStorageDriver | "KeyShardTaximeterCrc32"
 /// groups.[].allow_reads_from_master | allows read requests from master instance | false
+/// groups.[].near_cache.prefixes | array of key prefixes cached by components::Redis::GetNearCache(), not supported for RedisCluster | -
+/// groups.[].near_cache.prefixes.[].prefix | keys starting with this prefix are cached | -
+/// groups.[].near_cache.prefixes.[].max_size_bytes | upper bound of the memory used by the cached keys and values | -
+/// groups.[].near_cache.prefixes.[].ttl | upper bound of the time a value is served without rereading it | 10s
 /// subscribe_groups | array of redis clusters to work with in subscribe mode | -
 /// subscribe_groups.[].config_name | key name in secdist with options for this cluster | -
 /// subscribe_groups.[].db | name to refer to the cluster in components::Redis::GetSubscribeClient() | -
@@ -80,6 +85,11 @@ namespace components {
 ///            sharding_strategy: RedisCluster
 ///          - config_name: dogs
 ///            db: hello_service_dogs_catalogue
+///            near_cache:
+///                prefixes:
+///                  - prefix: "dog:"
+///                    max_size_bytes: 16777216
+///                    ttl: 30s
 ///        subscribe_groups:
 ///          - config_name: food
 ///            db: hello_service_pet_food_orders
@@ -144,6 +154,11 @@ class Redis : public ComponentBase {
       const std::string& name,
       USERVER_NAMESPACE::redis::RedisWaitConnected wait_connected = {}) const;
 
+  /// Returns the near cache of the `groups` entry with `db` equal to `name`.
+  /// Requires Redis 6.0 or newer.
+  std::shared_ptr<storages::redis::NearCache> GetNearCache(
+      const std::string& name) const;
+
   static yaml_config::Schema GetStaticConfigSchema();
 
  private:
@@ -155,6 +170,7 @@ class Redis : public ComponentBase {
 
   void WriteStatistics(utils::statistics::Writer& writer);
   void WriteStatisticsPubsub(utils::statistics::Writer& writer);
+  void WriteStatisticsNearCache(utils::statistics::Writer& writer);
 
   std::shared_ptr<redis::ThreadPools> thread_pools_;
   std::unordered_map<std::string, std::shared_ptr<redis::Sentinel>> sentinels_;
@@ -163,12 +179,15 @@ class Redis : public ComponentBase {
   std::unordered_map<std::string,
                      std::shared_ptr<storages::redis::SubscribeClientImpl>>
       subscribe_clients_;
+  std::unordered_map<std::string, std::shared_ptr<storages::redis::NearCache>>
+      near_caches_;
 
   dynamic_config::Source config_;
   concurrent::AsyncEventSubscriberScope config_subscription_;
 
   utils::statistics::Entry statistics_holder_;
   utils::statistics::Entry subscribe_statistics_holder_;
+  utils::statistics::Entry near_cache_statistics_holder_;
 
   redis::MetricsSettings::StaticSettings static_metrics_settings_;
   rcu::Variable<redis::MetricsSettings> metrics_settings_;
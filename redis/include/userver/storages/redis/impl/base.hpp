@@ -113,11 +113,20 @@ struct CommandsBufferingSettings {
   bool buffering_enabled{false};
   size_t commands_buffering_threshold{0};
   std::chrono::microseconds watch_command_timer_interval{0};
+  /// Derive the buffering interval from the observed commands rate and RTT,
+  /// watch_command_timer_interval is the upper bound for it
+  bool adaptive_buffering_enabled{false};
+  /// Send concurrent GET and HGET commands as a single MGET or HMGET.
+  /// Merged GET of a key that does not hold a string returns nil instead of
+  /// a WRONGTYPE error, merged HGET keeps the error.
+  bool merge_single_key_reads{false};
 
   constexpr bool operator==(const CommandsBufferingSettings& o) const {
     return buffering_enabled == o.buffering_enabled &&
            commands_buffering_threshold == o.commands_buffering_threshold &&
-           watch_command_timer_interval == o.watch_command_timer_interval;
+           watch_command_timer_interval == o.watch_command_timer_interval &&
+           adaptive_buffering_enabled == o.adaptive_buffering_enabled &&
+           merge_single_key_reads == o.merge_single_key_reads;
   }
 };
 
@@ -16,6 +16,8 @@ USERVER_NAMESPACE_BEGIN
 
 namespace redis {
 
+class ReplyDataBuilder;
+
 class ReplyData final {
  public:
   using Array = std::vector<ReplyData>;
@@ -225,6 +227,8 @@ class ReplyData final {
   void ExpectError(const std::string& request_description = {}) const;
 
  private:
+  friend class ReplyDataBuilder;
+
   ReplyData() = default;
 
   [[noreturn]] void ThrowUnexpectedReplyType(
@@ -243,6 +247,8 @@ class Reply final {
   Reply(std::string cmd, redisReply* redis_reply, ReplyStatus status,
         std::string status_string);
   Reply(std::string cmd, ReplyData&& data);
+  Reply(std::string cmd, ReplyData&& data, ReplyStatus status,
+        std::string status_string);
 
   std::string server;
   ServerId server_id;
@@ -0,0 +1,120 @@
+#pragma once
+
+/// @file userver/storages/redis/near_cache.hpp
+/// @brief @copybrief storages::redis::NearCache
+
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <optional>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include <userver/storages/redis/client_fwd.hpp>
+#include <userver/storages/redis/command_options.hpp>
+#include <userver/storages/redis/subscription_token.hpp>
+
+USERVER_NAMESPACE_BEGIN
+
+namespace utils::statistics {
+class Writer;
+}  // namespace utils::statistics
+
+namespace storages::redis {
+
+/// Settings of the keys with a common prefix cached by NearCache
+struct NearCachePrefixSettings {
+  /// Keys starting with this prefix are cached
+  std::string prefix;
+
+  /// Upper bound of the memory used by the cached keys and values
+  std::size_t max_size_bytes{0};
+
+  /// Upper bound of the time a value is served without rereading it. Guards
+  /// against invalidations lost on reconnects and subscription queue
+  /// overflows.
+  std::chrono::milliseconds ttl{std::chrono::seconds{10}};
+};
+
+struct NearCacheSettings {
+  std::vector<NearCachePrefixSettings> prefixes;
+};
+
+/// Values of the NearCache metrics of a single prefix
+struct NearCachePrefixStatistics {
+  std::uint64_t hits{0};
+  std::uint64_t misses{0};
+  std::uint64_t invalidations{0};
+  std::uint64_t evictions{0};
+  std::size_t entries{0};
+  std::size_t size_bytes{0};
+};
+
+void DumpMetric(utils::statistics::Writer& writer,
+                const NearCachePrefixStatistics& stats);
+
+/// @ingroup userver_clients
+///
+/// @brief In-process cache of the GET replies that is kept coherent by the
+/// Redis server-assisted client side caching.
+///
+/// Usually retrieved from components::Redis component, see
+/// `groups.[].near_cache` static option.
+///
+/// The `subscribe_client` must be created with CLIENT TRACKING enabled in
+/// broadcasting mode for the cached prefixes. Invalidation messages are
+/// received from the `__redis__:invalidate` channel and drop the cached
+/// values of the modified keys. Keys that do not match any of the configured
+/// prefixes are always read from Redis.
+///
+/// Cached values are always read from the master, so that a value read after
+/// the invalidation of a modification already has that modification.
+///
+/// @warning Invalidations arrive asynchronously. A value may be served after
+/// it was modified until its invalidation is delivered, and for up to the
+/// prefix `ttl` if an invalidation message is lost.
+class NearCache final {
+ public:
+  NearCache(ClientPtr client, SubscribeClientPtr subscribe_client,
+            NearCacheSettings settings);
+  ~NearCache();
+
+  NearCache(const NearCache&) = delete;
+  NearCache& operator=(const NearCache&) = delete;
+
+  /// Returns the cached value of `key` or reads it with GET. The GET of a key
+  /// with a cached prefix goes to the master regardless of `command_control`.
+  std::optional<std::string> Get(std::string key,
+                                 const CommandControl& command_control);
+
+  /// Drops all the cached values
+  void Clear();
+
+  /// Returns the metrics of the first prefix equal to `prefix`
+  NearCachePrefixStatistics GetStatistics(std::string_view prefix) const;
+
+  /// The channel that CLIENT TRACKING invalidations are delivered to
+  static constexpr std::string_view kInvalidateChannel =
+      "__redis__:invalidate";
+
+ private:
+  class PrefixCache;
+
+  friend void DumpMetric(utils::statistics::Writer& writer,
+                         const NearCache& cache);
+
+  PrefixCache* FindPrefixCache(std::string_view key) const;
+
+  void OnInvalidate(const std::string& key);
+
+  ClientPtr client_;
+  SubscribeClientPtr subscribe_client_;
+  std::vector<std::unique_ptr<PrefixCache>> prefix_caches_;
+  SubscriptionToken invalidate_token_;
+};
+
+}  // namespace storages::redis
+
+USERVER_NAMESPACE_END
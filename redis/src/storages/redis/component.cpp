@@ -21,6 +21,7 @@
 #include <userver/yaml_config/merge_schemas.hpp>
 
 #include <userver/storages/redis/client.hpp>
+#include <userver/storages/redis/near_cache.hpp>
 #include <userver/storages/redis/redis_config.hpp>
 #include <userver/storages/redis/subscribe_client.hpp>
 
@@ -41,6 +42,7 @@ namespace {
 
 const auto kStatisticsName = "redis";
 const auto kSubscribeStatisticsName = "redis-pubsub";
+const auto kNearCacheStatisticsName = "redis-near-cache";
 
 template <typename RedisGroup>
 USERVER_NAMESPACE::secdist::RedisSettings GetSecdistSettings(
@@ -65,8 +67,24 @@ struct RedisGroup {
   std::string config_name;
   std::string sharding_strategy;
   bool allow_reads_from_master{false};
+  std::optional<storages::redis::NearCacheSettings> near_cache;
 };
 
+storages::redis::NearCacheSettings ParseNearCacheSettings(
+    const yaml_config::YamlConfig& value) {
+  storages::redis::NearCacheSettings settings;
+  for (const auto& prefix_value : value["prefixes"]) {
+    storages::redis::NearCachePrefixSettings prefix_settings;
+    prefix_settings.prefix = prefix_value["prefix"].As<std::string>();
+    prefix_settings.max_size_bytes =
+        prefix_value["max_size_bytes"].As<std::size_t>();
+    prefix_settings.ttl =
+        prefix_value["ttl"].As<std::chrono::milliseconds>(prefix_settings.ttl);
+    settings.prefixes.push_back(std::move(prefix_settings));
+  }
+  return settings;
+}
+
 RedisGroup Parse(const yaml_config::YamlConfig& value,
                  formats::parse::To<RedisGroup>) {
   RedisGroup config;
@@ -75,6 +93,9 @@ RedisGroup Parse(const yaml_config::YamlConfig& value,
   config.sharding_strategy = value["sharding_strategy"].As<std::string>("");
   config.allow_reads_from_master =
       value["allow_reads_from_master"].As<bool>(false);
+  if (!value["near_cache"].IsMissing()) {
+    config.near_cache = ParseNearCacheSettings(value["near_cache"]);
+  }
   return config;
 }
 
@@ -151,6 +172,11 @@ Redis::Redis(const ComponentConfig& config,
       kSubscribeStatisticsName, [this](utils::statistics::Writer& writer) {
         WriteStatisticsPubsub(writer);
       });
+
+  near_cache_statistics_holder_ = statistics_storage.RegisterWriter(
+      kNearCacheStatisticsName, [this](utils::statistics::Writer& writer) {
+        WriteStatisticsNearCache(writer);
+      });
 }
 
 std::shared_ptr<storages::redis::Client> Redis::GetClient(
@@ -165,6 +191,16 @@ std::shared_ptr<storages::redis::Client> Redis::GetClient(
   return it->second;
 }
 
+std::shared_ptr<storages::redis::NearCache> Redis::GetNearCache(
+    const std::string& name) const {
+  auto it = near_caches_.find(name);
+  if (it == near_caches_.end())
+    throw std::runtime_error(fmt::format(
+        "{} redis near cache not found. Available near caches: [{}]", name,
+        fmt::join(near_caches_ | boost::adaptors::map_keys, ", ")));
+  return it->second;
+}
+
 std::shared_ptr<redis::Sentinel> Redis::Client(const std::string& name) const {
   auto it = sentinels_.find(name);
   if (it == sentinels_.end())
@@ -265,11 +301,51 @@ void Redis::Connect(const ComponentConfig& config,
     subscribe_client_it.second->WaitConnectedOnce(
         redis_wait_connected_subscribe);
   }
+
+  for (const RedisGroup& redis_group : redis_groups) {
+    if (!redis_group.near_cache) continue;
+    const auto client_it = clients_.find(redis_group.db);
+    if (client_it == clients_.end()) continue;
+
+    if (USERVER_NAMESPACE::redis::IsClusterStrategy(
+            redis_group.sharding_strategy)) {
+      throw std::runtime_error(fmt::format(
+          "near_cache is not supported for RedisCluster, db={}",
+          redis_group.db));
+    }
+
+    // Invalidations are received over a dedicated subscriber connection that
+    // tracks the cached prefixes
+    std::vector<std::string> prefixes;
+    for (const auto& prefix_settings : redis_group.near_cache->prefixes) {
+      prefixes.push_back(prefix_settings.prefix);
+    }
+    redis::CommandControl cc{};
+    cc.allow_reads_from_master = redis_group.allow_reads_from_master;
+
+    auto sentinel = redis::SubscribeSentinel::Create(
+        thread_pools_, GetSecdistSettings(secdist_component, redis_group),
+        redis_group.config_name, config_source, redis_group.db, false, cc,
+        testsuite_redis_control, std::move(prefixes));
+    if (!sentinel) {
+      LOG_WARNING() << "skip redis near cache for " << redis_group.db;
+      continue;
+    }
+    auto subscribe_client =
+        std::make_shared<storages::redis::SubscribeClientImpl>(
+            std::move(sentinel));
+    subscribe_client->WaitConnectedOnce(redis_wait_connected_subscribe);
+    near_caches_.emplace(redis_group.db,
+                         std::make_shared<storages::redis::NearCache>(
+                             client_it->second, std::move(subscribe_client),
+                             *redis_group.near_cache));
+  }
 }
 
 Redis::~Redis() {
   statistics_holder_.Unregister();
   subscribe_statistics_holder_.Unregister();
+  near_cache_statistics_holder_.Unregister();
   config_subscription_.Unsubscribe();
 }
 
@@ -293,6 +369,12 @@ void Redis::WriteStatisticsPubsub(utils::statistics::Writer& writer) {
   }
 }
 
+void Redis::WriteStatisticsNearCache(utils::statistics::Writer& writer) {
+  for (const auto& [name, near_cache] : near_caches_) {
+    writer.ValueWithLabels(*near_cache, {"redis_database", name});
+  }
+}
+
 void Redis::OnConfigUpdate(const dynamic_config::Snapshot& cfg) {
   LOG_INFO() << "update default command control";
   const auto& redis_config = cfg[storages::redis::kConfig];
@@ -378,6 +460,30 @@ properties:
                     type: boolean
                     description: allows read requests from master instance
                     defaultDescription: false
+                near_cache:
+                    type: object
+                    description: settings of the in-process cache of GET replies, see components::Redis::GetNearCache()
+                    additionalProperties: false
+                    properties:
+                        prefixes:
+                            type: array
+                            description: cached key prefixes, the first matching one is used for a key
+                            items:
+                                type: object
+                                description: cached key prefix
+                                additionalProperties: false
+                                properties:
+                                    prefix:
+                                        type: string
+                                        description: keys starting with this prefix are cached
+                                    max_size_bytes:
+                                        type: integer
+                                        description: upper bound of the memory used by the cached keys and values
+                                        minimum: 0
+                                    ttl:
+                                        type: string
+                                        description: upper bound of the time a value is served without rereading it
+                                        defaultDescription: 10s
     metrics_level:
         type: string
         description: set metrics detail level
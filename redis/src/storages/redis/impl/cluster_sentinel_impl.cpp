@@ -4,7 +4,6 @@
 
 #include <fmt/format.h>
 #include <boost/container_hash/hash.hpp>
-#include <boost/crc.hpp>
 
 #include <userver/concurrent/variable.hpp>
 #include <userver/logging/log.hpp>
@@ -64,15 +63,6 @@ using NodesAddressesSet =
     std::unordered_set<NodeAddresses, NodeAddressesHasher>;
 using HostPort = std::string;
 
-size_t HashSlot(const std::string& key) {
-  size_t start = 0;
-  size_t len = 0;
-  GetRedisKey(key, &start, &len);
-  return std::for_each(key.data() + start, key.data() + start + len,
-                       boost::crc_optimal<16, 0x1021>())() &
-         0x3fff;
-}
-
 std::string ParseMovedShard(const std::string& err_string) {
   static const auto kUnknownShard = std::string("");
   size_t pos = err_string.find(' ');  // skip "MOVED" or "ASK"
@@ -167,13 +157,14 @@ class ClusterTopologyHolder
       const std::shared_ptr<engine::ev::ThreadPool>& redis_thread_pool,
       std::string shard_group_name, Password password,
       const std::vector<std::string>& /*shards*/,
-      const std::vector<ConnectionInfo>& conns)
+      const std::vector<ConnectionInfo>& conns, ConnectionMode mode)
       : ev_thread_(sentinel_thread_control),
         redis_thread_pool_(redis_thread_pool),
         shard_group_name_(std::move(shard_group_name)),
         password_(std::move(password)),
         shards_names_(MakeShardNames()),
         conns_(conns),
+        connection_mode_(mode),
         update_topology_timer_(
             ev_thread_, [this] { UpdateClusterTopology(); },
             kSentinelGetHostsCheckInterval),
@@ -376,6 +367,7 @@ class ClusterTopologyHolder
   Password password_;
   std::shared_ptr<const std::vector<std::string>> shards_names_;
   std::vector<ConnectionInfo> conns_;
+  const ConnectionMode connection_mode_;
   std::shared_ptr<Shard> sentinels_;
 
   std::atomic_size_t current_topology_version_{0};
@@ -678,7 +670,8 @@ ClusterTopologyHolder::CreateRedisInstance(const std::string& host_port) {
   return std::make_shared<RedisConnectionHolder>(
       ev_thread_, redis_thread_pool_, host, port, password_,
       buffering_settings_ptr->value_or(CommandsBufferingSettings{}),
-      *replication_monitoring_settings_ptr, *retry_budget_settings_ptr);
+      *replication_monitoring_settings_ptr, *retry_budget_settings_ptr,
+      connection_mode_);
 }
 
 namespace {
@@ -789,7 +782,7 @@ ClusterSentinelImpl::ClusterSentinelImpl(
     ConnectionSecurity /*connection_security*/,
     ReadyChangeCallback ready_callback,
     std::unique_ptr<KeyShard>&& /*key_shard*/,
-    dynamic_config::Source dynamic_config_source, ConnectionMode /*mode*/)
+    dynamic_config::Source dynamic_config_source, ConnectionMode mode)
     : sentinel_obj_(sentinel),
       ev_thread_(sentinel_thread_control),
       process_waiting_commands_timer_(
@@ -798,7 +791,7 @@ ClusterSentinelImpl::ClusterSentinelImpl(
               kSentinelGetHostsCheckInterval)),
       topology_holder_(std::make_shared<ClusterTopologyHolder>(
           ev_thread_, redis_thread_pool, shard_group_name, password, shards,
-          conns)),
+          conns, mode)),
       shard_group_name_(std::move(shard_group_name)),
       conns_(conns),
       ready_callback_(std::move(ready_callback)),
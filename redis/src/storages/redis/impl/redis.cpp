@@ -5,6 +5,7 @@
 #include <deque>
 #include <mutex>
 #include <string>
+#include <string_view>
 #include <unordered_map>
 #include <vector>
 
@@ -27,7 +28,9 @@
 #include <storages/redis/impl/ev_wrapper.hpp>
 #include <storages/redis/impl/redis_info.hpp>
 #include <storages/redis/impl/redis_stats.hpp>
+#include <storages/redis/impl/reply_builder.hpp>
 #include <storages/redis/impl/tcp_socket.hpp>
+#include <userver/storages/redis/impl/keyshard.hpp>
 #include <userver/storages/redis/impl/reply.hpp>
 
 #include "command_control_impl.hpp"
@@ -41,6 +44,13 @@ const auto kPingLatencyExp = 0.7;
 const auto kInitialPingLatencyMs = 1000;
 const size_t kMissedPingStreakThresholdDefault = 3;
 
+// Adaptive buffering delays the commands for at most 1/kBufferingRttDivisor of
+// RTT and only if at least kMinBufferedCommands are expected to arrive
+const auto kBufferingRttDivisor = 4;
+const auto kMinBufferedCommands = 2.0;
+const auto kCommandsRateExp = 0.7;
+const std::chrono::milliseconds kCommandsRatePeriod{100};
+
 // channel is used for periodic subscribe/unsubscribe to calculate actual RTT
 // instead of sending PING commands which are not supported by hiredis in
 // subscriber mode
@@ -112,6 +122,24 @@ inline bool IsExecCommand(const CmdArgs::CmdArgsArray& args) {
   return AreStringsEqualIgnoreCase(args[0], exec_command);
 }
 
+inline bool IsGetCommand(const CmdArgs::CmdArgsArray& args) {
+  static const std::string get_command{"GET"};
+
+  return args.size() == 2 && AreStringsEqualIgnoreCase(args[0], get_command);
+}
+
+inline bool IsHgetCommand(const CmdArgs::CmdArgsArray& args) {
+  static const std::string hget_command{"HGET"};
+
+  return args.size() == 3 && AreStringsEqualIgnoreCase(args[0], hget_command);
+}
+
+bool IsMergeableRead(const CommandPtr& command) {
+  if (command->asking || command->args.args.size() != 1) return false;
+  const auto& args = command->args.args.front();
+  return IsGetCommand(args) || IsHgetCommand(args);
+}
+
 bool IsFinalState(Redis::State state) {
   return state == Redis::State::kDisconnected ||
          state == Redis::State::kDisconnectError;
@@ -218,7 +246,15 @@ class Redis::RedisImpl : public std::enable_shared_from_this<Redis::RedisImpl> {
 
   void OnNewCommandImpl();
   void CommandLoopImpl();
-  void OnRedisReplyImpl(redisReply* redis_reply, void* privdata, int status,
+  void AccountCommandsRate(size_t commands_count);
+  std::chrono::microseconds GetBufferingInterval(
+      const CommandsBufferingSettings& commands_buffering_settings) const;
+  std::deque<CommandPtr> MergeSingleKeyReads(std::deque<CommandPtr>&& commands);
+  CommandPtr MergeReads(std::vector<CommandPtr>&& reads);
+  void OnMergedReply(const std::vector<CommandPtr>& reads,
+                     const ReplyPtr& reply);
+  ReplyData MakeReplyData(void* redis_reply) const;
+  void OnRedisReplyImpl(ReplyData&& reply_data, void* privdata, int status,
                         const char* errstr);
   void AccountPingLatency(std::chrono::milliseconds latency);
   void AccountRtt();
@@ -235,6 +271,8 @@ class Redis::RedisImpl : public std::enable_shared_from_this<Redis::RedisImpl> {
 
   void Authenticate();
   void SendReadOnly();
+  void EnableClientTracking();
+  void OnAuthenticated();
   void FreeCommands();
 
   static void LogSocketErrorReply(const CommandPtr& command,
@@ -292,11 +330,20 @@ class Redis::RedisImpl : public std::enable_shared_from_this<Redis::RedisImpl> {
   std::atomic_bool enable_replication_monitoring_ = false;
   std::atomic_bool forbid_requests_to_syncing_replicas_ = false;
   const bool send_readonly_;
+  const bool cluster_mode_;
+  const std::vector<std::string> client_tracking_prefixes_;
+  // Subscriber connections keep the redisReply trees, hiredis dispatches
+  // pubsub messages by their contents
+  const bool reply_data_objects_;
   const ConnectionSecurity connection_security_;
   std::chrono::milliseconds ping_interval_{2000};
   std::chrono::milliseconds ping_timeout_{4000};
   std::chrono::milliseconds info_replication_interval_{2000};
   std::atomic<double> ping_latency_ms_{kInitialPingLatencyMs};
+  std::chrono::microseconds peer_rtt_{0};
+  double commands_rate_{0};
+  size_t commands_rate_count_{0};
+  std::chrono::steady_clock::time_point commands_rate_start_{};
   logging::LogExtra log_extra_;
   bool watch_command_timer_started_ = false;
   Statistics statistics_;
@@ -393,6 +440,10 @@ Redis::RedisImpl::RedisImpl(
       ev_thread_control_(thread_control),
       thread_pool_(thread_pool),
       send_readonly_(redis_settings.send_readonly),
+      cluster_mode_(redis_settings.cluster_mode),
+      client_tracking_prefixes_(redis_settings.client_tracking_prefixes),
+      reply_data_objects_(redis_settings.connection_mode ==
+                          ConnectionMode::kCommands),
       connection_security_(redis_settings.connection_security),
       server_id_(ServerId::Generate()),
       retry_budget_(utils::RetryBudgetSettings{100, 0.1, false}) {
@@ -482,6 +533,8 @@ bool Redis::RedisImpl::Connect(const std::string& host, int port,
     return false;
   }
 
+  if (reply_data_objects_) UseReplyDataObjects(*context_->c.reader);
+
   ev_thread_control_.RunInEvLoopBlocking([this, &host]() {
     bool err = false;
     auto CheckError = [&err, &host](int status, const std::string& name) {
@@ -674,6 +727,7 @@ void Redis::RedisImpl::AccountPingLatency(std::chrono::milliseconds latency) {
 void Redis::RedisImpl::AccountRtt() {
   auto rtt = GetSocketPeerRtt(context_->c.fd);
   if (rtt) {
+    peer_rtt_ = *rtt;
     AccountPingLatency(
         std::chrono::duration_cast<std::chrono::milliseconds>(*rtt));
   }
@@ -898,17 +952,16 @@ void Redis::RedisImpl::OnNewCommand(struct ev_loop*, ev_async* w,
 
 void Redis::RedisImpl::OnNewCommandImpl() {
   auto commands_buffering_settings = commands_buffering_settings_.Get();
-  if (WatchCommandTimerEnabled(*commands_buffering_settings) &&
+  const auto buffering_interval =
+      GetBufferingInterval(*commands_buffering_settings);
+  if (buffering_interval != std::chrono::microseconds::zero() &&
       (!commands_buffering_settings->commands_buffering_threshold ||
        commands_size_.load() <
            commands_buffering_settings->commands_buffering_threshold)) {
     if (!std::exchange(watch_command_timer_started_, true)) {
       // NOLINTNEXTLINE(cppcoreguidelines-pro-type-cstyle-cast)
-      ev_timer_set(
-          &watch_command_timer_,
-          ToEvDuration(
-              commands_buffering_settings->watch_command_timer_interval),
-          0.0);
+      ev_timer_set(&watch_command_timer_, ToEvDuration(buffering_interval),
+                   0.0);
       ev_thread_control_.Start(watch_command_timer_);
     }
   } else {
@@ -916,6 +969,33 @@ void Redis::RedisImpl::OnNewCommandImpl() {
   }
 }
 
+std::chrono::microseconds Redis::RedisImpl::GetBufferingInterval(
+    const CommandsBufferingSettings& commands_buffering_settings) const {
+  if (!WatchCommandTimerEnabled(commands_buffering_settings)) {
+    return std::chrono::microseconds::zero();
+  }
+  const auto max_interval =
+      commands_buffering_settings.watch_command_timer_interval;
+  if (!commands_buffering_settings.adaptive_buffering_enabled) {
+    return max_interval;
+  }
+
+  // Unknown RTT, do not guess
+  if (peer_rtt_ == std::chrono::microseconds::zero()) return max_interval;
+
+  const auto interval =
+      std::min(max_interval, peer_rtt_ / kBufferingRttDivisor);
+  const auto expected_commands =
+      commands_rate_ *
+      std::chrono::duration_cast<std::chrono::duration<double>>(interval)
+          .count();
+  // At low load the delay would not gather any commands to send together
+  if (expected_commands < kMinBufferedCommands) {
+    return std::chrono::microseconds::zero();
+  }
+  return interval;
+}
+
 void Redis::RedisImpl::CommandLoopOnTimer(struct ev_loop*, ev_timer* w,
                                           int) noexcept {
   auto* impl = static_cast<Redis::RedisImpl*>(w->data);
@@ -940,11 +1020,125 @@ void Redis::RedisImpl::CommandLoopImpl() {
     std::swap(commands_, commands);
   }
   LOG_TRACE() << "commands size=" << commands.size();
+  AccountCommandsRate(commands.size());
+  if (!subscriber_ &&
+      commands_buffering_settings_.Get()->merge_single_key_reads) {
+    commands = MergeSingleKeyReads(std::move(commands));
+  }
   for (auto& command : commands) {
     ProcessCommand(command);
   }
 }
 
+void Redis::RedisImpl::AccountCommandsRate(size_t commands_count) {
+  commands_rate_count_ += commands_count;
+
+  const auto now = std::chrono::steady_clock::now();
+  const auto elapsed = now - commands_rate_start_;
+  if (elapsed < kCommandsRatePeriod) return;
+
+  const auto rate =
+      commands_rate_count_ /
+      std::chrono::duration_cast<std::chrono::duration<double>>(elapsed)
+          .count();
+  commands_rate_ =
+      commands_rate_ * kCommandsRateExp + rate * (1 - kCommandsRateExp);
+  commands_rate_count_ = 0;
+  commands_rate_start_ = now;
+}
+
+std::deque<CommandPtr> Redis::RedisImpl::MergeSingleKeyReads(
+    std::deque<CommandPtr>&& commands) {
+  std::deque<CommandPtr> result;
+
+  // Reads are merged only with adjacent reads, so that they are never
+  // reordered with writes. MGET may only be used for the keys of the same hash
+  // slot in cluster mode. MGET replies nil for a key of another type where GET
+  // replies WRONGTYPE, HMGET of a single hash keeps the error of HGET.
+  std::unordered_map<size_t, std::vector<CommandPtr>> gets;
+  std::unordered_map<std::string_view, std::vector<CommandPtr>> hgets;
+  const auto flush_group = [&](std::vector<CommandPtr>& reads) {
+    result.push_back(reads.size() == 1 ? std::move(reads.front())
+                                       : MergeReads(std::move(reads)));
+  };
+  const auto flush = [&] {
+    for (auto& [_, reads] : gets) flush_group(reads);
+    gets.clear();
+    for (auto& [_, reads] : hgets) flush_group(reads);
+    hgets.clear();
+  };
+
+  for (auto& command : commands) {
+    if (!IsMergeableRead(command)) {
+      flush();
+      result.push_back(std::move(command));
+      continue;
+    }
+
+    const auto& args = command->args.args.front();
+    if (IsGetCommand(args)) {
+      gets[cluster_mode_ ? HashSlot(args[1]) : 0].push_back(std::move(command));
+    } else {
+      hgets[args[1]].push_back(std::move(command));
+    }
+  }
+  flush();
+
+  return result;
+}
+
+CommandPtr Redis::RedisImpl::MergeReads(std::vector<CommandPtr>&& reads) {
+  UASSERT(reads.size() > 1);
+  const auto& first_args = reads.front()->args.args.front();
+  const bool is_hget = IsHgetCommand(first_args);
+
+  CmdArgs args;
+  auto& merged_args = args.args.emplace_back();
+  merged_args.reserve(reads.size() + 2);
+  merged_args.emplace_back(is_hget ? "HMGET" : "MGET");
+  if (is_hget) merged_args.push_back(first_args[1]);
+
+  // The replies are accounted for each of the original commands
+  CommandControl control = reads.front()->control;
+  control.account_in_statistics = false;
+  for (const auto& read : reads) {
+    merged_args.push_back(read->args.args.front().back());
+    control.timeout_single =
+        std::min(CommandControlImpl{control}.timeout_single,
+                 CommandControlImpl{read->control}.timeout_single);
+    read->ResetStartHandlingTime();
+  }
+
+  statistics_.merged_commands += utils::statistics::Rate{reads.size()};
+  ++statistics_.merged_batches;
+
+  return PrepareCommand(
+      std::move(args),
+      [this, reads = std::move(reads)](const CommandPtr&, ReplyPtr reply) {
+        OnMergedReply(reads, reply);
+      },
+      control);
+}
+
+void Redis::RedisImpl::OnMergedReply(const std::vector<CommandPtr>& reads,
+                                     const ReplyPtr& reply) {
+  const bool is_split = reply->IsOk() && reply->data.IsArray() &&
+                        reply->data.GetArray().size() == reads.size();
+  for (size_t i = 0; i < reads.size(); ++i) {
+    const auto& cmd = reads[i]->args.args.front().front();
+    if (is_split) {
+      InvokeCommand(reads[i], std::make_shared<Reply>(
+                                  cmd, std::move(reply->data.GetArray()[i])));
+    } else {
+      // Errors of the merged command are errors of each of the reads
+      auto read_reply = std::make_shared<Reply>(cmd, ReplyData{reply->data});
+      read_reply->status = reply->status;
+      read_reply->status_string = reply->status_string;
+      InvokeCommand(reads[i], std::move(read_reply));
+    }
+  }
+}
+
 void Redis::RedisImpl::OnConnect(const redisAsyncContext* c,
                                  int status) noexcept {
   auto* impl = static_cast<Redis::RedisImpl*>(c->data);
@@ -1041,19 +1235,13 @@ bool Redis::RedisImpl::InitSecureConnection() {
 
 void Redis::RedisImpl::Authenticate() {
   if (password_.GetUnderlying().empty()) {
-    if (send_readonly_)
-      SendReadOnly();
-    else
-      SetState(State::kConnected);
+    OnAuthenticated();
   } else {
     ProcessCommand(PrepareCommand(
         CmdArgs{"AUTH", password_.GetUnderlying()},
         [this](const CommandPtr&, ReplyPtr reply) {
           if (*reply && reply->data.IsStatus()) {
-            if (send_readonly_)
-              SendReadOnly();
-            else
-              SetState(State::kConnected);
+            OnAuthenticated();
           } else {
             if (*reply) {
               if (reply->IsUnknownCommandError()) {
@@ -1079,13 +1267,25 @@ void Redis::RedisImpl::Authenticate() {
   }
 }
 
+void Redis::RedisImpl::OnAuthenticated() {
+  if (send_readonly_)
+    SendReadOnly();
+  else if (!client_tracking_prefixes_.empty())
+    EnableClientTracking();
+  else
+    SetState(State::kConnected);
+}
+
 void Redis::RedisImpl::SendReadOnly() {
   LOG_DEBUG() << "Send READONLY command to slave "
               << GetServerId().GetDescription() << " in cluster mode";
   ProcessCommand(PrepareCommand(CmdArgs{"READONLY"}, [this](const CommandPtr&,
                                                             ReplyPtr reply) {
     if (*reply && reply->data.IsStatus()) {
-      SetState(State::kConnected);
+      if (!client_tracking_prefixes_.empty())
+        EnableClientTracking();
+      else
+        SetState(State::kConnected);
     } else {
       if (*reply) {
         LOG_LIMITED_ERROR()
@@ -1102,25 +1302,70 @@ void Redis::RedisImpl::SendReadOnly() {
   }));
 }
 
+// Invalidation messages are redirected to this very connection, so that they
+// arrive as pubsub messages on the `__redis__:invalidate` channel once it is
+// subscribed to. RESP2 connections are not able to receive push messages.
+void Redis::RedisImpl::EnableClientTracking() {
+  LOG_DEBUG() << "Enable client tracking on " << GetServerId().GetDescription()
+              << " for " << client_tracking_prefixes_.size() << " prefixes";
+  ProcessCommand(PrepareCommand(
+      CmdArgs{"CLIENT", "ID"}, [this](const CommandPtr&, ReplyPtr reply) {
+        if (!*reply || !reply->data.IsInt()) {
+          LOG_LIMITED_ERROR() << log_extra_ << "CLIENT ID failed: "
+                              << (*reply ? reply->data.ToDebugString()
+                                         : reply->status_string);
+          Disconnect();
+          return;
+        }
+
+        CmdArgs::CmdArgsArray args{"CLIENT", "TRACKING", "ON", "REDIRECT",
+                                   std::to_string(reply->data.GetInt()),
+                                   "BCAST"};
+        for (const auto& prefix : client_tracking_prefixes_) {
+          args.emplace_back("PREFIX");
+          args.push_back(prefix);
+        }
+        ProcessCommand(PrepareCommand(
+            CmdArgs{std::move(args)},
+            [this](const CommandPtr&, ReplyPtr tracking_reply) {
+              if (*tracking_reply && tracking_reply->data.IsStatus()) {
+                SetState(State::kConnected);
+                return;
+              }
+              LOG_LIMITED_ERROR()
+                  << log_extra_ << "CLIENT TRACKING failed: "
+                  << (*tracking_reply ? tracking_reply->data.ToDebugString()
+                                      : tracking_reply->status_string);
+              Disconnect();
+            }));
+      }));
+}
+
 void Redis::RedisImpl::OnRedisReply(redisAsyncContext* c, void* r,
                                     void* privdata) noexcept {
   auto* impl = static_cast<Redis::RedisImpl*>(c->data);
   UASSERT(impl != nullptr);
   try {
     if (r || c->err != REDIS_OK) {
-      impl->OnRedisReplyImpl(static_cast<redisReply*>(r), privdata, c->err,
+      impl->OnRedisReplyImpl(impl->MakeReplyData(r), privdata, c->err,
                              c->errstr);
     } else {
       // redisAsyncDisconnect causes empty replies with OK status,
       // translate to something sensible.
-      impl->OnRedisReplyImpl(nullptr, privdata, REDIS_ERR_EOF, "Disconnecting");
+      impl->OnRedisReplyImpl(impl->MakeReplyData(nullptr), privdata,
+                             REDIS_ERR_EOF, "Disconnecting");
     }
   } catch (const std::exception& ex) {
     LOG_ERROR() << "OnRedisReplyImpl() failed: " << ex;
   }
 }
 
-void Redis::RedisImpl::OnRedisReplyImpl(redisReply* redis_reply, void* privdata,
+ReplyData Redis::RedisImpl::MakeReplyData(void* redis_reply) const {
+  if (reply_data_objects_ && redis_reply) return TakeReplyData(redis_reply);
+  return ReplyData(static_cast<const redisReply*>(redis_reply));
+}
+
+void Redis::RedisImpl::OnRedisReplyImpl(ReplyData&& reply_data, void* privdata,
                                         int status, const char* errstr) {
   auto data = reply_privdata_.find(reinterpret_cast<size_t>(privdata));
   if (data == reply_privdata_.end()) return;
@@ -1131,7 +1376,7 @@ void Redis::RedisImpl::OnRedisReplyImpl(redisReply* redis_reply, void* privdata,
   ev_thread_control_.Stop(data->second->timer);
   pcommand = data->second.get();
 
-  auto reply = std::make_shared<Reply>(pcommand->cmd, redis_reply,
+  auto reply = std::make_shared<Reply>(pcommand->cmd, std::move(reply_data),
                                        NativeToReplyStatus(status),
                                        errstr ? errstr : "");
 
@@ -1143,7 +1388,7 @@ void Redis::RedisImpl::OnRedisReplyImpl(redisReply* redis_reply, void* privdata,
   // SUBSCRIBE request with the same channel name until the response to
   // UNSUBSCRIBE request is received. shard_subscriber::Fsm checks it.
   // TODO: add check in RedisImpl.
-  if (!subscriber_ || !redis_reply || IsUnsubscribeReply(reply)) {
+  if (!subscriber_ || !reply->data || IsUnsubscribeReply(reply)) {
     command_ptr = std::move(data->second);
     if (!subscriber_) --sent_count_;
 
@@ -1193,6 +1438,13 @@ void Redis::RedisImpl::ProcessCommand(const CommandPtr& command) {
     }
 
     const bool is_special = IsSubscribesCommand(args);
+    if (is_special && reply_data_objects_) {
+      LOG_ERROR() << log_extra_
+                  << "subscriptions require a subscriber connection: "
+                  << args[0];
+      InvokeCommandError(command, args[0], ReplyStatus::kOtherError);
+      continue;
+    }
     if (is_special) subscriber_ = true;
     if (subscriber_ && !is_special) {
       LOG_ERROR() << log_extra_ << "impossible for subscriber: " << args[0];
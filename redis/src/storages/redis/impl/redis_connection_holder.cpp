@@ -10,7 +10,8 @@ RedisConnectionHolder::RedisConnectionHolder(
     const std::string& host, uint16_t port, Password password,
     CommandsBufferingSettings buffering_settings,
     ReplicationMonitoringSettings replication_monitoring_settings,
-    utils::RetryBudgetSettings retry_budget_settings)
+    utils::RetryBudgetSettings retry_budget_settings,
+    ConnectionMode connection_mode)
     : commands_buffering_settings_(std::move(buffering_settings)),
       replication_monitoring_settings_(
           std::move(replication_monitoring_settings)),
@@ -20,6 +21,7 @@ RedisConnectionHolder::RedisConnectionHolder(
       host_(host),
       port_(port),
       password_(std::move(password)),
+      connection_mode_(connection_mode),
       connection_check_timer_(
           ev_thread_, [this] { EnsureConnected(); },
           kCheckRedisConnectedInterval) {
@@ -53,6 +55,8 @@ void RedisConnectionHolder::CreateConnection() {
   /// Here we allow read from replicas possibly stale data.
   /// This does not affect connections to masters
   settings.send_readonly = true;
+  settings.cluster_mode = true;
+  settings.connection_mode = connection_mode_;
   auto instance = std::make_shared<Redis>(redis_thread_pool_, settings);
   instance->signal_state_change.connect(
       [weak_ptr{weak_from_this()}](Redis::State state) {
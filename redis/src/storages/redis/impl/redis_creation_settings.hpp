@@ -1,6 +1,8 @@
 #pragma once
 
+#include <string>
 #include <unordered_map>
+#include <vector>
 
 #include <userver/storages/redis/impl/base.hpp>
 
@@ -11,6 +13,11 @@ namespace redis {
 struct RedisCreationSettings {
   ConnectionSecurity connection_security = ConnectionSecurity::kNone;
   bool send_readonly{false};
+  bool cluster_mode{false};
+  // Non-empty prefixes enable broadcasting CLIENT TRACKING on the connection
+  std::vector<std::string> client_tracking_prefixes;
+  // Replies of command connections are parsed right into ReplyData
+  ConnectionMode connection_mode = ConnectionMode::kCommands;
 };
 
 }  // namespace redis
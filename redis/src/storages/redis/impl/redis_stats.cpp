@@ -209,6 +209,11 @@ void DumpMetric(utils::statistics::Writer& writer,
   writer["reconnects"] = stats.reconnects.Load().value;
   writer["reconnects.v2"] = stats.reconnects;
 
+  // GET and HGET commands sent as parts of MGET and HMGET, the ratio of
+  // the two is the average number of reads merged into one command
+  writer["merged_commands"] = stats.merged_commands;
+  writer["merged_batches"] = stats.merged_batches;
+
   if (stats.settings.IsRequestSizesEnabled()) {
     writer["request_sizes"] = stats.request_size_percentile;
   }
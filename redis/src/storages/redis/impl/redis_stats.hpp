@@ -50,6 +50,8 @@ class Statistics {
   std::atomic_llong last_ping_ms{};
   std::atomic_bool is_syncing = false;
   std::atomic_size_t offset_from_master_bytes = 0;
+  utils::statistics::RateCounter merged_commands{0};
+  utils::statistics::RateCounter merged_batches{0};
 
   std::array<utils::statistics::RateCounter, kReplyStatusMap.size()>
       error_count{{}};
@@ -70,6 +72,8 @@ struct InstanceStatistics {
     is_syncing = other.is_syncing.load(std::memory_order_relaxed);
     offset_from_master =
         other.offset_from_master_bytes.load(std::memory_order_relaxed);
+    merged_commands = other.merged_commands;
+    merged_batches = other.merged_batches;
     for (size_t i = 0; i < error_count.size(); i++)
       error_count[i] = other.error_count[i];
     for (const auto& [command, timings] : other.command_timings_percentile) {
@@ -84,6 +88,8 @@ struct InstanceStatistics {
     request_size_percentile.Add(other.request_size_percentile);
     reply_size_percentile.Add(other.reply_size_percentile);
     timings_percentile.Add(other.timings_percentile);
+    merged_commands += other.merged_commands;
+    merged_batches += other.merged_batches;
 
     for (size_t i = 0; i < error_count.size(); i++)
       error_count[i] += other.error_count[i];
@@ -104,6 +110,8 @@ struct InstanceStatistics {
   long long last_ping_ms{};
   bool is_syncing{};
   long long offset_from_master{};
+  utils::statistics::RateCounter merged_commands{};
+  utils::statistics::RateCounter merged_batches{};
 
   std::array<utils::statistics::RateCounter, kReplyStatusMap.size()>
       error_count{{}};
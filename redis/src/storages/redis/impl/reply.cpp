@@ -17,12 +17,19 @@ namespace redis {
 ReplyData::ReplyData(const redisReply* reply) {
   if (!reply) return;
 
+  // RESP3 types are mapped onto the closest RESP2 ones
   switch (reply->type) {
     case REDIS_REPLY_STRING:
+    case REDIS_REPLY_DOUBLE:
+    case REDIS_REPLY_BIGNUM:
+    case REDIS_REPLY_VERB:
       type_ = Type::kString;
       string_ = std::string(reply->str, reply->len);
       break;
     case REDIS_REPLY_ARRAY:
+    case REDIS_REPLY_MAP:
+    case REDIS_REPLY_SET:
+    case REDIS_REPLY_PUSH:
       type_ = Type::kArray;
       array_.reserve(reply->elements);
       for (size_t i = 0; i < reply->elements; i++)
@@ -32,6 +39,10 @@ ReplyData::ReplyData(const redisReply* reply) {
       type_ = Type::kInteger;
       integer_ = reply->integer;
       break;
+    case REDIS_REPLY_BOOL:
+      type_ = Type::kInteger;
+      integer_ = reply->integer ? 1 : 0;
+      break;
     case REDIS_REPLY_NIL:
       type_ = Type::kNil;
       break;
@@ -273,6 +284,13 @@ Reply::Reply(std::string cmd, redisReply* redis_reply, ReplyStatus status,
 Reply::Reply(std::string cmd, ReplyData&& data)
     : cmd(std::move(cmd)), data(std::move(data)), status(ReplyStatus::kOk) {}
 
+Reply::Reply(std::string cmd, ReplyData&& data, ReplyStatus status,
+             std::string status_string)
+    : cmd(std::move(cmd)),
+      data(std::move(data)),
+      status(status),
+      status_string(std::move(status_string)) {}
+
 bool Reply::IsOk() const { return status == ReplyStatus::kOk; }
 
 bool Reply::IsLoggableError() const {
@@ -0,0 +1,150 @@
+#include <storages/redis/impl/reply_builder.hpp>
+
+#include <exception>
+#include <memory>
+#include <type_traits>
+
+#include <hiredis/hiredis.h>
+
+USERVER_NAMESPACE_BEGIN
+
+namespace redis {
+
+namespace {
+
+// hiredis looks into `type` and `str` of the replies that have no callback,
+// e.g. of the error sent on exceeding the server connections limit. So the
+// root objects start with a redisReply describing them.
+struct RootReply {
+  redisReply header;
+  ReplyData* data;
+};
+
+static_assert(std::is_standard_layout_v<RootReply>);
+
+}  // namespace
+
+class ReplyDataBuilder final {
+ public:
+  static void* CreateString(const redisReadTask* task, char* str,
+                            size_t len) noexcept {
+    return Create(task, [&](ReplyData& data) {
+      data.type_ = ToStringType(task->type);
+      data.string_.assign(str, len);
+    });
+  }
+
+  static void* CreateArray(const redisReadTask* task,
+                           size_t elements) noexcept {
+    return Create(task, [&](ReplyData& data) {
+      data.type_ = ReplyData::Type::kArray;
+      // Elements are referenced by hiredis while they are being filled, so
+      // the array must never reallocate
+      data.array_.reserve(elements);
+    });
+  }
+
+  static void* CreateInteger(const redisReadTask* task,
+                             long long value) noexcept {
+    return Create(task, [&](ReplyData& data) {
+      data.type_ = ReplyData::Type::kInteger;
+      data.integer_ = value;
+    });
+  }
+
+  // Doubles are kept in the textual form, the way RESP2 delivers them
+  static void* CreateDouble(const redisReadTask* task, double /*value*/,
+                            char* str, size_t len) noexcept {
+    return CreateString(task, str, len);
+  }
+
+  static void* CreateNil(const redisReadTask* task) noexcept {
+    return Create(task, [](ReplyData& data) {
+      data.type_ = ReplyData::Type::kNil;
+    });
+  }
+
+  static void* CreateBool(const redisReadTask* task, int value) noexcept {
+    return Create(task, [&](ReplyData& data) {
+      data.type_ = ReplyData::Type::kInteger;
+      data.integer_ = value ? 1 : 0;
+    });
+  }
+
+  static void FreeObject(void* reply) noexcept {
+    auto* root = static_cast<RootReply*>(reply);
+    delete root->data;
+    delete root;
+  }
+
+  static ReplyData Take(void* reply) {
+    auto* root = static_cast<RootReply*>(reply);
+    root->header.str = nullptr;
+    root->header.len = 0;
+    return std::move(*root->data);
+  }
+
+ private:
+  static ReplyData::Type ToStringType(int type) {
+    switch (type) {
+      case REDIS_REPLY_STATUS:
+        return ReplyData::Type::kStatus;
+      case REDIS_REPLY_ERROR:
+        return ReplyData::Type::kError;
+      default:
+        return ReplyData::Type::kString;
+    }
+  }
+
+  static ReplyData& GetParentData(const redisReadTask& task) {
+    const auto* parent = task.parent;
+    if (!parent->parent) return *static_cast<RootReply*>(parent->obj)->data;
+    return *static_cast<ReplyData*>(parent->obj);
+  }
+
+  // Returning nullptr makes hiredis fail the connection with an OOM error
+  template <typename Fill>
+  static void* Create(const redisReadTask* task, Fill fill) noexcept {
+    try {
+      ReplyData data;
+      fill(data);
+
+      if (task->parent) {
+        auto& array = GetParentData(*task).array_;
+        if (array.size() == array.capacity()) return nullptr;
+        array.push_back(std::move(data));
+        return &array.back();
+      }
+
+      auto root = std::make_unique<RootReply>();
+      root->data = new ReplyData(std::move(data));
+      root->header.type = task->type;
+      root->header.str = root->data->string_.data();
+      root->header.len = root->data->string_.size();
+      return root.release();
+    } catch (const std::exception&) {
+      return nullptr;
+    }
+  }
+};
+
+namespace {
+
+redisReplyObjectFunctions kReplyDataObjectFunctions{
+    ReplyDataBuilder::CreateString, ReplyDataBuilder::CreateArray,
+    ReplyDataBuilder::CreateInteger, ReplyDataBuilder::CreateDouble,
+    ReplyDataBuilder::CreateNil,     ReplyDataBuilder::CreateBool,
+    ReplyDataBuilder::FreeObject,
+};
+
+}  // namespace
+
+void UseReplyDataObjects(redisReader& reader) {
+  reader.fn = &kReplyDataObjectFunctions;
+}
+
+ReplyData TakeReplyData(void* reply) { return ReplyDataBuilder::Take(reply); }
+
+}  // namespace redis
+
+USERVER_NAMESPACE_END
@@ -0,0 +1,25 @@
+#pragma once
+
+#include <userver/storages/redis/impl/reply.hpp>
+
+struct redisReader;
+
+USERVER_NAMESPACE_BEGIN
+
+namespace redis {
+
+/// Makes `reader` build ReplyData right while parsing the input instead of a
+/// tree of redisReply objects, saving an allocation and a copy per element.
+/// Must be called before anything is fed to the reader.
+///
+/// Not suitable for subscriber connections, hiredis dispatches pubsub messages
+/// by walking the redisReply tree itself.
+void UseReplyDataObjects(redisReader& reader);
+
+/// Moves the data out of a reply produced by a reader set up with
+/// UseReplyDataObjects(). The reply itself is still freed by hiredis.
+ReplyData TakeReplyData(void* reply);
+
+}  // namespace redis
+
+USERVER_NAMESPACE_END
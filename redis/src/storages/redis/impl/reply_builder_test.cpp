@@ -0,0 +1,117 @@
+#include <storages/redis/impl/reply_builder.hpp>
+
+#include <memory>
+#include <optional>
+#include <string_view>
+
+#include <gtest/gtest.h>
+#include <hiredis/hiredis.h>
+
+USERVER_NAMESPACE_BEGIN
+
+namespace {
+
+using ReaderPtr = std::unique_ptr<redisReader, decltype(&redisReaderFree)>;
+
+ReaderPtr MakeReader(bool reply_data_objects) {
+  ReaderPtr reader{redisReaderCreate(), &redisReaderFree};
+  if (reply_data_objects) redis::UseReplyDataObjects(*reader);
+  return reader;
+}
+
+// Feeds the input byte by byte to check that partially parsed replies are
+// resumed correctly
+std::optional<redis::ReplyData> Parse(redisReader& reader,
+                                      std::string_view input,
+                                      bool reply_data_objects) {
+  for (const char c : input) {
+    EXPECT_EQ(redisReaderFeed(&reader, &c, 1), REDIS_OK);
+  }
+
+  void* reply = nullptr;
+  EXPECT_EQ(redisReaderGetReply(&reader, &reply), REDIS_OK);
+  if (!reply) return std::nullopt;
+
+  if (reply_data_objects) {
+    auto data = redis::TakeReplyData(reply);
+    reader.fn->freeObject(reply);
+    return data;
+  }
+  redis::ReplyData data{static_cast<const redisReply*>(reply)};
+  freeReplyObject(reply);
+  return data;
+}
+
+redis::ReplyData ParseBothWays(std::string_view input) {
+  auto tree_reader = MakeReader(false);
+  const auto expected = Parse(*tree_reader, input, false);
+
+  auto reader = MakeReader(true);
+  auto data = Parse(*reader, input, true);
+  EXPECT_TRUE(expected && data);
+  if (!expected || !data) return redis::ReplyData::CreateNil();
+
+  EXPECT_EQ(data->GetType(), expected->GetType());
+  EXPECT_EQ(data->ToDebugString(), expected->ToDebugString());
+  return std::move(*data);
+}
+
+}  // namespace
+
+TEST(ReplyBuilder, Scalars) {
+  EXPECT_EQ(ParseBothWays("$5\r\nvalue\r\n").GetString(), "value");
+  EXPECT_EQ(ParseBothWays("$0\r\n\r\n").GetString(), "");
+  EXPECT_EQ(ParseBothWays(":-42\r\n").GetInt(), -42);
+  EXPECT_EQ(ParseBothWays("+OK\r\n").GetStatus(), "OK");
+  EXPECT_EQ(ParseBothWays("-ERR wrong\r\n").GetError(), "ERR wrong");
+  EXPECT_TRUE(ParseBothWays("$-1\r\n").IsNil());
+  EXPECT_TRUE(ParseBothWays("*-1\r\n").IsNil());
+}
+
+TEST(ReplyBuilder, Arrays) {
+  EXPECT_TRUE(ParseBothWays("*0\r\n").GetArray().empty());
+
+  const auto data = ParseBothWays(
+      "*4\r\n$1\r\na\r\n*2\r\n:1\r\n*0\r\n$-1\r\n*2\r\n*1\r\n+x\r\n-e\r\n");
+  ASSERT_TRUE(data.IsArray());
+  ASSERT_EQ(data.GetArray().size(), 4U);
+  EXPECT_EQ(data[0].GetString(), "a");
+  EXPECT_EQ(data[1][0].GetInt(), 1);
+  EXPECT_TRUE(data[1][1].GetArray().empty());
+  EXPECT_TRUE(data[2].IsNil());
+  EXPECT_EQ(data[3][0][0].GetStatus(), "x");
+  EXPECT_EQ(data[3][1].GetError(), "e");
+}
+
+TEST(ReplyBuilder, Resp3) {
+  EXPECT_EQ(ParseBothWays(",1.5\r\n").GetString(), "1.5");
+  EXPECT_EQ(ParseBothWays("#t\r\n").GetInt(), 1);
+  EXPECT_EQ(ParseBothWays("#f\r\n").GetInt(), 0);
+  EXPECT_TRUE(ParseBothWays("_\r\n").IsNil());
+
+  const auto map = ParseBothWays("%1\r\n$1\r\nk\r\n$1\r\nv\r\n");
+  ASSERT_EQ(map.GetArray().size(), 2U);
+  EXPECT_EQ(map[0].GetString(), "k");
+  EXPECT_EQ(map[1].GetString(), "v");
+
+  EXPECT_EQ(ParseBothWays("~2\r\n:1\r\n:2\r\n").GetArray().size(), 2U);
+}
+
+TEST(ReplyBuilder, PipelinedReplies) {
+  auto reader = MakeReader(true);
+  const std::string_view input = "+OK\r\n*2\r\n$1\r\na\r\n$1\r\nb\r\n:7\r\n";
+  ASSERT_EQ(redisReaderFeed(reader.get(), input.data(), input.size()),
+            REDIS_OK);
+
+  EXPECT_EQ(Parse(*reader, {}, true)->GetStatus(), "OK");
+  EXPECT_EQ(Parse(*reader, {}, true)->GetArray().size(), 2U);
+  EXPECT_EQ(Parse(*reader, {}, true)->GetInt(), 7);
+  EXPECT_FALSE(Parse(*reader, {}, true));
+}
+
+TEST(ReplyBuilder, IncompleteReplyIsFreed) {
+  auto reader = MakeReader(true);
+  EXPECT_FALSE(Parse(*reader, "*3\r\n$1\r\na\r\n*2\r\n:1\r\n", true));
+}
+
+USERVER_NAMESPACE_END
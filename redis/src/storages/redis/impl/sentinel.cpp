@@ -56,8 +56,22 @@ void OnSubscribeImpl(std::string_view message_type,
                          reply_array[2].GetInt());
   } else if (!strcasecmp(reply_array[0].GetString().c_str(),
                          message_type.data())) {
-    message_callback(reply->server_id, reply_array[1].GetString(),
-                     reply_array[2].GetString());
+    const auto& payload = reply_array[2];
+    if (payload.IsString()) {
+      message_callback(reply->server_id, reply_array[1].GetString(),
+                       payload.GetString());
+    } else if (payload.IsArray()) {
+      // CLIENT TRACKING invalidations carry an array of keys, deliver them
+      // one by one
+      for (const auto& key : payload.GetArray()) {
+        if (!key.IsString()) continue;
+        message_callback(reply->server_id, reply_array[1].GetString(),
+                         key.GetString());
+      }
+    } else if (payload.IsNil()) {
+      // CLIENT TRACKING invalidation of all the keys, e.g. after FLUSHALL
+      message_callback(reply->server_id, reply_array[1].GetString(), {});
+    }
   }
 }
 
@@ -71,7 +85,8 @@ Sentinel::Sentinel(
     ConnectionSecurity connection_security, ReadyChangeCallback ready_callback,
     dynamic_config::Source dynamic_config_source,
     std::unique_ptr<KeyShard>&& key_shard, CommandControl command_control,
-    const testsuite::RedisControl& testsuite_redis_control, ConnectionMode mode)
+    const testsuite::RedisControl& testsuite_redis_control, ConnectionMode mode,
+    std::vector<std::string> client_tracking_prefixes)
     : thread_pools_(thread_pools),
       secdist_default_command_control_(command_control),
       testsuite_redis_control_(testsuite_redis_control) {
@@ -86,6 +101,8 @@ Sentinel::Sentinel(
 
   sentinel_thread_control_->RunInEvLoopBlocking([&]() {
     if (!key_shard) {
+      UINVARIANT(client_tracking_prefixes.empty(),
+                 "Client tracking is not supported in cluster mode");
       impl_ = std::make_unique<ClusterSentinelImpl>(
           *sentinel_thread_control_, thread_pools_->GetRedisThreadPool(), *this,
           shards, conns, std::move(shard_group_name), client_name, password,
@@ -96,7 +113,7 @@ Sentinel::Sentinel(
           *sentinel_thread_control_, thread_pools_->GetRedisThreadPool(), *this,
           shards, conns, std::move(shard_group_name), client_name, password,
           connection_security, std::move(ready_callback), std::move(key_shard),
-          dynamic_config_source, mode);
+          dynamic_config_source, mode, std::move(client_tracking_prefixes));
     }
   });
 }
@@ -4,7 +4,6 @@
 #include <sstream>
 #include <thread>
 
-#include <boost/crc.hpp>
 
 #include <fmt/format.h>
 
@@ -63,7 +62,8 @@ SentinelImpl::SentinelImpl(
     const std::string& client_name, const Password& password,
     ConnectionSecurity connection_security, ReadyChangeCallback ready_callback,
     std::unique_ptr<KeyShard>&& key_shard,
-    dynamic_config::Source dynamic_config_source, ConnectionMode mode)
+    dynamic_config::Source dynamic_config_source, ConnectionMode mode,
+    std::vector<std::string> client_tracking_prefixes)
     : sentinel_obj_(sentinel),
       ev_thread_(sentinel_thread_control),
       shard_group_name_(std::move(shard_group_name)),
@@ -78,7 +78,8 @@ SentinelImpl::SentinelImpl(
       key_shard_(std::move(key_shard)),
       connection_mode_(mode),
       slot_info_(IsInClusterMode() ? std::make_unique<SlotInfo>() : nullptr),
-      dynamic_config_source_(dynamic_config_source) {
+      dynamic_config_source_(dynamic_config_source),
+      client_tracking_prefixes_(std::move(client_tracking_prefixes)) {
   for (size_t i = 0; i < init_shards_->size(); ++i) {
     shards_[(*init_shards_)[i]] = i;
     connected_statuses_.push_back(std::make_unique<ConnectedStatus>());
@@ -191,6 +192,8 @@ void SentinelImpl::InitShards(
                                            ready_callback](bool ready) {
       if (ready_callback) ready_callback(i, shard, ready);
     };
+    shard_options.client_tracking_prefixes = client_tracking_prefixes_;
+    shard_options.connection_mode = connection_mode_;
     auto object = std::make_shared<Shard>(std::move(shard_options));
     object->SignalInstanceStateChange().connect(
         [this](ServerId, Redis::State state) {
@@ -941,15 +944,6 @@ size_t SentinelImpl::ParseMovedShard(const std::string& err_string) {
   return shard_info_.GetShard(host, port);
 }
 
-size_t SentinelImpl::HashSlot(const std::string& key) {
-  size_t start = 0;
-  size_t len = 0;
-  GetRedisKey(key, &start, &len);
-  return std::for_each(key.data() + start, key.data() + start + len,
-                       boost::crc_optimal<16, 0x1021>())() &
-         0x3fff;
-}
-
 SentinelImpl::SlotInfo::SlotInfo() {
   for (size_t i = 0; i < kClusterHashSlots; ++i) {
     slot_to_shard_[i] = kUnknownShard;
@@ -112,7 +112,8 @@ class SentinelImpl : public SentinelImplBase {
                ReadyChangeCallback ready_callback,
                std::unique_ptr<KeyShard>&& key_shard,
                dynamic_config::Source dynamic_config_source,
-               ConnectionMode mode = ConnectionMode::kCommands);
+               ConnectionMode mode = ConnectionMode::kCommands,
+               std::vector<std::string> client_tracking_prefixes = {});
   ~SentinelImpl() override;
 
   std::unordered_map<ServerId, size_t, ServerIdHasher>
@@ -242,8 +243,6 @@ class SentinelImpl : public SentinelImplBase {
                   std::vector<std::shared_ptr<Shard>>& shard_objects,
                   const ReadyChangeCallback& ready_callback);
 
-  static size_t HashSlot(const std::string& key);
-
   void ProcessWaitingCommands();
 
   Sentinel& sentinel_obj_;
@@ -285,6 +284,7 @@ class SentinelImpl : public SentinelImplBase {
   std::optional<CommandsBufferingSettings> commands_buffering_settings_;
   dynamic_config::Source dynamic_config_source_;
   std::atomic<int> publish_shard_{0};
+  const std::vector<std::string> client_tracking_prefixes_;
 };
 
 }  // namespace redis
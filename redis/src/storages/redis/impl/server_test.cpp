@@ -1,5 +1,8 @@
 #include "mock_server_test.hpp"
 
+#include <atomic>
+#include <map>
+#include <mutex>
 #include <thread>
 
 #include <userver/storages/redis/impl/base.hpp>
@@ -184,4 +187,100 @@ TEST_P(RedisDisconnectingReplies, X) {
   PeriodicWait([&] { return !IsConnected(*redis); });
 }
 
+TEST(Redis, MergeSingleKeyReads) {
+  MockRedisServer server;
+  auto ping_handler = server.RegisterPingHandler();
+  auto mget_handler = server.RegisterHandlerWithConstReply(
+      "MGET", redis::ReplyData::Array{redis::ReplyData{"value1"},
+                                      redis::ReplyData{"value2"},
+                                      redis::ReplyData{"value3"}});
+
+  auto pool = std::make_shared<redis::ThreadPools>(1, 1);
+  redis::RedisCreationSettings redis_settings;
+  auto redis = std::make_shared<redis::Redis>(pool->GetRedisThreadPool(),
+                                              redis_settings);
+  redis::CommandsBufferingSettings buffering_settings;
+  buffering_settings.buffering_enabled = true;
+  buffering_settings.watch_command_timer_interval = kWaitPeriod;
+  buffering_settings.merge_single_key_reads = true;
+  redis->SetCommandsBufferingSettings(buffering_settings);
+  redis->Connect({kLocalhost}, server.GetPort(), redis::Password(""));
+
+  EXPECT_TRUE(ping_handler->WaitForFirstReply(kSmallPeriod));
+  PeriodicWait([&] { return IsConnected(*redis); });
+
+  std::mutex mutex;
+  std::map<std::string, std::string> values;
+  for (const std::string key : {"key1", "key2", "key3"}) {
+    redis->AsyncCommand(redis::PrepareCommand(
+        {"GET", key},
+        [&mutex, &values, key](const redis::CommandPtr&,
+                               redis::ReplyPtr reply) {
+          ASSERT_TRUE(reply->IsOk());
+          ASSERT_TRUE(reply->data.IsString());
+          const std::lock_guard lock{mutex};
+          values.emplace(key, reply->data.GetString());
+        }));
+  }
+
+  PeriodicWait([&] {
+    const std::lock_guard lock{mutex};
+    return values.size() == 3;
+  });
+  EXPECT_EQ(mget_handler->GetReplyCount(), 1);
+
+  const std::lock_guard lock{mutex};
+  EXPECT_EQ(values, (std::map<std::string, std::string>{
+                        {"key1", "value1"},
+                        {"key2", "value2"},
+                        {"key3", "value3"},
+                    }));
+}
+
+TEST(Redis, AdaptiveBufferingLowLoad) {
+  MockRedisServer server;
+  auto ping_handler = server.RegisterPingHandler();
+  auto get_handler =
+      server.RegisterHandlerWithConstReply("GET", redis::ReplyData{"value"});
+
+  auto pool = std::make_shared<redis::ThreadPools>(1, 1);
+  redis::RedisCreationSettings redis_settings;
+  auto redis = std::make_shared<redis::Redis>(pool->GetRedisThreadPool(),
+                                              redis_settings);
+  // Without adaptive buffering each command would wait for the interval
+  redis::CommandsBufferingSettings buffering_settings;
+  buffering_settings.buffering_enabled = true;
+  buffering_settings.watch_command_timer_interval = std::chrono::seconds{10};
+  buffering_settings.adaptive_buffering_enabled = true;
+  redis->SetCommandsBufferingSettings(buffering_settings);
+  redis->Connect({kLocalhost}, server.GetPort(), redis::Password(""));
+
+  EXPECT_TRUE(ping_handler->WaitForFirstReply(kSmallPeriod));
+  PeriodicWait([&] { return IsConnected(*redis); });
+
+  // The socket RTT is taken before the periodic pings, the buffering interval
+  // is not adapted until it is known
+  const auto rtt_deadline =
+      std::chrono::steady_clock::now() + std::chrono::seconds{10};
+  while (ping_handler->GetReplyCount() < 2 &&
+         std::chrono::steady_clock::now() < rtt_deadline) {
+    std::this_thread::sleep_for(kWaitPeriod);
+  }
+  ASSERT_GE(ping_handler->GetReplyCount(), 2);
+
+  // A single command at a time is sent right away, as no other commands are
+  // expected to be buffered with it
+  for (int i = 0; i < 3; ++i) {
+    std::atomic<bool> replied{false};
+    redis->AsyncCommand(redis::PrepareCommand(
+        {"GET", "key"}, [&replied](const redis::CommandPtr&,
+                                   redis::ReplyPtr reply) {
+          EXPECT_TRUE(reply->IsOk());
+          replied = true;
+        }));
+    PeriodicWait([&] { return replied.load(); });
+  }
+  EXPECT_EQ(get_handler->GetReplyCount(), 3);
+}
+
 USERVER_NAMESPACE_END
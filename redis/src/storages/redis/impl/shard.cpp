@@ -70,7 +70,9 @@ Shard::Shard(Options options)
     : shard_name_(std::move(options.shard_name)),
       shard_group_name_(std::move(options.shard_group_name)),
       ready_change_callback_(std::move(options.ready_change_callback)),
-      cluster_mode_(options.cluster_mode) {
+      cluster_mode_(options.cluster_mode),
+      client_tracking_prefixes_(std::move(options.client_tracking_prefixes)),
+      connection_mode_(options.connection_mode) {
   for (const auto& conn : options.connection_infos) {
     connection_infos_.emplace_back(conn);
   }
@@ -293,7 +295,8 @@ bool Shard::ProcessCreation(
   // NOLINTNEXTLINE(clang-analyzer-cplusplus.NewDelete)
   for (const auto& id : need_to_create) {
     const auto redis_settings = RedisCreationSettings{
-        id.GetConnectionSecurity(), cluster_mode_ && id.IsReadOnly()};
+        id.GetConnectionSecurity(), cluster_mode_ && id.IsReadOnly(),
+        cluster_mode_, client_tracking_prefixes_, connection_mode_};
     ConnectionStatus entry{
         id, std::make_shared<Redis>(
                 redis_thread_pool,
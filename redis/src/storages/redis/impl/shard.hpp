@@ -65,6 +65,8 @@ class Shard {
     bool cluster_mode{false};
     std::function<void(bool ready)> ready_change_callback;
     std::vector<ConnectionInfo> connection_infos;
+    std::vector<std::string> client_tracking_prefixes;
+    ConnectionMode connection_mode{ConnectionMode::kCommands};
   };
 
   explicit Shard(Options options);
@@ -138,6 +140,8 @@ class Shard {
 
   bool prev_connected_ = false;
   const bool cluster_mode_ = false;
+  const std::vector<std::string> client_tracking_prefixes_;
+  const ConnectionMode connection_mode_;
 };
 
 }  // namespace redis
@@ -43,11 +43,13 @@ SubscribeSentinel::SubscribeSentinel(
     ConnectionSecurity connection_security, ReadyChangeCallback ready_callback,
     std::unique_ptr<KeyShard>&& key_shard, bool is_cluster_mode,
     CommandControl command_control,
-    const testsuite::RedisControl& testsuite_redis_control)
+    const testsuite::RedisControl& testsuite_redis_control,
+    std::vector<std::string> client_tracking_prefixes)
     : Sentinel(thread_pools, shards, conns, std::move(shard_group_name),
                client_name, password, connection_security, ready_callback,
                dynamic_config_source, std::move(key_shard), command_control,
-               testsuite_redis_control, ConnectionMode::kSubscriber),
+               testsuite_redis_control, ConnectionMode::kSubscriber,
+               std::move(client_tracking_prefixes)),
       thread_pools_(thread_pools),
       storage_(
           CreateSubscriptionStorage(thread_pools, shards, is_cluster_mode)),
@@ -88,7 +90,8 @@ std::shared_ptr<SubscribeSentinel> SubscribeSentinel::Create(
     dynamic_config::Source dynamic_config_source,
     const std::string& client_name, bool is_cluster_mode,
     const CommandControl& command_control,
-    const testsuite::RedisControl& testsuite_redis_control) {
+    const testsuite::RedisControl& testsuite_redis_control,
+    std::vector<std::string> client_tracking_prefixes) {
   auto ready_callback = [](size_t shard, const std::string& shard_name,
                            bool ready) {
     LOG_INFO() << "redis: ready_callback:"
@@ -99,7 +102,8 @@ std::shared_ptr<SubscribeSentinel> SubscribeSentinel::Create(
   // NOLINTNEXTLINE(clang-analyzer-cplusplus.NewDelete)
   return Create(thread_pools, settings, std::move(shard_group_name),
                 dynamic_config_source, client_name, std::move(ready_callback),
-                is_cluster_mode, command_control, testsuite_redis_control);
+                is_cluster_mode, command_control, testsuite_redis_control,
+                std::move(client_tracking_prefixes));
 }
 
 std::shared_ptr<SubscribeSentinel> SubscribeSentinel::Create(
@@ -108,7 +112,8 @@ std::shared_ptr<SubscribeSentinel> SubscribeSentinel::Create(
     dynamic_config::Source dynamic_config_source,
     const std::string& client_name, ReadyChangeCallback ready_callback,
     bool is_cluster_mode, const CommandControl& command_control,
-    const testsuite::RedisControl& testsuite_redis_control) {
+    const testsuite::RedisControl& testsuite_redis_control,
+    std::vector<std::string> client_tracking_prefixes) {
   const auto& password = settings.password;
 
   const std::vector<std::string>& shards = settings.shards;
@@ -136,7 +141,8 @@ std::shared_ptr<SubscribeSentinel> SubscribeSentinel::Create(
       dynamic_config_source, client_name, password, settings.secure_connection,
       std::move(ready_callback),
       (is_cluster_mode ? nullptr : std::make_unique<KeyShardZero>()),
-      is_cluster_mode, command_control, testsuite_redis_control);
+      is_cluster_mode, command_control, testsuite_redis_control,
+      std::move(client_tracking_prefixes));
   subscribe_sentinel->Start();
   return subscribe_sentinel;
 }
@@ -0,0 +1,251 @@
+#include <userver/storages/redis/near_cache.hpp>
+
+#include <list>
+#include <unordered_map>
+
+#include <userver/engine/mutex.hpp>
+#include <userver/logging/log.hpp>
+#include <userver/storages/redis/client.hpp>
+#include <userver/storages/redis/subscribe_client.hpp>
+#include <userver/utils/assert.hpp>
+#include <userver/utils/scope_guard.hpp>
+#include <userver/utils/statistics/rate.hpp>
+#include <userver/utils/statistics/writer.hpp>
+
+USERVER_NAMESPACE_BEGIN
+
+namespace storages::redis {
+
+class NearCache::PrefixCache final {
+ public:
+  using CachedValue = std::optional<std::string>;
+
+  explicit PrefixCache(NearCachePrefixSettings settings)
+      : settings_(std::move(settings)) {}
+
+  const std::string& Prefix() const { return settings_.prefix; }
+
+  std::optional<CachedValue> Find(const std::string& key) {
+    const std::lock_guard lock{mutex_};
+    const auto it = entries_.find(key);
+    if (it == entries_.end()) {
+      ++misses_;
+      return std::nullopt;
+    }
+    if (it->second.expires_at <= std::chrono::steady_clock::now()) {
+      Erase(it);
+      ++misses_;
+      return std::nullopt;
+    }
+    lru_.splice(lru_.begin(), lru_, it->second.lru_it);
+    ++hits_;
+    return std::optional<CachedValue>{std::in_place, it->second.value};
+  }
+
+  std::uint64_t StartFill(const std::string& key) {
+    const std::lock_guard lock{mutex_};
+    const auto fill_id = ++last_fill_id_;
+    pending_fills_[key] = fill_id;
+    return fill_id;
+  }
+
+  void CancelFill(const std::string& key, std::uint64_t fill_id) {
+    const std::lock_guard lock{mutex_};
+    const auto it = pending_fills_.find(key);
+    if (it != pending_fills_.end() && it->second == fill_id) {
+      pending_fills_.erase(it);
+    }
+  }
+
+  // Stores the value only if no invalidation of `key` was received since the
+  // matching StartFill(), otherwise the value may be already stale.
+  void FinishFill(const std::string& key, std::uint64_t fill_id,
+                  const CachedValue& value) {
+    const auto entry_size = EntrySize(key, value);
+    const std::lock_guard lock{mutex_};
+    const auto fill_it = pending_fills_.find(key);
+    if (fill_it == pending_fills_.end() || fill_it->second != fill_id) return;
+    pending_fills_.erase(fill_it);
+
+    const auto it = entries_.find(key);
+    if (it != entries_.end()) Erase(it);
+    if (entry_size > settings_.max_size_bytes) return;
+
+    while (size_bytes_ + entry_size > settings_.max_size_bytes) {
+      UASSERT(!lru_.empty());
+      Erase(entries_.find(lru_.back()));
+      ++evictions_;
+    }
+
+    const auto expires_at = std::chrono::steady_clock::now() + settings_.ttl;
+    lru_.push_front(key);
+    entries_.emplace(key, Entry{value, entry_size, expires_at, lru_.begin()});
+    size_bytes_ += entry_size;
+  }
+
+  void Invalidate(const std::string& key) {
+    const std::lock_guard lock{mutex_};
+    ++invalidations_;
+    pending_fills_.erase(key);
+    const auto it = entries_.find(key);
+    if (it != entries_.end()) Erase(it);
+  }
+
+  void Clear() {
+    const std::lock_guard lock{mutex_};
+    ++invalidations_;
+    pending_fills_.clear();
+    entries_.clear();
+    lru_.clear();
+    size_bytes_ = 0;
+  }
+
+  NearCachePrefixStatistics GetStatistics() const {
+    const std::lock_guard lock{mutex_};
+    NearCachePrefixStatistics stats;
+    stats.hits = hits_;
+    stats.misses = misses_;
+    stats.invalidations = invalidations_;
+    stats.evictions = evictions_;
+    stats.entries = entries_.size();
+    stats.size_bytes = size_bytes_;
+    return stats;
+  }
+
+ private:
+  using LruList = std::list<std::string>;
+
+  struct Entry {
+    CachedValue value;
+    std::size_t size_bytes{0};
+    std::chrono::steady_clock::time_point expires_at;
+    LruList::iterator lru_it;
+  };
+
+  using Entries = std::unordered_map<std::string, Entry>;
+
+  // The key is stored both in the map and in the LRU list
+  static std::size_t EntrySize(const std::string& key,
+                               const CachedValue& value) {
+    return sizeof(Entries::value_type) + sizeof(LruList::value_type) +
+           key.size() * 2 + (value ? value->size() : 0);
+  }
+
+  void Erase(Entries::iterator it) {
+    size_bytes_ -= it->second.size_bytes;
+    lru_.erase(it->second.lru_it);
+    entries_.erase(it);
+  }
+
+  const NearCachePrefixSettings settings_;
+
+  mutable engine::Mutex mutex_;
+  Entries entries_;
+  LruList lru_;
+  std::unordered_map<std::string, std::uint64_t> pending_fills_;
+  std::uint64_t last_fill_id_{0};
+  std::size_t size_bytes_{0};
+
+  std::uint64_t hits_{0};
+  std::uint64_t misses_{0};
+  std::uint64_t invalidations_{0};
+  std::uint64_t evictions_{0};
+};
+
+NearCache::NearCache(ClientPtr client, SubscribeClientPtr subscribe_client,
+                     NearCacheSettings settings)
+    : client_(std::move(client)),
+      subscribe_client_(std::move(subscribe_client)) {
+  UINVARIANT(client_ && subscribe_client_, "NearCache requires both clients");
+  prefix_caches_.reserve(settings.prefixes.size());
+  for (auto& prefix_settings : settings.prefixes) {
+    prefix_caches_.push_back(
+        std::make_unique<PrefixCache>(std::move(prefix_settings)));
+  }
+
+  invalidate_token_ = subscribe_client_->Subscribe(
+      std::string{kInvalidateChannel},
+      [this](const std::string&, const std::string& key) {
+        OnInvalidate(key);
+      });
+}
+
+NearCache::~NearCache() { invalidate_token_.Unsubscribe(); }
+
+std::optional<std::string> NearCache::Get(
+    std::string key, const CommandControl& command_control) {
+  auto* prefix_cache = FindPrefixCache(key);
+  if (!prefix_cache) return client_->Get(std::move(key), command_control).Get();
+
+  auto cached = prefix_cache->Find(key);
+  if (cached) return std::move(*cached);
+
+  // A lagging replica may return the value that was modified before the fill
+  // started, its invalidation would not prevent storing it
+  auto fill_command_control = command_control;
+  fill_command_control.force_request_to_master = true;
+
+  const auto fill_id = prefix_cache->StartFill(key);
+  utils::ScopeGuard cancel_fill(
+      [&] { prefix_cache->CancelFill(key, fill_id); });
+  auto value = client_->Get(key, fill_command_control).Get();
+  cancel_fill.Release();
+  prefix_cache->FinishFill(key, fill_id, value);
+  return value;
+}
+
+void NearCache::Clear() {
+  for (auto& prefix_cache : prefix_caches_) prefix_cache->Clear();
+}
+
+NearCachePrefixStatistics NearCache::GetStatistics(
+    std::string_view prefix) const {
+  for (const auto& prefix_cache : prefix_caches_) {
+    if (prefix_cache->Prefix() == prefix) return prefix_cache->GetStatistics();
+  }
+  return {};
+}
+
+NearCache::PrefixCache* NearCache::FindPrefixCache(std::string_view key) const {
+  for (const auto& prefix_cache : prefix_caches_) {
+    if (key.substr(0, prefix_cache->Prefix().size()) ==
+        prefix_cache->Prefix()) {
+      return prefix_cache.get();
+    }
+  }
+  return nullptr;
+}
+
+void NearCache::OnInvalidate(const std::string& key) {
+  // An empty message is delivered when all the keys are invalidated at once,
+  // e.g. after FLUSHALL
+  if (key.empty()) {
+    LOG_INFO() << "Redis near cache is invalidated as a whole";
+    Clear();
+    return;
+  }
+
+  auto* prefix_cache = FindPrefixCache(key);
+  if (prefix_cache) prefix_cache->Invalidate(key);
+}
+
+void DumpMetric(utils::statistics::Writer& writer,
+                const NearCachePrefixStatistics& stats) {
+  writer["hits"] = utils::statistics::Rate{stats.hits};
+  writer["misses"] = utils::statistics::Rate{stats.misses};
+  writer["invalidations"] = utils::statistics::Rate{stats.invalidations};
+  writer["evictions"] = utils::statistics::Rate{stats.evictions};
+  writer["entries"] = stats.entries;
+  writer["size_bytes"] = stats.size_bytes;
+}
+
+void DumpMetric(utils::statistics::Writer& writer, const NearCache& cache) {
+  for (const auto& prefix_cache : cache.prefix_caches_) {
+    writer.ValueWithLabels(prefix_cache->GetStatistics(),
+                           {"redis_key_prefix", prefix_cache->Prefix()});
+  }
+}
+
+}  // namespace storages::redis
+
+USERVER_NAMESPACE_END
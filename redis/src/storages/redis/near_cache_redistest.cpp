@@ -0,0 +1,158 @@
+#include <storages/redis/client_redistest.hpp>
+
+#include <userver/engine/deadline.hpp>
+#include <userver/engine/sleep.hpp>
+#include <userver/storages/redis/near_cache.hpp>
+
+USERVER_NAMESPACE_BEGIN
+
+namespace {
+
+const std::string kPrefix = "near:";
+constexpr std::chrono::seconds kMaxWait{15};
+
+class RedisNearCacheTest : public RedisClientTest {
+ public:
+  void SetUp() override {
+    RedisClientTest::SetUp();
+    if (!CheckVersion(kSince)) {
+      GTEST_SKIP() << SkipMsgByVersion("CLIENT TRACKING", kSince);
+    }
+  }
+
+ protected:
+  std::unique_ptr<storages::redis::NearCache> MakeNearCache(
+      std::size_t max_size_bytes = 1 << 20) {
+    storages::redis::NearCacheSettings settings;
+    settings.prefixes.push_back(
+        {kPrefix, max_size_bytes, std::chrono::hours{1}});
+    auto near_cache = std::make_unique<storages::redis::NearCache>(
+        GetClient(), MakeTrackingSubscribeClient({kPrefix}), settings);
+    WaitInvalidationsFlow(*near_cache);
+    return near_cache;
+  }
+
+  // Subscription happens asynchronously, keep modifying a probe key until its
+  // invalidation arrives
+  void WaitInvalidationsFlow(storages::redis::NearCache& near_cache) {
+    const auto deadline = engine::Deadline::FromDuration(kMaxWait);
+    while (near_cache.GetStatistics(kPrefix).invalidations == 0) {
+      ASSERT_FALSE(deadline.IsReached()) << "No invalidations received";
+      GetClient()->Set(kPrefix + "probe", "value", {}).Get();
+      engine::SleepFor(std::chrono::milliseconds{100});
+    }
+  }
+
+  // Waits for the invalidation of the modified key, so that it does not race
+  // with the following reads
+  void SetAndWaitInvalidation(storages::redis::NearCache& near_cache,
+                              const std::string& key,
+                              const std::string& value) {
+    const auto invalidations = near_cache.GetStatistics(kPrefix).invalidations;
+    GetClient()->Set(key, value, {}).Get();
+    const auto deadline = engine::Deadline::FromDuration(kMaxWait);
+    while (near_cache.GetStatistics(kPrefix).invalidations == invalidations) {
+      ASSERT_FALSE(deadline.IsReached()) << "No invalidation of " << key;
+      engine::SleepFor(std::chrono::milliseconds{10});
+    }
+  }
+
+  static void WaitValue(storages::redis::NearCache& near_cache,
+                        const std::string& key,
+                        const std::optional<std::string>& expected) {
+    const auto deadline = engine::Deadline::FromDuration(kMaxWait);
+    while (near_cache.Get(key, {}) != expected) {
+      ASSERT_FALSE(deadline.IsReached()) << "Stale value of " << key;
+      engine::SleepFor(std::chrono::milliseconds{10});
+    }
+  }
+
+ private:
+  static constexpr Version kSince{6, 0, 0};
+};
+
+}  // namespace
+
+UTEST_F(RedisNearCacheTest, HitAfterMiss) {
+  auto near_cache = MakeNearCache();
+  const auto key = kPrefix + "key";
+  SetAndWaitInvalidation(*near_cache, key, "value");
+
+  const auto before = near_cache->GetStatistics(kPrefix);
+  EXPECT_EQ(near_cache->Get(key, {}), "value");
+  EXPECT_EQ(near_cache->Get(key, {}), "value");
+  EXPECT_EQ(near_cache->Get(key, {}), "value");
+  const auto after = near_cache->GetStatistics(kPrefix);
+  EXPECT_EQ(after.misses, before.misses + 1);
+  EXPECT_EQ(after.hits, before.hits + 2);
+  EXPECT_EQ(after.entries, 1U);
+}
+
+UTEST_F(RedisNearCacheTest, Invalidation) {
+  auto near_cache = MakeNearCache();
+  const auto key = kPrefix + "key";
+  GetClient()->Set(key, "old", {}).Get();
+  WaitValue(*near_cache, key, "old");
+
+  GetClient()->Set(key, "new", {}).Get();
+  WaitValue(*near_cache, key, "new");
+
+  GetClient()->Del(key, {}).Get();
+  WaitValue(*near_cache, key, std::nullopt);
+}
+
+// Replicas may lag behind the instance that sends the invalidations, the
+// cache must not be filled from them
+UTEST_F(RedisNearCacheTest, ReadAfterInvalidation) {
+  auto near_cache = MakeNearCache();
+  const auto key = kPrefix + "key";
+  for (int i = 0; i < 20; ++i) {
+    const auto value = "value-" + std::to_string(i);
+    SetAndWaitInvalidation(*near_cache, key, value);
+    EXPECT_EQ(near_cache->Get(key, {}), value);
+    EXPECT_EQ(near_cache->Get(key, {}), value);
+  }
+}
+
+UTEST_F(RedisNearCacheTest, Flush) {
+  auto near_cache = MakeNearCache();
+  const auto key = kPrefix + "key";
+  GetClient()->Set(key, "value", {}).Get();
+  WaitValue(*near_cache, key, "value");
+
+  GetSentinel()->MakeRequest({"flushdb"}, "none", true).Get();
+  WaitValue(*near_cache, key, std::nullopt);
+}
+
+UTEST_F(RedisNearCacheTest, OtherKeysAreNotCached) {
+  auto near_cache = MakeNearCache();
+  GetClient()->Set("far:key", "value", {}).Get();
+
+  // Other keys are read as requested, replicas may lag behind the write
+  redis::CommandControl master_cc;
+  master_cc.force_request_to_master = true;
+
+  const auto before = near_cache->GetStatistics(kPrefix);
+  EXPECT_EQ(near_cache->Get("far:key", master_cc), "value");
+  const auto after = near_cache->GetStatistics(kPrefix);
+  EXPECT_EQ(after.hits, before.hits);
+  EXPECT_EQ(after.misses, before.misses);
+}
+
+UTEST_F(RedisNearCacheTest, MemoryBound) {
+  constexpr std::size_t kMaxSizeBytes = 4096;
+  auto near_cache = MakeNearCache(kMaxSizeBytes);
+  const std::string value(512, 'x');
+  for (int i = 0; i < 32; ++i) {
+    const auto key = kPrefix + std::to_string(i);
+    SetAndWaitInvalidation(*near_cache, key, value);
+    EXPECT_EQ(near_cache->Get(key, {}), value);
+  }
+
+  const auto stats = near_cache->GetStatistics(kPrefix);
+  EXPECT_LE(stats.size_bytes, kMaxSizeBytes);
+  EXPECT_GT(stats.entries, 0U);
+  EXPECT_GT(stats.evictions, 0U);
+}
+
+USERVER_NAMESPACE_END
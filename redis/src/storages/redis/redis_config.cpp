@@ -93,6 +93,10 @@ USERVER_NAMESPACE::redis::CommandsBufferingSettings Parse(
       elem["commands_buffering_threshold"].As<size_t>(0);
   result.watch_command_timer_interval = std::chrono::microseconds(
       elem["watch_command_timer_interval_us"].As<size_t>());
+  result.adaptive_buffering_enabled =
+      elem["adaptive_buffering_enabled"].As<bool>(false);
+  result.merge_single_key_reads =
+      elem["merge_single_key_reads"].As<bool>(false);
   return result;
 }
 
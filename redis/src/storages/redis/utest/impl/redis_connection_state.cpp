@@ -6,6 +6,7 @@
 #include <userver/dynamic_config/test_helpers.hpp>
 #include <userver/formats/json/serialize.hpp>
 #include <userver/storages/redis/impl/secdist_redis.hpp>
+#include <userver/utils/assert.hpp>
 #include <userver/utils/text.hpp>
 
 #include <storages/redis/impl/keyshard_impl.hpp>
@@ -145,6 +146,18 @@ RedisConnectionState::RedisConnectionState() {
       std::make_shared<SubscribeClientImpl>(subscribe_sentinel_);
 }
 
+SubscribeClientPtr RedisConnectionState::MakeTrackingSubscribeClient(
+    std::vector<std::string> client_tracking_prefixes) const {
+  UINVARIANT(!subscribe_sentinel_->IsInClusterMode(),
+             "Client tracking is not supported in cluster mode");
+  auto subscribe_sentinel = SubscribeSentinel::Create(
+      thread_pools_, GetRedisSettings(), "none",
+      dynamic_config::GetDefaultSource(), "pub", false, {}, {},
+      std::move(client_tracking_prefixes));
+  subscribe_sentinel->WaitConnectedDebug();
+  return std::make_shared<SubscribeClientImpl>(std::move(subscribe_sentinel));
+}
+
 RedisConnectionState::RedisConnectionState(InClusterMode) {
   auto configs_source = GetClusterDynamicConfigSource();
 
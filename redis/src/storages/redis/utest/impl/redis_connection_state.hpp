@@ -1,5 +1,8 @@
 #pragma once
 
+#include <string>
+#include <vector>
+
 #include <userver/storages/redis/impl/thread_pools.hpp>
 
 #include <storages/redis/client_impl.hpp>
@@ -17,6 +20,11 @@ class RedisConnectionState {
 
   SubscribeClientPtr GetSubscribeClient() const { return subscribe_client_; }
 
+  // Creates one more subscribe client with CLIENT TRACKING enabled for the
+  // prefixes. Not available in cluster mode.
+  SubscribeClientPtr MakeTrackingSubscribeClient(
+      std::vector<std::string> client_tracking_prefixes) const;
+
  protected:
   RedisConnectionState();
 
@@ -3,23 +3,41 @@
 /// @file userver/storages/rocks/client.hpp
 /// @brief @copybrief storages::rocks::Client
 
+#include <memory>
+#include <optional>
 #include <string>
 #include <string_view>
+#include <unordered_map>
+#include <vector>
 
 #include <rocksdb/db.h>
 
 #include <userver/engine/task/task_processor_fwd.hpp>
+#include <userver/storages/rocks/column_family.hpp>
+#include <userver/storages/rocks/iterator.hpp>
+#include <userver/storages/rocks/options.hpp>
+#include <userver/storages/rocks/snapshot.hpp>
+#include <userver/storages/rocks/write_batch.hpp>
+#include <userver/utils/statistics/fwd.hpp>
 
 USERVER_NAMESPACE_BEGIN
 
 namespace storages::rocks {
 
+namespace impl {
+struct Statistics;
+}  // namespace impl
+
 /**
  * @brief Client for working with RocksDB storage.
  *
  * This class provides an interface for interacting with the RocksDB database.
  * To use the class, you need to specify the database path when creating an
  * object.
+ *
+ * Each method that touches the database is executed on the blocking task
+ * processor. Prefer WriteBatch, MultiGet and Scan to loops over single keys,
+ * as they pay for the task processor switch once per call.
  */
 class Client final {
  public:
@@ -29,31 +47,75 @@ class Client final {
    * @param db_path The path to the RocksDB database.
    * @param blocking_task_processor - task processor to execute blocking FS
    * operations
+   * @param column_families - names of the column families to open, missing
+   * ones are created. Column families that already exist in the database are
+   * opened anyway.
    */
   Client(const std::string& db_path,
-         engine::TaskProcessor& blocking_task_processor);
+         engine::TaskProcessor& blocking_task_processor,
+         const std::vector<std::string>& column_families = {});
+
+  ~Client();
 
   /**
    * @brief Puts a record into the database.
    *
    * @param key The key of the record.
    * @param value The value of the record.
+   * @param column_family The column family of the record.
    */
-  void Put(std::string_view key, std::string_view value);
+  void Put(std::string_view key, std::string_view value,
+           const ColumnFamily& column_family = {});
 
   /**
    * @brief Retrieves the value of a record from the database by key.
    *
    * @param key The key of the record.
+   * @param options Column family and snapshot to read from.
+   * @returns an empty string if there is no such record.
    */
-  std::string Get(std::string_view key);
+  std::string Get(std::string_view key, const ReadOptions& options = {});
 
   /**
    * @brief Deletes a record from the database by key.
    *
    * @param key The key of the record to be deleted.
+   * @param column_family The column family of the record.
+   */
+  void Delete(std::string_view key, const ColumnFamily& column_family = {});
+
+  /**
+   * @brief Atomically applies all the updates of the batch.
+   *
+   * The batch is left intact and may be cleared and reused afterwards.
+   */
+  void Write(WriteBatch& batch);
+
+  /**
+   * @brief Retrieves the values of several records in one lookup.
+   *
+   * @param keys The keys of the records.
+   * @param options Column family and snapshot to read from.
+   * @returns values in the order of `keys`, std::nullopt for missing records.
    */
-  void Delete(std::string_view key);
+  std::vector<std::optional<std::string>> MultiGet(
+      const std::vector<std::string_view>& keys,
+      const ReadOptions& options = {});
+
+  /// @brief Returns an iterator over the records in the key range of
+  /// `options`.
+  Iterator Scan(const ScanOptions& options = {});
+
+  /// @brief Returns an iterator over the records with keys starting with
+  /// `prefix`, bounds of `options` are overridden.
+  Iterator ScanPrefix(std::string_view prefix, ScanOptions options = {});
+
+  /// @brief Takes a snapshot of the current state of the database.
+  Snapshot MakeSnapshot();
+
+  /// @brief Returns the column family opened in the constructor.
+  /// @throws storages::rocks::Exception if there is no such column family.
+  ColumnFamily GetColumnFamily(std::string_view name) const;
 
   /**
    * Checks the status of an operation and handles any errors based on the given
@@ -64,9 +126,22 @@ class Client final {
    */
   void CheckStatus(rocksdb::Status status, std::string_view method_name);
 
+  /// @cond
+  friend void DumpMetric(utils::statistics::Writer& writer,
+                         const Client& client);
+  /// @endcond
+
  private:
+  rocksdb::ColumnFamilyHandle* GetHandle(
+      const ColumnFamily& column_family) const;
+
+  static rocksdb::ReadOptions MakeReadOptions(const Snapshot* snapshot);
+
   std::unique_ptr<rocksdb::DB> db_;
   engine::TaskProcessor& blocking_task_processor_;
+  std::unordered_map<std::string, rocksdb::ColumnFamilyHandle*>
+      column_families_;
+  std::unique_ptr<impl::Statistics> stats_;
 };
 }  // namespace storages::rocks
 
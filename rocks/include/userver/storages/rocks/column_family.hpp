@@ -0,0 +1,37 @@
+#pragma once
+
+/// @file userver/storages/rocks/column_family.hpp
+/// @brief @copybrief storages::rocks::ColumnFamily
+
+#include <rocksdb/db.h>
+
+USERVER_NAMESPACE_BEGIN
+
+namespace storages::rocks {
+
+class Client;
+class WriteBatch;
+
+/**
+ * @brief Handle of a column family, obtained from Client::GetColumnFamily.
+ *
+ * A default-constructed handle refers to the default column family. The handle
+ * is valid for the lifetime of the Client that produced it.
+ */
+class ColumnFamily final {
+ public:
+  ColumnFamily() = default;
+
+ private:
+  friend class Client;
+  friend class WriteBatch;
+
+  explicit ColumnFamily(rocksdb::ColumnFamilyHandle* handle) noexcept
+      : handle_(handle) {}
+
+  rocksdb::ColumnFamilyHandle* handle_{nullptr};
+};
+
+}  // namespace storages::rocks
+
+USERVER_NAMESPACE_END
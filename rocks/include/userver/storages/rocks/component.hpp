@@ -8,6 +8,7 @@
 #include <userver/components/component_context.hpp>
 #include <userver/engine/task/task_processor_fwd.hpp>
 #include <userver/storages/rocks/client_fwd.hpp>
+#include <userver/utils/statistics/entry.hpp>
 
 USERVER_NAMESPACE_BEGIN
 
@@ -23,6 +24,7 @@ namespace storages::rocks {
 /// ---------------------------------- | ------------------------------------------------ | ---------------
 /// task-processor                     | name of the task processor to run the blocking file operations | -
 /// db-path                            | path to database file                            | -
+/// column-families                    | names of the column families to open or create   | []
 
 // clang-format on
 
@@ -31,7 +33,7 @@ class Component : public components::ComponentBase {
   Component(const components::ComponentConfig&,
             const components::ComponentContext&);
 
-  ~Component() = default;
+  ~Component() override;
 
   storages::rocks::ClientPtr MakeClient();
 
@@ -39,6 +41,7 @@ class Component : public components::ComponentBase {
 
  private:
   storages::rocks::ClientPtr client_ptr_;
+  utils::statistics::Entry statistics_holder_;
 };
 
 }  // namespace storages::rocks
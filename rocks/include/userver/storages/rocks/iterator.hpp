@@ -0,0 +1,65 @@
+#pragma once
+
+/// @file userver/storages/rocks/iterator.hpp
+/// @brief @copybrief storages::rocks::Iterator
+
+#include <memory>
+#include <string>
+#include <vector>
+
+USERVER_NAMESPACE_BEGIN
+
+namespace storages::rocks {
+
+class Client;
+
+namespace impl {
+struct IteratorState;
+}  // namespace impl
+
+/// A record of the database
+struct KeyValue final {
+  std::string key;
+  std::string value;
+};
+
+/**
+ * @brief Forward iterator over a range of keys, obtained from Client::Scan or
+ * Client::ScanPrefix.
+ *
+ * Records are read in chunks of ScanOptions::chunk_size on the blocking task
+ * processor, so a long scan does not occupy the coroutine thread and pays for
+ * the task processor switch once per chunk.
+ *
+ * The iterator must not outlive the Client that produced it.
+ *
+ * @code
+ * auto it = client.ScanPrefix("user:");
+ * for (auto chunk = it.NextChunk(); !chunk.empty(); chunk = it.NextChunk()) {
+ *   for (const auto& [key, value] : chunk) {
+ *     Process(key, value);
+ *   }
+ * }
+ * @endcode
+ */
+class Iterator final {
+ public:
+  Iterator(Iterator&&) noexcept;
+  Iterator& operator=(Iterator&&) noexcept;
+  ~Iterator();
+
+  /// Reads the next records in key order.
+  /// @returns an empty vector if the range is exhausted
+  std::vector<KeyValue> NextChunk();
+
+ private:
+  friend class Client;
+
+  explicit Iterator(std::unique_ptr<impl::IteratorState> state);
+
+  std::unique_ptr<impl::IteratorState> state_;
+};
+
+}  // namespace storages::rocks
+
+USERVER_NAMESPACE_END
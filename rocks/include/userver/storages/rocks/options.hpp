@@ -0,0 +1,49 @@
+#pragma once
+
+/// @file userver/storages/rocks/options.hpp
+/// @brief Options of the read operations
+
+#include <cstddef>
+#include <string>
+
+#include <userver/storages/rocks/column_family.hpp>
+
+USERVER_NAMESPACE_BEGIN
+
+namespace storages::rocks {
+
+class Snapshot;
+
+/// Options of Client::Get and Client::MultiGet
+struct ReadOptions final {
+  /// Column family to read from
+  ColumnFamily column_family{};
+
+  /// Snapshot to read from, the latest state is read if not set.
+  /// The snapshot must outlive the operation.
+  const Snapshot* snapshot{nullptr};
+};
+
+/// Options of Client::Scan
+struct ScanOptions final {
+  /// Column family to read from
+  ColumnFamily column_family{};
+
+  /// Snapshot to read from, the latest state is read if not set.
+  /// The snapshot must outlive the Iterator.
+  const Snapshot* snapshot{nullptr};
+
+  /// Inclusive lower bound of keys, the scan starts from the first key if
+  /// empty
+  std::string lower_bound{};
+
+  /// Exclusive upper bound of keys, the scan goes up to the last key if empty
+  std::string upper_bound{};
+
+  /// Maximum number of records fetched by Iterator::NextChunk
+  std::size_t chunk_size{1000};
+};
+
+}  // namespace storages::rocks
+
+USERVER_NAMESPACE_END
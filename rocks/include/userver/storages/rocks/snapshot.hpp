@@ -0,0 +1,41 @@
+#pragma once
+
+/// @file userver/storages/rocks/snapshot.hpp
+/// @brief @copybrief storages::rocks::Snapshot
+
+#include <rocksdb/db.h>
+
+USERVER_NAMESPACE_BEGIN
+
+namespace storages::rocks {
+
+class Client;
+
+/**
+ * @brief Consistent read-only view of the database, obtained from
+ * Client::MakeSnapshot.
+ *
+ * Reads that are given the snapshot in ReadOptions do not see the writes
+ * made after the snapshot was taken. The snapshot is released on destruction
+ * and must not outlive the Client that produced it.
+ */
+class Snapshot final {
+ public:
+  Snapshot(Snapshot&& other) noexcept;
+  Snapshot& operator=(Snapshot&& other) noexcept;
+  ~Snapshot();
+
+ private:
+  friend class Client;
+
+  Snapshot(rocksdb::DB& db, const rocksdb::Snapshot* snapshot) noexcept;
+
+  void Release() noexcept;
+
+  rocksdb::DB* db_;
+  const rocksdb::Snapshot* snapshot_;
+};
+
+}  // namespace storages::rocks
+
+USERVER_NAMESPACE_END
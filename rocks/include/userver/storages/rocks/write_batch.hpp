@@ -0,0 +1,58 @@
+#pragma once
+
+/// @file userver/storages/rocks/write_batch.hpp
+/// @brief @copybrief storages::rocks::WriteBatch
+
+#include <cstddef>
+#include <string_view>
+
+#include <rocksdb/write_batch.h>
+
+#include <userver/storages/rocks/column_family.hpp>
+
+USERVER_NAMESPACE_BEGIN
+
+namespace storages::rocks {
+
+/**
+ * @brief A set of updates that is applied atomically by Client::Write.
+ *
+ * Filling the batch does not touch the database, so it does not block and
+ * does not switch to the blocking task processor.
+ */
+class WriteBatch final {
+ public:
+  /// Adds a record, overwriting the existing value of the key
+  void Put(std::string_view key, std::string_view value);
+
+  /// @overload
+  void Put(const ColumnFamily& column_family, std::string_view key,
+           std::string_view value);
+
+  /// Removes a record
+  void Delete(std::string_view key);
+
+  /// @overload
+  void Delete(const ColumnFamily& column_family, std::string_view key);
+
+  /// Removes the records in the range [begin_key, end_key)
+  void DeleteRange(const ColumnFamily& column_family,
+                   std::string_view begin_key, std::string_view end_key);
+
+  /// Number of updates in the batch
+  std::size_t Size() const;
+
+  bool IsEmpty() const { return Size() == 0; }
+
+  /// Removes all the updates, so that the batch can be reused
+  void Clear();
+
+ private:
+  friend class Client;
+
+  rocksdb::WriteBatch batch_;
+};
+
+}  // namespace storages::rocks
+
+USERVER_NAMESPACE_END
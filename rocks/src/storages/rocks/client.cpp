@@ -1,61 +1,255 @@
 #include <userver/storages/rocks/client.hpp>
 
+#include <algorithm>
+#include <cstdint>
+
 #include <fmt/format.h>
 
 #include <userver/storages/rocks/exception.hpp>
+#include <userver/utils/assert.hpp>
 #include <userver/utils/async.hpp>
+#include <userver/utils/statistics/writer.hpp>
+
+#include <storages/rocks/impl/iterator_state.hpp>
+#include <storages/rocks/impl/statistics.hpp>
 
 USERVER_NAMESPACE_BEGIN
 
 namespace storages::rocks {
 
+namespace {
+
+constexpr std::string_view kPropertyPrefix = "rocksdb.";
+
+// Cheap in-memory properties, safe to read on the coroutine thread
+constexpr std::string_view kIntProperties[] = {
+    "rocksdb.estimate-num-keys",
+    "rocksdb.cur-size-all-mem-tables",
+    "rocksdb.block-cache-usage",
+    "rocksdb.live-sst-files-size",
+    "rocksdb.estimate-pending-compaction-bytes",
+};
+
+std::vector<std::string> GetColumnFamiliesToOpen(
+    const rocksdb::Options& options, const std::string& db_path,
+    const std::vector<std::string>& requested) {
+  std::vector<std::string> names;
+  // Fails if the database does not exist yet, it is created with the
+  // requested column families then
+  if (!rocksdb::DB::ListColumnFamilies(options, db_path, &names).ok()) {
+    names.clear();
+  }
+  names.insert(names.end(), requested.begin(), requested.end());
+  names.push_back(rocksdb::kDefaultColumnFamilyName);
+
+  std::sort(names.begin(), names.end());
+  names.erase(std::unique(names.begin(), names.end()), names.end());
+  return names;
+}
+
+// The successor of all the keys with the prefix, empty if there is none
+std::string GetPrefixUpperBound(std::string_view prefix) {
+  std::string upper_bound{prefix};
+  while (!upper_bound.empty() &&
+         static_cast<unsigned char>(upper_bound.back()) == 0xff) {
+    upper_bound.pop_back();
+  }
+  if (!upper_bound.empty()) ++upper_bound.back();
+  return upper_bound;
+}
+
+}  // namespace
+
 Client::Client(const std::string& db_path,
-               engine::TaskProcessor& blocking_task_processor)
-    : blocking_task_processor_(blocking_task_processor) {
+               engine::TaskProcessor& blocking_task_processor,
+               const std::vector<std::string>& column_families)
+    : blocking_task_processor_(blocking_task_processor),
+      stats_(std::make_unique<impl::Statistics>()) {
   rocksdb::Options options;
   options.create_if_missing = true;
+  options.create_missing_column_families = true;
 
+  std::vector<rocksdb::ColumnFamilyDescriptor> descriptors;
+  for (auto& name :
+       GetColumnFamiliesToOpen(options, db_path, column_families)) {
+    descriptors.emplace_back(std::move(name),
+                             rocksdb::ColumnFamilyOptions{options});
+  }
+
+  std::vector<rocksdb::ColumnFamilyHandle*> handles;
   rocksdb::DB* db{};
-  rocksdb::Status status = rocksdb::DB::Open(options, db_path, &db);
+  rocksdb::Status status =
+      rocksdb::DB::Open(options, db_path, descriptors, &handles, &db);
   db_.reset(db);
   CheckStatus(status, "Create client");
+
+  for (auto* handle : handles) {
+    column_families_.emplace(handle->GetName(), handle);
+  }
 }
 
-void Client::Put(std::string_view key, std::string_view value) {
-  engine::AsyncNoSpan(blocking_task_processor_, [this, key, value] {
-    rocksdb::Status status = db_->Put(rocksdb::WriteOptions(), key, value);
+Client::~Client() {
+  // Handles must be released before the database is closed
+  for (const auto& [name, handle] : column_families_) {
+    db_->DestroyColumnFamilyHandle(handle);
+  }
+}
+
+void Client::Put(std::string_view key, std::string_view value,
+                 const ColumnFamily& column_family) {
+  impl::StatsScope stats_scope{stats_->put, 1};
+  engine::AsyncNoSpan(blocking_task_processor_, [&, this] {
+    rocksdb::Status status = db_->Put(rocksdb::WriteOptions(),
+                                      GetHandle(column_family), key, value);
     CheckStatus(status, "Put");
   }).Get();
 }
 
-std::string Client::Get(std::string_view key) {
+std::string Client::Get(std::string_view key, const ReadOptions& options) {
+  impl::StatsScope stats_scope{stats_->get, 1};
   return engine::AsyncNoSpan(blocking_task_processor_,
-                             [this, key] {
+                             [&, this] {
                                std::string res;
-                               rocksdb::Status status =
-                                   db_->Get(rocksdb::ReadOptions(), key, &res);
+                               rocksdb::Status status = db_->Get(
+                                   MakeReadOptions(options.snapshot),
+                                   GetHandle(options.column_family), key, &res);
                                CheckStatus(status, "Get");
                                return res;
                              })
       .Get();
 }
 
-void Client::Delete(std::string_view key) {
+void Client::Delete(std::string_view key, const ColumnFamily& column_family) {
+  impl::StatsScope stats_scope{stats_->del, 1};
   return engine::AsyncNoSpan(blocking_task_processor_,
-                             [this, key] {
+                             [&, this] {
                                rocksdb::Status status =
-                                   db_->Delete(rocksdb::WriteOptions(), key);
+                                   db_->Delete(rocksdb::WriteOptions(),
+                                               GetHandle(column_family), key);
                                CheckStatus(status, "Delete");
                              })
       .Get();
 }
 
+void Client::Write(WriteBatch& batch) {
+  if (batch.IsEmpty()) return;
+
+  impl::StatsScope stats_scope{stats_->write_batch, batch.Size()};
+  engine::AsyncNoSpan(blocking_task_processor_, [&batch, this] {
+    rocksdb::Status status = db_->Write(rocksdb::WriteOptions(), &batch.batch_);
+    CheckStatus(status, "Write");
+  }).Get();
+}
+
+std::vector<std::optional<std::string>> Client::MultiGet(
+    const std::vector<std::string_view>& keys, const ReadOptions& options) {
+  if (keys.empty()) return {};
+
+  impl::StatsScope stats_scope{stats_->multi_get, keys.size()};
+  return engine::AsyncNoSpan(blocking_task_processor_, [&, this] {
+           std::vector<rocksdb::Slice> slices;
+           slices.reserve(keys.size());
+           for (const auto key : keys) {
+             slices.emplace_back(key.data(), key.size());
+           }
+           std::vector<rocksdb::PinnableSlice> values(keys.size());
+           std::vector<rocksdb::Status> statuses(keys.size());
+
+           // Batched lookup, shares the index and filter block reads between
+           // the keys of the same block
+           db_->MultiGet(MakeReadOptions(options.snapshot),
+                         GetHandle(options.column_family), keys.size(),
+                         slices.data(), values.data(), statuses.data());
+
+           std::vector<std::optional<std::string>> result(keys.size());
+           for (std::size_t i = 0; i < keys.size(); ++i) {
+             if (statuses[i].ok()) {
+               result[i].emplace(values[i].data(), values[i].size());
+             } else {
+               CheckStatus(statuses[i], "MultiGet");
+             }
+           }
+           return result;
+         })
+      .Get();
+}
+
+Iterator Client::Scan(const ScanOptions& options) {
+  UINVARIANT(options.chunk_size > 0, "Scan chunk size must be positive");
+
+  auto state = std::make_unique<impl::IteratorState>(
+      blocking_task_processor_, stats_->scan, options.lower_bound,
+      options.upper_bound, options.chunk_size);
+
+  auto read_options = MakeReadOptions(options.snapshot);
+  if (!state->lower_bound.empty()) {
+    read_options.iterate_lower_bound = &state->lower_bound_slice;
+  }
+  if (!state->upper_bound.empty()) {
+    read_options.iterate_upper_bound = &state->upper_bound_slice;
+  }
+  // Obsolete files are deleted on the background when the iterator is
+  // destroyed, so that the destructor does not block
+  read_options.background_purge_on_iterator_cleanup = true;
+
+  // Creating an iterator does not do IO, the seek is done by the first
+  // NextChunk call
+  state->iterator.reset(
+      db_->NewIterator(read_options, GetHandle(options.column_family)));
+  return Iterator{std::move(state)};
+}
+
+Iterator Client::ScanPrefix(std::string_view prefix, ScanOptions options) {
+  options.lower_bound = std::string{prefix};
+  options.upper_bound = GetPrefixUpperBound(prefix);
+  return Scan(options);
+}
+
+Snapshot Client::MakeSnapshot() { return Snapshot{*db_, db_->GetSnapshot()}; }
+
+ColumnFamily Client::GetColumnFamily(std::string_view name) const {
+  const auto it = column_families_.find(std::string{name});
+  if (it == column_families_.end()) {
+    throw Exception(fmt::format("Column family '{}' is not opened", name));
+  }
+  return ColumnFamily{it->second};
+}
+
 void Client::CheckStatus(rocksdb::Status status, std::string_view method_name) {
   if (!status.ok() && !status.IsNotFound()) {
     throw USERVER_NAMESPACE::storages::rocks::RequestFailedException(
         method_name, status.ToString());
   }
 }
+
+rocksdb::ColumnFamilyHandle* Client::GetHandle(
+    const ColumnFamily& column_family) const {
+  return column_family.handle_ ? column_family.handle_
+                               : db_->DefaultColumnFamily();
+}
+
+rocksdb::ReadOptions Client::MakeReadOptions(const Snapshot* snapshot) {
+  rocksdb::ReadOptions read_options;
+  if (snapshot) {
+    UASSERT_MSG(snapshot->snapshot_, "Snapshot is moved out");
+    read_options.snapshot = snapshot->snapshot_;
+  }
+  return read_options;
+}
+
+void DumpMetric(utils::statistics::Writer& writer, const Client& client) {
+  writer = *client.stats_;
+
+  auto properties = writer["properties"];
+  std::uint64_t value = 0;
+  for (const auto property : kIntProperties) {
+    if (client.db_->GetIntProperty(
+            rocksdb::Slice{property.data(), property.size()}, &value)) {
+      properties[property.substr(kPropertyPrefix.size())] = value;
+    }
+  }
+}
+
 }  // namespace storages::rocks
 
 USERVER_NAMESPACE_END
@@ -0,0 +1,130 @@
+#include <userver/storages/rocks/client.hpp>
+
+#include <string>
+#include <vector>
+
+#include <benchmark/benchmark.h>
+
+#include <userver/engine/run_standalone.hpp>
+#include <userver/engine/task/task.hpp>
+#include <userver/fs/blocking/temp_directory.hpp>
+
+USERVER_NAMESPACE_BEGIN
+
+namespace {
+
+std::vector<std::string> MakeKeys(std::size_t count) {
+  std::vector<std::string> keys;
+  keys.reserve(count);
+  for (std::size_t i = 0; i < count; ++i) {
+    keys.push_back("key" + std::to_string(i));
+  }
+  return keys;
+}
+
+void Fill(storages::rocks::Client& client,
+          const std::vector<std::string>& keys) {
+  storages::rocks::WriteBatch batch;
+  for (const auto& key : keys) {
+    batch.Put(key, std::string(100, 'v'));
+  }
+  client.Write(batch);
+}
+
+}  // namespace
+
+void rocks_put_loop(benchmark::State& state) {
+  engine::RunStandalone([&] {
+    const auto dir = fs::blocking::TempDirectory::Create();
+    storages::rocks::Client client{dir.GetPath(),
+                                   engine::current_task::GetTaskProcessor()};
+    const auto keys = MakeKeys(state.range(0));
+    const std::string value(100, 'v');
+
+    for ([[maybe_unused]] auto _ : state) {
+      for (const auto& key : keys) {
+        client.Put(key, value);
+      }
+    }
+    state.SetItemsProcessed(state.iterations() * keys.size());
+  });
+}
+BENCHMARK(rocks_put_loop)->RangeMultiplier(10)->Range(1, 1000);
+
+void rocks_write_batch(benchmark::State& state) {
+  engine::RunStandalone([&] {
+    const auto dir = fs::blocking::TempDirectory::Create();
+    storages::rocks::Client client{dir.GetPath(),
+                                   engine::current_task::GetTaskProcessor()};
+    const auto keys = MakeKeys(state.range(0));
+    const std::string value(100, 'v');
+
+    storages::rocks::WriteBatch batch;
+    for ([[maybe_unused]] auto _ : state) {
+      batch.Clear();
+      for (const auto& key : keys) {
+        batch.Put(key, value);
+      }
+      client.Write(batch);
+    }
+    state.SetItemsProcessed(state.iterations() * keys.size());
+  });
+}
+BENCHMARK(rocks_write_batch)->RangeMultiplier(10)->Range(1, 1000);
+
+void rocks_get_loop(benchmark::State& state) {
+  engine::RunStandalone([&] {
+    const auto dir = fs::blocking::TempDirectory::Create();
+    storages::rocks::Client client{dir.GetPath(),
+                                   engine::current_task::GetTaskProcessor()};
+    const auto keys = MakeKeys(state.range(0));
+    Fill(client, keys);
+
+    for ([[maybe_unused]] auto _ : state) {
+      for (const auto& key : keys) {
+        benchmark::DoNotOptimize(client.Get(key));
+      }
+    }
+    state.SetItemsProcessed(state.iterations() * keys.size());
+  });
+}
+BENCHMARK(rocks_get_loop)->RangeMultiplier(10)->Range(1, 1000);
+
+void rocks_multi_get(benchmark::State& state) {
+  engine::RunStandalone([&] {
+    const auto dir = fs::blocking::TempDirectory::Create();
+    storages::rocks::Client client{dir.GetPath(),
+                                   engine::current_task::GetTaskProcessor()};
+    const auto keys = MakeKeys(state.range(0));
+    Fill(client, keys);
+    const std::vector<std::string_view> key_views(keys.begin(), keys.end());
+
+    for ([[maybe_unused]] auto _ : state) {
+      benchmark::DoNotOptimize(client.MultiGet(key_views));
+    }
+    state.SetItemsProcessed(state.iterations() * keys.size());
+  });
+}
+BENCHMARK(rocks_multi_get)->RangeMultiplier(10)->Range(1, 1000);
+
+void rocks_scan(benchmark::State& state) {
+  engine::RunStandalone([&] {
+    const auto dir = fs::blocking::TempDirectory::Create();
+    storages::rocks::Client client{dir.GetPath(),
+                                   engine::current_task::GetTaskProcessor()};
+    const auto keys = MakeKeys(10000);
+    Fill(client, keys);
+
+    storages::rocks::ScanOptions options;
+    options.chunk_size = state.range(0);
+    for ([[maybe_unused]] auto _ : state) {
+      auto it = client.Scan(options);
+      while (!it.NextChunk().empty()) {
+      }
+    }
+    state.SetItemsProcessed(state.iterations() * keys.size());
+  });
+}
+BENCHMARK(rocks_scan)->RangeMultiplier(10)->Range(1, 10000);
+
+USERVER_NAMESPACE_END
@@ -1,4 +1,7 @@
 #include <userver/storages/rocks/client.hpp>
+
+#include <userver/fs/blocking/temp_directory.hpp>
+#include <userver/storages/rocks/exception.hpp>
 #include <userver/utest/utest.hpp>
 #include <userver/utils/async.hpp>
 
@@ -6,6 +9,16 @@ USERVER_NAMESPACE_BEGIN
 
 namespace {
 
+std::vector<std::string> ReadAll(storages::rocks::Iterator it) {
+  std::vector<std::string> result;
+  for (auto chunk = it.NextChunk(); !chunk.empty(); chunk = it.NextChunk()) {
+    for (auto& [key, value] : chunk) {
+      result.push_back(key + "=" + value);
+    }
+  }
+  return result;
+}
+
 UTEST(Rocks, CheckCRUD) {
   storages::rocks::Client client{"/tmp/rocksdb_simple_example",
                                  engine::current_task::GetTaskProcessor()};
@@ -25,6 +38,133 @@ UTEST(Rocks, CheckCRUD) {
   EXPECT_EQ("", res);
 }
 
+UTEST(Rocks, WriteBatchAndMultiGet) {
+  const auto dir = fs::blocking::TempDirectory::Create();
+  storages::rocks::Client client{dir.GetPath(),
+                                 engine::current_task::GetTaskProcessor()};
+
+  storages::rocks::WriteBatch batch;
+  batch.Put("a", "1");
+  batch.Put("b", "2");
+  batch.Put("c", "3");
+  batch.Delete("b");
+  EXPECT_EQ(4, batch.Size());
+  client.Write(batch);
+
+  const auto values = client.MultiGet({"a", "b", "c", "d"});
+  ASSERT_EQ(4, values.size());
+  EXPECT_EQ("1", values[0]);
+  EXPECT_EQ(std::nullopt, values[1]);
+  EXPECT_EQ("3", values[2]);
+  EXPECT_EQ(std::nullopt, values[3]);
+
+  batch.Clear();
+  EXPECT_TRUE(batch.IsEmpty());
+  batch.DeleteRange({}, "a", "c");
+  client.Write(batch);
+  EXPECT_EQ("", client.Get("a"));
+  EXPECT_EQ("3", client.Get("c"));
+
+  EXPECT_TRUE(client.MultiGet({}).empty());
+}
+
+UTEST(Rocks, Scan) {
+  const auto dir = fs::blocking::TempDirectory::Create();
+  storages::rocks::Client client{dir.GetPath(),
+                                 engine::current_task::GetTaskProcessor()};
+
+  storages::rocks::WriteBatch batch;
+  for (const auto* key : {"a", "b1", "b2", "b3", "c"}) {
+    batch.Put(key, "v");
+  }
+  batch.Put("b\xff", "v");
+  client.Write(batch);
+
+  EXPECT_EQ(ReadAll(client.Scan()),
+            (std::vector<std::string>{"a=v", "b1=v", "b2=v", "b3=v", "b\xff=v",
+                                      "c=v"}));
+
+  storages::rocks::ScanOptions options;
+  options.lower_bound = "b2";
+  options.upper_bound = "c";
+  options.chunk_size = 1;
+  auto it = client.Scan(options);
+  EXPECT_EQ(1, it.NextChunk().size());
+  EXPECT_EQ(1, it.NextChunk().size());
+  EXPECT_EQ(1, it.NextChunk().size());
+  EXPECT_TRUE(it.NextChunk().empty());
+  EXPECT_TRUE(it.NextChunk().empty());
+
+  EXPECT_EQ(ReadAll(client.ScanPrefix("b")),
+            (std::vector<std::string>{"b1=v", "b2=v", "b3=v", "b\xff=v"}));
+  EXPECT_EQ(ReadAll(client.ScanPrefix("b\xff")),
+            (std::vector<std::string>{"b\xff=v"}));
+  EXPECT_TRUE(ReadAll(client.ScanPrefix("d")).empty());
+}
+
+UTEST(Rocks, Snapshot) {
+  const auto dir = fs::blocking::TempDirectory::Create();
+  storages::rocks::Client client{dir.GetPath(),
+                                 engine::current_task::GetTaskProcessor()};
+
+  client.Put("key", "old");
+  const auto snapshot = client.MakeSnapshot();
+  client.Put("key", "new");
+  client.Put("other", "new");
+
+  storages::rocks::ReadOptions read_options;
+  read_options.snapshot = &snapshot;
+  EXPECT_EQ("old", client.Get("key", read_options));
+  EXPECT_EQ("new", client.Get("key"));
+
+  const auto values = client.MultiGet({"key", "other"}, read_options);
+  EXPECT_EQ("old", values[0]);
+  EXPECT_EQ(std::nullopt, values[1]);
+
+  storages::rocks::ScanOptions scan_options;
+  scan_options.snapshot = &snapshot;
+  EXPECT_EQ(ReadAll(client.Scan(scan_options)),
+            std::vector<std::string>{"key=old"});
+}
+
+UTEST(Rocks, ColumnFamilies) {
+  const auto dir = fs::blocking::TempDirectory::Create();
+  {
+    storages::rocks::Client client{dir.GetPath(),
+                                   engine::current_task::GetTaskProcessor(),
+                                   {"first", "second"}};
+    const auto first = client.GetColumnFamily("first");
+    const auto second = client.GetColumnFamily("second");
+    UEXPECT_THROW(client.GetColumnFamily("third"),
+                  storages::rocks::Exception);
+
+    client.Put("key", "default");
+    client.Put("key", "first", first);
+
+    storages::rocks::WriteBatch batch;
+    batch.Put(second, "key", "second");
+    client.Write(batch);
+
+    storages::rocks::ReadOptions options;
+    EXPECT_EQ("default", client.Get("key", options));
+    options.column_family = first;
+    EXPECT_EQ("first", client.Get("key", options));
+    options.column_family = second;
+    EXPECT_EQ("second", client.Get("key", options));
+
+    client.Delete("key", first);
+    options.column_family = first;
+    EXPECT_EQ("", client.Get("key", options));
+  }
+
+  // Existing column families are reopened even if not requested
+  storages::rocks::Client client{dir.GetPath(),
+                                 engine::current_task::GetTaskProcessor()};
+  storages::rocks::ReadOptions options;
+  options.column_family = client.GetColumnFamily("second");
+  EXPECT_EQ("second", client.Get("key", options));
+}
+
 }  // namespace
 
 USERVER_NAMESPACE_END
@@ -2,7 +2,9 @@
 
 #include <memory>
 
+#include <userver/components/statistics_storage.hpp>
 #include <userver/storages/rocks/client.hpp>
+#include <userver/utils/statistics/writer.hpp>
 #include <userver/yaml_config/merge_schemas.hpp>
 
 USERVER_NAMESPACE_BEGIN
@@ -14,8 +16,17 @@ Component::Component(const components::ComponentConfig& config,
     : ComponentBase(config, context),
       client_ptr_(std::make_shared<storages::rocks::Client>(
           config["db-path"].As<std::string>(),
-          context.GetTaskProcessor(
-              config["task-processor"].As<std::string>()))) {}
+          context.GetTaskProcessor(config["task-processor"].As<std::string>()),
+          config["column-families"].As<std::vector<std::string>>({}))) {
+  auto& statistics_storage =
+      context.FindComponent<components::StatisticsStorage>();
+  statistics_holder_ = statistics_storage.GetStorage().RegisterWriter(
+      "rocks",
+      [this](utils::statistics::Writer& writer) { writer = *client_ptr_; },
+      {{"rocks_database", config.Name()}});
+}
+
+Component::~Component() { statistics_holder_.Unregister(); }
 
 storages::rocks::ClientPtr Component::MakeClient() { return client_ptr_; }
 
@@ -31,6 +42,13 @@ properties:
     db-path:
         type: string
         description: path to database file
+    column-families:
+        type: array
+        description: names of the column families to open or create
+        defaultDescription: '[]'
+        items:
+            type: string
+            description: column family name
 )");
 }
 }  // namespace storages::rocks
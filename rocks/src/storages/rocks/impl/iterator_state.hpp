@@ -0,0 +1,47 @@
+#pragma once
+
+#include <cstddef>
+#include <memory>
+#include <string>
+
+#include <rocksdb/db.h>
+
+#include <userver/engine/task/task_processor_fwd.hpp>
+
+#include <storages/rocks/impl/statistics.hpp>
+
+USERVER_NAMESPACE_BEGIN
+
+namespace storages::rocks::impl {
+
+// Lives on the heap, as rocksdb::ReadOptions of the iterator keep pointers to
+// the bounds
+struct IteratorState final {
+  IteratorState(engine::TaskProcessor& blocking_task_processor,
+                OperationStatistics& stats, std::string lower_bound,
+                std::string upper_bound, std::size_t chunk_size)
+      : blocking_task_processor(blocking_task_processor),
+        stats(stats),
+        lower_bound(std::move(lower_bound)),
+        upper_bound(std::move(upper_bound)),
+        lower_bound_slice(this->lower_bound),
+        upper_bound_slice(this->upper_bound),
+        chunk_size(chunk_size) {}
+
+  engine::TaskProcessor& blocking_task_processor;
+  OperationStatistics& stats;
+
+  const std::string lower_bound;
+  const std::string upper_bound;
+  const rocksdb::Slice lower_bound_slice;
+  const rocksdb::Slice upper_bound_slice;
+  const std::size_t chunk_size;
+
+  std::unique_ptr<rocksdb::Iterator> iterator;
+  bool is_started{false};
+  bool is_finished{false};
+};
+
+}  // namespace storages::rocks::impl
+
+USERVER_NAMESPACE_END
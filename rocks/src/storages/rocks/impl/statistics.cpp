@@ -0,0 +1,70 @@
+#include <storages/rocks/impl/statistics.hpp>
+
+#include <exception>
+#include <iterator>
+
+#include <userver/utils/statistics/writer.hpp>
+
+USERVER_NAMESPACE_BEGIN
+
+namespace storages::rocks::impl {
+
+namespace {
+
+// Local storage operations mostly take from microseconds to a few
+// milliseconds, the tail covers compaction stalls.
+constexpr double kTimingsBoundsUs[] = {
+    1,    2,    5,    10,    20,    50,    100,    200,    500,
+    1000, 2000, 5000, 10000, 20000, 50000, 100000, 500000, 1000000};
+
+// "Golden test". Note that there is 1 more "inf" bucket.
+static_assert(std::size(kTimingsBoundsUs) == 18);
+
+}  // namespace
+
+OperationStatistics::OperationStatistics() : timings(kTimingsBoundsUs) {}
+
+void DumpMetric(utils::statistics::Writer& writer,
+                const OperationStatistics& stats) {
+  const auto success = stats.success.Load();
+  const auto error = stats.error.Load();
+  writer["total"] = success + error;
+  writer["success"] = success;
+  writer["error"] = error;
+  writer["keys"] = stats.keys;
+  writer["timings-us"] = stats.timings;
+}
+
+void DumpMetric(utils::statistics::Writer& writer, const Statistics& stats) {
+  auto operations = writer["operations"];
+  operations.ValueWithLabels(stats.put, {"rocks_operation", "put"});
+  operations.ValueWithLabels(stats.get, {"rocks_operation", "get"});
+  operations.ValueWithLabels(stats.del, {"rocks_operation", "delete"});
+  operations.ValueWithLabels(stats.write_batch,
+                             {"rocks_operation", "write-batch"});
+  operations.ValueWithLabels(stats.multi_get, {"rocks_operation", "multi-get"});
+  operations.ValueWithLabels(stats.scan, {"rocks_operation", "scan"});
+}
+
+StatsScope::StatsScope(OperationStatistics& stats, std::size_t keys)
+    : stats_(stats),
+      start_(std::chrono::steady_clock::now()),
+      uncaught_exceptions_(std::uncaught_exceptions()) {
+  stats_.keys += utils::statistics::Rate{keys};
+}
+
+StatsScope::~StatsScope() {
+  const auto total_time = std::chrono::steady_clock::now() - start_;
+  if (std::uncaught_exceptions() > uncaught_exceptions_) {
+    ++stats_.error;
+  } else {
+    ++stats_.success;
+  }
+  stats_.timings.Account(
+      std::chrono::duration_cast<std::chrono::microseconds>(total_time)
+          .count());
+}
+
+}  // namespace storages::rocks::impl
+
+USERVER_NAMESPACE_END
@@ -0,0 +1,57 @@
+#pragma once
+
+#include <chrono>
+#include <cstddef>
+
+#include <userver/utils/statistics/fwd.hpp>
+#include <userver/utils/statistics/histogram.hpp>
+#include <userver/utils/statistics/rate_counter.hpp>
+
+USERVER_NAMESPACE_BEGIN
+
+namespace storages::rocks::impl {
+
+struct OperationStatistics final {
+  OperationStatistics();
+
+  utils::statistics::RateCounter success;
+  utils::statistics::RateCounter error;
+  // Number of keys read or written, differs from the number of operations
+  // for the batched ones
+  utils::statistics::RateCounter keys;
+  utils::statistics::Histogram timings;
+};
+
+void DumpMetric(utils::statistics::Writer& writer,
+                const OperationStatistics& stats);
+
+struct Statistics final {
+  OperationStatistics put;
+  OperationStatistics get;
+  OperationStatistics del;
+  OperationStatistics write_batch;
+  OperationStatistics multi_get;
+  OperationStatistics scan;
+};
+
+void DumpMetric(utils::statistics::Writer& writer, const Statistics& stats);
+
+/// Accounts the time of the operation on destruction, the operation is
+/// considered failed if the scope is left with an exception
+class StatsScope final {
+ public:
+  StatsScope(OperationStatistics& stats, std::size_t keys);
+
+  StatsScope(const StatsScope&) = delete;
+  StatsScope& operator=(const StatsScope&) = delete;
+  ~StatsScope();
+
+ private:
+  OperationStatistics& stats_;
+  const std::chrono::steady_clock::time_point start_;
+  const int uncaught_exceptions_;
+};
+
+}  // namespace storages::rocks::impl
+
+USERVER_NAMESPACE_END
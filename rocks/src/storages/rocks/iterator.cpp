@@ -0,0 +1,74 @@
+#include <userver/storages/rocks/iterator.hpp>
+
+#include <algorithm>
+
+#include <userver/storages/rocks/exception.hpp>
+#include <userver/utils/assert.hpp>
+#include <userver/utils/async.hpp>
+
+#include <storages/rocks/impl/iterator_state.hpp>
+
+USERVER_NAMESPACE_BEGIN
+
+namespace storages::rocks {
+
+namespace {
+
+// Do not preallocate huge chunks for small ranges
+constexpr std::size_t kMaxChunkReserve = 1024;
+
+}  // namespace
+
+Iterator::Iterator(std::unique_ptr<impl::IteratorState> state)
+    : state_(std::move(state)) {
+  UASSERT(state_ && state_->iterator);
+}
+
+Iterator::Iterator(Iterator&&) noexcept = default;
+
+Iterator& Iterator::operator=(Iterator&&) noexcept = default;
+
+Iterator::~Iterator() = default;
+
+std::vector<KeyValue> Iterator::NextChunk() {
+  UASSERT_MSG(state_, "Iterator is moved out");
+  auto& state = *state_;
+  if (state.is_finished) return {};
+
+  impl::StatsScope stats_scope{state.stats, 0};
+  auto chunk =
+      engine::AsyncNoSpan(state.blocking_task_processor, [&state] {
+        auto& it = *state.iterator;
+        if (!state.is_started) {
+          // iterate_lower_bound limits only the backward iteration
+          if (state.lower_bound.empty()) {
+            it.SeekToFirst();
+          } else {
+            it.Seek(state.lower_bound_slice);
+          }
+          state.is_started = true;
+        }
+
+        std::vector<KeyValue> result;
+        result.reserve(std::min(state.chunk_size, kMaxChunkReserve));
+        for (; it.Valid() && result.size() < state.chunk_size; it.Next()) {
+          result.push_back({it.key().ToString(), it.value().ToString()});
+        }
+
+        if (!it.Valid()) {
+          const auto status = it.status();
+          if (!status.ok()) {
+            throw RequestFailedException("Scan", status.ToString());
+          }
+          state.is_finished = true;
+        }
+        return result;
+      }).Get();
+
+  state.stats.keys += utils::statistics::Rate{chunk.size()};
+  return chunk;
+}
+
+}  // namespace storages::rocks
+
+USERVER_NAMESPACE_END
@@ -0,0 +1,38 @@
+#include <userver/storages/rocks/snapshot.hpp>
+
+#include <utility>
+
+#include <userver/utils/assert.hpp>
+
+USERVER_NAMESPACE_BEGIN
+
+namespace storages::rocks {
+
+Snapshot::Snapshot(rocksdb::DB& db, const rocksdb::Snapshot* snapshot) noexcept
+    : db_(&db), snapshot_(snapshot) {
+  UASSERT(snapshot_);
+}
+
+Snapshot::Snapshot(Snapshot&& other) noexcept
+    : db_(other.db_), snapshot_(std::exchange(other.snapshot_, nullptr)) {}
+
+Snapshot& Snapshot::operator=(Snapshot&& other) noexcept {
+  if (this != &other) {
+    Release();
+    db_ = other.db_;
+    snapshot_ = std::exchange(other.snapshot_, nullptr);
+  }
+  return *this;
+}
+
+Snapshot::~Snapshot() { Release(); }
+
+void Snapshot::Release() noexcept {
+  // Only drops a reference in the in-memory list of snapshots, so it is fine
+  // to do it on the coroutine thread
+  if (snapshot_) db_->ReleaseSnapshot(std::exchange(snapshot_, nullptr));
+}
+
+}  // namespace storages::rocks
+
+USERVER_NAMESPACE_END
@@ -0,0 +1,54 @@
+#include <userver/storages/rocks/write_batch.hpp>
+
+#include <userver/storages/rocks/exception.hpp>
+
+USERVER_NAMESPACE_BEGIN
+
+namespace storages::rocks {
+
+namespace {
+
+void CheckBatchStatus(const rocksdb::Status& status,
+                      std::string_view method_name) {
+  // Only fails if the batch exceeds its size limit
+  if (!status.ok()) {
+    throw RequestFailedException(method_name, status.ToString());
+  }
+}
+
+}  // namespace
+
+void WriteBatch::Put(std::string_view key, std::string_view value) {
+  Put(ColumnFamily{}, key, value);
+}
+
+void WriteBatch::Put(const ColumnFamily& column_family, std::string_view key,
+                     std::string_view value) {
+  // nullptr handle stands for the default column family
+  CheckBatchStatus(batch_.Put(column_family.handle_, key, value),
+                   "WriteBatch::Put");
+}
+
+void WriteBatch::Delete(std::string_view key) { Delete(ColumnFamily{}, key); }
+
+void WriteBatch::Delete(const ColumnFamily& column_family,
+                        std::string_view key) {
+  CheckBatchStatus(batch_.Delete(column_family.handle_, key),
+                   "WriteBatch::Delete");
+}
+
+void WriteBatch::DeleteRange(const ColumnFamily& column_family,
+                             std::string_view begin_key,
+                             std::string_view end_key) {
+  CheckBatchStatus(
+      batch_.DeleteRange(column_family.handle_, begin_key, end_key),
+      "WriteBatch::DeleteRange");
+}
+
+std::size_t WriteBatch::Size() const { return batch_.Count(); }
+
+void WriteBatch::Clear() { batch_.Clear(); }
+
+}  // namespace storages::rocks
+
+USERVER_NAMESPACE_END
@@ -3,6 +3,7 @@
 #include "hello_service.hpp"
 
 #include <userver/server/handlers/http_handler_base.hpp>
+#include <userver/server/handlers/http_handler_typed_json_base.hpp>
 
 #include "say_hello.hpp"
 
@@ -38,10 +39,30 @@ class Hello final : public server::handlers::HttpHandlerBase {
   /// [Handler]
 };
 
+class HelloTyped final
+    : public server::handlers::HttpHandlerTypedJsonBase<HelloRequestBody,
+                                                        HelloResponseBody> {
+ public:
+  static constexpr std::string_view kName = "handler-hello-typed-sample";
+
+  using HttpHandlerTypedJsonBase::HttpHandlerTypedJsonBase;
+
+  /// [Typed handler]
+  // The request is parsed by the generated SAX parser and the response is
+  // written by the generated WriteToStream(), no formats::json::Value is built
+  HelloResponseBody HandleRequestTypedJsonThrow(
+      const server::http::HttpRequest&, const HelloRequestBody& request,
+      server::request::RequestContext&) const override {
+    return SayHelloTo(request);
+  }
+  /// [Typed handler]
+};
+
 }  // namespace
 
 void AppendHello(components::ComponentList& component_list) {
   component_list.Append<Hello>();
+  component_list.Append<HelloTyped>();
 }
 
 }  // namespace samples::hello
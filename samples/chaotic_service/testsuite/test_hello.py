@@ -16,3 +16,52 @@ async def test_hello_base(service_client):
         'text': 'Hello, userver!\n',
         'current-time': '2019-01-01T12:00:00+00:00',
     }
+
+
+@pytest.mark.now('2019-01-01T12:00:00+0000')
+@pytest.mark.parametrize(
+    'body, name',
+    [
+        pytest.param({}, 'noname', id='default'),
+        pytest.param({'name': 'userver'}, 'userver', id='name'),
+        pytest.param(
+            {'name': 'with "quotes" and \\ \u043f\u0440\u0438\u0432\u0435\u0442'},
+            'with "quotes" and \\ \u043f\u0440\u0438\u0432\u0435\u0442',
+            id='escaping',
+        ),
+    ],
+)
+async def test_hello_typed(service_client, body, name):
+    response = await service_client.post('/hello-typed', json=body)
+    assert response.status == 200
+    assert response.headers['Content-Type'] == 'application/json; charset=utf-8'
+    assert response.json() == {
+        'text': f'Hello, {name}!\n',
+        'current-time': '2019-01-01T12:00:00+00:00',
+    }
+
+    # Same response as from the DOM based handler
+    response_dom = await service_client.post('/hello', json=body)
+    assert response_dom.json() == response.json()
+
+
+@pytest.mark.now('2019-01-01T12:00:00+0000')
+async def test_hello_typed_empty_body(service_client):
+    response = await service_client.post('/hello-typed', data='')
+    assert response.status == 200
+    assert response.json()['text'] == 'Hello, noname!\n'
+
+
+@pytest.mark.parametrize(
+    'data',
+    [
+        pytest.param('{"name": ', id='truncated'),
+        pytest.param('{"name": 1}', id='wrong-type'),
+        pytest.param('{"name": "x", "unknown": 1}', id='unknown-field'),
+        pytest.param('[]', id='not-object'),
+    ],
+)
+async def test_hello_typed_bad_request(service_client, data):
+    response = await service_client.post('/hello-typed', data=data)
+    assert response.status == 400
+    assert 'Invalid JSON body' in response.json()['message']
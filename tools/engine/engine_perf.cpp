@@ -1,3 +1,6 @@
+#include <sys/resource.h>
+
+#include <algorithm>
 #include <atomic>
 #include <iostream>
 
@@ -22,6 +25,11 @@ struct Config {
   size_t io_threads = 1;
   size_t cycle = 1000;
   size_t memory = 1000;
+  std::string task_queue = "global-task-queue";
+  std::string spinning_policy = "fixed";
+  size_t hot_workers = 0;
+  bool wakeup_latency = false;
+  size_t wakeup_interval_us = 100;
 };
 
 struct WorkerContext {
@@ -59,6 +67,23 @@ Config ParseConfig(int argc, char* argv[]) {
        "cycle iterations")  //
       ("memory,m", po::value(&config.memory)->default_value(config.memory),
        "memory used in each coro")  //
+      ("task-queue",
+       po::value(&config.task_queue)->default_value(config.task_queue),
+       "task queue type (global-task-queue, work-stealing-task-queue)")  //
+      ("spinning-policy",
+       po::value(&config.spinning_policy)
+           ->default_value(config.spinning_policy),
+       "idle workers spinning policy (fixed, adaptive)")  //
+      ("hot-workers",
+       po::value(&config.hot_workers)->default_value(config.hot_workers),
+       "idle workers that spin without parking")  //
+      ("wakeup-latency", po::bool_switch(&config.wakeup_latency),
+       "measure the latency of waking up an idle worker instead of the "
+       "throughput, 'count' tasks are started one by one")  //
+      ("wakeup-interval-us",
+       po::value(&config.wakeup_interval_us)
+           ->default_value(config.wakeup_interval_us),
+       "pause between the tasks in --wakeup-latency mode")  //
       ;
 
   po::variables_map vm;
@@ -73,6 +98,32 @@ Config ParseConfig(int argc, char* argv[]) {
   return config;
 }
 
+engine::TaskQueueType ParseTaskQueueType(const std::string& task_queue) {
+  if (task_queue == "global-task-queue") {
+    return engine::TaskQueueType::kGlobalTaskQueue;
+  }
+  if (task_queue == "work-stealing-task-queue") {
+    return engine::TaskQueueType::kWorkStealingTaskQueue;
+  }
+  throw std::runtime_error("Unknown task queue type: " + task_queue);
+}
+
+engine::SpinningPolicy ParseSpinningPolicy(const std::string& policy) {
+  if (policy == "fixed") return engine::SpinningPolicy::kFixed;
+  if (policy == "adaptive") return engine::SpinningPolicy::kAdaptive;
+  throw std::runtime_error("Unknown spinning policy: " + policy);
+}
+
+std::chrono::microseconds GetCpuTime() {
+  rusage usage{};
+  getrusage(RUSAGE_SELF, &usage);
+  const auto to_duration = [](const timeval& time) {
+    return std::chrono::seconds{time.tv_sec} +
+           std::chrono::microseconds{time.tv_usec};
+  };
+  return to_duration(usage.ru_utime) + to_duration(usage.ru_stime);
+}
+
 void Worker(WorkerContext& context) {
   LOG_DEBUG() << "Worker started";
   int count = context.config.count;
@@ -122,6 +173,44 @@ void DoWork(const Config& config) {
                 << " average RPS = " << rps;
 }
 
+// Starts tasks one by one with pauses long enough for the workers to go idle
+// and reports how long it took for a worker to pick each of them up
+void MeasureWakeupLatency(const Config& config) {
+  auto& tp = engine::current_task::GetTaskProcessor();
+
+  std::vector<std::chrono::nanoseconds> latencies;
+  latencies.reserve(config.count);
+
+  const auto cpu_start = GetCpuTime();
+  const auto wall_start = std::chrono::steady_clock::now();
+  for (size_t i = 0; i < config.count; ++i) {
+    const auto scheduled = std::chrono::steady_clock::now();
+    latencies.push_back(engine::AsyncNoSpan(tp, [scheduled] {
+                          return std::chrono::steady_clock::now() - scheduled;
+                        }).Get());
+    engine::SleepFor(std::chrono::microseconds{config.wakeup_interval_us});
+  }
+  const auto wall = std::chrono::steady_clock::now() - wall_start;
+  const auto cpu = GetCpuTime() - cpu_start;
+
+  std::sort(latencies.begin(), latencies.end());
+  const auto percentile = [&latencies](size_t percent) {
+    if (latencies.empty()) return std::chrono::nanoseconds{0};
+    return latencies[(latencies.size() - 1) * percent / 100];
+  };
+  const auto to_us = [](std::chrono::nanoseconds value) {
+    return std::chrono::duration<double, std::micro>(value).count();
+  };
+
+  std::cerr << "wakeup latency p50=" << to_us(percentile(50))
+            << "us p99=" << to_us(percentile(99))
+            << "us max=" << to_us(percentile(100)) << "us, cpu usage="
+            << 100.0 * cpu.count() /
+                   std::chrono::duration_cast<std::chrono::microseconds>(wall)
+                       .count()
+            << "%" << std::endl;
+}
+
 int main(int argc, char* argv[]) {
   const Config config = ParseConfig(argc, argv);
 
@@ -137,7 +226,21 @@ int main(int argc, char* argv[]) {
   logging::DefaultLoggerGuard guard{logger};
 
   LOG_WARNING() << "Starting using requests=" << config.count
-                << " coroutines=" << config.coroutines;
-
-  engine::RunStandalone(config.worker_threads, [&]() { DoWork(config); });
+                << " coroutines=" << config.coroutines
+                << " task_queue=" << config.task_queue
+                << " spinning_policy=" << config.spinning_policy
+                << " hot_workers=" << config.hot_workers;
+
+  engine::TaskProcessorPoolsConfig pools_config;
+  pools_config.task_queue_type = ParseTaskQueueType(config.task_queue);
+  pools_config.spinning_policy = ParseSpinningPolicy(config.spinning_policy);
+  pools_config.hot_workers = config.hot_workers;
+
+  engine::RunStandalone(config.worker_threads, pools_config, [&]() {
+    if (config.wakeup_latency) {
+      MeasureWakeupLatency(config);
+    } else {
+      DoWork(config);
+    }
+  });
 }
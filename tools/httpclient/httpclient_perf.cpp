@@ -1,3 +1,4 @@
+#include <algorithm>
 #include <fstream>
 #include <iostream>
 #include <list>
@@ -30,12 +31,16 @@ struct Config {
   http::HttpVersion http_version = http::HttpVersion::k11;
   std::string url_file;
   bool defer_events = false;
+  http::ConnectionAffinity connection_affinity =
+      http::ConnectionAffinity::kNone;
+  bool share_ssl_sessions = false;
 };
 
 struct WorkerContext {
   std::atomic<uint64_t> counter{0};
   const uint64_t print_each_counter;
   uint64_t response_len;
+  std::atomic<uint64_t> open_sockets{0};
 
   http::Client& http_client;
   const Config& config;
@@ -77,7 +82,13 @@ Config ParseConfig(int argc, char* argv[]) {
       "maximum HTTP connection number to a single host")(
       "defer-events",
       po::value(&config.defer_events)->default_value(config.defer_events),
-      "whether to defer curl events to a periodic timer");
+      "whether to defer curl events to a periodic timer")(
+      "connection-affinity", po::value<std::string>(),
+      "how requests choose the IO thread, possible values: none, destination")(
+      "share-ssl-sessions",
+      po::value(&config.share_ssl_sessions)
+          ->default_value(config.share_ssl_sessions),
+      "whether to share TLS sessions between IO threads");
 
   po::variables_map vm;
   po::store(po::parse_command_line(argc, argv, desc), vm);
@@ -107,6 +118,18 @@ Config ParseConfig(int argc, char* argv[]) {
     }
   }
 
+  if (vm.count("connection-affinity")) {
+    auto value = vm["connection-affinity"].as<std::string>();
+    if (value == "none")
+      config.connection_affinity = http::ConnectionAffinity::kNone;
+    else if (value == "destination")
+      config.connection_affinity = http::ConnectionAffinity::kDestination;
+    else {
+      std::cerr << "--connection-affinity value is unknown" << std::endl;
+      exit(1);
+    }
+  }
+
   if (config.url_file.empty()) {
     std::cerr << "url-file is undefined" << std::endl;
     std::cout << desc << std::endl;
@@ -160,6 +183,7 @@ void Worker(WorkerContext& context) {
 
       auto response = request.perform();
       context.response_len += response->body().size();
+      context.open_sockets += response->GetStats().open_socket_count;
       LOG_DEBUG() << "Got response body_size=" << response->body().size();
       auto ts3 = std::chrono::system_clock::now();
       LOG_INFO() << "timings create="
@@ -185,9 +209,11 @@ void DoWork(const Config& config, const std::vector<std::string>& urls) {
   LOG_INFO() << "Starting thread " << std::this_thread::get_id();
 
   auto& tp = engine::current_task::GetTaskProcessor();
+  http::ClientSettings settings{"", config.io_threads, config.defer_events};
+  settings.connection_affinity = config.connection_affinity;
+  settings.share_ssl_sessions = config.share_ssl_sessions;
   http::Client http_client{
-      {"", config.io_threads, config.defer_events},
-      tp,
+      std::move(settings), tp,
       std::vector<utils::NotNull<clients::http::Plugin*>>{}};
   LOG_INFO() << "Client created";
 
@@ -195,8 +221,8 @@ void DoWork(const Config& config, const std::vector<std::string>& urls) {
   if (config.max_host_connections > 0)
     http_client.SetMaxHostConnections(config.max_host_connections);
 
-  WorkerContext worker_context{{0},    2000, 0, std::ref(http_client),
-                               config, urls};
+  WorkerContext worker_context{{0},   2000, 0,   {0},
+                               std::ref(http_client), config, urls};
 
   std::vector<engine::TaskWithResult<void>> tasks;
   tasks.resize(config.coroutines);
@@ -219,6 +245,11 @@ void DoWork(const Config& config, const std::vector<std::string>& urls) {
   LOG_CRITICAL() << "counter = " << worker_context.counter.load()
                  << " sum response body size = " << worker_context.response_len
                  << " average RPS = " << rps;
+  // Every opened socket means a full TCP (and TLS) handshake
+  LOG_CRITICAL() << "opened connections = "
+                 << worker_context.open_sockets.load() << " per request = "
+                 << static_cast<double>(worker_context.open_sockets.load()) /
+                        std::max<std::size_t>(config.count, 1);
 }
 
 }  // namespace
@@ -242,7 +273,13 @@ int main(int argc, char* argv[]) {
                 << " timeout=" << config.timeout_ms << "ms";
   LOG_WARNING() << "multiplexing ="
                 << (config.multiplexing ? "enabled" : "disabled")
-                << " max_host_connections=" << config.max_host_connections;
+                << " max_host_connections=" << config.max_host_connections
+                << " connection_affinity="
+                << (config.connection_affinity ==
+                            clients::http::ConnectionAffinity::kDestination
+                        ? "destination"
+                        : "none")
+                << " share_ssl_sessions=" << config.share_ssl_sessions;
 
   const std::vector<std::string> urls = ReadUrls(config);
 
@@ -0,0 +1,105 @@
+#pragma once
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+
+#include <userver/utils/fixed_array.hpp>
+
+USERVER_NAMESPACE_BEGIN
+
+namespace cache::impl {
+
+/// Count-min sketch of small saturating counters that estimates how often
+/// a key was accessed recently. Same double hashing scheme as
+/// utils::FilterBloom, but works with precomputed hashes and periodically
+/// halves all the counters, so that the history of old accesses fades out.
+class FrequencySketch final {
+ public:
+  static constexpr std::uint8_t kMaxFrequency = 15;
+
+  explicit FrequencySketch(std::size_t capacity)
+      : counters_(CountersFor(capacity), 0),
+        sample_size_(SampleSizeFor(capacity)) {}
+
+  void Increment(std::size_t hash) noexcept {
+    const auto [hash_1, hash_2] = SplitHash(hash);
+    const auto min_frequency = MinFrequency(hash_1, hash_2);
+    if (min_frequency == kMaxFrequency) return;
+
+    for (std::size_t step = 0; step < kHashFunctionsCount; ++step) {
+      auto& counter = counters_[Index(hash_1, hash_2, step)];
+      if (counter == min_frequency) ++counter;
+    }
+
+    if (++additions_ >= sample_size_) Age();
+  }
+
+  std::uint8_t Estimate(std::size_t hash) const noexcept {
+    const auto [hash_1, hash_2] = SplitHash(hash);
+    return MinFrequency(hash_1, hash_2);
+  }
+
+  void Clear() noexcept {
+    std::fill(counters_.begin(), counters_.end(), 0);
+    additions_ = 0;
+  }
+
+ private:
+  static constexpr std::size_t kHashFunctionsCount = 4;
+  static constexpr std::size_t kCountersPerItem = 8;
+  static constexpr std::size_t kSamplesPerItem = 10;
+
+  struct HashPair {
+    std::uint32_t first;
+    std::uint32_t second;
+  };
+
+  static std::size_t CountersFor(std::size_t capacity) noexcept {
+    // Power of two to replace the modulo with a mask
+    std::size_t result = 64;
+    while (result < capacity * kCountersPerItem) result *= 2;
+    return result;
+  }
+
+  static std::size_t SampleSizeFor(std::size_t capacity) noexcept {
+    return std::max<std::size_t>(capacity * kSamplesPerItem, 64);
+  }
+
+  static HashPair SplitHash(std::size_t hash) noexcept {
+    // std::hash of integers is identity, mix the bits before splitting
+    const std::uint64_t mixed =
+        static_cast<std::uint64_t>(hash) * 0x9E3779B97F4A7C15ULL;
+    return {static_cast<std::uint32_t>(mixed >> 32),
+            static_cast<std::uint32_t>(mixed) | 1};
+  }
+
+  std::size_t Index(std::uint32_t hash_1, std::uint32_t hash_2,
+                    std::size_t step) const noexcept {
+    // the idea was taken from
+    // https://www.eecs.harvard.edu/~michaelm/postscripts/tr-02-05.pdf
+    return (hash_1 + std::uint64_t{hash_2} * step) & (counters_.size() - 1);
+  }
+
+  std::uint8_t MinFrequency(std::uint32_t hash_1,
+                            std::uint32_t hash_2) const noexcept {
+    std::uint8_t result = kMaxFrequency;
+    for (std::size_t step = 0; step < kHashFunctionsCount; ++step) {
+      result = std::min(result, counters_[Index(hash_1, hash_2, step)]);
+    }
+    return result;
+  }
+
+  void Age() noexcept {
+    for (auto& counter : counters_) counter /= 2;
+    additions_ /= 2;
+  }
+
+  utils::FixedArray<std::uint8_t> counters_;
+  std::size_t sample_size_;
+  std::size_t additions_{0};
+};
+
+}  // namespace cache::impl
+
+USERVER_NAMESPACE_END
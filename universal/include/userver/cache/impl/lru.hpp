@@ -120,6 +120,9 @@ class LruBase final {
 
   U* Get(const T& key);
 
+  // Same as Get, but doesn't update the usage
+  const U* Peek(const T& key) const;
+
   const T* GetLeastUsedKey() const;
 
   U* GetLeastUsedValue();
@@ -236,6 +239,13 @@ U* LruBase<T, U, Hash, Eq>::Get(const T& key) {
   return &it->GetValue();
 }
 
+template <typename T, typename U, typename Hash, typename Eq>
+const U* LruBase<T, U, Hash, Eq>::Peek(const T& key) const {
+  auto it = map_.find(key, map_.hash_function(), map_.key_eq());
+  if (it == map_.end()) return nullptr;
+  return &it->GetValue();
+}
+
 template <typename T, typename U, typename Hash, typename Eq>
 const T* LruBase<T, U, Hash, Eq>::GetLeastUsedKey() const {
   if (list_.empty()) return nullptr;
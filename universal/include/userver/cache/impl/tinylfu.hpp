@@ -0,0 +1,417 @@
+#pragma once
+
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <memory>
+#include <type_traits>
+#include <utility>
+
+#include <userver/cache/impl/frequency_sketch.hpp>
+#include <userver/cache/impl/lru.hpp>
+#include <userver/utils/assert.hpp>
+
+/*
+
+W-TinyLFU: a small LRU window for new keys in front of a segmented LRU main
+area. A key evicted from the window gets into the main area only if it was
+accessed more frequently than the main area eviction candidate, so bulk scans
+of cold keys do not flush the hot set.
+
+https://arxiv.org/abs/1512.00727
+
+*/
+
+USERVER_NAMESPACE_BEGIN
+
+namespace cache::impl {
+
+template <typename U>
+struct TinyLfuEntry final {
+  template <typename... Args>
+  explicit TinyLfuEntry(std::in_place_t, Args&&... args)
+      : value(std::forward<Args>(args)...) {}
+
+  TinyLfuEntry(TinyLfuEntry&& other) noexcept(
+      std::is_nothrow_move_constructible_v<U>)
+      : value(std::move(other.value)) {}
+
+  TinyLfuEntry& operator=(TinyLfuEntry&& other) noexcept(
+      std::is_nothrow_move_assignable_v<U>) {
+    value = std::move(other.value);
+    return *this;
+  }
+
+  U value;
+  // Set by the concurrent readers instead of reordering the lists
+  mutable std::atomic<bool> accessed{false};
+};
+
+// Lossy buffer of the hashes of keys read under a shared lock. Record() may
+// be called concurrently, Drain() requires exclusive access.
+class TinyLfuReadBuffer final {
+ public:
+  static constexpr std::size_t kCapacity = 64;
+
+  TinyLfuReadBuffer() = default;
+
+  // Pending reads are dropped
+  TinyLfuReadBuffer(TinyLfuReadBuffer&&) noexcept {}
+  TinyLfuReadBuffer& operator=(TinyLfuReadBuffer&&) noexcept {
+    size_.store(0, std::memory_order_relaxed);
+    return *this;
+  }
+
+  // Returns true if the buffer is full and should be drained
+  bool Record(std::size_t hash) noexcept {
+    const auto index = size_.fetch_add(1, std::memory_order_relaxed);
+    if (index < kCapacity) hashes_[index] = hash;
+    return index + 1 >= kCapacity;
+  }
+
+  bool IsFull() const noexcept {
+    return size_.load(std::memory_order_relaxed) >= kCapacity;
+  }
+
+  template <typename Function>
+  void Drain(Function&& func) {
+    const auto size =
+        std::min(size_.load(std::memory_order_relaxed), kCapacity);
+    for (std::size_t i = 0; i < size; ++i) func(hashes_[i]);
+    size_.store(0, std::memory_order_relaxed);
+  }
+
+ private:
+  std::array<std::size_t, kCapacity> hashes_{};
+  std::atomic<std::size_t> size_{0};
+};
+
+template <typename T, typename U, typename Hash = std::hash<T>,
+          typename Equal = std::equal_to<T>>
+class TinyLfuBase final {
+ public:
+  explicit TinyLfuBase(std::size_t max_size, const Hash& hash = Hash(),
+                       const Equal& equal = Equal());
+
+  TinyLfuBase(TinyLfuBase&& other) noexcept = default;
+  TinyLfuBase& operator=(TinyLfuBase&& other) noexcept = default;
+
+  TinyLfuBase(const TinyLfuBase&) = delete;
+  TinyLfuBase& operator=(const TinyLfuBase&) = delete;
+
+  bool Put(const T& key, U value);
+
+  template <typename... Args>
+  U* Emplace(const T& key, Args&&... args);
+
+  void Erase(const T& key);
+
+  U* Get(const T& key);
+
+  // Same as Get, but doesn't reorder the lists and may be called concurrently
+  // with other Peek calls. The access is applied by the next modifying call
+  // or by ProcessPendingReads().
+  const U* Peek(const T& key) const;
+
+  bool HasManyPendingReads() const noexcept { return read_buffer_.IsFull(); }
+
+  void ProcessPendingReads();
+
+  void SetMaxSize(std::size_t new_max_size);
+
+  void Clear() noexcept;
+
+  template <typename Function>
+  void VisitAll(Function&& func) const;
+
+  template <typename Function>
+  void VisitAll(Function&& func);
+
+  std::size_t GetSize() const;
+
+  std::size_t GetCapacity() const;
+
+ private:
+  using Entry = TinyLfuEntry<U>;
+  using Part = LruBase<T, Entry, Hash, Equal>;
+  using Node = LruNode<T, Entry>;
+  using NodeType = typename Part::NodeType;
+
+  struct Capacities {
+    std::size_t window;
+    std::size_t main;
+    std::size_t protected_part;
+  };
+
+  static Capacities SplitCapacity(std::size_t max_size);
+
+  Entry* FindAndTouch(const T& key);
+  Entry& Promote(NodeType&& node);
+  NodeType MakeRoom();
+  NodeType Admit(NodeType&& candidate);
+  void ShrinkMain();
+
+  Capacities capacities_;
+  Part window_;
+  Part probation_;
+  Part protected_;
+  FrequencySketch sketch_;
+  mutable TinyLfuReadBuffer read_buffer_;
+  Hash hash_;
+};
+
+template <typename T, typename U, typename Hash, typename Equal>
+typename TinyLfuBase<T, U, Hash, Equal>::Capacities
+TinyLfuBase<T, U, Hash, Equal>::SplitCapacity(std::size_t max_size) {
+  UASSERT(max_size > 0);
+  Capacities result{};
+  result.window = std::max<std::size_t>(max_size / 100, 1);
+  result.main = std::max<std::size_t>(max_size - result.window, 2);
+  result.protected_part = std::max<std::size_t>(result.main * 4 / 5, 1);
+  return result;
+}
+
+template <typename T, typename U, typename Hash, typename Equal>
+TinyLfuBase<T, U, Hash, Equal>::TinyLfuBase(std::size_t max_size,
+                                            const Hash& hash,
+                                            const Equal& equal)
+    : capacities_(SplitCapacity(max_size)),
+      window_(capacities_.window, hash, equal),
+      probation_(capacities_.main, hash, equal),
+      protected_(capacities_.protected_part, hash, equal),
+      sketch_(capacities_.window + capacities_.main),
+      hash_(hash) {}
+
+template <typename T, typename U, typename Hash, typename Equal>
+bool TinyLfuBase<T, U, Hash, Equal>::Put(const T& key, U value) {
+  ProcessPendingReads();
+  sketch_.Increment(hash_(key));
+
+  auto* entry = FindAndTouch(key);
+  if (entry) {
+    entry->value = std::move(value);
+    return false;
+  }
+
+  auto node = MakeRoom();
+  if (node) {
+    // Reuse the evicted node to avoid an allocation
+    node->SetKey(key);
+    node->GetValue().value = std::move(value);
+    node->GetValue().accessed.store(false, std::memory_order_relaxed);
+  } else {
+    node = std::make_unique<Node>(T{key}, std::in_place, std::move(value));
+  }
+  window_.InsertNode(std::move(node));
+  return true;
+}
+
+template <typename T, typename U, typename Hash, typename Equal>
+template <typename... Args>
+U* TinyLfuBase<T, U, Hash, Equal>::Emplace(const T& key, Args&&... args) {
+  ProcessPendingReads();
+  sketch_.Increment(hash_(key));
+
+  auto* entry = FindAndTouch(key);
+  if (entry) return &entry->value;
+
+  MakeRoom();
+  return &window_
+              .InsertNode(std::make_unique<Node>(T{key}, std::in_place,
+                                                 std::forward<Args>(args)...))
+              .value;
+}
+
+template <typename T, typename U, typename Hash, typename Equal>
+void TinyLfuBase<T, U, Hash, Equal>::Erase(const T& key) {
+  window_.Erase(key);
+  probation_.Erase(key);
+  protected_.Erase(key);
+}
+
+template <typename T, typename U, typename Hash, typename Equal>
+U* TinyLfuBase<T, U, Hash, Equal>::Get(const T& key) {
+  ProcessPendingReads();
+  sketch_.Increment(hash_(key));
+
+  auto* entry = FindAndTouch(key);
+  return entry ? &entry->value : nullptr;
+}
+
+template <typename T, typename U, typename Hash, typename Equal>
+const U* TinyLfuBase<T, U, Hash, Equal>::Peek(const T& key) const {
+  // Misses are counted too, a frequently requested key should be admitted
+  read_buffer_.Record(hash_(key));
+
+  const Entry* entry = window_.Peek(key);
+  if (!entry) entry = protected_.Peek(key);
+  if (!entry) entry = probation_.Peek(key);
+  if (!entry) return nullptr;
+
+  if (!entry->accessed.load(std::memory_order_relaxed)) {
+    entry->accessed.store(true, std::memory_order_relaxed);
+  }
+  return &entry->value;
+}
+
+template <typename T, typename U, typename Hash, typename Equal>
+void TinyLfuBase<T, U, Hash, Equal>::ProcessPendingReads() {
+  read_buffer_.Drain([this](std::size_t hash) { sketch_.Increment(hash); });
+}
+
+template <typename T, typename U, typename Hash, typename Equal>
+void TinyLfuBase<T, U, Hash, Equal>::SetMaxSize(std::size_t new_max_size) {
+  UASSERT(new_max_size > 0);
+  if (!new_max_size) ++new_max_size;
+
+  const auto capacities = SplitCapacity(new_max_size);
+  if (capacities.window == capacities_.window &&
+      capacities.main == capacities_.main) {
+    return;
+  }
+
+  capacities_ = capacities;
+  window_.SetMaxSize(capacities_.window);
+  protected_.SetMaxSize(capacities_.protected_part);
+  probation_.SetMaxSize(capacities_.main);
+  ShrinkMain();
+
+  sketch_ = FrequencySketch(capacities_.window + capacities_.main);
+}
+
+template <typename T, typename U, typename Hash, typename Equal>
+void TinyLfuBase<T, U, Hash, Equal>::Clear() noexcept {
+  window_.Clear();
+  probation_.Clear();
+  protected_.Clear();
+  sketch_.Clear();
+  read_buffer_.Drain([](std::size_t) {});
+}
+
+template <typename T, typename U, typename Hash, typename Equal>
+template <typename Function>
+void TinyLfuBase<T, U, Hash, Equal>::VisitAll(Function&& func) const {
+  const auto visitor = [&func](const T& key, const Entry& entry) {
+    func(key, entry.value);
+  };
+  window_.VisitAll(visitor);
+  probation_.VisitAll(visitor);
+  protected_.VisitAll(visitor);
+}
+
+template <typename T, typename U, typename Hash, typename Equal>
+template <typename Function>
+void TinyLfuBase<T, U, Hash, Equal>::VisitAll(Function&& func) {
+  const auto visitor = [&func](const T& key, Entry& entry) {
+    func(key, entry.value);
+  };
+  window_.VisitAll(visitor);
+  probation_.VisitAll(visitor);
+  protected_.VisitAll(visitor);
+}
+
+template <typename T, typename U, typename Hash, typename Equal>
+std::size_t TinyLfuBase<T, U, Hash, Equal>::GetSize() const {
+  return window_.GetSize() + probation_.GetSize() + protected_.GetSize();
+}
+
+template <typename T, typename U, typename Hash, typename Equal>
+std::size_t TinyLfuBase<T, U, Hash, Equal>::GetCapacity() const {
+  return capacities_.window + capacities_.main;
+}
+
+template <typename T, typename U, typename Hash, typename Equal>
+typename TinyLfuBase<T, U, Hash, Equal>::Entry*
+TinyLfuBase<T, U, Hash, Equal>::FindAndTouch(const T& key) {
+  auto* entry = window_.Get(key);
+  if (entry) return entry;
+
+  entry = protected_.Get(key);
+  if (entry) return entry;
+
+  auto node = probation_.ExtractNode(key);
+  if (!node) return nullptr;
+  return &Promote(std::move(node));
+}
+
+template <typename T, typename U, typename Hash, typename Equal>
+typename TinyLfuBase<T, U, Hash, Equal>::Entry&
+TinyLfuBase<T, U, Hash, Equal>::Promote(NodeType&& node) {
+  node->GetValue().accessed.store(false, std::memory_order_relaxed);
+
+  // Second chance for the protected keys read under a shared lock
+  for (auto attempts = protected_.GetSize();
+       attempts > 0 && protected_.GetSize() >= capacities_.protected_part;
+       --attempts) {
+    auto& lru = *protected_.GetLeastUsedValue();
+    if (!lru.accessed.exchange(false, std::memory_order_relaxed)) break;
+    protected_.InsertNode(protected_.ExtractLeastUsedNode());
+  }
+
+  if (protected_.GetSize() >= capacities_.protected_part) {
+    probation_.InsertNode(protected_.ExtractLeastUsedNode());
+  }
+  return protected_.InsertNode(std::move(node));
+}
+
+// Returns the evicted node, if any
+template <typename T, typename U, typename Hash, typename Equal>
+typename TinyLfuBase<T, U, Hash, Equal>::NodeType
+TinyLfuBase<T, U, Hash, Equal>::MakeRoom() {
+  if (window_.GetSize() < capacities_.window) return {};
+
+  // Second chance for the window keys read under a shared lock
+  for (auto attempts = window_.GetSize(); attempts > 1; --attempts) {
+    auto& lru = *window_.GetLeastUsedValue();
+    if (!lru.accessed.exchange(false, std::memory_order_relaxed)) break;
+    window_.InsertNode(window_.ExtractLeastUsedNode());
+  }
+  return Admit(window_.ExtractLeastUsedNode());
+}
+
+// Moves the candidate from the window to the main area if it is accessed more
+// frequently than the main area victim. Returns the loser, if any.
+template <typename T, typename U, typename Hash, typename Equal>
+typename TinyLfuBase<T, U, Hash, Equal>::NodeType
+TinyLfuBase<T, U, Hash, Equal>::Admit(NodeType&& candidate) {
+  UASSERT(candidate);
+  if (probation_.GetSize() + protected_.GetSize() < capacities_.main) {
+    probation_.InsertNode(std::move(candidate));
+    return {};
+  }
+
+  // Keys read under a shared lock are not eviction candidates
+  for (auto attempts = probation_.GetSize(); attempts > 1; --attempts) {
+    if (!probation_.GetLeastUsedValue()->accessed.load(
+            std::memory_order_relaxed)) {
+      break;
+    }
+    Promote(probation_.ExtractLeastUsedNode());
+  }
+
+  const auto* victim_key = probation_.GetLeastUsedKey();
+  UASSERT(victim_key);
+  if (sketch_.Estimate(hash_(candidate->GetKey())) <=
+      sketch_.Estimate(hash_(*victim_key))) {
+    return std::move(candidate);
+  }
+
+  auto victim = probation_.ExtractLeastUsedNode();
+  probation_.InsertNode(std::move(candidate));
+  return victim;
+}
+
+template <typename T, typename U, typename Hash, typename Equal>
+void TinyLfuBase<T, U, Hash, Equal>::ShrinkMain() {
+  while (probation_.GetSize() + protected_.GetSize() > capacities_.main) {
+    if (probation_.GetSize() > 0) {
+      probation_.ExtractLeastUsedNode();
+    } else {
+      protected_.ExtractLeastUsedNode();
+    }
+  }
+}
+
+}  // namespace cache::impl
+
+USERVER_NAMESPACE_END
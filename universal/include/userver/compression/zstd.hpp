@@ -1,5 +1,7 @@
 #pragma once
 
+#include <memory>
+#include <string>
 #include <string_view>
 
 #include <userver/compression/error.hpp>
@@ -12,6 +14,36 @@ namespace compression::zstd {
 /// @throws DecompressionError
 std::string Decompress(std::string_view compressed, size_t max_size);
 
+/// Compresses the string with the given compression level.
+/// @throws CompressionError
+std::string Compress(std::string_view data, int level);
+
+/// @brief Compresses the data chunk by chunk into a single zstd frame.
+///
+/// Output of each Compress() call is flushed, so it may be sent to the
+/// client right away and decompressed on arrival.
+class StreamCompressor final {
+ public:
+  /// @throws CompressionError
+  explicit StreamCompressor(int level);
+
+  StreamCompressor(StreamCompressor&&) noexcept;
+  StreamCompressor& operator=(StreamCompressor&&) noexcept;
+  ~StreamCompressor();
+
+  /// Compresses the chunk and flushes the output.
+  /// @throws CompressionError
+  std::string Compress(std::string_view chunk);
+
+  /// Finishes the frame, no calls are allowed after it.
+  /// @throws CompressionError
+  std::string Finish();
+
+ private:
+  struct Impl;
+  std::unique_ptr<Impl> impl_;
+};
+
 }  // namespace compression::zstd
 
 USERVER_NAMESPACE_END
@@ -9,6 +9,7 @@
 #include <userver/formats/parse/to.hpp>
 #include <userver/http/predefined_header.hpp>
 #include <userver/utils/fast_pimpl.hpp>
+#include <userver/utils/impl/monotonic_arena.hpp>
 
 USERVER_NAMESPACE_BEGIN
 
@@ -65,6 +66,11 @@ class HeaderMap final {
   /// Constructor with capacity: preallocates `capacity` elements for internal
   /// storage.
   HeaderMap(std::size_t capacity);
+  /// @cond
+  /// Constructor with capacity that allocates the entries from the arena.
+  /// Copies of the map use the heap.
+  HeaderMap(std::size_t capacity, utils::impl::MonotonicArena& arena);
+  /// @endcond
   /// Constructor from iterator pair:
   /// `HeaderMap{key_value_pairs.begin(), key_value_pairs.end()}`.
   /// Its unspecified which pair is inserted in case of names not being unique.
@@ -269,7 +275,7 @@ class HeaderMap final {
   template <std::size_t Size>
   [[noreturn]] static void ReportMisuse();
 
-  utils::FastPimpl<header_map::Map, 272, 8> impl_;
+  utils::FastPimpl<header_map::Map, 280, 8> impl_;
 };
 
 template <typename InputIt>
@@ -342,6 +348,9 @@ class MapEntry final {
   Slot slot_{};
 };
 
+using MapEntries =
+    std::vector<MapEntry, utils::impl::ArenaAllocator<MapEntry>>;
+
 }  // namespace header_map
 
 class HeaderMap::Iterator final {
@@ -357,8 +366,7 @@ class HeaderMap::Iterator final {
   // The underlying iterator is a reversed one to do not invalidate
   // end() on erase - end() is actually an rbegin() of underlying storage and is
   // only invalidated on reallocation.
-  using UnderlyingIterator =
-      std::vector<header_map::MapEntry>::reverse_iterator;
+  using UnderlyingIterator = header_map::MapEntries::reverse_iterator;
 
   Iterator();
   explicit Iterator(UnderlyingIterator it);
@@ -401,8 +409,7 @@ class HeaderMap::ConstIterator final {
   // The underlying iterator is a reversed one to do not invalidate
   // end() on erase - end() is actually an rbegin() of underlying storage and is
   // only invalidated on reallocation.
-  using UnderlyingIterator =
-      std::vector<header_map::MapEntry>::const_reverse_iterator;
+  using UnderlyingIterator = header_map::MapEntries::const_reverse_iterator;
 
   ConstIterator();
   explicit ConstIterator(UnderlyingIterator it);
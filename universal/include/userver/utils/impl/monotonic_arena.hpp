@@ -0,0 +1,109 @@
+#pragma once
+
+#include <cstddef>
+#include <new>
+#include <type_traits>
+
+USERVER_NAMESPACE_BEGIN
+
+namespace utils::impl {
+
+/// @brief Monotonic memory arena, e.g. of a single HTTP request.
+///
+/// Memory is handed out sequentially from an inline buffer and then from
+/// geometrically growing heap blocks. Nothing is freed until the arena is
+/// destroyed, e.g. together with the request after the response is sent.
+///
+/// Not thread-safe, the request is processed by a single task at a time.
+class MonotonicArena final {
+ public:
+  static constexpr std::size_t kInlineSize = 1024;
+
+  struct Stats final {
+    /// Bytes handed out by the arena
+    std::size_t allocated_bytes{0};
+    /// Heap blocks allocated after the inline buffer was exhausted
+    std::size_t heap_blocks{0};
+  };
+
+  MonotonicArena() noexcept = default;
+  ~MonotonicArena();
+
+  MonotonicArena(const MonotonicArena&) = delete;
+  MonotonicArena& operator=(const MonotonicArena&) = delete;
+
+  void* Allocate(std::size_t size, std::size_t alignment);
+
+  const Stats& GetStats() const noexcept { return stats_; }
+
+ private:
+  struct BlockHeader;
+
+  void* AllocateFromNewBlock(std::size_t size, std::size_t alignment);
+
+  alignas(std::max_align_t) std::byte inline_buffer_[kInlineSize];
+  std::byte* current_{inline_buffer_};
+  std::size_t available_{kInlineSize};
+  BlockHeader* blocks_{nullptr};
+  Stats stats_;
+};
+
+/// @brief Allocator for the standard containers that live in an arena.
+///
+/// A default constructed allocator uses the heap. The allocator is never
+/// propagated: copies of a container use the heap, and assigning
+/// a container moves the elements instead of adopting the arena. So the
+/// containers that are handed out to the user code never outlive the arena.
+template <typename T>
+class ArenaAllocator {
+ public:
+  using value_type = T;
+  using propagate_on_container_copy_assignment = std::false_type;
+  using propagate_on_container_move_assignment = std::false_type;
+  using propagate_on_container_swap = std::false_type;
+  using is_always_equal = std::false_type;
+
+  ArenaAllocator() noexcept = default;
+
+  explicit ArenaAllocator(MonotonicArena& arena) noexcept : arena_(&arena) {}
+
+  template <typename U>
+  ArenaAllocator(const ArenaAllocator<U>& other) noexcept
+      : arena_(other.GetArena()) {}
+
+  T* allocate(std::size_t n) {
+    if (!arena_) {
+      return static_cast<T*>(::operator new(n * sizeof(T)));
+    }
+    return static_cast<T*>(arena_->Allocate(n * sizeof(T), alignof(T)));
+  }
+
+  void deallocate(T* p, std::size_t) noexcept {
+    if (!arena_) {
+      ::operator delete(p);
+    }
+  }
+
+  ArenaAllocator select_on_container_copy_construction() const noexcept {
+    return ArenaAllocator{};
+  }
+
+  MonotonicArena* GetArena() const noexcept { return arena_; }
+
+  template <typename U>
+  bool operator==(const ArenaAllocator<U>& other) const noexcept {
+    return arena_ == other.GetArena();
+  }
+
+  template <typename U>
+  bool operator!=(const ArenaAllocator<U>& other) const noexcept {
+    return arena_ != other.GetArena();
+  }
+
+ private:
+  MonotonicArena* arena_{nullptr};
+};
+
+}  // namespace utils::impl
+
+USERVER_NAMESPACE_END
@@ -1,6 +1,7 @@
 #pragma once
 
 #include <functional>
+#include <memory>
 #include <string_view>
 #include <unordered_map>
 #include <unordered_set>
@@ -38,20 +39,24 @@ struct TransparentHash : public std::hash<std::string_view> {
 
 #ifndef USERVER_IMPL_TRANSPARENT_HASH_LEGACY
 template <typename Key, typename Value, typename Hash = TransparentHash<Key>,
-          typename Equal = std::equal_to<>>
-using TransparentMap = std::unordered_map<Key, Value, Hash, Equal>;
+          typename Equal = std::equal_to<>,
+          typename Allocator = std::allocator<std::pair<const Key, Value>>>
+using TransparentMap = std::unordered_map<Key, Value, Hash, Equal, Allocator>;
 
 template <typename Key, typename Hash = TransparentHash<Key>,
-          typename Equal = std::equal_to<>>
-using TransparentSet = std::unordered_set<Key, Hash, Equal>;
+          typename Equal = std::equal_to<>,
+          typename Allocator = std::allocator<Key>>
+using TransparentSet = std::unordered_set<Key, Hash, Equal, Allocator>;
 #else
 template <typename Key, typename Value, typename Hash = TransparentHash<Key>,
-          typename Equal = std::equal_to<>>
-using TransparentMap = boost::unordered_map<Key, Value, Hash, Equal>;
+          typename Equal = std::equal_to<>,
+          typename Allocator = std::allocator<std::pair<const Key, Value>>>
+using TransparentMap = boost::unordered_map<Key, Value, Hash, Equal, Allocator>;
 
 template <typename Key, typename Hash = TransparentHash<Key>,
-          typename Equal = std::equal_to<>>
-using TransparentSet = boost::unordered_set<Key, Hash, Equal>;
+          typename Equal = std::equal_to<>,
+          typename Allocator = std::allocator<Key>>
+using TransparentSet = boost::unordered_set<Key, Hash, Equal, Allocator>;
 #endif
 
 template <typename TransparentContainer, typename Key>
@@ -0,0 +1,137 @@
+#include <benchmark/benchmark.h>
+
+#include <cmath>
+#include <random>
+#include <vector>
+
+#include <userver/cache/impl/slru.hpp>
+#include <userver/cache/impl/tinylfu.hpp>
+#include <userver/cache/lru_map.hpp>
+
+USERVER_NAMESPACE_BEGIN
+
+namespace {
+
+using Lru = cache::LruMap<unsigned, unsigned>;
+using Slru = cache::impl::SlruBase<unsigned, unsigned>;
+using TinyLfu = cache::impl::TinyLfuBase<unsigned, unsigned>;
+
+constexpr unsigned kElementsCount = 1000;
+constexpr unsigned kKeysCount = 100 * kElementsCount;
+constexpr std::size_t kRequestsCount = 50 * kKeysCount;
+
+template <typename Cache>
+Cache MakeCache() {
+  if constexpr (std::is_same_v<Cache, Slru>) {
+    return Cache(kElementsCount / 5, kElementsCount - kElementsCount / 5);
+  } else {
+    return Cache(kElementsCount);
+  }
+}
+
+// Zipf-distributed hot keys mixed with bulk scans of cold keys, each cold key
+// is requested `scan_repeats` times in a row
+std::vector<unsigned> MakeRequests(unsigned scan_repeats) {
+  std::vector<double> weights(kKeysCount);
+  for (unsigned i = 0; i < kKeysCount; ++i) {
+    weights[i] = 1.0 / (i + 1);
+  }
+  std::discrete_distribution<unsigned> zipf(weights.begin(), weights.end());
+  std::minstd_rand rng(42);
+
+  std::vector<unsigned> requests;
+  requests.reserve(kRequestsCount);
+  unsigned cold_key = kKeysCount;
+  while (requests.size() < kRequestsCount) {
+    for (unsigned i = 0; i < 10 * kElementsCount; ++i) {
+      requests.push_back(zipf(rng));
+    }
+    for (unsigned i = 0; i < 2 * kElementsCount; ++i) {
+      for (unsigned j = 0; j < scan_repeats; ++j) {
+        requests.push_back(cold_key);
+      }
+      ++cold_key;
+    }
+  }
+  return requests;
+}
+
+}  // namespace
+
+template <typename Cache>
+void CacheHitRate(benchmark::State& state) {
+  const auto requests = MakeRequests(state.range(0));
+  std::size_t hits = 0;
+  std::size_t total = 0;
+  for ([[maybe_unused]] auto _ : state) {
+    auto cache = MakeCache<Cache>();
+    for (const auto key : requests) {
+      if (cache.Get(key)) {
+        ++hits;
+      } else {
+        cache.Put(key, key);
+      }
+    }
+    total += requests.size();
+  }
+  state.counters["hit_rate"] = static_cast<double>(hits) / total;
+  state.SetItemsProcessed(total);
+}
+BENCHMARK_TEMPLATE(CacheHitRate, Lru)->Arg(1)->Arg(2);
+BENCHMARK_TEMPLATE(CacheHitRate, Slru)->Arg(1)->Arg(2);
+BENCHMARK_TEMPLATE(CacheHitRate, TinyLfu)->Arg(1)->Arg(2);
+
+void TinyLfuPut(benchmark::State& state) {
+  for ([[maybe_unused]] auto _ : state) {
+    TinyLfu cache(kElementsCount);
+    for (unsigned i = 0; i < kElementsCount; ++i) {
+      cache.Put(i, i);
+    }
+    benchmark::DoNotOptimize(cache);
+  }
+}
+BENCHMARK(TinyLfuPut);
+
+void TinyLfuHas(benchmark::State& state) {
+  TinyLfu cache(kElementsCount);
+  for (unsigned i = 0; i < kElementsCount; ++i) {
+    cache.Put(i, i);
+  }
+  for ([[maybe_unused]] auto _ : state) {
+    for (unsigned i = 0; i < kElementsCount; ++i) {
+      benchmark::DoNotOptimize(cache.Get(i));
+    }
+  }
+}
+BENCHMARK(TinyLfuHas);
+
+void TinyLfuPeek(benchmark::State& state) {
+  TinyLfu cache(kElementsCount);
+  for (unsigned i = 0; i < kElementsCount; ++i) {
+    cache.Put(i, i);
+  }
+  for ([[maybe_unused]] auto _ : state) {
+    for (unsigned i = 0; i < kElementsCount; ++i) {
+      benchmark::DoNotOptimize(cache.Peek(i));
+      if (cache.HasManyPendingReads()) cache.ProcessPendingReads();
+    }
+  }
+}
+BENCHMARK(TinyLfuPeek);
+
+void TinyLfuPutOverflow(benchmark::State& state) {
+  TinyLfu cache(kElementsCount);
+  for (unsigned i = 0; i < kElementsCount; ++i) {
+    cache.Put(i, i);
+  }
+  unsigned i = kElementsCount;
+  for ([[maybe_unused]] auto _ : state) {
+    for (unsigned j = 0; j < kElementsCount; ++j) {
+      cache.Put(++i, 0);
+    }
+    benchmark::DoNotOptimize(cache);
+  }
+}
+BENCHMARK(TinyLfuPutOverflow);
+
+USERVER_NAMESPACE_END
@@ -0,0 +1,142 @@
+#include <userver/cache/impl/tinylfu.hpp>
+
+#include <string>
+
+#include <gtest/gtest.h>
+
+USERVER_NAMESPACE_BEGIN
+
+namespace {
+
+using TinyLfu = cache::impl::TinyLfuBase<std::size_t, std::size_t>;
+
+constexpr std::size_t kCacheSize = 100;
+
+}  // namespace
+
+TEST(TinyLfuBase, Sample) {
+  cache::impl::TinyLfuBase<std::string, int> cache(kCacheSize);
+
+  EXPECT_TRUE(cache.Put("a", 1));
+  EXPECT_FALSE(cache.Put("a", 2));
+  EXPECT_EQ(2, *cache.Get("a"));
+  EXPECT_EQ(2, *cache.Peek("a"));
+  EXPECT_EQ(nullptr, cache.Get("b"));
+  EXPECT_EQ(nullptr, cache.Peek("b"));
+
+  EXPECT_EQ(3, *cache.Emplace("b", 3));
+  EXPECT_EQ(3, *cache.Emplace("b", 4));
+  EXPECT_EQ(2, cache.GetSize());
+}
+
+TEST(TinyLfuBase, Capacity) {
+  TinyLfu cache(kCacheSize);
+  EXPECT_EQ(kCacheSize, cache.GetCapacity());
+
+  for (std::size_t i = 0; i < 10 * kCacheSize; ++i) {
+    cache.Put(i, i);
+    EXPECT_LE(cache.GetSize(), kCacheSize);
+  }
+  EXPECT_EQ(kCacheSize, cache.GetSize());
+
+  cache.SetMaxSize(kCacheSize / 2);
+  EXPECT_EQ(kCacheSize / 2, cache.GetSize());
+
+  cache.Clear();
+  EXPECT_EQ(0, cache.GetSize());
+}
+
+TEST(TinyLfuBase, ScanResistance) {
+  TinyLfu cache(kCacheSize);
+
+  constexpr std::size_t kHotKeys = kCacheSize / 2;
+  constexpr std::size_t kRounds = 10;
+  std::size_t hits = 0;
+  std::size_t cold_key = 1000;
+  for (std::size_t round = 0; round < kRounds; ++round) {
+    for (std::size_t i = 0; i < kHotKeys; ++i) {
+      if (cache.Get(i)) {
+        ++hits;
+      } else {
+        cache.Put(i, i);
+      }
+    }
+
+    // Bulk scan of cold keys between the hot key accesses, plain LRU would
+    // have no hits at all
+    for (std::size_t i = 0; i < 2 * kCacheSize; ++i) {
+      cache.Put(cold_key, cold_key);
+      ++cold_key;
+    }
+  }
+
+  EXPECT_GE(hits, (kRounds - 2) * kHotKeys);
+}
+
+TEST(TinyLfuBase, PeekedKeysAreNotEvicted) {
+  TinyLfu cache(kCacheSize);
+
+  constexpr std::size_t kHotKeys = kCacheSize / 2;
+  constexpr std::size_t kRounds = 10;
+  std::size_t hits = 0;
+  std::size_t cold_key = 1000;
+  for (std::size_t round = 0; round < kRounds; ++round) {
+    // Reads under a shared lock only record the accesses
+    for (std::size_t i = 0; i < kHotKeys; ++i) {
+      if (cache.Peek(i)) {
+        ++hits;
+      } else {
+        cache.Put(i, i);
+      }
+      if (cache.HasManyPendingReads()) cache.ProcessPendingReads();
+    }
+
+    for (std::size_t i = 0; i < 2 * kCacheSize; ++i) {
+      cache.Put(cold_key, cold_key);
+      ++cold_key;
+    }
+  }
+
+  EXPECT_GE(hits, (kRounds - 2) * kHotKeys);
+}
+
+TEST(TinyLfuBase, Erase) {
+  TinyLfu cache(kCacheSize);
+  for (std::size_t i = 0; i < kCacheSize; ++i) {
+    cache.Put(i, i);
+    cache.Get(i);
+  }
+
+  for (std::size_t i = 0; i < kCacheSize; ++i) {
+    cache.Erase(i);
+  }
+
+  EXPECT_EQ(0, cache.GetSize());
+  for (std::size_t i = 0; i < kCacheSize; ++i) {
+    EXPECT_EQ(nullptr, cache.Get(i));
+  }
+}
+
+TEST(TinyLfuBase, VisitAll) {
+  TinyLfu cache(kCacheSize);
+  for (std::size_t i = 0; i < kCacheSize; ++i) {
+    cache.Put(i, i);
+  }
+
+  std::size_t sum = 0;
+  cache.VisitAll([&sum](std::size_t key, std::size_t value) {
+    EXPECT_EQ(key, value);
+    sum += value;
+  });
+  EXPECT_EQ(kCacheSize * (kCacheSize - 1) / 2, sum);
+}
+
+TEST(TinyLfuBase, SmallSize) {
+  TinyLfu cache(1);
+  for (std::size_t i = 0; i < 100; ++i) {
+    cache.Put(i % 3, i);
+    EXPECT_LE(cache.GetSize(), cache.GetCapacity());
+  }
+}
+
+USERVER_NAMESPACE_END
@@ -3,6 +3,8 @@
 #include <zstd.h>
 #include <zstd_errors.h>
 
+#include <userver/utils/assert.hpp>
+
 USERVER_NAMESPACE_BEGIN
 
 namespace compression::zstd {
@@ -58,6 +60,85 @@ std::string DecompressStream(std::string_view compressed, size_t max_size) {
   return decompressed;
 }
 
+struct StreamCompressor::Impl final {
+  explicit Impl(int level) : context(ZSTD_createCCtx()) {
+    if (context == nullptr) {
+      throw CompressionError("Couldn't create ZSTD compression context");
+    }
+    if (const auto ret =
+            ZSTD_CCtx_setParameter(context, ZSTD_c_compressionLevel, level);
+        ZSTD_isError(ret)) {
+      ZSTD_freeCCtx(context);
+      throw CompressionError(fmt::format("Compression failed: {}",
+                                         ZSTD_getErrorName(ret)));
+    }
+  }
+
+  ~Impl() { ZSTD_freeCCtx(context); }
+
+  Impl(Impl&&) = delete;
+  Impl& operator=(Impl&&) = delete;
+
+  std::string DoCompress(std::string_view data, ZSTD_EndDirective mode) {
+    std::string output;
+    ZSTD_inBuffer input{data.data(), data.size(), 0};
+
+    std::size_t remaining = 0;
+    do {
+      const auto old_size = output.size();
+      // The loop takes care of the rare case when the bound is not enough
+      // for the buffered data plus the frame epilogue
+      const auto chunk_size = ZSTD_compressBound(input.size - input.pos);
+      output.resize(old_size + chunk_size);
+      ZSTD_outBuffer out{output.data() + old_size, chunk_size, 0};
+
+      remaining = ZSTD_compressStream2(context, &out, &input, mode);
+      if (ZSTD_isError(remaining)) {
+        throw CompressionError(fmt::format("Compression failed: {}",
+                                           ZSTD_getErrorName(remaining)));
+      }
+      output.resize(old_size + out.pos);
+    } while (remaining != 0);
+
+    UASSERT(input.pos == input.size);
+    return output;
+  }
+
+  ZSTD_CCtx* context;
+};
+
+StreamCompressor::StreamCompressor(int level)
+    : impl_(std::make_unique<Impl>(level)) {}
+
+StreamCompressor::StreamCompressor(StreamCompressor&&) noexcept = default;
+
+StreamCompressor& StreamCompressor::operator=(StreamCompressor&&) noexcept =
+    default;
+
+StreamCompressor::~StreamCompressor() = default;
+
+std::string StreamCompressor::Compress(std::string_view chunk) {
+  UASSERT(impl_);
+  return impl_->DoCompress(chunk, ZSTD_e_flush);
+}
+
+std::string StreamCompressor::Finish() {
+  UASSERT(impl_);
+  return impl_->DoCompress({}, ZSTD_e_end);
+}
+
+std::string Compress(std::string_view data, int level) {
+  std::string compressed(ZSTD_compressBound(data.size()), '\0');
+  const auto ret = ZSTD_compress(compressed.data(), compressed.size(),
+                                 data.data(), data.size(), level);
+  if (ZSTD_isError(ret)) {
+    throw CompressionError(
+        fmt::format("Compression failed: {}", ZSTD_getErrorName(ret)));
+  }
+  compressed.resize(ret);
+  return compressed;
+}
+
 std::string Decompress(std::string_view compressed, size_t max_size) {
   const auto decompressed_size =
       ZSTD_getFrameContentSize(compressed.data(), compressed.size());
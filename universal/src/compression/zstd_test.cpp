@@ -65,4 +65,32 @@ TEST(Zstd, TestOverflow) {
       compression::TooBigError);
 }
 
+TEST(Zstd, CompressRoundtrip) {
+  std::string data;
+  for (int i = 0; i < 1000; ++i) {
+    data += R"({"id":)" + std::to_string(i) + R"(,"name":"item"},)";
+  }
+
+  const auto compressed = compression::zstd::Compress(data, 3);
+  EXPECT_LT(compressed.size(), data.size());
+  EXPECT_EQ(compression::zstd::Decompress(compressed, data.size()), data);
+}
+
+TEST(Zstd, StreamCompressRoundtrip) {
+  compression::zstd::StreamCompressor compressor{1};
+
+  std::string data;
+  std::string compressed;
+  for (int i = 0; i < 100; ++i) {
+    const auto chunk = "chunk #" + std::to_string(i) + '\n';
+    data += chunk;
+    const auto compressed_chunk = compressor.Compress(chunk);
+    EXPECT_FALSE(compressed_chunk.empty());
+    compressed += compressed_chunk;
+  }
+  compressed += compressor.Finish();
+
+  EXPECT_EQ(compression::zstd::Decompress(compressed, data.size()), data);
+}
+
 USERVER_NAMESPACE_END
@@ -57,6 +57,11 @@ HeaderMap::HeaderMap(
 
 HeaderMap::HeaderMap(std::size_t capacity) : HeaderMap{} { reserve(capacity); }
 
+HeaderMap::HeaderMap(std::size_t capacity, utils::impl::MonotonicArena& arena)
+    : impl_{arena} {
+  reserve(capacity);
+}
+
 HeaderMap::~HeaderMap() = default;
 
 HeaderMap::HeaderMap(const HeaderMap& other) = default;
@@ -215,6 +215,9 @@ inline Map::FindResult Map::FindResult::None() noexcept {
 
 Map::Map() { static_assert(IsPowerOf2(kOnStackPositionsCount)); }
 
+Map::Map(utils::impl::MonotonicArena& arena)
+    : entries_{utils::impl::ArenaAllocator<MapEntry>{arena}} {}
+
 void Map::Reserve(std::size_t capacity) {
   // We don't touch positions here because:
   // 1. it's a small vector with capacity probably big enough anyway
@@ -326,7 +329,7 @@ void Map::Rebuild() {
 
   positions_.assign(positions_.size(), Pos::None());
 
-  std::vector<MapEntry> entries;
+  MapEntries entries{entries_.get_allocator()};
   std::swap(entries_, entries);
   entries_.reserve(entries.size());
 
@@ -723,15 +726,13 @@ void Map::OutputInHttpFormat(HeadersString& buffer) const {
   UASSERT(buffer.size() == old_buffer_size + amount_to_add);
 }
 
-inline Map::Iterator Map::ToReverseIterator(
-    std::vector<MapEntry>::iterator it) {
+inline Map::Iterator Map::ToReverseIterator(MapEntries::iterator it) {
   static_assert(!std::is_same_v<Iterator, decltype(it)>);
 
   return Iterator{++it /* ++ because reversed */};
 }
 
-Map::ConstIterator Map::ToReverseIterator(
-    std::vector<MapEntry>::const_iterator it) {
+Map::ConstIterator Map::ToReverseIterator(MapEntries::const_iterator it) {
   static_assert(!std::is_same_v<ConstIterator, decltype(it)>);
 
   return ConstIterator{++it /* ++ because reversed */};
@@ -58,10 +58,11 @@ class MaybeOwnedKey final {
 
 class Map final {
  public:
-  using Iterator = std::vector<MapEntry>::reverse_iterator;
-  using ConstIterator = std::vector<MapEntry>::const_reverse_iterator;
+  using Iterator = MapEntries::reverse_iterator;
+  using ConstIterator = MapEntries::const_reverse_iterator;
 
   Map();
+  explicit Map(utils::impl::MonotonicArena& arena);
 
   void Reserve(std::size_t capacity);
 
@@ -134,9 +135,8 @@ class Map final {
                             InsertOrModifyOccupiedAction occupied_action);
   Iterator DoErase(std::string_view key, Traits::HashValue hash);
 
-  static Iterator ToReverseIterator(std::vector<MapEntry>::iterator it);
-  static ConstIterator ToReverseIterator(
-      std::vector<MapEntry>::const_iterator it);
+  static Iterator ToReverseIterator(MapEntries::iterator it);
+  static ConstIterator ToReverseIterator(MapEntries::const_iterator it);
 
   static bool AreValuesICaseEqual(std::string_view lhs,
                                   std::string_view rhs) noexcept;
@@ -152,7 +152,7 @@ class Map final {
 
   Traits::Size mask_{0};
   boost::container::small_vector<Pos, kOnStackPositionsCount> positions_;
-  std::vector<MapEntry> entries_;
+  MapEntries entries_;
   Danger danger_;
 };
 
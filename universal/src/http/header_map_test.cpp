@@ -9,6 +9,7 @@
 #include <userver/formats/serialize/common_containers.hpp>
 #include <userver/http/common_headers.hpp>
 #include <userver/http/header_map.hpp>
+#include <userver/utils/impl/monotonic_arena.hpp>
 #include <userver/utils/rand.hpp>
 #include <userver/utils/str_icase.hpp>
 
@@ -645,6 +646,28 @@ bool CheckNoCollisions(const HeadersArray& headers,
 
 }  // namespace
 
+TEST(HeaderMap, Arena) {
+  utils::impl::MonotonicArena arena;
+  HeaderMap map{16, arena};
+  const auto allocated = arena.GetStats().allocated_bytes;
+  EXPECT_GT(allocated, 0);
+
+  for (int i = 0; i < 100; ++i) {
+    map.emplace("header-" + std::to_string(i), std::to_string(i));
+  }
+  EXPECT_GT(arena.GetStats().allocated_bytes, allocated);
+  EXPECT_EQ(map.find(std::string_view{"header-42"})->second, "42");
+
+  // Copies may outlive the arena
+  const HeaderMap copy = map;
+  const auto arena_bytes = arena.GetStats().allocated_bytes;
+  HeaderMap assigned;
+  assigned = map;
+  EXPECT_EQ(arena.GetStats().allocated_bytes, arena_bytes);
+  EXPECT_EQ(copy, map);
+  EXPECT_EQ(assigned, map);
+}
+
 TEST(HeaderMap, DefaultHeadersHashDistribution) {
   const auto check_uniqueness = [](const auto& headers) {
     const std::unordered_set<std::string_view> st(std::begin(headers),
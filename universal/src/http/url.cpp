@@ -2,6 +2,7 @@
 
 #include <array>
 
+#include <utils/impl/byte_scan.hpp>
 #include <utils/impl/internal_tag.hpp>
 
 USERVER_NAMESPACE_BEGIN
@@ -12,33 +13,24 @@ namespace {
 
 const std::string_view kSchemaSeparator = "://";
 
+void AppendPercentEncoded(char symbol, std::string& result) {
+  std::array<char, 3> bytes = {'%', 0, 0};
+  bytes[1] = (symbol & 0xF0) / 16;
+  bytes[1] += (bytes[1] > 9) ? 'A' - 10 : '0';
+  bytes[2] = symbol & 0x0F;
+  bytes[2] += (bytes[2] > 9) ? 'A' - 10 : '0';
+  result.append(bytes.data(), bytes.size());
+}
+
 void UrlEncodeTo(std::string_view input_string, std::string& result) {
-  for (char symbol : input_string) {
-    if (isalnum(symbol)) {
-      result.append(1, symbol);
-      continue;
-    }
-    switch (symbol) {
-      case '-':
-      case '_':
-      case '.':
-      case '!':
-      case '~':
-      case '*':
-      case '(':
-      case ')':
-      case '\'':
-        result.append(1, symbol);
-        break;
-      default:
-        std::array<char, 3> bytes = {'%', 0, 0};
-        bytes[1] = (symbol & 0xF0) / 16;
-        bytes[1] += (bytes[1] > 9) ? 'A' - 10 : '0';
-        bytes[2] = symbol & 0x0F;
-        bytes[2] += (bytes[2] > 9) ? 'A' - 10 : '0';
-        result.append(bytes.data(), bytes.size());
-        break;
-    }
+  while (!input_string.empty()) {
+    // Copy the run of symbols that need no encoding at once
+    const auto safe_size = utils::impl::FindFirstNotUrlSafe(input_string);
+    result.append(input_string.data(), safe_size);
+    if (safe_size == input_string.size()) break;
+
+    AppendPercentEncoded(input_string[safe_size], result);
+    input_string.remove_prefix(safe_size + 1);
   }
 }
 
@@ -201,28 +193,27 @@ namespace impl {
 
 std::string UrlDecode(utils::impl::InternalTag, std::string_view range) {
   std::string result;
-  result.reserve(range.size() / 3);
-
-  for (const char *i = range.begin(), *end = range.end(); i != end; ++i) {
-    switch (*i) {
-      case '+':
-        result.append(1, ' ');
-        break;
-      case '%':
-        if (std::distance(i, end) > 2) {
-          char f = *(i + 1);
-          char s = *(i + 2);
-          int digit = (f >= 'A' ? ((f & 0xDF) - 'A') + 10 : (f - '0')) * 16;
-          digit += (s >= 'A') ? ((s & 0xDF) - 'A') + 10 : (s - '0');
-          result.append(1, static_cast<char>(digit));
-          i += 2;
-        } else {
-          result.append(1, '%');
-        }
-        break;
-      default:
-        result.append(1, (*i));
-        break;
+  result.reserve(range.size());
+
+  while (!range.empty()) {
+    const auto plain_size = utils::impl::FindFirstOf(range, '%', '+');
+    result.append(range.data(), plain_size);
+    if (plain_size == range.size()) break;
+    range.remove_prefix(plain_size);
+
+    if (range.front() == '+') {
+      result.append(1, ' ');
+      range.remove_prefix(1);
+    } else if (range.size() > 2) {
+      char f = range[1];
+      char s = range[2];
+      int digit = (f >= 'A' ? ((f & 0xDF) - 'A') + 10 : (f - '0')) * 16;
+      digit += (s >= 'A') ? ((s & 0xDF) - 'A') + 10 : (s - '0');
+      result.append(1, static_cast<char>(digit));
+      range.remove_prefix(3);
+    } else {
+      result.append(1, '%');
+      range.remove_prefix(1);
     }
   }
 
@@ -1,5 +1,6 @@
 #include <benchmark/benchmark.h>
 
+#include <userver/http/parser/http_request_parse_args.hpp>
 #include <userver/http/url.hpp>
 
 USERVER_NAMESPACE_BEGIN
@@ -40,4 +41,45 @@ void make_query(benchmark::State& state) {
 }
 BENCHMARK(make_query)->RangeMultiplier(2)->Range(1, 256);
 
+void url_encode(benchmark::State& state) {
+  // A typical argument: mostly safe symbols with rare ones to encode
+  std::string input;
+  while (input.size() < static_cast<std::size_t>(state.range(0))) {
+    input += "some-value_with.latin/symbols ";
+  }
+  for ([[maybe_unused]] auto _ : state) {
+    benchmark::DoNotOptimize(http::UrlEncode(input));
+  }
+  state.SetBytesProcessed(state.iterations() * input.size());
+}
+BENCHMARK(url_encode)->RangeMultiplier(8)->Range(8, 4096);
+
+void url_decode(benchmark::State& state) {
+  std::string input;
+  while (input.size() < static_cast<std::size_t>(state.range(0))) {
+    input += "some-value_with.latin%2Fsymbols+";
+  }
+  for ([[maybe_unused]] auto _ : state) {
+    benchmark::DoNotOptimize(http::parser::UrlDecode(input));
+  }
+  state.SetBytesProcessed(state.iterations() * input.size());
+}
+BENCHMARK(url_decode)->RangeMultiplier(8)->Range(8, 4096);
+
+void parse_args(benchmark::State& state) {
+  std::string args;
+  for (std::int64_t i = 0; i < state.range(0); ++i) {
+    args += "argument" + std::to_string(i) + "=some%20value+" +
+            std::to_string(i) + '&';
+  }
+  for ([[maybe_unused]] auto _ : state) {
+    std::size_t count = 0;
+    http::parser::ParseAndConsumeArgs(
+        args, [&count](std::string&&, std::string&&) { ++count; });
+    benchmark::DoNotOptimize(count);
+  }
+  state.SetBytesProcessed(state.iterations() * args.size());
+}
+BENCHMARK(parse_args)->RangeMultiplier(4)->Range(1, 256);
+
 USERVER_NAMESPACE_END
@@ -29,6 +29,20 @@ TEST(UrlEncode, Special) {
   EXPECT_EQ("Text%20with%20spaces%2C%3F%26%3D", UrlEncode(str));
 }
 
+TEST(UrlEncode, Long) {
+  // Special symbols at different positions within and across SIMD blocks
+  std::string str(100, 'a');
+  for (std::size_t pos : {0, 15, 16, 31, 32, 63, 99}) {
+    str[pos] = ' ';
+  }
+  EXPECT_EQ(UrlDecode(UrlEncode(str)), str);
+
+  const std::string latin(100, 'b');
+  EXPECT_EQ(latin + "%2F" + latin, UrlEncode(latin + '/' + latin));
+  EXPECT_EQ("-_.!~*'()", UrlEncode("-_.!~*'()"));
+  EXPECT_EQ("%7F%80%FF", UrlEncode("\x7f\x80\xff"));
+}
+
 TEST(UrlDecode, Empty) { EXPECT_EQ("", UrlDecode("")); }
 
 TEST(UrlDecode, Latin) {
@@ -57,6 +71,12 @@ TEST(UrlDecode, Invalid) {
   EXPECT_EQ("Q11", UrlDecode(str));
 }
 
+TEST(UrlDecode, Long) {
+  const std::string latin(100, 'a');
+  EXPECT_EQ(latin + " /" + latin, UrlDecode(latin + "+%2F" + latin));
+  EXPECT_EQ(latin + '%', UrlDecode(latin + '%'));
+}
+
 TEST(MakeUrl, InitializerList) {
   EXPECT_EQ("path?a=b&c=d", http::MakeUrl("path", {{"a", "b"}, {"c", "d"}}));
 }
@@ -0,0 +1,173 @@
+#include <utils/impl/byte_scan.hpp>
+
+#if defined(__AVX2__)
+#include <immintrin.h>
+#elif defined(__SSE2__)
+#include <emmintrin.h>
+#endif
+
+#include <cstdint>
+
+USERVER_NAMESPACE_BEGIN
+
+namespace utils::impl {
+
+namespace {
+
+constexpr bool InRange(char c, char lo, char hi) noexcept {
+  return lo <= c && c <= hi;
+}
+
+// Characters that are not percent-encoded, as in RFC 2396 "unreserved".
+// Note that "'()*" and "-." are contiguous in ASCII.
+constexpr bool IsUrlSafe(char c) noexcept {
+  return InRange(c, '0', '9') || InRange(c, 'A', 'Z') ||
+         InRange(c, 'a', 'z') || InRange(c, '\'', '*') ||
+         InRange(c, '-', '.') || c == '_' || c == '!' || c == '~';
+}
+
+#ifdef __SSE2__
+struct Sse2Ops final {
+  using Vector = __m128i;
+  using Mask = std::uint32_t;
+
+  static constexpr std::size_t kSize = 16;
+
+  static Vector Load(const char* data) noexcept {
+    return _mm_loadu_si128(reinterpret_cast<const __m128i*>(data));
+  }
+  static Vector Set(char c) noexcept { return _mm_set1_epi8(c); }
+  static Vector Equal(Vector x, char c) noexcept {
+    return _mm_cmpeq_epi8(x, Set(c));
+  }
+  // Signed comparisons, bytes >= 0x80 are never in an ASCII range
+  static Vector InRange(Vector x, char lo, char hi) noexcept {
+    return _mm_and_si128(_mm_cmpgt_epi8(x, Set(lo - 1)),
+                         _mm_cmpgt_epi8(Set(hi + 1), x));
+  }
+  static Vector Or(Vector x, Vector y) noexcept { return _mm_or_si128(x, y); }
+  static Mask MoveMask(Vector x) noexcept {
+    return static_cast<Mask>(_mm_movemask_epi8(x));
+  }
+  static constexpr Mask kAllSet = 0xFFFF;
+};
+#endif
+
+#ifdef __AVX2__
+struct Avx2Ops final {
+  using Vector = __m256i;
+  using Mask = std::uint32_t;
+
+  static constexpr std::size_t kSize = 32;
+
+  static Vector Load(const char* data) noexcept {
+    return _mm256_loadu_si256(reinterpret_cast<const __m256i*>(data));
+  }
+  static Vector Set(char c) noexcept { return _mm256_set1_epi8(c); }
+  static Vector Equal(Vector x, char c) noexcept {
+    return _mm256_cmpeq_epi8(x, Set(c));
+  }
+  static Vector InRange(Vector x, char lo, char hi) noexcept {
+    return _mm256_and_si256(_mm256_cmpgt_epi8(x, Set(lo - 1)),
+                            _mm256_cmpgt_epi8(Set(hi + 1), x));
+  }
+  static Vector Or(Vector x, Vector y) noexcept {
+    return _mm256_or_si256(x, y);
+  }
+  static Mask MoveMask(Vector x) noexcept {
+    return static_cast<Mask>(_mm256_movemask_epi8(x));
+  }
+  static constexpr Mask kAllSet = 0xFFFFFFFF;
+};
+#endif
+
+// Processes whole blocks of `data` starting at `pos`. Returns true and sets
+// `pos` to the first matching byte if found, otherwise sets `pos` to the
+// beginning of the unprocessed tail.
+template <typename Ops, typename Matcher>
+bool FindInBlocks(std::string_view data, std::size_t& pos,
+                  Matcher matcher) noexcept {
+  for (; pos + Ops::kSize <= data.size(); pos += Ops::kSize) {
+    const auto mask = matcher(Ops::Load(data.data() + pos));
+    if (mask != 0) {
+      pos += __builtin_ctz(mask);
+      return true;
+    }
+  }
+  return false;
+}
+
+template <typename Ops>
+bool FindFirstOfBlocks(std::string_view data, std::size_t& pos, char a,
+                       char b) noexcept {
+  return FindInBlocks<Ops>(data, pos, [a, b](typename Ops::Vector x) {
+    return Ops::MoveMask(Ops::Or(Ops::Equal(x, a), Ops::Equal(x, b)));
+  });
+}
+
+template <typename Ops>
+bool FindFirstNotUrlSafeBlocks(std::string_view data,
+                               std::size_t& pos) noexcept {
+  return FindInBlocks<Ops>(data, pos, [](typename Ops::Vector x) {
+    auto safe = Ops::Or(Ops::InRange(x, '0', '9'), Ops::InRange(x, 'A', 'Z'));
+    safe = Ops::Or(safe, Ops::InRange(x, 'a', 'z'));
+    safe = Ops::Or(safe, Ops::InRange(x, '\'', '*'));
+    safe = Ops::Or(safe, Ops::InRange(x, '-', '.'));
+    safe = Ops::Or(safe, Ops::Equal(x, '_'));
+    safe = Ops::Or(safe, Ops::Equal(x, '!'));
+    safe = Ops::Or(safe, Ops::Equal(x, '~'));
+    return Ops::MoveMask(safe) ^ Ops::kAllSet;
+  });
+}
+
+std::size_t FindFirstOfTail(std::string_view data, std::size_t pos, char a,
+                            char b) noexcept {
+  for (; pos < data.size(); ++pos) {
+    if (data[pos] == a || data[pos] == b) break;
+  }
+  return pos;
+}
+
+std::size_t FindFirstNotUrlSafeTail(std::string_view data,
+                                    std::size_t pos) noexcept {
+  for (; pos < data.size(); ++pos) {
+    if (!IsUrlSafe(data[pos])) break;
+  }
+  return pos;
+}
+
+}  // namespace
+
+std::size_t FindFirstOf(std::string_view data, char a, char b) noexcept {
+  std::size_t pos = 0;
+#ifdef __AVX2__
+  if (FindFirstOfBlocks<Avx2Ops>(data, pos, a, b)) return pos;
+#endif
+#ifdef __SSE2__
+  if (FindFirstOfBlocks<Sse2Ops>(data, pos, a, b)) return pos;
+#endif
+  return FindFirstOfTail(data, pos, a, b);
+}
+
+std::size_t FindFirstOfNoSse(std::string_view data, char a, char b) noexcept {
+  return FindFirstOfTail(data, 0, a, b);
+}
+
+std::size_t FindFirstNotUrlSafe(std::string_view data) noexcept {
+  std::size_t pos = 0;
+#ifdef __AVX2__
+  if (FindFirstNotUrlSafeBlocks<Avx2Ops>(data, pos)) return pos;
+#endif
+#ifdef __SSE2__
+  if (FindFirstNotUrlSafeBlocks<Sse2Ops>(data, pos)) return pos;
+#endif
+  return FindFirstNotUrlSafeTail(data, pos);
+}
+
+std::size_t FindFirstNotUrlSafeNoSse(std::string_view data) noexcept {
+  return FindFirstNotUrlSafeTail(data, 0);
+}
+
+}  // namespace utils::impl
+
+USERVER_NAMESPACE_END
@@ -0,0 +1,29 @@
+#pragma once
+
+#include <cstddef>
+#include <string_view>
+
+USERVER_NAMESPACE_BEGIN
+
+namespace utils::impl {
+
+// Returns the position of the first byte of `data` that is equal to `a` or
+// `b`, or `data.size()` if there is none. Uses AVX2 or SSE2 when available.
+std::size_t FindFirstOf(std::string_view data, char a, char b) noexcept;
+
+// Same as FindFirstOf, but doesn't explicitly use SIMD even if it's available.
+std::size_t FindFirstOfNoSse(std::string_view data, char a, char b) noexcept;
+
+// Returns the position of the first byte of `data` that has to be
+// percent-encoded in URL, i.e. is not an ASCII letter, digit or one of
+// "-_.!~*'()". Returns `data.size()` if there is none. Uses AVX2 or SSE2 when
+// available.
+std::size_t FindFirstNotUrlSafe(std::string_view data) noexcept;
+
+// Same as FindFirstNotUrlSafe, but doesn't explicitly use SIMD even if it's
+// available.
+std::size_t FindFirstNotUrlSafeNoSse(std::string_view data) noexcept;
+
+}  // namespace utils::impl
+
+USERVER_NAMESPACE_END
@@ -0,0 +1,55 @@
+#include <gtest/gtest.h>
+
+#include <string>
+
+#include <utils/impl/byte_scan.hpp>
+
+USERVER_NAMESPACE_BEGIN
+
+namespace {
+
+// Covers the SIMD blocks of all the sizes, their tails and boundaries
+constexpr std::size_t kMaxSize = 100;
+
+}  // namespace
+
+TEST(ByteScan, FindFirstOf) {
+  for (std::size_t size = 0; size <= kMaxSize; ++size) {
+    const std::string plain(size, 'a');
+    EXPECT_EQ(utils::impl::FindFirstOf(plain, '%', '+'), size);
+    EXPECT_EQ(utils::impl::FindFirstOfNoSse(plain, '%', '+'), size);
+
+    for (std::size_t pos = 0; pos < size; ++pos) {
+      for (const char c : {'%', '+'}) {
+        auto data = plain;
+        data[pos] = c;
+        if (pos + 1 < size) data[size - 1] = '%';
+        EXPECT_EQ(utils::impl::FindFirstOf(data, '%', '+'), pos);
+        EXPECT_EQ(utils::impl::FindFirstOfNoSse(data, '%', '+'), pos);
+      }
+    }
+  }
+}
+
+TEST(ByteScan, FindFirstNotUrlSafe) {
+  const std::string safe =
+      "abcdefghijklmnopqrstuvwxyzABCDEFGHIJKLMNOPQRSTUVWXYZ0123456789-_.!~*'()";
+  EXPECT_EQ(utils::impl::FindFirstNotUrlSafe(safe), safe.size());
+  EXPECT_EQ(utils::impl::FindFirstNotUrlSafeNoSse(safe), safe.size());
+
+  for (int c = 0; c < 256; ++c) {
+    const auto symbol = static_cast<char>(c);
+    const bool is_safe = safe.find(symbol) != std::string::npos;
+
+    for (const std::size_t pos : {std::size_t{0}, std::size_t{17},
+                                  std::size_t{40}, kMaxSize - 1}) {
+      std::string data(kMaxSize, 'a');
+      data[pos] = symbol;
+      const auto expected = is_safe ? kMaxSize : pos;
+      EXPECT_EQ(utils::impl::FindFirstNotUrlSafe(data), expected) << c;
+      EXPECT_EQ(utils::impl::FindFirstNotUrlSafeNoSse(data), expected) << c;
+    }
+  }
+}
+
+USERVER_NAMESPACE_END
@@ -0,0 +1,59 @@
+#include <userver/utils/impl/monotonic_arena.hpp>
+
+#include <algorithm>
+#include <memory>
+
+USERVER_NAMESPACE_BEGIN
+
+namespace utils::impl {
+
+namespace {
+
+constexpr std::size_t kMinBlockSize = 4096;
+
+}  // namespace
+
+struct MonotonicArena::BlockHeader final {
+  BlockHeader* next;
+  std::size_t size;
+};
+
+MonotonicArena::~MonotonicArena() {
+  while (blocks_) {
+    auto* const next = blocks_->next;
+    ::operator delete(blocks_);
+    blocks_ = next;
+  }
+}
+
+void* MonotonicArena::Allocate(std::size_t size, std::size_t alignment) {
+  void* ptr = current_;
+  if (!std::align(alignment, size, ptr, available_)) {
+    return AllocateFromNewBlock(size, alignment);
+  }
+
+  current_ = static_cast<std::byte*>(ptr) + size;
+  available_ -= size;
+  stats_.allocated_bytes += size;
+  return ptr;
+}
+
+void* MonotonicArena::AllocateFromNewBlock(std::size_t size,
+                                         std::size_t alignment) {
+  const auto previous_size = (blocks_ ? blocks_->size : kInlineSize);
+  const auto block_size =
+      std::max({kMinBlockSize, previous_size * 2, size + alignment});
+
+  auto* const memory = ::operator new(sizeof(BlockHeader) + block_size);
+  blocks_ = new (memory) BlockHeader{blocks_, block_size};
+  ++stats_.heap_blocks;
+
+  current_ = reinterpret_cast<std::byte*>(blocks_ + 1);
+  available_ = block_size;
+  // Always fits the new block
+  return Allocate(size, alignment);
+}
+
+}  // namespace utils::impl
+
+USERVER_NAMESPACE_END
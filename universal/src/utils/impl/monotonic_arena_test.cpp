@@ -0,0 +1,80 @@
+#include <userver/utils/impl/monotonic_arena.hpp>
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+USERVER_NAMESPACE_BEGIN
+
+using utils::impl::ArenaAllocator;
+using utils::impl::MonotonicArena;
+
+TEST(MonotonicArena, Alignment) {
+  MonotonicArena arena;
+  for (std::size_t alignment : {1, 2, 4, 8, 16}) {
+    auto* ptr = arena.Allocate(1, alignment);
+    EXPECT_EQ(reinterpret_cast<std::uintptr_t>(ptr) % alignment, 0);
+  }
+  EXPECT_EQ(arena.GetStats().heap_blocks, 0);
+}
+
+TEST(MonotonicArena, Growth) {
+  MonotonicArena arena;
+  arena.Allocate(MonotonicArena::kInlineSize, 1);
+  EXPECT_EQ(arena.GetStats().heap_blocks, 0);
+
+  arena.Allocate(1, 1);
+  EXPECT_EQ(arena.GetStats().heap_blocks, 1);
+
+  arena.Allocate(100'000, 8);
+  EXPECT_EQ(arena.GetStats().heap_blocks, 2);
+  EXPECT_EQ(arena.GetStats().allocated_bytes,
+            MonotonicArena::kInlineSize + 1 + 100'000);
+}
+
+TEST(MonotonicArena, Containers) {
+  MonotonicArena arena;
+  std::vector<std::string, ArenaAllocator<std::string>> strings{
+      ArenaAllocator<std::string>{arena}};
+  for (int i = 0; i < 100; ++i) {
+    strings.push_back(std::to_string(i));
+  }
+  EXPECT_EQ(strings[42], "42");
+  EXPECT_GT(arena.GetStats().allocated_bytes, 0);
+
+  // Copies must not outlive the arena, so they use the heap
+  auto copy = strings;
+  EXPECT_EQ(copy.get_allocator().GetArena(), nullptr);
+  EXPECT_EQ(copy, strings);
+}
+
+TEST(MonotonicArena, AssignmentKeepsAllocator) {
+  MonotonicArena arena;
+  std::vector<std::string, ArenaAllocator<std::string>> in_arena{
+      ArenaAllocator<std::string>{arena}};
+  in_arena.push_back("in arena");
+
+  std::vector<std::string, ArenaAllocator<std::string>> on_heap;
+  on_heap = in_arena;
+  EXPECT_EQ(on_heap.get_allocator().GetArena(), nullptr);
+
+  on_heap = std::move(in_arena);
+  EXPECT_EQ(on_heap.get_allocator().GetArena(), nullptr);
+  EXPECT_EQ(on_heap.front(), "in arena");
+
+  std::vector<std::string, ArenaAllocator<std::string>> other_arena{
+      ArenaAllocator<std::string>{arena}};
+  other_arena = on_heap;
+  EXPECT_EQ(other_arena.get_allocator().GetArena(), &arena);
+}
+
+TEST(MonotonicArena, DefaultAllocatorUsesHeap) {
+  std::vector<int, ArenaAllocator<int>> values;
+  values.resize(1000, 1);
+  EXPECT_EQ(values.get_allocator().GetArena(), nullptr);
+  EXPECT_EQ(values.back(), 1);
+}
+
+USERVER_NAMESPACE_END